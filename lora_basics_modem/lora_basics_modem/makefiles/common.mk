@@ -5,7 +5,12 @@
 #-----------------------------------------------------------------------------
 # Build system binaries
 #-----------------------------------------------------------------------------
+ifeq ($(HOST),yes)
+# Host build: use the native toolchain
+PREFIX =
+else
 PREFIX = arm-none-eabi-
+endif
 # The gcc compiler bin path can be either defined in make command via GCC_PATH variable (> make GCC_PATH=xxx)
 # either it can be added to the PATH environment variable.
 ifdef GCC_PATH
@@ -99,6 +104,24 @@ BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_lr11xx_crypto_with_cred
 endif # LR11XX_WITH_CREDENTIALS
 endif # lr1120
 
+ifeq ($(CRYPTO),SOFT_FAST)
+TARGET_MODEM := $(TARGET_MODEM)_soft_fast
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_soft_fast
+endif # SOFT_FAST
+
+ifeq ($(CRYPTO),HW_ACCEL)
+TARGET_MODEM := $(TARGET_MODEM)_hw_accel
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_hw_accel
+endif # HW_ACCEL
+
+# Native build of a real radio target, for the radio hal replay of the utilities
+ifeq ($(HOST),yes)
+ifneq ($(RADIO),sim)
+TARGET_MODEM := $(TARGET_MODEM)_host
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_host
+endif
+endif
+
 ifeq ($(MIDDLEWARE),yes)
 TARGET_MODEM := $(TARGET_MODEM)_middleware
 BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_middleware
@@ -178,12 +201,15 @@ WFLAG += \
 	-Wno-unused-parameter \
 	-Wpedantic \
 	-fomit-frame-pointer \
-	-mabi=aapcs \
 	-fno-unroll-loops \
 	-ffast-math \
 	-ftree-vectorize \
 	$(BYPASS_FLAGS)
 
+ifneq ($(HOST),yes)
+WFLAG += -mabi=aapcs
+endif
+
 # Allow linker to not link unused functions
 WFLAG += \
 	-ffunction-sections \
@@ -234,6 +260,11 @@ COMMON_C_DEFS += \
 	-DPERF_TEST_ENABLED
 endif
 
+ifeq ($(CRYPTO),HW_ACCEL)
+COMMON_C_DEFS += \
+	-DSOFT_SE_HW_ACCEL
+endif
+
 ifeq ($(MIDDLEWARE),yes)
 COMMON_C_DEFS += \
 	-DTASK_EXTENDED_1 \
@@ -290,6 +321,7 @@ SMTC_MODEM_CORE_C_SOURCES += \
 	smtc_modem_core/modem_core/smtc_modem.c\
 	smtc_modem_core/modem_core/smtc_modem_test.c\
 	smtc_modem_core/modem_services/fifo_ctrl.c\
+	smtc_modem_core/modem_services/modem_crc32.c\
 	smtc_modem_core/modem_services/modem_utilities.c \
 	smtc_modem_core/modem_services/smtc_modem_services_hal.c\
 	smtc_modem_core/modem_services/lorawan_certification.c\
@@ -341,6 +373,9 @@ endif
 SMTC_MODEM_CRYPTO_C_SOURCES += \
 	smtc_modem_core/smtc_modem_crypto/smtc_modem_crypto.c
 
+SMTC_RALF_C_SOURCES += \
+	smtc_modem_core/smtc_ralf/src/ralf_shadow.c
+
 RADIO_PLANNER_C_SOURCES += \
 	smtc_modem_core/radio_planner/src/radio_planner.c\
 	smtc_modem_core/radio_planner/src/radio_planner_hal.c
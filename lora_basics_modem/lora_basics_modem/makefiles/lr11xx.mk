@@ -49,9 +49,9 @@ SMTC_MODEM_CRYPTO_C_SOURCES += \
 	smtc_modem_core/smtc_modem_crypto/lr11xx_crypto_engine/lr11xx_ce.c
 endif # LR11XX_WITH_CREDENTIALS
 
-ifeq ($(CRYPTO),SOFT)
+ifneq ($(filter SOFT SOFT_FAST HW_ACCEL,$(CRYPTO)),)
 SMTC_MODEM_CRYPTO_C_SOURCES += \
-	smtc_modem_core/smtc_modem_crypto/soft_secure_element/aes.c\
+	$(SOFT_SE_AES_C_SOURCES)\
 	smtc_modem_core/smtc_modem_crypto/soft_secure_element/cmac.c\
 	smtc_modem_core/smtc_modem_crypto/soft_secure_element/soft_se.c
 endif # soft_crypto
@@ -72,7 +72,7 @@ MODEM_C_INCLUDES += \
 	-Ismtc_modem_core/smtc_modem_crypto/lr11xx_crypto_engine
 endif # LR11XX_WITH_CREDENTIALS
 
-ifeq ($(CRYPTO),SOFT)
+ifneq ($(filter SOFT SOFT_FAST HW_ACCEL,$(CRYPTO)),)
 MODEM_C_INCLUDES += \
 	-Ismtc_modem_core/smtc_modem_crypto/soft_secure_element
 endif # soft_crypto
@@ -0,0 +1,33 @@
+##############################################################################
+# Definitions for the simulated tranceiver (host build)
+##############################################################################
+TARGET = sim
+
+SMTC_RAL_C_SOURCES += \
+	smtc_modem_core/smtc_ral/src/ral_sim.c
+
+SMTC_RALF_C_SOURCES += \
+	smtc_modem_core/smtc_ralf/src/ralf_sim.c
+
+SMTC_MODEM_CRYPTO_C_SOURCES += \
+	$(SOFT_SE_AES_C_SOURCES)\
+	smtc_modem_core/smtc_modem_crypto/soft_secure_element/cmac.c\
+	smtc_modem_core/smtc_modem_crypto/soft_secure_element/soft_se.c
+
+#-----------------------------------------------------------------------------
+# Includes
+#-----------------------------------------------------------------------------
+MODEM_C_INCLUDES =  \
+	-Ismtc_modem_core/smtc_modem_crypto/soft_secure_element
+
+#-----------------------------------------------------------------------------
+# Region
+#-----------------------------------------------------------------------------
+
+#-----------------------------------------------------------------------------
+# Radio specific compilation flags
+#-----------------------------------------------------------------------------
+# The inverse cipher is also built, for the virtual network server of the host simulation
+MODEM_C_DEFS += \
+	-DRADIO_SIM\
+	-DAES_DEC_PREKEYED
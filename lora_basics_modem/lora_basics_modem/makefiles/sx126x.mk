@@ -23,7 +23,7 @@ SMTC_RALF_C_SOURCES += \
 	smtc_modem_core/smtc_ralf/src/ralf_sx126x.c
 
 SMTC_MODEM_CRYPTO_C_SOURCES += \
-	smtc_modem_core/smtc_modem_crypto/soft_secure_element/aes.c\
+	$(SOFT_SE_AES_C_SOURCES)\
 	smtc_modem_core/smtc_modem_crypto/soft_secure_element/cmac.c\
 	smtc_modem_core/smtc_modem_crypto/soft_secure_element/soft_se.c
 
@@ -16,7 +16,7 @@ LR1MAC_C_SOURCES += \
 	smtc_modem_core/lr1mac/src/smtc_real/src/region_ww2g4.c 
 
 SMTC_MODEM_CRYPTO_C_SOURCES += \
-	smtc_modem_core/smtc_modem_crypto/soft_secure_element/aes.c\
+	$(SOFT_SE_AES_C_SOURCES)\
 	smtc_modem_core/smtc_modem_crypto/soft_secure_element/cmac.c\
 	smtc_modem_core/smtc_modem_crypto/soft_secure_element/soft_se.c
 
@@ -543,6 +543,15 @@ typedef struct smtc_modem_event_s
     } event_data;
 } smtc_modem_event_t;
 
+/**
+ * @brief Downlink payload given in place in the modem downlink fifo, see smtc_modem_get_event_zero_copy
+ */
+typedef struct smtc_modem_dl_payload_spans_s
+{
+    const uint8_t* data[2];    //!< Payload spans, data[1] is only used when the payload wraps at the end of the fifo
+    uint16_t       length[2];  //!< Length of each span, their sum is event_data.downdata.length
+} smtc_modem_dl_payload_spans_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -564,6 +573,36 @@ typedef struct smtc_modem_event_s
 
 smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_t* event_pending_count );
 
+/**
+ * @brief Get the modem event, without copying the payload of a downlink
+ *
+ * @remark Same as @ref smtc_modem_get_event, except for SMTC_MODEM_EVENT_DOWNDATA: event_data.downdata.data is not
+ * filled, the payload is given in place in the modem downlink fifo by \p downdata_spans. The spans stay valid until
+ * @ref smtc_modem_release_downdata is called or until the next event is read, which releases them.
+ *
+ * @param [out] event                   Structure holding event-related information
+ * @param [out] event_pending_count     Number of pending event(s)
+ * @param [out] downdata_spans          Payload of a SMTC_MODEM_EVENT_DOWNDATA event
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK            Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID       \p event, \p event_pending_count or \p downdata_spans are NULL
+ * @retval SMTC_MODEM_RC_BUSY          Modem is currently in test mode
+ */
+smtc_modem_return_code_t smtc_modem_get_event_zero_copy( smtc_modem_event_t* event, uint8_t* event_pending_count,
+                                                         smtc_modem_dl_payload_spans_t* downdata_spans );
+
+/**
+ * @brief Release the downlink payload given by @ref smtc_modem_get_event_zero_copy
+ *
+ * @remark Nothing is done if no downlink payload is held
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK            Command executed without errors
+ * @retval SMTC_MODEM_RC_BUSY          Modem is currently in test mode
+ */
+smtc_modem_return_code_t smtc_modem_release_downdata( void );
+
 /**
  * @brief Get the modem firmware version
  *
@@ -646,6 +685,18 @@ smtc_modem_return_code_t smtc_modem_get_charge( uint32_t* charge_mah );
  */
 smtc_modem_return_code_t smtc_modem_reset_charge( void );
 
+/**
+ * @brief Get the radio utilization since the modem start or the last charge counter reset
+ *
+ * @param [out] utilization_per_mille Part of the time spent with the radio busy, in per mille
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK            Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID       Parameter \p utilization_per_mille is NULL
+ * @retval SMTC_MODEM_RC_BUSY          Modem is currently in test mode
+ */
+smtc_modem_return_code_t smtc_modem_get_radio_utilization( uint16_t* utilization_per_mille );
+
 /**
  * @brief Get the Tx power offset in dB
  *
@@ -92,7 +92,7 @@ typedef enum smtc_modem_rp_task_types_e
 } smtc_modem_rp_task_types_t;
 
 /**
- * @brief Radio Planner task id
+ * @brief Radio Planner task id, the ids returned by smtc_modem_rp_register_user_radio_access_task can be used as well
  */
 typedef enum smtc_modem_rp_task_id_e
 {
@@ -142,6 +142,11 @@ typedef struct smtc_modem_rp_task_s
     void ( *end_task_callback )( smtc_modem_rp_status_t* status );  //!< The status of the operation
 } smtc_modem_rp_task_t;
 
+/**
+ * @brief Storage of a user task registered at runtime, of smtc_modem_rp_get_user_task_ctx_size() bytes
+ */
+typedef struct smtc_modem_rp_user_task_ctx_s smtc_modem_rp_user_task_ctx_t;
+
 /**
  * @brief Device to device priority definition
  */
@@ -172,11 +177,14 @@ typedef struct smtc_modem_d2d_class_b_uplink_config_e
 
 /**
  * @brief Add a user task in radio planner
+ * @remark A scheduled task that can not start at start_time_ms because the radio is busy is aborted, unless a slack
+ * has been set for its id with smtc_modem_rp_set_user_task_slack
  *
  * @param [in] rp_task  Structure holding radio planner task information
  *
  * @return smtc_modem_return_code_t as defined in @ref smtc_modem_return_code_t
  * @retval SMTC_MODEM_RC_OK                 Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID            rp_task->id is neither a SMTC_MODEM_RP_TASK_ID0..2 id nor a registered one
  * @retval SMTC_MODEM_RC_BUSY               Modem is currently in test mode
  * @retval SMTC_MODEM_RC_FAIL               A user task is already running in radio planner
  */
@@ -193,6 +201,63 @@ smtc_modem_return_code_t smtc_modem_rp_add_user_radio_access_task( smtc_modem_rp
  */
 smtc_modem_return_code_t smtc_modem_rp_abort_user_radio_access_task( uint8_t user_task_id );
 
+/**
+ * @brief Set the slack of the tasks added afterwards for a user task id
+ * @remark The slack is 0 after smtc_modem_init and after the registration of a task: a scheduled task that can not
+ * start at start_time_ms because the radio is busy is aborted. A non-zero slack lets the radio planner postpone it up
+ * to start_time_ms + slack_ms instead.
+ *
+ * @param [in] user_task_id  SMTC_MODEM_RP_TASK_ID0..2 or an id returned by smtc_modem_rp_register_user_radio_access_task
+ * @param [in] slack_ms      Delay after start_time_ms the tasks can be postponed to
+ *
+ * @return smtc_modem_return_code_t as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                 Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID            user_task_id is neither a SMTC_MODEM_RP_TASK_ID0..2 id nor a registered one
+ * @retval SMTC_MODEM_RC_BUSY               Modem is currently in test mode
+ */
+smtc_modem_return_code_t smtc_modem_rp_set_user_task_slack( uint8_t user_task_id, uint32_t slack_ms );
+
+/**
+ * @brief Get the size of the storage of a user task registered at runtime
+ *
+ * @return uint32_t size in bytes
+ */
+uint32_t smtc_modem_rp_get_user_task_ctx_size( void );
+
+/**
+ * @brief Register a user task in radio planner, in addition to the SMTC_MODEM_RP_TASK_ID0..2 ones
+ * @remark The returned id is used as the id of smtc_modem_rp_add_user_radio_access_task and
+ * smtc_modem_rp_abort_user_radio_access_task, and is the id of the status given to its end_task_callback. Its tasks
+ * have a lower priority than the tasks of the modem and of the SMTC_MODEM_RP_TASK_ID0..2 ids.
+ *
+ * @param [in]  user_task     Storage of the task, suitably aligned for any type and of
+ * smtc_modem_rp_get_user_task_ctx_size() bytes, it must remain valid until the task is unregistered
+ * @param [out] user_task_id  Id of the registered task
+ *
+ * @return smtc_modem_return_code_t as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                 Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID            user_task or user_task_id is NULL
+ * @retval SMTC_MODEM_RC_BUSY               Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_FAIL               The radio planner can not take more tasks (see RP_NB_HOOKS_MAX)
+ */
+smtc_modem_return_code_t smtc_modem_rp_register_user_radio_access_task( smtc_modem_rp_user_task_ctx_t* user_task,
+                                                                       uint8_t*                       user_task_id );
+
+/**
+ * @brief Unregister a user task registered with smtc_modem_rp_register_user_radio_access_task, its storage can be
+ * reused afterwards
+ *
+ * @param [in] user_task_id  Id of the registered task
+ *
+ * @return smtc_modem_return_code_t as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                 Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID            user_task_id is not a registered user task
+ * @retval SMTC_MODEM_RC_BUSY               Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_FAIL               A task is still pending or running, abort it and wait for its
+ * end_task_callback first
+ */
+smtc_modem_return_code_t smtc_modem_rp_unregister_user_radio_access_task( uint8_t user_task_id );
+
 /**
  * @brief Request a LoRaWAN extended uplink
  *
@@ -65,6 +65,11 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/**
+ * @brief Modem context: the whole state of one soft modem instance
+ */
+typedef struct smtc_modem_ctx_s smtc_modem_ctx_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -73,11 +78,37 @@ extern "C" {
 /**
  * @brief Init the soft modem and set the modem event chosen callback
  * @remark The callback will be called each time an modem event is raised internally
+ * @remark The current modem context (see smtc_modem_set_ctx) is first cleared to its power-on state
  *
  * @param [in] event_callback User event callback prototype
  */
 void smtc_modem_init( const ralf_t* radio, void ( *event_callback )( void ) );
 
+/**
+ * @brief Get the size of a modem context
+ *
+ * @return uint32_t size in bytes
+ */
+uint32_t smtc_modem_get_ctx_size( void );
+
+/**
+ * @brief Set the modem context used by all the following modem calls, including the modem engine
+ * @remark Several modems can run in the same program, each one with its own context of smtc_modem_get_ctx_size()
+ * bytes. smtc_modem_init() must be called once with the context set before any other call for this modem.
+ * @remark The radio and timer interrupts of a modem always run on the context it was initialized with, whatever
+ * context is set when they occur.
+ *
+ * @param [in] ctx Modem context, NULL for the built-in one used by single modem applications
+ */
+void smtc_modem_set_ctx( smtc_modem_ctx_t* ctx );
+
+/**
+ * @brief Get the modem context used by the modem calls
+ *
+ * @return smtc_modem_ctx_t* Current modem context
+ */
+smtc_modem_ctx_t* smtc_modem_get_ctx( void );
+
 /**
  * @brief Run the modem engine
  * @remark This function must be called in main loop. It returns an amount of ms after which the function must at least
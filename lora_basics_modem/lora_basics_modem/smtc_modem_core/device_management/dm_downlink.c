@@ -68,7 +68,7 @@
 #include "smtc_modem_e_api_extension.h"
 #endif  // LR1110_MODEM_E
 
-extern smtc_modem_services_t smtc_modem_services_ctx;
+#include "smtc_modem_ctx.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -202,6 +202,10 @@ dm_rc_t dm_downlink( uint8_t* data, uint8_t length )
 
 dm_rc_t dm_parse_cmd( dm_cmd_msg_t* cmd_input )
 {
+#if defined( ADD_SMTC_FILE_UPLOAD ) || defined( ADD_SMTC_STREAM ) || defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_services_t* modem_services = &smtc_modem_current_ctx->api.smtc_modem_services_ctx;
+#endif
+
     dm_rc_t ret = DM_OK;
     if( dm_check_cmd_size( cmd_input->request_code, cmd_input->buffer_len ) != DM_CMD_LENGTH_VALID )
     {
@@ -237,7 +241,7 @@ dm_rc_t dm_parse_cmd( dm_cmd_msg_t* cmd_input )
         }
 
         // process frame
-        if( file_upload_process_file_done_frame( &( smtc_modem_services_ctx.file_upload_ctx ), cmd_input->buffer,
+        if( file_upload_process_file_done_frame( &( modem_services->file_upload_ctx ), cmd_input->buffer,
                                                  cmd_input->buffer_len ) != FILE_UPLOAD_OK )
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "DM_FILE_DONE bad session_counter or bad message\n" );
@@ -308,7 +312,7 @@ dm_rc_t dm_parse_cmd( dm_cmd_msg_t* cmd_input )
         break;
 #if defined( ADD_SMTC_STREAM )
     case DM_STREAM:
-        if( stream_process_dn_frame( &( smtc_modem_services_ctx.stream_ROSE_ctx ), cmd_input->buffer,
+        if( stream_process_dn_frame( &( modem_services->stream_ROSE_ctx ), cmd_input->buffer,
                                      cmd_input->buffer_len ) != STREAM_OK )
         {
             ret = DM_ERROR;
@@ -318,24 +322,24 @@ dm_rc_t dm_parse_cmd( dm_cmd_msg_t* cmd_input )
 #if defined( ADD_SMTC_ALC_SYNC )
     case DM_ALC_SYNC: {
         uint8_t alc_sync_status =
-            alc_sync_parser( &( smtc_modem_services_ctx.alc_sync_ctx ), cmd_input->buffer, cmd_input->buffer_len );
+            alc_sync_parser( &( modem_services->alc_sync_ctx ), cmd_input->buffer, cmd_input->buffer_len );
 
         if( ( ( alc_sync_status >> ALC_SYNC_APP_TIME_ANS ) & 0x1 ) == 1 )
         {
             // an alcsync dl with time was received => update flag
-            smtc_modem_services_ctx.alc_sync_ctx.is_sync_dl_received = true;
+            modem_services->alc_sync_ctx.is_sync_dl_received = true;
 
             increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_TIME, SMTC_MODEM_EVENT_TIME_VALID );
 
             // Remove all alc sync task.
             modem_supervisor_remove_task_clock_sync( );
 
-            if( clock_sync_is_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
+            if( clock_sync_is_enabled( &( modem_services->clock_sync_ctx ) ) == true )
             {
                 int32_t  tmp_rand = 0;
                 uint32_t tmp_delay =
-                    MIN( clock_sync_get_interval_second( &( smtc_modem_services_ctx.clock_sync_ctx ) ),
-                         clock_sync_get_time_left_connection_lost( &( smtc_modem_services_ctx.clock_sync_ctx ) ) );
+                    MIN( clock_sync_get_interval_second( &( modem_services->clock_sync_ctx ) ),
+                         clock_sync_get_time_left_connection_lost( &( modem_services->clock_sync_ctx ) ) );
                 do
                 {
                     tmp_rand = smtc_modem_hal_get_signed_random_nb_in_range( -30, 30 );
@@ -351,12 +355,12 @@ dm_rc_t dm_parse_cmd( dm_cmd_msg_t* cmd_input )
             {
                 // If periodic time request is configured, add task to handle it
 
-                if( clock_sync_is_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
+                if( clock_sync_is_enabled( &( modem_services->clock_sync_ctx ) ) == true )
                 {
                     int32_t  tmp_rand = 0;
                     uint32_t tmp_delay =
-                        MIN( clock_sync_get_interval_second( &( smtc_modem_services_ctx.clock_sync_ctx ) ),
-                             clock_sync_get_time_left_connection_lost( &( smtc_modem_services_ctx.clock_sync_ctx ) ) );
+                        MIN( clock_sync_get_interval_second( &( modem_services->clock_sync_ctx ) ),
+                             clock_sync_get_time_left_connection_lost( &( modem_services->clock_sync_ctx ) ) );
                     do
                     {
                         tmp_rand = smtc_modem_hal_get_signed_random_nb_in_range( -30, 30 );
@@ -45,13 +45,15 @@
 #include "smtc_real.h"
 #include "device_management_defs.h"
 #include "lorawan_api.h"
-#include "modem_utilities.h"  // for crc
+#include "modem_utilities.h"
+#include "modem_crc32.h"
 #include "smtc_modem_api.h"
 #include "smtc_modem_middleware_advanced_api.h"
 #include "smtc_modem_utilities.h"
 #include "alc_sync.h"
 #include "lr1mac_utilities.h"
 #include "modem_supervisor.h"
+#include "smtc_modem_ctx.h"
 
 #if defined( LR1110_MODEM_E )
 #include "pool_mem.h"
@@ -100,187 +102,6 @@ typedef struct modem_context_nvm_idx_s
     uint32_t crc;  // !! crc MUST be the last field of the structure !!
 } modem_context_nvm_t;
 
-#if !defined( LR1110_MODEM_E )
-static int16_t  modem_appkey_status = MODEM_APPKEY_CRC_STATUS_INVALID;
-static uint32_t modem_appkey_crc    = 0;
-static uint8_t  modem_status        = 0;
-static uint8_t  modem_dm_interval   = DEFAULT_DM_REPORTING_INTERVAL;
-static uint8_t  modem_dm_port       = DEFAULT_DM_PORT;
-#if defined( ADD_SMTC_PATCH_UPDATE )
-static uint8_t modem_frag_port = DEFAULT_FRAG_PORT;
-#endif  // ADD_SMTC_PATCH_UPDATE
-static uint8_t                modem_appstatus[8] = { 0 };
-static smtc_modem_class_t     modem_dm_class     = SMTC_MODEM_CLASS_A;
-static modem_suspend_status_t is_modem_suspend   = MODEM_NOT_SUSPEND;
-static uint32_t               modem_start_time   = 0;
-#if defined( ADD_SMTC_FILE_UPLOAD )
-static uint8_t              modem_dm_upload_sctr = 0;
-static modem_upload_state_t modem_upload_state   = MODEM_UPLOAD_NOT_INIT;
-#endif  // ADD_SMTC_FILE_UPLOAD
-#if defined( ADD_SMTC_STREAM )
-static modem_stream_t modem_stream_state = {  //
-    .port       = DEFAULT_DM_PORT,            //
-    .state      = MODEM_STREAM_NOT_INIT,      //
-    .encryption = false
-};
-#endif                                                                            // ADD_SMTC_STREAM
-static uint32_t dm_info_bitfield_periodic         = DEFAULT_DM_REPORTING_FIELDS;  // context for periodic GetInfo
-static uint32_t dm_info_bitfield_now              = 0;                            // User GetInfo
-static uint8_t  tag_number                        = 0;
-static uint8_t  tag_number_now                    = 0;
-static uint8_t  number_of_muted_day               = 0;
-static dm_dl_opportunities_config_t dm_pending_dl = { .up_count = 0, .up_delay = 0 };
-static uint32_t                     user_alarm    = 0x7FFFFFFF;
-static uint8_t                      asynchronous_msgnumber = 0;
-static uint8_t                      modem_event_count[MODEM_NUMBER_OF_EVENTS];
-static uint8_t                      modem_event_status[MODEM_NUMBER_OF_EVENTS];
-static uint8_t                      asynch_msg[MODEM_NUMBER_OF_EVENTS];
-static modem_downlink_msg_t         modem_dwn_pkt;
-static bool                         is_modem_reset_requested    = false;
-static bool                         is_modem_charge_loaded      = false;
-static uint32_t                     modem_charge_offset         = 0;
-static bool                         start_time_was_set          = false;
-static uint16_t                     user_define_charge_counter  = 0;
-static charge_counter_value_t       charge_counter_to_send      = CHARGE_COUNTER_MODEM;
-static rf_output_t                  modem_rf_output             = MODEM_RFO_LP_LF;
-static uint8_t                      duty_cycle_disabled_by_host = false;
-static uint32_t                     crc_fw;
-static smtc_modem_adr_profile_t     modem_adr_profile;
-#if defined( ADD_SMTC_FILE_UPLOAD )
-static uint32_t modem_upload_avgdelay;
-#endif  // ADD_SMTC_FILE_UPLOAD
-static uint16_t             nb_adr_mobile_timeout;
-static bool                 is_modem_in_test_mode = false;
-static int8_t               rx_pathloss_db        = 0;
-static int8_t               tx_power_offset_db    = 0;
-static radio_planner_t*     modem_rp              = NULL;
-static modem_power_config_t power_config_lut[POWER_CONFIG_LUT_SIZE];
-#if defined( SMTC_D2D )
-static modem_context_class_b_d2d_t class_b_d2d_ctx;
-#endif  // SMTC_D2D
-static void ( *modem_lbm_notification_extended_1_callback )( void );
-static void ( *modem_lbm_notification_extended_2_callback )( void );
-static const void* modem_radio_ctx;  // use to save lr11xx user radio context needed to perform direct access to radio
-                                     // withing modem code (almanac update, crypto)
-
-#else
-struct
-{
-    int16_t                      modem_appkey_status;
-    uint32_t                     modem_appkey_crc;
-    uint8_t                      modem_status;
-    uint8_t                      modem_dm_interval;
-    uint8_t                      modem_dm_port;
-#if defined( ADD_SMTC_PATCH_UPDATE )
-    uint8_t                      modem_frag_port;
-#endif  // ADD_SMTC_PATCH_UPDATE
-    uint8_t                      modem_appstatus[8];
-    smtc_modem_class_t           modem_dm_class;
-    modem_suspend_status_t       is_modem_suspend;
-    uint32_t                     modem_start_time;
-#if defined( ADD_SMTC_FILE_UPLOAD )
-    uint8_t                      modem_dm_upload_sctr;
-    modem_upload_state_t         modem_upload_state;
-    uint32_t                     modem_upload_avgdelay;
-#endif  // ADD_SMTC_FILE_UPLOAD
-#if defined( ADD_SMTC_STREAM )
-    modem_stream_t               modem_stream_state;
-#endif  // ADD_SMTC_STREAM
-    uint32_t                     dm_info_bitfield_periodic;  // context for periodic GetInfo
-    uint32_t                     dm_info_bitfield_now;       // User GetInfo
-    uint8_t                      tag_number;
-    uint8_t                      tag_number_now;
-    uint8_t                      number_of_muted_day;
-    dm_dl_opportunities_config_t dm_pending_dl;
-    uint32_t                     user_alarm;
-    uint8_t                      asynchronous_msgnumber;
-    uint8_t                      modem_event_count[MODEM_NUMBER_OF_EVENTS];
-    uint8_t                      modem_event_status[MODEM_NUMBER_OF_EVENTS];
-    uint8_t                      asynch_msg[MODEM_NUMBER_OF_EVENTS];
-    modem_downlink_msg_t         modem_dwn_pkt;
-    bool                         is_modem_reset_requested;
-    bool                         is_modem_charge_loaded;
-    uint32_t                     modem_charge_offset;
-    uint8_t                      start_time_was_set;
-    uint16_t                     user_define_charge_counter;
-    charge_counter_value_t       charge_counter_to_send;
-    rf_output_t                  modem_rf_output;
-    uint8_t                      duty_cycle_disabled_by_host;
-    uint32_t                     crc_fw;
-    smtc_modem_adr_profile_t     modem_adr_profile;
-    uint16_t                     nb_adr_mobile_timeout;
-    bool                         is_modem_in_test_mode;
-    int8_t                       rx_pathloss_db;
-    int8_t                       tx_power_offset_db;
-    radio_planner_t*             modem_rp;
-    modem_power_config_t         power_config_lut[POWER_CONFIG_LUT_SIZE];
-#if defined( ADD_D2D )
-    modem_context_class_b_d2d_t  class_b_d2d_ctx;
-#endif  // ADD_D2D
-    void ( *modem_lbm_notification_extended_1_callback )( void );
-    void ( *modem_lbm_notification_extended_2_callback )( void );
-    const void* modem_radio_ctx;
-} modem_ctx_context;
-
-// clang-format off
-#define  modem_appkey_status                        modem_ctx_context.modem_appkey_status
-#define  modem_appkey_crc                           modem_ctx_context.modem_appkey_crc
-#define  modem_status                               modem_ctx_context.modem_status
-#define  modem_dm_interval                          modem_ctx_context.modem_dm_interval
-#define  modem_dm_port                              modem_ctx_context.modem_dm_port
-#if defined( ADD_SMTC_PATCH_UPDATE )
-#define  modem_frag_port                            modem_ctx_context.modem_frag_port
-#endif  // ADD_SMTC_PATCH_UPDATE
-#define  modem_appstatus                            modem_ctx_context.modem_appstatus
-#define  modem_dm_class                             modem_ctx_context.modem_dm_class
-#define  is_modem_suspend                           modem_ctx_context.is_modem_suspend
-#define  modem_start_time                           modem_ctx_context.modem_start_time
-#if defined( ADD_SMTC_FILE_UPLOAD )
-#define  modem_dm_upload_sctr                       modem_ctx_context.modem_dm_upload_sctr
-#define  modem_upload_state                         modem_ctx_context.modem_upload_state
-#endif // ADD_SMTC_FILE_UPLOAD
-#if defined( ADD_SMTC_STREAM )
-#define  modem_stream_state                         modem_ctx_context.modem_stream_state
-#endif  // ADD_SMTC_STREAM
-#define  dm_info_bitfield_periodic                  modem_ctx_context.dm_info_bitfield_periodic
-#define  dm_info_bitfield_now                       modem_ctx_context.dm_info_bitfield_now
-#define  tag_number                                 modem_ctx_context.tag_number
-#define  tag_number_now                             modem_ctx_context.tag_number_now
-#define  number_of_muted_day                        modem_ctx_context.number_of_muted_day
-#define  dm_pending_dl                              modem_ctx_context.dm_pending_dl
-#define  user_alarm                                 modem_ctx_context.user_alarm
-#define  asynchronous_msgnumber                     modem_ctx_context.asynchronous_msgnumber
-#define  modem_event_count                          modem_ctx_context.modem_event_count
-#define  modem_event_status                         modem_ctx_context.modem_event_status
-#define  asynch_msg                                 modem_ctx_context.asynch_msg
-#define  modem_dwn_pkt                              modem_ctx_context.modem_dwn_pkt
-#define  is_modem_reset_requested                   modem_ctx_context.is_modem_reset_requested
-#define  is_modem_charge_loaded                     modem_ctx_context.is_modem_charge_loaded
-#define  modem_charge_offset                        modem_ctx_context.modem_charge_offset
-#define  start_time_was_set                         modem_ctx_context.start_time_was_set
-#define  user_define_charge_counter                 modem_ctx_context.user_define_charge_counter
-#define  charge_counter_to_send                     modem_ctx_context.charge_counter_to_send
-#define  modem_rf_output                            modem_ctx_context.modem_rf_output
-#define  duty_cycle_disabled_by_host                modem_ctx_context.duty_cycle_disabled_by_host
-#define  crc_fw                                     modem_ctx_context.crc_fw
-#define  modem_adr_profile                          modem_ctx_context.modem_adr_profile
-#if defined ( ADD_SMTC_FILE_UPLOAD )
-#define  modem_upload_avgdelay                      modem_ctx_context.modem_upload_avgdelay
-#endif // ADD_SMTC_FILE_UPLOAD
-#define  nb_adr_mobile_timeout                      modem_ctx_context.nb_adr_mobile_timeout
-#define  is_modem_in_test_mode                      modem_ctx_context.is_modem_in_test_mode
-#define  rx_pathloss_db                             modem_ctx_context.rx_pathloss_db
-#define  tx_power_offset_db                         modem_ctx_context.tx_power_offset_db
-#define  modem_rp                                   modem_ctx_context.modem_rp
-#define  power_config_lut                           modem_ctx_context.power_config_lut
-#define  class_b_d2d_ctx                            modem_ctx_context.class_b_d2d_ctx
-#define modem_lbm_notification_extended_1_callback  modem_ctx_context.modem_lbm_notification_extended_1_callback
-#define modem_lbm_notification_extended_2_callback  modem_ctx_context.modem_lbm_notification_extended_2_callback
-#define modem_radio_ctx                             modem_ctx_context.modem_radio_ctx
-// clang-format on
-
-#endif
-
 // DM info field sizes
 static const uint8_t dm_info_field_sz[DM_INFO_MAX] = {
     [DM_INFO_STATUS] = 1,    [DM_INFO_CHARGE] = 2,    [DM_INFO_VOLTAGE] = 1,  [DM_INFO_TEMP] = 1,
@@ -360,62 +181,65 @@ static dm_cmd_length_valid_t check_dm_status_max_size( uint32_t info_requested,
 
 void modem_context_init( )
 {
-    modem_status      = 0;
-    modem_dm_interval = DEFAULT_DM_REPORTING_INTERVAL;
-    modem_dm_port     = DEFAULT_DM_PORT;
+    modem_context_ctx_t*      modem_ctx = &smtc_modem_current_ctx->context;
+    smtc_modem_ctx_buffers_t* buffers   = &smtc_modem_current_ctx->buffers;
+
+    modem_ctx->modem_status      = 0;
+    modem_ctx->modem_dm_interval = DEFAULT_DM_REPORTING_INTERVAL;
+    modem_ctx->modem_dm_port     = DEFAULT_DM_PORT;
 #if defined( ADD_SMTC_PATCH_UPDATE )
-    modem_frag_port = DEFAULT_FRAG_PORT;
+    modem_ctx->modem_frag_port = DEFAULT_FRAG_PORT;
 #endif  // ADD_SMTC_PATCH_UPDATE
-    modem_dm_class   = SMTC_MODEM_CLASS_A;
-    is_modem_suspend = MODEM_NOT_SUSPEND;
-    modem_start_time = 0;
+    modem_ctx->modem_dm_class   = SMTC_MODEM_CLASS_A;
+    modem_ctx->is_modem_suspend = MODEM_NOT_SUSPEND;
+    modem_ctx->modem_start_time = 0;
 #if defined( ADD_SMTC_FILE_UPLOAD )
-    modem_dm_upload_sctr = 0;
-    modem_upload_state   = MODEM_UPLOAD_NOT_INIT;
+    modem_ctx->modem_dm_upload_sctr = 0;
+    modem_ctx->modem_upload_state   = MODEM_UPLOAD_NOT_INIT;
 #endif  // ADD_SMTC_FILE_UPLOAD
 #if defined( ADD_SMTC_STREAM )
-    modem_stream_state.port       = DEFAULT_DM_PORT;
-    modem_stream_state.state      = MODEM_STREAM_NOT_INIT;
-    modem_stream_state.encryption = false;
+    modem_ctx->modem_stream_state.port       = DEFAULT_DM_PORT;
+    modem_ctx->modem_stream_state.state      = MODEM_STREAM_NOT_INIT;
+    modem_ctx->modem_stream_state.encryption = false;
 #endif                                                          // ADD_SMTC_STREAM
-    dm_info_bitfield_periodic   = DEFAULT_DM_REPORTING_FIELDS;  // context for periodic GetInfo
-    dm_info_bitfield_now        = 0;                            // User GetInfo
-    tag_number                  = 0;
-    tag_number_now              = 0;
-    number_of_muted_day         = 0;
-    dm_pending_dl.up_count      = 0;
-    dm_pending_dl.up_delay      = 0;
-    user_alarm                  = 0;
-    asynchronous_msgnumber      = 0;
-    is_modem_reset_requested    = false;
-    is_modem_charge_loaded      = false;
-    modem_charge_offset         = 0;
-    start_time_was_set          = false;
-    user_define_charge_counter  = 0;
-    charge_counter_to_send      = CHARGE_COUNTER_MODEM;
-    modem_rf_output             = MODEM_RFO_LP_LF;
-    duty_cycle_disabled_by_host = false;
-    crc_fw                      = compute_crc_fw( );
-    modem_adr_profile           = SMTC_MODEM_ADR_PROFILE_NETWORK_CONTROLLED;
+    modem_ctx->dm_info_bitfield_periodic   = DEFAULT_DM_REPORTING_FIELDS;  // context for periodic GetInfo
+    modem_ctx->dm_info_bitfield_now        = 0;                            // User GetInfo
+    modem_ctx->tag_number                  = 0;
+    modem_ctx->tag_number_now              = 0;
+    modem_ctx->number_of_muted_day         = 0;
+    modem_ctx->dm_pending_dl.up_count      = 0;
+    modem_ctx->dm_pending_dl.up_delay      = 0;
+    modem_ctx->user_alarm                  = 0;
+    modem_ctx->asynchronous_msgnumber      = 0;
+    modem_ctx->is_modem_reset_requested    = false;
+    modem_ctx->is_modem_charge_loaded      = false;
+    modem_ctx->modem_charge_offset         = 0;
+    modem_ctx->start_time_was_set          = false;
+    modem_ctx->user_define_charge_counter  = 0;
+    modem_ctx->charge_counter_to_send      = CHARGE_COUNTER_MODEM;
+    modem_ctx->modem_rf_output             = MODEM_RFO_LP_LF;
+    modem_ctx->duty_cycle_disabled_by_host = false;
+    modem_ctx->crc_fw                      = compute_crc_fw( );
+    modem_ctx->modem_adr_profile           = SMTC_MODEM_ADR_PROFILE_NETWORK_CONTROLLED;
 #if defined( ADD_SMTC_FILE_UPLOAD )
-    modem_upload_avgdelay = 0;
+    modem_ctx->modem_upload_avgdelay = 0;
 #endif  // ADD_SMTC_FILE_UPLOAD
-    nb_adr_mobile_timeout = DEFAULT_ADR_MOBILE_MODE_TIMEOUT;
-    is_modem_in_test_mode = false;
-    rx_pathloss_db        = 0;
-    tx_power_offset_db    = 0;
-    modem_rp              = NULL;
-    modem_appkey_status   = MODEM_APPKEY_CRC_STATUS_INVALID;
-    modem_appkey_crc      = 0;
-    memset( modem_appstatus, 0, 8 );
-    memset( modem_event_count, 0, MODEM_NUMBER_OF_EVENTS );
-    memset( modem_event_status, 0, MODEM_NUMBER_OF_EVENTS );
-    memset( asynch_msg, 0, MODEM_NUMBER_OF_EVENTS );
-    memset( &modem_dwn_pkt, 0, sizeof( modem_downlink_msg_t ) );
+    modem_ctx->nb_adr_mobile_timeout = DEFAULT_ADR_MOBILE_MODE_TIMEOUT;
+    modem_ctx->is_modem_in_test_mode = false;
+    modem_ctx->rx_pathloss_db        = 0;
+    modem_ctx->tx_power_offset_db    = 0;
+    modem_ctx->modem_rp              = NULL;
+    modem_ctx->modem_appkey_status   = MODEM_APPKEY_CRC_STATUS_INVALID;
+    modem_ctx->modem_appkey_crc      = 0;
+    memset( modem_ctx->modem_appstatus, 0, 8 );
+    memset( modem_ctx->modem_event_count, 0, MODEM_NUMBER_OF_EVENTS );
+    memset( modem_ctx->modem_event_status, 0, MODEM_NUMBER_OF_EVENTS );
+    memset( modem_ctx->asynch_msg, 0, MODEM_NUMBER_OF_EVENTS );
+    memset( &buffers->modem_dwn_pkt, 0, sizeof( modem_downlink_msg_t ) );
     // init power config tab to 0x80 as it corresponds to an expected power of 128dbm, value that is never reached
-    memset( power_config_lut, 0x80, POWER_CONFIG_LUT_SIZE * sizeof( modem_power_config_t ) );
+    memset( modem_ctx->power_config_lut, 0x80, POWER_CONFIG_LUT_SIZE * sizeof( modem_power_config_t ) );
 #if defined( ADD_D2D )
-    memset( &class_b_d2d_ctx, 0, sizeof( modem_context_class_b_d2d_t ) );
+    memset( &modem_ctx->class_b_d2d_ctx, 0, sizeof( modem_context_class_b_d2d_t ) );
 #endif  // ADD_D2D
 }
 
@@ -429,66 +253,79 @@ void modem_event_init( void )
 
 uint8_t get_modem_event_count( uint8_t event_type )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( event_type >= MODEM_NUMBER_OF_EVENTS )
     {
         smtc_modem_hal_mcu_panic( );
     }
 
-    return ( modem_event_count[event_type] );
+    return ( modem_ctx->modem_event_count[event_type] );
 }
 
 uint8_t get_modem_event_status( uint8_t event_type )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( event_type >= MODEM_NUMBER_OF_EVENTS )
     {
         smtc_modem_hal_mcu_panic( );
     }
-    return ( modem_event_status[event_type] );
+    return ( modem_ctx->modem_event_status[event_type] );
 }
 
 void set_modem_event_count_and_status( uint8_t event_type, uint8_t value, uint8_t status )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( event_type < MODEM_NUMBER_OF_EVENTS )
     {
-        modem_event_count[event_type]  = value;
-        modem_event_status[event_type] = status;
+        modem_ctx->modem_event_count[event_type]  = value;
+        modem_ctx->modem_event_status[event_type] = status;
     }
 }
 
 void increment_modem_event_count_and_status( uint8_t event_type, uint8_t status )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( event_type < MODEM_NUMBER_OF_EVENTS )
     {
-        if( modem_event_count[event_type] < 255 )
+        if( modem_ctx->modem_event_count[event_type] < 255 )
         {
-            modem_event_count[event_type]++;
+            modem_ctx->modem_event_count[event_type]++;
         }
         // Set last status even if the number of event max is reached
-        modem_event_status[event_type] = status;
+        modem_ctx->modem_event_status[event_type] = status;
     }
 }
 
 void decrement_asynchronous_msgnumber( void )
 {
-    if( asynchronous_msgnumber > 0 )
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    if( modem_ctx->asynchronous_msgnumber > 0 )
     {
-        asynchronous_msgnumber--;
+        modem_ctx->asynchronous_msgnumber--;
     }
     else
     {
-        asynchronous_msgnumber = 0;
+        modem_ctx->asynchronous_msgnumber = 0;
     }
 }
 
 uint8_t get_asynchronous_msgnumber( void )
 {
-    return ( asynchronous_msgnumber );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->asynchronous_msgnumber );
 }
 
 void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     // Next condition should never append because only one asynch msg by type of message
-    if( asynchronous_msgnumber > MODEM_NUMBER_OF_EVENTS )
+    if( modem_ctx->asynchronous_msgnumber > MODEM_NUMBER_OF_EVENTS )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( " Modem reach the max number of asynch message\n" );
         return;
@@ -497,8 +334,8 @@ void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status )
     tmp = get_modem_event_count( event_type );
     if( tmp == 0 )
     {
-        asynchronous_msgnumber++;
-        asynch_msg[asynchronous_msgnumber] = event_type;
+        modem_ctx->asynchronous_msgnumber++;
+        modem_ctx->asynch_msg[modem_ctx->asynchronous_msgnumber] = event_type;
     }
 
     increment_modem_event_count_and_status( event_type, status );
@@ -506,35 +343,42 @@ void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status )
 
 uint8_t get_last_msg_event( void )
 {
-    return asynch_msg[asynchronous_msgnumber];
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->asynch_msg[modem_ctx->asynchronous_msgnumber];
 }
 
 uint32_t get_modem_uptime_s( void )
 {
-    return ( smtc_modem_hal_get_time_in_s( ) - modem_start_time );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( smtc_modem_hal_get_time_in_s( ) - modem_ctx->modem_start_time );
 }
 
 void set_modem_start_time_s( uint32_t time )
 {
-    if( !start_time_was_set )
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    if( !modem_ctx->start_time_was_set )
     {
-        start_time_was_set = true;
-        modem_start_time   = time;
+        modem_ctx->start_time_was_set = true;
+        modem_ctx->modem_start_time   = time;
     }
 }
 
 dm_rc_t set_modem_dm_interval( uint8_t interval )
 {
-    if( modem_dm_interval != interval )
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    if( modem_ctx->modem_dm_interval != interval )
     {
-        modem_dm_interval = interval;
+        modem_ctx->modem_dm_interval = interval;
     }
 
     return ( DM_OK );
 }
 uint8_t get_modem_dm_interval( void )
 {
-    return ( modem_dm_interval );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_dm_interval );
 }
 uint32_t get_modem_dm_interval_second( void )
 {
@@ -563,16 +407,20 @@ uint32_t get_modem_dm_interval_second( void )
 
 void set_modem_class( smtc_modem_class_t lorawan_class )
 {
-    modem_dm_class = lorawan_class;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_dm_class = lorawan_class;
 }
 
 smtc_modem_class_t get_modem_class( void )
 {
-    return ( modem_dm_class );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_dm_class );
 }
 
 dm_rc_t set_modem_dm_port( uint8_t port )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( ( port == 0 ) || ( port >= 224 ) )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "modem port invalid\n" );
@@ -580,9 +428,9 @@ dm_rc_t set_modem_dm_port( uint8_t port )
     }
     else
     {
-        if( modem_dm_port != port )
+        if( modem_ctx->modem_dm_port != port )
         {
-            modem_dm_port = port;
+            modem_ctx->modem_dm_port = port;
             modem_store_context( );
         }
         return ( DM_OK );
@@ -591,7 +439,8 @@ dm_rc_t set_modem_dm_port( uint8_t port )
 
 uint8_t get_modem_dm_port( void )
 {
-    return ( modem_dm_port );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_dm_port );
 }
 
 #if defined( ADD_SMTC_PATCH_UPDATE )
@@ -603,13 +452,15 @@ dm_rc_t set_modem_frag_port( uint8_t port )
 
 uint8_t get_modem_frag_port( void )
 {
-    return ( modem_frag_port );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_frag_port );
 }
 #endif  // ADD_SMTC_PATCH_UPDATE
 
 smtc_modem_adr_profile_t get_modem_adr_profile( void )
 {
-    return modem_adr_profile;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->modem_adr_profile;
 }
 
 uint8_t get_modem_region( void )
@@ -646,12 +497,14 @@ modem_join_state_t get_join_state( void )
 
 void set_modem_appstatus( const uint8_t* app_status )
 {
-    memcpy( modem_appstatus, app_status, dm_info_field_sz[DM_INFO_APPSTATUS] );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    memcpy( modem_ctx->modem_appstatus, app_status, dm_info_field_sz[DM_INFO_APPSTATUS] );
 }
 
 void get_modem_appstatus( uint8_t* app_status )
 {
-    memcpy( app_status, modem_appstatus, dm_info_field_sz[DM_INFO_APPSTATUS] );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    memcpy( app_status, modem_ctx->modem_appstatus, dm_info_field_sz[DM_INFO_APPSTATUS] );
 }
 
 void modem_supervisor_add_task_join( void )
@@ -660,29 +513,35 @@ void modem_supervisor_add_task_join( void )
     task_join.id       = JOIN_TASK;
     task_join.priority = TASK_HIGH_PRIORITY;
 
-    uint32_t current_time_s = smtc_modem_hal_get_time_in_s( );
-
-    task_join.time_to_execute_s = smtc_modem_hal_get_random_nb_in_range( 0, 5 );
+    uint32_t jitter_ms = smtc_modem_hal_get_random_nb_in_range( 0, 5000 );
+    uint32_t delay_s   = 0;
+    uint32_t delay_ms  = 0;
 
 #if defined( TEST_BYPASS_JOIN_DUTY_CYCLE )
     SMTC_MODEM_HAL_TRACE_WARNING( "BYPASS JOIN DUTY CYCLE activated\n" );
-    task_join.time_to_execute_s += current_time_s;
+    delay_ms = jitter_ms;
 #else
     if( lorawan_api_modem_certification_is_enabled( ) == false )
     {
         // current time is already taken in count in lr1mac time computation
-        task_join.time_to_execute_s += lorawan_api_next_join_time_second_get( );
+        int32_t join_delay_s =
+            ( int32_t )( lorawan_api_next_join_time_second_get( ) - smtc_modem_hal_get_time_in_s( ) );
+        if( join_delay_s > 0 )
+        {
+            delay_s  = join_delay_s;
+            delay_ms = jitter_ms;
+        }
     }
 #endif
+    modem_supervisor_set_task_delay( &task_join, delay_s, delay_ms );
 
-    if( ( int32_t )( task_join.time_to_execute_s - current_time_s ) <= 0 )
+    if( ( delay_s == 0 ) && ( delay_ms == 0 ) )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( " Start a new join sequence now \n" );
     }
     else
     {
-        SMTC_MODEM_HAL_TRACE_PRINTF( " Start a new join sequence in %d seconds \n",
-                                     task_join.time_to_execute_s - current_time_s );
+        SMTC_MODEM_HAL_TRACE_PRINTF( " Start a new join sequence in %d seconds \n", delay_s + ( delay_ms / 1000 ) );
     }
 
     set_modem_status_joining( true );
@@ -692,10 +551,10 @@ void modem_supervisor_add_task_join( void )
 void modem_supervisor_add_task_dm_status( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = DM_TASK;
-    task_dm.priority          = TASK_LOW_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute;
+    task_dm.id         = DM_TASK;
+    task_dm.priority   = TASK_LOW_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, next_execute, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -705,21 +564,23 @@ void modem_supervisor_add_task_dm_status( uint32_t next_execute )
 void modem_supervisor_add_task_dm_status_now( void )
 {
     smodem_task task_dm;
-    task_dm.id                = DM_TASK_NOW;
-    task_dm.priority          = TASK_LOW_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) +
-                                smtc_modem_hal_get_random_nb_in_range( DM_STATUS_NOW_MIN_TIME, DM_STATUS_NOW_MAX_TIME );
+    task_dm.id         = DM_TASK_NOW;
+    task_dm.priority   = TASK_LOW_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay(
+        &task_dm, 0,
+        smtc_modem_hal_get_random_nb_in_range( DM_STATUS_NOW_MIN_TIME * 1000, DM_STATUS_NOW_MAX_TIME * 1000 ) );
     modem_supervisor_add_task( &task_dm );
 }
 void modem_supervisor_add_task_crash_log( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = CRASH_LOG_TASK;
-    task_dm.priority          = TASK_LOW_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute +
-                                smtc_modem_hal_get_random_nb_in_range( DM_STATUS_NOW_MIN_TIME, DM_STATUS_NOW_MAX_TIME );
+    task_dm.id         = CRASH_LOG_TASK;
+    task_dm.priority   = TASK_LOW_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay(
+        &task_dm, next_execute,
+        smtc_modem_hal_get_random_nb_in_range( DM_STATUS_NOW_MIN_TIME * 1000, DM_STATUS_NOW_MAX_TIME * 1000 ) );
     modem_supervisor_add_task( &task_dm );
 }
 
@@ -727,10 +588,10 @@ void modem_supervisor_add_task_crash_log( uint32_t next_execute )
 void modem_supervisor_add_task_clock_sync_time_req( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = CLOCK_SYNC_TIME_REQ_TASK;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute;
+    task_dm.id         = CLOCK_SYNC_TIME_REQ_TASK;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, next_execute, 0 );
 
     modem_supervisor_add_task( &task_dm );
 }
@@ -760,10 +621,10 @@ bool modem_supervisor_is_clock_sync_running( void )
 void modem_supervisor_add_task_alc_sync_ans( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = ALC_SYNC_ANS_TASK;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute;
+    task_dm.id         = ALC_SYNC_ANS_TASK;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, next_execute, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -774,10 +635,10 @@ void modem_supervisor_add_task_alc_sync_ans( uint32_t next_execute )
 void modem_supervisor_add_task_alm_dbg_ans( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = DM_ALM_DBG_ANS;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute;
+    task_dm.id         = DM_ALM_DBG_ANS;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, next_execute, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -787,20 +648,20 @@ void modem_supervisor_add_task_alm_dbg_ans( uint32_t next_execute )
 void modem_supervisor_add_task_modem_mute( void )
 {
     smodem_task task_dm;
-    task_dm.id                = MUTE_TASK;
-    task_dm.priority          = TASK_MEDIUM_HIGH_PRIORITY;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + 86400;  // Every 24h
+    task_dm.id       = MUTE_TASK;
+    task_dm.priority = TASK_MEDIUM_HIGH_PRIORITY;
+    modem_supervisor_set_task_delay( &task_dm, 86400, 0 );  // Every 24h
     modem_supervisor_add_task( &task_dm );
 }
 
 void modem_supervisor_add_task_retrieve_dl( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = RETRIEVE_DL_TASK;
-    task_dm.priority          = TASK_LOW_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.sizeIn            = 0;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute;
+    task_dm.id         = RETRIEVE_DL_TASK;
+    task_dm.priority   = TASK_LOW_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    task_dm.sizeIn     = 0;
+    modem_supervisor_set_task_delay( &task_dm, next_execute, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -810,10 +671,10 @@ void modem_supervisor_add_task_retrieve_dl( uint32_t next_execute )
 void modem_supervisor_add_task_frag( uint32_t next_execute )
 {
     smodem_task task_dm;
-    task_dm.id                = FRAG_TASK;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + next_execute;
+    task_dm.id         = FRAG_TASK;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, next_execute, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -827,11 +688,11 @@ void modem_supervisor_add_task_stream( void )
     // so this is safe even when it is going to be invalidated.
     smodem_task stream_task;
 
-    stream_task.id                = STREAM_TASK;
-    stream_task.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + smtc_modem_hal_get_random_nb_in_range( 1, 3 );
-    stream_task.priority          = TASK_HIGH_PRIORITY;
-    stream_task.fPort             = modem_get_stream_port( );
-    stream_task.fPort_present     = true;
+    stream_task.id            = STREAM_TASK;
+    stream_task.priority      = TASK_HIGH_PRIORITY;
+    stream_task.fPort         = modem_get_stream_port( );
+    stream_task.fPort_present = true;
+    modem_supervisor_set_task_delay( &stream_task, 0, smtc_modem_hal_get_random_nb_in_range( 1000, 3000 ) );
     // stream_task.dataIn        not used in task
     // stream_task.sizeIn        not used in task
     // stream_task.PacketType    not used in task
@@ -846,9 +707,9 @@ void modem_supervisor_add_task_file_upload( uint32_t delay_in_s )
 {
     smodem_task upload_task;
 
-    upload_task.id                = FILE_UPLOAD_TASK;
-    upload_task.priority          = TASK_HIGH_PRIORITY;
-    upload_task.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + delay_in_s;
+    upload_task.id       = FILE_UPLOAD_TASK;
+    upload_task.priority = TASK_HIGH_PRIORITY;
+    modem_supervisor_set_task_delay( &upload_task, delay_in_s, 0 );
 
     modem_supervisor_add_task( &upload_task );
 }
@@ -857,10 +718,10 @@ void modem_supervisor_add_task_file_upload( uint32_t delay_in_s )
 void modem_supervisor_add_task_link_check_req( uint32_t delay_in_s )
 {
     smodem_task task_dm;
-    task_dm.id                = LINK_CHECK_REQ_TASK;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + delay_in_s;
+    task_dm.id         = LINK_CHECK_REQ_TASK;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, delay_in_s, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -870,10 +731,10 @@ void modem_supervisor_add_task_link_check_req( uint32_t delay_in_s )
 void modem_supervisor_add_task_device_time_req( uint32_t delay_in_s )
 {
     smodem_task task_dm;
-    task_dm.id                = DEVICE_TIME_REQ_TASK;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + delay_in_s;
+    task_dm.id         = DEVICE_TIME_REQ_TASK;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, delay_in_s, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -883,10 +744,10 @@ void modem_supervisor_add_task_device_time_req( uint32_t delay_in_s )
 void modem_supervisor_add_task_ping_slot_info_req( uint32_t delay_in_s )
 {
     smodem_task task_dm;
-    task_dm.id                = PING_SLOT_INFO_REQ_TASK;
-    task_dm.priority          = TASK_HIGH_PRIORITY;
-    task_dm.PacketType        = UNCONF_DATA_UP;
-    task_dm.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + delay_in_s;
+    task_dm.id         = PING_SLOT_INFO_REQ_TASK;
+    task_dm.priority   = TASK_HIGH_PRIORITY;
+    task_dm.PacketType = UNCONF_DATA_UP;
+    modem_supervisor_set_task_delay( &task_dm, delay_in_s, 0 );
     if( get_join_state( ) == MODEM_JOINED )
     {
         modem_supervisor_add_task( &task_dm );
@@ -895,12 +756,14 @@ void modem_supervisor_add_task_ping_slot_info_req( uint32_t delay_in_s )
 
 uint8_t get_modem_status( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     // If the stack is no more join, the modem status was not aware of the disconnection
     if( get_join_state( ) != MODEM_JOINED )
     {
         set_modem_status_modem_joined( false );
     }
-    return ( modem_status );
+    return ( modem_ctx->modem_status );
 }
 
 void get_modem_gnss_status( uint8_t* gnss_status )
@@ -908,8 +771,10 @@ void get_modem_gnss_status( uint8_t* gnss_status )
 #if defined( LR1110_MODEM_E ) && defined( _MODEM_E_GNSS_ENABLE )
     Gnss_context_status( gnss_status );
 #elif defined( LR11XX_TRANSCEIVER ) && defined( ENABLE_MODEM_GNSS_FEATURE )
-    uint8_t buffer_response[ALM_UPDATE_UPLINK_PAYLOAD_LENGTH];
-    almanac_update_create_uplink_payload( modem_radio_ctx, buffer_response );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    uint8_t              buffer_response[ALM_UPDATE_UPLINK_PAYLOAD_LENGTH];
+
+    almanac_update_create_uplink_payload( modem_ctx->modem_radio_ctx, buffer_response );
     // Discard first byte as it is already handle by the dm uplink process in modem_context
     memcpy( gnss_status, &buffer_response[1], ALM_UPDATE_UPLINK_PAYLOAD_LENGTH - 1 );
 #endif
@@ -917,84 +782,106 @@ void get_modem_gnss_status( uint8_t* gnss_status )
 
 void set_modem_status_reset_after_brownout( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_BROWNOUT ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_BROWNOUT ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_BROWNOUT ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_BROWNOUT ) );
 }
 
 void set_modem_status_reset_after_crash( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_CRASH ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_CRASH ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_CRASH ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_CRASH ) );
 }
 
 void set_modem_status_modem_mute( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_MUTE ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_MUTE ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_MUTE ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_MUTE ) );
 }
 
 void set_modem_status_modem_joined( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_JOINED ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_JOINED ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_JOINED ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_JOINED ) );
 }
 
 void set_modem_status_radio_suspend( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_SUSPEND ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_SUSPEND ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_SUSPEND ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_SUSPEND ) );
 }
 
 void set_modem_status_file_upload( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_UPLOAD ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_UPLOAD ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_UPLOAD ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_UPLOAD ) );
 }
 
 void set_modem_status_joining( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_JOINING ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_JOINING ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_JOINING ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_JOINING ) );
 }
 
 void set_modem_status_streaming( bool value )
 {
-    modem_status = ( value == true ) ? ( modem_status | ( 1 << MODEM_STATUS_OFFSET_STREAMING ) )
-                                     : ( modem_status & ~( 1 << MODEM_STATUS_OFFSET_STREAMING ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_status = ( value == true ) ? ( modem_ctx->modem_status | ( 1 << MODEM_STATUS_OFFSET_STREAMING ) )
+                                     : ( modem_ctx->modem_status & ~( 1 << MODEM_STATUS_OFFSET_STREAMING ) );
 }
 
 bool get_modem_status_reset_after_crash( void )
 {
-    return ( ( modem_status >> MODEM_STATUS_OFFSET_CRASH ) & 0x01 );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( ( modem_ctx->modem_status >> MODEM_STATUS_OFFSET_CRASH ) & 0x01 );
 }
 
 bool get_modem_status_file_upload( void )
 {
-    return ( ( modem_status >> MODEM_STATUS_OFFSET_UPLOAD ) & 0x01 );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( ( modem_ctx->modem_status >> MODEM_STATUS_OFFSET_UPLOAD ) & 0x01 );
 }
 
 bool get_modem_status_joining( void )
 {
-    return ( ( modem_status >> MODEM_STATUS_OFFSET_JOINING ) & 0x01 );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( ( modem_ctx->modem_status >> MODEM_STATUS_OFFSET_JOINING ) & 0x01 );
 }
 
 bool get_modem_status_streaming( void )
 {
-    return ( ( modem_status >> MODEM_STATUS_OFFSET_STREAMING ) & 0x01 );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( ( modem_ctx->modem_status >> MODEM_STATUS_OFFSET_STREAMING ) & 0x01 );
 }
 
 void reset_modem_charge( void )
 {
     radio_planner_t* rp = modem_context_get_modem_rp( );
-    rp_stats_init( &rp->stats );
+    rp_reset_stats( rp );
 }
 
 uint32_t get_modem_charge_ma_s( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     radio_planner_t* rp = modem_context_get_modem_rp( );
     uint32_t         total_consumption =
         rp->stats.tx_total_consumption_ma + rp->stats.rx_total_consumption_ma + rp->stats.none_total_consumption_ma;
-    return ( ( total_consumption / 1000 ) + modem_charge_offset );
+    return ( ( total_consumption / 1000 ) + modem_ctx->modem_charge_offset );
 }
 
 uint32_t get_modem_charge_ma_h( void )
@@ -1004,27 +891,32 @@ uint32_t get_modem_charge_ma_h( void )
 
 uint16_t get_modem_user_define_charge_ma_h( void )
 {
-    return user_define_charge_counter;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->user_define_charge_counter;
 }
 
 void set_modem_user_define_charge_ma_h( const uint16_t value )
 {
-    user_define_charge_counter = value;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->user_define_charge_counter = value;
 }
 
 void choose_modem_charge_counter( void )
 {
-    charge_counter_to_send = CHARGE_COUNTER_MODEM;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->charge_counter_to_send = CHARGE_COUNTER_MODEM;
 }
 
 void choose_user_define_charge_counter( void )
 {
-    charge_counter_to_send = CHARGE_COUNTER_USER_DEFINE;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->charge_counter_to_send = CHARGE_COUNTER_USER_DEFINE;
 }
 
 charge_counter_value_t get_charge_counter_to_send( void )
 {
-    return charge_counter_to_send;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->charge_counter_to_send;
 }
 
 uint8_t get_modem_voltage( void )
@@ -1055,6 +947,8 @@ dm_cmd_length_valid_t dm_check_dminfo_size( dm_info_field_t cmd, uint8_t length
 
 dm_rc_t dm_set_conf( dm_info_field_t tag, uint8_t* data, uint8_t length )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     dm_rc_t ret = DM_OK;
 
     if( dm_check_dminfo_size( tag, length ) != DM_CMD_LENGTH_VALID )
@@ -1068,7 +962,7 @@ dm_rc_t dm_set_conf( dm_info_field_t tag, uint8_t* data, uint8_t length )
         {
         case DM_INFO_ADRMODE: {
             // update modem context adr
-            modem_adr_profile = ( smtc_modem_adr_profile_t ) data[0];
+            modem_ctx->modem_adr_profile = ( smtc_modem_adr_profile_t ) data[0];
 
             status_lorawan_t status = lorawan_api_dr_strategy_set( ( dr_strategy_t ) data[0] );
             if( status == ERRORLORAWAN )
@@ -1108,13 +1002,15 @@ dm_rc_t dm_set_conf( dm_info_field_t tag, uint8_t* data, uint8_t length )
 
 modem_mute_status_t get_modem_muted( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     modem_mute_status_t mute;
 
-    if( number_of_muted_day == MODEM_INFINITE_MUTE )
+    if( modem_ctx->number_of_muted_day == MODEM_INFINITE_MUTE )
     {
         mute = MODEM_INFINITE_MUTE;
     }
-    else if( number_of_muted_day > 0 )
+    else if( modem_ctx->number_of_muted_day > 0 )
     {
         mute = MODEM_TEMPORARY_MUTE;
     }
@@ -1127,17 +1023,20 @@ modem_mute_status_t get_modem_muted( void )
 
 uint8_t dm_get_number_of_days_mute( void )
 {
-    return number_of_muted_day;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->number_of_muted_day;
 }
 
 void dm_set_number_of_days_mute( uint8_t days )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     SMTC_MODEM_HAL_TRACE_PRINTF( "MUTE for %d days\n", days );
-    if( number_of_muted_day != days )
+    if( modem_ctx->number_of_muted_day != days )
     {
-        number_of_muted_day = days;
+        modem_ctx->number_of_muted_day = days;
 
-        if( number_of_muted_day > 0 )
+        if( modem_ctx->number_of_muted_day > 0 )
         {
             set_modem_status_modem_mute( true );
         }
@@ -1150,16 +1049,18 @@ void dm_set_number_of_days_mute( uint8_t days )
 
 uint8_t get_dm_info_tag_list( uint8_t* dm, dm_info_rate_t flag )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     uint8_t* p = dm;
     uint32_t info_req;
 
     if( flag == DM_INFO_NOW )
     {
-        info_req = dm_info_bitfield_now;
+        info_req = modem_ctx->dm_info_bitfield_now;
     }
     else
     {
-        info_req = dm_info_bitfield_periodic;
+        info_req = modem_ctx->dm_info_bitfield_periodic;
     }
 
     for( uint8_t i = 0; i < DM_INFO_MAX; i++ )
@@ -1174,6 +1075,8 @@ uint8_t get_dm_info_tag_list( uint8_t* dm, dm_info_rate_t flag )
 
 dm_rc_t set_dm_info( const uint8_t* requested_info_list, uint8_t len, dm_info_rate_t flag )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     dm_rc_t  ret      = DM_OK;
     uint32_t info_req = 0;
 
@@ -1213,16 +1116,16 @@ dm_rc_t set_dm_info( const uint8_t* requested_info_list, uint8_t len, dm_info_ra
         convert_requested_dm_info_bytes_to_bitfield( requested_info_list, len, &info_req );
         if( flag == DM_INFO_NOW )
         {
-            dm_info_bitfield_now = info_req;
-            tag_number_now       = 0;  // Reset tag_number used by dm_status_payload to
+            modem_ctx->dm_info_bitfield_now = info_req;
+            modem_ctx->tag_number_now       = 0;  // Reset tag_number used by dm_status_payload to
                                        // start a report from beginning
         }
         else
         {
-            if( dm_info_bitfield_periodic != info_req )
+            if( modem_ctx->dm_info_bitfield_periodic != info_req )
             {
-                dm_info_bitfield_periodic = info_req;
-                tag_number                = 0;  // Reset tag_number used by dm_status_payload to start
+                modem_ctx->dm_info_bitfield_periodic = info_req;
+                modem_ctx->tag_number                = 0;  // Reset tag_number used by dm_status_payload to start
                                                 // a report from beginning
             }
         }
@@ -1234,6 +1137,8 @@ dm_rc_t set_dm_info( const uint8_t* requested_info_list, uint8_t len, dm_info_ra
 bool dm_status_payload( uint8_t* dm_uplink_message, uint8_t* dm_uplink_message_len, uint8_t max_size,
                         dm_info_rate_t flag )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     uint8_t* p_tmp = dm_uplink_message;
     uint8_t* p     = dm_uplink_message;
     uint32_t info_requested;
@@ -1243,14 +1148,14 @@ bool dm_status_payload( uint8_t* dm_uplink_message, uint8_t* dm_uplink_message_l
     // Used DM code given in parameter
     if( flag == DM_INFO_NOW )
     {
-        info_requested = dm_info_bitfield_now;
-        tag            = &tag_number_now;
+        info_requested = modem_ctx->dm_info_bitfield_now;
+        tag            = &modem_ctx->tag_number_now;
         // Used DM code in context
     }
     else
     {
-        info_requested = dm_info_bitfield_periodic;
-        tag            = &tag_number;
+        info_requested = modem_ctx->dm_info_bitfield_periodic;
+        tag            = &modem_ctx->tag_number;
     }
 
     if( check_dm_status_max_size( info_requested, max_size ) != DM_CMD_LENGTH_VALID )
@@ -1333,10 +1238,10 @@ bool dm_status_payload( uint8_t* dm_uplink_message, uint8_t* dm_uplink_message_l
 #if defined( LR1110_MODEM_E ) && defined( ADD_SMTC_PATCH_UPDATE )
                 // return the crc value of fuota dedicated for test have to be
                 // re implement when fuota availble
-                *( p_tmp + 0 ) = crc_fw & 0xFF;
-                *( p_tmp + 1 ) = ( crc_fw >> 8 ) & 0xFF;
-                *( p_tmp + 2 ) = ( crc_fw >> 16 ) & 0xFF;
-                *( p_tmp + 3 ) = ( crc_fw >> 24 ) & 0xFF;
+                *( p_tmp + 0 ) = modem_ctx->crc_fw & 0xFF;
+                *( p_tmp + 1 ) = ( modem_ctx->crc_fw >> 8 ) & 0xFF;
+                *( p_tmp + 2 ) = ( modem_ctx->crc_fw >> 16 ) & 0xFF;
+                *( p_tmp + 3 ) = ( modem_ctx->crc_fw >> 24 ) & 0xFF;
                 *( p_tmp + 4 ) = frag_get_session_counter( ) & 0xFF;
                 *( p_tmp + 5 ) = ( frag_get_session_counter( ) >> 8 ) & 0xFF;
                 *( p_tmp + 6 ) = frag_get_nb_frag_received( ) & 0xFF;
@@ -1392,7 +1297,7 @@ bool dm_status_payload( uint8_t* dm_uplink_message, uint8_t* dm_uplink_message_l
 #if defined( USE_LR11XX_CE )
                 // lr11xx operation needed: suspend modem radio access to secure this direct access
                 modem_context_suspend_radio_access( RP_TASK_TYPE_NONE );
-                lr11xx_system_read_uid( modem_radio_ctx, ( uint8_t* ) &p_tmp_chip_eui );
+                lr11xx_system_read_uid( modem_ctx->modem_radio_ctx, ( uint8_t* ) &p_tmp_chip_eui );
                 // lr11xx operation done: resume modem radio access
                 modem_context_resume_radio_access( );
 #endif  // USE_LR11XX_CE
@@ -1468,19 +1373,24 @@ void dm_alm_dbg_uplink_payload( uint8_t max_payload_length, uint8_t* dm_uplink_m
 
 dm_rc_t set_modem_suspend( bool suspend )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     set_modem_status_radio_suspend( suspend );
-    is_modem_suspend = ( ( suspend == true ) ? MODEM_SUSPEND : MODEM_NOT_SUSPEND );
+    modem_ctx->is_modem_suspend = ( ( suspend == true ) ? MODEM_SUSPEND : MODEM_NOT_SUSPEND );
     return DM_OK;
 }
 
 modem_suspend_status_t get_modem_suspend( void )
 {
-    return ( ( is_modem_suspend == MODEM_SUSPEND ) ? true : false );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( ( modem_ctx->is_modem_suspend == MODEM_SUSPEND ) ? true : false );
 }
 
 dm_rc_t set_modem_adr_profile( smtc_modem_adr_profile_t adr_profile, const uint8_t* adr_custom_data,
                                uint8_t adr_custom_length )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     /* error case : 1) user_dr invalid
                     2) user_dr = custom but length not equal to 16
                     3) user_dr not custom but length not equal to 0*/
@@ -1494,7 +1404,7 @@ dm_rc_t set_modem_adr_profile( smtc_modem_adr_profile_t adr_profile, const uint8
     }
 
     // save profile in context:
-    modem_adr_profile = adr_profile;
+    modem_ctx->modem_adr_profile = adr_profile;
 
     status_lorawan_t status = ERRORLORAWAN;
 
@@ -1606,65 +1516,79 @@ dm_rc_t set_modem_adr_profile( smtc_modem_adr_profile_t adr_profile, const uint8
 
 void set_modem_downlink_frame( uint8_t* data, uint8_t data_length, lr1mac_down_metadata_t* metadata )
 {
-    memcpy( modem_dwn_pkt.data, data, data_length );
-    modem_dwn_pkt.length       = data_length;
-    modem_dwn_pkt.timestamp    = metadata->timestamp;
-    modem_dwn_pkt.snr          = metadata->rx_snr << 2;
-    modem_dwn_pkt.rssi         = metadata->rx_rssi + 64;
-    modem_dwn_pkt.port         = metadata->rx_fport;
-    modem_dwn_pkt.fpending_bit = metadata->rx_fpending_bit;
-    modem_dwn_pkt.frequency_hz = metadata->rx_frequency_hz;
-    modem_dwn_pkt.datarate     = metadata->rx_datarate;
-    SMTC_MODEM_HAL_TRACE_ARRAY( "Downlink frame ", modem_dwn_pkt.data, modem_dwn_pkt.length );
-    SMTC_MODEM_HAL_TRACE_PRINTF( "DL Port = %d , ", modem_dwn_pkt.port );
-    SMTC_MODEM_HAL_TRACE_PRINTF( "DL SNR = %d , DL RSSI = %d , ", modem_dwn_pkt.snr, modem_dwn_pkt.rssi );
-    SMTC_MODEM_HAL_TRACE_PRINTF( "DL Freq = %lu , DL DR = %d , ", modem_dwn_pkt.frequency_hz, modem_dwn_pkt.datarate );
-    SMTC_MODEM_HAL_TRACE_PRINTF( "DL Fpending Bit = %d \n", modem_dwn_pkt.fpending_bit );
+    smtc_modem_ctx_buffers_t* buffers = &smtc_modem_current_ctx->buffers;
+
+    memcpy( buffers->modem_dwn_pkt.data, data, data_length );
+    buffers->modem_dwn_pkt.length       = data_length;
+    buffers->modem_dwn_pkt.timestamp    = metadata->timestamp;
+    buffers->modem_dwn_pkt.snr          = metadata->rx_snr << 2;
+    buffers->modem_dwn_pkt.rssi         = metadata->rx_rssi + 64;
+    buffers->modem_dwn_pkt.port         = metadata->rx_fport;
+    buffers->modem_dwn_pkt.fpending_bit = metadata->rx_fpending_bit;
+    buffers->modem_dwn_pkt.frequency_hz = metadata->rx_frequency_hz;
+    buffers->modem_dwn_pkt.datarate     = metadata->rx_datarate;
+    SMTC_MODEM_HAL_TRACE_ARRAY( "Downlink frame ", buffers->modem_dwn_pkt.data, buffers->modem_dwn_pkt.length );
+    SMTC_MODEM_HAL_TRACE_PRINTF( "DL Port = %d , ", buffers->modem_dwn_pkt.port );
+    SMTC_MODEM_HAL_TRACE_PRINTF( "DL SNR = %d , DL RSSI = %d , ", buffers->modem_dwn_pkt.snr,
+                                 buffers->modem_dwn_pkt.rssi );
+    SMTC_MODEM_HAL_TRACE_PRINTF( "DL Freq = %lu , DL DR = %d , ", buffers->modem_dwn_pkt.frequency_hz,
+                                 buffers->modem_dwn_pkt.datarate );
+    SMTC_MODEM_HAL_TRACE_PRINTF( "DL Fpending Bit = %d \n", buffers->modem_dwn_pkt.fpending_bit );
 }
 void get_modem_downlink_frame( modem_downlink_msg_t* modem_dwn_in )
 {
-    modem_dwn_in->timestamp    = modem_dwn_pkt.timestamp;
-    modem_dwn_in->snr          = modem_dwn_pkt.snr;
-    modem_dwn_in->rssi         = modem_dwn_pkt.rssi;
-    modem_dwn_in->port         = modem_dwn_pkt.port;
-    modem_dwn_in->fpending_bit = modem_dwn_pkt.fpending_bit;
-    modem_dwn_in->frequency_hz = modem_dwn_pkt.frequency_hz;
-    modem_dwn_in->datarate     = modem_dwn_pkt.datarate;
-    modem_dwn_in->length       = modem_dwn_pkt.length;
-    memcpy( modem_dwn_in->data, modem_dwn_pkt.data, modem_dwn_pkt.length );
+    smtc_modem_ctx_buffers_t* buffers = &smtc_modem_current_ctx->buffers;
+
+    modem_dwn_in->timestamp    = buffers->modem_dwn_pkt.timestamp;
+    modem_dwn_in->snr          = buffers->modem_dwn_pkt.snr;
+    modem_dwn_in->rssi         = buffers->modem_dwn_pkt.rssi;
+    modem_dwn_in->port         = buffers->modem_dwn_pkt.port;
+    modem_dwn_in->fpending_bit = buffers->modem_dwn_pkt.fpending_bit;
+    modem_dwn_in->frequency_hz = buffers->modem_dwn_pkt.frequency_hz;
+    modem_dwn_in->datarate     = buffers->modem_dwn_pkt.datarate;
+    modem_dwn_in->length       = buffers->modem_dwn_pkt.length;
+    memcpy( modem_dwn_in->data, buffers->modem_dwn_pkt.data, buffers->modem_dwn_pkt.length );
 }
 
 void set_dm_retrieve_pending_dl( uint8_t up_count, uint8_t up_delay )
 {
-    dm_pending_dl.up_count = up_count;
-    dm_pending_dl.up_delay = ( up_delay < 20 ) ? 20 : up_delay;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->dm_pending_dl.up_count = up_count;
+    modem_ctx->dm_pending_dl.up_delay = ( up_delay < 20 ) ? 20 : up_delay;
 }
 
 void get_dm_retrieve_pending_dl( dm_dl_opportunities_config_t* pending_dl )
 {
-    pending_dl->up_count = dm_pending_dl.up_count;
-    pending_dl->up_delay = dm_pending_dl.up_delay;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    pending_dl->up_count = modem_ctx->dm_pending_dl.up_count;
+    pending_dl->up_delay = modem_ctx->dm_pending_dl.up_delay;
 }
 
 void decrement_dm_retrieve_pending_dl( void )
 {
-    if( dm_pending_dl.up_count > 0 )
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    if( modem_ctx->dm_pending_dl.up_count > 0 )
     {
-        dm_pending_dl.up_count--;
+        modem_ctx->dm_pending_dl.up_count--;
     }
 }
 
 void modem_store_context( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     modem_context_nvm_t ctx = {
-        .dm_port = modem_dm_port,
+        .dm_port = modem_ctx->modem_dm_port,
         //.dm_upload_sctr    = modem_dm_upload_sctr,
-        .appkey_crc_status = modem_appkey_status,
-        .appkey_crc        = modem_appkey_crc,
+        .appkey_crc_status = modem_ctx->modem_appkey_status,
+        .appkey_crc        = modem_ctx->modem_appkey_crc,
         .rfu               = { 0 },
     };
 
-    ctx.crc = crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
+    ctx.crc = modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
     smtc_modem_hal_context_store( CONTEXT_MODEM, ( uint8_t* ) &ctx, sizeof( ctx ) );
     modem_load_context( );
 }
@@ -1676,21 +1600,23 @@ void modem_store_context( void )
  */
 void modem_load_context( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     modem_context_nvm_t ctx;
 
     smtc_modem_hal_context_restore( CONTEXT_MODEM, ( uint8_t* ) &ctx, sizeof( ctx ) );
 
-    if( crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc )
+    if( modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc )
     {
-        modem_dm_port = ctx.dm_port;
+        modem_ctx->modem_dm_port = ctx.dm_port;
         // modem_dm_upload_sctr = ctx.dm_upload_sctr;
-        modem_appkey_status = ctx.appkey_crc_status;
-        modem_appkey_crc    = ctx.appkey_crc;
+        modem_ctx->modem_appkey_status = ctx.appkey_crc_status;
+        modem_ctx->modem_appkey_crc    = ctx.appkey_crc;
 
-        SMTC_MODEM_HAL_TRACE_PRINTF( "Modem Load Config :\n Port = %d\n", modem_dm_port );
+        SMTC_MODEM_HAL_TRACE_PRINTF( "Modem Load Config :\n Port = %d\n", modem_ctx->modem_dm_port );
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
-        SMTC_MODEM_HAL_TRACE_PRINTF( "Upload_sctr = %d\n", modem_dm_upload_sctr );
+        SMTC_MODEM_HAL_TRACE_PRINTF( "Upload_sctr = %d\n", modem_ctx->modem_dm_upload_sctr );
 #endif  // ADD_SMTC_FILE_UPLOAD
     }
     else
@@ -1702,6 +1628,8 @@ void modem_load_context( void )
 
 void modem_context_factory_reset( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     modem_context_nvm_t ctx = {
         .dm_port = DEFAULT_DM_PORT,
         // .dm_upload_sctr    = 0,
@@ -1709,136 +1637,158 @@ void modem_context_factory_reset( void )
         .appkey_crc        = 0,
     };
 
-    ctx.crc = crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
+    ctx.crc = modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
     smtc_modem_hal_context_store( CONTEXT_MODEM, ( uint8_t* ) &ctx, sizeof( ctx ) );
 
-    // dummy context reading to ensure context store is done before exiting the function
-    smtc_modem_hal_context_restore( CONTEXT_LR1MAC, ( uint8_t* ) &ctx, sizeof( ctx ) );
-
-    is_modem_reset_requested = true;
+    modem_ctx->is_modem_reset_requested = true;
     SMTC_MODEM_HAL_TRACE_INFO( "modem_context_factory_reset done\n" );
 }
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
 uint8_t modem_context_compute_and_get_next_dm_upload_sctr( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     // take current and add 1 then mask to fit 4bits length (overflow is implicitely managed)
-    modem_dm_upload_sctr = ( modem_dm_upload_sctr + 1 ) & 0xf;
-    return modem_dm_upload_sctr;
+    modem_ctx->modem_dm_upload_sctr = ( modem_ctx->modem_dm_upload_sctr + 1 ) & 0xf;
+    return modem_ctx->modem_dm_upload_sctr;
 }
 
 modem_upload_state_t modem_get_upload_state( void )
 {
-    return ( modem_upload_state );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_upload_state );
 }
 
 void modem_set_upload_state( modem_upload_state_t upload_state )
 {
-    modem_upload_state = upload_state;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_upload_state = upload_state;
 }
 #endif  // ADD_SMTC_FILE_UPLOAD
 
 #if defined( ADD_SMTC_STREAM )
 modem_stream_status_t modem_get_stream_state( void )
 {
-    return ( modem_stream_state.state );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_stream_state.state );
 }
 
 uint8_t modem_get_stream_port( void )
 {
-    return ( modem_stream_state.port );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_stream_state.port );
 }
 
 bool modem_get_stream_encryption( void )
 {
-    return ( modem_stream_state.encryption );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->modem_stream_state.encryption );
 }
 
 void modem_set_stream_state( modem_stream_status_t stream_state )
 {
-    modem_stream_state.state = stream_state;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_stream_state.state = stream_state;
 }
 
 void modem_set_stream_port( uint8_t port )
 {
-    modem_stream_state.port = port;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_stream_state.port = port;
 }
 
 void modem_set_stream_encryption( bool enc )
 {
-    modem_stream_state.encryption = enc;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_stream_state.encryption = enc;
 }
 #endif  // ADD_SMTC_STREAM
 
 void modem_set_dm_info_bitfield_periodic( uint32_t value )
 {
-    if( dm_info_bitfield_periodic != value )
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    if( modem_ctx->dm_info_bitfield_periodic != value )
     {
-        dm_info_bitfield_periodic = value;
+        modem_ctx->dm_info_bitfield_periodic = value;
     }
 }
 
 void modem_context_reset_dm_tag_number( void )
 {
-    tag_number = 0;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->tag_number = 0;
 }
 
 uint32_t modem_get_dm_info_bitfield_periodic( void )
 {
-    return ( dm_info_bitfield_periodic );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->dm_info_bitfield_periodic );
 }
 uint32_t modem_get_user_alarm( void )
 {
-    return ( user_alarm );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return ( modem_ctx->user_alarm );
 }
 
 void modem_set_user_alarm( uint32_t alarm )
 {
-    user_alarm = alarm;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->user_alarm = alarm;
 }
 
 bool get_modem_reset_requested( void )
 {
-    return is_modem_reset_requested;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->is_modem_reset_requested;
 }
 void set_modem_reset_requested( bool reset_req )
 {
-    is_modem_reset_requested = reset_req;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->is_modem_reset_requested = reset_req;
 }
 
 rf_output_t modem_get_rfo_pa( void )
 {
-    return modem_rf_output;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->modem_rf_output;
 }
 
 uint8_t modem_set_rfo_pa( rf_output_t rf_output )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( rf_output >= MODEM_RFO_MAX )
     {
         return DM_ERROR;
     }
-    modem_rf_output = rf_output;
+    modem_ctx->modem_rf_output = rf_output;
     return DM_OK;
 }
 
 void modem_set_duty_cycle_disabled_by_host( uint8_t disabled_by_host )
 {
-    duty_cycle_disabled_by_host = disabled_by_host;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->duty_cycle_disabled_by_host = disabled_by_host;
 }
 
 uint8_t modem_get_duty_cycle_disabled_by_host( void )
 {
-    return duty_cycle_disabled_by_host;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->duty_cycle_disabled_by_host;
 }
 
 void modem_set_adr_mobile_timeout_config( uint16_t nb_tx )
 {
-    nb_adr_mobile_timeout = nb_tx;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->nb_adr_mobile_timeout = nb_tx;
 }
 
 uint16_t modem_get_adr_mobile_timeout_config( void )
 {
-    return nb_adr_mobile_timeout;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->nb_adr_mobile_timeout;
 }
 
 bool modem_available_new_link_adr_request( void )
@@ -1847,42 +1797,50 @@ bool modem_available_new_link_adr_request( void )
 }
 void modem_set_test_mode_status( bool enable )
 {
-    is_modem_in_test_mode = enable;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->is_modem_in_test_mode = enable;
 }
 
 bool modem_get_test_mode_status( void )
 {
-    return is_modem_in_test_mode;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->is_modem_in_test_mode;
 }
 
 void modem_context_set_rx_pathloss_db( int8_t rx_pathloss )
 {
-    rx_pathloss_db = rx_pathloss;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->rx_pathloss_db = rx_pathloss;
 }
 
 int8_t modem_context_get_rx_pathloss_db( void )
 {
-    return rx_pathloss_db;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->rx_pathloss_db;
 }
 
 void modem_context_set_tx_power_offset_db( int8_t tx_power_offset )
 {
-    tx_power_offset_db = tx_power_offset;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->tx_power_offset_db = tx_power_offset;
 }
 
 int8_t modem_context_get_tx_power_offset_db( void )
 {
-    return tx_power_offset_db;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->tx_power_offset_db;
 }
 
 radio_planner_t* modem_context_get_modem_rp( void )
 {
-    return modem_rp;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->modem_rp;
 }
 
 void modem_context_set_modem_rp( radio_planner_t* rp )
 {
-    modem_rp = rp;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_rp = rp;
 }
 
 void modem_context_empty_callback( void* ctx )
@@ -1893,6 +1851,8 @@ void modem_context_empty_callback( void* ctx )
 #if !defined( LR1110_MODEM_E )
 bool modem_context_suspend_user_radio_access( rp_task_types_t type )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     rp_radio_params_t fake_radio_params = { 0 };
 
     rp_task_t rp_task = {
@@ -1904,16 +1864,18 @@ bool modem_context_suspend_user_radio_access( rp_task_types_t type )
         .schedule_task_low_priority = false,
         .start_time_ms              = smtc_modem_hal_get_time_in_ms( ) + 4,
     };
-    rp_hook_status_t status = rp_task_enqueue( modem_rp, &rp_task, NULL, 0, &fake_radio_params );
+    rp_hook_status_t status = rp_task_enqueue( modem_ctx->modem_rp, &rp_task, NULL, 0, &fake_radio_params );
 
     return ( status == RP_HOOK_STATUS_OK ) ? true : false;
 }
 
 bool modem_context_resume_user_radio_access( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     bool status = true;
 
-    if( rp_task_abort( modem_rp, RP_HOOK_ID_USER_SUSPEND ) != RP_HOOK_STATUS_OK )
+    if( rp_task_abort( modem_ctx->modem_rp, RP_HOOK_ID_USER_SUSPEND ) != RP_HOOK_STATUS_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Fail to abort hook\n" );
         status = false;
@@ -1925,6 +1887,8 @@ bool modem_context_resume_user_radio_access( void )
 
 bool modem_context_suspend_radio_access( rp_task_types_t type )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     rp_radio_params_t fake_radio_params = { 0 };
 
     rp_task_t rp_task = {
@@ -1940,16 +1904,18 @@ bool modem_context_suspend_radio_access( rp_task_types_t type )
     // First disable modem irq to secure radio access
     smtc_modem_hal_disable_modem_irq( );
 
-    rp_hook_status_t status = rp_task_enqueue( modem_rp, &rp_task, NULL, 0, &fake_radio_params );
+    rp_hook_status_t status = rp_task_enqueue( modem_ctx->modem_rp, &rp_task, NULL, 0, &fake_radio_params );
 
     return ( status == RP_HOOK_STATUS_OK ) ? true : false;
 }
 
 bool modem_context_resume_radio_access( void )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     bool status = true;
 
-    if( rp_task_abort( modem_rp, RP_HOOK_ID_SUSPEND ) != RP_HOOK_STATUS_OK )
+    if( rp_task_abort( modem_ctx->modem_rp, RP_HOOK_ID_SUSPEND ) != RP_HOOK_STATUS_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Fail to abort hook\n" );
         status = false;
@@ -1963,20 +1929,23 @@ bool modem_context_resume_radio_access( void )
 
 void modem_context_set_power_config_lut( uint8_t config[30] )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     // save raw buff into power lut
     for( uint8_t i = 0; i < POWER_CONFIG_LUT_SIZE; i++ )
     {
-        power_config_lut[i].expected_power   = config[5 * i];
-        power_config_lut[i].configured_power = config[( 5 * i ) + 1];
-        power_config_lut[i].pa_param1        = config[( 5 * i ) + 2];
-        power_config_lut[i].pa_param2        = config[( 5 * i ) + 3];
-        power_config_lut[i].pa_ramp_time     = config[( 5 * i ) + 4];
+        modem_ctx->power_config_lut[i].expected_power   = config[5 * i];
+        modem_ctx->power_config_lut[i].configured_power = config[( 5 * i ) + 1];
+        modem_ctx->power_config_lut[i].pa_param1        = config[( 5 * i ) + 2];
+        modem_ctx->power_config_lut[i].pa_param2        = config[( 5 * i ) + 3];
+        modem_ctx->power_config_lut[i].pa_ramp_time     = config[( 5 * i ) + 4];
     }
 }
 
 modem_power_config_t* modem_context_get_power_config_lut( void )
 {
-    return power_config_lut;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->power_config_lut;
 }
 
 modem_ctx_rc_t modem_context_set_appkey( const uint8_t app_key[16] )
@@ -1984,12 +1953,15 @@ modem_ctx_rc_t modem_context_set_appkey( const uint8_t app_key[16] )
     modem_ctx_rc_t rc = MODEM_CTX_RC_SUCCESS;
 // To prevent too much flash access first check crc on key in case of Hardware Secure element
 #if( defined( LR1110_MODEM_E ) && defined( USE_LR11XX_CE ) ) || defined( USE_LR11XX_CE )
-    uint32_t new_crc = crc( app_key, 16 );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
 
-    if( ( modem_appkey_status == MODEM_APPKEY_CRC_STATUS_INVALID ) || ( modem_appkey_crc != new_crc ) )
+    uint32_t new_crc = modem_crc32( app_key, 16 );
+
+    if( ( modem_ctx->modem_appkey_status == MODEM_APPKEY_CRC_STATUS_INVALID ) ||
+        ( modem_ctx->modem_appkey_crc != new_crc ) )
     {
-        modem_appkey_crc    = new_crc;
-        modem_appkey_status = MODEM_APPKEY_CRC_STATUS_VALID;
+        modem_ctx->modem_appkey_crc    = new_crc;
+        modem_ctx->modem_appkey_status = MODEM_APPKEY_CRC_STATUS_VALID;
 
         if( lorawan_api_set_appkey( app_key ) != OKLORAWAN )
         {
@@ -2012,7 +1984,9 @@ modem_ctx_rc_t modem_context_set_appkey( const uint8_t app_key[16] )
 
 void modem_context_appkey_is_derived( void )
 {
-    modem_appkey_status = MODEM_APPKEY_CRC_STATUS_INVALID;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->modem_appkey_status = MODEM_APPKEY_CRC_STATUS_INVALID;
     modem_store_context( );
 }
 
@@ -2028,20 +2002,24 @@ void modem_context_set_network_type( bool network_type )
 
 const void* modem_context_get_modem_radio_ctx( void )
 {
-    return modem_radio_ctx;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    return modem_ctx->modem_radio_ctx;
 }
 
 void modem_context_set_modem_radio_ctx( const void* radio_ctx )
 {
-    modem_radio_ctx = radio_ctx;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    modem_ctx->modem_radio_ctx = radio_ctx;
 }
 
 #if defined( ADD_D2D )
 void modem_context_set_class_b_d2d_last_metadata( uint8_t mc_grp_id, bool tx_done, uint8_t nb_trans_not_send )
 {
-    class_b_d2d_ctx.tx_done           = tx_done;
-    class_b_d2d_ctx.nb_trans_not_send = nb_trans_not_send;
-    class_b_d2d_ctx.mc_grp_id         = mc_grp_id;
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
+    modem_ctx->class_b_d2d_ctx.tx_done           = tx_done;
+    modem_ctx->class_b_d2d_ctx.nb_trans_not_send = nb_trans_not_send;
+    modem_ctx->class_b_d2d_ctx.mc_grp_id         = mc_grp_id;
 
     if( tx_done == true )
     {
@@ -2057,19 +2035,22 @@ void modem_context_set_class_b_d2d_last_metadata( uint8_t mc_grp_id, bool tx_don
 
 void modem_context_get_class_b_d2d_last_metadata( modem_context_class_b_d2d_t* class_b_d2d )
 {
-    memcpy( class_b_d2d, &class_b_d2d_ctx, sizeof( modem_context_class_b_d2d_t ) );
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+    memcpy( class_b_d2d, &modem_ctx->class_b_d2d_ctx, sizeof( modem_context_class_b_d2d_t ) );
 }
 #endif  // ADD_D2D
 
 void modem_set_extended_callback( func_callback callback, uint8_t extended_uplink_id )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( extended_uplink_id == 1 )
     {
-        modem_lbm_notification_extended_1_callback = callback;
+        modem_ctx->modem_lbm_notification_extended_1_callback = callback;
     }
     else if( extended_uplink_id == 2 )
     {
-        modem_lbm_notification_extended_2_callback = callback;
+        modem_ctx->modem_lbm_notification_extended_2_callback = callback;
     }
     else
     {
@@ -2078,13 +2059,15 @@ void modem_set_extended_callback( func_callback callback, uint8_t extended_uplin
 }
 func_callback modem_get_extended_callback( uint8_t extended_uplink_id )
 {
+    modem_context_ctx_t* modem_ctx = &smtc_modem_current_ctx->context;
+
     if( extended_uplink_id == 1 )
     {
-        return modem_lbm_notification_extended_1_callback;
+        return modem_ctx->modem_lbm_notification_extended_1_callback;
     }
     else if( extended_uplink_id == 2 )
     {
-        return modem_lbm_notification_extended_2_callback;
+        return modem_ctx->modem_lbm_notification_extended_2_callback;
     }
     else
     {
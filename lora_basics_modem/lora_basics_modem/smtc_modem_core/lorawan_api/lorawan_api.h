@@ -394,6 +394,13 @@ uint32_t lorawan_api_next_join_time_second_get( void );
  */
 int32_t lorawan_api_next_free_duty_cycle_ms_get( void );
 
+/**
+ * @brief Get the delay before lorawan_api_process has to be called again while the stack is not idle
+ *
+ * @return uint32_t Delay in ms, 0 if lorawan_api_process has to be called right now
+ */
+uint32_t lorawan_api_next_process_delay_ms_get( void );
+
 /**
  * @brief Enable / disable the dutycycle
  *
@@ -60,6 +60,24 @@
  * --- PRIVATE MACROS ---------------------------------------------------------------
  */
 
+/**
+ * @brief Longest time on air of a class A frame: SF12 125 kHz with the largest DR0 payload (2.8 s), rounded up
+ */
+#define LR1MAC_CLASS_A_MAX_TOA_MS 3000
+
+/**
+ * @brief Join accept delay 2, the longest receive delay of a stack which did not receive a RXTimingSetupReq
+ */
+#define LR1MAC_JOIN_ACCEPT_DELAY2_MS 6000
+
+/**
+ * @brief Slack of an asap uplink once the radio planner switched it to a schedule task: it can wait for the end of a
+ * class A exchange of another stack (its uplink, the second receive window and the downlink received in it) instead
+ * of being aborted. Longer exchanges still abort the uplink, which is then retried by the MAC
+ */
+#define LR1MAC_TX_ASAP_SLACK_MS \
+    ( LR1MAC_CLASS_A_MAX_TOA_MS + LR1MAC_JOIN_ACCEPT_DELAY2_MS + LR1MAC_CLASS_A_MAX_TOA_MS )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -98,6 +116,15 @@ static void             beacon_freq_req_parser( lr1_stack_mac_t* lr1_mac );
 static void             ping_slot_channel_req_parser( lr1_stack_mac_t* lr1_mac );
 static status_lorawan_t ping_slot_info_ans_parser( lr1_stack_mac_t* lr1_mac );
 
+/**
+ * @brief Check that a postponed uplink still respects the duty cycle and dwell time constraints checked by the MAC
+ *
+ * @param [in] hook           lr1mac object owning the uplink
+ * @param [in] start_time_ms  New start time of the uplink
+ * @return true if the uplink can be postponed, false if it has to be aborted
+ */
+static bool lr1_stack_mac_tx_shift_check_callback_for_rp( void* hook, uint32_t start_time_ms );
+
 /*
  *-----------------------------------------------------------------------------------
  *--- PUBLIC FUNCTION DEFINITIONS ---------------------------------------------------
@@ -196,20 +223,13 @@ void lr1_stack_mac_tx_frame_encrypt( lr1_stack_mac_t* lr1_mac )
         tx_fopts_length = lr1_mac->tx_fopts_current_length;
     }
 
-    if( smtc_modem_crypto_payload_encrypt(
-            &lr1_mac->tx_payload[FHDROFFSET + lr1_mac->tx_fport_present + tx_fopts_length], lr1_mac->app_payload_size,
-            ( lr1_mac->tx_fport == PORTNWK ) ? SMTC_SE_NWK_S_ENC_KEY : SMTC_SE_APP_S_KEY, lr1_mac->dev_addr, UP_LINK,
-            lr1_mac->fcnt_up, &lr1_mac->tx_payload[FHDROFFSET + lr1_mac->tx_fport_present + tx_fopts_length] ) !=
-        SMTC_MODEM_CRYPTO_RC_SUCCESS )
+    // The payload ( app_payload_size bytes ) ends the frame: it is encrypted and the mic computed in the same pass
+    if( smtc_modem_crypto_payload_encrypt_and_add_mic(
+            &lr1_mac->tx_payload[0], lr1_mac->tx_payload_size, FHDROFFSET + lr1_mac->tx_fport_present + tx_fopts_length,
+            ( lr1_mac->tx_fport == PORTNWK ) ? SMTC_SE_NWK_S_ENC_KEY : SMTC_SE_APP_S_KEY, SMTC_SE_NWK_S_ENC_KEY,
+            lr1_mac->dev_addr, UP_LINK, lr1_mac->fcnt_up ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
     {
-        smtc_modem_hal_lr1mac_panic( "Crypto error during payload encryption\n" );
-    }
-
-    if( smtc_modem_crypto_compute_and_add_mic( &lr1_mac->tx_payload[0], lr1_mac->tx_payload_size, SMTC_SE_NWK_S_ENC_KEY,
-                                               lr1_mac->dev_addr, UP_LINK,
-                                               lr1_mac->fcnt_up ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
-    {
-        smtc_modem_hal_lr1mac_panic( "Crypto error during mic computation\n" );
+        smtc_modem_hal_lr1mac_panic( "Crypto error during payload encryption or mic computation\n" );
     }
     lr1_mac->tx_payload_size = lr1_mac->tx_payload_size + 4;
 }
@@ -235,12 +255,12 @@ void lr1_stack_mac_tx_lora_launch_callback_for_rp( void* rp_void )
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
 
-    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->radio_params[id].tx.lora ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->hook_table[id]->radio_params.tx.lora ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_TX_DONE ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_pkt_payload( &( rp->radio->ral ), rp->payload[id], rp->payload_size[id] ) ==
-                           RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_pkt_payload( &( rp->radio->ral ), rp->hook_table[id]->payload,
+                                                rp->hook_table[id]->payload_size ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
     {
         // Do nothing
     }
@@ -255,12 +275,12 @@ void lr1_stack_mac_tx_gfsk_launch_callback_for_rp( void* rp_void )
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
 
-    smtc_modem_hal_assert( ralf_setup_gfsk( rp->radio, &rp->radio_params[id].tx.gfsk ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ralf_setup_gfsk( rp->radio, &rp->hook_table[id]->radio_params.tx.gfsk ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_TX_DONE ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_pkt_payload( &( rp->radio->ral ), rp->payload[id], rp->payload_size[id] ) ==
-                           RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_pkt_payload( &( rp->radio->ral ), rp->hook_table[id]->payload,
+                                                rp->hook_table[id]->payload_size ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
     {
     }
     // At this time only tcxo startup delay is remaining
@@ -275,20 +295,22 @@ void lr1_stack_mac_tx_lr_fhss_launch_callback_for_rp( void* rp_void )
     uint8_t          id = rp->radio_task_id;
 
     // Initialize LR-FHSS
+    smtc_modem_hal_assert( ral_lr_fhss_init( &( rp->radio->ral ),
+                                             &rp->hook_table[id]->radio_params.tx.lr_fhss.ral_lr_fhss_params ) ==
+                           RAL_STATUS_OK );
     smtc_modem_hal_assert(
-        ral_lr_fhss_init( &( rp->radio->ral ), &rp->radio_params[id].tx.lr_fhss.ral_lr_fhss_params ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert(
-        ral_set_tx_cfg( &( rp->radio->ral ), rp->radio_params[id].tx.lr_fhss.output_pwr_in_dbm,
-                        rp->radio_params[id].tx.lr_fhss.ral_lr_fhss_params.center_frequency_in_hz ) == RAL_STATUS_OK );
+        ral_set_tx_cfg( &( rp->radio->ral ), rp->hook_table[id]->radio_params.tx.lr_fhss.output_pwr_in_dbm,
+                        rp->hook_table[id]->radio_params.tx.lr_fhss.ral_lr_fhss_params.center_frequency_in_hz ) ==
+        RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_TX_DONE | RAL_IRQ_LR_FHSS_HOP ) ==
                            RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_lr_fhss_build_frame( &( rp->radio->ral ),
-                                                    &rp->radio_params[id].tx.lr_fhss.ral_lr_fhss_params,
-                                                    ( ral_lr_fhss_memory_state_t ) rp->radio_params[id].lr_fhss_state,
-                                                    rp->radio_params[id].tx.lr_fhss.hop_sequence_id, rp->payload[id],
-                                                    rp->payload_size[id] ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert(
+        ral_lr_fhss_build_frame( &( rp->radio->ral ), &rp->hook_table[id]->radio_params.tx.lr_fhss.ral_lr_fhss_params,
+                                 ( ral_lr_fhss_memory_state_t ) rp->hook_table[id]->radio_params.lr_fhss_state,
+                                 rp->hook_table[id]->radio_params.tx.lr_fhss.hop_sequence_id,
+                                 rp->hook_table[id]->payload, rp->hook_table[id]->payload_size ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
     {
         // Do nothing
     }
@@ -303,17 +325,18 @@ void lr1_stack_mac_rx_lora_launch_callback_for_rp( void* rp_void )
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
 
-    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->radio_params[id].rx.lora ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->hook_table[id]->radio_params.rx.lora ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_RX_DONE | RAL_IRQ_RX_TIMEOUT |
                                                                             RAL_IRQ_RX_HDR_ERROR |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
     {
     }
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
-    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->hook_table[id]->radio_params.rx.timeout_in_ms ) ==
+                           RAL_STATUS_OK );
     rp_stats_set_rx_timestamp( &rp->stats, smtc_modem_hal_get_time_in_ms( ) );
 }
 
@@ -322,16 +345,17 @@ void lr1_stack_mac_rx_gfsk_launch_callback_for_rp( void* rp_void )
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
 
-    smtc_modem_hal_assert( ralf_setup_gfsk( rp->radio, &rp->radio_params[id].rx.gfsk ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ralf_setup_gfsk( rp->radio, &rp->hook_table[id]->radio_params.rx.gfsk ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_RX_DONE | RAL_IRQ_RX_TIMEOUT |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
     {
     }
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
-    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->hook_table[id]->radio_params.rx.timeout_in_ms ) ==
+                           RAL_STATUS_OK );
     rp_stats_set_rx_timestamp( &rp->stats, smtc_modem_hal_get_time_in_ms( ) );
 }
 
@@ -465,12 +489,15 @@ void lr1_stack_mac_tx_radio_start( lr1_stack_mac_t* lr1_mac )
     rp_task.start_time_ms    = lr1_mac->rtc_target_timer_ms - smtc_modem_hal_get_radio_tcxo_startup_delay_ms( );
     if( lr1_mac->send_at_time == true )
     {
+        // No slack: the channel was just checked free by lbt or the payload holds the time of the transmission
         lr1_mac->send_at_time = false;  // reinit the flag
         rp_task.state         = RP_TASK_STATE_SCHEDULE;
     }
     else
     {
-        rp_task.state = RP_TASK_STATE_ASAP;
+        rp_task.state                      = RP_TASK_STATE_ASAP;
+        rp_task.slack_ms                   = LR1MAC_TX_ASAP_SLACK_MS;
+        rp_task.shift_task_check_callbacks = lr1_stack_mac_tx_shift_check_callback_for_rp;
     }
     lr1_mac->radio_process_state = RADIOSTATE_TX_ON;
     if( rp_task_enqueue( lr1_mac->rp, &rp_task, lr1_mac->tx_payload, lr1_mac->tx_payload_size, &radio_params ) !=
@@ -626,14 +653,16 @@ void lr1_stack_mac_rp_callback( lr1_stack_mac_t* lr1_mac )
     case RP_STATUS_RX_PACKET:
         // save rssi and snr
         lr1_mac->rx_metadata.timestamp = tcurrent_ms;
-        lr1_mac->rx_metadata.rx_snr    = lr1_mac->rp->radio_params[my_hook_id].rx.lora_pkt_status.snr_pkt_in_db;
-        lr1_mac->rx_metadata.rx_rssi   = lr1_mac->rp->radio_params[my_hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm;
-        lr1_mac->rx_payload_size       = ( uint8_t ) lr1_mac->rp->payload_size[my_hook_id];
+        lr1_mac->rx_metadata.rx_snr =
+            lr1_mac->rp->hook_table[my_hook_id]->radio_params.rx.lora_pkt_status.snr_pkt_in_db;
+        lr1_mac->rx_metadata.rx_rssi =
+            lr1_mac->rp->hook_table[my_hook_id]->radio_params.rx.lora_pkt_status.rssi_pkt_in_dbm;
+        lr1_mac->rx_payload_size = ( uint8_t ) lr1_mac->rp->hook_table[my_hook_id]->payload_size;
 
-        SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "payload size receive = %u, snr = %d , rssi = %d\n",
-                                           lr1_mac->rx_payload_size,
-                                           lr1_mac->rp->radio_params[my_hook_id].rx.lora_pkt_status.snr_pkt_in_db,
-                                           lr1_mac->rp->radio_params[my_hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm );
+        SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG(
+            "payload size receive = %u, snr = %d , rssi = %d\n", lr1_mac->rx_payload_size,
+            lr1_mac->rp->hook_table[my_hook_id]->radio_params.rx.lora_pkt_status.snr_pkt_in_db,
+            lr1_mac->rp->hook_table[my_hook_id]->radio_params.rx.lora_pkt_status.rssi_pkt_in_dbm );
 
         if( lr1_stack_mac_downlink_check_under_it( lr1_mac ) != OKLORAWAN )
         {  // Case receive a packet but it isn't a valid packet
@@ -865,9 +894,35 @@ rx_packet_type_t lr1_stack_mac_rx_frame_decode( lr1_stack_mac_t* lr1_mac )
             lr1_mac->rx_payload_size = lr1_mac->rx_payload_size - MICSIZE;
             memcpy1( ( uint8_t* ) &mic_in, &lr1_mac->rx_payload[lr1_mac->rx_payload_size], MICSIZE );
 
-            if( smtc_modem_crypto_verify_mic( &lr1_mac->rx_payload[0], lr1_mac->rx_payload_size, SMTC_SE_NWK_S_ENC_KEY,
-                                              lr1_mac->dev_addr, 1, fcnt_dwn_stack_tmp,
-                                              mic_in ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
+            // The payload is decrypted while the mic is verified and only copied, once the mic matched, to where the
+            // frame processing below expects it: nwk_payload for a mac management frame, the start of rx_payload for an
+            // app frame
+            uint8_t                  payload_offset = lr1_mac->rx_payload_size;
+            uint8_t*                 dec_buffer     = NULL;
+            smtc_se_key_identifier_t dec_key_id     = SMTC_SE_APP_S_KEY;
+
+            if( lr1_mac->rx_payload_empty == 0 )
+            {
+                uint8_t offset = FHDROFFSET + 1 + lr1_mac->rx_fopts_length;
+
+                if( lr1_mac->rx_metadata.rx_fport != 0 )
+                {
+                    payload_offset = offset;
+                    dec_buffer     = &lr1_mac->rx_payload[0];
+                }
+                else if( ( lr1_mac->rx_fopts_length == 0 ) &&
+                         ( ( lr1_mac->rx_payload_size - offset ) <= NWK_MAC_PAYLOAD_MAX_SIZE ) )
+                {
+                    payload_offset = offset;
+                    dec_buffer     = &lr1_mac->nwk_payload[0];
+                    dec_key_id     = SMTC_SE_NWK_S_ENC_KEY;
+                }
+            }
+
+            if( smtc_modem_crypto_verify_mic_and_payload_decrypt(
+                    &lr1_mac->rx_payload[0], lr1_mac->rx_payload_size, payload_offset, dec_key_id,
+                    SMTC_SE_NWK_S_ENC_KEY, lr1_mac->dev_addr, 1, fcnt_dwn_stack_tmp, mic_in,
+                    dec_buffer ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
             {
                 status = ERRORLORAWAN;
             }
@@ -914,13 +969,7 @@ rx_packet_type_t lr1_stack_mac_rx_frame_decode( lr1_stack_mac_t* lr1_mac )
                 {  // receive a mac management frame without fopts
                     if( lr1_mac->rx_fopts_length == 0 )
                     {
-                        if( smtc_modem_crypto_payload_decrypt(
-                                &lr1_mac->rx_payload[FHDROFFSET + 1], lr1_mac->rx_payload_size, SMTC_SE_NWK_S_ENC_KEY,
-                                lr1_mac->dev_addr, 1, fcnt_dwn_stack_tmp,
-                                &lr1_mac->nwk_payload[0] ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
-                        {
-                            smtc_modem_hal_lr1mac_panic( "Crypto error during payload decryption\n" );
-                        }
+                        // Already decrypted in nwk_payload when it fits
                         if( lr1_mac->rx_payload_size > NWK_MAC_PAYLOAD_MAX_SIZE )
                         {
                             SMTC_MODEM_HAL_TRACE_WARNING( " Receive too many nwk frames\n" );
@@ -943,14 +992,7 @@ rx_packet_type_t lr1_stack_mac_rx_frame_decode( lr1_stack_mac_t* lr1_mac )
                     // =>  if rx_fopts_length > 0 set rx_packet_type = USERRX_FOPTSPACKET and copy fopts data
                     // =>  notify the upper layer that the stack have received a payload : set available_app_packet
                     //     to LORA_RX_PACKET_AVAILABLE with length > 0
-                    if( smtc_modem_crypto_payload_decrypt(
-                            &lr1_mac->rx_payload[FHDROFFSET + 1 + lr1_mac->rx_fopts_length], lr1_mac->rx_payload_size,
-                            SMTC_SE_APP_S_KEY, lr1_mac->dev_addr, 1, fcnt_dwn_stack_tmp,
-                            &lr1_mac->rx_payload[0] ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
-                    {
-                        smtc_modem_hal_lr1mac_panic( "Crypto error during payload decryption\n" );
-                    }
-
+                    //     ( the payload is already decrypted at the start of rx_payload )
                     if( lr1_mac->rx_fopts_length != 0 )
                     {
                         memcpy1( lr1_mac->nwk_payload, lr1_mac->rx_fopts, lr1_mac->rx_fopts_length );
@@ -1619,6 +1661,30 @@ static void frame_header_set( lr1_stack_mac_t* lr1_mac )
     }
 }
 
+static bool lr1_stack_mac_tx_shift_check_callback_for_rp( void* hook, uint32_t start_time_ms )
+{
+    lr1_stack_mac_t* lr1_mac = ( lr1_stack_mac_t* ) hook;
+
+    // The network duty cycle has to be elapsed at the new start time
+    if( lr1_stack_network_next_free_duty_cycle_ms_get( lr1_mac ) >
+        ( int32_t )( start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) )
+    {
+        return false;
+    }
+    // The band of the channel may have been used meanwhile (d2d), same criterion as the channel selection
+    if( smtc_duty_cycle_is_channel_free( lr1_mac->dtc_obj, lr1_mac->tx_frequency ) == false )
+    {
+        return false;
+    }
+    // The MAC payload (without MHDR and MIC) has to fit in the dwell time of the data rate
+    if( ( lr1_mac->tx_payload_size - 1 - MICSIZE ) >
+        smtc_real_get_max_payload_size( lr1_mac, lr1_mac->tx_data_rate, lr1_mac->uplink_dwell_time ) )
+    {
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************************************/
 /*                    Private NWK MANAGEMENTS Methods */
 /************************************************************************************************/
@@ -1912,7 +1978,7 @@ static void dev_status_parser( lr1_stack_mac_t* lr1_mac )
         lr1_mac->tx_fopts_data[lr1_mac->tx_fopts_length]     = DEV_STATUS_ANS;  // copy Cid
         lr1_mac->tx_fopts_data[lr1_mac->tx_fopts_length + 1] = smtc_modem_hal_get_battery_level( );
         lr1_mac->tx_fopts_data[lr1_mac->tx_fopts_length + 2] =
-            ( lr1_mac->rp->radio_params[my_hook_id].rx.lora_pkt_status.snr_pkt_in_db ) & 0x3F;
+            ( lr1_mac->rp->hook_table[my_hook_id]->radio_params.rx.lora_pkt_status.snr_pkt_in_db ) & 0x3F;
         lr1_mac->tx_fopts_length += DEV_STATUS_ANS_SIZE;
     }
 }
@@ -326,6 +326,7 @@ void beacon_rp_request( smtc_lr1_beacon_t* lr1_beacon_obj )
     rp_task.start_time_ms         = compute_start_time( lr1_beacon_obj );
     rp_task.duration_time_ms      = BEACON_SYMB_DURATION_MS( ) * lr1_beacon_obj->beacon_open_rx_nb_symb;
     rp_task.launch_task_callbacks = smtc_beacon_sniff_launch_callback_for_rp;
+    rp_task.slack_ms              = 0;  // the beacon is only on air at its slot, a late rx would miss it
 
     rp_radio_params_t rp_radio_params      = { 0 };
     rp_radio_params.pkt_type               = RAL_PKT_TYPE_LORA;
@@ -355,22 +356,23 @@ void smtc_beacon_sniff_launch_callback_for_rp( void* rp_void )
 {
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
-    if( rp->tasks[id].type == RP_TASK_TYPE_NONE )
+    if( rp->hook_table[id]->task.type == RP_TASK_TYPE_NONE )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( "doesn't listen this beacon , jump it to save power \n" );
         rp_task_abort( rp, id );
         return;
     }
     smtc_modem_hal_start_radio_tcxo( );
-    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->radio_params[id].rx.lora ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->hook_table[id]->radio_params.rx.lora ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_RX_DONE | RAL_IRQ_RX_TIMEOUT |
                                                                             RAL_IRQ_RX_HDR_ERROR |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact time
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
     {
     }
-    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->hook_table[id]->radio_params.rx.timeout_in_ms ) ==
+                           RAL_STATUS_OK );
     rp_stats_set_rx_timestamp( &rp->stats, smtc_modem_hal_get_time_in_ms( ) );
 }
 
@@ -381,11 +383,11 @@ void smtc_beacon_sniff_rp_callback( smtc_lr1_beacon_t* lr1_beacon_obj )
         return;
     }
 
-    rp_status_t rp_status         = lr1_beacon_obj->rp->status[lr1_beacon_obj->beacon_sniff_id_rp];
+    rp_status_t rp_status         = lr1_beacon_obj->rp->hook_table[lr1_beacon_obj->beacon_sniff_id_rp]->status;
     uint32_t    beacon_epoch_time = 0;
     // assuming that the radio hw latency between the end of the packet and the timestamp of the rx packet is about
     // 1/2 symbol
-    uint32_t timestamp = lr1_beacon_obj->rp->irq_timestamp_100us[lr1_beacon_obj->beacon_sniff_id_rp] -
+    uint32_t timestamp = lr1_beacon_obj->rp->hook_table[lr1_beacon_obj->beacon_sniff_id_rp]->irq_timestamp_100us -
                          ( ( BEACON_SYMB_DURATION_US( ) >> 1 ) / 100 );
 
     SMTC_MODEM_HAL_TRACE_PRINTF( " beacon_timestamp_us = %u us\n", timestamp * 100 );
@@ -395,7 +397,7 @@ void smtc_beacon_sniff_rp_callback( smtc_lr1_beacon_t* lr1_beacon_obj )
         beacon_epoch_time = smtc_decode_beacon_epoch_time( lr1_beacon_obj->beacon_buffer, GET_BEACON_SF( ) );
         lr1_beacon_obj->is_valid_beacon = is_valid_beacon( lr1_beacon_obj, timestamp );
         lr1_beacon_obj->beacon_buffer_length =
-            ( uint8_t ) lr1_beacon_obj->rp->payload_size[lr1_beacon_obj->beacon_sniff_id_rp];
+            ( uint8_t ) lr1_beacon_obj->rp->hook_table[lr1_beacon_obj->beacon_sniff_id_rp]->payload_size;
     }
 
     update_beacon_pll( lr1_beacon_obj, timestamp );
@@ -576,11 +578,11 @@ static void compute_beacon_metadata( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_t
 
     if( lr1_beacon_obj->is_valid_beacon == true )
     {
+        const rp_radio_params_t* radio_params =
+            &lr1_beacon_obj->rp->hook_table[lr1_beacon_obj->beacon_sniff_id_rp]->radio_params;
         lr1_beacon_obj->beacon_metadata.rx_metadata.timestamp = timestamp;
-        lr1_beacon_obj->beacon_metadata.rx_metadata.rx_snr =
-            lr1_beacon_obj->rp->radio_params[lr1_beacon_obj->beacon_sniff_id_rp].rx.lora_pkt_status.snr_pkt_in_db;
-        lr1_beacon_obj->beacon_metadata.rx_metadata.rx_rssi =
-            lr1_beacon_obj->rp->radio_params[lr1_beacon_obj->beacon_sniff_id_rp].rx.lora_pkt_status.rssi_pkt_in_dbm;
+        lr1_beacon_obj->beacon_metadata.rx_metadata.rx_snr    = radio_params->rx.lora_pkt_status.snr_pkt_in_db;
+        lr1_beacon_obj->beacon_metadata.rx_metadata.rx_rssi   = radio_params->rx.lora_pkt_status.rssi_pkt_in_dbm;
         lr1_beacon_obj->beacon_metadata.rx_metadata.rx_datarate     = BEACON_DATA_RATE( );
         lr1_beacon_obj->beacon_metadata.rx_metadata.rx_frequency_hz = GET_BEACON_FREQUENCY( );
 
@@ -597,7 +599,7 @@ static void compute_beacon_metadata( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_t
         lr1_beacon_obj->beacon_metadata.nb_beacon_missed++;
         lr1_beacon_obj->beacon_metadata.last_beacon_received_consecutively = 0;
         lr1_beacon_obj->beacon_metadata.last_beacon_lost_consecutively++;
-        if( lr1_beacon_obj->rp->tasks[lr1_beacon_obj->beacon_sniff_id_rp].type != RP_TASK_TYPE_NONE )
+        if( lr1_beacon_obj->rp->hook_table[lr1_beacon_obj->beacon_sniff_id_rp]->task.type != RP_TASK_TYPE_NONE )
         {
             if( lr1_beacon_obj->beacon_metadata.four_last_beacon_rx_statistic > 0 )
             {
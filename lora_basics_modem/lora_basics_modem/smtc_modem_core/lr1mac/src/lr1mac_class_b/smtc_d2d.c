@@ -360,10 +360,10 @@ static void class_b_d2d_rp_request( smtc_class_b_d2d_t* class_b_d2d_obj )
     rp_task.hook_id = class_b_d2d_obj->classb_d2d_id_rp;
     rp_task.state   = RP_TASK_STATE_SCHEDULE;
     // get the rp param set by the ping slot object itself
-    uint32_t ping_slot_start_time =
-        class_b_d2d_obj->ping_slot_obj->rp->tasks[class_b_d2d_obj->ping_slot_obj->ping_slot_id4rp].start_time_ms;
-    uint32_t ping_slot_rx_duration_ms =
-        class_b_d2d_obj->ping_slot_obj->rp->tasks[class_b_d2d_obj->ping_slot_obj->ping_slot_id4rp].duration_time_ms;
+    const rp_task_t* ping_slot_task =
+        &class_b_d2d_obj->ping_slot_obj->rp->hook_table[class_b_d2d_obj->ping_slot_obj->ping_slot_id4rp]->task;
+    uint32_t ping_slot_start_time     = ping_slot_task->start_time_ms;
+    uint32_t ping_slot_rx_duration_ms = ping_slot_task->duration_time_ms;
 
     // configure the d2d start time and duration even in case of cad add the cad duration to the tx duration to book
     // the right time inside the rp
@@ -376,6 +376,7 @@ static void class_b_d2d_rp_request( smtc_class_b_d2d_t* class_b_d2d_obj )
                             MAX( ( 6 * MULTICAST_SYMB_DURATION_US ) / 1000, ( ping_slot_rx_duration_ms >> 1 ) );
     rp_task.duration_time_ms      = toa;
     rp_task.launch_task_callbacks = class_b_d2d_launch_callback_for_rp;
+    rp_task.slack_ms              = 0;  // the peer only listens during its ping slot
 
     if( rp_task_enqueue( class_b_d2d_obj->ping_slot_obj->rp, &rp_task, NULL, 0, &radio_params ) != RP_HOOK_STATUS_OK )
     {
@@ -390,7 +391,7 @@ static void class_b_d2d_launch_callback_for_rp( void* rp_void )
 {
     radio_planner_t*    rp = ( radio_planner_t* ) rp_void;
     smtc_class_b_d2d_t* class_b_d2d_obj =
-        ( smtc_class_b_d2d_t* ) rp->hooks[rp->radio_task_id];  // verify if it is true !!!!
+        ( smtc_class_b_d2d_t* ) rp->hook_table[rp->radio_task_id]->hook;  // verify if it is true !!!!
 
     uint8_t            sf;
     lr1mac_bandwidth_t bw;
@@ -408,7 +409,7 @@ static void class_b_d2d_launch_callback_for_rp( void* rp_void )
                                              .cad_timeout_in_ms    = 0 };
 
         smtc_modem_hal_start_radio_tcxo( );
-        smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &RP->radio_params[rp->radio_task_id].tx.lora ) ==
+        smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &RP->hook_table[rp->radio_task_id]->radio_params.tx.lora ) ==
                                RAL_STATUS_OK );
         smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_CAD_DONE | RAL_IRQ_CAD_OK ) ==
                                RAL_STATUS_OK );
@@ -426,7 +427,7 @@ static void class_b_d2d_launch_callback_for_rp( void* rp_void )
 static void class_b_d2d_rp_callback( smtc_class_b_d2d_t* class_b_d2d_obj )
 {
     radio_planner_t* rp        = RP;
-    rp_status_t      rp_status = rp->status[class_b_d2d_obj->classb_d2d_id_rp];
+    rp_status_t      rp_status = rp->hook_table[class_b_d2d_obj->classb_d2d_id_rp]->status;
     if( rp_status == RP_STATUS_CAD_NEGATIVE )
     {
         class_b_d2d_cad_to_tx( class_b_d2d_obj );
@@ -450,7 +451,7 @@ static void class_b_d2d_rp_callback( smtc_class_b_d2d_t* class_b_d2d_obj )
         //  relaunch taskonly if nbtrans != 0
 
         smtc_duty_cycle_sum( LR1MAC->dtc_obj, MULTICAST_OBJ->rx_frequency,
-                             rp->stats.tx_last_toa_ms[class_b_d2d_obj->classb_d2d_id_rp] );
+                             rp->hook_table[class_b_d2d_obj->classb_d2d_id_rp]->stats.tx_last_toa_ms );
     }
     else if( rp_status == RP_STATUS_TASK_ABORTED )
     {
@@ -504,8 +505,9 @@ static void class_b_d2d_cad_to_tx( smtc_class_b_d2d_t* class_b_d2d_obj )
 
     if( modulation_type == LORA )
     {
-        RP->tasks[class_b_d2d_obj->classb_d2d_id_rp].type = RP_TASK_TYPE_TX_LORA;
-        smtc_modem_hal_assert( ralf_setup_lora( RP->radio, &RP->radio_params[id].tx.lora ) == RAL_STATUS_OK );
+        RP->hook_table[class_b_d2d_obj->classb_d2d_id_rp]->task.type = RP_TASK_TYPE_TX_LORA;
+        smtc_modem_hal_assert( ralf_setup_lora( RP->radio, &RP->hook_table[id]->radio_params.tx.lora ) ==
+                               RAL_STATUS_OK );
         smtc_modem_hal_assert( ral_set_dio_irq_params( &( RP->radio->ral ), RAL_IRQ_TX_DONE ) == RAL_STATUS_OK );
         smtc_modem_hal_assert( ral_set_pkt_payload( &( RP->radio->ral ), class_b_d2d_obj->tx_payload_encrypt,
                                                     class_b_d2d_obj->tx_payload_size ) == RAL_STATUS_OK );
@@ -517,9 +519,10 @@ static void class_b_d2d_cad_to_tx( smtc_class_b_d2d_t* class_b_d2d_obj )
         smtc_modem_hal_mcu_panic( );
     }
     SMTC_MODEM_HAL_TRACE_PRINTF( "launch TX , Freq = %d Hz, SF = %d BW = %d preamble length =  %d \n",
-                                 RP->radio_params[id].tx.lora.rf_freq_in_hz, RP->radio_params[id].tx.lora.mod_params.sf,
-                                 RP->radio_params[id].tx.lora.mod_params.bw,
-                                 RP->radio_params[id].tx.lora.pkt_params.preamble_len_in_symb );
+                                 RP->hook_table[id]->radio_params.tx.lora.rf_freq_in_hz,
+                                 RP->hook_table[id]->radio_params.tx.lora.mod_params.sf,
+                                 RP->hook_table[id]->radio_params.tx.lora.mod_params.bw,
+                                 RP->hook_table[id]->radio_params.tx.lora.pkt_params.preamble_len_in_symb );
 }
 
 /**
@@ -410,6 +410,7 @@ void smtc_ping_slot_start( smtc_ping_slot_t* ping_slot_obj )
         rp_task.hook_id                    = ping_slot_obj->ping_slot_id4rp;
         rp_task.state                      = RP_TASK_STATE_SCHEDULE;
         rp_task.schedule_task_low_priority = true;
+        rp_task.slack_ms                   = 0;  // the network only transmits at the ping slot time
         int8_t board_delay_ms =
             smtc_modem_hal_get_radio_tcxo_startup_delay_ms( ) + smtc_modem_hal_get_board_delay_ms( );
         smtc_real_get_rx_start_time_offset_ms( ping_slot_obj->lr1_mac, RX_SESSION_PARAM_CURRENT->rx_data_rate,
@@ -458,7 +459,7 @@ void smtc_ping_slot_rp_callback( smtc_ping_slot_t* ping_slot_obj )
 {
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "%s\n", __func__ );
 
-    rp_status_t rp_status = ping_slot_obj->rp->status[ping_slot_obj->ping_slot_id4rp];
+    rp_status_t rp_status = ping_slot_obj->rp->hook_table[ping_slot_obj->ping_slot_id4rp]->status;
     if( rp_status == RP_STATUS_RX_PACKET )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "--> RP_STATUS_RX_PACKET\n" );
@@ -508,15 +509,14 @@ void smtc_ping_slot_mac_rp_callback( smtc_ping_slot_t* ping_slot_obj )
         // save rssi and snr
         ping_slot_obj->rx_metadata.timestamp = tcurrent_ms;
         ping_slot_obj->rx_metadata.rx_snr =
-            ping_slot_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.snr_pkt_in_db;
+            ping_slot_obj->rp->hook_table[from_hook_id]->radio_params.rx.lora_pkt_status.snr_pkt_in_db;
         ping_slot_obj->rx_metadata.rx_rssi =
-            ping_slot_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm;
-        ping_slot_obj->rx_payload_size = ( uint8_t ) ping_slot_obj->rp->payload_size[from_hook_id];
+            ping_slot_obj->rp->hook_table[from_hook_id]->radio_params.rx.lora_pkt_status.rssi_pkt_in_dbm;
+        ping_slot_obj->rx_payload_size = ( uint8_t ) ping_slot_obj->rp->hook_table[from_hook_id]->payload_size;
 
         SMTC_MODEM_HAL_TRACE_PRINTF( "payload size receive = %u, snr = %d , rssi = %d\n",
-                                     ping_slot_obj->rx_payload_size,
-                                     ping_slot_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.snr_pkt_in_db,
-                                     ping_slot_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm );
+                                     ping_slot_obj->rx_payload_size, ping_slot_obj->rx_metadata.rx_snr,
+                                     ping_slot_obj->rx_metadata.rx_rssi );
 
         SMTC_MODEM_HAL_TRACE_ARRAY( "RxB Payload", ping_slot_obj->rx_payload, ping_slot_obj->rx_payload_size );
 
@@ -535,7 +535,7 @@ void smtc_ping_slot_mac_rp_callback( smtc_ping_slot_t* ping_slot_obj )
 
                 ping_slot_obj->last_toa = smtc_ping_slot_compute_downlink_toa(
                     ping_slot_obj->lr1_mac, RX_SESSION_PARAM_CURRENT->rx_data_rate,
-                    ping_slot_obj->rp->payload_size[ping_slot_obj->ping_slot_id4rp] );
+                    ping_slot_obj->rp->hook_table[ping_slot_obj->ping_slot_id4rp]->payload_size );
 
                 ping_slot_obj->rx_metadata.rx_datarate     = RX_SESSION_PARAM_CURRENT->rx_data_rate;
                 ping_slot_obj->rx_metadata.rx_frequency_hz = RX_SESSION_PARAM_CURRENT->rx_frequency;
@@ -1142,15 +1142,16 @@ static void ping_slot_mac_rx_lora_launch_callback_for_rp( void* rp_void )
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
     smtc_modem_hal_start_radio_tcxo( );
-    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->radio_params[id].rx.lora ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->hook_table[id]->radio_params.rx.lora ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_RX_DONE | RAL_IRQ_RX_TIMEOUT |
                                                                             RAL_IRQ_RX_HDR_ERROR |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact time
-    while( ( int32_t )( rp->tasks[id].start_time_100us - smtc_modem_hal_get_time_in_100us( ) ) > 0 )
+    while( ( int32_t )( rp->hook_table[id]->task.start_time_100us - smtc_modem_hal_get_time_in_100us( ) ) > 0 )
     {
     }
-    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->hook_table[id]->radio_params.rx.timeout_in_ms ) ==
+                           RAL_STATUS_OK );
     rp_stats_set_rx_timestamp( &rp->stats, smtc_modem_hal_get_time_in_ms( ) );
 }
 /* --- EOF ------------------------------------------------------------------ */
@@ -300,7 +300,7 @@ static void lr1mac_class_c_rp_callback( lr1mac_class_c_t* class_c_obj )
 {
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "%s\n", __func__ );
 
-    rp_status_t rp_status = class_c_obj->rp->status[class_c_obj->class_c_id4rp];
+    rp_status_t rp_status = class_c_obj->rp->hook_table[class_c_obj->class_c_id4rp]->status;
     if( rp_status == RP_STATUS_RX_PACKET )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "--> RP_STATUS_RX_PACKET\n" );
@@ -337,14 +337,14 @@ void lr1mac_class_c_mac_rp_callback( lr1mac_class_c_t* class_c_obj )
 
         // save rssi and snr
         class_c_obj->rx_metadata.timestamp = tcurrent_ms;
-        class_c_obj->rx_metadata.rx_snr = class_c_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.snr_pkt_in_db;
+        class_c_obj->rx_metadata.rx_snr =
+            class_c_obj->rp->hook_table[from_hook_id]->radio_params.rx.lora_pkt_status.snr_pkt_in_db;
         class_c_obj->rx_metadata.rx_rssi =
-            class_c_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm;
-        class_c_obj->rx_payload_size = ( uint8_t ) class_c_obj->rp->payload_size[from_hook_id];
+            class_c_obj->rp->hook_table[from_hook_id]->radio_params.rx.lora_pkt_status.rssi_pkt_in_dbm;
+        class_c_obj->rx_payload_size = ( uint8_t ) class_c_obj->rp->hook_table[from_hook_id]->payload_size;
 
         SMTC_MODEM_HAL_TRACE_PRINTF( "payload size receive = %u, snr = %d , rssi = %d\n", class_c_obj->rx_payload_size,
-                                     class_c_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.snr_pkt_in_db,
-                                     class_c_obj->rp->radio_params[from_hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm );
+                                     class_c_obj->rx_metadata.rx_snr, class_c_obj->rx_metadata.rx_rssi );
 
         SMTC_MODEM_HAL_TRACE_ARRAY( "RxC Payload", class_c_obj->rx_payload, class_c_obj->rx_payload_size );
 
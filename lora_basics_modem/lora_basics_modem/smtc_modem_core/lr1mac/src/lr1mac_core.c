@@ -67,6 +67,12 @@
  */
 #define FAILSAFE_DURATION 300U
 
+/*!
+ * Delay after the expected end of the radio task of the stack before the state machine is processed anyway, in case
+ * the radio irq that should have woken up the MCU has been missed
+ */
+#define LR1MAC_RADIO_EVENT_GUARD_MS 400
+
 #if( MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON )
 static const char* smtc_name_bw[]         = { "BW007", "BW010", "BW015", "BW020", "BW031", "BW041", "BW062",
                                       "BW125", "BW200", "BW250", "BW400", "BW500", "BW800", "BW1600" };
@@ -279,8 +285,8 @@ lr1mac_states_t lr1mac_core_process( lr1_stack_mac_t* lr1_mac_obj )
             lr1_mac_obj->lr1mac_state               = LWPSTATE_RX1;
             lr1_mac_obj->tx_duty_cycle_timestamp_ms = lr1_mac_obj->isr_tx_done_radio_timestamp;
             lr1_mac_obj->tx_duty_cycle_time_off_ms =
-                ( lr1_mac_obj->rp->stats.tx_last_toa_ms[myhook_id] << lr1_mac_obj->max_duty_cycle_index ) -
-                lr1_mac_obj->rp->stats.tx_last_toa_ms[myhook_id];
+                ( lr1_mac_obj->rp->hook_table[myhook_id]->stats.tx_last_toa_ms << lr1_mac_obj->max_duty_cycle_index ) -
+                lr1_mac_obj->rp->hook_table[myhook_id]->stats.tx_last_toa_ms;
 
             if( lr1_mac_obj->join_status == JOINING )
             {
@@ -290,7 +296,7 @@ lr1mac_states_t lr1mac_core_process( lr1_stack_mac_t* lr1_mac_obj )
             lr1_stack_mac_rx_timer_configure( lr1_mac_obj, RX1 );
             lr1_stack_mac_update_tx_done( lr1_mac_obj );
             smtc_duty_cycle_sum( lr1_mac_obj->dtc_obj, lr1_mac_obj->tx_frequency,
-                                 lr1_mac_obj->rp->stats.tx_last_toa_ms[myhook_id] );
+                                 lr1_mac_obj->rp->hook_table[myhook_id]->stats.tx_last_toa_ms );
 
             break;
 
@@ -689,11 +695,6 @@ void lr1mac_core_context_save( lr1_stack_mac_t* lr1_mac_obj )
 
         smtc_modem_hal_context_store( CONTEXT_LR1MAC, ( uint8_t* ) &( lr1_mac_obj->mac_context ),
                                       sizeof( lr1_mac_obj->mac_context ) );
-
-        // dummy context reading to ensure context store is done before exiting the function
-        mac_context_t dummy_context = { 0 };
-        smtc_modem_hal_context_restore( CONTEXT_LR1MAC, ( uint8_t* ) &dummy_context,
-                                        sizeof( lr1_mac_obj->mac_context ) );
     }
 }
 /**************************************************/
@@ -728,10 +729,6 @@ void lr1mac_core_factory_reset( lr1_stack_mac_t* lr1_mac_obj )
 
     smtc_modem_hal_context_store( CONTEXT_LR1MAC, ( uint8_t* ) &( lr1_mac_obj->mac_context ),
                                   sizeof( lr1_mac_obj->mac_context ) );
-
-    // dummy context reading to ensure context store is done before exiting the function
-    mac_context_t dummy_context = { 0 };
-    smtc_modem_hal_context_restore( CONTEXT_LR1MAC, ( uint8_t* ) &dummy_context, sizeof( lr1_mac_obj->mac_context ) );
 }
 
 lr1mac_activation_mode_t lr1mac_core_get_activation_mode( lr1_stack_mac_t* lr1_mac_obj )
@@ -832,6 +829,35 @@ int32_t lr1mac_core_next_free_duty_cycle_ms_get( lr1_stack_mac_t* lr1_mac_obj )
     return ret;
 }
 
+uint32_t lr1mac_core_next_process_delay_ms_get( lr1_stack_mac_t* lr1_mac_obj )
+{
+    const uint32_t now_ms   = smtc_modem_hal_get_time_in_ms( );
+    int32_t        delay_ms = 0;
+
+    if( lr1_mac_obj->lr1mac_state == LWPSTATE_IDLE )
+    {
+        return 0;
+    }
+    if( lr1_mac_obj->lr1mac_state == LWPSTATE_TX_WAIT )
+    {
+        // Retransmission backoff, the state machine moves to the send state once the target time is passed
+        delay_ms = ( int32_t )( lr1_mac_obj->rtc_target_timer_ms - now_ms ) + 1;
+    }
+    else if( ( lr1_mac_obj->radio_process_state == RADIOSTATE_PENDING ) ||
+             ( lr1_mac_obj->radio_process_state == RADIOSTATE_TX_ON ) ||
+             ( lr1_mac_obj->radio_process_state == RADIOSTATE_RX_ON ) )
+    {
+        // Waiting for the radio planner callback, which is called under the radio irq and so wakes up the MCU
+        const rp_task_t* task = &lr1_mac_obj->rp->hook_table[lr1_mac_obj->stack_id4rp]->task;
+
+        delay_ms = ( int32_t )( task->start_time_ms + task->duration_time_ms - now_ms );
+        delay_ms = MAX( delay_ms, 0 ) + LR1MAC_RADIO_EVENT_GUARD_MS;
+    }
+    // else the radio task is over, the state machine has to be processed right now
+
+    return ( delay_ms > 0 ) ? ( uint32_t ) delay_ms : 0;
+}
+
 uint8_t lr1mac_core_rx_ack_bit_get( lr1_stack_mac_t* lr1_mac_obj )
 {
     return ( lr1_mac_obj->rx_ack_bit );
@@ -1234,9 +1260,6 @@ static void save_devnonce_rst( const lr1_stack_mac_t* lr1_mac_obj )
     ctx.crc = lr1mac_utilities_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
 
     smtc_modem_hal_context_store( CONTEXT_DEVNONCE, ( uint8_t* ) &ctx, sizeof( ctx ) );
-    // dummy context reading to ensure context store is done before exiting the function
-    lr1_counter_context_t dummy_context = { 0 };
-    smtc_modem_hal_context_restore( CONTEXT_DEVNONCE, ( uint8_t* ) &dummy_context, sizeof( dummy_context ) );
 }
 
 static void load_devnonce_reset( lr1_stack_mac_t* lr1_mac_obj )
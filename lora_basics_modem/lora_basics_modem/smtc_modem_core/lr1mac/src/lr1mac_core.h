@@ -379,6 +379,17 @@ uint32_t lr1mac_core_next_join_time_second_get( lr1_stack_mac_t* lr1_mac_obj );
  */
 int32_t lr1mac_core_next_free_duty_cycle_ms_get( lr1_stack_mac_t* lr1_mac_obj );
 
+/**
+ * @brief Get the delay before the stack state machine has to be processed again
+ *
+ * @remark  The state machine only progresses on radio events and on the retransmission backoff. The radio events are
+ *          notified under the radio irq, which wakes up the MCU, so the returned delay is only a fallback for them
+ *
+ * @param lr1_mac_obj
+ * @return uint32_t Delay in ms, 0 if the state machine has to be processed right now or if the stack is idle
+ */
+uint32_t lr1mac_core_next_process_delay_ms_get( lr1_stack_mac_t* lr1_mac_obj );
+
 /**
  * @brief Get the Rx network ACK bit status
  *
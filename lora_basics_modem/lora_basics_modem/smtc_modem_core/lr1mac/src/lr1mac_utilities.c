@@ -42,6 +42,7 @@
 
 #include "lr1mac_utilities.h"
 #include "lr1mac_defs.h"
+#include "modem_crc32.h"
 
 #include "smtc_modem_hal.h"
 #include "smtc_modem_hal_dbg_trace.h"
@@ -73,17 +74,8 @@ void memset1( uint8_t* dst, uint8_t value, uint16_t size )
 
 uint32_t lr1mac_utilities_crc( uint8_t* buf, int len )
 {
-    uint32_t crc = 0xFFFFFFFA;
-    while( len-- > 0 )
-    {
-        crc = crc ^ *buf++;
-        for( int i = 0; i < 8; i++ )
-        {
-            uint32_t mask = -( crc & 1 );
-            crc           = ( crc >> 1 ) ^ ( 0xEDB88320 & mask );
-        }
-    }
-    return ~crc + 3;
+    // Same crc32 as the other contexts, with the historical lr1mac seed and offset kept for the stored contexts
+    return modem_crc32_final( modem_crc32_update( 0xFFFFFFFA, buf, len ) ) + 3;
 }
 
 uint32_t lr1mac_utilities_get_symb_time_us( const uint16_t nb_symb, const ral_lora_sf_t sf, const ral_lora_bw_t bw )
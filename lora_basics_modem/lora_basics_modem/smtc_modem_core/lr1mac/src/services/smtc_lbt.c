@@ -103,10 +103,12 @@ void smtc_lbt_launch_callback_for_rp( void* rp_void )
     uint8_t          id = rp->radio_task_id;
     int16_t          rssi_tmp;
     smtc_modem_hal_start_radio_tcxo( );
-    smtc_modem_hal_assert( ral_set_pkt_type( &( rp->radio->ral ), rp->radio_params[id].pkt_type ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_rf_freq( &( rp->radio->ral ), rp->radio_params[id].rx.gfsk.rf_freq_in_hz ) ==
+    smtc_modem_hal_assert( ral_set_pkt_type( &( rp->radio->ral ), rp->hook_table[id]->radio_params.pkt_type ) ==
                            RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_gfsk_mod_params( &( rp->radio->ral ), &rp->radio_params[id].rx.gfsk.mod_params ) ==
+    smtc_modem_hal_assert( ral_set_rf_freq( &( rp->radio->ral ),
+                                            rp->hook_table[id]->radio_params.rx.gfsk.rf_freq_in_hz ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_gfsk_mod_params( &( rp->radio->ral ),
+                                                    &rp->hook_table[id]->radio_params.rx.gfsk.mod_params ) ==
                            RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_NONE ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), RAL_RX_TIMEOUT_CONTINUOUS_MODE ) == RAL_STATUS_OK );
@@ -118,20 +120,20 @@ void smtc_lbt_launch_callback_for_rp( void* rp_void )
     do
     {
         smtc_modem_hal_assert( ral_get_rssi_inst( &( rp->radio->ral ), &rssi_tmp ) == RAL_STATUS_OK );
-        ( ( smtc_lbt_t* ) rp->hooks[id] )->rssi_inst = rssi_tmp;
-        ( ( smtc_lbt_t* ) rp->hooks[id] )->rssi_accu += rssi_tmp;
-        ( ( smtc_lbt_t* ) rp->hooks[id] )->rssi_nb_of_meas++;
-        if( rssi_tmp >= rp->radio_params[id].lbt_threshold )
+        ( ( smtc_lbt_t* ) rp->hook_table[id]->hook )->rssi_inst = rssi_tmp;
+        ( ( smtc_lbt_t* ) rp->hook_table[id]->hook )->rssi_accu += rssi_tmp;
+        ( ( smtc_lbt_t* ) rp->hook_table[id]->hook )->rssi_nb_of_meas++;
+        if( rssi_tmp >= rp->hook_table[id]->radio_params.lbt_threshold )
         {
             SMTC_MODEM_HAL_TRACE_PRINTF( "lbt rssi: %d dBm\n", rssi_tmp );
-            rp->status[id] = RP_STATUS_LBT_BUSY_CHANNEL;
+            rp->hook_table[id]->status = RP_STATUS_LBT_BUSY_CHANNEL;
             rp_radio_irq_callback( rp_void );
             return;
         }
-    } while( ( int32_t )( carrier_sense_time + rp->radio_params[id].rx.timeout_in_ms -
+    } while( ( int32_t )( carrier_sense_time + rp->hook_table[id]->radio_params.rx.timeout_in_ms -
                           smtc_modem_hal_get_time_in_ms( ) ) > 0 );
 
-    rp->status[id] = RP_STATUS_LBT_FREE_CHANNEL;
+    rp->hook_table[id]->status = RP_STATUS_LBT_FREE_CHANNEL;
     rp_radio_irq_callback( rp_void );
 }
 
@@ -67,6 +67,7 @@
 #include "smtc_modem_utilities.h"
 #include "modem_utilities.h"
 #include "smtc_modem_crypto.h"
+#include "smtc_modem_ctx.h"
 #include "lora_basics_modem_version.h"
 #include "ralf.h"
 
@@ -135,87 +136,40 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+#if !defined( LR1110_MODEM_E )
+/**
+ * @brief User task registered at runtime, in the storage given by the application
+ */
+struct smtc_modem_rp_user_task_ctx_s
+{
+    rp_hook_t hook_data;  //!< Radio planner hook of the task
+    void ( *end_task_callback )( smtc_modem_rp_status_t* status );  //!< Set by each add of the task
+    uint32_t slack_ms;                                               //!< See smtc_modem_rp_set_user_task_slack
+    uint8_t  id;                                                     //!< Radio planner hook id, the user task id
+};
+#endif  // !LR1110_MODEM_E
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-#if !defined( LR1110_MODEM_E )
-static uint8_t   modem_buffer[242];
-static uint32_t* upload_pdata;
-static uint32_t  upload_size;
-
-static radio_planner_t modem_radio_planner;
-
-smtc_modem_services_t smtc_modem_services_ctx;
-
-// LBT configuration status
-static bool lbt_config_available = false;
-
-// user_radio_access
-static rp_status_t user_radio_irq_status;
-static uint32_t    user_radio_irq_timestamp;
-static void ( *user_end_task_callback_0 )( smtc_modem_rp_status_t* status ) = NULL;
-static void ( *user_end_task_callback_1 )( smtc_modem_rp_status_t* status ) = NULL;
-static void ( *user_end_task_callback_2 )( smtc_modem_rp_status_t* status ) = NULL;
-
-#ifdef LORAWAN_BYPASS_ENABLED
-static bool stream_bypass_enabled = false;
-#endif  // LORAWAN_BYPASS_ENABLED
-
-#else  // !defined( LR1110_MODEM_E )
-
-uint8_t modem_buffer[242];
-#if defined( ADD_SMTC_FILE_UPLOAD )
-static struct
-{
-    uint32_t* upload_pdata;
-    uint32_t  upload_size;
-    uint32_t  upload_spare;
-#ifdef LORAWAN_BYPASS_ENABLED
-    bool      stream_bypass_enabled = false;
-#endif  // LORAWAN_BYPASS_ENABLED
-} modem_api_context;
-
-// clang-format off
-#define upload_pdata                modem_api_context.upload_pdata
-#define upload_size                 modem_api_context.upload_size
-#ifdef LORAWAN_BYPASS_ENABLED
-#define stream_bypass_enabled       modem_api_context.stream_bypass_enabled
-#endif  // LORAWAN_BYPASS_ENABLED
-// clang-format on
-#endif  // ADD_SMTC_FILE_UPLOAD
-
-radio_planner_t       modem_radio_planner;
-smtc_modem_services_t smtc_modem_services_ctx;
-
-// user_radio_access
-struct
-{
-    // LBT configuration status
-    bool        lbt_config_available;
-    rp_status_t user_radio_irq_status;
-    uint32_t    user_radio_irq_timestamp;
-    uint16_t    spare;
-#if !defined( LR1110_MODEM_E )
-    void ( *user_end_task_callback_0 )( smtc_modem_rp_status_t* status );
-    void ( *user_end_task_callback_1 )( smtc_modem_rp_status_t* status );
-    void ( *user_end_task_callback_2 )( smtc_modem_rp_status_t* status );
-#endif  // !LR1110_MODEM_E
-} smtc_modem_ctx;
-
-#define lbt_config_available smtc_modem_ctx.lbt_config_available
-#define user_radio_irq_status smtc_modem_ctx.user_radio_irq_status
-#define user_radio_irq_timestamp smtc_modem_ctx.user_radio_irq_timestamp
-#define user_end_task_callback_0 smtc_modem_ctx.user_end_task_callback_0
-#define user_end_task_callback_1 smtc_modem_ctx.user_end_task_callback_1
-#define user_end_task_callback_2 smtc_modem_ctx.user_end_task_callback_2
-#endif  // !defined( LR1110_MODEM_E )
+// Built-in context, used as long as no other one is set with smtc_modem_set_ctx()
+static smtc_modem_ctx_t smtc_modem_ctx_default;
+smtc_modem_ctx_t*       smtc_modem_current_ctx = &smtc_modem_ctx_default;
 
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
+/**
+ * @brief Select the modem context used by the modem calls, given to the radio planner for its interrupts
+ *
+ * @param [in] ctx  Modem context to be selected
+ * @return void*    Modem context selected before
+ */
+static void* smtc_modem_select_ctx( void* ctx );
+
 static bool modem_port_reserved( uint8_t f_port );
 
 static smtc_modem_return_code_t smtc_modem_get_dm_status_with_rate( uint8_t* dm_fields_payload,
@@ -231,6 +185,12 @@ static smtc_modem_return_code_t smtc_modem_send_empty_tx( uint8_t f_port, bool f
 static smtc_modem_return_code_t smtc_modem_send_tx( uint8_t f_port, bool confirmed, const uint8_t* payload,
                                                     uint8_t payload_length, bool emergency, uint8_t tx_buffer_id );
 
+/**
+ * @brief Read the last event, the payload of a downlink is copied in the event if \p downdata_spans is NULL
+ */
+static smtc_modem_return_code_t smtc_modem_get_event_internal( smtc_modem_event_t* event, uint8_t* event_pending_count,
+                                                               smtc_modem_dl_payload_spans_t* downdata_spans );
+
 smtc_modem_event_user_radio_access_status_t convert_rp_to_user_radio_access_status( rp_status_t rp_status );
 smtc_modem_rp_radio_status_t                convert_rp_to_user_radio_access_rp_status( rp_status_t rp_status );
 
@@ -241,6 +201,15 @@ void user_radio_access_callback( void* ctx );
 void callback_rp_user_radio_access_0( void* ctx );
 void callback_rp_user_radio_access_1( void* ctx );
 void callback_rp_user_radio_access_2( void* ctx );
+void callback_rp_user_radio_access_registered( void* ctx );
+
+/**
+ * @brief Get a user task registered with smtc_modem_rp_register_user_radio_access_task
+ *
+ * @param [in] user_task_id                 Id of the user task
+ * @return smtc_modem_rp_user_task_ctx_t*   Storage of the user task, NULL if the id is not a registered user task
+ */
+static smtc_modem_rp_user_task_ctx_t* smtc_modem_rp_get_registered_user_task( uint8_t user_task_id );
 #endif  // !LR1110_MODEM_E
 
 /*
@@ -253,51 +222,82 @@ smtc_modem_event_user_radio_access_status_t convert_rp_to_user_radio_access_stat
 
 void smtc_modem_init( const ralf_t* radio, void ( *callback_event )( void ) )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     SMTC_MODEM_HAL_TRACE_INFO( "Modem Initialization\n" );
 
+    // Power-on state: the module init functions below only set the values which are not 0
+    memset( smtc_modem_current_ctx, 0, sizeof( smtc_modem_ctx_t ) );
+
 #ifdef LORAWAN_BYPASS_ENABLED
-    stream_bypass_enabled = false;
+    modem_api->stream_bypass_enabled = false;
 #endif
     // init radio and put it in sleep mode
     ral_reset( &( radio->ral ) );
     ral_init( &( radio->ral ) );
     ral_set_sleep( &( radio->ral ), true );
+    ralf_invalidate_shadow( radio );
 
     // Save modem radio context in case of direct access to radio by the modem
     modem_context_set_modem_radio_ctx( radio->ral.context );
 
     // init radio planner and attach corresponding radio irq
-    rp_init( &modem_radio_planner, radio );
+    rp_init( &modem_api->modem_radio_planner, radio );
+    rp_irq_context_init( &modem_api->modem_radio_planner, smtc_modem_select_ctx, smtc_modem_current_ctx );
 
 #if !defined( LR1110_MODEM_E )
-    smtc_modem_hal_irq_config_radio_irq( rp_radio_irq_callback, &modem_radio_planner );
+    smtc_modem_hal_irq_config_radio_irq( rp_radio_irq_callback, &modem_api->modem_radio_planner );
 #endif
 
     // init modem supervisor
 
 #if defined( LR1110_MODEM_E )
-    smtc_rtc_compensation_init( &modem_radio_planner, RP_HOOK_ID_RTC_COMPENSATION );
+    smtc_rtc_compensation_init( &modem_api->modem_radio_planner, RP_HOOK_ID_RTC_COMPENSATION );
 #endif
-    rp_hook_init( &modem_radio_planner, RP_HOOK_ID_SUSPEND, ( void ( * )( void* ) )( empty_callback ),
-                  &modem_radio_planner );
+    rp_hook_init( &modem_api->modem_radio_planner, RP_HOOK_ID_SUSPEND, ( void ( * )( void* ) )( empty_callback ),
+                  &modem_api->modem_radio_planner );
 #if !defined( LR1110_MODEM_E )
-    rp_hook_init( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND, ( void ( * )( void* ) )( user_radio_access_callback ),
-                  &modem_radio_planner ); /* user_radio_access_callback called when interrupt occurs */
-    rp_hook_init( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_0,
-                  ( void ( * )( void* ) )( callback_rp_user_radio_access_0 ), &modem_radio_planner );
-    rp_hook_init( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_1,
-                  ( void ( * )( void* ) )( callback_rp_user_radio_access_1 ), &modem_radio_planner );
-    rp_hook_init( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_2,
-                  ( void ( * )( void* ) )( callback_rp_user_radio_access_2 ), &modem_radio_planner );
+    rp_hook_init( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND,
+                  ( void ( * )( void* ) )( user_radio_access_callback ),
+                  &modem_api->modem_radio_planner ); /* user_radio_access_callback called when interrupt occurs */
+    rp_hook_init( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_0,
+                  ( void ( * )( void* ) )( callback_rp_user_radio_access_0 ), &modem_api->modem_radio_planner );
+    rp_hook_init( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_1,
+                  ( void ( * )( void* ) )( callback_rp_user_radio_access_1 ), &modem_api->modem_radio_planner );
+    rp_hook_init( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_2,
+                  ( void ( * )( void* ) )( callback_rp_user_radio_access_2 ), &modem_api->modem_radio_planner );
 #endif  // !LR1110_MODEM_E
-    modem_supervisor_init( callback_event, &modem_radio_planner, &smtc_modem_services_ctx );
+    modem_supervisor_init( callback_event, &modem_api->modem_radio_planner, &modem_api->smtc_modem_services_ctx );
     smtc_secure_element_init( );
 }
 
+uint32_t smtc_modem_get_ctx_size( void )
+{
+    return sizeof( smtc_modem_ctx_t );
+}
+
+void smtc_modem_set_ctx( smtc_modem_ctx_t* ctx )
+{
+    smtc_modem_current_ctx = ( ctx != NULL ) ? ctx : &smtc_modem_ctx_default;
+}
+
+smtc_modem_ctx_t* smtc_modem_get_ctx( void )
+{
+    return smtc_modem_current_ctx;
+}
+
 uint32_t smtc_modem_run_engine( void )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     uint8_t nb_downlink = fifo_ctrl_get_nb_elt( lorawan_api_get_fifo_obj( ) );
 
+    // A downlink held by the application is already notified
+    if( modem_api->downlink_peek.elt_len != 0 )
+    {
+        nb_downlink--;
+    }
+
     if( nb_downlink > 0 )
     {
         increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_DOWNDATA, 0 );
@@ -315,7 +315,46 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
     RETURN_INVALID_IF_NULL( event );
     RETURN_INVALID_IF_NULL( event_pending_count );
 
+    return smtc_modem_get_event_internal( event, event_pending_count, NULL );
+}
+
+smtc_modem_return_code_t smtc_modem_get_event_zero_copy( smtc_modem_event_t* event, uint8_t* event_pending_count,
+                                                         smtc_modem_dl_payload_spans_t* downdata_spans )
+{
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( event );
+    RETURN_INVALID_IF_NULL( event_pending_count );
+    RETURN_INVALID_IF_NULL( downdata_spans );
+
+    return smtc_modem_get_event_internal( event, event_pending_count, downdata_spans );
+}
+
+smtc_modem_return_code_t smtc_modem_release_downdata( void )
+{
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    if( modem_api->downlink_peek.elt_len != 0 )
+    {
+        fifo_ctrl_commit( lorawan_api_get_fifo_obj( ), &modem_api->downlink_peek );
+    }
+    return SMTC_MODEM_RC_OK;
+}
+
+static smtc_modem_return_code_t smtc_modem_get_event_internal( smtc_modem_event_t* event, uint8_t* event_pending_count,
+                                                               smtc_modem_dl_payload_spans_t* downdata_spans )
+{
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
+
+    // The downlink given by the previous event is not used anymore
+    if( modem_api->downlink_peek.elt_len != 0 )
+    {
+        fifo_ctrl_commit( lorawan_api_get_fifo_obj( ), &modem_api->downlink_peek );
+    }
+
     const uint8_t            event_count = get_asynchronous_msgnumber( );
 
     if( event_count > MODEM_NUMBER_OF_EVENTS )
@@ -337,12 +376,31 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
             event->event_data.reset.count = lorawan_api_nb_reset_get( );
             break;
         case SMTC_MODEM_EVENT_DOWNDATA: {
-            lr1mac_down_metadata_t metadata;
-            uint8_t                metadata_len;
+            // Left to zero if the fifo holds no downlink
+            lr1mac_down_metadata_t metadata     = { 0 };
+            uint8_t                metadata_len = 0;
 
-            fifo_ctrl_get( lorawan_api_get_fifo_obj( ), event->event_data.downdata.data,
-                           &( event->event_data.downdata.length ), SMTC_MODEM_MAX_DOWNLINK_LENGTH, &metadata,
-                           &metadata_len, sizeof( lr1mac_down_metadata_t ) );
+            if( downdata_spans == NULL )
+            {
+                fifo_ctrl_get( lorawan_api_get_fifo_obj( ), event->event_data.downdata.data,
+                               &( event->event_data.downdata.length ), SMTC_MODEM_MAX_DOWNLINK_LENGTH, &metadata,
+                               &metadata_len, sizeof( lr1mac_down_metadata_t ) );
+            }
+            else
+            {
+                // The payload stays in the fifo until the application releases it
+                if( fifo_ctrl_peek( lorawan_api_get_fifo_obj( ), &modem_api->downlink_peek, &metadata, &metadata_len,
+                                    sizeof( lr1mac_down_metadata_t ) ) != FIFO_STATUS_OK )
+                {
+                    memset( &modem_api->downlink_peek, 0, sizeof( modem_api->downlink_peek ) );
+                }
+                downdata_spans->data[0]   = modem_api->downlink_peek.data[0];
+                downdata_spans->length[0] = modem_api->downlink_peek.data_len[0];
+                downdata_spans->data[1]   = modem_api->downlink_peek.data[1];
+                downdata_spans->length[1] = modem_api->downlink_peek.data_len[1];
+                event->event_data.downdata.length =
+                    modem_api->downlink_peek.data_len[0] + modem_api->downlink_peek.data_len[1];
+            }
 
             if( ( metadata.rx_rssi >= -128 ) && ( metadata.rx_rssi <= 63 ) )
             {
@@ -393,9 +451,9 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
                 ( smtc_modem_event_link_check_status_t ) get_modem_event_status( event->event_type );
             break;
         case SMTC_MODEM_EVENT_USER_RADIO_ACCESS:
-            event->event_data.user_radio_access.timestamp_ms = user_radio_irq_timestamp;
+            event->event_data.user_radio_access.timestamp_ms = modem_api->user_radio_irq_timestamp;
             event->event_data.user_radio_access.status =
-                convert_rp_to_user_radio_access_status( user_radio_irq_status );
+                convert_rp_to_user_radio_access_status( modem_api->user_radio_irq_status );
             break;
         case SMTC_MODEM_EVENT_ALMANAC_UPDATE:
             event->event_data.almanac_update.status =
@@ -551,6 +609,18 @@ smtc_modem_return_code_t smtc_modem_reset_charge( void )
     return return_code;
 }
 
+smtc_modem_return_code_t smtc_modem_get_radio_utilization( uint16_t* utilization_per_mille )
+{
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( utilization_per_mille );
+
+    smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
+    *utilization_per_mille               = rp_get_radio_utilization( &modem_api->modem_radio_planner );
+    return return_code;
+}
+
 smtc_modem_return_code_t smtc_modem_get_tx_power_offset_db( uint8_t stack_id, int8_t* tx_pwr_offset_db )
 {
     UNUSED( stack_id );
@@ -580,6 +650,8 @@ smtc_modem_return_code_t smtc_modem_time_start_sync_service( uint8_t
                                                              smtc_modem_time_sync_service_t sync_service )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
@@ -589,9 +661,9 @@ smtc_modem_return_code_t smtc_modem_time_start_sync_service( uint8_t
         return SMTC_MODEM_RC_INVALID;
     }
 
-    if( clock_sync_is_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == false )
+    if( clock_sync_is_enabled( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) ) == false )
     {
-        clock_sync_set_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ), true,
+        clock_sync_set_enabled( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ), true,
                                 ( clock_sync_service_t ) sync_service );
 
         // Activate only if modem is Joined
@@ -603,7 +675,7 @@ smtc_modem_return_code_t smtc_modem_time_start_sync_service( uint8_t
                 modem_supervisor_add_task_clock_sync_time_req( 1 );
 
                 // Force no synchronisation
-                clock_sync_set_sync_lost( &( smtc_modem_services_ctx.clock_sync_ctx ) );
+                clock_sync_set_sync_lost( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) );
             }
         }
     }
@@ -621,20 +693,22 @@ smtc_modem_return_code_t smtc_modem_time_start_sync_service( uint8_t
 smtc_modem_return_code_t smtc_modem_time_stop_sync_service( uint8_t stack_id )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
 
-    if( clock_sync_is_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
+    if( clock_sync_is_enabled( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
     {
-        clock_sync_set_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ), false,
-                                smtc_modem_services_ctx.clock_sync_ctx.sync_service_type );
+        clock_sync_set_enabled( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ), false,
+                                modem_api->smtc_modem_services_ctx.clock_sync_ctx.sync_service_type );
 
         modem_supervisor_remove_task_clock_sync( );
 
         // Force no synchronisation
-        clock_sync_set_sync_lost( &( smtc_modem_services_ctx.clock_sync_ctx ) );
+        clock_sync_set_sync_lost( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) );
     }
     else
     {
@@ -655,9 +729,12 @@ smtc_modem_return_code_t smtc_modem_get_time( uint32_t* gps_time_s, uint32_t* gp
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
 
 #if defined( ADD_SMTC_ALC_SYNC )
-    if( clock_sync_is_time_valid( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    if( clock_sync_is_time_valid( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
     {
-        clock_sync_get_gps_time_second( &( smtc_modem_services_ctx.clock_sync_ctx ), gps_time_s, gps_fractional_s );
+        clock_sync_get_gps_time_second( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ), gps_time_s,
+                                        gps_fractional_s );
     }
     else
     {
@@ -685,10 +762,12 @@ smtc_modem_return_code_t smtc_modem_get_time( uint32_t* gps_time_s, uint32_t* gp
 smtc_modem_return_code_t smtc_modem_time_set_alcsync_fport( uint8_t clock_sync_fport )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
-    if( clock_sync_set_alcsync_port( &( smtc_modem_services_ctx.clock_sync_ctx ), clock_sync_fport ) != 0 )
+    if( clock_sync_set_alcsync_port( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ), clock_sync_fport ) != 0 )
     {
         return_code = SMTC_MODEM_RC_INVALID;
     }
@@ -702,6 +781,8 @@ smtc_modem_return_code_t smtc_modem_time_set_alcsync_fport( uint8_t clock_sync_f
 smtc_modem_return_code_t smtc_modem_time_trigger_sync_request( uint8_t stack_id )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
@@ -713,7 +794,7 @@ smtc_modem_return_code_t smtc_modem_time_trigger_sync_request( uint8_t stack_id
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
 
     // Check if a time sync service is enabled
-    if( clock_sync_is_enabled( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
+    if( clock_sync_is_enabled( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
     {
         modem_supervisor_add_task_clock_sync_time_req( 1 );
     }
@@ -732,11 +813,14 @@ smtc_modem_return_code_t smtc_modem_time_trigger_sync_request( uint8_t stack_id
 smtc_modem_return_code_t smtc_modem_time_get_alcsync_fport( uint8_t* clock_sync_port )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
     RETURN_INVALID_IF_NULL( clock_sync_port );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
-    *clock_sync_port                     = clock_sync_get_alcsync_port( &( smtc_modem_services_ctx.clock_sync_ctx ) );
+    *clock_sync_port                     =
+        clock_sync_get_alcsync_port( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) );
 
     return return_code;
 #else   //  ADD_SMTC_ALC_SYNC
@@ -747,11 +831,13 @@ smtc_modem_return_code_t smtc_modem_time_get_alcsync_fport( uint8_t* clock_sync_
 smtc_modem_return_code_t smtc_modem_time_set_sync_interval_s( uint32_t sync_interval_s )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
 
-    if( clock_sync_set_interval_second( &( smtc_modem_services_ctx.clock_sync_ctx ), sync_interval_s ) !=
+    if( clock_sync_set_interval_second( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ), sync_interval_s ) !=
         CLOCK_SYNC_OK )
     {
         return_code = SMTC_MODEM_RC_INVALID;
@@ -765,11 +851,13 @@ smtc_modem_return_code_t smtc_modem_time_set_sync_interval_s( uint32_t sync_inte
 smtc_modem_return_code_t smtc_modem_time_get_sync_interval_s( uint32_t* sync_interval_s )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
     RETURN_INVALID_IF_NULL( sync_interval_s );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
-    *sync_interval_s = clock_sync_get_interval_second( &( smtc_modem_services_ctx.clock_sync_ctx ) );
+    *sync_interval_s = clock_sync_get_interval_second( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) );
     return return_code;
 #else   //  ADD_SMTC_ALC_SYNC
     return SMTC_MODEM_RC_FAIL;
@@ -779,11 +867,13 @@ smtc_modem_return_code_t smtc_modem_time_get_sync_interval_s( uint32_t* sync_int
 smtc_modem_return_code_t smtc_modem_time_set_sync_invalid_delay_s( uint32_t sync_invalid_delay_s )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
-    if( clock_sync_set_invalid_time_delay_s( &( smtc_modem_services_ctx.clock_sync_ctx ), sync_invalid_delay_s ) !=
-        CLOCK_SYNC_OK )
+    if( clock_sync_set_invalid_time_delay_s( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ),
+                                             sync_invalid_delay_s ) != CLOCK_SYNC_OK )
     {
         return_code = SMTC_MODEM_RC_INVALID;
     }
@@ -807,7 +897,10 @@ smtc_modem_return_code_t smtc_modem_time_get_sync_invalid_delay_s( uint32_t* syn
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
 
 #if defined( ADD_SMTC_ALC_SYNC )
-    *sync_invalid_delay_s = clock_sync_get_invalid_time_delay_s( &( smtc_modem_services_ctx.clock_sync_ctx ) );
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    *sync_invalid_delay_s =
+        clock_sync_get_invalid_time_delay_s( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) );
 #else   //  ADD_SMTC_ALC_SYNC
     *sync_invalid_delay_s = lorawan_api_get_device_time_invalid_delay_s( );
 #endif  //  ADD_SMTC_ALC_SYNC
@@ -998,7 +1091,9 @@ smtc_modem_return_code_t smtc_modem_set_class( uint8_t stack_id, smtc_modem_clas
     }
     case SMTC_MODEM_CLASS_B: {
 #if defined( ADD_SMTC_ALC_SYNC )
-        if( clock_sync_is_time_valid( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == false )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+        if( clock_sync_is_time_valid( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) ) == false )
 
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "set to class b is refused : modem is not time synced" );
@@ -1761,6 +1856,8 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
                                                       uint32_t average_delay_s )
 {
 #if defined( ADD_SMTC_FILE_UPLOAD )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
@@ -1785,13 +1882,13 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
         return SMTC_MODEM_RC_INVALID;
     }
     // save current file size and buff  (to keep hw modem compatiblity if needed)
-    upload_size  = file_length;
-    upload_pdata = ( uint32_t* ) file;
+    modem_api->upload_size  = file_length;
+    modem_api->upload_pdata = ( uint32_t* ) file;
 
     // get the next modem upload session counter
     uint8_t next_session_counter = modem_context_compute_and_get_next_dm_upload_sctr( );
 
-    if( file_upload_init( &( smtc_modem_services_ctx.file_upload_ctx ), UPLOAD_SID, ( uint32_t ) file_length,
+    if( file_upload_init( &( modem_api->smtc_modem_services_ctx.file_upload_ctx ), UPLOAD_SID, ( uint32_t ) file_length,
                           average_delay_s, index, ( uint8_t ) cipher_mode, next_session_counter ) != FILE_UPLOAD_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Upload initialization fails\n" );
@@ -1800,7 +1897,7 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
     SMTC_MODEM_HAL_TRACE_PRINTF( "%s, cipher_mode: %d, size:%d, average_delay:%d, session counter:%d", __func__,
                                  cipher_mode, file_length, average_delay_s, next_session_counter );
     // attach the file
-    file_upload_attach_file_buffer( &( smtc_modem_services_ctx.file_upload_ctx ), file );
+    file_upload_attach_file_buffer( &( modem_api->smtc_modem_services_ctx.file_upload_ctx ), file );
 
     modem_set_upload_state( MODEM_UPLOAD_INIT_AND_FILLED );
 
@@ -1813,6 +1910,8 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
 smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id )
 {
 #if defined( ADD_SMTC_FILE_UPLOAD )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
@@ -1832,7 +1931,7 @@ smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id )
     }
 
     // ready to prepare the file to be uploaded
-    file_upload_prepare_upload( &( smtc_modem_services_ctx.file_upload_ctx ) );
+    file_upload_prepare_upload( &( modem_api->smtc_modem_services_ctx.file_upload_ctx ) );
 
     // add the first upload task in scheduler
     modem_supervisor_add_task_file_upload( smtc_modem_hal_get_random_nb_in_range( 0, 2 ) );
@@ -1876,6 +1975,8 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t fport
                                                  uint8_t                         redundancy_ratio_percent )
 {
 #if defined( ADD_SMTC_STREAM )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
@@ -1899,10 +2000,10 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t fport
     }
 
     // First reset stream service
-    stream_reset( &( smtc_modem_services_ctx.stream_ROSE_ctx ) );
+    stream_reset( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ) );
 
     // initialize stream session
-    if( stream_init( &( smtc_modem_services_ctx.stream_ROSE_ctx ) ) != STREAM_OK )
+    if( stream_init( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ) ) != STREAM_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT FAILED\n" );
         return SMTC_MODEM_RC_FAIL;
@@ -1910,7 +2011,7 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t fport
     // enable encryption if needed
     if( cipher_mode == SMTC_MODEM_STREAM_AES_WITH_APPSKEY )
     {
-        if( stream_enable_encryption( &( smtc_modem_services_ctx.stream_ROSE_ctx ) ) != STREAM_OK )
+        if( stream_enable_encryption( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ) ) != STREAM_OK )
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT ENCRYPTION FAILED\n" );
             return SMTC_MODEM_RC_FAIL;
@@ -1921,7 +2022,7 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t fport
     modem_supervisor_remove_task( STREAM_TASK );
 
     modem_set_stream_port( fport );
-    stream_set_rr( &( smtc_modem_services_ctx.stream_ROSE_ctx ), redundancy_ratio_percent );
+    stream_set_rr( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ), redundancy_ratio_percent );
     modem_set_stream_encryption( cipher_mode == SMTC_MODEM_STREAM_AES_WITH_APPSKEY );
     modem_set_stream_state( MODEM_STREAM_INIT );
 
@@ -1934,6 +2035,8 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t fport
 smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uint8_t* data, uint8_t len )
 {
 #if defined( ADD_SMTC_STREAM )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
     RETURN_INVALID_IF_NULL( data );
@@ -1957,7 +2060,8 @@ smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uin
         }
     }
 
-    stream_return_code_t stream_rc = stream_add_data( &( smtc_modem_services_ctx.stream_ROSE_ctx ), data, len );
+    stream_return_code_t stream_rc =
+        stream_add_data( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ), data, len );
 
     switch( stream_rc )
     {
@@ -1975,7 +2079,7 @@ smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uin
     }
 
 #ifdef LORAWAN_BYPASS_ENABLED
-    if( stream_bypass_enabled == true )
+    if( modem_api->stream_bypass_enabled == true )
     {
         SMTC_MODEM_HAL_TRACE_INFO( "STREAM_SEND BYPASS [OK]\n" );
         return SMTC_MODEM_RC_OK;
@@ -1994,6 +2098,8 @@ smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uin
 smtc_modem_return_code_t smtc_modem_stream_status( uint8_t stack_id, uint16_t* pending, uint16_t* free )
 {
 #if defined( ADD_SMTC_STREAM )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
     RETURN_INVALID_IF_NULL( pending );
@@ -2004,7 +2110,7 @@ smtc_modem_return_code_t smtc_modem_stream_status( uint8_t stack_id, uint16_t* p
         return SMTC_MODEM_RC_NOT_INIT;
     }
 
-    stream_status( &( smtc_modem_services_ctx.stream_ROSE_ctx ), pending, free );
+    stream_status( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ), pending, free );
     return SMTC_MODEM_RC_OK;
 #else   // ADD_SMTC_STREAM
     return SMTC_MODEM_RC_FAIL;
@@ -2022,8 +2128,10 @@ smtc_modem_return_code_t smtc_modem_stream_status( uint8_t stack_id, uint16_t* p
  */
 void modem_stream_bypass_enable( bool enabled )
 {
-    stream_bypass_enabled = enabled;
-    SMTC_MODEM_HAL_TRACE_PRINTF( "STREAM BYPASS %d\n", stream_bypass_enabled );
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    modem_api->stream_bypass_enabled = enabled;
+    SMTC_MODEM_HAL_TRACE_PRINTF( "STREAM BYPASS %d\n", modem_api->stream_bypass_enabled );
 }
 
 /*
@@ -2031,7 +2139,9 @@ void modem_stream_bypass_enable( bool enabled )
  */
 smtc_modem_return_code_t smtc_modem_stream_bypass_get_fragment( uint8_t* buffer, uint32_t frag_cnt, uint8_t* len )
 {
-    if( !stream_bypass_enabled )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    if( !modem_api->stream_bypass_enabled )
     {
         return SMTC_MODEM_RC_FAIL;
     }
@@ -2051,7 +2161,9 @@ smtc_modem_return_code_t smtc_modem_stream_bypass_get_fragment( uint8_t* buffer,
  */
 smtc_modem_return_code_t smtc_modem_stream_bypass_send_downlink( uint8_t* buffer, uint8_t len )
 {
-    if( !stream_bypass_enabled )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    if( !modem_api->stream_bypass_enabled )
     {
         return SMTC_MODEM_RC_FAIL;
     }
@@ -2165,20 +2277,26 @@ smtc_modem_return_code_t smtc_modem_get_duty_cycle_status( int32_t* duty_cycle_s
 smtc_modem_return_code_t smtc_modem_rp_abort_user_radio_access_task( uint8_t user_task_id )
 {
 #if !defined( LR1110_MODEM_E )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     rp_hook_status_t status = RP_HOOK_STATUS_ID_ERROR;
     switch( user_task_id )
     {
     case SMTC_MODEM_RP_TASK_ID0:
-        status = rp_task_abort( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_0 );
+        status = rp_task_abort( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_0 );
         break;
     case SMTC_MODEM_RP_TASK_ID1:
-        status = rp_task_abort( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_1 );
+        status = rp_task_abort( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_1 );
         break;
     case SMTC_MODEM_RP_TASK_ID2:
-        status = rp_task_abort( &modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_2 );
+        status = rp_task_abort( &modem_api->modem_radio_planner, RP_HOOK_ID_USER_SUSPEND_2 );
         break;
     default:
-        return SMTC_MODEM_RC_INVALID;
+        if( smtc_modem_rp_get_registered_user_task( user_task_id ) == NULL )
+        {
+            return SMTC_MODEM_RC_INVALID;
+        }
+        status = rp_task_abort( &modem_api->modem_radio_planner, user_task_id );
         break;
     }
     return ( status == RP_HOOK_STATUS_OK ) ? SMTC_MODEM_RC_OK : SMTC_MODEM_RC_FAIL;
@@ -2190,28 +2308,44 @@ smtc_modem_return_code_t smtc_modem_rp_abort_user_radio_access_task( uint8_t use
 smtc_modem_return_code_t smtc_modem_rp_add_user_radio_access_task( smtc_modem_rp_task_t* rp_task )
 {
 #if !defined( LR1110_MODEM_E )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
 
     rp_radio_params_t fake_radio_params = { 0 };
     uint8_t           user_hook_id_temp = 0;
+    uint32_t          slack_ms          = 0;
     switch( rp_task->id )
     {
     case SMTC_MODEM_RP_TASK_ID0:
-        user_end_task_callback_0 = rp_task->end_task_callback;
-        user_hook_id_temp        = RP_HOOK_ID_USER_SUSPEND_0;
+        modem_api->user_end_task_callback_0 = rp_task->end_task_callback;
+        user_hook_id_temp                   = RP_HOOK_ID_USER_SUSPEND_0;
+        slack_ms                            = modem_api->user_task_slack_ms_0;
         break;
     case SMTC_MODEM_RP_TASK_ID1:
-        user_end_task_callback_1 = rp_task->end_task_callback;
-        user_hook_id_temp        = RP_HOOK_ID_USER_SUSPEND_1;
+        modem_api->user_end_task_callback_1 = rp_task->end_task_callback;
+        user_hook_id_temp                   = RP_HOOK_ID_USER_SUSPEND_1;
+        slack_ms                            = modem_api->user_task_slack_ms_1;
         break;
     case SMTC_MODEM_RP_TASK_ID2:
-        user_end_task_callback_2 = rp_task->end_task_callback;
-        user_hook_id_temp        = RP_HOOK_ID_USER_SUSPEND_2;
+        modem_api->user_end_task_callback_2 = rp_task->end_task_callback;
+        user_hook_id_temp                   = RP_HOOK_ID_USER_SUSPEND_2;
+        slack_ms                            = modem_api->user_task_slack_ms_2;
         break;
     default:
-        return SMTC_MODEM_RC_INVALID;
+    {
+        smtc_modem_rp_user_task_ctx_t* user_task = smtc_modem_rp_get_registered_user_task( rp_task->id );
+
+        if( user_task == NULL )
+        {
+            return SMTC_MODEM_RC_INVALID;
+        }
+        user_task->end_task_callback = rp_task->end_task_callback;
+        user_hook_id_temp            = user_task->id;
+        slack_ms                     = user_task->slack_ms;
         break;
     }
+    }
 
     rp_task_t rp_task_tmp = { .hook_id               = user_hook_id_temp,
                               .launch_task_callbacks = rp_task->launch_task_callback,
@@ -2219,9 +2353,11 @@ smtc_modem_return_code_t smtc_modem_rp_add_user_radio_access_task( smtc_modem_rp
                               .state = ( rp_task->type == SMTC_MODEM_RP_TASK_STATE_SCHEDULE ) ? RP_TASK_STATE_SCHEDULE
                                                                                               : RP_TASK_STATE_ASAP,
                               .schedule_task_low_priority = false,
-                              .start_time_ms              = rp_task->start_time_ms };
+                              .start_time_ms              = rp_task->start_time_ms,
+                              .slack_ms                   = slack_ms };
 
-    rp_hook_status_t status = rp_task_enqueue( &modem_radio_planner, &rp_task_tmp, NULL, 0, &fake_radio_params );
+    rp_hook_status_t status =
+        rp_task_enqueue( &modem_api->modem_radio_planner, &rp_task_tmp, NULL, 0, &fake_radio_params );
 
     return ( status == RP_HOOK_STATUS_OK ) ? SMTC_MODEM_RC_OK : SMTC_MODEM_RC_FAIL;
 #else   // !LR1110_MODEM_E
@@ -2229,6 +2365,95 @@ smtc_modem_return_code_t smtc_modem_rp_add_user_radio_access_task( smtc_modem_rp
 #endif  // !LR1110_MODEM_E
 }
 
+smtc_modem_return_code_t smtc_modem_rp_set_user_task_slack( uint8_t user_task_id, uint32_t slack_ms )
+{
+#if !defined( LR1110_MODEM_E )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    switch( user_task_id )
+    {
+    case SMTC_MODEM_RP_TASK_ID0:
+        modem_api->user_task_slack_ms_0 = slack_ms;
+        break;
+    case SMTC_MODEM_RP_TASK_ID1:
+        modem_api->user_task_slack_ms_1 = slack_ms;
+        break;
+    case SMTC_MODEM_RP_TASK_ID2:
+        modem_api->user_task_slack_ms_2 = slack_ms;
+        break;
+    default:
+    {
+        smtc_modem_rp_user_task_ctx_t* user_task = smtc_modem_rp_get_registered_user_task( user_task_id );
+
+        if( user_task == NULL )
+        {
+            return SMTC_MODEM_RC_INVALID;
+        }
+        user_task->slack_ms = slack_ms;
+        break;
+    }
+    }
+    return SMTC_MODEM_RC_OK;
+#else   // !LR1110_MODEM_E
+    return SMTC_MODEM_RC_FAIL;
+#endif  // !LR1110_MODEM_E
+}
+
+uint32_t smtc_modem_rp_get_user_task_ctx_size( void )
+{
+#if !defined( LR1110_MODEM_E )
+    return sizeof( smtc_modem_rp_user_task_ctx_t );
+#else   // !LR1110_MODEM_E
+    return 0;
+#endif  // !LR1110_MODEM_E
+}
+
+smtc_modem_return_code_t smtc_modem_rp_register_user_radio_access_task( smtc_modem_rp_user_task_ctx_t* user_task,
+                                                                       uint8_t*                       user_task_id )
+{
+#if !defined( LR1110_MODEM_E )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( user_task );
+    RETURN_INVALID_IF_NULL( user_task_id );
+
+    user_task->end_task_callback = NULL;
+    user_task->slack_ms          = 0;
+    if( rp_hook_register( &modem_api->modem_radio_planner, &user_task->hook_data,
+                          ( void ( * )( void* ) )( callback_rp_user_radio_access_registered ), user_task,
+                          &user_task->id ) != RP_HOOK_STATUS_OK )
+    {
+        return SMTC_MODEM_RC_FAIL;
+    }
+    *user_task_id = user_task->id;
+    return SMTC_MODEM_RC_OK;
+#else   // !LR1110_MODEM_E
+    return SMTC_MODEM_RC_FAIL;
+#endif  // !LR1110_MODEM_E
+}
+
+smtc_modem_return_code_t smtc_modem_rp_unregister_user_radio_access_task( uint8_t user_task_id )
+{
+#if !defined( LR1110_MODEM_E )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    if( smtc_modem_rp_get_registered_user_task( user_task_id ) == NULL )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
+    return ( rp_hook_unregister( &modem_api->modem_radio_planner, user_task_id ) == RP_HOOK_STATUS_OK )
+               ? SMTC_MODEM_RC_OK
+               : SMTC_MODEM_RC_FAIL;
+#else   // !LR1110_MODEM_E
+    return SMTC_MODEM_RC_FAIL;
+#endif  // !LR1110_MODEM_E
+}
+
 smtc_modem_return_code_t smtc_modem_suspend_before_user_radio_access( void )
 {
 #if !defined( LR1110_MODEM_E )
@@ -2250,6 +2475,8 @@ smtc_modem_return_code_t smtc_modem_suspend_before_user_radio_access( void )
 smtc_modem_return_code_t smtc_modem_resume_after_user_radio_access( void )
 {
 #if !defined( LR1110_MODEM_E )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
 
     SMTC_MODEM_HAL_TRACE_PRINTF( "Resume modem user radio access\n" );
@@ -2257,6 +2484,9 @@ smtc_modem_return_code_t smtc_modem_resume_after_user_radio_access( void )
     // First stop the radio_planner suspension (always RC_OK)
     modem_context_resume_user_radio_access( );
 
+    // The radio may have been configured by the user outside of RALF
+    ralf_invalidate_shadow( modem_api->modem_radio_planner.radio );
+
     // Then put the modem in NOT_SUSPENDED mode to relaunch the scheduler (always RC_OK)
     smtc_modem_suspend_radio_communications( false );
 
@@ -2311,6 +2541,8 @@ smtc_modem_return_code_t smtc_modem_get_network_type( uint8_t stack_id, bool* ne
 smtc_modem_return_code_t smtc_modem_lbt_set_parameters( uint8_t stack_id, uint32_t listen_duration_ms,
                                                         int16_t threshold_dbm, uint32_t bw_hz )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
@@ -2318,7 +2550,7 @@ smtc_modem_return_code_t smtc_modem_lbt_set_parameters( uint8_t stack_id, uint32
 
     lorawan_api_lbt_set_parameters( listen_duration_ms, threshold_dbm, bw_hz );
 
-    lbt_config_available = true;
+    modem_api->lbt_config_available = true;
     return SMTC_MODEM_RC_OK;
 }
 
@@ -2338,13 +2570,15 @@ smtc_modem_return_code_t smtc_modem_lbt_get_parameters( uint8_t stack_id, uint32
 
 smtc_modem_return_code_t smtc_modem_lbt_set_state( uint8_t stack_id, bool enable )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
     if( enable == true )
     {
         // check if a configuration was set before
-        if( lbt_config_available == true )
+        if( modem_api->lbt_config_available == true )
         {
             lorawan_api_lbt_set_state( true );
             return SMTC_MODEM_RC_OK;
@@ -2726,10 +2960,12 @@ smtc_modem_return_code_t smtc_modem_derive_keys( uint8_t stack_id )
 smtc_modem_return_code_t smtc_modem_stream_get_redundancy_ratio( uint8_t stack_id, uint8_t* stream_rr )
 {
 #if defined( ADD_SMTC_STREAM )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
-    *stream_rr = stream_get_rr( &( smtc_modem_services_ctx.stream_ROSE_ctx ) );
+    *stream_rr = stream_get_rr( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ) );
     return SMTC_MODEM_RC_OK;
 #else   // ADD_SMTC_STREAM
     return SMTC_MODEM_RC_FAIL;
@@ -2739,10 +2975,12 @@ smtc_modem_return_code_t smtc_modem_stream_get_redundancy_ratio( uint8_t stack_i
 smtc_modem_return_code_t smtc_modem_stream_set_redundancy_ratio( uint8_t stack_id, uint8_t redundancy_ratio_percent )
 {
 #if defined( ADD_SMTC_STREAM )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
-    stream_set_rr( &( smtc_modem_services_ctx.stream_ROSE_ctx ), redundancy_ratio_percent );
+    stream_set_rr( &( modem_api->smtc_modem_services_ctx.stream_ROSE_ctx ), redundancy_ratio_percent );
     return SMTC_MODEM_RC_OK;
 #else   // ADD_SMTC_STREAM
     return SMTC_MODEM_RC_FAIL;
@@ -2780,7 +3018,9 @@ smtc_modem_return_code_t smtc_modem_time_available( void )
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_NO_TIME;
 
 #if defined( ADD_SMTC_ALC_SYNC )
-    if( clock_sync_is_time_valid( &( smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
+    if( clock_sync_is_time_valid( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ) ) == true )
     {
         return_code = SMTC_MODEM_RC_OK;
     }
@@ -2797,10 +3037,12 @@ smtc_modem_return_code_t smtc_modem_time_available( void )
 smtc_modem_return_code_t smtc_modem_set_time( uint32_t gps_time_s )
 {
 #if defined( ADD_SMTC_ALC_SYNC )
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     RETURN_BUSY_IF_TEST_MODE( );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
-    clock_sync_set_gps_time( &( smtc_modem_services_ctx.clock_sync_ctx ), gps_time_s );
+    clock_sync_set_gps_time( &( modem_api->smtc_modem_services_ctx.clock_sync_ctx ), gps_time_s );
 
     return return_code;
 #else   // ADD_SMTC_ALC_SYNC
@@ -2817,6 +3059,8 @@ void empty_task_launch_callback_for_rp( void* rp_void )
 
 void smtc_modem_suspend_rp( e_sniff_mode_t sniff_mode )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     rp_radio_params_t fake_radio_params = { 0 };
     rp_task_t         rp_task           = { 0 };
     uint8_t           fake_payload[2]   = { 0 };
@@ -2852,12 +3096,14 @@ void smtc_modem_suspend_rp( e_sniff_mode_t sniff_mode )
     }
     rp_task.launch_task_callbacks = empty_task_launch_callback_for_rp;
     rp_task.start_time_ms         = smtc_modem_hal_get_time_in_ms( ) + 4;
-    rp_task_enqueue( &modem_radio_planner, &rp_task, fake_payload, fake_payload_size, &fake_radio_params );
+    rp_task_enqueue( &modem_api->modem_radio_planner, &rp_task, fake_payload, fake_payload_size, &fake_radio_params );
 }
 void smtc_modem_resume_rp( void )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     SMTC_MODEM_HAL_TRACE_PRINTF( "Resume rp\n" );
-    rp_task_abort( &modem_radio_planner, 0 );
+    rp_task_abort( &modem_api->modem_radio_planner, 0 );
     smtc_modem_hal_stop_radio_tcxo( );
 }
 
@@ -2891,6 +3137,29 @@ smtc_modem_return_code_t smtc_modem_get_output_power_lut( uint8_t config[30] )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void* smtc_modem_select_ctx( void* ctx )
+{
+    smtc_modem_ctx_t* previous_ctx = smtc_modem_current_ctx;
+
+    smtc_modem_current_ctx = ( smtc_modem_ctx_t* ) ctx;
+    return previous_ctx;
+}
+
+#if !defined( LR1110_MODEM_E )
+static smtc_modem_rp_user_task_ctx_t* smtc_modem_rp_get_registered_user_task( uint8_t user_task_id )
+{
+    radio_planner_t* rp = &smtc_modem_current_ctx->api.modem_radio_planner;
+
+    // The hooks registered by the modem layers are not user tasks, only the callback of the user ones tells them apart
+    if( ( user_task_id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[user_task_id] == NULL ) ||
+        ( rp->hook_table[user_task_id]->callback != callback_rp_user_radio_access_registered ) )
+    {
+        return NULL;
+    }
+    return ( smtc_modem_rp_user_task_ctx_t* ) rp->hook_table[user_task_id]->hook;
+}
+#endif  // !LR1110_MODEM_E
+
 static bool modem_port_reserved( uint8_t f_port )
 {
     return ( f_port >= 224 );
@@ -2956,13 +3225,13 @@ static smtc_modem_return_code_t smtc_modem_send_empty_tx( uint8_t f_port, bool f
     }
     else
     {
-        task_send.priority          = TASK_HIGH_PRIORITY;
-        task_send.id                = SEND_TASK;
-        task_send.fPort             = f_port;
-        task_send.fPort_present     = f_port_present;
-        task_send.PacketType        = confirmed;
-        task_send.sizeIn            = 0;
-        task_send.time_to_execute_s = smtc_modem_hal_get_time_in_s( );
+        task_send.priority      = TASK_HIGH_PRIORITY;
+        task_send.id            = SEND_TASK;
+        task_send.fPort         = f_port;
+        task_send.fPort_present = f_port_present;
+        task_send.PacketType    = confirmed;
+        task_send.sizeIn        = 0;
+        modem_supervisor_set_task_delay( &task_send, 0, 0 );
 
         if( modem_supervisor_add_task( &task_send ) != TASK_VALID )
         {
@@ -2975,6 +3244,8 @@ static smtc_modem_return_code_t smtc_modem_send_empty_tx( uint8_t f_port, bool f
 static smtc_modem_return_code_t smtc_modem_send_tx( uint8_t f_port, bool confirmed, const uint8_t* payload,
                                                     uint8_t payload_length, bool emergency, uint8_t tx_buffer_id )
 {
+    smtc_modem_ctx_buffers_t* buffers = &smtc_modem_current_ctx->buffers;
+
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
     smodem_task              task_send;
 
@@ -3003,9 +3274,9 @@ static smtc_modem_return_code_t smtc_modem_send_tx( uint8_t f_port, bool confirm
         switch( tx_buffer_id )
         {
         case 0:
-            memcpy( modem_buffer, payload, payload_length );
+            memcpy( buffers->modem_buffer, payload, payload_length );
             task_send.id     = SEND_TASK;
-            task_send.dataIn = modem_buffer;
+            task_send.dataIn = buffers->modem_buffer;
             break;
         case 1:
             task_send.id     = SEND_TASK_EXTENDED_1;
@@ -3020,11 +3291,11 @@ static smtc_modem_return_code_t smtc_modem_send_tx( uint8_t f_port, bool confirm
         default:
             return SMTC_MODEM_RC_FAIL;
         }
-        task_send.fPort             = f_port;
-        task_send.fPort_present     = true;
-        task_send.PacketType        = confirmed;
-        task_send.sizeIn            = payload_length;
-        task_send.time_to_execute_s = smtc_modem_hal_get_time_in_s( );
+        task_send.fPort         = f_port;
+        task_send.fPort_present = true;
+        task_send.PacketType    = confirmed;
+        task_send.sizeIn        = payload_length;
+        modem_supervisor_set_task_delay( &task_send, 0, 0 );
 
         // SMTC_MODEM_HAL_TRACE_INFO( "add task user tx payload with payload size = %d \n ", payload_length );
         if( modem_supervisor_add_task( &task_send ) != TASK_VALID )
@@ -3129,11 +3400,16 @@ void empty_callback( void* ctx )
 
 void user_radio_access_callback( void* ctx )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     radio_planner_t* rp = ( radio_planner_t* ) ctx;
 
-    rp_get_status( rp, rp->radio_task_id, &user_radio_irq_timestamp, &user_radio_irq_status );
+    // The radio may have been configured by the user outside of RALF
+    ralf_invalidate_shadow( rp->radio );
+
+    rp_get_status( rp, rp->radio_task_id, &modem_api->user_radio_irq_timestamp, &modem_api->user_radio_irq_status );
 
-    switch( user_radio_irq_status )
+    switch( modem_api->user_radio_irq_status )
     {
     case RP_STATUS_TASK_ABORTED:
         SMTC_MODEM_HAL_TRACE_INFO( "User radio access callback: ignored ABORTED status \n" );
@@ -3147,12 +3423,17 @@ void user_radio_access_callback( void* ctx )
 #if !defined( LR1110_MODEM_E )
 void callback_rp_user_radio_access_0( void* ctx )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     radio_planner_t*       rp              = ( radio_planner_t* ) ctx;
     smtc_modem_rp_status_t modem_rp_status = { 0 };
     uint32_t               rp_timestamp    = 0;
     ral_irq_t              rp_radio_irq    = 0;
     rp_status_t            rp_status;
 
+    // The radio may have been configured by the user outside of RALF
+    ralf_invalidate_shadow( rp->radio );
+
     rp_get_status( rp, RP_HOOK_ID_USER_SUSPEND_0, &rp_timestamp, &rp_status );
     rp_get_and_clear_raw_radio_irq( rp, RP_HOOK_ID_USER_SUSPEND_0, &rp_radio_irq );
 
@@ -3162,20 +3443,25 @@ void callback_rp_user_radio_access_0( void* ctx )
     modem_rp_status.raw_irq      = ( uint16_t ) rp_radio_irq;
 
     // call user callback
-    if( *user_end_task_callback_0 != NULL )
+    if( *modem_api->user_end_task_callback_0 != NULL )
     {
-        user_end_task_callback_0( &modem_rp_status );
+        modem_api->user_end_task_callback_0( &modem_rp_status );
     }
 }
 
 void callback_rp_user_radio_access_1( void* ctx )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     radio_planner_t*       rp              = ( radio_planner_t* ) ctx;
     smtc_modem_rp_status_t modem_rp_status = { 0 };
     uint32_t               rp_timestamp    = 0;
     ral_irq_t              rp_radio_irq    = 0;
     rp_status_t            rp_status;
 
+    // The radio may have been configured by the user outside of RALF
+    ralf_invalidate_shadow( rp->radio );
+
     rp_get_status( rp, RP_HOOK_ID_USER_SUSPEND_1, &rp_timestamp, &rp_status );
     rp_get_and_clear_raw_radio_irq( rp, RP_HOOK_ID_USER_SUSPEND_1, &rp_radio_irq );
 
@@ -3185,20 +3471,25 @@ void callback_rp_user_radio_access_1( void* ctx )
     modem_rp_status.raw_irq      = ( uint16_t ) rp_radio_irq;
 
     // call user callback
-    if( *user_end_task_callback_1 != NULL )
+    if( *modem_api->user_end_task_callback_1 != NULL )
     {
-        user_end_task_callback_1( &modem_rp_status );
+        modem_api->user_end_task_callback_1( &modem_rp_status );
     }
 }
 
 void callback_rp_user_radio_access_2( void* ctx )
 {
+    smtc_modem_api_ctx_t* modem_api = &smtc_modem_current_ctx->api;
+
     radio_planner_t*       rp              = ( radio_planner_t* ) ctx;
     smtc_modem_rp_status_t modem_rp_status = { 0 };
     uint32_t               rp_timestamp    = 0;
     ral_irq_t              rp_radio_irq    = 0;
     rp_status_t            rp_status;
 
+    // The radio may have been configured by the user outside of RALF
+    ralf_invalidate_shadow( rp->radio );
+
     rp_get_status( rp, RP_HOOK_ID_USER_SUSPEND_2, &rp_timestamp, &rp_status );
     rp_get_and_clear_raw_radio_irq( rp, RP_HOOK_ID_USER_SUSPEND_2, &rp_radio_irq );
 
@@ -3208,9 +3499,37 @@ void callback_rp_user_radio_access_2( void* ctx )
     modem_rp_status.raw_irq      = ( uint16_t ) rp_radio_irq;
 
     // call user callback
-    if( *user_end_task_callback_2 != NULL )
+    if( *modem_api->user_end_task_callback_2 != NULL )
+    {
+        modem_api->user_end_task_callback_2( &modem_rp_status );
+    }
+}
+
+void callback_rp_user_radio_access_registered( void* ctx )
+{
+    smtc_modem_rp_user_task_ctx_t* user_task = ( smtc_modem_rp_user_task_ctx_t* ) ctx;
+
+    radio_planner_t*       rp              = &smtc_modem_current_ctx->api.modem_radio_planner;
+    smtc_modem_rp_status_t modem_rp_status = { 0 };
+    uint32_t               rp_timestamp    = 0;
+    ral_irq_t              rp_radio_irq    = 0;
+    rp_status_t            rp_status;
+
+    // The radio may have been configured by the user outside of RALF
+    ralf_invalidate_shadow( rp->radio );
+
+    rp_get_status( rp, user_task->id, &rp_timestamp, &rp_status );
+    rp_get_and_clear_raw_radio_irq( rp, user_task->id, &rp_radio_irq );
+
+    modem_rp_status.id           = user_task->id;
+    modem_rp_status.timestamp_ms = rp_timestamp;
+    modem_rp_status.status       = convert_rp_to_user_radio_access_rp_status( rp_status );
+    modem_rp_status.raw_irq      = ( uint16_t ) rp_radio_irq;
+
+    // call user callback
+    if( user_task->end_task_callback != NULL )
     {
-        user_end_task_callback_2( &modem_rp_status );
+        user_task->end_task_callback( &modem_rp_status );
     }
 }
 #endif  // !LR1110_MODEM_E
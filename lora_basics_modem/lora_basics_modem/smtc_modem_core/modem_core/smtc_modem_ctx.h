@@ -0,0 +1,311 @@
+/*!
+ * \file      smtc_modem_ctx.h
+ *
+ * \brief     modem context: the whole state of one soft modem instance
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_MODEM_CTX__H
+#define __SMTC_MODEM_CTX__H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "smtc_modem_utilities.h"
+#include "smtc_modem_middleware_advanced_api.h"
+#include "radio_planner.h"
+#include "lr1_stack_mac_layer.h"
+#include "lorawan_certification.h"
+#include "smtc_real.h"
+#include "smtc_lbt.h"
+#include "smtc_duty_cycle.h"
+#include "smtc_multicast.h"
+#include "smtc_ping_slot.h"
+#include "smtc_beacon_sniff.h"
+#include "smtc_d2d.h"
+#include "lr1mac_class_c.h"
+#include "fifo_ctrl.h"
+#include "modem_supervisor.h"
+#include "modem_context.h"
+
+#if !defined( LR1110_MODEM_E )
+#include "smtc_secure_element_ctx.h"
+#endif  // !LR1110_MODEM_E
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+#define SMTC_MODEM_BUFFER_SIZE 242
+#define SMTC_MODEM_CERTIF_PAYLOAD_SIZE 242
+#define FIFO_LORAWAN_SIZE 512
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * \typedef modem_test_context_t
+ * \brief   Test context
+ */
+typedef struct modem_test_context
+{
+    radio_planner_t* rp;                  //!< Radio planner instance
+    lr1_stack_mac_t* lr1_mac_obj;         //!< Lorawan lr1mac instance
+    uint8_t          hook_id;             //!< Lorawan lr1mac hook id used for test
+    uint8_t          tx_rx_payload[255];  //!< Transmit/Received buffer
+    int16_t          rssi;                //!< Placeholder for mean rssi
+    bool             rssi_ready;          //!< True when rssi mean test is finished
+    uint32_t         total_rx_packets;    //!< Number of received packet
+    bool             random_payload;      //!< True in case of random payload
+} modem_test_context_t;
+
+/*!
+ * \typedef lorawan_api_ctx_t
+ * \brief   LoRaWAN stack part of the modem context (lorawan_api.c)
+ */
+typedef struct lorawan_api_ctx_s
+{
+    lr1_stack_mac_t   lr1_mac_obj;
+    smtc_real_t       real;
+    smtc_lbt_t        lbt_obj;
+    smtc_dtc_t        duty_cycle_obj;
+    lr1mac_class_c_t  class_c_obj;
+    fifo_ctrl_t       fifo_ctrl_obj;
+    smtc_lr1_beacon_t lr1_beacon_obj;
+    smtc_ping_slot_t  ping_slot_obj;
+#if defined( SMTC_MULTICAST )
+    smtc_multicast_t multicast_obj;
+#endif
+#if defined( SMTC_D2D )
+    smtc_class_b_d2d_t class_b_d2d_obj;
+#endif
+    lorawan_certification_t lorawan_certif_obj;
+} lorawan_api_ctx_t;
+
+/*!
+ * \typedef smtc_modem_api_ctx_t
+ * \brief   Modem api part of the modem context (smtc_modem.c)
+ */
+typedef struct smtc_modem_api_ctx_s
+{
+    radio_planner_t modem_radio_planner;
+
+    // LBT configuration status
+    bool lbt_config_available;
+
+    // user_radio_access
+    rp_status_t user_radio_irq_status;
+    uint32_t    user_radio_irq_timestamp;
+
+    // Downlink held by the application, see smtc_modem_get_event_zero_copy
+    fifo_ctrl_peek_t downlink_peek;
+
+#if !defined( LR1110_MODEM_E )
+    void ( *user_end_task_callback_0 )( smtc_modem_rp_status_t* status );
+    void ( *user_end_task_callback_1 )( smtc_modem_rp_status_t* status );
+    void ( *user_end_task_callback_2 )( smtc_modem_rp_status_t* status );
+    uint32_t user_task_slack_ms_0;  // see smtc_modem_rp_set_user_task_slack
+    uint32_t user_task_slack_ms_1;
+    uint32_t user_task_slack_ms_2;
+#endif  // !LR1110_MODEM_E
+
+#ifdef LORAWAN_BYPASS_ENABLED
+    bool stream_bypass_enabled;
+#endif  // LORAWAN_BYPASS_ENABLED
+
+    uint32_t* upload_pdata;
+    uint32_t  upload_size;
+
+    smtc_modem_services_t smtc_modem_services_ctx;
+} smtc_modem_api_ctx_t;
+
+/*!
+ * \typedef modem_supervisor_ctx_t
+ * \brief   Supervisor part of the modem context (modem_supervisor.c)
+ */
+typedef struct modem_supervisor_ctx_s
+{
+    lr1mac_states_t LpState;
+    stask_manager   task_manager;
+    bool            is_pending_dm_status_payload_periodic;
+    bool            is_pending_dm_status_payload_now;
+    bool            is_first_dm_after_join;
+    bool            send_task_update_needed;
+    void ( *app_callback )( void );
+
+#if defined( ADD_SMTC_ALC_SYNC )
+    alc_sync_ctx_t*   alc_sync_context;
+    clock_sync_ctx_t* clock_sync_context;
+#endif  // ADD_SMTC_ALC_SYNC
+
+#if defined( ADD_SMTC_STREAM )
+    rose_t* ROSE;
+#endif  // ADD_SMTC_STREAM
+
+#if defined( ADD_SMTC_FILE_UPLOAD )
+    file_upload_t* file_upload_context;
+#endif  // ADD_SMTC_FILE_UPLOAD
+
+    // Used for LoRaWAN Certification, the payload itself is in smtc_modem_ctx_buffers_t
+    uint8_t user_payload_length;
+    uint8_t user_port;
+    bool    certification_data_is_pending;
+
+    // Used for class B
+    bool class_b_bit;
+} modem_supervisor_ctx_t;
+
+/*!
+ * \typedef modem_context_ctx_t
+ * \brief   Device management part of the modem context (modem_context.c)
+ */
+typedef struct modem_context_ctx_s
+{
+    int16_t  modem_appkey_status;
+    uint32_t modem_appkey_crc;
+    uint8_t  modem_status;
+    uint8_t  modem_dm_interval;
+    uint8_t  modem_dm_port;
+#if defined( ADD_SMTC_PATCH_UPDATE )
+    uint8_t modem_frag_port;
+#endif  // ADD_SMTC_PATCH_UPDATE
+    uint8_t                modem_appstatus[8];
+    smtc_modem_class_t     modem_dm_class;
+    modem_suspend_status_t is_modem_suspend;
+    uint32_t               modem_start_time;
+#if defined( ADD_SMTC_FILE_UPLOAD )
+    uint8_t              modem_dm_upload_sctr;
+    modem_upload_state_t modem_upload_state;
+#endif  // ADD_SMTC_FILE_UPLOAD
+#if defined( ADD_SMTC_STREAM )
+    modem_stream_t modem_stream_state;
+#endif                                                  // ADD_SMTC_STREAM
+    uint32_t                     dm_info_bitfield_periodic;  // context for periodic GetInfo
+    uint32_t                     dm_info_bitfield_now;       // User GetInfo
+    uint8_t                      tag_number;
+    uint8_t                      tag_number_now;
+    uint8_t                      number_of_muted_day;
+    dm_dl_opportunities_config_t dm_pending_dl;
+    uint32_t                     user_alarm;
+    uint8_t                      asynchronous_msgnumber;
+    uint8_t                      modem_event_count[MODEM_NUMBER_OF_EVENTS];
+    uint8_t                      modem_event_status[MODEM_NUMBER_OF_EVENTS];
+    uint8_t                      asynch_msg[MODEM_NUMBER_OF_EVENTS];
+    bool                         is_modem_reset_requested;
+    bool                         is_modem_charge_loaded;
+    uint32_t                     modem_charge_offset;
+    bool                         start_time_was_set;
+    uint16_t                     user_define_charge_counter;
+    charge_counter_value_t       charge_counter_to_send;
+    rf_output_t                  modem_rf_output;
+    uint8_t                      duty_cycle_disabled_by_host;
+    uint32_t                     crc_fw;
+    smtc_modem_adr_profile_t     modem_adr_profile;
+#if defined( ADD_SMTC_FILE_UPLOAD )
+    uint32_t modem_upload_avgdelay;
+#endif  // ADD_SMTC_FILE_UPLOAD
+    uint16_t             nb_adr_mobile_timeout;
+    bool                 is_modem_in_test_mode;
+    int8_t               rx_pathloss_db;
+    int8_t               tx_power_offset_db;
+    radio_planner_t*     modem_rp;
+    modem_power_config_t power_config_lut[POWER_CONFIG_LUT_SIZE];
+#if defined( SMTC_D2D )
+    modem_context_class_b_d2d_t class_b_d2d_ctx;
+#endif  // SMTC_D2D
+    void ( *modem_lbm_notification_extended_1_callback )( void );
+    void ( *modem_lbm_notification_extended_2_callback )( void );
+    const void* modem_radio_ctx;  // use to save lr11xx user radio context needed to perform direct access to radio
+                                  // withing modem code (almanac update, crypto)
+} modem_context_ctx_t;
+
+/*!
+ * \typedef smtc_modem_ctx_buffers_t
+ * \brief   Large data buffers of the modem context, kept apart from the state accessed on every engine run
+ */
+typedef struct smtc_modem_ctx_buffers_s
+{
+    modem_downlink_msg_t modem_dwn_pkt;                                //!< Last downlink, modem_context.c
+    uint8_t              modem_buffer[SMTC_MODEM_BUFFER_SIZE];         //!< Uplink payload, smtc_modem.c
+    uint8_t              user_payload[SMTC_MODEM_CERTIF_PAYLOAD_SIZE];  //!< Certification payload, modem_supervisor.c
+    uint8_t              fifo_buffer[FIFO_LORAWAN_SIZE];               //!< Downlink fifo storage, lorawan_api.c
+} smtc_modem_ctx_buffers_t;
+
+/*!
+ * \typedef smtc_modem_ctx_t
+ * \brief   Whole state of one soft modem instance
+ *
+ * \remark  Each function takes a pointer to the part of its module from smtc_modem_current_ctx. Parts are ordered by
+ *          access frequency: the radio planner, supervisor and LoRaWAN stack come first, the large buffers and the test
+ *          mode last.
+ */
+struct smtc_modem_ctx_s
+{
+    smtc_modem_api_ctx_t      api;
+    modem_supervisor_ctx_t    supervisor;
+    lorawan_api_ctx_t         lorawan;
+    modem_context_ctx_t       context;
+#if !defined( LR1110_MODEM_E )
+    smtc_secure_element_ctx_t secure_element;
+#endif  // !LR1110_MODEM_E
+    smtc_modem_ctx_buffers_t  buffers;
+    modem_test_context_t      test;
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC VARIABLES --------------------------------------------------------
+ */
+
+/*!
+ * \brief   Context of the modem targeted by the modem calls
+ *
+ * \remark  Set by smtc_modem_set_ctx() for the application calls, and by the radio planner of each modem to its own
+ *          context for the duration of its radio and timer interrupts.
+ */
+extern smtc_modem_ctx_t* smtc_modem_current_ctx;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_MODEM_CTX__H
@@ -51,6 +51,7 @@
 #include "lr1mac_core.h"
 #include "smtc_real.h"
 #include "smtc_modem_hal.h"
+#include "smtc_modem_ctx.h"
 
 #include "ralf.h"
 #include "radio_planner.h"
@@ -61,6 +62,8 @@
 #include "sx126x_hal.h"
 #elif defined( LR11XX )
 #include "lr11xx_hal.h"
+#elif defined( RADIO_SIM )
+#include "ral_sim.h"
 #else
 #error "Please select radio board.."
 #endif
@@ -133,33 +136,11 @@ static const uint32_t modem_test_bw_helper[SMTC_MODEM_TEST_BW_COUNT] = {
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
-/*!
- * \typedef modem_test_context_t
- * \brief   Test context
- */
-typedef struct modem_test_context
-{
-    radio_planner_t* rp;                  //!< Radio planner instance
-    lr1_stack_mac_t* lr1_mac_obj;         //!< Lorawan lr1mac instance
-    uint8_t          hook_id;             //!< Lorawan lr1mac hook id used for test
-    uint8_t          tx_rx_payload[255];  //!< Transmit/Received buffer
-    int16_t          rssi;                //!< Placeholder for mean rssi
-    bool             rssi_ready;          //!< True when rssi mean test is finished
-    uint32_t         total_rx_packets;    //!< Number of received packet
-    bool             random_payload;      //!< True in case of random payload
-} modem_test_context_t;
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-#if defined( LR1110_MODEM_E )
-modem_test_context_t modem_test_context;
-#else
-static modem_test_context_t modem_test_context;
-#endif
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -197,6 +178,8 @@ void test_mode_cw_callback_for_rp( void* rp_void );
 
 smtc_modem_return_code_t smtc_modem_test_start( void )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == true )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TST MODE: ALREADY STARTED\n" );
@@ -211,20 +194,22 @@ smtc_modem_return_code_t smtc_modem_test_start( void )
 
     modem_set_test_mode_status( true );
     SMTC_MODEM_HAL_TRACE_INFO( "TST MODE: START\n" );
-    memset( &modem_test_context, 0, sizeof( modem_test_context_t ) );
+    memset( modem_test_context, 0, sizeof( modem_test_context_t ) );
 
-    modem_test_context.rp          = modem_context_get_modem_rp( );
-    modem_test_context.lr1_mac_obj = lorawan_api_stack_mac_get( );
-    modem_test_context.hook_id     = lorawan_api_rp_hook_id_get( );
+    modem_test_context->rp          = modem_context_get_modem_rp( );
+    modem_test_context->lr1_mac_obj = lorawan_api_stack_mac_get( );
+    modem_test_context->hook_id     = lorawan_api_rp_hook_id_get( );
 
-    rp_release_hook( modem_test_context.rp, modem_test_context.hook_id );
-    lorawan_api_init( modem_test_context.rp );
+    rp_release_hook( modem_test_context->rp, modem_test_context->hook_id );
+    lorawan_api_init( modem_test_context->rp );
 
     return SMTC_MODEM_RC_OK;
 }
 
 smtc_modem_return_code_t smtc_modem_test_stop( void )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
@@ -235,8 +220,8 @@ smtc_modem_return_code_t smtc_modem_test_stop( void )
     {
         return SMTC_MODEM_RC_FAIL;
     }
-    rp_release_hook( modem_test_context.rp, modem_test_context.hook_id );
-    lorawan_api_init( modem_test_context.rp );
+    rp_release_hook( modem_test_context->rp, modem_test_context->hook_id );
+    lorawan_api_init( modem_test_context->rp );
     modem_set_test_mode_status( false );
 
     return SMTC_MODEM_RC_OK;
@@ -254,12 +239,14 @@ smtc_modem_return_code_t smtc_modem_test_tx_hop( void )
 
 smtc_modem_return_code_t smtc_modem_test_nop( void )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    rp_task_abort( modem_test_context.rp, modem_test_context.hook_id );
+    rp_task_abort( modem_test_context->rp, modem_test_context->hook_id );
     smtc_modem_test_radio_reset( );
     return SMTC_MODEM_RC_OK;
 }
@@ -268,12 +255,14 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
                                              int8_t tx_power_dbm, smtc_modem_test_sf_t sf, smtc_modem_test_bw_t bw,
                                              smtc_modem_test_cr_t cr, uint32_t preamble_size, bool continuous_tx )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    if( smtc_real_is_frequency_valid( modem_test_context.lr1_mac_obj, frequency_hz ) != OKLORAWAN )
+    if( smtc_real_is_frequency_valid( modem_test_context->lr1_mac_obj, frequency_hz ) != OKLORAWAN )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Invalid Frequency %d\n", frequency_hz );
         return SMTC_MODEM_RC_INVALID;
@@ -297,7 +286,7 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
     rp_task_t         rp_task         = { 0 };
     rp_radio_params_t rp_radio_params = { 0 };
 
-    rp_task.hook_id = modem_test_context.hook_id;
+    rp_task.hook_id = modem_test_context->hook_id;
     rp_task.state   = RP_TASK_STATE_ASAP;
 
     if( sf == SMTC_MODEM_TEST_FSK )  // FSK
@@ -307,7 +296,7 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
 
         gfsk_param.rf_freq_in_hz                    = frequency_hz;
         gfsk_param.output_pwr_in_dbm                = tx_power_dbm;
-        gfsk_param.sync_word                        = smtc_real_get_gfsk_sync_word( modem_test_context.lr1_mac_obj );
+        gfsk_param.sync_word                        = smtc_real_get_gfsk_sync_word( modem_test_context->lr1_mac_obj );
         gfsk_param.dc_free_is_on                    = true;
         gfsk_param.whitening_seed                   = GFSK_WHITENING_SEED;
         gfsk_param.crc_seed                         = GFSK_CRC_SEED;
@@ -331,7 +320,7 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
 
         rp_task.type                  = RP_TASK_TYPE_TX_FSK;
         rp_task.launch_task_callbacks = lr1_stack_mac_tx_gfsk_launch_callback_for_rp;
-        rp_task.duration_time_ms      = ral_get_gfsk_time_on_air_in_ms( &( modem_test_context.rp->radio->ral ),
+        rp_task.duration_time_ms      = ral_get_gfsk_time_on_air_in_ms( &( modem_test_context->rp->radio->ral ),
                                                                    &( rp_radio_params.tx.gfsk.pkt_params ),
                                                                    &( rp_radio_params.tx.gfsk.mod_params ) );
     }
@@ -342,7 +331,7 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
 
         lora_param.rf_freq_in_hz     = frequency_hz;
         lora_param.output_pwr_in_dbm = tx_power_dbm;
-        lora_param.sync_word         = smtc_real_get_sync_word( modem_test_context.lr1_mac_obj );
+        lora_param.sync_word         = smtc_real_get_sync_word( modem_test_context->lr1_mac_obj );
 
         lora_param.pkt_params.preamble_len_in_symb = preamble_size;
         lora_param.pkt_params.header_type          = RAL_LORA_PKT_EXPLICIT;
@@ -364,7 +353,7 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
 
         rp_task.type                  = RP_TASK_TYPE_TX_LORA;
         rp_task.launch_task_callbacks = lr1_stack_mac_tx_lora_launch_callback_for_rp;
-        rp_task.duration_time_ms      = ral_get_lora_time_on_air_in_ms( &( modem_test_context.rp->radio->ral ),
+        rp_task.duration_time_ms      = ral_get_lora_time_on_air_in_ms( &( modem_test_context->rp->radio->ral ),
                                                                    &( rp_radio_params.tx.lora.pkt_params ),
                                                                    &( rp_radio_params.tx.lora.mod_params ) );
     }
@@ -376,37 +365,37 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
 
     if( continuous_tx == false )  // single tx
     {
-        rp_release_hook( modem_test_context.rp, modem_test_context.hook_id );
-        rp_hook_init( modem_test_context.rp, modem_test_context.hook_id,
-                      ( void ( * )( void* ) )( modem_test_empty_callback ), &modem_test_context );
+        rp_release_hook( modem_test_context->rp, modem_test_context->hook_id );
+        rp_hook_init( modem_test_context->rp, modem_test_context->hook_id,
+                      ( void ( * )( void* ) )( modem_test_empty_callback ), modem_test_context );
     }
     else
     {
-        rp_release_hook( modem_test_context.rp, modem_test_context.hook_id );
-        rp_hook_init( modem_test_context.rp, modem_test_context.hook_id,
-                      ( void ( * )( void* ) )( modem_test_tx_callback ), &modem_test_context );
+        rp_release_hook( modem_test_context->rp, modem_test_context->hook_id );
+        rp_hook_init( modem_test_context->rp, modem_test_context->hook_id,
+                      ( void ( * )( void* ) )( modem_test_tx_callback ), modem_test_context );
     }
 
     if( payload == NULL )
     {
         // user payload is NULL=> generate a random before at next step
-        modem_test_context.random_payload = true;
+        modem_test_context->random_payload = true;
         for( uint8_t i = 0; i < payload_length; i++ )
         {
-            modem_test_context.tx_rx_payload[i] = ( smtc_modem_hal_get_random_nb( ) % 256 );
+            modem_test_context->tx_rx_payload[i] = ( smtc_modem_hal_get_random_nb( ) % 256 );
         }
     }
     else
     {
-        modem_test_context.random_payload = false;
+        modem_test_context->random_payload = false;
         // save tx payload in context
-        memcpy( modem_test_context.tx_rx_payload, payload, payload_length );
+        memcpy( modem_test_context->tx_rx_payload, payload, payload_length );
     }
 
     rp_task.start_time_ms = smtc_modem_hal_get_time_in_ms( ) + 20;
 
     // Enqueue task in radio planner
-    rp_task_enqueue( modem_test_context.rp, &rp_task, modem_test_context.tx_rx_payload, payload_length,
+    rp_task_enqueue( modem_test_context->rp, &rp_task, modem_test_context->tx_rx_payload, payload_length,
                      &rp_radio_params );
 
     return SMTC_MODEM_RC_OK;
@@ -414,12 +403,14 @@ smtc_modem_return_code_t smtc_modem_test_tx( uint8_t* payload, uint8_t payload_l
 
 smtc_modem_return_code_t smtc_modem_test_tx_cw( uint32_t frequency_hz, int8_t tx_power_dbm )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    if( smtc_real_is_frequency_valid( modem_test_context.lr1_mac_obj, frequency_hz ) != OKLORAWAN )
+    if( smtc_real_is_frequency_valid( modem_test_context->lr1_mac_obj, frequency_hz ) != OKLORAWAN )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Invalid Frequency %d\n", frequency_hz );
         return SMTC_MODEM_RC_INVALID;
@@ -437,23 +428,25 @@ smtc_modem_return_code_t smtc_modem_test_tx_cw( uint32_t frequency_hz, int8_t tx
     lora_param.mod_params.bw = RAL_LORA_BW_125_KHZ;
 #elif defined( LR11XX )
     lora_param.mod_params.bw = RAL_LORA_BW_125_KHZ;
+#elif defined( RADIO_SIM )
+    lora_param.mod_params.bw = RAL_LORA_BW_125_KHZ;
 #endif
-    lora_param.mod_params.cr = smtc_real_get_coding_rate( modem_test_context.lr1_mac_obj );
-    lora_param.sync_word     = smtc_real_get_sync_word( modem_test_context.lr1_mac_obj );
+    lora_param.mod_params.cr = smtc_real_get_coding_rate( modem_test_context->lr1_mac_obj );
+    lora_param.sync_word     = smtc_real_get_sync_word( modem_test_context->lr1_mac_obj );
 
     rp_radio_params_t radio_params = { 0 };
     radio_params.pkt_type          = RAL_PKT_TYPE_LORA;
     radio_params.tx.lora           = lora_param;
 
     rp_task_t rp_task             = { 0 };
-    rp_task.hook_id               = modem_test_context.hook_id;
+    rp_task.hook_id               = modem_test_context->hook_id;
     rp_task.state                 = RP_TASK_STATE_ASAP;
     rp_task.start_time_ms         = smtc_modem_hal_get_time_in_ms( ) + 2;
     rp_task.duration_time_ms      = 2000;  // toa;
     rp_task.type                  = RP_TASK_TYPE_RX_LORA;
     rp_task.launch_task_callbacks = test_mode_cw_callback_for_rp;
 
-    if( rp_task_enqueue( modem_test_context.rp, &rp_task, NULL, 0, &radio_params ) != RP_HOOK_STATUS_OK )
+    if( rp_task_enqueue( modem_test_context->rp, &rp_task, NULL, 0, &radio_params ) != RP_HOOK_STATUS_OK )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( "Radio planner hook %d is busy \n", rp_task.hook_id );
     }
@@ -465,12 +458,14 @@ smtc_modem_return_code_t smtc_modem_test_tx_cw( uint32_t frequency_hz, int8_t tx
 smtc_modem_return_code_t smtc_modem_test_rx_continuous( uint32_t frequency_hz, smtc_modem_test_sf_t sf,
                                                         smtc_modem_test_bw_t bw, smtc_modem_test_cr_t cr )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    if( smtc_real_is_frequency_valid( modem_test_context.lr1_mac_obj, frequency_hz ) != OKLORAWAN )
+    if( smtc_real_is_frequency_valid( modem_test_context->lr1_mac_obj, frequency_hz ) != OKLORAWAN )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Invalid Frequency %u\n", frequency_hz );
         return SMTC_MODEM_RC_INVALID;
@@ -492,13 +487,13 @@ smtc_modem_return_code_t smtc_modem_test_rx_continuous( uint32_t frequency_hz, s
     }
 
     // reset number of received packets
-    modem_test_context.total_rx_packets = 0;
+    modem_test_context->total_rx_packets = 0;
 
     rp_radio_params_t rp_radio_params = { 0 };
     rp_radio_params.rx.timeout_in_ms  = RAL_RX_TIMEOUT_CONTINUOUS_MODE;
 
     rp_task_t rp_task = { 0 };
-    rp_task.hook_id   = modem_test_context.hook_id;
+    rp_task.hook_id   = modem_test_context->hook_id;
     rp_task.state     = RP_TASK_STATE_ASAP;
 
     if( sf == 0 )  // FSK
@@ -508,7 +503,7 @@ smtc_modem_return_code_t smtc_modem_test_rx_continuous( uint32_t frequency_hz, s
         memset( &gfsk_param, 0, sizeof( ralf_params_gfsk_t ) );
 
         gfsk_param.rf_freq_in_hz                    = frequency_hz;
-        gfsk_param.sync_word                        = smtc_real_get_gfsk_sync_word( modem_test_context.lr1_mac_obj );
+        gfsk_param.sync_word                        = smtc_real_get_gfsk_sync_word( modem_test_context->lr1_mac_obj );
         gfsk_param.dc_free_is_on                    = true;
         gfsk_param.whitening_seed                   = GFSK_WHITENING_SEED;
         gfsk_param.crc_seed                         = GFSK_CRC_SEED;
@@ -540,11 +535,11 @@ smtc_modem_return_code_t smtc_modem_test_rx_continuous( uint32_t frequency_hz, s
         memset( &lora_param, 0, sizeof( ralf_params_lora_t ) );
 
         lora_param.rf_freq_in_hz   = frequency_hz;
-        lora_param.sync_word       = smtc_real_get_sync_word( modem_test_context.lr1_mac_obj );
+        lora_param.sync_word       = smtc_real_get_sync_word( modem_test_context->lr1_mac_obj );
         lora_param.symb_nb_timeout = 0;
 
         lora_param.pkt_params.preamble_len_in_symb =
-            smtc_real_get_preamble_len( modem_test_context.lr1_mac_obj, modem_test_sf_convert[sf] );
+            smtc_real_get_preamble_len( modem_test_context->lr1_mac_obj, modem_test_sf_convert[sf] );
         lora_param.pkt_params.header_type      = RAL_LORA_PKT_EXPLICIT;
         lora_param.pkt_params.pld_len_in_bytes = 255;
         lora_param.pkt_params.crc_is_on        = false;
@@ -571,37 +566,41 @@ smtc_modem_return_code_t smtc_modem_test_rx_continuous( uint32_t frequency_hz, s
         return SMTC_MODEM_RC_FAIL;
     }
 
-    rp_release_hook( modem_test_context.rp, modem_test_context.hook_id );
-    rp_hook_init( modem_test_context.rp, modem_test_context.hook_id, ( void ( * )( void* ) )( modem_test_rx_callback ),
-                  &modem_test_context );
+    rp_release_hook( modem_test_context->rp, modem_test_context->hook_id );
+    rp_hook_init( modem_test_context->rp, modem_test_context->hook_id,
+                  ( void ( * )( void* ) )( modem_test_rx_callback ), modem_test_context );
 
     rp_task.start_time_ms    = smtc_modem_hal_get_time_in_ms( ) + 20;
     rp_task.duration_time_ms = 2000;  // toa;
 
-    rp_task_enqueue( modem_test_context.rp, &rp_task, modem_test_context.tx_rx_payload, 255, &rp_radio_params );
+    rp_task_enqueue( modem_test_context->rp, &rp_task, modem_test_context->tx_rx_payload, 255, &rp_radio_params );
 
     return SMTC_MODEM_RC_OK;
 }
 
 smtc_modem_return_code_t smtc_modem_test_get_nb_rx_packets( uint32_t* nb_rx_packets )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    *nb_rx_packets = modem_test_context.total_rx_packets;
+    *nb_rx_packets = modem_test_context->total_rx_packets;
     return SMTC_MODEM_RC_OK;
 }
 
 smtc_modem_return_code_t smtc_modem_test_rssi( uint32_t frequency_hz, smtc_modem_test_bw_t bw, uint16_t time_ms )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    if( smtc_real_is_frequency_valid( modem_test_context.lr1_mac_obj, frequency_hz ) != OKLORAWAN )
+    if( smtc_real_is_frequency_valid( modem_test_context->lr1_mac_obj, frequency_hz ) != OKLORAWAN )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( " Invalid Frequency %d\n", frequency_hz );
         return SMTC_MODEM_RC_INVALID;
@@ -622,22 +621,24 @@ smtc_modem_return_code_t smtc_modem_test_rssi( uint32_t frequency_hz, smtc_modem
         bw_tmp = modem_test_bw_helper[bw];
     }
 
-    modem_test_context.rssi_ready = false;
+    modem_test_context->rssi_ready = false;
 
-    smtc_lbt_init( modem_test_context.lr1_mac_obj->lbt_obj, modem_test_context.lr1_mac_obj->rp, RP_HOOK_ID_LBT,
-                   ( void ( * )( void* ) ) modem_test_compute_rssi_callback, &modem_test_context,
-                   ( void ( * )( void* ) ) modem_test_compute_rssi_callback, &modem_test_context,
-                   ( void ( * )( void* ) ) modem_test_compute_rssi_callback, &modem_test_context );
-    smtc_lbt_set_parameters( modem_test_context.lr1_mac_obj->lbt_obj, time_ms, 50, bw_tmp );
-    smtc_lbt_set_state( modem_test_context.lr1_mac_obj->lbt_obj, true );
-    smtc_lbt_listen_channel( modem_test_context.lr1_mac_obj->lbt_obj, frequency_hz, 0, smtc_modem_hal_get_time_in_ms( ),
-                             0 );
+    smtc_lbt_init( modem_test_context->lr1_mac_obj->lbt_obj, modem_test_context->lr1_mac_obj->rp, RP_HOOK_ID_LBT,
+                   ( void ( * )( void* ) ) modem_test_compute_rssi_callback, modem_test_context,
+                   ( void ( * )( void* ) ) modem_test_compute_rssi_callback, modem_test_context,
+                   ( void ( * )( void* ) ) modem_test_compute_rssi_callback, modem_test_context );
+    smtc_lbt_set_parameters( modem_test_context->lr1_mac_obj->lbt_obj, time_ms, 50, bw_tmp );
+    smtc_lbt_set_state( modem_test_context->lr1_mac_obj->lbt_obj, true );
+    smtc_lbt_listen_channel( modem_test_context->lr1_mac_obj->lbt_obj, frequency_hz, 0,
+                             smtc_modem_hal_get_time_in_ms( ), 0 );
 
     return SMTC_MODEM_RC_OK;
 }
 
 smtc_modem_return_code_t smtc_modem_test_get_rssi( int8_t* rssi )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
@@ -646,14 +647,14 @@ smtc_modem_return_code_t smtc_modem_test_get_rssi( int8_t* rssi )
 
     smtc_modem_return_code_t return_code;
 
-    if( modem_test_context.rssi_ready == false )
+    if( modem_test_context->rssi_ready == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "RSSI TEST RESULT NOT READY\n" )
         return_code = SMTC_MODEM_RC_BUSY;
     }
     else
     {
-        *rssi       = ( ( int8_t )( modem_test_context.rssi + 64 ) );
+        *rssi       = ( ( int8_t )( modem_test_context->rssi + 64 ) );
         return_code = SMTC_MODEM_RC_OK;
     }
     return return_code;
@@ -661,25 +662,29 @@ smtc_modem_return_code_t smtc_modem_test_get_rssi( int8_t* rssi )
 
 void modem_test_set_rssi( int16_t rssi )
 {
-    modem_test_context.rssi = rssi;
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+    modem_test_context->rssi = rssi;
 }
 
 smtc_modem_return_code_t smtc_modem_test_radio_reset( void )
 {
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    if( ral_reset( &( modem_test_context.rp->radio->ral ) ) != RAL_STATUS_OK )
+    ralf_invalidate_shadow( modem_test_context->rp->radio );
+    if( ral_reset( &( modem_test_context->rp->radio->ral ) ) != RAL_STATUS_OK )
     {
         return SMTC_MODEM_RC_FAIL;
     }
-    if( ral_init( &( modem_test_context.rp->radio->ral ) ) != RAL_STATUS_OK )
+    if( ral_init( &( modem_test_context->rp->radio->ral ) ) != RAL_STATUS_OK )
     {
         return SMTC_MODEM_RC_FAIL;
     }
-    if( ral_set_sleep( &( modem_test_context.rp->radio->ral ), true ) != RAL_STATUS_OK )
+    if( ral_set_sleep( &( modem_test_context->rp->radio->ral ), true ) != RAL_STATUS_OK )
     {
         return SMTC_MODEM_RC_FAIL;
     }
@@ -711,21 +716,25 @@ smtc_modem_return_code_t smtc_modem_test_duty_cycle_app_activate( bool status )
 smtc_modem_return_code_t smtc_modem_test_direct_radio_write( uint8_t* command, uint16_t command_length, uint8_t* data,
                                                              uint16_t data_length )
 {
+#if defined( SX128X ) || defined( SX126X ) || defined( LR11XX_TRANSCEIVER )
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+#endif
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
 #if defined( SX128X )
-    if( sx128x_hal_read( modem_test_context.rp->radio->ral.context, command, command_length, data, data_length ) !=
+    if( sx128x_hal_read( modem_test_context->rp->radio->ral.context, command, command_length, data, data_length ) !=
         SX128X_HAL_STATUS_OK )
 #elif defined( SX126X )
-    if( sx126x_hal_write( modem_test_context.rp->radio->ral.context, command, command_length, data, data_length ) !=
+    if( sx126x_hal_write( modem_test_context->rp->radio->ral.context, command, command_length, data, data_length ) !=
         SX126X_HAL_STATUS_OK )
 #elif defined( LR11XX_TRANSCEIVER )
-    if( lr11xx_hal_write( modem_test_context.rp->radio->ral.context, command, command_length, data, data_length ) !=
+    if( lr11xx_hal_write( modem_test_context->rp->radio->ral.context, command, command_length, data, data_length ) !=
         LR11XX_HAL_STATUS_OK )
-#elif defined( LR1110_MODEM_E )
+#elif defined( LR1110_MODEM_E ) || defined( RADIO_SIM )
     return SMTC_MODEM_RC_FAIL;
 #else
 #error "Please select radio board.."
@@ -739,21 +748,25 @@ smtc_modem_return_code_t smtc_modem_test_direct_radio_write( uint8_t* command, u
 smtc_modem_return_code_t smtc_modem_test_direct_radio_read( uint8_t* command, uint16_t command_length, uint8_t* data,
                                                             uint16_t data_length )
 {
+#if defined( SX128X ) || defined( SX126X ) || defined( LR11XX_TRANSCEIVER )
+    modem_test_context_t* modem_test_context = &smtc_modem_current_ctx->test;
+#endif
+
     if( modem_get_test_mode_status( ) == false )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "TEST FUNCTION CANNOT BE CALLED: NOT IN TEST MODE\n" );
         return SMTC_MODEM_RC_INVALID;
     }
 #if defined( SX128X )
-    if( sx128x_hal_read( modem_test_context.rp->radio->ral.context, command, command_length, data, data_length ) !=
+    if( sx128x_hal_read( modem_test_context->rp->radio->ral.context, command, command_length, data, data_length ) !=
         SX128X_HAL_STATUS_OK )
 #elif defined( SX126X )
-    if( sx126x_hal_read( modem_test_context.rp->radio->ral.context, command, command_length, data, data_length ) !=
+    if( sx126x_hal_read( modem_test_context->rp->radio->ral.context, command, command_length, data, data_length ) !=
         SX126X_HAL_STATUS_OK )
 #elif defined( LR11XX_TRANSCEIVER )
-    if( lr11xx_hal_read( modem_test_context.rp->radio->ral.context, command, command_length, data, data_length ) !=
+    if( lr11xx_hal_read( modem_test_context->rp->radio->ral.context, command, command_length, data, data_length ) !=
         LR11XX_HAL_STATUS_OK )
-#elif defined( LR1110_MODEM_E )
+#elif defined( LR1110_MODEM_E ) || defined( RADIO_SIM )
     return SMTC_MODEM_RC_FAIL;
 #else
 #error "Please select radio board.."
@@ -777,7 +790,7 @@ void modem_test_empty_callback( modem_test_context_t* context )
 void modem_test_compute_rssi_callback( modem_test_context_t* context )
 {
     float rssi_mean = ( ( float ) context->lr1_mac_obj->lbt_obj->rssi_accu ) /
-                      modem_test_context.lr1_mac_obj->lbt_obj->rssi_nb_of_meas;
+                      context->lr1_mac_obj->lbt_obj->rssi_nb_of_meas;
     context->rssi             = ( int16_t )( rssi_mean );
     context->total_rx_packets = context->lr1_mac_obj->lbt_obj->rssi_nb_of_meas;
     context->rssi_ready       = true;
@@ -789,7 +802,7 @@ void modem_test_compute_rssi_callback( modem_test_context_t* context )
 void modem_test_tx_callback( modem_test_context_t* context )
 {
     smtc_modem_hal_reload_wdog( );
-    rp_status_t rp_status = context->rp->status[context->hook_id];
+    rp_status_t rp_status = context->rp->hook_table[context->hook_id]->status;
     if( rp_status == RP_STATUS_TASK_ABORTED )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( " modem_test_tx_callback ABORTED\n" );
@@ -801,7 +814,7 @@ void modem_test_tx_callback( modem_test_context_t* context )
     rp_task.state         = RP_TASK_STATE_ASAP;
     rp_task.start_time_ms = smtc_modem_hal_get_time_in_ms( ) + 20;
 
-    rp_radio_params_t radio_params = context->rp->radio_params[context->hook_id];
+    rp_radio_params_t radio_params = context->rp->hook_table[context->hook_id]->radio_params;
 
     if( radio_params.pkt_type == RAL_PKT_TYPE_LORA )
     {
@@ -845,18 +858,19 @@ void modem_test_tx_callback( modem_test_context_t* context )
 void modem_test_rx_callback( modem_test_context_t* context )
 {
     smtc_modem_hal_reload_wdog( );
-    rp_status_t rp_status = context->rp->status[context->hook_id];
+    rp_status_t rp_status = context->rp->hook_table[context->hook_id]->status;
 
     if( rp_status == RP_STATUS_RX_PACKET )
     {
         context->total_rx_packets++;
 #if( MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON )
-        int16_t  snr              = context->rp->radio_params[context->hook_id].rx.lora_pkt_status.snr_pkt_in_db;
-        int16_t  rssi             = context->rp->radio_params[context->hook_id].rx.lora_pkt_status.rssi_pkt_in_dbm;
-        uint32_t irq_timestamp_ms = context->rp->irq_timestamp_ms[context->hook_id];
+        const rp_hook_t* hook_data        = context->rp->hook_table[context->hook_id];
+        int16_t          snr              = hook_data->radio_params.rx.lora_pkt_status.snr_pkt_in_db;
+        int16_t          rssi             = hook_data->radio_params.rx.lora_pkt_status.rssi_pkt_in_dbm;
+        uint32_t         irq_timestamp_ms = hook_data->irq_timestamp_ms;
         SMTC_MODEM_HAL_TRACE_PRINTF( "t: %d, rp_status %u, snr: %d, rssi: %d\n", irq_timestamp_ms, rp_status, snr,
                                      rssi );
-        SMTC_MODEM_HAL_TRACE_ARRAY( "rx_payload", context->tx_rx_payload, context->rp->payload_size[context->hook_id] );
+        SMTC_MODEM_HAL_TRACE_ARRAY( "rx_payload", context->tx_rx_payload, hook_data->payload_size );
 #endif
     }
     else if( rp_status == RP_STATUS_TASK_ABORTED )
@@ -872,7 +886,7 @@ void modem_test_rx_callback( modem_test_context_t* context )
     rp_task.start_time_ms    = smtc_modem_hal_get_time_in_ms( ) + 20;
     rp_task.duration_time_ms = 2000;  // toa;
 
-    rp_radio_params_t radio_params = context->rp->radio_params[context->hook_id];
+    rp_radio_params_t radio_params = context->rp->hook_table[context->hook_id]->radio_params;
 
     if( radio_params.pkt_type == RAL_PKT_TYPE_LORA )
     {
@@ -895,7 +909,8 @@ void test_mode_cw_callback_for_rp( void* rp_void )
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
     uint8_t          id = rp->radio_task_id;
     smtc_modem_hal_assert( ral_init( &( rp->radio->ral ) ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->radio_params[id].tx.lora ) == RAL_STATUS_OK );
+    ralf_invalidate_shadow( rp->radio );
+    smtc_modem_hal_assert( ralf_setup_lora( rp->radio, &rp->hook_table[id]->radio_params.tx.lora ) == RAL_STATUS_OK );
     smtc_modem_hal_assert( ral_set_tx_cw( &( rp->radio->ral ) ) == RAL_STATUS_OK );
 }
 
@@ -51,6 +51,12 @@
 
 #define LEN_DATA_SIZE ( 2 )
 #define LEN_METADATA_SIZE ( 1 )
+#define LEN_HEADER_SIZE ( LEN_DATA_SIZE + LEN_METADATA_SIZE )
+
+#define MIN( a, b ) ( ( ( a ) < ( b ) ) ? ( a ) : ( b ) )
+
+// The free running offsets of the spsc mode are 16 bits, the used space must stay below their range
+#define FIFO_SPSC_BUFFER_SIZE_MAX ( 32768 )
 
 /*
  * -----------------------------------------------------------------------------
@@ -72,6 +78,51 @@ static fifo_return_status_t ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer,
 static fifo_return_status_t ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t* data_len,
                                       const uint16_t data_buffer_size, void* metadata, uint8_t* metadata_len,
                                       const uint8_t metadata_buffer_size );
+
+static fifo_return_status_t ctrl_set_spsc( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
+                                           const void* metadata, const uint8_t metadata_len );
+
+static fifo_return_status_t ctrl_get_spsc( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t* data_len,
+                                           const uint16_t data_buffer_size, void* metadata, uint8_t* metadata_len,
+                                           const uint8_t metadata_buffer_size );
+
+/**
+ * @brief Move a position of the buffer forward, wrapping at the end of the buffer
+ *
+ * @param ctrl  fifo manager
+ * @param pos   position in the buffer
+ * @param len   number of bytes to skip (lower or equal to buffer size)
+ * @return uint16_t new position in the buffer
+ */
+static uint16_t ctrl_advance( const fifo_ctrl_t* ctrl, uint16_t pos, const uint16_t len );
+
+/**
+ * @brief Copy bytes to a position of the buffer, wrapping at the end of the buffer
+ */
+static void ctrl_copy_in( fifo_ctrl_t* ctrl, const uint16_t pos, const uint8_t* src, const uint16_t len );
+
+/**
+ * @brief Copy bytes from a position of the buffer, wrapping at the end of the buffer
+ */
+static void ctrl_copy_out( const fifo_ctrl_t* ctrl, const uint16_t pos, uint8_t* dst, const uint16_t len );
+
+/**
+ * @brief Write a complete element (header, metadata and data) from a position of the buffer
+ */
+static void ctrl_write_element( fifo_ctrl_t* ctrl, uint16_t pos, const uint8_t* buffer, const uint16_t buffer_len,
+                                const void* metadata, const uint8_t metadata_len );
+
+/**
+ * @brief Read the element stored at a position of the buffer
+ *      Buffer & metadata are NULL to only get the element length (drop of the oldest element)
+ *
+ * @param [out] elt_len total length of the element in the buffer, header included
+ */
+static fifo_return_status_t ctrl_read_element( const fifo_ctrl_t* ctrl, uint16_t pos, uint8_t* buffer,
+                                               uint16_t* data_len, const uint16_t data_buffer_size, void* metadata,
+                                               uint8_t* metadata_len, const uint8_t metadata_buffer_size,
+                                               uint16_t* elt_len );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -81,6 +132,20 @@ void fifo_ctrl_init( fifo_ctrl_t* ctrl, uint8_t* buffer, const uint16_t buffer_s
 {
     ctrl->buffer      = buffer;
     ctrl->buffer_size = buffer_size;
+    ctrl->spsc        = false;
+    fifo_ctrl_clear( ctrl );
+}
+
+void fifo_ctrl_init_spsc( fifo_ctrl_t* ctrl, uint8_t* buffer, const uint16_t buffer_size )
+{
+    if( ( buffer_size == 0 ) || ( buffer_size > FIFO_SPSC_BUFFER_SIZE_MAX ) ||
+        ( ( buffer_size & ( buffer_size - 1 ) ) != 0 ) )
+    {
+        smtc_modem_hal_mcu_panic( "spsc fifo size %d is not a power of two\n", buffer_size );
+    }
+    ctrl->buffer      = buffer;
+    ctrl->buffer_size = buffer_size;
+    ctrl->spsc        = true;
     fifo_ctrl_clear( ctrl );
 }
 
@@ -100,21 +165,33 @@ void fifo_ctrl_print_stat( const fifo_ctrl_t* ctrl )
     SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "----------------------------------\n" );
     SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "fifo_ctrl_print_stat\n" );
     SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Buffer size : %d\n", ctrl->buffer_size );
-    SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Current elt : %d\n", ctrl->nb_element );
-    SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Free space  : %d\n", ctrl->free_space );
+    SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Current elt : %d\n", fifo_ctrl_get_nb_elt( ctrl ) );
+    SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Free space  : %d\n", fifo_ctrl_get_free_space( ctrl ) );
     SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Write       : %d\n", ctrl->write_cnt );
-    SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Read        : %d\n", ctrl->read_cnt - ctrl->drop_cnt );
+    // In spsc mode the dropped elements are the new ones, they are never read
+    SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Read        : %d\n",
+                                     ctrl->read_cnt - ( ( ctrl->spsc == true ) ? 0 : ctrl->drop_cnt ) );
     SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "Drop        : %d\n", ctrl->drop_cnt );
     SMTC_MODEM_HAL_TRACE_INFO_DEBUG( "----------------------------------\n" );
 }
 
 uint16_t fifo_ctrl_get_nb_elt( const fifo_ctrl_t* ctrl )
 {
+    if( ctrl->spsc == true )
+    {
+        return ( uint16_t )( __atomic_load_n( &ctrl->write_cnt, __ATOMIC_ACQUIRE ) -
+                             __atomic_load_n( &ctrl->read_cnt, __ATOMIC_ACQUIRE ) );
+    }
     return ctrl->nb_element;
 }
 
 uint16_t fifo_ctrl_get_free_space( const fifo_ctrl_t* ctrl )
 {
+    if( ctrl->spsc == true )
+    {
+        return ctrl->buffer_size - ( uint16_t )( __atomic_load_n( &ctrl->write_offset, __ATOMIC_ACQUIRE ) -
+                                                 __atomic_load_n( &ctrl->read_offset, __ATOMIC_ACQUIRE ) );
+    }
     return ctrl->free_space;
 }
 
@@ -122,6 +199,12 @@ fifo_return_status_t fifo_ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t
                                     const uint16_t data_buffer_size, void* metadata, uint8_t* metadata_len,
                                     const uint8_t metadata_buffer_size )
 {
+    if( ctrl->spsc == true )
+    {
+        return ctrl_get_spsc( ctrl, buffer, data_len, data_buffer_size, metadata, metadata_len,
+                              metadata_buffer_size );
+    }
+
     smtc_modem_hal_disable_modem_irq( );
     fifo_return_status_t ret =
         ctrl_get( ctrl, buffer, data_len, data_buffer_size, metadata, metadata_len, metadata_buffer_size );
@@ -133,77 +216,99 @@ fifo_return_status_t fifo_ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t
 fifo_return_status_t fifo_ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
                                     const void* metadata, const uint8_t metadata_len )
 {
+    fifo_return_status_t ret;
+
     smtc_modem_hal_disable_modem_irq( );
-    fifo_return_status_t ret = ctrl_set( ctrl, buffer, buffer_len, metadata, metadata_len );
+    if( ctrl->spsc == true )
+    {
+        ret = ctrl_set_spsc( ctrl, buffer, buffer_len, metadata, metadata_len );
+    }
+    else
+    {
+        ret = ctrl_set( ctrl, buffer, buffer_len, metadata, metadata_len );
+    }
     smtc_modem_hal_enable_modem_irq( );
     return ret;
 }
 
-static fifo_return_status_t ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
-                                      const void* metadata, const uint8_t metadata_len )
+fifo_return_status_t fifo_ctrl_peek( fifo_ctrl_t* ctrl, fifo_ctrl_peek_t* peek, void* metadata, uint8_t* metadata_len,
+                                     const uint8_t metadata_buffer_size )
 {
-    uint16_t total_write_len = LEN_DATA_SIZE + LEN_METADATA_SIZE + metadata_len + buffer_len;
+    if( ( ctrl->spsc == false ) || ( peek == NULL ) || ( metadata == NULL ) || ( metadata_len == NULL ) )
+    {
+        return FIFO_STATUS_PARAM_ERROR;
+    }
+    if( __atomic_load_n( &ctrl->write_offset, __ATOMIC_ACQUIRE ) == ctrl->read_offset )
+    {
+        return FIFO_STATUS_BUFFER_EMPTY;
+    }
 
-    if( total_write_len > ctrl->buffer_size )
+    uint16_t pos = ctrl->read_offset & ( ctrl->buffer_size - 1 );
+    uint8_t  header[LEN_HEADER_SIZE];
+
+    ctrl_copy_out( ctrl, pos, header, LEN_HEADER_SIZE );
+    uint16_t read_data_len = ( ( ( uint16_t ) header[0] ) << 8 ) + header[1];
+    *metadata_len          = header[2];
+    if( *metadata_len > metadata_buffer_size )
     {
         return FIFO_STATUS_BUFFER_TOO_SMALL;
     }
+    pos = ctrl_advance( ctrl, pos, LEN_HEADER_SIZE );
 
-    while( ctrl->free_space < total_write_len )
+    if( *metadata_len != 0 )
     {
-        // Not enough free space --> Remove oldest
-        ctrl_get( ctrl, NULL, NULL, 0, NULL, NULL, 0 );
-        ctrl->drop_cnt += 1;
+        ctrl_copy_out( ctrl, pos, ( uint8_t* ) metadata, *metadata_len );
+        pos = ctrl_advance( ctrl, pos, *metadata_len );
     }
 
-    // Write data length - 2 bytes MSB first
-    ctrl->buffer[ctrl->write_offset] = ( uint8_t )( buffer_len >> 8 );
-    ctrl->write_offset += 1;
-    ctrl->write_offset %= ctrl->buffer_size;
-    ctrl->buffer[ctrl->write_offset] = ( uint8_t )( buffer_len );
-    ctrl->write_offset += 1;
-    ctrl->write_offset %= ctrl->buffer_size;
+    peek->data[0]     = ctrl->buffer + pos;
+    peek->data_len[0] = MIN( read_data_len, ctrl->buffer_size - pos );
+    peek->data[1]     = ctrl->buffer;
+    peek->data_len[1] = read_data_len - peek->data_len[0];
+    peek->elt_len     = LEN_HEADER_SIZE + *metadata_len + read_data_len;
 
-    // Write metadata length
-    ctrl->buffer[ctrl->write_offset] = metadata_len;
-    ctrl->write_offset += 1;
-    ctrl->write_offset %= ctrl->buffer_size;
+    return FIFO_STATUS_OK;
+}
 
-    // Write metadata
-    if( metadata_len != 0 )
+fifo_return_status_t fifo_ctrl_commit( fifo_ctrl_t* ctrl, fifo_ctrl_peek_t* peek )
+{
+    if( ( ctrl->spsc == false ) || ( peek == NULL ) || ( peek->elt_len == 0 ) )
     {
-        if( ( ctrl->write_offset + metadata_len ) > ctrl->buffer_size )
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, ( uint8_t* ) metadata, ctrl->buffer_size - ctrl->write_offset );
-            memcpy( ctrl->buffer, ( uint8_t* ) metadata + ctrl->buffer_size - ctrl->write_offset,
-                    metadata_len - ( ctrl->buffer_size - ctrl->write_offset ) );
-        }
-        else
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, ( uint8_t* ) metadata, metadata_len );
-        }
-        ctrl->write_offset += metadata_len;
-        ctrl->write_offset %= ctrl->buffer_size;
+        return FIFO_STATUS_PARAM_ERROR;
     }
 
-    // Write data
-    if( buffer_len != 0 )
+    __atomic_store_n( &ctrl->read_cnt, ctrl->read_cnt + 1, __ATOMIC_RELEASE );
+    __atomic_store_n( &ctrl->read_offset, ( uint16_t )( ctrl->read_offset + peek->elt_len ), __ATOMIC_RELEASE );
+    peek->elt_len = 0;
+
+    return FIFO_STATUS_OK;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static fifo_return_status_t ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
+                                      const void* metadata, const uint8_t metadata_len )
+{
+    uint16_t total_write_len = LEN_HEADER_SIZE + metadata_len + buffer_len;
+
+    if( total_write_len > ctrl->buffer_size )
     {
-        if( ( ctrl->write_offset + buffer_len ) > ctrl->buffer_size )
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, buffer, ctrl->buffer_size - ctrl->write_offset );
-            memcpy( ctrl->buffer, buffer + ctrl->buffer_size - ctrl->write_offset,
-                    buffer_len - ( ctrl->buffer_size - ctrl->write_offset ) );
-        }
-        else
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, buffer, buffer_len );
-        }
+        return FIFO_STATUS_BUFFER_TOO_SMALL;
+    }
 
-        ctrl->write_offset += buffer_len;
-        ctrl->write_offset %= ctrl->buffer_size;
+    while( ctrl->free_space < total_write_len )
+    {
+        // Not enough free space --> Remove oldest
+        ctrl_get( ctrl, NULL, NULL, 0, NULL, NULL, 0 );
+        ctrl->drop_cnt += 1;
     }
 
+    ctrl_write_element( ctrl, ctrl->write_offset, buffer, buffer_len, metadata, metadata_len );
+    ctrl->write_offset = ctrl_advance( ctrl, ctrl->write_offset, total_write_len );
+
     ctrl->free_space -= total_write_len;
     ctrl->nb_element += 1;
     ctrl->write_cnt += 1;
@@ -220,10 +325,154 @@ static fifo_return_status_t ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16
         return FIFO_STATUS_BUFFER_EMPTY;
     }
 
-    // Read data & metadata size (read_offset update is done later if input param are ok)
-    uint16_t read_data_len = ( ( uint16_t ) ctrl->buffer[ctrl->read_offset] ) << 8;
-    read_data_len += ( ( uint16_t ) ctrl->buffer[( ctrl->read_offset + 1 ) % ctrl->buffer_size] );
-    uint8_t read_metadata_len = ctrl->buffer[( ctrl->read_offset + 2 ) % ctrl->buffer_size];
+    uint16_t             elt_len;
+    fifo_return_status_t ret = ctrl_read_element( ctrl, ctrl->read_offset, buffer, data_len, data_buffer_size,
+                                                  metadata, metadata_len, metadata_buffer_size, &elt_len );
+    if( ret != FIFO_STATUS_OK )
+    {
+        return ret;
+    }
+
+    // Update read offset (only if there is no error)
+    ctrl->read_offset = ctrl_advance( ctrl, ctrl->read_offset, elt_len );
+
+    ctrl->free_space += elt_len;
+    ctrl->nb_element -= 1;
+    ctrl->read_cnt += 1;
+
+    return FIFO_STATUS_OK;
+}
+
+//
+// Single-producer/single-consumer mode
+//
+// write_offset and write_cnt are only written by the producer side, read_offset and read_cnt only by the consumer. The
+// offsets are free running and masked with the power of two buffer size, the element is copied before its offset is
+// published with a release store, and the other side reads the offset with an acquire load. Several producers (modem
+// engine and radio irqs) can push to the same fifo, fifo_ctrl_set masks the modem irqs around the push so that they
+// never interleave; the consumer does not need it.
+//
+
+static fifo_return_status_t ctrl_set_spsc( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
+                                           const void* metadata, const uint8_t metadata_len )
+{
+    uint16_t total_write_len = LEN_HEADER_SIZE + metadata_len + buffer_len;
+
+    if( total_write_len > ctrl->buffer_size )
+    {
+        return FIFO_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    uint16_t used_space = ctrl->write_offset - __atomic_load_n( &ctrl->read_offset, __ATOMIC_ACQUIRE );
+    if( ( ctrl->buffer_size - used_space ) < total_write_len )
+    {
+        // The oldest element belongs to the consumer, the new one is dropped
+        ctrl->drop_cnt += 1;
+        return FIFO_STATUS_BUFFER_FULL;
+    }
+
+    ctrl_write_element( ctrl, ctrl->write_offset & ( ctrl->buffer_size - 1 ), buffer, buffer_len, metadata,
+                        metadata_len );
+
+    __atomic_store_n( &ctrl->write_offset, ( uint16_t )( ctrl->write_offset + total_write_len ), __ATOMIC_RELEASE );
+    __atomic_store_n( &ctrl->write_cnt, ctrl->write_cnt + 1, __ATOMIC_RELEASE );
+
+    return FIFO_STATUS_OK;
+}
+
+static fifo_return_status_t ctrl_get_spsc( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t* data_len,
+                                           const uint16_t data_buffer_size, void* metadata, uint8_t* metadata_len,
+                                           const uint8_t metadata_buffer_size )
+{
+    if( __atomic_load_n( &ctrl->write_offset, __ATOMIC_ACQUIRE ) == ctrl->read_offset )
+    {
+        return FIFO_STATUS_BUFFER_EMPTY;
+    }
+
+    uint16_t             elt_len;
+    fifo_return_status_t ret =
+        ctrl_read_element( ctrl, ctrl->read_offset & ( ctrl->buffer_size - 1 ), buffer, data_len, data_buffer_size,
+                           metadata, metadata_len, metadata_buffer_size, &elt_len );
+    if( ret != FIFO_STATUS_OK )
+    {
+        return ret;
+    }
+
+    __atomic_store_n( &ctrl->read_cnt, ctrl->read_cnt + 1, __ATOMIC_RELEASE );
+    __atomic_store_n( &ctrl->read_offset, ( uint16_t )( ctrl->read_offset + elt_len ), __ATOMIC_RELEASE );
+
+    return FIFO_STATUS_OK;
+}
+
+static uint16_t ctrl_advance( const fifo_ctrl_t* ctrl, uint16_t pos, const uint16_t len )
+{
+    pos += len;
+    if( pos >= ctrl->buffer_size )
+    {
+        pos -= ctrl->buffer_size;
+    }
+    return pos;
+}
+
+static void ctrl_copy_in( fifo_ctrl_t* ctrl, const uint16_t pos, const uint8_t* src, const uint16_t len )
+{
+    if( ( pos + len ) > ctrl->buffer_size )
+    {
+        memcpy( ctrl->buffer + pos, src, ctrl->buffer_size - pos );
+        memcpy( ctrl->buffer, src + ctrl->buffer_size - pos, len - ( ctrl->buffer_size - pos ) );
+    }
+    else
+    {
+        memcpy( ctrl->buffer + pos, src, len );
+    }
+}
+
+static void ctrl_copy_out( const fifo_ctrl_t* ctrl, const uint16_t pos, uint8_t* dst, const uint16_t len )
+{
+    if( ( pos + len ) > ctrl->buffer_size )
+    {
+        memcpy( dst, ctrl->buffer + pos, ctrl->buffer_size - pos );
+        memcpy( dst + ctrl->buffer_size - pos, ctrl->buffer, len - ( ctrl->buffer_size - pos ) );
+    }
+    else
+    {
+        memcpy( dst, ctrl->buffer + pos, len );
+    }
+}
+
+static void ctrl_write_element( fifo_ctrl_t* ctrl, uint16_t pos, const uint8_t* buffer, const uint16_t buffer_len,
+                                const void* metadata, const uint8_t metadata_len )
+{
+    // Data length - 2 bytes MSB first, then metadata length
+    const uint8_t header[LEN_HEADER_SIZE] = { ( uint8_t )( buffer_len >> 8 ), ( uint8_t )( buffer_len ),
+                                              metadata_len };
+
+    ctrl_copy_in( ctrl, pos, header, LEN_HEADER_SIZE );
+    pos = ctrl_advance( ctrl, pos, LEN_HEADER_SIZE );
+
+    if( metadata_len != 0 )
+    {
+        ctrl_copy_in( ctrl, pos, ( const uint8_t* ) metadata, metadata_len );
+        pos = ctrl_advance( ctrl, pos, metadata_len );
+    }
+
+    if( buffer_len != 0 )
+    {
+        ctrl_copy_in( ctrl, pos, buffer, buffer_len );
+    }
+}
+
+static fifo_return_status_t ctrl_read_element( const fifo_ctrl_t* ctrl, uint16_t pos, uint8_t* buffer,
+                                               uint16_t* data_len, const uint16_t data_buffer_size, void* metadata,
+                                               uint8_t* metadata_len, const uint8_t metadata_buffer_size,
+                                               uint16_t* elt_len )
+{
+    uint8_t header[LEN_HEADER_SIZE];
+
+    // Read data & metadata size
+    ctrl_copy_out( ctrl, pos, header, LEN_HEADER_SIZE );
+    uint16_t read_data_len     = ( ( ( uint16_t ) header[0] ) << 8 ) + header[1];
+    uint8_t  read_metadata_len = header[2];
 
     // Buffer & metadata are NULL --> drop old message --> don't check/update size of buffer
     if( ( buffer != NULL ) && ( metadata != NULL ) )
@@ -242,48 +491,21 @@ static fifo_return_status_t ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16
             return FIFO_STATUS_BUFFER_TOO_SMALL;
         }
     }
-
-    // Update read offset (only if there is no error)
-    ctrl->read_offset += ( LEN_DATA_SIZE + LEN_METADATA_SIZE );
-    ctrl->read_offset %= ctrl->buffer_size;
+    pos = ctrl_advance( ctrl, pos, LEN_HEADER_SIZE );
 
     // Copy metadata (if required)
     if( ( metadata != NULL ) && ( read_metadata_len != 0 ) )
     {
-        if( ( ctrl->read_offset + read_metadata_len ) > ctrl->buffer_size )
-        {
-            memcpy( ( uint8_t* ) metadata, ctrl->buffer + ctrl->read_offset, ctrl->buffer_size - ctrl->read_offset );
-            memcpy( ( uint8_t* ) metadata + ctrl->buffer_size - ctrl->read_offset, ctrl->buffer,
-                    read_metadata_len - ( ctrl->buffer_size - ctrl->read_offset ) );
-        }
-        else
-        {
-            memcpy( ( uint8_t* ) metadata, ctrl->buffer + ctrl->read_offset, read_metadata_len );
-        }
+        ctrl_copy_out( ctrl, pos, ( uint8_t* ) metadata, read_metadata_len );
     }
-    ctrl->read_offset += read_metadata_len;
-    ctrl->read_offset %= ctrl->buffer_size;
+    pos = ctrl_advance( ctrl, pos, read_metadata_len );
 
     // Copy data (if required)
     if( ( buffer != NULL ) && ( read_data_len != 0 ) )
     {
-        if( ( ctrl->read_offset + read_data_len ) > ctrl->buffer_size )
-        {
-            memcpy( buffer, ctrl->buffer + ctrl->read_offset, ctrl->buffer_size - ctrl->read_offset );
-            memcpy( buffer + ctrl->buffer_size - ctrl->read_offset, ctrl->buffer,
-                    read_data_len - ( ctrl->buffer_size - ctrl->read_offset ) );
-        }
-        else
-        {
-            memcpy( buffer, ctrl->buffer + ctrl->read_offset, read_data_len );
-        }
+        ctrl_copy_out( ctrl, pos, buffer, read_data_len );
     }
-    ctrl->read_offset += read_data_len;
-    ctrl->read_offset %= ctrl->buffer_size;
-
-    ctrl->free_space += ( LEN_DATA_SIZE + LEN_METADATA_SIZE + read_metadata_len + read_data_len );
-    ctrl->nb_element -= 1;
-    ctrl->read_cnt += 1;
 
+    *elt_len = LEN_HEADER_SIZE + read_metadata_len + read_data_len;
     return FIFO_STATUS_OK;
 }
@@ -43,7 +43,8 @@ extern "C" {
  * -----------------------------------------------------------------------------
  * --- DEPENDENCIES ------------------------------------------------------------
  */
-#include <stdint.h>  // C99 types
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
 
 /*
  * -----------------------------------------------------------------------------
@@ -68,9 +69,12 @@ typedef enum fifo_return_status_e
     FIFO_STATUS_BUFFER_EMPTY,      // Only for get function
     FIFO_STATUS_BUFFER_TOO_SMALL,  // For get: not enough space in buffer to read data from fifo
                                    // For set: fifo is not big enough to save data + metadata
+    FIFO_STATUS_BUFFER_FULL,       // Only for set in spsc mode: the new element is dropped
 } fifo_return_status_t;
 
 // Internal structure to manage fifo - don't modify it
+// In spsc mode, read_offset and write_offset are free running indexes, each one is only written by one side
+// (consumer and producer) and free_space/nb_element are not used
 typedef struct fifo_ctrl_s
 {
     uint8_t* buffer;
@@ -79,6 +83,7 @@ typedef struct fifo_ctrl_s
     uint16_t write_offset;
     uint16_t free_space;
     uint16_t nb_element;
+    bool     spsc;
 
     // Stat
     uint32_t write_cnt;
@@ -86,6 +91,14 @@ typedef struct fifo_ctrl_s
     uint32_t drop_cnt;
 } fifo_ctrl_t;
 
+// Oldest element of a spsc fifo read in place, see fifo_ctrl_peek
+typedef struct fifo_ctrl_peek_s
+{
+    const uint8_t* data[2];      // Data spans in the fifo buffer, data[1] is only used when the data wraps
+    uint16_t       data_len[2];  // Length of each span
+    uint16_t       elt_len;      // Size of the element in the fifo, 0 when no element is peeked
+} fifo_ctrl_peek_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -101,6 +114,18 @@ typedef struct fifo_ctrl_s
  */
 void fifo_ctrl_init( fifo_ctrl_t* ctrl, uint8_t* buffer, const uint16_t buffer_size );
 
+/**
+ * @brief Init the fifo in single-consumer mode
+ *      The consumer (fifo_ctrl_get, fifo_ctrl_peek) is lock-free and never masks the modem irqs. The producers
+ *      (fifo_ctrl_set) can run in several contexts (modem engine and irqs), they are serialized by masking the modem
+ *      irqs during the push only. When the fifo is full, the new element is dropped instead of the oldest one.
+ *
+ * @param ctrl          Fifo manager
+ * @param buffer        Buffer to link to the fifo manager
+ * @param buffer_size   Buffer size, must be a power of two and at most 32768
+ */
+void fifo_ctrl_init_spsc( fifo_ctrl_t* ctrl, uint8_t* buffer, const uint16_t buffer_size );
+
 /**
  * @brief Reset fifo manager (all datas & metadatas will be lost)
  *
@@ -147,9 +172,33 @@ fifo_return_status_t fifo_ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t
                                     const uint16_t data_buffer_size, void* metadata, uint8_t* metadata_len,
                                     const uint8_t metadata_buffer_size );
 
+/**
+ * @brief Read the oldest element of a spsc fifo in place, without removing it
+ *      The metadata are copied, the data are given as one or two spans in the fifo buffer. The spans stay valid until
+ *      fifo_ctrl_commit is called, the producer never writes in the space of the peeked element.
+ *
+ * @param ctrl                  fifo manager (spsc mode only)
+ * @param peek                  peeked element, to give back to fifo_ctrl_commit
+ * @param metadata              pointer to save metadata
+ * @param metadata_len          length of metadata
+ * @param metadata_buffer_size  size of metadata buffer
+ * @return fifo_return_status_t return status
+ */
+fifo_return_status_t fifo_ctrl_peek( fifo_ctrl_t* ctrl, fifo_ctrl_peek_t* peek, void* metadata, uint8_t* metadata_len,
+                                     const uint8_t metadata_buffer_size );
+
+/**
+ * @brief Remove the element read by fifo_ctrl_peek from the fifo, its spans must not be used anymore
+ *
+ * @param ctrl  fifo manager (spsc mode only)
+ * @param peek  peeked element, its elt_len is reset
+ * @return fifo_return_status_t return status
+ */
+fifo_return_status_t fifo_ctrl_commit( fifo_ctrl_t* ctrl, fifo_ctrl_peek_t* peek );
+
 /**
  * @brief Save a new element in the fifo
- *      If there is not enough free space, the oldest element will be removed
+ *      If there is not enough free space, the oldest element will be removed (the new one in spsc mode)
  *
  * @param ctrl          fifo manager
  * @param buffer        buffer to save
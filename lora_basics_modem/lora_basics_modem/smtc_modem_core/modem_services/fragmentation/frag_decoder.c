@@ -36,6 +36,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 #include "lr1mac_utilities.h"
 #include "frag_decoder.h"
 #include "smtc_modem_hal.h"
@@ -48,6 +49,10 @@
 #define STATIC static
 #endif
 
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
 /*
  *=============================================================================
  * Fragmentation decoder algorithm utilities
@@ -56,20 +61,21 @@
 
 /*
  * L = FRAG_MAX_SIZE
- * M = FRAG_MAX_NB
- * R = FRAG_MAX_FRAME_LOSS
+ * M = FragNb
+ * R = MaxLoss
  *
  *
- * Global
- *  MatrixM2B [R][R/8]          little parity matrix
- *  FragNbMissingIndex [M]      Fragment i is the Nth missing
+ * Arena
+ *  FragNbMissingIndex [R]      Fragment i is the Nth missing
+ *  FragMissing [M/8]
+ *  matrixRow [M/8]             Ci in the paper
  *  S[R/8]
+ *  dataTempVector [R/8]        Line of MatrixM2B
+ *  dataTempVector2 [R/8]       Line of MatrixM2B
+ *  MatrixM2B [R][R/8]          little parity matrix, or one of its lines when spilled
  *
  * Local
- *  matrixRow [M/8]             Ci in the paper
  *  matrixDataTemp [L]          Coded fragment, Si in the paper
- *  dataTempVector [R/8]        Line of MatrixM2B
- *  dataTempVector2 [R/8]       Line of MatrixM2B
  *
  */
 
@@ -130,13 +136,33 @@
 #endif  // TEST
 
 // This computes the number of bytes needed to store N bits.
-#define BITARRAY_BYTES( N ) ( ( ( N ) + 7 ) >> 3 )
+#define BITARRAY_BYTES( N ) ( ( ( uint32_t ) ( N ) + 7 ) >> 3 )
+
+// Largest NbFrag of a FragSessionSetupReq ( 14 bits field )
+#define FRAG_NB_MAX 16383
+
+// Flash pages holding the reconstructed file, erased when a session is set up
+#define FRAG_FLASH_FIRST_PAGE 109
+#define FRAG_FLASH_PAGE_SIZE 2048
+
+#if( FRAG_ROW_CACHE_NB > 0 )
+typedef struct
+{
+    uint32_t LastUse;  // RowCacheTick at the last access, the smallest one is the least recently used line
+    uint16_t Row;
+    bool     Valid;
+    bool     Dirty;
+    uint8_t  Data[FRAG_MAX_SIZE];
+} FragRowCacheLine_t;
+#endif
 
 typedef struct
 {
     FragDecoderCallbacks_t* Callbacks;
     uint16_t                FragNb;
     uint8_t                 FragSize;
+    uint16_t                MaxLoss;
+    uint32_t                ArenaSize;
 
     uint32_t M2BLine;
 
@@ -149,15 +175,19 @@ typedef struct
      * We will store at most L*(L+1)/2 bits, with L the maximum number of missing fragments
      * that we can tolerate.
      *
-     * NbElems = FRAG_MAX_FRAME_LOSS * (FRAG_MAX_FRAME_LOSS + 1) / 2
+     * NbElems = MaxLoss * (MaxLoss + 1) / 2
      *
      * // (N+7)/8 is the correct floor function for 8 bits/byte
      * NbBytes = (NbElems + 7) >> 3
      *
+     * When M2BSpilled is true the matrix is behind the FragDecoderMatrixWrite/Read callbacks,
+     * and this only holds the bytes of the line being extracted or pushed.
      */
-#define M2B_NB_ELEM ( FRAG_MAX_FRAME_LOSS * ( FRAG_MAX_FRAME_LOSS + 1 ) >> 1 )
-#define M2B_STORAGE_SIZE ( BITARRAY_BYTES( M2B_NB_ELEM ) )
-    uint8_t MatrixM2B[M2B_STORAGE_SIZE];
+#define M2B_NB_ELEM( maxLoss ) ( ( ( uint32_t ) ( maxLoss ) * ( ( uint32_t ) ( maxLoss ) + 1 ) ) >> 1 )
+#define M2B_STORAGE_SIZE( maxLoss ) ( BITARRAY_BYTES( M2B_NB_ELEM( maxLoss ) ) )
+#define M2B_LINE_SIZE( maxLoss ) ( ( ( maxLoss ) >> 3 ) + 2 )
+    uint8_t* MatrixM2B;
+    bool     M2BSpilled;
 
     /*
      * BitArray containing if fragment {I} is missing or not.
@@ -166,8 +196,7 @@ typedef struct
      * iterating through FragMissingIndex every time we want to check
      * if a fragment is missing or not. The gain is small though (32 bytes for 256 fragments)
      */
-#define MISSING_STORAGE_SIZE ( BITARRAY_BYTES( FRAG_MAX_NB ) )
-    uint8_t FragMissing[MISSING_STORAGE_SIZE];
+    uint8_t* FragMissing;
 
     /*
      * Array containing Status.FragNbLost elements.
@@ -178,11 +207,42 @@ typedef struct
      * We could also remove this if we do an exhaustive search through FragMissing, by keeping count
      * of the real index and the number of missing bits set to 1.
      */
-    uint16_t FragMissingIndex[FRAG_MAX_FRAME_LOSS];
+    uint16_t* FragMissingIndex;
+
+    uint8_t* S;
+
+    /*
+     * Scratch lines of FragDecoderProcess, sized from FragNb and MaxLoss
+     */
+    uint8_t* MatrixRow;
+    uint8_t* DataTempVector;
+    uint8_t* DataTempVector2;
 
-    uint8_t S[BITARRAY_BYTES( FRAG_MAX_FRAME_LOSS )];
+    /*
+     * Parity matrix rows of the coded fragments FragNb + 1 to FragNb + FRAG_PARITY_ROW_CACHE_NB,
+     * ( FragNb >> 3 ) + 1 bytes each, computed by FragDecoderInitArena
+     */
+    uint8_t* ParityRows;
 
     FragDecoderStatus_t Status;
+
+    /*
+     * Progress of the step 5 back-substitution: next row to solve (goes down to 0), and first column of that
+     * row still to be added when a chunk stopped in the middle of it
+     */
+    bool    BackSubPending;
+    int32_t BackSubRow;
+    int32_t BackSubCol;
+
+#if( FRAG_ROW_CACHE_NB > 0 )
+    /*
+     * Write-back cache in front of the Write/Read callbacks. The step 5 back-substitution rereads
+     * the same rows O(FragNbLost^2) times, and every write to the flash callback erases a page.
+     */
+    FragRowCacheLine_t RowCache[FRAG_ROW_CACHE_NB];
+    uint32_t           RowCacheTick;
+    bool               RowCacheWriteError;
+#endif
 } FragDecoder_t;
 
 /*!
@@ -202,6 +262,47 @@ static void SetRow( uint8_t* src, uint16_t row, uint16_t size );
  */
 static void GetRow( uint8_t* src, uint16_t row, uint16_t size );
 
+/*!
+ * \brief Writes a row straight to the file through the Write callback
+ *
+ * \param [IN] src  Source buffer pointer
+ * \param [IN] row  Destination index of the row to be copied
+ * \param [IN] size Source number of bytes to be copied
+ *
+ * \retval status   Write operation status [0: Success, -1 Fail]
+ */
+static int8_t WriteRowToFile( uint8_t* src, uint16_t row, uint16_t size );
+
+/*!
+ * \brief Reads a row straight from the file through the Read callback
+ *
+ * \param [IN] dst  Destination buffer pointer
+ * \param [IN] row  Source index of the row to be copied
+ * \param [IN] size Source number of bytes to be copied
+ */
+static void ReadRowFromFile( uint8_t* dst, uint16_t row, uint16_t size );
+
+#if( FRAG_ROW_CACHE_NB > 0 )
+/*!
+ * \brief Returns the cache line holding a row, evicting the least recently used line on a miss
+ *
+ * \param [IN] row  Index of the row
+ * \param [IN] size Number of bytes of a row
+ * \param [IN] load Read the row from the file on a miss, false when the caller overwrites the whole row
+ *
+ * \retval line     Cache line of the row
+ */
+static FragRowCacheLine_t* RowCacheGetLine( uint16_t row, uint16_t size, bool load );
+
+/*!
+ * \brief Writes a cache line back to the file if it was modified
+ *
+ * \param [IN] line Cache line to write back
+ * \param [IN] size Number of bytes of a row
+ */
+static void RowCacheWriteBack( FragRowCacheLine_t* line, uint16_t size );
+#endif
+
 /*!
  * \brief Gets the parity value from a given row of the parity matrix
  *
@@ -231,26 +332,26 @@ STATIC void SetParity( uint16_t index, uint8_t* matrixRow, uint8_t parity );
 static bool IsPowerOfTwo( uint32_t x );
 
 /*!
- * \brief XOrs two data lines
+ * \brief XOrs two data lines, a word at a time
  *
- * \param [IN]  line1  1st Data line to be XORed
- * \param [IN]  line2  2nd Data line to be XORed
- * \param [IN]  size   Number of elements in line1
+ * \param [IN]  line1  1st Data line to be XORed, no alignment required
+ * \param [IN]  line2  2nd Data line to be XORed, no alignment required
+ * \param [IN]  size   Number of bytes in line1
  *
  * \param [OUT] result XOR( line1, line2 ) result stored in line1
  */
-static void XorDataLine( uint8_t* line1, uint8_t* line2, int32_t size );
+static void XorDataLine( uint8_t* line1, const uint8_t* line2, int32_t size );
 
 /*!
- * \brief XORs two parity lines
+ * \brief XORs two parity lines, a byte at a time
  *
  * \param [IN]  line1  1st Parity line to be XORed
  * \param [IN]  line2  2nd Parity line to be XORed
- * \param [IN]  size   Number of elements in line1
+ * \param [IN]  size   Number of bits in line1, bits beyond it are left untouched
  *
  * \param [OUT] result XOR( line1, line2 ) result stored in line1
  */
-static void XorParityLine( uint8_t* line1, uint8_t* line2, int32_t size );
+static void XorParityLine( uint8_t* line1, const uint8_t* line2, int32_t size );
 
 /*!
  * \brief Generates a pseudo random number : PRBS23
@@ -270,6 +371,24 @@ static int32_t FragPrbs23( int32_t value );
  */
 STATIC void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow );
 
+/*!
+ * \brief Loads 32 bits of a bit array, bit index order kept (index 0 is the MSB)
+ *
+ * \param [IN] bitArray Pointer to the first byte to load, no alignment required
+ * \retval word         The 4 bytes as a big endian word
+ */
+static uint32_t BitArrayLoadWord( const uint8_t* bitArray );
+
+/*!
+ * \brief Finds the index of the first one in a bit array, starting from a given index
+ *
+ * \param [IN] bitArray Pointer to the bit array
+ * \param [IN] start    First index to test
+ * \param [IN] size     Bit array size
+ * \retval index        The index of the next 1 in the bit array, size if there is none
+ */
+static uint16_t BitArrayFindNextOne( const uint8_t* bitArray, uint16_t start, uint16_t size );
+
 /*!
  * \brief Finds the index of the first one in a bit array
  *
@@ -312,7 +431,7 @@ static uint16_t FragFindMissingIndex( uint16_t x );
  * \param [IN] fragCounter      Number of the missing fragment (1-indexed)
  *
  * \retval index    The index of the missing fragment in the small matrix. (0-indexed)
- *                  If the index is not found, FRAG_MAX_FRAME_LOSS is returned
+ *                  If the index is not found, FragDecoder.MaxLoss is returned
  *                  to indicate an error, and the caller should check this condition.
  */
 static uint16_t FragFindMissing( uint16_t fragCounter );
@@ -321,8 +440,8 @@ static uint16_t FragFindMissing( uint16_t fragCounter );
  * \brief Extacts a row from the M2B binary matrix and expands it to a bitArray
  *
  * \param [IN] bitArray  Pointer to the bit array
- * \param [IN] rowIndex  Matrix row index           Max FRAG_MAX_FRAME_LOSS
- * \param [IN] bitsInRow Number of bits in one row. Max FRAG_MAX_FRAME_LOSS
+ * \param [IN] rowIndex  Matrix row index           Max FragDecoder.MaxLoss
+ * \param [IN] bitsInRow Number of bits in one row. Max FragDecoder.MaxLoss
  */
 STATIC void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow );
 
@@ -330,11 +449,39 @@ STATIC void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowInde
  * \brief Collapses and Pushs a row of a bit array to the M2B matrix
  *
  * \param [IN] bitArray  Pointer to the bit array
- * \param [IN] rowIndex  Matrix row index           Max FRAG_MAX_FRAME_LOSS
- * \param [IN] bitsInRow Number of bits in one row. Max FRAG_MAX_FRAME_LOSS
+ * \param [IN] rowIndex  Matrix row index           Max FragDecoder.MaxLoss
+ * \param [IN] bitsInRow Number of bits in one row. Max FragDecoder.MaxLoss
  */
 STATIC void FragPushLineToBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow );
 
+/*!
+ * \brief Computes the position of the first stored bit of a row of the triangular M2B matrix
+ *
+ * \param [IN] rowIndex  Matrix row index           Max FragDecoder.MaxLoss
+ * \param [IN] bitsInRow Number of bits in one row. Max FragDecoder.MaxLoss
+ *
+ * \retval bit          Bit index of the row in the M2B storage
+ */
+static uint32_t M2BLineFirstBit( uint16_t rowIndex, uint16_t bitsInRow );
+
+/*!
+ * \brief Gives access to bytes of the M2B matrix, read through FragDecoderMatrixRead when it is spilled
+ *
+ * \param [IN] firstByte First byte of the M2B storage
+ * \param [IN] size      Number of bytes, at most M2B_LINE_SIZE( MaxLoss ) when spilled
+ *
+ * \retval bytes        Pointer to the bytes, valid until the next load
+ */
+static uint8_t* M2BLoadLine( uint32_t firstByte, uint32_t size );
+
+/*!
+ * \brief Writes back bytes given by M2BLoadLine when the M2B matrix is spilled
+ *
+ * \param [IN] firstByte First byte of the M2B storage, as given to M2BLoadLine
+ * \param [IN] size      Number of bytes, as given to M2BLoadLine
+ */
+static void M2BStoreLine( uint32_t firstByte, uint32_t size );
+
 /*
  *=============================================================================
  * Fragmentation decoder algorithm
@@ -343,7 +490,24 @@ STATIC void FragPushLineToBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, ui
 
 static FragDecoder_t FragDecoder;
 
+/*!
+ * Working memory used by FragDecoderInit
+ */
+static uint8_t FragDecoderArena[FRAG_DECODER_ARENA_SIZE( FRAG_MAX_NB, FRAG_MAX_FRAME_LOSS, false )];
+
 int32_t FragDecoderInit( uint16_t fragNb, uint8_t fragSize, FragDecoderCallbacks_t* callbacks )
+{
+    if( fragNb > FRAG_MAX_NB )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "FRAG fragNb > %d\n", FRAG_MAX_NB );
+        return FRAG_SESSION_BADSIZE;
+    }
+    return FragDecoderInitArena( fragNb, fragSize, FRAG_MAX_FRAME_LOSS, callbacks, FragDecoderArena,
+                                 sizeof( FragDecoderArena ) );
+}
+
+int32_t FragDecoderInitArena( uint16_t fragNb, uint8_t fragSize, uint16_t maxLoss, FragDecoderCallbacks_t* callbacks,
+                              uint8_t* arena, uint32_t arenaSize )
 {
     if( !callbacks || !callbacks->FragDecoderWrite || !callbacks->FragDecoderRead )
     {
@@ -351,48 +515,111 @@ int32_t FragDecoderInit( uint16_t fragNb, uint8_t fragSize, FragDecoderCallbacks
         return FRAG_SESSION_ERROR;
     }
 
-    if( fragNb > FRAG_MAX_NB || fragSize > FRAG_MAX_SIZE )
+    bool spill = ( callbacks->FragDecoderMatrixWrite != NULL ) && ( callbacks->FragDecoderMatrixRead != NULL );
+
+    if( fragSize > FRAG_MAX_SIZE || maxLoss == 0 || arena == NULL ||
+        arenaSize < FRAG_DECODER_ARENA_SIZE( fragNb, maxLoss, spill ) )
     {
-        SMTC_MODEM_HAL_TRACE_ERROR( "FRAG fragNb > %d || fragSize > %d\n", FRAG_MAX_NB, FRAG_MAX_SIZE );
+        SMTC_MODEM_HAL_TRACE_ERROR( "FRAG fragSize > %d || arena %u < %u bytes\n", FRAG_MAX_SIZE, arenaSize,
+                                    FRAG_DECODER_ARENA_SIZE( fragNb, maxLoss, spill ) );
         return FRAG_SESSION_BADSIZE;
     }
 
     FragDecoder.Callbacks           = callbacks;
     FragDecoder.FragNb              = fragNb;    // FragNb = FRAG_MAX_SIZE
     FragDecoder.FragSize            = fragSize;  // number of byte on a row
+    FragDecoder.MaxLoss             = maxLoss;
+    FragDecoder.ArenaSize           = arenaSize;
     FragDecoder.Status.FragNbRx     = 0;
     FragDecoder.Status.FragNbLastRx = 0;
     FragDecoder.Status.FragNbLost   = 0;
     FragDecoder.M2BLine             = 0;
+    FragDecoder.BackSubPending      = false;
+
+    // Carve the arena, FragMissingIndex first on a 2 bytes boundary (the extra byte of FRAG_DECODER_ARENA_SIZE)
+    arena += ( ( uintptr_t ) arena ) & 0x01;
+    FragDecoder.FragMissingIndex = ( uint16_t* ) arena;
+    arena += 2 * maxLoss;
+    FragDecoder.FragMissing = arena;
+    arena += BITARRAY_BYTES( fragNb );
+    FragDecoder.MatrixRow = arena;
+    arena += ( fragNb >> 3 ) + 1;
+    FragDecoder.ParityRows = arena;
+    arena += FRAG_PARITY_ROW_CACHE_NB * ( ( fragNb >> 3 ) + 1 );
+    FragDecoder.S = arena;
+    arena += BITARRAY_BYTES( maxLoss );
+    FragDecoder.DataTempVector = arena;
+    arena += ( maxLoss >> 3 ) + 1;
+    FragDecoder.DataTempVector2 = arena;
+    arena += ( maxLoss >> 3 ) + 1;
+    FragDecoder.MatrixM2B  = arena;
+    FragDecoder.M2BSpilled = spill;
 
     // Initialize missing fragments index array
-    for( uint16_t i = 0; i < FRAG_MAX_FRAME_LOSS; i++ )
+    for( uint16_t i = 0; i < maxLoss; i++ )
     {
         FragDecoder.FragMissingIndex[i] = 0;
     }
-    for( size_t i = 0; i < MISSING_STORAGE_SIZE; i++ )
+    for( uint32_t i = 0; i < BITARRAY_BYTES( fragNb ); i++ )
     {
         FragDecoder.FragMissing[i] = 0;
     }
 
     // Initialize parity matrix
-    for( uint32_t i = 0; i < BITARRAY_BYTES( FRAG_MAX_FRAME_LOSS ); i++ )
+    for( uint32_t i = 0; i < BITARRAY_BYTES( maxLoss ); i++ )
     {
         FragDecoder.S[i] = 0;
     }
 
-    for( uint32_t i = 0; i < M2B_STORAGE_SIZE; i++ )
+    if( spill == false )
+    {
+        for( uint32_t i = 0; i < M2B_STORAGE_SIZE( maxLoss ); i++ )
+        {
+            FragDecoder.MatrixM2B[i] = 0xFF;
+        }
+    }
+    else
     {
-        FragDecoder.MatrixM2B[i] = 0xFF;
+        memset1( FragDecoder.MatrixM2B, 0xFF, M2B_LINE_SIZE( maxLoss ) );
+        for( uint32_t i = 0; i < M2B_STORAGE_SIZE( maxLoss ); i += M2B_LINE_SIZE( maxLoss ) )
+        {
+            uint32_t size = MIN( ( uint32_t ) M2B_LINE_SIZE( maxLoss ), M2B_STORAGE_SIZE( maxLoss ) - i );
+            if( callbacks->FragDecoderMatrixWrite( i, FragDecoder.MatrixM2B, size ) != 0 )
+            {
+                SMTC_MODEM_HAL_TRACE_ERROR( "FRAG parity matrix init failed at %u\n", i );
+                return FRAG_SESSION_MEM_ERROR;
+            }
+        }
     }
 
-    SMTC_MODEM_HAL_TRACE_INFO( "Missing %3d bytes\n", MISSING_STORAGE_SIZE );
-    SMTC_MODEM_HAL_TRACE_INFO( "MIndex  %3d bytes\n", FRAG_MAX_FRAME_LOSS );
-    SMTC_MODEM_HAL_TRACE_INFO( "M2B     %3d bytes\n", M2B_STORAGE_SIZE );
+#if( FRAG_ROW_CACHE_NB > 0 )
+    // Rows of a previous session are dropped, their pages are erased below
+    for( uint8_t i = 0; i < FRAG_ROW_CACHE_NB; i++ )
+    {
+        FragDecoder.RowCache[i].Valid = false;
+        FragDecoder.RowCache[i].Dirty = false;
+    }
+    FragDecoder.RowCacheTick       = 0;
+    FragDecoder.RowCacheWriteError = false;
+#endif
+
+    SMTC_MODEM_HAL_TRACE_INFO( "Missing %3u bytes\n", BITARRAY_BYTES( fragNb ) );
+    SMTC_MODEM_HAL_TRACE_INFO( "MIndex  %3d bytes\n", 2 * maxLoss );
+    SMTC_MODEM_HAL_TRACE_INFO( "M2B     %3d bytes%s\n", M2B_STORAGE_SIZE( maxLoss ), spill ? " (spilled)" : "" );
+#if( FRAG_ROW_CACHE_NB > 0 )
+    SMTC_MODEM_HAL_TRACE_INFO( "RowCache %d bytes\n", FRAG_ROW_CACHE_NB * FRAG_MAX_SIZE );
+#endif
+
+    // Generate the rows of the first coded fragments now rather than on their reception
+    for( uint16_t i = 0; i < FRAG_PARITY_ROW_CACHE_NB; i++ )
+    {
+        FragGetParityMatrixRow( fragNb + 1 + i, fragNb, FragDecoder.ParityRows + ( i * ( ( fragNb >> 3 ) + 1 ) ) );
+    }
 
-    // Initialize final uncoded data buffer ( FRAG_MAX_NB * FRAG_MAX_SIZE )
+    // Initialize final uncoded data buffer ( FragNb * FragSize )
     // erase Delta update storage pages
-    for( uint16_t page = 109; page < 124; page++ )
+    uint16_t nb_pages = ( ( ( uint32_t ) fragNb * fragSize ) + FRAG_FLASH_PAGE_SIZE - 1 ) / FRAG_FLASH_PAGE_SIZE;
+    for( uint16_t page = FRAG_FLASH_FIRST_PAGE; page < ( FRAG_FLASH_FIRST_PAGE + nb_pages ); page++ )
     {
         if( FlashErasePage( page, 0 ) != 1 )
         {
@@ -403,13 +630,30 @@ int32_t FragDecoderInit( uint16_t fragNb, uint8_t fragSize, FragDecoderCallbacks
     FragDecoder.Status.FragNbLost   = 0;
     FragDecoder.Status.FragNbLastRx = 0;
 
-    SMTC_MODEM_HAL_TRACE_INFO( "FragDecoderInit %d %d\n", FragDecoder.FragNb, FragDecoder.FragSize );
+    SMTC_MODEM_HAL_TRACE_INFO( "FragDecoderInit %d %d loss %d\n", FragDecoder.FragNb, FragDecoder.FragSize,
+                               FragDecoder.MaxLoss );
     return FRAG_SESSION_OK;
 }
 
 uint32_t FragDecoderGetMaxFileSize( void )
 {
-    return FRAG_MAX_NB * FRAG_MAX_SIZE;
+    // Largest fragment count whose session fits in the arena of the current one, the arena size grows with it
+    uint16_t low  = 0;
+    uint16_t high = FRAG_NB_MAX;
+
+    while( low < high )
+    {
+        uint16_t mid = ( low + high + 1 ) >> 1;
+        if( FRAG_DECODER_ARENA_SIZE( mid, FragDecoder.MaxLoss, FragDecoder.M2BSpilled ) <= FragDecoder.ArenaSize )
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    return ( uint32_t ) low * FRAG_MAX_SIZE;
 }
 
 FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
@@ -418,15 +662,20 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
     int32_t  first         = 0;
     int32_t  noInfo        = 0;
 
-    uint8_t matrixRow[( FRAG_MAX_NB >> 3 ) + 1];
-    uint8_t matrixDataTemp[FRAG_MAX_SIZE];
-    uint8_t dataTempVector[( FRAG_MAX_FRAME_LOSS >> 3 ) + 1];
-    uint8_t dataTempVector2[( FRAG_MAX_FRAME_LOSS >> 3 ) + 1];
+    uint8_t* matrixRow       = FragDecoder.MatrixRow;
+    uint8_t  matrixDataTemp[FRAG_MAX_SIZE];
+    uint8_t* dataTempVector  = FragDecoder.DataTempVector;
+    uint8_t* dataTempVector2 = FragDecoder.DataTempVector2;
 
-    memset1( matrixRow, 0, ( FRAG_MAX_NB >> 3 ) + 1 );
+    if( FragDecoder.Callbacks == NULL )
+    {
+        return FRAG_SESSION_ERROR;
+    }
+
+    memset1( matrixRow, 0, ( FragDecoder.FragNb >> 3 ) + 1 );
     memset1( matrixDataTemp, 0, FRAG_MAX_SIZE );
-    memset1( dataTempVector, 0, ( FRAG_MAX_FRAME_LOSS >> 3 ) + 1 );
-    memset1( dataTempVector2, 0, ( FRAG_MAX_FRAME_LOSS >> 3 ) + 1 );
+    memset1( dataTempVector, 0, ( FragDecoder.MaxLoss >> 3 ) + 1 );
+    memset1( dataTempVector2, 0, ( FragDecoder.MaxLoss >> 3 ) + 1 );
 
     SMTC_MODEM_HAL_TRACE_INFO( "FragProcess cnt %d nb_frag %d frag_size %d\n", fragCounter, FragDecoder.FragNb,
                                FragDecoder.FragSize );
@@ -445,6 +694,12 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
     // only in debug messages.
     FragDecoder.Status.FragNbRx += 1;
 
+    if( FragDecoder.BackSubPending == true )
+    {
+        // The system is already solved, use this call to go on with the back-substitution
+        return FragDecoderContinue( );
+    }
+
     if( fragCounter <= FragDecoder.Status.FragNbLastRx )
     {
         return FRAG_SESSION_ONGOING;  // Drop frame out of order
@@ -468,7 +723,7 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
         {
             // the case : all the M(FragNb) first rows have been transmitted with no error
             SMTC_MODEM_HAL_TRACE_INFO( "[OK] All uncoded fragments have been received - no need to continue\n" );
-            return FRAG_SESSION_OK;
+            return FragDecoderFlush( );
         }
 
         return FRAG_SESSION_ONGOING;
@@ -478,7 +733,7 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
     FragFindMissingFrags( fragCounter );
 
     // It will be impossible to reconstruct the original data
-    if( FragDecoder.Status.FragNbLost > FRAG_MAX_FRAME_LOSS )
+    if( FragDecoder.Status.FragNbLost > FragDecoder.MaxLoss )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Lost too many fragments\n" );
         FragDecoder.Status.MatrixError = 1;
@@ -486,57 +741,65 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
     }
 
     // At this point we receive encoded frames and the number of lost frames is well known
-    FragGetParityMatrixRow( fragCounter, FragDecoder.FragNb, matrixRow );
+    uint32_t parityRowIndex = ( uint32_t ) ( fragCounter - FragDecoder.FragNb - 1 );
+    if( parityRowIndex < FRAG_PARITY_ROW_CACHE_NB )
+    {
+        uint32_t rowBytes = ( FragDecoder.FragNb >> 3 ) + 1;
+        memcpy( matrixRow, FragDecoder.ParityRows + ( parityRowIndex * rowBytes ), rowBytes );
+    }
+    else
+    {
+        FragGetParityMatrixRow( fragCounter, FragDecoder.FragNb, matrixRow );
+    }
     SMTC_MODEM_HAL_TRACE_INFO( "Get parity matrix row %d\n", fragCounter );
     PARITY_LINE_PRINT( "matrixRow", matrixRow, 0, FragDecoder.FragNb );
 
     SMTC_MODEM_HAL_TRACE_INFO( "Checking if this fragments brings interesting information\n" );
     DATA_PRINT_FRAG( "Raw", rawData, FragDecoder.FragSize );
-    for( int32_t i = 0; i < FragDecoder.FragNb; i++ )
+    // Only visit the fragments this coded fragment is made of
+    for( int32_t i = BitArrayFindNextOne( matrixRow, 0, FragDecoder.FragNb ); i < FragDecoder.FragNb;
+         i = BitArrayFindNextOne( matrixRow, i + 1, FragDecoder.FragNb ) )
     {
-        if( GetParity( i, matrixRow ) == 1 )  // This fragment brings potentially new data for missing frag i
+        if( GetParity( i, FragDecoder.FragMissing ) == 0 )  // Nope, already received
+        {
+            SetParity( i, matrixRow, 0 );
+            GetRow( matrixDataTemp, i, FragDecoder.FragSize );
+            XorDataLine( rawData, matrixDataTemp, FragDecoder.FragSize );
+            SMTC_MODEM_HAL_TRACE_INFO( "Fragment %d already received\n", i + 1 );
+            DATA_PRINT_FRAG( "XOR", rawData, FragDecoder.FragSize );
+        }
+        else  // New unknown data, store it somewhere
         {
-            if( GetParity( i, FragDecoder.FragMissing ) == 0 )  // Nope, already received
+            // Fill the "little" boolean matrix m2b
+            // - Fragment {fragCounter} can give information on fragment {i}.
+            // - Fragment {i} is the {n}th missing, we need to find n
+            // Warning, we need to give the real fragCounter (1-indexed)
+            uint16_t nth = FragFindMissing( i + 1 );
+            if( nth >= FragDecoder.MaxLoss )
             {
-                SetParity( i, matrixRow, 0 );
-                GetRow( matrixDataTemp, i, FragDecoder.FragSize );
-                XorDataLine( rawData, matrixDataTemp, FragDecoder.FragSize );
-                SMTC_MODEM_HAL_TRACE_INFO( "Fragment %d already received\n", i + 1 );
-                DATA_PRINT_FRAG( "XOR", rawData, FragDecoder.FragSize );
+                // We didn't find it, maybe we have too many frames lost?
+                // We panic, because this should really not happen
+                // and means we have a deeper source of errors.
+                smtc_modem_hal_mcu_panic( "Could not find missing fragment %d in FragMissingIndex\n", i + 1 );
             }
-            else  // New unknown data, store it somewhere
+
+            // - We store that this fragment {fragCounter} can retrieve data for the {n}th in dataTempVector
+            SMTC_MODEM_HAL_TRACE_INFO(
+                "Fragment %d could bring new data for fragment %d (missing #%d) (total %d)\n", fragCounter, i + 1,
+                nth, FragDecoder.Status.FragNbLost );
+            SMTC_MODEM_HAL_TRACE_INFO( "SetParity for missing %d\n", nth );
+
+            SetParity( nth, dataTempVector, 1 );
+            if( first == 0 )
             {
-                // Fill the "little" boolean matrix m2b
-                // - Fragment {fragCounter} can give information on fragment {i}.
-                // - Fragment {i} is the {n}th missing, we need to find n
-                // Warning, we need to give the real fragCounter (1-indexed)
-                uint16_t nth = FragFindMissing( i + 1 );
-                if( nth >= FRAG_MAX_FRAME_LOSS )
-                {
-                    // We didn't find it, maybe we have too many frames lost?
-                    // We panic, because this should really not happen
-                    // and means we have a deeper source of errors.
-                    smtc_modem_hal_mcu_panic( "Could not find missing fragment %d in FragMissingIndex\n", i + 1 );
-                }
-
-                // - We store that this fragment {fragCounter} can retrieve data for the {n}th in dataTempVector
-                SMTC_MODEM_HAL_TRACE_INFO(
-                    "Fragment %d could bring new data for fragment %d (missing #%d) (total %d)\n", fragCounter, i + 1,
-                    nth, FragDecoder.Status.FragNbLost );
-                SMTC_MODEM_HAL_TRACE_INFO( "SetParity for missing %d\n", nth );
-
-                SetParity( nth, dataTempVector, 1 );
-                if( first == 0 )
-                {
-                    // Used to tell that we received at least one useful redundant fragment
-                    first = 1;
-                }
+                // Used to tell that we received at least one useful redundant fragment
+                first = 1;
             }
         }
     }
     PARITY_LINE_PRINT( "matrixRow", matrixRow, 0, FragDecoder.FragNb );
 
-    PARITY_LINE_PRINT( "dataTempVector", dataTempVector, 0, FRAG_MAX_FRAME_LOSS );
+    PARITY_LINE_PRINT( "dataTempVector", dataTempVector, 0, FragDecoder.MaxLoss );
     firstOneInRow = BitArrayFindFirstOne( dataTempVector, FragDecoder.Status.FragNbLost );
 
     SMTC_MODEM_HAL_TRACE_INFO( "first %d firstOneInRow %d\n", first, firstOneInRow + 1 );
@@ -544,10 +807,9 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
     if( first > 0 )
     {
         int32_t li;
-        int32_t lj;
 
         // Manage a new line in MatrixM2B
-        PARITY_LINE_PRINT( "S", FragDecoder.S, 0, FRAG_MAX_FRAME_LOSS );
+        PARITY_LINE_PRINT( "S", FragDecoder.S, 0, FragDecoder.MaxLoss );
         while( GetParity( firstOneInRow, FragDecoder.S ) == 1 )
         {
             // Row already diagonalized exist & ( FragDecoder.MatrixM2B[firstOneInRow][0] )
@@ -583,35 +845,11 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
         if( FragDecoder.M2BLine == FragDecoder.Status.FragNbLost )
         {
             // Then last step diagonalized
-            // Step 5 from the paper
-            if( FragDecoder.Status.FragNbLost > 1 )
-            {
-                int32_t i, j;
-
-                for( i = ( FragDecoder.Status.FragNbLost - 2 ); i >= 0; i-- )
-                {
-                    li = FragFindMissingIndex( i );
-                    GetRow( matrixDataTemp, li, FragDecoder.FragSize );
-                    for( j = ( FragDecoder.Status.FragNbLost - 1 ); j > i; j-- )
-                    {
-                        FragExtractLineFromBinaryMatrix( dataTempVector2, i, FragDecoder.Status.FragNbLost );
-                        FragExtractLineFromBinaryMatrix( dataTempVector, j, FragDecoder.Status.FragNbLost );
-                        if( GetParity( j, dataTempVector2 ) == 1 )
-                        {
-                            XorParityLine( dataTempVector2, dataTempVector, FragDecoder.Status.FragNbLost );
-
-                            lj = FragFindMissingIndex( j );
-
-                            GetRow( rawData, lj, FragDecoder.FragSize );
-                            XorDataLine( matrixDataTemp, rawData, FragDecoder.FragSize );
-                        }
-                    }
-                    SetRow( matrixDataTemp, li, FragDecoder.FragSize );
-                }
-            }
-
-            SMTC_MODEM_HAL_TRACE_INFO( "Session reconstructed, FragNbLost %d\n", FragDecoder.Status.FragNbLost );
-            return FRAG_SESSION_OK;
+            // Step 5 from the paper, run by chunks of FRAG_BACKSUB_BUDGET row operations
+            FragDecoder.BackSubPending = true;
+            FragDecoder.BackSubRow     = FragDecoder.Status.FragNbLost - 2;
+            FragDecoder.BackSubCol     = FragDecoder.Status.FragNbLost - 1;
+            return FragDecoderContinue( );
         }
     }
 
@@ -619,11 +857,96 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
     return FRAG_SESSION_ONGOING;
 }
 
+FragDecoderSessionStatus_t FragDecoderContinue( void )
+{
+    uint8_t  matrixDataTemp[FRAG_MAX_SIZE];
+    uint8_t  matrixDataTemp2[FRAG_MAX_SIZE];
+    uint8_t* dataTempVector2 = FragDecoder.DataTempVector2;
+    uint16_t nbLost          = FragDecoder.Status.FragNbLost;
+#if( FRAG_BACKSUB_BUDGET > 0 )
+    uint32_t budget = FRAG_BACKSUB_BUDGET;
+#endif
+
+    if( FragDecoder.BackSubPending == false )
+    {
+        return FRAG_SESSION_ONGOING;
+    }
+
+    // Rows are solved from the bottom of the triangular matrix. Row i only needs the data of the rows below it
+    // it has a one for, and is only read once solved, so a partially reduced row can be stored between two chunks
+    while( FragDecoder.BackSubRow >= 0 )
+    {
+        int32_t i  = FragDecoder.BackSubRow;
+        int32_t li = FragFindMissingIndex( i );
+
+#if( FRAG_BACKSUB_BUDGET > 0 )
+        if( budget == 0 )
+        {
+            SMTC_MODEM_HAL_TRACE_INFO( "Back-substitution paused at row %d\n", i );
+            return FRAG_SESSION_RECONSTRUCTING;
+        }
+#endif
+        GetRow( matrixDataTemp, li, FragDecoder.FragSize );
+        FragExtractLineFromBinaryMatrix( dataTempVector2, i, nbLost );
+        for( int32_t j = BitArrayFindNextOne( dataTempVector2, FragDecoder.BackSubCol, nbLost ); j < nbLost;
+             j = BitArrayFindNextOne( dataTempVector2, j + 1, nbLost ) )
+        {
+#if( FRAG_BACKSUB_BUDGET > 0 )
+            if( budget == 0 )
+            {
+                SetRow( matrixDataTemp, li, FragDecoder.FragSize );
+                FragDecoder.BackSubCol = j;
+                SMTC_MODEM_HAL_TRACE_INFO( "Back-substitution paused at row %d column %d\n", i, j );
+                return FRAG_SESSION_RECONSTRUCTING;
+            }
+#endif
+            GetRow( matrixDataTemp2, FragFindMissingIndex( j ), FragDecoder.FragSize );
+            XorDataLine( matrixDataTemp, matrixDataTemp2, FragDecoder.FragSize );
+#if( FRAG_BACKSUB_BUDGET > 0 )
+            budget--;
+#endif
+        }
+        SetRow( matrixDataTemp, li, FragDecoder.FragSize );
+        FragDecoder.BackSubRow = i - 1;
+        FragDecoder.BackSubCol = i;
+#if( FRAG_BACKSUB_BUDGET > 0 )
+        // Loading and storing the row costs one unit
+        if( budget > 0 )
+        {
+            budget--;
+        }
+#endif
+    }
+    FragDecoder.BackSubPending = false;
+
+    SMTC_MODEM_HAL_TRACE_INFO( "Session reconstructed, FragNbLost %d\n", nbLost );
+
+    // The caller reads the file back through its own accessors, so it has to be complete
+    return FragDecoderFlush( );
+}
+
 FragDecoderStatus_t FragDecoderGetStatus( void )
 {
     return FragDecoder.Status;
 }
 
+FragDecoderSessionStatus_t FragDecoderFlush( void )
+{
+#if( FRAG_ROW_CACHE_NB > 0 )
+    for( uint8_t i = 0; i < FRAG_ROW_CACHE_NB; i++ )
+    {
+        RowCacheWriteBack( &FragDecoder.RowCache[i], FragDecoder.FragSize );
+    }
+    if( FragDecoder.RowCacheWriteError == true )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "FRAG row cache write back failed\n" );
+        FragDecoder.RowCacheWriteError = false;
+        return FRAG_SESSION_MEM_ERROR;
+    }
+#endif
+    return FRAG_SESSION_OK;
+}
+
 uint32_t FragDecoderFileSize( void )
 {
     uint32_t size = FragDecoder.FragNb * FragDecoder.FragSize;
@@ -638,14 +961,36 @@ uint32_t FragDecoderFileSize( void )
  */
 
 static void SetRow( uint8_t* src, uint16_t row, uint16_t size )
+{
+#if( FRAG_ROW_CACHE_NB > 0 )
+    FragRowCacheLine_t* line = RowCacheGetLine( row, size, false );
+    memcpy( line->Data, src, size );
+    line->Dirty = true;
+#else
+    WriteRowToFile( src, row, size );
+#endif
+}
+
+static void GetRow( uint8_t* dst, uint16_t row, uint16_t size )
+{
+#if( FRAG_ROW_CACHE_NB > 0 )
+    FragRowCacheLine_t* line = RowCacheGetLine( row, size, true );
+    memcpy( dst, line->Data, size );
+#else
+    ReadRowFromFile( dst, row, size );
+#endif
+}
+
+static int8_t WriteRowToFile( uint8_t* src, uint16_t row, uint16_t size )
 {
     if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderWrite != NULL ) )
     {
-        FragDecoder.Callbacks->FragDecoderWrite( row * size, src, size );
+        return FragDecoder.Callbacks->FragDecoderWrite( row * size, src, size );
     }
+    return -1;
 }
 
-static void GetRow( uint8_t* dst, uint16_t row, uint16_t size )
+static void ReadRowFromFile( uint8_t* dst, uint16_t row, uint16_t size )
 {
     if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderRead != NULL ) )
     {
@@ -653,6 +998,52 @@ static void GetRow( uint8_t* dst, uint16_t row, uint16_t size )
     }
 }
 
+#if( FRAG_ROW_CACHE_NB > 0 )
+static FragRowCacheLine_t* RowCacheGetLine( uint16_t row, uint16_t size, bool load )
+{
+    FragRowCacheLine_t* victim = &FragDecoder.RowCache[0];
+
+    for( uint8_t i = 0; i < FRAG_ROW_CACHE_NB; i++ )
+    {
+        FragRowCacheLine_t* line = &FragDecoder.RowCache[i];
+
+        if( ( line->Valid == true ) && ( line->Row == row ) )
+        {
+            line->LastUse = ++FragDecoder.RowCacheTick;
+            return line;
+        }
+        // Take a free line first, then the least recently used one
+        if( ( victim->Valid == true ) && ( ( line->Valid == false ) || ( line->LastUse < victim->LastUse ) ) )
+        {
+            victim = line;
+        }
+    }
+
+    RowCacheWriteBack( victim, size );
+    if( load == true )
+    {
+        ReadRowFromFile( victim->Data, row, size );
+    }
+    victim->Row     = row;
+    victim->Valid   = true;
+    victim->Dirty   = false;
+    victim->LastUse = ++FragDecoder.RowCacheTick;
+    return victim;
+}
+
+static void RowCacheWriteBack( FragRowCacheLine_t* line, uint16_t size )
+{
+    if( ( line->Valid == true ) && ( line->Dirty == true ) )
+    {
+        if( WriteRowToFile( line->Data, line->Row, size ) != 0 )
+        {
+            FragDecoder.RowCacheWriteError = true;
+        }
+        line->Dirty = false;
+    }
+}
+#endif
+
 STATIC uint8_t GetParity( uint16_t index, uint8_t* matrixRow )
 {
     uint8_t parity;
@@ -670,32 +1061,45 @@ STATIC void SetParity( uint16_t index, uint8_t* matrixRow, uint8_t parity )
 
 static bool IsPowerOfTwo( uint32_t x )
 {
-    uint8_t sumBit = 0;
+    // A power of two has a single bit set, clearing the lowest one leaves 0
+    return ( x != 0 ) && ( ( x & ( x - 1 ) ) == 0 );
+}
+
+static void XorDataLine( uint8_t* line1, const uint8_t* line2, int32_t size )
+{
+    int32_t i = 0;
 
-    for( uint8_t i = 0; i < 32; i++ )
+#if defined( __SSE2__ )
+    for( ; ( i + 16 ) <= size; i += 16 )
     {
-        sumBit += ( x & ( 1 << i ) ) >> i;
+        __m128i word1 = _mm_loadu_si128( ( const __m128i* ) &line1[i] );
+        __m128i word2 = _mm_loadu_si128( ( const __m128i* ) &line2[i] );
+        _mm_storeu_si128( ( __m128i* ) &line1[i], _mm_xor_si128( word1, word2 ) );
     }
-    if( sumBit == 1 )
+#endif
+    // Rows come from the file callbacks and the radio buffer, go through memcpy to stay unaligned-safe
+    for( ; ( i + 4 ) <= size; i += 4 )
     {
-        return true;
+        uint32_t word1;
+        uint32_t word2;
+        memcpy( &word1, &line1[i], sizeof( word1 ) );
+        memcpy( &word2, &line2[i], sizeof( word2 ) );
+        word1 ^= word2;
+        memcpy( &line1[i], &word1, sizeof( word1 ) );
     }
-    return false;
-}
-
-static void XorDataLine( uint8_t* line1, uint8_t* line2, int32_t size )
-{
-    for( int32_t i = 0; i < size; i++ )
+    for( ; i < size; i++ )
     {
         line1[i] = line1[i] ^ line2[i];
     }
 }
 
-static void XorParityLine( uint8_t* line1, uint8_t* line2, int32_t size )
+static void XorParityLine( uint8_t* line1, const uint8_t* line2, int32_t size )
 {
-    for( int32_t i = 0; i < size; i++ )
+    XorDataLine( line1, line2, size >> 3 );
+    if( ( size & 0x07 ) != 0 )
     {
-        SetParity( i, line1, ( GetParity( i, line1 ) ^ GetParity( i, line2 ) ) );
+        uint8_t mask = ( uint8_t ) ( 0xFF << ( 8 - ( size & 0x07 ) ) );
+        line1[size >> 3] ^= line2[size >> 3] & mask;
     }
 }
 
@@ -709,10 +1113,12 @@ static int32_t FragPrbs23( int32_t value )
 
 STATIC void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
 {
-    int32_t mTemp;
-    int32_t x;
-    int32_t nbCoeff = 0;
-    int32_t r;
+    int32_t  mTemp;
+    int32_t  x;
+    int32_t  nbCoeff = 0;
+    int32_t  r;
+    uint32_t modulo;
+    uint32_t reciprocal;
 
     if( IsPowerOfTwo( m ) != false )
     {
@@ -723,6 +1129,11 @@ STATIC void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
         mTemp = 0;
     }
 
+    // x % modulo without a division per draw: the quotient estimated with floor( ( 2^32 - 1 ) / modulo )
+    // is the exact one or one less as long as x < 2^31, which holds for the PRBS23 values
+    modulo     = ( uint32_t ) ( m + mTemp );
+    reciprocal = 0xFFFFFFFFUL / modulo;
+
     x = 1 + ( 1001 * n );
     for( uint32_t i = 0; i < ( ( m >> 3 ) + 1 ); i++ )
     {
@@ -733,8 +1144,15 @@ STATIC void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
         r = 1 << 16;
         while( r >= m )
         {
-            x = FragPrbs23( x );
-            r = x % ( m + mTemp );
+            uint32_t remainder;
+
+            x         = FragPrbs23( x );
+            remainder = ( uint32_t ) x - ( uint32_t ) ( ( ( uint64_t ) ( uint32_t ) x * reciprocal ) >> 32 ) * modulo;
+            if( remainder >= modulo )
+            {
+                remainder -= modulo;
+            }
+            r = ( int32_t ) remainder;
         }
         if( GetParity( r, matrixRow ) == 0 )
         {
@@ -744,28 +1162,52 @@ STATIC void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
     }
 }
 
-static uint16_t BitArrayFindFirstOne( uint8_t* bitArray, uint16_t size )
+static uint32_t BitArrayLoadWord( const uint8_t* bitArray )
 {
-    for( uint16_t i = 0; i < size; i++ )
+    return ( ( uint32_t ) bitArray[0] << 24 ) | ( ( uint32_t ) bitArray[1] << 16 ) |
+           ( ( uint32_t ) bitArray[2] << 8 ) | ( uint32_t ) bitArray[3];
+}
+
+static uint16_t BitArrayFindNextOne( const uint8_t* bitArray, uint16_t start, uint16_t size )
+{
+    uint16_t i = start;
+
+    while( i < size )
     {
-        if( GetParity( i, bitArray ) == 1 )
+        if( ( ( i & 0x07 ) == 0 ) && ( ( size - i ) >= 32 ) )
         {
-            return i;
+            // Whole word inside the array: skip 32 zeros at once
+            uint32_t word = BitArrayLoadWord( &bitArray[i >> 3] );
+            if( word != 0 )
+            {
+                return i + __builtin_clz( word );
+            }
+            i += 32;
+        }
+        else
+        {
+            // Partial byte at the head or the tail of the search
+            uint8_t byte = bitArray[i >> 3] & ( 0xFF >> ( i & 0x07 ) );
+            if( byte != 0 )
+            {
+                uint16_t one = ( i & ~0x07 ) + ( __builtin_clz( byte ) - 24 );
+                return ( one < size ) ? one : size;
+            }
+            i = ( i | 0x07 ) + 1;
         }
     }
-    return 0;
+    return size;
+}
+
+static uint16_t BitArrayFindFirstOne( uint8_t* bitArray, uint16_t size )
+{
+    uint16_t index = BitArrayFindNextOne( bitArray, 0, size );
+    return ( index < size ) ? index : 0;
 }
 
 static uint8_t BitArrayIsAllZeros( uint8_t* bitArray, uint16_t size )
 {
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        if( GetParity( i, bitArray ) == 1 )
-        {
-            return 0;
-        }
-    }
-    return 1;
+    return ( BitArrayFindNextOne( bitArray, 0, size ) == size ) ? 1 : 0;
 }
 
 /*!
@@ -784,7 +1226,11 @@ static void FragFindMissingFrags( uint16_t counter )
             SMTC_MODEM_HAL_TRACE_INFO( "Fragment %d is missing, store it at index %d\n", i + 1, i );
             SetParity( i, FragDecoder.FragMissing, 1 );
             // Nth missing fragment is number i+1 (we keep the 0-indexed value)
-            FragDecoder.FragMissingIndex[FragDecoder.Status.FragNbLost] = i;
+            // Past MaxLoss the session is aborted by the caller, only keep counting
+            if( FragDecoder.Status.FragNbLost < FragDecoder.MaxLoss )
+            {
+                FragDecoder.FragMissingIndex[FragDecoder.Status.FragNbLost] = i;
+            }
             FragDecoder.Status.FragNbLost++;
         }
     }
@@ -806,7 +1252,7 @@ static void FragFindMissingFrags( uint16_t counter )
 /*!
  * \brief Finds the index (frag counter) of the x th missing frag
  *
- * \param [IN] x   x th missing frag. Max FRAG_MAX_FRAME_LOSS
+ * \param [IN] x   x th missing frag. Max FragDecoder.MaxLoss
  *
  * \retval counter The counter value associated to the x th missing frag
  */
@@ -822,7 +1268,7 @@ static uint16_t FragFindMissingIndex( uint16_t x )
  * \param [IN] fragCounter      Number of the missing fragment (1-indexed)
  *
  * \retval index    The index of the missing fragment in the small matrix. (0-indexed)
- *                  If the index is not found, FRAG_MAX_FRAME_LOSS is returned
+ *                  If the index is not found, FragDecoder.MaxLoss is returned
  *                  to indicate an error, and the caller should check this condition.
  */
 static uint16_t FragFindMissing( uint16_t fragCounter )
@@ -834,7 +1280,7 @@ static uint16_t FragFindMissing( uint16_t fragCounter )
             return i;
         }
     }
-    return FRAG_MAX_FRAME_LOSS;
+    return FragDecoder.MaxLoss;
 }
 
 /*!
@@ -843,18 +1289,19 @@ static uint16_t FragFindMissing( uint16_t fragCounter )
  * of the triangle are 0.
  *
  * \param [OUT] bitArray  Pointer to the bit array
- * \param [IN] rowIndex  Matrix row index           Max FRAG_MAX_FRAME_LOSS
- * \param [IN] bitsInRow Number of bits in one row. Max FRAG_MAX_FRAME_LOSS
+ * \param [IN] rowIndex  Matrix row index           Max FragDecoder.MaxLoss
+ * \param [IN] bitsInRow Number of bits in one row. Max FragDecoder.MaxLoss
  */
 STATIC void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow )
 {
     uint32_t findByte      = 0;
     uint32_t findBitInByte = 0;
+    uint8_t* m2b;
 
     if( rowIndex > 0 )
     {
-        findByte      = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) >> 3;
-        findBitInByte = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) % 8;
+        findByte      = M2BLineFirstBit( rowIndex, bitsInRow ) >> 3;
+        findBitInByte = M2BLineFirstBit( rowIndex, bitsInRow ) % 8;
     }
     if( rowIndex > 0 )
     {
@@ -863,9 +1310,15 @@ STATIC void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowInde
             SetParity( i, bitArray, 0 );
         }
     }
+    if( rowIndex >= bitsInRow )
+    {
+        return;
+    }
+    m2b = M2BLoadLine( findByte, BITARRAY_BYTES( findBitInByte + bitsInRow - rowIndex ) );
+    findByte = 0;
     for( uint16_t i = rowIndex; i < bitsInRow; i++ )
     {
-        SetParity( i, bitArray, ( FragDecoder.MatrixM2B[findByte] >> ( 7 - findBitInByte ) ) & 0x01 );
+        SetParity( i, bitArray, ( m2b[findByte] >> ( 7 - findBitInByte ) ) & 0x01 );
 
         findBitInByte++;
         if( findBitInByte == 8 )
@@ -881,28 +1334,38 @@ STATIC void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowInde
  * Only store the triangular sup part of the matrix. All bits left of the triangle are ignored
  *
  * \param [IN] bitArray  Pointer to the bit array
- * \param [IN] rowIndex  Matrix row index.          Max FRAG_MAX_FRAME_LOSS
- * \param [IN] bitsInRow Number of bits in one row. Max FRAG_MAX_FRAME_LOSS
+ * \param [IN] rowIndex  Matrix row index.          Max FragDecoder.MaxLoss
+ * \param [IN] bitsInRow Number of bits in one row. Max FragDecoder.MaxLoss
  */
 STATIC void FragPushLineToBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow )
 {
     uint32_t findByte      = 0;
     uint32_t findBitInByte = 0;
+    uint32_t lineByte;
+    uint32_t lineSize;
+    uint8_t* m2b;
 
     if( rowIndex > 0 )
     {
-        findByte      = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) >> 3;
-        findBitInByte = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) % 8;
+        findByte      = M2BLineFirstBit( rowIndex, bitsInRow ) >> 3;
+        findBitInByte = M2BLineFirstBit( rowIndex, bitsInRow ) % 8;
     }
     SMTC_MODEM_HAL_TRACE_PRINTF( "PushLine row %d nb_bits %d | findByte %d bitInByte %d\n", rowIndex, bitsInRow,
                                  findByte, findBitInByte );
 
+    if( rowIndex >= bitsInRow )
+    {
+        return;
+    }
+    lineByte = findByte;
+    lineSize = BITARRAY_BYTES( findBitInByte + bitsInRow - rowIndex );
+    m2b      = M2BLoadLine( lineByte, lineSize );
+    findByte = 0;
     for( uint16_t i = rowIndex; i < bitsInRow; i++ )
     {
         if( GetParity( i, bitArray ) == 0 )
         {
-            FragDecoder.MatrixM2B[findByte] =
-                FragDecoder.MatrixM2B[findByte] & ( 0xFF - ( 1 << ( 7 - findBitInByte ) ) );
+            m2b[findByte] = m2b[findByte] & ( 0xFF - ( 1 << ( 7 - findBitInByte ) ) );
         }
         findBitInByte++;
         if( findBitInByte == 8 )
@@ -911,5 +1374,35 @@ STATIC void FragPushLineToBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, ui
             findByte++;
         }
     }
+    M2BStoreLine( lineByte, lineSize );
     PARITY_ARRAY_PRINT( "M2B", FragDecoder.MatrixM2B, bitsInRow, bitsInRow );
 }
+
+static uint32_t M2BLineFirstBit( uint16_t rowIndex, uint16_t bitsInRow )
+{
+    return ( ( uint32_t ) rowIndex * bitsInRow ) - ( ( ( uint32_t ) rowIndex * ( rowIndex - 1 ) ) >> 1 );
+}
+
+static uint8_t* M2BLoadLine( uint32_t firstByte, uint32_t size )
+{
+    if( FragDecoder.M2BSpilled == false )
+    {
+        return &FragDecoder.MatrixM2B[firstByte];
+    }
+    if( FragDecoder.Callbacks->FragDecoderMatrixRead( firstByte, FragDecoder.MatrixM2B, size ) != 0 )
+    {
+        smtc_modem_hal_mcu_panic( "FRAG parity matrix read failed at %u\n", firstByte );
+    }
+    return FragDecoder.MatrixM2B;
+}
+
+static void M2BStoreLine( uint32_t firstByte, uint32_t size )
+{
+    if( FragDecoder.M2BSpilled == true )
+    {
+        if( FragDecoder.Callbacks->FragDecoderMatrixWrite( firstByte, FragDecoder.MatrixM2B, size ) != 0 )
+        {
+            smtc_modem_hal_mcu_panic( "FRAG parity matrix write failed at %u\n", firstByte );
+        }
+    }
+}
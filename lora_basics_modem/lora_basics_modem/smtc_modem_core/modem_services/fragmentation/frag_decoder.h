@@ -40,21 +40,23 @@
 #include <errno.h>
 
 /*
- * The following parameters have an impact on the memory footprint.
+ * The working memory of a session (parity matrix, missing fragment index and bit arrays) is taken
+ * from an arena given to FragDecoderInitArena, see FRAG_DECODER_ARENA_SIZE.
+ * FragDecoderInit uses a static arena sized for FRAG_MAX_NB and FRAG_MAX_FRAME_LOSS.
  * The major contributors are the parity matrix and missing fragment index.
  *
- * Heap size >=   FRAG_MAX_FRAME_LOSS * (FRAG_MAX_FRAME_LOSS + 1) / 2 / 8
- *              + 2 * FRAG_MAX_FRAME_LOSS
- *              + FRAG_MAX_NB / 8
+ * Arena size >=   maxLoss * (maxLoss + 1) / 2 / 8   (or maxLoss / 8 when the matrix is spilled)
+ *               + 2 * maxLoss
+ *               + 2 * fragNb / 8
  *
- * Stack size >= FRAG_MAX_NB
+ * Stack size >= 2 * FRAG_MAX_SIZE
  */
 
 /*!
- * Maximum number of uncoded fragment that can be handled.
+ * Maximum number of uncoded fragment that can be handled by FragDecoderInit.
  *
  * \remark This parameter has an impact on the heap memory footprint.
- *         It defines the size of the bitarray of missing fragments.
+ *         It defines the size of the bitarray of missing fragments of the static arena.
  */
 #define FRAG_MAX_NB 150
 
@@ -67,14 +69,61 @@
 #define FRAG_MAX_SIZE 200
 
 /*!
- * Maximum number of uncoded fragments that can be lost.
+ * Maximum number of uncoded fragments that can be lost with FragDecoderInit.
  * This determines the resistance of the algorithm wrt. packet loss
  *
  * \remark This parameter has an impact on the heap memory footprint.
- *         It defines the size of the parity matrix and of the missing fragment index array.
+ *         It defines the size of the parity matrix and of the missing fragment index array of the static arena.
  */
 #define FRAG_MAX_FRAME_LOSS 64
 
+/*!
+ * Number of parity matrix rows precomputed when a session is set up, for the coded fragments
+ * FragNb + 1 to FragNb + FRAG_PARITY_ROW_CACHE_NB. Later coded fragments get their row generated
+ * on reception. 0 disables the precomputation.
+ *
+ * \remark This parameter has an impact on the arena footprint:
+ *         FRAG_PARITY_ROW_CACHE_NB * ( ( fragNb >> 3 ) + 1 ) bytes.
+ */
+#ifndef FRAG_PARITY_ROW_CACHE_NB
+#define FRAG_PARITY_ROW_CACHE_NB 16
+#endif
+
+/*!
+ * Number of bytes of the arena needed by a session of fragNb uncoded fragments tolerating maxLoss losses.
+ * When spillMatrix is true, the parity matrix lives behind the FragDecoderMatrixWrite/Read callbacks
+ * and the arena only holds one of its rows.
+ */
+#define FRAG_DECODER_ARENA_SIZE( fragNb, maxLoss, spillMatrix )                                        \
+    ( 1 + ( 2 * ( uint32_t ) ( maxLoss ) ) + ( ( ( uint32_t ) ( fragNb ) + 7 ) >> 3 ) +                \
+      ( ( 1 + FRAG_PARITY_ROW_CACHE_NB ) * ( ( ( uint32_t ) ( fragNb ) >> 3 ) + 1 ) ) +                \
+      ( ( ( uint32_t ) ( maxLoss ) + 7 ) >> 3 ) +                                                      \
+      ( 2 * ( ( ( uint32_t ) ( maxLoss ) >> 3 ) + 1 ) ) +                                              \
+      ( ( spillMatrix ) ? ( ( ( uint32_t ) ( maxLoss ) >> 3 ) + 2 )                                     \
+                        : ( ( ( ( ( uint32_t ) ( maxLoss ) * ( ( uint32_t ) ( maxLoss ) + 1 ) ) >> 1 ) + 7 ) >> 3 ) ) )
+
+/*!
+ * Number of fragment rows kept in RAM in front of the Write/Read callbacks.
+ * Rows are written back to the callbacks when evicted (least recently used first)
+ * or when the session is flushed. 0 disables the cache.
+ *
+ * \remark This parameter has an impact on the heap memory footprint:
+ *         FRAG_ROW_CACHE_NB * FRAG_MAX_SIZE bytes.
+ */
+#ifndef FRAG_ROW_CACHE_NB
+#define FRAG_ROW_CACHE_NB 8
+#endif
+
+/*!
+ * Maximum number of row operations (one row read and XORed, or one row solved) done by a single call
+ * to FragDecoderProcess or FragDecoderContinue during the final back-substitution.
+ * The back-substitution needs up to FragNbLost^2 / 2 row operations, when the budget is exhausted
+ * the call returns FRAG_SESSION_RECONSTRUCTING and the next call resumes it. 0 disables the limit.
+ */
+#ifndef FRAG_BACKSUB_BUDGET
+#define FRAG_BACKSUB_BUDGET 32
+#endif
+
 /*!
  * \brief This return code indicates the state of the session
  */
@@ -86,6 +135,7 @@ typedef enum
     FRAG_SESSION_BADSIZE,
     FRAG_SESSION_ABORT,
     FRAG_SESSION_MEM_ERROR,
+    FRAG_SESSION_RECONSTRUCTING,  //!< Enough fragments received, call FragDecoderContinue until FRAG_SESSION_OK
 } FragDecoderSessionStatus_t;
 
 /*!
@@ -125,6 +175,29 @@ typedef struct sFragDecoderCallbacks
      * \retval status Read operation status [0: Success, -1 Fail]
      */
     int8_t ( *FragDecoderRead )( uint32_t addr, uint8_t* data, uint32_t size );
+    /*!
+     * Optional: writes `data` buffer of `size` starting at byte `addr` of the parity matrix.
+     * When both matrix callbacks are set, the parity matrix is spilled out of the arena.
+     * The decoder only ever clears bits of the matrix after filling it with 0xFF at init,
+     * so flash can be programmed in place without erasing.
+     *
+     * \param [IN] addr Byte index in the parity matrix to write to.
+     * \param [IN] data Data buffer to be written.
+     * \param [IN] size Size of data buffer to be written.
+     *
+     * \retval status Write operation status [0: Success, -1 Fail]
+     */
+    int8_t ( *FragDecoderMatrixWrite )( uint32_t addr, uint8_t* data, uint32_t size );
+    /*!
+     * Optional: reads `data` buffer of `size` starting at byte `addr` of the parity matrix.
+     *
+     * \param [IN] addr Byte index in the parity matrix to read from.
+     * \param [OUT] data Data buffer to be read.
+     * \param [IN] size Size of data buffer to be read.
+     *
+     * \retval status Read operation status [0: Success, -1 Fail]
+     */
+    int8_t ( *FragDecoderMatrixRead )( uint32_t addr, uint8_t* data, uint32_t size );
 } FragDecoderCallbacks_t;
 
 /*!
@@ -135,8 +208,22 @@ typedef struct sFragDecoderCallbacks
  * \param [IN] callbacks  Pointer to the Write/Read functions.
  */
 int32_t FragDecoderInit( uint16_t fragNb, uint8_t fragSize, FragDecoderCallbacks_t* callbacks );
+
+/*!
+ * \brief Initializes the fragmentation decoder with a caller provided working memory
+ *
+ * \param [IN] fragNb     Number of expected fragments (without redundancy packets)
+ * \param [IN] fragSize   Size of a fragment, at most FRAG_MAX_SIZE
+ * \param [IN] maxLoss    Number of uncoded fragments that can be lost
+ * \param [IN] callbacks  Pointer to the Write/Read functions, and optionally to the matrix ones.
+ * \param [IN] arena      Working memory, must stay valid for the whole session
+ * \param [IN] arenaSize  Size of the arena, at least FRAG_DECODER_ARENA_SIZE( fragNb, maxLoss, spill )
+ */
+int32_t FragDecoderInitArena( uint16_t fragNb, uint8_t fragSize, uint16_t maxLoss, FragDecoderCallbacks_t* callbacks,
+                              uint8_t* arena, uint32_t arenaSize );
 /*!
- * \brief Gets the maximum file size that can be received
+ * \brief Gets the maximum file size that can be received with the working memory and the loss tolerance of the
+ *        current session
  *
  * \retval size FileSize
  */
@@ -161,6 +248,15 @@ uint32_t FragDecoderFileSize( void );
  */
 FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData );
 
+/*!
+ * \brief Runs the next FRAG_BACKSUB_BUDGET row operations of the data block reconstruction
+ *        Fragments given to FragDecoderProcess meanwhile are not needed anymore and only make it go on.
+ *
+ * \retval status FRAG_SESSION_RECONSTRUCTING while not done, FRAG_SESSION_OK once the data block is
+ *                reconstructed and flushed, FRAG_SESSION_ONGOING if no reconstruction is pending
+ */
+FragDecoderSessionStatus_t FragDecoderContinue( void );
+
 /*!
  * \brief Gets the current fragmentation status
  *
@@ -168,6 +264,16 @@ FragDecoderSessionStatus_t FragDecoderProcess( uint16_t fragCounter, uint8_t* ra
  */
 FragDecoderStatus_t FragDecoderGetStatus( void );
 
+/*!
+ * \brief Writes back all the modified rows held by the row cache
+ *
+ * \remark FragDecoderProcess already flushes before returning FRAG_SESSION_OK,
+ *         call it before reading the file through the callbacks in any other case.
+ *
+ * \retval status FRAG_SESSION_OK, or FRAG_SESSION_MEM_ERROR if a Write callback failed
+ */
+FragDecoderSessionStatus_t FragDecoderFlush( void );
+
 #if defined( TEST )
 // This is only accessible during unit testing.
 
@@ -166,6 +166,8 @@ static const char* frag_cmd_str[FRAG_CMD_MAX] = {
 
 static uint8_t        frag_tx_payload[FRAG_UPLINK_LENGTH_MAX];
 static e_file_error_t check_received_patch( void );
+static void           frag_handle_decoder_status( FragDecoderSessionStatus_t rc );
+static bool           frag_prepare_data_block_received( void );
 struct
 {
     // Uplink buffer
@@ -182,6 +184,7 @@ struct
     // Current fragmentation status
     bool     is_frag_session_exist;
     bool     is_data_block_reconstructed;
+    bool     is_data_block_reconstructing;  // enough fragments received, back-substitution still running
     bool     is_data_block_mic_success;
     bool     is_data_block_sign_success;
     bool     is_data_block_crc_fw_success;
@@ -205,6 +208,7 @@ struct
 
 #define is_frag_session_exist frag_context.is_frag_session_exist
 #define is_data_block_reconstructed frag_context.is_data_block_reconstructed
+#define is_data_block_reconstructing frag_context.is_data_block_reconstructing
 #define is_data_block_mic_success frag_context.is_data_block_mic_success
 #define is_data_block_sign_success frag_context.is_data_block_sign_success
 #define is_data_block_crc_fw_success frag_context.is_data_block_crc_fw_success
@@ -230,6 +234,7 @@ struct
 void frag_context_reset( void )
 {
     is_data_block_reconstructed  = false;
+    is_data_block_reconstructing = false;
     is_data_block_mic_success    = false;
     is_data_block_sign_success   = false;
     is_data_block_crc_fw_success = false;
@@ -345,12 +350,16 @@ static FragDecoderCallbacks_t frag_decoder_callbacks = {
     .FragDecoderRead  = frag_decoder_read_fl,
 };
 
+// Working memory of the frag_decoder session
+static uint8_t frag_decoder_arena[FRAG_SESSION_ARENA_SIZE];
+
 void frag_session_print( void )
 {
 #if MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON
     SMTC_MODEM_HAL_TRACE_INFO( "------ Current Frag Session context -------\n" );
     SMTC_MODEM_HAL_TRACE_INFO( "  session exist: %d\n", is_frag_session_exist );
     SMTC_MODEM_HAL_TRACE_INFO( "  reconstructed: %d\n", is_data_block_reconstructed );
+    SMTC_MODEM_HAL_TRACE_INFO( "  reconstructing: %d\n", is_data_block_reconstructing );
     SMTC_MODEM_HAL_TRACE_INFO( "  MIC success: %d\n", is_data_block_mic_success );
     SMTC_MODEM_HAL_TRACE_INFO( "  SIGN success: %d\n", is_data_block_sign_success );
     SMTC_MODEM_HAL_TRACE_INFO( "  CRC_FW success: %d\n", is_data_block_crc_fw_success );
@@ -598,6 +607,22 @@ STATIC int8_t frag_process_data_fragment( uint8_t* buffer, uint8_t buffer_len )
     // The decoder rejects 'old' fragments, if their frag_n precede the latest received.
     rc = FragDecoderProcess( frag_n, &buffer[2] );
     SMTC_MODEM_HAL_TRACE_PRINTF( "Fragment %d FragDecoderProcess rc %d\n", frag_n, rc );
+    frag_handle_decoder_status( rc );
+
+    frag_session_print( );
+
+    return FRAG_OK;
+}
+
+/*!
+ * \brief Updates the session status with a result of the fragmentation decoder
+ *
+ * \param [IN] rc Value returned by FragDecoderProcess or FragDecoderContinue
+ */
+static void frag_handle_decoder_status( FragDecoderSessionStatus_t rc )
+{
+    is_data_block_reconstructing = ( rc == FRAG_SESSION_RECONSTRUCTING );
+
     if( rc == FRAG_SESSION_OK )
     {
         SMTC_MODEM_HAL_TRACE_INFO( "SUCCESS: FragDecoder reconstructed the full data, no need for more fragments\n" );
@@ -622,6 +647,10 @@ STATIC int8_t frag_process_data_fragment( uint8_t* buffer, uint8_t buffer_len )
             // All is well, decoder is waiting for additional fragments
             SMTC_MODEM_HAL_TRACE_INFO( "FRAG: Waiting for more fragments\n" );
             break;
+        case FRAG_SESSION_RECONSTRUCTING:
+            // All fragments needed are there, frag_reconstruction_step runs the rest of the reconstruction
+            SMTC_MODEM_HAL_TRACE_INFO( "FRAG: Reconstructing the data block\n" );
+            break;
         case FRAG_SESSION_ABORT:
             // Lost too many fragments
             SMTC_MODEM_HAL_TRACE_ERROR( "FRAG: Lost too many fragments to be able to reconstruct\n" );
@@ -635,10 +664,32 @@ STATIC int8_t frag_process_data_fragment( uint8_t* buffer, uint8_t buffer_len )
             break;
         }
     }
+}
 
-    frag_session_print( );
-
-    return FRAG_OK;
+/*!
+ * \brief Queues the DataBlockReceived request once the data block is reconstructed, if the session asks for it
+ *
+ * \retval queued true if the request was added to frag_req_status
+ */
+static bool frag_prepare_data_block_received( void )
+{
+    if( ( is_data_block_reconstructed == true ) && ( frag_session_setup_req.control.ack_reception == 0x01 ) &&
+        ( is_ack_reception_done == false ) )
+    {
+        SMTC_MODEM_HAL_TRACE_WARNING( "Preparing BLOCK_RECEIVED\n" );
+        // at this point we will verify the received file , ancm
+        if( check_received_patch( ) > 0 )
+        {
+            SMTC_MODEM_HAL_TRACE_WARNING( "file is valid!!\n" );
+            frag_req_status[frag_req_status_num++] = FRAG_CMD_FRAG_DATA_BLOCK_RECEIVED;
+        }
+        else
+            SMTC_MODEM_HAL_TRACE_WARNING( "file is not valid!!\n" );
+        // create the uplink with data block received for das aknownledge
+        frag_req_status[frag_req_status_num++] = FRAG_CMD_FRAG_DATA_BLOCK_RECEIVED;
+        return true;
+    }
+    return false;
 }
 
 e_descriptor_error_t frag_session_parse_descriptor( uint32_t descriptor )
@@ -683,6 +734,7 @@ void frag_init( void )
     // Initialize fragmentation session context variables
     is_frag_session_exist        = false;
     is_data_block_reconstructed  = false;
+    is_data_block_reconstructing = false;
     is_data_block_mic_success    = false;
     is_data_block_sign_success   = false;
     is_data_block_crc_fw_success = false;
@@ -913,22 +965,7 @@ int8_t frag_parser( uint8_t* frag_buffer, uint8_t frag_buffer_len )
             if( ( frag_rx_buffer_index == 0 ) && ( frag_buffer_len == frag_session_setup_req.frag_size + 3 ) )
             {
                 frag_process_data_fragment( &frag_buffer[frag_rx_buffer_index + 1], frag_buffer_len - 1 );
-                if( ( is_data_block_reconstructed == true ) &&
-                    ( frag_session_setup_req.control.ack_reception == 0x01 ) && ( is_ack_reception_done == false ) )
-                {
-                    SMTC_MODEM_HAL_TRACE_WARNING( "Preparing BLOCK_RECEIVED\n" );
-                    // at this point we will verify the received file , ancm
-                    if( check_received_patch( ) > 0 )
-                    {
-                        SMTC_MODEM_HAL_TRACE_WARNING( "file is valid!!\n" );
-                        frag_req_status[frag_req_status_num++] = FRAG_CMD_FRAG_DATA_BLOCK_RECEIVED;
-                    }
-                    else
-                        SMTC_MODEM_HAL_TRACE_WARNING( "file is not valid!!\n" );
-                    // create the uplink with data block received for das aknownledge
-                    frag_req_status[frag_req_status_num++] = FRAG_CMD_FRAG_DATA_BLOCK_RECEIVED;
-                }
-                else
+                if( frag_prepare_data_block_received( ) == false )
                 {
                     frag_req_status_num = 0;
                 }
@@ -998,6 +1035,32 @@ int8_t frag_parser( uint8_t* frag_buffer, uint8_t frag_buffer_len )
     return ( int8_t ) frag_req_status_num;
 }
 
+bool frag_is_reconstructing( void )
+{
+    return is_data_block_reconstructing;
+}
+
+int8_t frag_reconstruction_step( void )
+{
+    if( is_data_block_reconstructing == false )
+    {
+        return 0;
+    }
+
+    frag_handle_decoder_status( FragDecoderContinue( ) );
+    if( is_data_block_reconstructing == true )
+    {
+        return 0;
+    }
+
+    frag_session_print( );
+    if( frag_prepare_data_block_received( ) == false )
+    {
+        return 0;
+    }
+    return ( int8_t ) frag_req_status_num;
+}
+
 void frag_set_max_length_up_payload( uint8_t max_payload )
 {
     frag_max_length_up_payload = max_payload;
@@ -1131,8 +1194,9 @@ void frag_construct_frag_session_status_answer( void )
 
 void frag_construct_frag_session_setup_answer( void )
 {
-    int32_t rc;  // FragDecoder return code
-    uint8_t frag_session_setup_ans = 0x0;
+    int32_t  rc;  // FragDecoder return code
+    uint8_t  frag_session_setup_ans = 0x0;
+    uint16_t max_loss;
 
     uint32_t tmp;
 
@@ -1176,6 +1240,15 @@ void frag_construct_frag_session_setup_answer( void )
         frag_session_setup_ans |= ( 1 << FRAG_SESSION_SETUP_NO_MEMORY );
     }
 
+    // Check that the decoder can handle the fragments within its working memory
+    max_loss = MIN( frag_session_setup_req.nb_frag, FRAG_SESSION_MAX_FRAME_LOSS );
+    if( ( frag_session_setup_req.frag_size > FRAG_MAX_SIZE ) ||
+        ( FRAG_DECODER_ARENA_SIZE( frag_session_setup_req.nb_frag, max_loss, false ) > sizeof( frag_decoder_arena ) ) )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "FragSessionSetup: Not enough decoder memory\n" );
+        frag_session_setup_ans |= ( 1 << FRAG_SESSION_SETUP_NO_MEMORY );
+    }
+
     if( frag_session_setup_req.control.frag_algo != 0 )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "FragSessionSetup: FragAlgo unsupported\n" );
@@ -1224,8 +1297,8 @@ void frag_construct_frag_session_setup_answer( void )
 
         // Initialize underlying frag_decoder
 
-        rc = FragDecoderInit( frag_session_setup_req.nb_frag, frag_session_setup_req.frag_size,
-                              &frag_decoder_callbacks );
+        rc = FragDecoderInitArena( frag_session_setup_req.nb_frag, frag_session_setup_req.frag_size, max_loss,
+                                   &frag_decoder_callbacks, frag_decoder_arena, sizeof( frag_decoder_arena ) );
         switch( rc )
         {
         case FRAG_SESSION_ERROR:
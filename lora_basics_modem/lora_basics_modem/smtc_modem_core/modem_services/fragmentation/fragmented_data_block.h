@@ -104,7 +104,25 @@ extern "C" {
 #define FRAG_RECEIVED_DATA_BLOC_SIGN_ERROR 6
 #define FRAG_RECEIVED_DATA_BLOC_CRC_FW_ERROR 7
 
+#ifndef FRAG_DATA_BLOCK_SIZE_MAX
 #define FRAG_DATA_BLOCK_SIZE_MAX ( 30 * 1024 )  // Target 30KB: TODO refine actual space available for defrag
+#endif
+
+// Number of uncoded fragments a session can lose, capped by the number of fragments of the session
+#ifndef FRAG_SESSION_MAX_FRAME_LOSS
+#define FRAG_SESSION_MAX_FRAME_LOSS FRAG_MAX_FRAME_LOSS
+#endif
+
+// Number of uncoded fragments the decoder working memory is sized for by default (30KB in 60 bytes fragments)
+#ifndef FRAG_SESSION_NB_FRAG_MAX
+#define FRAG_SESSION_NB_FRAG_MAX ( 512 )
+#endif
+
+// Decoder working memory, a session is refused when FRAG_DECODER_ARENA_SIZE of its parameters does not fit in it
+#ifndef FRAG_SESSION_ARENA_SIZE
+#define FRAG_SESSION_ARENA_SIZE \
+    FRAG_DECODER_ARENA_SIZE( FRAG_SESSION_NB_FRAG_MAX, FRAG_SESSION_MAX_FRAME_LOSS, false )
+#endif
 #define FLASH_BASE ( uint32_t ) 0x80000
 #define FLASH_DELTA_UPDATE ( uint32_t ) 0xB6800
 
@@ -164,6 +182,20 @@ void frag_init( void );
 
 int8_t frag_parser( uint8_t* frag_buffer, uint8_t frag_buffer_len );
 
+/*!
+ * \brief Tells if a data block reconstruction is waiting for frag_reconstruction_step calls
+ *
+ * \retval reconstructing true while the back-substitution of the decoder is not done
+ */
+bool frag_is_reconstructing( void );
+
+/*!
+ * \brief Runs the next bounded chunk (FRAG_BACKSUB_BUDGET) of the data block reconstruction
+ *
+ * \retval nb_req Number of requests to uplink once the data block is reconstructed, 0 otherwise
+ */
+int8_t frag_reconstruction_step( void );
+
 void frag_construct_package_version_answer( void );
 void frag_construct_frag_session_status_answer( void );
 void frag_construct_frag_session_setup_answer( void );
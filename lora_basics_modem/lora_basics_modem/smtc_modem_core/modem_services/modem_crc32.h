@@ -0,0 +1,114 @@
+/*!
+ * \file      modem_crc32.h
+ *
+ * \brief     CRC32 shared by the modem contexts and the firmware image checks
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MODEM_CRC32_H__
+#define __MODEM_CRC32_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stdint.h>  // C99 types
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * Select the slice-by-8 implementation (8 KB of tables in flash), 0 keeps the byte-wise one (1 KB of table)
+ */
+#ifndef MODEM_CRC32_SLICE_BY_8
+#define MODEM_CRC32_SLICE_BY_8 1
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Register value to start a crc computation with modem_crc32_update
+ */
+#define MODEM_CRC32_INIT 0xFFFFFFFFUL
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * \brief   Feed a buffer to a running crc32 ( reflected polynomial 0xEDB88320 )
+ * \remark  The register is neither initialized nor inverted, so that a crc can be computed over several buffers:
+ *          modem_crc32_final( modem_crc32_update( modem_crc32_update( MODEM_CRC32_INIT, a, len_a ), b, len_b ) )
+ *          When the firmware is built with MODEM_HAL_CRC32, smtc_modem_hal_crc32_update is used instead
+ *
+ * \param  [in]     crc             - current register value
+ * \param  [in]     buf*            - input buffer
+ * \param  [in]     len             - input buffer length
+ * \retval [out]    crc             - updated register value
+ */
+uint32_t modem_crc32_update( uint32_t crc, const uint8_t* buf, uint32_t len );
+
+/*!
+ * \brief   Return the crc32 of a register value built with modem_crc32_update
+ *
+ * \param  [in]     crc             - register value
+ * \retval [out]    crc             - crc32
+ */
+static inline uint32_t modem_crc32_final( uint32_t crc )
+{
+    return ~crc;
+}
+
+/*!
+ * \brief   Compute the crc32 of a buffer in one call
+ *
+ * \param  [in]     buf*            - input buffer
+ * \param  [in]     len             - input buffer length
+ * \retval [out]    crc             - computed crc
+ */
+uint32_t modem_crc32( const uint8_t* buf, uint32_t len );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __MODEM_CRC32_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -33,27 +33,14 @@
  */
 
 #include "modem_utilities.h"
+#include "modem_crc32.h"
 
-uint32_t crc( const uint8_t* buf, int len )
-{
-    uint32_t crc = 0xFFFFFFFF;
-    while( len-- > 0 )
-    {
-        crc = crc ^ *buf++;
-        for( int i = 0; i < 8; i++ )
-        {
-            uint32_t mask = -( crc & 1 );
-            crc           = ( crc >> 1 ) ^ ( 0xEDB88320 & mask );
-        }
-    }
-    return ~crc;
-}
 uint32_t compute_crc_fw( void )
 {
 #if defined( LR1110_MODEM_E )
     uint32_t crctmp =
-        crc( ( uint8_t* ) ( START_FLASH_ADRESS ),
-             ( *( uint32_t* ) FLASH_PROG_LEN ) * 4 );  // prog length in word is store in start_fw_flash_address
+        modem_crc32( ( uint8_t* ) ( START_FLASH_ADRESS ),
+                     ( *( uint32_t* ) FLASH_PROG_LEN ) * 4 );  // prog length in word is store in start_fw_flash_address
     return crctmp;
 #else
     return 0;
@@ -58,15 +58,6 @@ extern "C" {
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
-/*!
- * \brief   Compute crc
- * \remark
- *
- * \param  [in]     buf*            - input buffer
- * \param  [in]     len*            - input buffer length
- * \retval [out]    crc             - computed crc
- */
-uint32_t crc( const uint8_t* buf, int len );
 uint8_t  crc8( const uint8_t* data, int length );
 uint32_t compute_crc_fw( void );
 #ifdef __cplusplus
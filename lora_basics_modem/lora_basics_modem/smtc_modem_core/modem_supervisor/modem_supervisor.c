@@ -55,6 +55,7 @@
 #include "radio_planner.h"
 #include "smtc_modem_test_api.h"
 #include "smtc_secure_element.h"
+#include "smtc_modem_ctx.h"
 
 // services
 #if defined( ADD_SMTC_FILE_UPLOAD )
@@ -93,111 +94,6 @@
  */
 #define ABS( N ) ( ( N < 0 ) ? ( -N ) : ( N ) )
 
-/*
- * -----------------------------------------------------------------------------
- * --- PRIVATE VARIABLES -------------------------------------------------------
- */
-
-#if !defined( LR1110_MODEM_E )
-static lr1mac_states_t LpState = LWPSTATE_IDLE;
-static stask_manager   task_manager;
-static bool            is_pending_dm_status_payload_periodic = false;
-static bool            is_pending_dm_status_payload_now      = false;
-static bool            is_first_dm_after_join                = true;
-static bool            send_task_update_needed               = false;
-
-static void ( *app_callback )( void ) = NULL;
-
-#if defined( ADD_SMTC_ALC_SYNC )
-static alc_sync_ctx_t*   alc_sync_context   = NULL;
-static clock_sync_ctx_t* clock_sync_context = NULL;
-#endif  // ADD_SMTC_ALC_SYNC
-
-#if defined( ADD_SMTC_STREAM )
-static rose_t* ROSE = NULL;
-#endif  // ADD_SMTC_STREAM
-#if defined( ADD_SMTC_FILE_UPLOAD )
-
-static file_upload_t* file_upload_context = NULL;
-#endif  // ADD_SMTC_FILE_UPLOAD
-
-// Used for LoRaWAN Certification
-static uint8_t user_payload_length           = 10;
-static uint8_t user_payload[242]             = { 0 };
-static uint8_t user_port                     = 1;
-static bool    certification_data_is_pending = false;
-
-// Used for class B
-static bool class_b_bit = false;
-#else
-
-struct
-{
-    lr1mac_states_t LpState;
-    stask_manager   task_manager;
-    bool            is_pending_dm_status_payload_periodic;
-    bool            is_pending_dm_status_payload_now;
-    bool            is_first_dm_after_join;
-    bool            send_task_update_needed;
-    void ( *app_callback )( void );
-
-#if defined( ADD_SMTC_ALC_SYNC )
-    alc_sync_ctx_t*   alc_sync_context;
-    clock_sync_ctx_t* clock_sync_context;
-#endif  // ADD_SMTC_ALC_SYNC
-
-#if defined( ADD_SMTC_STREAM )
-    rose_t*           ROSE;
-#endif  // ADD_SMTC_STREAM
-
-#if defined( ADD_SMTC_FILE_UPLOAD )
-    file_upload_t*    file_upload_context;
-#endif  // ADD_SMTC_FILE_UPLOAD
-
-    // Used for LoRaWAN Certification
-    uint8_t user_payload_length;
-    uint8_t user_payload[242];
-    uint8_t user_port;
-    bool    certification_data_is_pending;
-
-    // Used for class B
-    bool class_b_bit;
-} modem_supervisor_context;
-
-// clang-format off
-#define LpState                                 modem_supervisor_context.LpState
-#define task_manager                            modem_supervisor_context.task_manager
-#define is_pending_dm_status_payload_periodic   modem_supervisor_context.is_pending_dm_status_payload_periodic
-#define is_pending_dm_status_payload_now        modem_supervisor_context.is_pending_dm_status_payload_now
-#define is_first_dm_after_join                  modem_supervisor_context.is_first_dm_after_join
-#define send_task_update_needed                 modem_supervisor_context.send_task_update_needed
-#define app_callback                            modem_supervisor_context.app_callback
-
-#if defined( ADD_SMTC_ALC_SYNC )
-#define alc_sync_context                        modem_supervisor_context.alc_sync_context
-#define clock_sync_context                      modem_supervisor_context.clock_sync_context
-#endif  // ADD_SMTC_ALC_SYNC
-
-#if defined( ADD_SMTC_STREAM )
-#define ROSE                                    modem_supervisor_context.ROSE
-#endif  // ADD_SMTC_STREAM
-
-#if defined( ADD_SMTC_FILE_UPLOAD )
-#define file_upload_context                     modem_supervisor_context.file_upload_context
-#endif  // ADD_SMTC_FILE_UPLOAD
-
-// Used for LoRaWAN Certification
-#define user_payload_length                     modem_supervisor_context.user_payload_length
-#define user_payload                            modem_supervisor_context.user_payload
-#define user_port                               modem_supervisor_context.user_port
-#define certification_data_is_pending           modem_supervisor_context.certification_data_is_pending
-
-// Used for class B
-#define class_b_bit                             modem_supervisor_context.class_b_bit
-
-// clang-format on
-#endif
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -213,6 +109,43 @@ static void check_class_b_to_generate_event( void );
 static void backoff_mobile_static( void );
 static void send_task_update( uint8_t event_type );
 
+/**
+ * @brief remove a task from the timeline and from the ready tasks
+ *
+ * @param id task id
+ */
+static void modem_supervisor_task_unschedule( task_id_t id );
+
+/**
+ * @brief compare the dates of two tasks of the timeline, the lowest id first for a same date
+ *
+ * @param id_a first task id
+ * @param id_b second task id
+ * @return true if task id_a is before task id_b
+ */
+static bool modem_supervisor_timeline_is_before( uint8_t id_a, uint8_t id_b );
+
+/**
+ * @brief restore the timeline order around a position whose date has changed
+ *
+ * @param pos position in the timeline
+ */
+static void modem_supervisor_timeline_sift( uint8_t pos );
+
+/**
+ * @brief add a task to the timeline, or re-sort it if it is already there
+ *
+ * @param id task id
+ */
+static void modem_supervisor_timeline_insert( task_id_t id );
+
+/**
+ * @brief remove a task from the timeline, nothing is done if it is not there
+ *
+ * @param id task id
+ */
+static void modem_supervisor_timeline_remove( task_id_t id );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -221,32 +154,35 @@ static void send_task_update( uint8_t event_type );
 void modem_supervisor_init( void ( *callback )( void ), radio_planner_t* rp,
                             smtc_modem_services_t* smtc_modem_services_ctx )
 {
-    LpState                               = LWPSTATE_IDLE;
-    is_pending_dm_status_payload_periodic = true;  // Set to true to send at least the first DM after Join
-    is_pending_dm_status_payload_now      = false;
-    is_first_dm_after_join                = true;
-    send_task_update_needed               = false;
-    app_callback                          = callback;
+    modem_supervisor_ctx_t*   supervisor = &smtc_modem_current_ctx->supervisor;
+    smtc_modem_ctx_buffers_t* buffers    = &smtc_modem_current_ctx->buffers;
+
+    supervisor->LpState                               = LWPSTATE_IDLE;
+    supervisor->is_pending_dm_status_payload_periodic = true;  // Set to true to send at least the first DM after Join
+    supervisor->is_pending_dm_status_payload_now      = false;
+    supervisor->is_first_dm_after_join                = true;
+    supervisor->send_task_update_needed               = false;
+    supervisor->app_callback                          = callback;
 
 #if defined( ADD_SMTC_ALC_SYNC )
-    alc_sync_context   = &( smtc_modem_services_ctx->alc_sync_ctx );
-    clock_sync_context = &( smtc_modem_services_ctx->clock_sync_ctx );
+    supervisor->alc_sync_context   = &( smtc_modem_services_ctx->alc_sync_ctx );
+    supervisor->clock_sync_context = &( smtc_modem_services_ctx->clock_sync_ctx );
 #endif  // ADD_SMTC_ALC_SYNC
 
 #if defined( ADD_SMTC_STREAM )
-    ROSE = &( smtc_modem_services_ctx->stream_ROSE_ctx );
+    supervisor->ROSE = &( smtc_modem_services_ctx->stream_ROSE_ctx );
 #endif  // ADD_SMTC_STREAM
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
-    file_upload_context = &( smtc_modem_services_ctx->file_upload_ctx );
+    supervisor->file_upload_context = &( smtc_modem_services_ctx->file_upload_ctx );
 #endif  // ADD_SMTC_FILE_UPLOAD
 
     // Used for LoRaWAN Certification
-    user_payload_length = 10;
-    memset( user_payload, 0, sizeof( user_payload ) );
-    user_port                     = 1;
-    certification_data_is_pending = false;
-    class_b_bit                   = false;
+    supervisor->user_payload_length = 10;
+    memset( buffers->user_payload, 0, sizeof( buffers->user_payload ) );
+    supervisor->user_port                     = 1;
+    supervisor->certification_data_is_pending = false;
+    supervisor->class_b_bit                   = false;
 
     lorawan_api_init( rp );
     lorawan_api_dr_strategy_set( STATIC_ADR_MODE );
@@ -258,8 +194,8 @@ void modem_supervisor_init( void ( *callback )( void ), radio_planner_t* rp,
     modem_load_context( );
 
 #if defined( ADD_SMTC_ALC_SYNC )
-    alc_sync_init( alc_sync_context );
-    clock_sync_init( clock_sync_context, alc_sync_context );
+    alc_sync_init( supervisor->alc_sync_context );
+    clock_sync_init( supervisor->clock_sync_context, supervisor->alc_sync_context );
 #endif  // ADD_SMTC_ALC_SYNC
 
 #if defined( LR1110_MODEM_E ) && defined( ADD_SMTC_PATCH_UPDATE )
@@ -287,19 +223,26 @@ void modem_supervisor_init( void ( *callback )( void ), radio_planner_t* rp,
 
 void modem_supervisor_init_task( void )
 {
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
     for( int i = 0; i < NUMBER_OF_TASKS; i++ )
     {
-        task_manager.modem_task[i].priority = TASK_FINISH;
-        task_manager.modem_task[i].id       = ( task_id_t ) i;
+        task_manager->modem_task[i].priority = TASK_FINISH;
+        task_manager->modem_task[i].id       = ( task_id_t ) i;
+        task_manager->timeline_position[i]   = MODEM_TASK_TIMELINE_NONE;
     }
-    task_manager.next_task_id = IDLE_TASK;
+    task_manager->timeline_size = 0;
+    memset( task_manager->ready_tasks, 0, sizeof( task_manager->ready_tasks ) );
+    task_manager->next_task_id = IDLE_TASK;
 }
 
 eTask_priority modem_supervisor_get_task_priority( task_id_t id )
 {
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
     if( id < NUMBER_OF_TASKS )
     {
-        return ( task_manager.modem_task[id].priority );
+        return ( task_manager->modem_task[id].priority );
     }
     else
     {
@@ -309,9 +252,12 @@ eTask_priority modem_supervisor_get_task_priority( task_id_t id )
 
 eTask_valid_t modem_supervisor_remove_task( task_id_t id )
 {
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
     if( id < NUMBER_OF_TASKS )
     {
-        task_manager.modem_task[id].priority = TASK_FINISH;
+        modem_supervisor_task_unschedule( id );
+        task_manager->modem_task[id].priority = TASK_FINISH;
         return TASK_VALID;
     }
     SMTC_MODEM_HAL_TRACE_ERROR( "modem_supervisor_remove_task id = %d unknown\n", id );
@@ -320,28 +266,49 @@ eTask_valid_t modem_supervisor_remove_task( task_id_t id )
 
 eTask_valid_t modem_supervisor_add_task( smodem_task* task )
 {
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+
     // the modem supervisor always accept a new task.
     // in case of a previous task is already enqueue , the new task remove the old one.
     // as soon as a task has been elected by the modem supervisor , the task is managed by the stack itself and a new
     // task could be added inside the modem supervisor.
     if( task->id < NUMBER_OF_TASKS )
     {
-        task_manager.modem_task[task->id].time_to_execute_s = task->time_to_execute_s;
-        task_manager.modem_task[task->id].priority          = task->priority;
-        task_manager.modem_task[task->id].fPort             = task->fPort;
-        task_manager.modem_task[task->id].fPort_present     = task->fPort_present;
-        task_manager.modem_task[task->id].dataIn            = task->dataIn;
-        task_manager.modem_task[task->id].sizeIn            = task->sizeIn;
-        task_manager.modem_task[task->id].PacketType        = task->PacketType;
-
+        modem_supervisor_task_unschedule( task->id );
+
+        supervisor->task_manager.modem_task[task->id].time_to_execute_ms    = task->time_to_execute_ms;
+        supervisor->task_manager.modem_task[task->id].time_beyond_horizon_s = task->time_beyond_horizon_s;
+        supervisor->task_manager.modem_task[task->id].priority              = task->priority;
+        supervisor->task_manager.modem_task[task->id].fPort                 = task->fPort;
+        supervisor->task_manager.modem_task[task->id].fPort_present         = task->fPort_present;
+        supervisor->task_manager.modem_task[task->id].dataIn                = task->dataIn;
+        supervisor->task_manager.modem_task[task->id].sizeIn                = task->sizeIn;
+        supervisor->task_manager.modem_task[task->id].PacketType            = task->PacketType;
+
+        if( task->priority < TASK_FINISH )
+        {
+            modem_supervisor_timeline_insert( task->id );
+        }
         return TASK_VALID;
     }
     SMTC_MODEM_HAL_TRACE_ERROR( "modem_supervisor_add_task id = %d unknown\n", task->id );
     return TASK_NOT_VALID;
 }
 
+void modem_supervisor_set_task_delay( smodem_task* task, uint32_t delay_s, uint32_t delay_ms )
+{
+    delay_s += delay_ms / 1000;
+    delay_ms %= 1000;
+
+    uint32_t step_s             = MIN( delay_s, MODEM_MAX_TIME );
+    task->time_to_execute_ms    = smtc_modem_hal_get_time_in_ms( ) + ( step_s * 1000 ) + delay_ms;
+    task->time_beyond_horizon_s = delay_s - step_s;
+}
+
 void modem_supervisor_launch_task( task_id_t id )
 {
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+
     status_lorawan_t send_status = ERRORLORAWAN;
     switch( id )
     {
@@ -350,7 +317,7 @@ void modem_supervisor_launch_task( task_id_t id )
         if( get_join_state( ) == MODEM_JOINED )
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "DEVICE ALREADY JOINED or TRY TO JOIN \n" );
-            task_manager.next_task_id = IDLE_TASK;
+            supervisor->task_manager.next_task_id = IDLE_TASK;
         }
         else if( get_join_state( ) == MODEM_JOIN_ONGOING )
         {
@@ -362,22 +329,22 @@ void modem_supervisor_launch_task( task_id_t id )
     case SEND_TASK_EXTENDED_2:
     case SEND_TASK: {
         send_status = lorawan_api_payload_send(
-            task_manager.modem_task[id].fPort, task_manager.modem_task[id].fPort_present,
-            task_manager.modem_task[id].dataIn, task_manager.modem_task[id].sizeIn,
-            ( task_manager.modem_task[id].PacketType == TX_CONFIRMED ) ? CONF_DATA_UP : UNCONF_DATA_UP,
+            supervisor->task_manager.modem_task[id].fPort, supervisor->task_manager.modem_task[id].fPort_present,
+            supervisor->task_manager.modem_task[id].dataIn, supervisor->task_manager.modem_task[id].sizeIn,
+            ( supervisor->task_manager.modem_task[id].PacketType == TX_CONFIRMED ) ? CONF_DATA_UP : UNCONF_DATA_UP,
             smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS );
 
         if( send_status == OKLORAWAN )
         {
-            send_task_update_needed = true;
+            supervisor->send_task_update_needed = true;
             SMTC_MODEM_HAL_TRACE_PRINTF(
                 " User Tx LORa %s %d \n",
-                ( task_manager.modem_task[id].fPort_present == true ) ? "on FPort" : "No FPort",
-                task_manager.modem_task[id].fPort );
+                ( supervisor->task_manager.modem_task[id].fPort_present == true ) ? "on FPort" : "No FPort",
+                supervisor->task_manager.modem_task[id].fPort );
         }
         else
         {
-            send_task_update_needed = false;
+            supervisor->send_task_update_needed = false;
             SMTC_MODEM_HAL_TRACE_WARNING( "The payload can't be send! internal code: %x\n", send_status );
         }
         break;
@@ -400,7 +367,8 @@ void modem_supervisor_launch_task( task_id_t id )
             uint32_t info_bitfield_periodic;
             uint32_t info_bitfield_periodictmp;
 
-            if( ( is_first_dm_after_join == true ) && ( is_pending_dm_status_payload_periodic == true ) )
+            if( ( supervisor->is_first_dm_after_join == true ) &&
+                ( supervisor->is_pending_dm_status_payload_periodic == true ) )
             {
                 info_bitfield_periodictmp = modem_get_dm_info_bitfield_periodic( );
                 SMTC_MODEM_HAL_TRACE_PRINTF( " info bit field = %x\n", info_bitfield_periodictmp );
@@ -415,7 +383,7 @@ void modem_supervisor_launch_task( task_id_t id )
 
                 modem_set_dm_info_bitfield_periodic( info_bitfield_periodic );
                 SMTC_MODEM_HAL_TRACE_PRINTF( " info bit field = %x\n", info_bitfield_periodic );
-                is_pending_dm_status_payload_periodic =
+                supervisor->is_pending_dm_status_payload_periodic =
                     dm_status_payload( payload, &payload_length, max_payload, DM_INFO_PERIODIC );
 
                 send_status =
@@ -424,9 +392,9 @@ void modem_supervisor_launch_task( task_id_t id )
 
                 if( send_status == OKLORAWAN )
                 {
-                    if( is_pending_dm_status_payload_periodic == false )
+                    if( supervisor->is_pending_dm_status_payload_periodic == false )
                     {
-                        is_first_dm_after_join = false;
+                        supervisor->is_first_dm_after_join = false;
                     }
                     modem_set_dm_info_bitfield_periodic( info_bitfield_periodictmp );
                     SMTC_MODEM_HAL_TRACE_ARRAY( "payload DM ", payload, payload_length );
@@ -441,7 +409,7 @@ void modem_supervisor_launch_task( task_id_t id )
             {
                 if( ( get_modem_dm_interval_second( ) > 0 ) && ( modem_get_dm_info_bitfield_periodic( ) > 0 ) )
                 {
-                    is_pending_dm_status_payload_periodic =
+                    supervisor->is_pending_dm_status_payload_periodic =
                         dm_status_payload( payload, &payload_length, max_payload, DM_INFO_PERIODIC );
 
                     send_status =
@@ -467,7 +435,8 @@ void modem_supervisor_launch_task( task_id_t id )
             uint8_t max_payload = lorawan_api_next_max_payload_length_get( );
             uint8_t payload[242];
             uint8_t payload_length;
-            is_pending_dm_status_payload_now = dm_status_payload( payload, &payload_length, max_payload, DM_INFO_NOW );
+            supervisor->is_pending_dm_status_payload_now =
+                dm_status_payload( payload, &payload_length, max_payload, DM_INFO_NOW );
 
             send_status = lorawan_api_payload_send( get_modem_dm_port( ), true, payload, payload_length, UNCONF_DATA_UP,
                                                     smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS );
@@ -521,7 +490,7 @@ void modem_supervisor_launch_task( task_id_t id )
         }
         uint32_t max_payload_size = lorawan_api_next_max_payload_length_get( );
         file_upload_chunk_size =
-            file_upload_get_fragment( file_upload_context, file_upload_chunk_payload,
+            file_upload_get_fragment( supervisor->file_upload_context, file_upload_chunk_payload,
                                       ( max_payload_size > 100 ) ? 100 : max_payload_size, lorawan_api_fcnt_up_get( ) );
         if( file_upload_chunk_size > 0 )
         {
@@ -572,11 +541,12 @@ void modem_supervisor_launch_task( task_id_t id )
         // XXX Check if a streaming session is already active
         fragment_size = lorawan_api_next_max_payload_length_get( ) - tx_buff_offset;
         frame_cnt     = lorawan_api_fcnt_up_get( );
-        stream_rc     = stream_get_fragment( ROSE, &stream_payload[tx_buff_offset], frame_cnt, &fragment_size );
+        stream_rc =
+            stream_get_fragment( supervisor->ROSE, &stream_payload[tx_buff_offset], frame_cnt, &fragment_size );
         // TODO Is this enough to ensure we send everything?
         if( stream_rc == STREAM_OK && fragment_size > 0 )
         {
-            send_status = lorawan_api_payload_send( task_manager.modem_task[id].fPort, true, stream_payload,
+            send_status = lorawan_api_payload_send( supervisor->task_manager.modem_task[id].fPort, true, stream_payload,
                                                     fragment_size + tx_buff_offset, UNCONF_DATA_UP,
                                                     smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS );
         }
@@ -614,7 +584,7 @@ void modem_supervisor_launch_task( task_id_t id )
         }
         if( get_join_state( ) == MODEM_JOINED )
         {
-            clock_sync_request( clock_sync_context );
+            clock_sync_request( supervisor->clock_sync_context );
         }
 
         break;
@@ -631,16 +601,16 @@ void modem_supervisor_launch_task( task_id_t id )
         uint8_t  tx_buff_offset       = 0;
 
         // check first if alc_sync runs on dm port and if yes add dm code
-        if( get_modem_dm_port( ) == clock_sync_get_alcsync_port( clock_sync_context ) )
+        if( get_modem_dm_port( ) == clock_sync_get_alcsync_port( supervisor->clock_sync_context ) )
         {
             tx_buffer_out[tx_buff_offset] = DM_INFO_ALCSYNC;
             tx_buff_offset++;
         }
 
         // use target send time with both local compensation and previous alcsync compensation to create payload
-        alc_sync_create_uplink_payload( alc_sync_context,
+        alc_sync_create_uplink_payload( supervisor->alc_sync_context,
                                         target_send_time + smtc_modem_hal_get_time_compensation_in_s( ) +
-                                            alc_sync_get_time_correction_second( alc_sync_context ),
+                                            alc_sync_get_time_correction_second( supervisor->alc_sync_context ),
                                         true, true, max_payload - tx_buff_offset, &tx_buffer_out[tx_buff_offset],
                                         &tx_buffer_length_out );
 
@@ -649,11 +619,12 @@ void modem_supervisor_launch_task( task_id_t id )
 
         if( tx_buffer_length_out > 0 )
         {
-            send_status = lorawan_api_payload_send_at_time( clock_sync_get_alcsync_port( clock_sync_context ), true,
-                                                            tx_buffer_out, tx_buffer_length_out, UNCONF_DATA_UP,
-                                                            target_send_time * 1000 );
+            send_status =
+                lorawan_api_payload_send_at_time( clock_sync_get_alcsync_port( supervisor->clock_sync_context ), true,
+                                                  tx_buffer_out, tx_buffer_length_out, UNCONF_DATA_UP,
+                                                  target_send_time * 1000 );
             // reset alcsync reception bool
-            alc_sync_context->is_sync_dl_received = false;
+            supervisor->alc_sync_context->is_sync_dl_received = false;
         }
         break;
     }
@@ -689,8 +660,9 @@ void modem_supervisor_launch_task( task_id_t id )
 #endif  // LR1110_MODEM_E && ADD_SMTC_PATCH_UPDATE
     case USER_TASK: {
         send_status = lorawan_api_payload_send(
-            get_modem_dm_port( ), true, task_manager.modem_task[id].dataIn, task_manager.modem_task[id].sizeIn,
-            task_manager.modem_task[id].PacketType, smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS );
+            get_modem_dm_port( ), true, supervisor->task_manager.modem_task[id].dataIn,
+            supervisor->task_manager.modem_task[id].sizeIn, supervisor->task_manager.modem_task[id].PacketType,
+            smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS );
         break;
     }
 #if defined( LR1110_MODEM_E ) && defined( _MODEM_E_GNSS_ENABLE )
@@ -725,6 +697,8 @@ void modem_supervisor_launch_task( task_id_t id )
 
 void modem_supervisor_update_task( task_id_t id )
 {
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+
     // modem_supervisor_update_downlink_frame( );
     switch( id )
     {
@@ -734,8 +708,8 @@ void modem_supervisor_update_task( task_id_t id )
             set_modem_status_joining( false );
             set_modem_status_modem_joined( true );
             // as soon as modem is joined, modem send has to sent a dm report every DM_PERIOD_AFTER_JOIN
-            is_first_dm_after_join                = true;
-            is_pending_dm_status_payload_periodic = true;
+            supervisor->is_first_dm_after_join                = true;
+            supervisor->is_pending_dm_status_payload_periodic = true;
             modem_supervisor_add_task_dm_status( DM_PERIOD_AFTER_JOIN );
 
             // reset dm tag number to prevent using wrong id
@@ -743,11 +717,11 @@ void modem_supervisor_update_task( task_id_t id )
 
 #if defined( ADD_SMTC_ALC_SYNC )
             // If clock sync service activated => initiate a new request
-            if( clock_sync_is_enabled( clock_sync_context ) == true )
+            if( clock_sync_is_enabled( supervisor->clock_sync_context ) == true )
             {
                 modem_supervisor_add_task_clock_sync_time_req( DM_PERIOD_AFTER_JOIN + 10 +
                                                                smtc_modem_hal_get_random_nb_in_range( 0, 5 ) );
-                clock_sync_reset_nb_time_req( clock_sync_context );
+                clock_sync_reset_nb_time_req( supervisor->clock_sync_context );
             }
 #endif  // ADD_SMTC_ALC_SYNC
             if( smtc_modem_hal_get_crashlog_status( ) == true )
@@ -780,7 +754,7 @@ void modem_supervisor_update_task( task_id_t id )
 
         if( get_modem_dm_interval_second( ) > 0 )
         {
-            if( is_first_dm_after_join == true )
+            if( supervisor->is_first_dm_after_join == true )
             {
                 modem_supervisor_add_task_dm_status( smtc_modem_hal_get_random_nb_in_range( 10, 15 ) );
             }
@@ -791,7 +765,7 @@ void modem_supervisor_update_task( task_id_t id )
         }
         break;
     case DM_TASK_NOW:
-        if( is_pending_dm_status_payload_now )
+        if( supervisor->is_pending_dm_status_payload_now )
         {
             modem_supervisor_add_task_dm_status_now( );
         }
@@ -813,10 +787,11 @@ void modem_supervisor_update_task( task_id_t id )
         modem_upload_state_t modem_upload_state = modem_get_upload_state( );
         if( modem_upload_state == MODEM_UPLOAD_ON_GOING )
         {
-            if( ( file_upload_is_data_remaining( file_upload_context ) == true ) )
+            if( ( file_upload_is_data_remaining( supervisor->file_upload_context ) == true ) )
             {
                 // There is still upload that need to be sent => add a new task
-                modem_supervisor_add_task_file_upload( file_upload_get_average_delay_in_s( file_upload_context ) );
+                modem_supervisor_add_task_file_upload(
+                    file_upload_get_average_delay_in_s( supervisor->file_upload_context ) );
             }
             else
             {
@@ -834,7 +809,7 @@ void modem_supervisor_update_task( task_id_t id )
 #if defined( ADD_SMTC_STREAM )
     case STREAM_TASK: {
         // SMTC_MODEM_HAL_TRACE_MSG( "Supervisor update STREAM_TASK\n" );
-        if( stream_data_pending( ROSE ) )
+        if( stream_data_pending( supervisor->ROSE ) )
         {
             modem_supervisor_add_task_stream( );
         }
@@ -866,12 +841,12 @@ void modem_supervisor_update_task( task_id_t id )
     }
 #if defined( ADD_SMTC_ALC_SYNC )
     case CLOCK_SYNC_TIME_REQ_TASK: {
-        clock_sync_callback( clock_sync_context, 0 );  // TODO change 0
+        clock_sync_callback( supervisor->clock_sync_context, 0 );  // TODO change 0
 
-        if( clock_sync_context->sync_service_type == CLOCK_SYNC_ALC )
+        if( supervisor->clock_sync_context->sync_service_type == CLOCK_SYNC_ALC )
         {
             // Answer with time sync not received, create a new downlink opportunities
-            if( clock_sync_is_time_valid( clock_sync_context ) == false )
+            if( clock_sync_is_time_valid( supervisor->clock_sync_context ) == false )
             {
                 dm_dl_opportunities_config_t retrieve;
                 get_dm_retrieve_pending_dl( &retrieve );
@@ -887,7 +862,7 @@ void modem_supervisor_update_task( task_id_t id )
         break;
     }
     case ALC_SYNC_ANS_TASK:
-        if( alc_sync_get_nb_transmission( alc_sync_context ) > 0 )
+        if( alc_sync_get_nb_transmission( supervisor->alc_sync_context ) > 0 )
         {
             modem_supervisor_add_task_alc_sync_ans( smtc_modem_hal_get_random_nb_in_range( 128, 150 ) );
         }
@@ -945,71 +920,71 @@ void modem_supervisor_update_task( task_id_t id )
 
 uint32_t modem_supervisor_scheduler( void )
 {
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
     // Check first if stack state is idle
     if( lorawan_api_state_get( ) != LWPSTATE_IDLE )
     {
         return ( CALL_LR1MAC_PERIOD_MS );
     }
 
-    if( task_manager.next_task_id != IDLE_TASK )
+    if( task_manager->next_task_id != IDLE_TASK )
     {
-        modem_supervisor_update_task( task_manager.next_task_id );
-        task_manager.next_task_id = IDLE_TASK;
+        modem_supervisor_update_task( task_manager->next_task_id );
+        task_manager->next_task_id = IDLE_TASK;
     }
 
-    eTask_priority next_task_priority = TASK_FINISH;
-    int32_t        next_task_time     = MODEM_MAX_TIME;
+    uint32_t now = smtc_modem_hal_get_time_in_ms( );
 
-    // Find the highest priority task in the past
-    for( task_id_t i = 0; i < NUMBER_OF_TASKS; i++ )
+    // Move the tasks whose date is reached from the timeline to the ready tasks
+    while( task_manager->timeline_size > 0 )
     {
-        if( task_manager.modem_task[i].priority != TASK_FINISH )
-        {
-            int32_t next_task_time_tmp =
-                ( int32_t )( task_manager.modem_task[i].time_to_execute_s - smtc_modem_hal_get_time_in_s( ) );
+        task_id_t    id   = ( task_id_t ) task_manager->timeline[0];
+        smodem_task* task = &task_manager->modem_task[id];
 
-            if( ( next_task_time_tmp <= 0 ) && ( task_manager.modem_task[i].priority < next_task_priority ) )
-            {
-                next_task_priority        = task_manager.modem_task[i].priority;
-                next_task_time            = next_task_time_tmp;
-                task_manager.next_task_id = ( task_id_t ) i;
-            }
+        if( ( int32_t )( task->time_to_execute_ms - now ) > 0 )
+        {
+            break;
+        }
+        if( task->time_beyond_horizon_s > 0 )
+        {
+            // Only a step of a long delay is over, the task goes back in the timeline for the next one
+            uint32_t step_s = MIN( task->time_beyond_horizon_s, MODEM_MAX_TIME );
+            task->time_to_execute_ms += step_s * 1000;
+            task->time_beyond_horizon_s -= step_s;
+            modem_supervisor_timeline_sift( 0 );
+        }
+        else
+        {
+            modem_supervisor_timeline_remove( id );
+            task_manager->ready_tasks[task->priority] |= ( uint32_t ) 1 << id;
         }
     }
 
-    // No task in the past was found, select the least in the future for wake up
-    if( next_task_priority == TASK_FINISH )
+    // Launch the highest priority ready task, the lowest id first for a same priority
+    for( uint8_t priority = 0; priority < TASK_FINISH; priority++ )
     {
-        for( task_id_t i = 0; i < NUMBER_OF_TASKS; i++ )
+        if( task_manager->ready_tasks[priority] != 0 )
         {
-            if( task_manager.modem_task[i].priority != TASK_FINISH )
-            {
-                int32_t next_task_time_tmp =
-                    ( int32_t )( task_manager.modem_task[i].time_to_execute_s - smtc_modem_hal_get_time_in_s( ) );
-                if( next_task_time_tmp < next_task_time )
-                {
-                    next_task_time            = next_task_time_tmp;
-                    task_manager.next_task_id = ( task_id_t ) i;
-                }
-            }
+            task_manager->next_task_id = ( task_id_t ) __builtin_ctz( task_manager->ready_tasks[priority] );
+            modem_supervisor_launch_task( task_manager->next_task_id );
+            return 0;
         }
     }
 
-    if( next_task_time > 0 )
+    // No ready task, wake up for the first task of the timeline
+    task_manager->sleep_duration = MODEM_MAX_TIME * 1000;
+    if( task_manager->timeline_size > 0 )
     {
-        task_manager.sleep_duration = next_task_time;
-        task_manager.next_task_id   = IDLE_TASK;
-        return ( next_task_time * 1000 );
-    }
-    else
-    {
-        modem_supervisor_launch_task( task_manager.next_task_id );
-        return 0;
+        task_manager->sleep_duration = task_manager->modem_task[task_manager->timeline[0]].time_to_execute_ms - now;
     }
+    return ( task_manager->sleep_duration );
 }
 
 uint32_t modem_supervisor_engine( void )
 {
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+
     // manage reset requested by the host
     if( get_modem_reset_requested( ) == true )
     {
@@ -1030,30 +1005,49 @@ uint32_t modem_supervisor_engine( void )
             increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_ALARM, 0 );
             modem_set_user_alarm( 0 );
             user_alarm_in_seconds = MODEM_MAX_ALARM_S;
-            if( *app_callback != NULL )
+            if( *supervisor->app_callback != NULL )
             {
-                app_callback( );
+                supervisor->app_callback( );
             }
         }
     }
 
     // case Lorawan stack already in use
-    LpState = lorawan_api_state_get( );
+    supervisor->LpState = lorawan_api_state_get( );
 
-    if( ( LpState != LWPSTATE_IDLE ) && ( LpState != LWPSTATE_ERROR ) && ( LpState != LWPSTATE_INVALID ) )
+    if( ( supervisor->LpState != LWPSTATE_IDLE ) && ( supervisor->LpState != LWPSTATE_ERROR ) &&
+        ( supervisor->LpState != LWPSTATE_INVALID ) )
     {
-        LpState = lorawan_api_process( );
-        return ( CALL_LR1MAC_PERIOD_MS );
+        supervisor->LpState = lorawan_api_process( );
+        if( ( supervisor->LpState != LWPSTATE_IDLE ) && ( supervisor->LpState != LWPSTATE_ERROR ) &&
+            ( supervisor->LpState != LWPSTATE_INVALID ) )
+        {
+            // Sleep until the next deadline of the stack, the radio irqs wake up the MCU sooner
+            return MIN( lorawan_api_next_process_delay_ms_get( ), ( uint32_t ) user_alarm_in_seconds * 1000 );
+        }
+        // else the stack is back to idle, the supervisor tasks are handled right now
     }
 
     backoff_mobile_static( );
     check_class_b_to_generate_event( );
 
+#if defined( LR1110_MODEM_E ) && defined( ADD_SMTC_PATCH_UPDATE )
+    // A received data block is reconstructed by bounded chunks, only while the stack is idle
+    if( frag_is_reconstructing( ) == true )
+    {
+        if( frag_reconstruction_step( ) > 0 )
+        {
+            // An answer to a request, or a request is required, add a task for it
+            modem_supervisor_add_task_frag( 1 );
+        }
+    }
+#endif  // LR1110_MODEM_E && ADD_SMTC_PATCH_UPDATE
+
     // Call modem_supervisor_update_task to update asynchronous messages number
-    if( task_manager.next_task_id != IDLE_TASK )
+    if( supervisor->task_manager.next_task_id != IDLE_TASK )
     {
-        modem_supervisor_update_task( task_manager.next_task_id );
-        task_manager.next_task_id = IDLE_TASK;
+        modem_supervisor_update_task( supervisor->task_manager.next_task_id );
+        supervisor->task_manager.next_task_id = IDLE_TASK;
     }
 
     uint8_t msgnumber_tmp;
@@ -1065,9 +1059,9 @@ uint32_t modem_supervisor_engine( void )
             {
                 certification_event_handler( );
             }
-            else if( *app_callback != NULL )
+            else if( *supervisor->app_callback != NULL )
             {
-                app_callback( );
+                supervisor->app_callback( );
             }
         }
         msgnumber_tmp = get_asynchronous_msgnumber( );
@@ -1103,17 +1097,27 @@ uint32_t modem_supervisor_engine( void )
     }
 
     sleep_time = MIN( sleep_time, ( uint32_t ) user_alarm_in_seconds * 1000 );
+
+#if defined( LR1110_MODEM_E ) && defined( ADD_SMTC_PATCH_UPDATE )
+    if( frag_is_reconstructing( ) == true )
+    {
+        // Come back right away for the next chunk of the reconstruction
+        sleep_time = 0;
+    }
+#endif  // LR1110_MODEM_E && ADD_SMTC_PATCH_UPDATE
     // SMTC_MODEM_HAL_TRACE_INFO( "Next task in %d\n", sleep_time );
     return ( sleep_time );
 }
 
 void check_class_b_to_generate_event( void )
 {
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+
     bool class_b_bit_stack = lorawan_api_get_class_b_status( );
 
-    if( class_b_bit != class_b_bit_stack )
+    if( supervisor->class_b_bit != class_b_bit_stack )
     {
-        class_b_bit = class_b_bit_stack;
+        supervisor->class_b_bit = class_b_bit_stack;
 
         dm_dl_opportunities_config_t retrieve;
         get_dm_retrieve_pending_dl( &retrieve );
@@ -1123,7 +1127,7 @@ void check_class_b_to_generate_event( void )
         }
         modem_supervisor_add_task_retrieve_dl( 1 );
 
-        increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_CLASS_B_STATUS, class_b_bit );
+        increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_CLASS_B_STATUS, supervisor->class_b_bit );
     }
 }
 
@@ -1156,6 +1160,9 @@ void backoff_mobile_static( void )
 uint8_t modem_supervisor_update_downlink_frame( uint8_t* data, uint8_t data_length, lr1mac_down_metadata_t* metadata,
                                                 bool ack_requested )
 {
+#if defined( ADD_SMTC_ALC_SYNC )
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+#endif  // ADD_SMTC_ALC_SYNC
     modem_downlink_msg_t dwnframe;
 
     // Class C Downlink Confirmed can trig a dl retrieve task to acked the frame
@@ -1181,29 +1188,30 @@ uint8_t modem_supervisor_update_downlink_frame( uint8_t* data, uint8_t data_leng
         dm_downlink( dwnframe.data, dwnframe.length );
     }
 #if defined( ADD_SMTC_ALC_SYNC )
-    else if( dwnframe.port == clock_sync_get_alcsync_port( clock_sync_context ) )
+    else if( dwnframe.port == clock_sync_get_alcsync_port( supervisor->clock_sync_context ) )
     {
         if( ( metadata->rx_window == RECEIVE_ON_RX1 ) || ( metadata->rx_window == RECEIVE_ON_RX2 ) ||
             ( metadata->rx_window == RECEIVE_ON_RXB ) || ( metadata->rx_window == RECEIVE_ON_RXC ) )
         {
-            uint8_t alc_sync_status = alc_sync_parser( alc_sync_context, dwnframe.data, dwnframe.length );
+            uint8_t alc_sync_status = alc_sync_parser( supervisor->alc_sync_context, dwnframe.data, dwnframe.length );
 
             if( ( ( alc_sync_status >> ALC_SYNC_APP_TIME_ANS ) & 0x1 ) == 1 )
             {
                 // an alcsync dl with time was received => update flag
-                alc_sync_context->is_sync_dl_received = true;
+                supervisor->alc_sync_context->is_sync_dl_received = true;
 
                 increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_TIME, SMTC_MODEM_EVENT_TIME_VALID );
 
                 // Remove all alc sync task.
                 modem_supervisor_remove_task_clock_sync( );
 
-                if( clock_sync_is_enabled( clock_sync_context ) == true )
+                if( clock_sync_is_enabled( supervisor->clock_sync_context ) == true )
                 {
                     int32_t tmp_rand = 0;
 
-                    uint32_t tmp_delay = MIN( clock_sync_get_interval_second( clock_sync_context ),
-                                              clock_sync_get_time_left_connection_lost( clock_sync_context ) );
+                    uint32_t tmp_delay =
+                        MIN( clock_sync_get_interval_second( supervisor->clock_sync_context ),
+                             clock_sync_get_time_left_connection_lost( supervisor->clock_sync_context ) );
                     do
                     {
                         tmp_rand = smtc_modem_hal_get_signed_random_nb_in_range( -30, 30 );
@@ -1217,13 +1225,14 @@ uint8_t modem_supervisor_update_downlink_frame( uint8_t* data, uint8_t data_leng
             {
                 if( ( ( alc_sync_status >> ALC_SYNC_DEVICE_APP_TIME_PERIODICITY_REQ ) & 0x1 ) == 1 )
                 {
-                    if( clock_sync_is_enabled( clock_sync_context ) == true )
+                    if( clock_sync_is_enabled( supervisor->clock_sync_context ) == true )
                     {
                         int32_t tmp_rand = 0;
 
                         // If periodic time request is configured, add task to handle it
-                        uint32_t tmp_delay = MIN( clock_sync_get_interval_second( clock_sync_context ),
-                                                  clock_sync_get_time_left_connection_lost( clock_sync_context ) );
+                        uint32_t tmp_delay =
+                            MIN( clock_sync_get_interval_second( supervisor->clock_sync_context ),
+                                 clock_sync_get_time_left_connection_lost( supervisor->clock_sync_context ) );
                         do
                         {
                             tmp_rand = smtc_modem_hal_get_signed_random_nb_in_range( -30, 30 );
@@ -1271,6 +1280,9 @@ uint8_t modem_supervisor_update_downlink_frame( uint8_t* data, uint8_t data_leng
  */
 static void certification_event_handler( void )
 {
+    modem_supervisor_ctx_t*   supervisor = &smtc_modem_current_ctx->supervisor;
+    smtc_modem_ctx_buffers_t* buffers    = &smtc_modem_current_ctx->buffers;
+
     smtc_modem_event_t current_event;
     uint8_t            event_pending_count;
     uint8_t            stack_id = 0;
@@ -1353,7 +1365,7 @@ static void certification_event_handler( void )
                 break;
 
             case SMTC_MODEM_EVENT_TXDONE_NOT_SENT:
-                user_payload_length = 0;
+                supervisor->user_payload_length = 0;
                 break;
 
             default:
@@ -1409,7 +1421,7 @@ static void certification_event_handler( void )
             {
                 if( ( lorawan_api_get_ping_slot_info_req_status( ) == OKLORAWAN ) &&
 #if defined( ADD_SMTC_ALC_SYNC )
-                    ( clock_sync_is_time_valid( clock_sync_context ) == true ) )
+                    ( clock_sync_is_time_valid( supervisor->clock_sync_context ) == true ) )
 #else   // ADD_SMTC_ALC_SYNC
                     ( lorawan_api_is_time_valid( ) == true ) )
 #endif  // ADD_SMTC_ALC_SYNC
@@ -1421,7 +1433,7 @@ static void certification_event_handler( void )
                 {
                     SMTC_MODEM_HAL_TRACE_PRINTF( "Certif classB could not be enabled\n" );
 #if defined( ADD_SMTC_ALC_SYNC )
-                    if( clock_sync_is_time_valid( clock_sync_context ) == false )
+                    if( clock_sync_is_time_valid( supervisor->clock_sync_context ) == false )
 #else   // ADD_SMTC_ALC_SYNC
                     if( lorawan_api_is_time_valid( ) == false )
 #endif  // ADD_SMTC_ALC_SYNC
@@ -1446,7 +1458,8 @@ static void certification_event_handler( void )
         smtc_modem_dm_set_info_interval( SMTC_MODEM_DM_INFO_INTERVAL_IN_SECOND, 0x00 );
 
         lorawan_certification_parser_ret_t status_certif =
-            lorawan_api_certification( rx_payload, rx_payload_size, user_payload, &user_payload_length, &user_port );
+            lorawan_api_certification( rx_payload, rx_payload_size, buffers->user_payload,
+                                       &supervisor->user_payload_length, &supervisor->user_port );
 
         SMTC_MODEM_HAL_TRACE_PRINTF( "status_certif 0x%x\n", status_certif );
         switch( status_certif )
@@ -1488,7 +1501,7 @@ static void certification_event_handler( void )
                 lorawan_api_class_c_enabled( false );
 
 #if defined( ADD_SMTC_ALC_SYNC )
-                if( clock_sync_is_time_valid( clock_sync_context ) == false )
+                if( clock_sync_is_time_valid( supervisor->clock_sync_context ) == false )
 #else   // ADD_SMTC_ALC_SYNC
                 if( lorawan_api_is_time_valid( ) == false )
 #endif  // ADD_SMTC_ALC_SYNC
@@ -1512,9 +1525,9 @@ static void certification_event_handler( void )
         case LORAWAN_CERTIFICATION_RET_NOTHING:
         case LORAWAN_CERTIFICATION_RET_APP_UL:
         default:
-            user_port           = 1;
-            user_payload_length = 1;  // lorawan_api_next_max_payload_length_get( );
-            memset( user_payload, 1, user_payload_length );
+            supervisor->user_port           = 1;
+            supervisor->user_payload_length = 1;  // lorawan_api_next_max_payload_length_get( );
+            memset( buffers->user_payload, 1, supervisor->user_payload_length );
             break;
         }
 
@@ -1522,44 +1535,47 @@ static void certification_event_handler( void )
         {
             smtc_modem_dm_set_info_interval( SMTC_MODEM_DM_INFO_INTERVAL_IN_SECOND, 60 );
         }
-        new_certification_cmd         = 0;
-        certification_data_is_pending = true;
+        new_certification_cmd                     = 0;
+        supervisor->certification_data_is_pending = true;
     }
 
     if( current_event.event_data.downdata.window == SMTC_MODEM_EVENT_DOWNDATA_WINDOW_RXBEACON )
     {
         if( lorawan_api_certification_get_beacon_rx_status_ind_ctrl( ) == true )
         {
-            user_payload_length = 0;
+            supervisor->user_payload_length = 0;
             // Send data beacon to testing tool
             lorawan_api_certification_build_beacon_rx_status_ind(
-                rx_payload, rx_payload_size, user_payload, &user_payload_length,
+                rx_payload, rx_payload_size, buffers->user_payload, &supervisor->user_payload_length,
                 current_event.event_data.downdata.rssi - 64, current_event.event_data.downdata.snr >> 2,
                 current_event.event_data.downdata.datarate, current_event.event_data.downdata.frequency_hz );
 
-            SMTC_MODEM_HAL_TRACE_ARRAY( "BEACON to testing tool", user_payload, user_payload_length );
-            user_port     = 224;
-            is_request_tx = true;
+            SMTC_MODEM_HAL_TRACE_ARRAY( "BEACON to testing tool", buffers->user_payload,
+                                        supervisor->user_payload_length );
+            supervisor->user_port = 224;
+            is_request_tx         = true;
         }
     }
-    else if( certification_data_is_pending == false )
+    else if( supervisor->certification_data_is_pending == false )
     {
-        user_port           = 2;
-        user_payload_length = 1;  // lorawan_api_next_max_payload_length_get( );
-        memset( user_payload, 2, user_payload_length );
+        supervisor->user_port           = 2;
+        supervisor->user_payload_length = 1;  // lorawan_api_next_max_payload_length_get( );
+        memset( buffers->user_payload, 2, supervisor->user_payload_length );
     }
 
     if( is_request_tx == true )
     {
-        is_request_tx                 = false;
-        certification_data_is_pending = false;
-        smtc_modem_request_uplink( stack_id, user_port, lorawan_api_certification_get_frame_type( ), user_payload,
-                                   user_payload_length );
+        is_request_tx                             = false;
+        supervisor->certification_data_is_pending = false;
+        smtc_modem_request_uplink( stack_id, supervisor->user_port, lorawan_api_certification_get_frame_type( ),
+                                   buffers->user_payload, supervisor->user_payload_length );
     }
 }
 static void send_task_update( uint8_t event_type )
 {
-    if( send_task_update_needed == true )
+    modem_supervisor_ctx_t* supervisor = &smtc_modem_current_ctx->supervisor;
+
+    if( supervisor->send_task_update_needed == true )
     {
         if( lorawan_api_rx_ack_bit_get( ) == 1 )
         {
@@ -1584,4 +1600,107 @@ static void send_task_update( uint8_t event_type )
     {
         lorawan_api_duty_cycle_enable_set( SMTC_DTC_ENABLED );
     }
-}
\ No newline at end of file
+}
+//
+// Task timeline
+//
+// The waiting tasks are kept in a min-heap ordered by date, so the scheduler only looks at the heap root to know if a
+// task is due and how long the modem can sleep. The due tasks are flagged in a bitset per priority and the first bit
+// of the highest priority bitset gives the task to launch.
+//
+
+static void modem_supervisor_task_unschedule( task_id_t id )
+{
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
+    modem_supervisor_timeline_remove( id );
+    for( uint8_t priority = 0; priority < TASK_FINISH; priority++ )
+    {
+        task_manager->ready_tasks[priority] &= ~( ( uint32_t ) 1 << id );
+    }
+}
+
+static bool modem_supervisor_timeline_is_before( uint8_t id_a, uint8_t id_b )
+{
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
+    uint32_t date_a = task_manager->modem_task[id_a].time_to_execute_ms;
+    uint32_t date_b = task_manager->modem_task[id_b].time_to_execute_ms;
+    int32_t  diff   = ( int32_t )( date_a - date_b );
+
+    return ( diff < 0 ) || ( ( diff == 0 ) && ( id_a < id_b ) );
+}
+
+static void modem_supervisor_timeline_sift( uint8_t pos )
+{
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
+    uint8_t id = task_manager->timeline[pos];
+
+    // Sift up
+    while( ( pos > 0 ) && modem_supervisor_timeline_is_before( id, task_manager->timeline[( pos - 1 ) >> 1] ) )
+    {
+        uint8_t parent                                               = ( pos - 1 ) >> 1;
+        task_manager->timeline[pos]                                  = task_manager->timeline[parent];
+        task_manager->timeline_position[task_manager->timeline[pos]] = pos;
+        pos                                                          = parent;
+    }
+    // Sift down
+    while( true )
+    {
+        uint8_t child = ( pos << 1 ) + 1;
+        if( child >= task_manager->timeline_size )
+        {
+            break;
+        }
+        if( ( ( child + 1 ) < task_manager->timeline_size ) &&
+            modem_supervisor_timeline_is_before( task_manager->timeline[child + 1], task_manager->timeline[child] ) )
+        {
+            child++;
+        }
+        if( modem_supervisor_timeline_is_before( id, task_manager->timeline[child] ) )
+        {
+            break;
+        }
+        task_manager->timeline[pos]                                  = task_manager->timeline[child];
+        task_manager->timeline_position[task_manager->timeline[pos]] = pos;
+        pos                                                          = child;
+    }
+
+    task_manager->timeline[pos]         = id;
+    task_manager->timeline_position[id] = pos;
+}
+
+static void modem_supervisor_timeline_insert( task_id_t id )
+{
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
+    if( task_manager->timeline_position[id] == MODEM_TASK_TIMELINE_NONE )
+    {
+        task_manager->timeline_position[id]                   = task_manager->timeline_size;
+        task_manager->timeline[task_manager->timeline_size++] = id;
+    }
+    modem_supervisor_timeline_sift( task_manager->timeline_position[id] );
+}
+
+static void modem_supervisor_timeline_remove( task_id_t id )
+{
+    stask_manager* task_manager = &smtc_modem_current_ctx->supervisor.task_manager;
+
+    uint8_t pos = task_manager->timeline_position[id];
+
+    if( pos == MODEM_TASK_TIMELINE_NONE )
+    {
+        return;
+    }
+    task_manager->timeline_position[id] = MODEM_TASK_TIMELINE_NONE;
+    task_manager->timeline_size--;
+    if( pos < task_manager->timeline_size )
+    {
+        // The last task of the heap takes the free position
+        uint8_t last_id                          = task_manager->timeline[task_manager->timeline_size];
+        task_manager->timeline[pos]              = last_id;
+        task_manager->timeline_position[last_id] = pos;
+        modem_supervisor_timeline_sift( pos );
+    }
+}
@@ -66,7 +66,8 @@ extern "C" {
 
 #define DM_PERIOD_AFTER_JOIN 0
 #define MODEM_TASK_DELAY_MS 200
-#define MODEM_MAX_TIME 0x1FFFFF
+#define MODEM_MAX_TIME 0x1FFFFF        // Longest step of a task delay in second(s), it still fits in a signed ms date
+#define MODEM_TASK_TIMELINE_NONE 0xFF  // timeline_position of a task that is not in the timeline
 #define CALL_LR1MAC_PERIOD_MS 400
 #define MODEM_MAX_ALARM_S 0x7FFFFFFF
 
@@ -145,26 +146,33 @@ typedef enum e_tx_mode
  */
 typedef struct smodem_task
 {
-    task_id_t      id;                 //!< Type ID of the task
-    uint32_t       time_to_execute_s;  //!< The date to execute the task in second
-    eTask_priority priority;           //!< The priority
-    uint8_t        fPort;              //!< LoRaWAN frame port
-    bool           fPort_present;      //!< LoRaWAN frame port
-    const uint8_t* dataIn;             //!< Data in task
-    uint8_t        sizeIn;             //!< Data length in byte(s)
-    uint8_t        PacketType;         //!< LoRaWAN packet type ( Tx confirmed/Unconfirmed )
+    task_id_t      id;                     //!< Type ID of the task
+    uint32_t       time_to_execute_ms;     //!< The date to execute the task in millisecond
+    uint32_t       time_beyond_horizon_s;  //!< Remaining delay after time_to_execute_ms, for delays > MODEM_MAX_TIME
+    eTask_priority priority;               //!< The priority
+    uint8_t        fPort;                  //!< LoRaWAN frame port
+    bool           fPort_present;          //!< LoRaWAN frame port
+    const uint8_t* dataIn;                 //!< Data in task
+    uint8_t        sizeIn;                 //!< Data length in byte(s)
+    uint8_t        PacketType;             //!< LoRaWAN packet type ( Tx confirmed/Unconfirmed )
 } smodem_task;
 
 /*!
  * \typedef stask_manager
  * \brief   Supervisor task manager
+ * \remark  The waiting tasks are kept in a min-heap ordered by date (the timeline), the tasks whose date is reached
+ *          are moved to a bitset per priority (one bit per task id, so NUMBER_OF_TASKS must stay <= 32)
  */
 typedef struct stask_manager
 {
     smodem_task modem_task[NUMBER_OF_TASKS];
+    uint8_t     timeline[NUMBER_OF_TASKS];           //!< Waiting task ids, min-heap ordered by time_to_execute_ms
+    uint8_t     timeline_position[NUMBER_OF_TASKS];  //!< Position of each task in the timeline
+    uint8_t     timeline_size;                       //!< Number of waiting tasks
+    uint32_t    ready_tasks[TASK_FINISH];            //!< Tasks whose date is reached, bitset per priority
     task_id_t   current_task_id;
     task_id_t   next_task_id;
-    uint32_t    sleep_duration;
+    uint32_t    sleep_duration;  //!< Last sleep duration computed by the scheduler in millisecond(s)
 
 } stask_manager;
 
@@ -232,6 +240,16 @@ eTask_valid_t modem_supervisor_remove_task( task_id_t id );
  */
 eTask_valid_t modem_supervisor_add_task( smodem_task* task );
 
+/*!
+ * \brief   Set the date of a task from a delay, before adding it in supervisor
+ * \remark  Delays longer than MODEM_MAX_TIME seconds are served in several steps
+ * \param [out] task*     - Task to date
+ * \param [in]  delay_s   - Delay in second(s)
+ * \param [in]  delay_ms  - Additional delay in millisecond(s)
+ * \retval None
+ */
+void modem_supervisor_set_task_delay( smodem_task* task, uint32_t delay_s, uint32_t delay_ms );
+
 /**
  * @brief
  *
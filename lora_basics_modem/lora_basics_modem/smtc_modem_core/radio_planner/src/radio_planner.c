@@ -39,17 +39,161 @@
 
 #include <string.h>
 
+//
+// Private planner constants
+//
+
+#define RP_TASK_HEAP_NONE 0xFF  // task_heap_position of a hook that is not in the heap
+#define RP_BITSET_NONE 0xFF     // returned by rp_bitset_find_next when no bit is set
+
+// The built-in hooks are an enum, out of reach of the preprocessor checks of radio_planner_types.h
+_Static_assert( RP_NB_HOOKS_MAX >= RP_NB_HOOKS, "RP_NB_HOOKS_MAX is lower than the number of built-in hooks" );
+
 //
 // Private planner utilities declaration
 //
 
+/**
+ * @brief rp_hook_data_init to reset the data of a hook before it is attached to the hook table
+ *
+ * @param hook_data pointer to the hook data
+ * @param hook_id id given to the hook
+ */
+static void rp_hook_data_init( rp_hook_t* hook_data, const uint8_t hook_id );
+
 /**
  * @brief rp_task_free to free a task
  *
  * @param rp  pointer to the radioplaner object itself
- * @param task pointer to the task that function free
+ * @param hook_id id of the task that function free
+ */
+static void rp_task_free( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_set_priority compute the priority of a task and add it to the priority index
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ */
+static void rp_task_set_priority( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_set_running move a pending task to the running state
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ */
+static void rp_task_set_running( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_set_aborted abort a task, its hook is notified by rp_task_call_aborted
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ * @param reason reason of the abort, for the hook statistics
+ */
+static void rp_task_set_aborted( radio_planner_t* rp, const uint8_t hook_id, const rp_abort_reason_t reason );
+
+/**
+ * @brief rp_task_try_shift postpone a schedule task in its slack instead of aborting it, if its owner accepts it
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ * @param start_time_ms new start time of the task
+ * @return true if the task has been postponed, false if it has to be aborted
+ */
+static bool rp_task_try_shift( radio_planner_t* rp, const uint8_t hook_id, const uint32_t start_time_ms );
+
+/**
+ * @brief rp_task_index_remove remove a task from the time heap, the priority index and the aborted index
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ */
+static void rp_task_index_remove( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_heap_is_before compare two tasks of the time heap
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param id_a id of the first task
+ * @param id_b id of the second task
+ * @return true if the first task starts before the second one (lowest hook id first on same start time)
+ */
+static bool rp_task_heap_is_before( const radio_planner_t* rp, const uint8_t id_a, const uint8_t id_b );
+
+/**
+ * @brief rp_task_heap_sift restore the time heap order around a position whose start time has changed
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param pos position in the time heap
  */
-static void rp_task_free( const radio_planner_t* rp, rp_task_t* task );
+static void rp_task_heap_sift( radio_planner_t* rp, uint8_t pos );
+
+/**
+ * @brief rp_task_heap_insert add a pending task to the time heap, or re-sort it if it is already there
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ */
+static void rp_task_heap_insert( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_heap_remove remove a task from the time heap, nothing is done if it is not there
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the targeted task
+ */
+static void rp_task_heap_remove( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_heap_scan split the pending tasks around a given time
+ *
+ * Only the tasks starting before the given time and their direct children in the heap are visited
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param time the reference time in ms
+ * @param late_ids return the ids of the tasks starting before time (array of RP_NB_HOOKS_MAX elements)
+ * @param next_id return the id of the first task starting at or after time, RP_NB_HOOKS_MAX if there is none
+ * @return uint8_t number of ids written in late_ids
+ */
+static uint8_t rp_task_heap_scan( const radio_planner_t* rp, const uint32_t time, uint8_t* late_ids,
+                                  uint8_t* next_id );
+
+/**
+ * @brief rp_bitset_set set a bit of a bitset
+ *
+ * @param bitset the bitset
+ * @param bit index of the bit
+ */
+static void rp_bitset_set( uint32_t* bitset, const uint8_t bit );
+
+/**
+ * @brief rp_bitset_clear clear a bit of a bitset
+ *
+ * @param bitset the bitset
+ * @param bit index of the bit
+ */
+static void rp_bitset_clear( uint32_t* bitset, const uint8_t bit );
+
+/**
+ * @brief rp_bitset_is_set test a bit of a bitset
+ *
+ * @param bitset the bitset
+ * @param bit index of the bit
+ * @return bool true if the bit is set
+ */
+static bool rp_bitset_is_set( const uint32_t* bitset, const uint8_t bit );
+
+/**
+ * @brief rp_bitset_find_next find the first bit set in a bitset from a given index
+ *
+ * @param bitset the bitset
+ * @param nb_words size of the bitset in 32-bit words
+ * @param from index of the first bit to test
+ * @return uint8_t index of the first bit set, RP_BITSET_NONE if there is none
+ */
+static uint8_t rp_bitset_find_next( const uint32_t* bitset, const uint8_t nb_words, const uint8_t from );
 
 /**
  * @brief rp_task_update_time update task time
@@ -76,18 +220,20 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
 static void rp_irq_get_status( radio_planner_t* rp, const uint8_t hook_id );
 
 /**
- * @brief rp_task_compute_ranking compute the ranking of the different tasks inside the radio planer
+ * @brief rp_task_launch_current call  the launch callback of the new running task
  *
- * @param rp pointer to the radioplaner object itself
+ * @param rp  pointer to the radioplaner object itself
  */
-static void rp_task_compute_ranking( radio_planner_t* rp );
+static void rp_task_launch_current( radio_planner_t* rp );
 
 /**
- * @brief rp_task_launch_current call  the launch callback of the new running task
+ * @brief rp_task_is_configured_by_ralf tell if the launch callback of a task only configures the radio through the
+ * ralf_setup_* functions
  *
- * @param rp  pointer to the radioplaner object itself
+ * @param type type of the task
+ * @return true if the task keeps the RALF shadow of the radio configuration up to date
  */
-static void rp_task_launch_current( radio_planner_t* rp );
+static bool rp_task_is_configured_by_ralf( const rp_task_types_t type );
 
 /**
  * @brief rp_task_select_next select the next most priority task
@@ -109,15 +255,6 @@ static uint8_t rp_task_select_next( radio_planner_t* rp, const uint32_t now );
  */
 static rp_next_state_status_t rp_task_get_next( radio_planner_t* rp, uint32_t* duration, uint8_t* task_id,
                                                 const uint32_t now );
-/**
- * @brief rp_task_find_highest_priority utilities to classify priority task (value 0 is the highest priority)
- *
- * @param vector a vector of value to classify from the lowest to the highest
- * @param length size of the vector
- * @return uint8_t index of the vector to indicate the position inside the vector of the minimum value
- */
-static uint8_t rp_task_find_highest_priority( uint8_t* vector, uint8_t length );
-
 /**
  * @brief rp_get_pkt_payload get the receive payload
  *
@@ -170,6 +307,15 @@ static void rp_radio_irq( radio_planner_t* rp );
  */
 static void rp_timer_irq_callback( void* obj );
 
+/**
+ * @brief Select the context of the radio planner owner with the function given to rp_irq_context_init
+ *
+ * @param [in] rp      Radio planner data structure
+ * @param [in] context Context to be selected
+ * @return void*       Context selected before, NULL if there is no select function
+ */
+static void* rp_irq_context_select( radio_planner_t* rp, void* context );
+
 /**
  * @brief rp_hook_callback call the callback associated to the id
  *
@@ -195,62 +341,124 @@ void rp_init( radio_planner_t* rp, const ralf_t* radio )
     memset( rp, 0, sizeof( radio_planner_t ) );
     rp->radio = radio;
 
+    for( int32_t i = 0; i < RP_NB_HOOKS_MAX; i++ )
+    {
+        rp->hook_table[i]         = ( i < RP_NB_HOOKS ) ? &rp->hook_builtin[i] : NULL;
+        rp->task_heap_position[i] = RP_TASK_HEAP_NONE;
+    }
     for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
     {
-        rp->tasks[i].hook_id                    = i;
-        rp->tasks[i].type                       = RP_TASK_TYPE_NONE;
-        rp->tasks[i].launch_task_callbacks      = NULL;
-        rp->tasks[i].state                      = RP_TASK_STATE_FINISHED;
-        rp->tasks[i].schedule_task_low_priority = false;
-        rp->hooks[i]                            = NULL;
-        rp->tasks[i].launch_task_callbacks      = NULL;
-        rp->hook_callbacks[i]                   = NULL;
-        rp->status[i]                           = RP_STATUS_TASK_INIT;
+        rp_hook_data_init( rp->hook_table[i], i );
     }
     rp->priority_task.type  = RP_TASK_TYPE_NONE;
     rp->priority_task.state = RP_TASK_STATE_FINISHED;
     rp_stats_init( &rp->stats );
+    rp->stats.stats_start_ms = rp_hal_get_time_in_ms( );
 
     rp->next_state_status = RP_STATUS_NO_MORE_TASK_SCHEDULE;
     rp->margin_delay      = RP_MARGIN_DELAY;
 }
 
+void rp_irq_context_init( radio_planner_t* rp, void* ( *select )( void* context ), void* context )
+{
+    rp->irq_context_select = select;
+    rp->irq_context        = context;
+}
+
 rp_hook_status_t rp_hook_init( radio_planner_t* rp, const uint8_t id, void ( *callback )( void* context ), void* hook )
 {
-    if( id >= RP_NB_HOOKS )
+    if( ( id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[id] == NULL ) )
     {
         smtc_modem_hal_mcu_panic( );
         return RP_HOOK_STATUS_ID_ERROR;
     }
-    if( ( rp->hook_callbacks[id] != NULL ) || ( callback == NULL ) )
+    if( ( rp->hook_table[id]->callback != NULL ) || ( callback == NULL ) )
     {
         smtc_modem_hal_mcu_panic( );
         return RP_HOOK_STATUS_ID_ERROR;
     }
-    rp->status[id]         = RP_STATUS_TASK_INIT;
-    rp->hook_callbacks[id] = callback;
-    rp->hooks[id]          = hook;
+    rp->hook_table[id]->status   = RP_STATUS_TASK_INIT;
+    rp->hook_table[id]->callback = callback;
+    rp->hook_table[id]->hook     = hook;
+    return RP_HOOK_STATUS_OK;
+}
+
+rp_hook_status_t rp_hook_register( radio_planner_t* rp, rp_hook_t* hook_data, void ( *callback )( void* context ),
+                                   void* hook, uint8_t* id )
+{
+    if( ( hook_data == NULL ) || ( callback == NULL ) )
+    {
+        return RP_HOOK_STATUS_ID_ERROR;
+    }
+    rp_hal_critical_section_begin( );
+    for( uint8_t i = RP_NB_HOOKS; i < RP_NB_HOOKS_MAX; i++ )
+    {
+        if( rp->hook_table[i] == NULL )
+        {
+            rp_hook_data_init( hook_data, i );
+            hook_data->callback = callback;
+            hook_data->hook     = hook;
+            rp->hook_table[i]   = hook_data;
+            rp_hal_critical_section_end( );
+            *id = i;
+            return RP_HOOK_STATUS_OK;
+        }
+    }
+    rp_hal_critical_section_end( );
+    SMTC_MODEM_HAL_TRACE_WARNING( "RP: hook table is full (%u hooks)\n", RP_NB_HOOKS_MAX );
+    return RP_HOOK_STATUS_ID_ERROR;
+}
+
+rp_hook_status_t rp_hook_unregister( radio_planner_t* rp, uint8_t id )
+{
+    if( ( id < RP_NB_HOOKS ) || ( id >= RP_NB_HOOKS_MAX ) )
+    {
+        return RP_HOOK_STATUS_ID_ERROR;
+    }
+    rp_hal_critical_section_begin( );
+    if( rp->hook_table[id] == NULL )
+    {
+        rp_hal_critical_section_end( );
+        return RP_HOOK_STATUS_ID_ERROR;
+    }
+    // A task still queued, running or waiting for its abort callback keeps its hook
+    if( ( rp->hook_table[id]->task.state < RP_TASK_STATE_ABORTED ) || rp_bitset_is_set( rp->aborted_index, id ) )
+    {
+        rp_hal_critical_section_end( );
+        return RP_TASK_STATUS_ALREADY_RUNNING;
+    }
+    rp->hook_table[id] = NULL;
+    // The radio and timer ids keep the last hook they served, they fall back on the built-in hook of rp_init
+    if( rp->radio_task_id == id )
+    {
+        rp->radio_task_id = 0;
+    }
+    if( rp->timer_hook_id == id )
+    {
+        rp->timer_hook_id = 0;
+    }
+    rp_hal_critical_section_end( );
     return RP_HOOK_STATUS_OK;
 }
 
 rp_hook_status_t rp_release_hook( radio_planner_t* rp, uint8_t id )
 {
-    if( id >= RP_NB_HOOKS )
+    if( ( id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[id] == NULL ) )
     {
         smtc_modem_hal_mcu_panic( );
         return RP_HOOK_STATUS_ID_ERROR;
     }
 
-    rp->hook_callbacks[id]                   = NULL;
-    rp->tasks[id].schedule_task_low_priority = false;
+    rp->hook_table[id]->callback                        = NULL;
+    rp->hook_table[id]->task.schedule_task_low_priority = false;
     return RP_HOOK_STATUS_OK;
 }
 
 rp_hook_status_t rp_hook_get_id( const radio_planner_t* rp, const void* hook, uint8_t* id )
 {
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    for( int32_t i = 0; i < RP_NB_HOOKS_MAX; i++ )
     {
-        if( hook == rp->hooks[i] )
+        if( ( rp->hook_table[i] != NULL ) && ( hook == rp->hook_table[i]->hook ) )
         {
             *id = i;
             return RP_HOOK_STATUS_OK;
@@ -264,12 +472,12 @@ rp_hook_status_t rp_task_enqueue( radio_planner_t* rp, const rp_task_t* task, ui
                                   const rp_radio_params_t* radio_params )
 {
     uint8_t hook_id = task->hook_id;
-    if( hook_id >= RP_NB_HOOKS )
+    if( ( hook_id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[hook_id] == NULL ) )
     {
         smtc_modem_hal_mcu_panic( );
         return RP_HOOK_STATUS_ID_ERROR;
     }
-    if( ( task->launch_task_callbacks == NULL ) || ( rp->hook_callbacks[hook_id] == NULL ) )
+    if( ( task->launch_task_callbacks == NULL ) || ( rp->hook_table[hook_id]->callback == NULL ) )
     {
         smtc_modem_hal_mcu_panic( );
         return RP_HOOK_STATUS_ID_ERROR;
@@ -286,32 +494,28 @@ rp_hook_status_t rp_task_enqueue( radio_planner_t* rp, const rp_task_t* task, ui
         return RP_TASK_STATUS_SCHEDULE_TASK_IN_PAST;
     }
 
-    if( rp->tasks[hook_id].state == RP_TASK_STATE_RUNNING )
+    if( rp->hook_table[hook_id]->task.state == RP_TASK_STATE_RUNNING )
     {
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: Task enqueue impossible. Task is already running\n" );
         return RP_TASK_STATUS_ALREADY_RUNNING;
     }
     rp_hal_critical_section_begin( );
-    if( rp->tasks[hook_id].state != RP_TASK_STATE_FINISHED )
+    if( rp->hook_table[hook_id]->task.state != RP_TASK_STATE_FINISHED )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( " RP: WARNING Task is already running\n" );
     }
-    rp->status[hook_id]       = RP_STATUS_TASK_INIT;
-    rp->tasks[hook_id]        = *task;
-    rp->radio_params[hook_id] = *radio_params;
-    rp->payload[hook_id]      = payload;
-    rp->payload_size[hook_id] = payload_size;
-    if( rp->tasks[hook_id].schedule_task_low_priority == true )
-    {
-        rp->tasks[hook_id].priority = ( RP_TASK_STATE_ASAP * RP_NB_HOOKS ) + hook_id;
-    }
-    else
-    {
-        rp->tasks[hook_id].priority = ( rp->tasks[hook_id].state * RP_NB_HOOKS ) + hook_id;
-    }
-    rp->tasks[hook_id].start_time_init_ms = rp->tasks[hook_id].start_time_ms;
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Task #%u enqueue with #%u priority\n", hook_id, rp->tasks[hook_id].priority );
-    rp_task_compute_ranking( rp );
+    // The previous task of this hook, if any, is replaced
+    rp_task_index_remove( rp, hook_id );
+    rp->hook_table[hook_id]->status       = RP_STATUS_TASK_INIT;
+    rp->hook_table[hook_id]->task         = *task;
+    rp->hook_table[hook_id]->radio_params = *radio_params;
+    rp->hook_table[hook_id]->payload      = payload;
+    rp->hook_table[hook_id]->payload_size = payload_size;
+    rp_task_set_priority( rp, hook_id );
+    rp->hook_table[hook_id]->task.start_time_init_ms = rp->hook_table[hook_id]->task.start_time_ms;
+    rp_task_heap_insert( rp, hook_id );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Task #%u enqueue with #%u priority\n", hook_id,
+                                    rp->hook_table[hook_id]->task.priority );
     if( rp->semaphore_radio == 0 )
     {
         rp_task_arbiter( rp, __func__ );
@@ -324,26 +528,26 @@ rp_hook_status_t rp_task_abort( radio_planner_t* rp, const uint8_t hook_id )
 {
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: rp_task_abort \n" );
     rp_hal_critical_section_begin( );
-    if( hook_id >= RP_NB_HOOKS )
+    if( ( hook_id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[hook_id] == NULL ) )
     {
         rp_hal_critical_section_end( );
         smtc_modem_hal_mcu_panic( );
         return RP_HOOK_STATUS_ID_ERROR;
     }
 
-    if( rp->tasks[hook_id].state > RP_TASK_STATE_ABORTED )
+    if( rp->hook_table[hook_id]->task.state > RP_TASK_STATE_ABORTED )
     {
         rp_hal_critical_section_end( );
         return RP_HOOK_STATUS_OK;
     }
 
-    if( rp->tasks[hook_id].state == RP_TASK_STATE_RUNNING )
+    if( rp->hook_table[hook_id]->task.state == RP_TASK_STATE_RUNNING )
     {
         rp_radio_irq( rp );
     }
     else
     {
-        rp->tasks[hook_id].state = RP_TASK_STATE_ABORTED;
+        rp_task_set_aborted( rp, hook_id, RP_ABORT_REASON_USER );
 
         if( rp->semaphore_radio == 0 )
         {
@@ -356,69 +560,113 @@ rp_hook_status_t rp_task_abort( radio_planner_t* rp, const uint8_t hook_id )
 
 void rp_get_status( const radio_planner_t* rp, const uint8_t id, uint32_t* irq_timestamp_ms, rp_status_t* status )
 {
-    if( id >= RP_NB_HOOKS )
+    if( ( id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[id] == NULL ) )
     {
         rp_hal_critical_section_end( );
         smtc_modem_hal_mcu_panic( );
         return;
     }
-    *irq_timestamp_ms = rp->irq_timestamp_ms[id];
-    *status           = rp->status[id];
+    *irq_timestamp_ms = rp->hook_table[id]->irq_timestamp_ms;
+    *status           = rp->hook_table[id]->status;
 }
 
 void rp_get_and_clear_raw_radio_irq( radio_planner_t* rp, const uint8_t id, ral_irq_t* raw_radio_irq )
 {
-    if( id >= RP_NB_HOOKS )
+    if( ( id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[id] == NULL ) )
     {
         rp_hal_critical_section_end( );
         smtc_modem_hal_mcu_panic( );
         return;
     }
-    *raw_radio_irq        = rp->raw_radio_irq[id];
-    rp->raw_radio_irq[id] = 0;
+    *raw_radio_irq                    = rp->hook_table[id]->raw_radio_irq;
+    rp->hook_table[id]->raw_radio_irq = 0;
 }
 rp_stats_t rp_get_stats( const radio_planner_t* rp )
 {
     return rp->stats;
 }
 
+void rp_reset_stats( radio_planner_t* rp )
+{
+    rp_stats_init( &rp->stats );
+    rp->stats.stats_start_ms = rp_hal_get_time_in_ms( );
+    for( int32_t i = 0; i < RP_NB_HOOKS_MAX; i++ )
+    {
+        if( rp->hook_table[i] != NULL )
+        {
+            rp_hook_stats_init( &rp->hook_table[i]->stats );
+        }
+    }
+}
+
+uint16_t rp_get_radio_utilization( const radio_planner_t* rp )
+{
+    uint32_t elapsed_ms = rp_hal_get_time_in_ms( ) - rp->stats.stats_start_ms;
+    uint32_t busy_ms =
+        rp->stats.tx_total_consumption_ms + rp->stats.rx_total_consumption_ms + rp->stats.none_total_consumption_ms;
+
+    if( elapsed_ms == 0 )
+    {
+        return 0;
+    }
+    if( busy_ms >= elapsed_ms )
+    {
+        return 1000;
+    }
+    return ( uint16_t ) ( ( ( uint64_t ) busy_ms * 1000 ) / elapsed_ms );
+}
+
+rp_hook_status_t rp_get_hook_latency_stats( const radio_planner_t* rp, const uint8_t id,
+                                            rp_hook_latency_stats_t* latency_stats )
+{
+    if( ( id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[id] == NULL ) || ( latency_stats == NULL ) )
+    {
+        return RP_HOOK_STATUS_ID_ERROR;
+    }
+    rp_hal_critical_section_begin( );
+    *latency_stats = rp->hook_table[id]->stats.latency;
+    rp_hal_critical_section_end( );
+    return RP_HOOK_STATUS_OK;
+}
+
 void rp_radio_irq( radio_planner_t* rp )
 {
-    if( rp->tasks[rp->radio_task_id].state < RP_TASK_STATE_ABORTED )
+    if( ( rp->hook_table[rp->radio_task_id] != NULL ) &&
+        ( rp->hook_table[rp->radio_task_id]->task.state < RP_TASK_STATE_ABORTED ) )
     {
         rp->semaphore_radio = 1;
 
-        uint32_t irq_timestamp_100us               = rp_hal_get_radio_irq_timestamp_in_100us( );
-        rp->irq_timestamp_100us[rp->radio_task_id] = irq_timestamp_100us;
-        rp->irq_timestamp_ms[rp->radio_task_id]    = rp_hal_get_time_in_ms( );
+        uint32_t irq_timestamp_100us                           = rp_hal_get_radio_irq_timestamp_in_100us( );
+        rp->hook_table[rp->radio_task_id]->irq_timestamp_100us = irq_timestamp_100us;
+        rp->hook_table[rp->radio_task_id]->irq_timestamp_ms    = rp_hal_get_time_in_ms( );
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: INFO - Radio IRQ received for hook #%u\n", rp->radio_task_id );
 
         rp_irq_get_status( rp, rp->radio_task_id );
-        if( rp->status[rp->radio_task_id] == RP_STATUS_LR_FHSS_HOP )
+        if( rp->hook_table[rp->radio_task_id]->status == RP_STATUS_LR_FHSS_HOP )
         {
             return;
         }
 
         // Tx can be performed only if no activity detected on channel
-        if( ( rp->status[rp->radio_task_id] == RP_STATUS_CAD_NEGATIVE ) &&
-            ( rp->tasks[rp->radio_task_id].type == RP_TASK_TYPE_CAD_TO_TX ) )
+        if( ( rp->hook_table[rp->radio_task_id]->status == RP_STATUS_CAD_NEGATIVE ) &&
+            ( rp->hook_table[rp->radio_task_id]->task.type == RP_TASK_TYPE_CAD_TO_TX ) )
         {
             rp_hook_callback( rp, rp->radio_task_id );
             return;
         }
 
         // Rx can be performed if activity detected on channel
-        if( ( rp->status[rp->radio_task_id] == RP_STATUS_CAD_POSITIVE ) &&
-            ( rp->tasks[rp->radio_task_id].type == RP_TASK_TYPE_CAD_TO_RX ) )
+        if( ( rp->hook_table[rp->radio_task_id]->status == RP_STATUS_CAD_POSITIVE ) &&
+            ( rp->hook_table[rp->radio_task_id]->task.type == RP_TASK_TYPE_CAD_TO_RX ) )
         {
             rp_hook_callback( rp, rp->radio_task_id );
             return;
         }
-        rp_consumption_statistics_updated( rp, rp->radio_task_id, rp->irq_timestamp_ms[rp->radio_task_id] );
+        rp_consumption_statistics_updated( rp, rp->radio_task_id, rp->hook_table[rp->radio_task_id]->irq_timestamp_ms );
 
         // Have to call rp_task_free before rp_hook_callback because the callback can enqueued a task and so call the
         // arbiter
-        rp_task_free( rp, &rp->tasks[rp->radio_task_id] );
+        rp_task_free( rp, rp->radio_task_id );
         smtc_modem_hal_assert( ral_set_sleep( &( rp->radio->ral ), true ) == RAL_STATUS_OK );
         rp_hook_callback( rp, rp->radio_task_id );
 
@@ -440,12 +688,29 @@ void rp_radio_irq( radio_planner_t* rp )
 // Private planner utilities implementation
 //
 
-static void rp_task_free( const radio_planner_t* rp, rp_task_t* task )
+static void rp_hook_data_init( rp_hook_t* hook_data, const uint8_t hook_id )
 {
-    task->hook_id            = RP_NB_HOOKS;
+    memset( hook_data, 0, sizeof( rp_hook_t ) );
+    hook_data->task.hook_id                    = hook_id;
+    hook_data->task.type                       = RP_TASK_TYPE_NONE;
+    hook_data->task.launch_task_callbacks      = NULL;
+    hook_data->task.state                      = RP_TASK_STATE_FINISHED;
+    hook_data->task.schedule_task_low_priority = false;
+    hook_data->hook                            = NULL;
+    hook_data->callback                        = NULL;
+    hook_data->status                          = RP_STATUS_TASK_INIT;
+}
+
+static void rp_task_free( radio_planner_t* rp, const uint8_t hook_id )
+{
+    rp_task_t* task = &rp->hook_table[hook_id]->task;
+
+    rp_task_index_remove( rp, hook_id );
+    task->hook_id            = RP_NB_HOOKS_MAX;
     task->start_time_ms      = 0;
     task->start_time_init_ms = 0;
     task->duration_time_ms   = 0;
+    task->slack_ms           = 0;
     //   task->type               = RP_TASK_TYPE_NONE; doesn't clear for suspend feature
     task->state                      = RP_TASK_STATE_FINISHED;
     task->schedule_task_low_priority = false;
@@ -453,43 +718,48 @@ static void rp_task_free( const radio_planner_t* rp, rp_task_t* task )
 
 static void rp_task_update_time( radio_planner_t* rp, uint32_t now )
 {
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    uint8_t late_ids[RP_NB_HOOKS_MAX];
+    uint8_t next_id;
+
+    // An asap task starting at or after now has already been updated with the same time
+    uint8_t nb_late = rp_task_heap_scan( rp, now, late_ids, &next_id );
+
+    for( uint8_t i = 0; i < nb_late; i++ )
     {
-        if( rp->tasks[i].state == RP_TASK_STATE_ASAP )
+        uint8_t id = late_ids[i];
+
+        if( rp->hook_table[id]->task.state == RP_TASK_STATE_ASAP )
         {
-            if( ( int32_t )( now - rp->tasks[i].start_time_init_ms ) > 0 )
+            if( ( int32_t )( now - rp->hook_table[id]->task.start_time_init_ms ) > 0 )
             {
-                rp->tasks[i].start_time_ms = now;
+                rp->hook_table[id]->task.start_time_ms = now;
             }
             // An asap task is automatically switch in schedule task after RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME ms
 
-            if( ( int32_t )( now - rp->tasks[i].start_time_init_ms ) > RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME )
+            if( ( int32_t )( now - rp->hook_table[id]->task.start_time_init_ms ) > RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME )
             {
-                rp->tasks[i].state = RP_TASK_STATE_SCHEDULE;
+                rp->hook_table[id]->task.state = RP_TASK_STATE_SCHEDULE;
                 // Schedule the task @ now + RP_TASK_RE_SCHEDULE_OFFSET_TIME
                 // seconds
-                rp->tasks[i].start_time_ms = now + RP_TASK_RE_SCHEDULE_OFFSET_TIME;
-                if( rp->tasks[i].schedule_task_low_priority == true )
-                {
-                    rp->tasks[i].priority = ( RP_TASK_STATE_ASAP * RP_NB_HOOKS ) + i;
-                }
-                else
-                {
-                    rp->tasks[i].priority = ( rp->tasks[i].state * RP_NB_HOOKS ) + i;
-                }
+                rp->hook_table[id]->task.start_time_ms = now + RP_TASK_RE_SCHEDULE_OFFSET_TIME;
+                // The slack of the task counts from this new start time, not from its enqueue
+                rp->hook_table[id]->task.start_time_init_ms = rp->hook_table[id]->task.start_time_ms;
+                rp_bitset_clear( rp->priority_index, rp->hook_table[id]->task.priority );
+                rp_task_set_priority( rp, id );
 
                 SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: WARNING - SWITCH TASK FROM ASAP TO SCHEDULE \n" );
-                rp_task_compute_ranking( rp );
             }
+            rp_task_heap_insert( rp, id );
         }
     }
 
-    if( ( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING ) &&
-        ( ( rp->tasks[rp->radio_task_id].type == RP_TASK_TYPE_RX_LORA ) ||
-          ( rp->tasks[rp->radio_task_id].type == RP_TASK_TYPE_RX_FSK ) ) )
+    if( ( rp->hook_table[rp->radio_task_id] != NULL ) &&
+        ( rp->hook_table[rp->radio_task_id]->task.state == RP_TASK_STATE_RUNNING ) &&
+        ( ( rp->hook_table[rp->radio_task_id]->task.type == RP_TASK_TYPE_RX_LORA ) ||
+          ( rp->hook_table[rp->radio_task_id]->task.type == RP_TASK_TYPE_RX_FSK ) ) )
     {
-        rp->tasks[rp->radio_task_id].duration_time_ms =
-            now + rp->margin_delay + 2 - rp->tasks[rp->radio_task_id].start_time_ms;
+        rp->hook_table[rp->radio_task_id]->task.duration_time_ms =
+            now + rp->margin_delay + 2 - rp->hook_table[rp->radio_task_id]->task.start_time_ms;
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: Extended duration of radio task #%u time to %lu ms\n", rp->radio_task_id,
                                         now );
     }
@@ -518,7 +788,7 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
                 rp->stats.rp_error++;
                 SMTC_MODEM_HAL_TRACE_ERROR( " RP: ERROR - delay #%d - hook #%d\n", delay, rp->priority_task.hook_id );
 
-                rp->tasks[rp->priority_task.hook_id].state = RP_TASK_STATE_ABORTED;
+                rp_task_set_aborted( rp, rp->priority_task.hook_id, RP_ABORT_REASON_IN_PAST );
             }
         }
         // Case where the high priority task is in the future
@@ -529,11 +799,24 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
         // Case where the high priority task is now
         else
         {
-            if( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING )
+            rp_task_t* radio_task =
+                ( rp->hook_table[rp->radio_task_id] != NULL ) ? &rp->hook_table[rp->radio_task_id]->task : NULL;
+
+            if( ( radio_task != NULL ) && ( radio_task->state == RP_TASK_STATE_RUNNING ) )
             {  // Radio is already running
-                if( rp->tasks[rp->radio_task_id].hook_id != rp->priority_task.hook_id )
+                if( ( radio_task->hook_id != rp->priority_task.hook_id ) &&
+                    ( rp_task_try_shift( rp, rp->priority_task.hook_id,
+                                         radio_task->start_time_ms + radio_task->duration_time_ms ) == true ) )
+                {  // The priority task can wait for the end of the radio task, it is cheaper than preempting it
+                    rp->priority_task = rp->hook_table[rp->priority_task.hook_id]->task;
+                    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Task #%u postponed after running task #%u\n",
+                                                    rp->priority_task.hook_id, rp->radio_task_id );
+                }
+                else if( radio_task->hook_id != rp->priority_task.hook_id )
                 {  // priority task not equal to radio task => abort radio task
-                    rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_ABORTED;
+                    rp->stats.task_preempted_nb++;
+                    rp->stats.preempted_radio_time_ms += now - radio_task->start_time_ms;
+                    rp_task_set_aborted( rp, rp->radio_task_id, RP_ABORT_REASON_PREEMPTED );
                     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Abort running task with hook #%u\n", rp->radio_task_id );
 
                     smtc_modem_hal_assert( ral_set_standby( &( rp->radio->ral ), RAL_STANDBY_CFG_RC ) ==
@@ -544,39 +827,48 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
 
                     smtc_modem_hal_assert( ral_set_sleep( &( rp->radio->ral ), true ) == RAL_STATUS_OK );
 
+                    // The preempted task may be a user one which configured the radio outside of RALF, and its end
+                    // callback is only called after the launch of the priority task
+                    ralf_invalidate_shadow( rp->radio );
+
                     // Shut Down the TCXO
                     smtc_modem_hal_stop_radio_tcxo( );
 
                     rp_consumption_statistics_updated( rp, rp->radio_task_id, rp_hal_get_time_in_ms( ) );
 
-                    rp->radio_task_id                  = rp->priority_task.hook_id;
-                    rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_RUNNING;
+                    rp->radio_task_id = rp->priority_task.hook_id;
+                    rp_task_set_running( rp, rp->radio_task_id );
                     rp_task_launch_current( rp );
                 }  // else case already managed during enqueue task
             }
             else
             {  // Radio is sleeping start priority task on radio
-                rp->radio_task_id                  = rp->priority_task.hook_id;
-                rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_RUNNING;
+                rp->radio_task_id = rp->priority_task.hook_id;
+                rp_task_set_running( rp, rp->radio_task_id );
                 rp_task_launch_current( rp );
             }
         }
         // Timer has expired on a not priority task => Have to abort this task
-        int32_t tmp = ( int32_t )( rp->tasks[rp->timer_hook_id].start_time_ms - now );
+        int32_t tmp = ( rp->hook_table[rp->timer_hook_id] != NULL )
+                          ? ( int32_t )( rp->hook_table[rp->timer_hook_id]->task.start_time_ms - now )
+                          : 0;
 
         if( tmp > 0 )
         {
             if( ( ( uint32_t ) tmp < rp->margin_delay ) && ( rp->next_state_status == RP_STATUS_HAVE_TO_SET_TIMER ) &&
                 ( rp->timer_hook_id != rp->priority_task.hook_id ) &&
-                ( rp->tasks[rp->timer_hook_id].state == RP_TASK_STATE_SCHEDULE ) )
+                ( rp->hook_table[rp->timer_hook_id]->task.state == RP_TASK_STATE_SCHEDULE ) &&
+                ( rp_task_try_shift( rp, rp->timer_hook_id,
+                                     rp->priority_task.start_time_ms + rp->priority_task.duration_time_ms ) == false ) )
             {
                 SMTC_MODEM_HAL_TRACE_WARNING( " RP: Aborted task with hook #%u - not a priority task\n ",
                                               rp->timer_hook_id );
-                rp->tasks[rp->timer_hook_id].state = RP_TASK_STATE_ABORTED;
+                rp_task_set_aborted( rp, rp->timer_hook_id, RP_ABORT_REASON_NOT_PRIORITY );
             }
         }
         // Execute the garbage collection if the radio isn't running
-        if( rp->tasks[rp->radio_task_id].state != RP_TASK_STATE_RUNNING )
+        if( ( rp->hook_table[rp->radio_task_id] == NULL ) ||
+            ( rp->hook_table[rp->radio_task_id]->task.state != RP_TASK_STATE_RUNNING ) )
         {
             rp_task_call_aborted( rp );
         }
@@ -605,10 +897,11 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
 
 static void rp_irq_get_status( radio_planner_t* rp, const uint8_t hook_id )
 {
-    ral_irq_t radio_irq = 0;
+    ral_irq_t  radio_irq = 0;
+    rp_hook_t* hook_data = rp->hook_table[hook_id];
 
-    if( ( rp->tasks[hook_id].type == RP_TASK_TYPE_LBT ) || ( rp->tasks[hook_id].type == RP_TASK_TYPE_WIFI_SNIFF ) ||
-        ( rp->tasks[hook_id].type == RP_TASK_TYPE_GNSS_SNIFF ) )
+    if( ( hook_data->task.type == RP_TASK_TYPE_LBT ) || ( hook_data->task.type == RP_TASK_TYPE_WIFI_SNIFF ) ||
+        ( hook_data->task.type == RP_TASK_TYPE_GNSS_SNIFF ) )
     {
         return;
     }
@@ -619,31 +912,31 @@ static void rp_irq_get_status( radio_planner_t* rp, const uint8_t hook_id )
     }
 
     // Do not modify the order of the next if / else if process
-    rp->raw_radio_irq[hook_id] = radio_irq;
+    hook_data->raw_radio_irq = radio_irq;
     if( ( radio_irq & RAL_IRQ_TX_DONE ) == RAL_IRQ_TX_DONE )
     {
-        rp->status[hook_id] = RP_STATUS_TX_DONE;
+        hook_data->status = RP_STATUS_TX_DONE;
         if( rp->priority_task.type == RP_TASK_TYPE_TX_LR_FHSS )
         {
             smtc_modem_hal_assert( ral_lr_fhss_handle_tx_done( &rp->radio->ral,
-                                                               &rp->radio_params[hook_id].tx.lr_fhss.ral_lr_fhss_params,
+                                                               &hook_data->radio_params.tx.lr_fhss.ral_lr_fhss_params,
                                                                NULL ) == RAL_STATUS_OK );
         }
     }
     else if( ( ( radio_irq & RAL_IRQ_RX_HDR_ERROR ) == RAL_IRQ_RX_HDR_ERROR ) ||
              ( ( radio_irq & RAL_IRQ_RX_CRC_ERROR ) == RAL_IRQ_RX_CRC_ERROR ) )
     {
-        rp->status[hook_id] = RP_STATUS_RX_CRC_ERROR;
+        hook_data->status = RP_STATUS_RX_CRC_ERROR;
     }
     else if( ( radio_irq & RAL_IRQ_RX_TIMEOUT ) == RAL_IRQ_RX_TIMEOUT )
     {
-        rp->status[hook_id] = RP_STATUS_RX_TIMEOUT;
+        hook_data->status = RP_STATUS_RX_TIMEOUT;
     }
     else if( ( radio_irq & RAL_IRQ_RX_DONE ) == RAL_IRQ_RX_DONE )
     {
-        rp->status[hook_id] = RP_STATUS_RX_PACKET;
+        hook_data->status = RP_STATUS_RX_PACKET;
 
-        if( rp_get_pkt_payload( rp, &rp->tasks[hook_id] ) == RP_HOOK_STATUS_ID_ERROR )
+        if( rp_get_pkt_payload( rp, &hook_data->task ) == RP_HOOK_STATUS_ID_ERROR )
         {
             smtc_modem_hal_mcu_panic( );
             return;
@@ -651,210 +944,197 @@ static void rp_irq_get_status( radio_planner_t* rp, const uint8_t hook_id )
     }
     else if( ( radio_irq & RAL_IRQ_CAD_OK ) == RAL_IRQ_CAD_OK )
     {
-        rp->status[hook_id] = RP_STATUS_CAD_POSITIVE;
+        hook_data->status = RP_STATUS_CAD_POSITIVE;
     }
     else if( ( radio_irq & RAL_IRQ_CAD_DONE ) == RAL_IRQ_CAD_DONE )
     {
-        rp->status[hook_id] = RP_STATUS_CAD_NEGATIVE;
+        hook_data->status = RP_STATUS_CAD_NEGATIVE;
     }
     else if( ( radio_irq & RAL_IRQ_LR_FHSS_HOP ) == RAL_IRQ_LR_FHSS_HOP )
     {
-        rp->status[hook_id] = RP_STATUS_LR_FHSS_HOP;
+        hook_data->status = RP_STATUS_LR_FHSS_HOP;
         smtc_modem_hal_assert(
-            ral_lr_fhss_handle_hop( &rp->radio->ral, &rp->radio_params[hook_id].tx.lr_fhss.ral_lr_fhss_params,
-                                    ( ral_lr_fhss_memory_state_t ) rp->radio_params[hook_id].lr_fhss_state ) ==
+            ral_lr_fhss_handle_hop( &rp->radio->ral, &hook_data->radio_params.tx.lr_fhss.ral_lr_fhss_params,
+                                    ( ral_lr_fhss_memory_state_t ) hook_data->radio_params.lr_fhss_state ) ==
             RAL_STATUS_OK );
     }
     else if( ( radio_irq & RAL_IRQ_WIFI_SCAN_DONE ) == RAL_IRQ_WIFI_SCAN_DONE )
     {
-        rp->status[hook_id] = RP_STATUS_WIFI_SCAN_DONE;
+        hook_data->status = RP_STATUS_WIFI_SCAN_DONE;
     }
     else if( ( radio_irq & RAL_IRQ_GNSS_SCAN_DONE ) == RAL_IRQ_GNSS_SCAN_DONE )
     {
-        rp->status[hook_id] = RP_STATUS_GNSS_SCAN_DONE;
+        hook_data->status = RP_STATUS_GNSS_SCAN_DONE;
     }
     else
     {
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: ERROR - IRQ source 0x%04X unknown\n", radio_irq );
-        rp->status[hook_id] = RP_STATUS_TASK_ABORTED;
+        hook_data->status = RP_STATUS_TASK_ABORTED;
     }
 }
 
-static void rp_task_compute_ranking( radio_planner_t* rp )
+static void rp_task_launch_current( radio_planner_t* rp )
 {
-    uint8_t rank;
-    uint8_t ranks_temp[RP_NB_HOOKS];
-
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    uint8_t id = rp->radio_task_id;
+    if( rp->hook_table[id] == NULL )
     {
-        ranks_temp[i] = rp->tasks[i].priority;
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: ERROR - hook #%u is not registered\n", id );
+        return;
     }
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: Launch task #%u and start radio state %u, type %u\n", id,
+                                    rp->hook_table[id]->task.state, rp->hook_table[id]->task.type );
+    if( rp->hook_table[id]->task.launch_task_callbacks == NULL )
+    {
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: ERROR - launch_task_callbacks == NULL \n" );
+    }
+    else
     {
-        rank             = rp_task_find_highest_priority( &( ranks_temp[0] ), RP_NB_HOOKS );
-        ranks_temp[rank] = 0xFF;
-        rp->rankings[i]  = rank;
+        rp_task_print( rp, &rp->hook_table[id]->task );
+        if( rp_task_is_configured_by_ralf( rp->hook_table[id]->task.type ) == false )
+        {
+            // The radio configuration is about to change behind the back of the RALF shadow
+            ralf_invalidate_shadow( rp->radio );
+        }
+        rp->hook_table[id]->task.launch_task_callbacks( ( void* ) rp );
     }
 }
 
-static void rp_task_launch_current( radio_planner_t* rp )
+static bool rp_task_is_configured_by_ralf( const rp_task_types_t type )
 {
-    uint8_t id = rp->radio_task_id;
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: Launch task #%u and start radio state %u, type %u\n", id, rp->tasks[id].state,
-                                    rp->tasks[id].type );
-    if( rp->tasks[id].launch_task_callbacks == NULL )
+    switch( type )
     {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: ERROR - launch_task_callbacks == NULL \n" );
-    }
-    else
-    {
-        rp_task_print( rp, &rp->tasks[id] );
-        rp->tasks[id].launch_task_callbacks( ( void* ) rp );
+    case RP_TASK_TYPE_RX_LORA:
+    case RP_TASK_TYPE_RX_FSK:
+    case RP_TASK_TYPE_TX_LORA:
+    case RP_TASK_TYPE_TX_FSK:
+    case RP_TASK_TYPE_CAD:
+    case RP_TASK_TYPE_CAD_TO_TX:
+    case RP_TASK_TYPE_CAD_TO_RX:
+        return true;
+    default:
+        return false;
     }
 }
 
 static uint8_t rp_task_select_next( radio_planner_t* rp, const uint32_t now )
 {
-    uint8_t  hook_to_exe_tmp      = 0xFF;
-    uint32_t hook_time_to_exe_tmp = 0;
-    uint32_t time_tmp             = 0;
-    uint8_t  rank                 = 0;
-    uint8_t  hook_id              = 0;
+    uint8_t late_ids[RP_NB_HOOKS_MAX];
+    uint8_t nb_late;
+    uint8_t next_id;
 
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
-    {  // Garbage collector
-        if( ( rp->tasks[hook_id].state == RP_TASK_STATE_SCHEDULE ) &&
-            ( ( ( int32_t )( rp->tasks[hook_id].start_time_ms - now ) < 0 ) ) )
-        {
-            rp->tasks[hook_id].state = RP_TASK_STATE_ABORTED;
-        }
-    }
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
+    // Garbage collector, a late schedule task is started now if it is still in its slack
+    nb_late = rp_task_heap_scan( rp, now, late_ids, &next_id );
+    for( uint8_t i = 0; i < nb_late; i++ )
     {
-        rank = rp->rankings[hook_id];
-        if( ( ( rp->tasks[rank].state < RP_TASK_STATE_RUNNING ) &&
-              ( ( int32_t )( rp->tasks[rank].start_time_ms - now ) >= 0 ) ) ||
-            ( rp->tasks[rank].state == RP_TASK_STATE_RUNNING ) )
+        if( ( rp->hook_table[late_ids[i]]->task.state == RP_TASK_STATE_SCHEDULE ) &&
+            ( rp_task_try_shift( rp, late_ids[i], now ) == false ) )
         {
-            hook_to_exe_tmp      = rp->tasks[rank].hook_id;
-            hook_time_to_exe_tmp = rp->tasks[rank].start_time_ms;
-            break;
+            rp_task_set_aborted( rp, late_ids[i], RP_ABORT_REASON_LATE );
         }
     }
-    if( hook_id == RP_NB_HOOKS )
+
+    // All the pending tasks are now in the future or asap, so the highest priority task is the first one of the index
+    uint8_t priority = rp_bitset_find_next( rp->priority_index, RP_PRIORITY_INDEX_WORDS, 0 );
+    if( priority == RP_BITSET_NONE )
     {
         return RP_NO_MORE_TASK;
     }
+    uint8_t  hook_to_exe_tmp      = priority % RP_NB_HOOKS_MAX;
+    uint32_t hook_time_to_exe_tmp = rp->hook_table[hook_to_exe_tmp]->task.start_time_ms;
 
-    for( int32_t i = hook_id; i < RP_NB_HOOKS; i++ )
+    // A lower priority task is selected if it ends before the start of the selected one: only the pending tasks
+    // starting before it and the running task can do so, they are checked from the highest to the lowest priority
+    uint32_t candidates[RP_PRIORITY_INDEX_WORDS] = { 0 };
+
+    nb_late = rp_task_heap_scan( rp, hook_time_to_exe_tmp, late_ids, &next_id );
+    for( uint8_t i = 0; i < nb_late; i++ )
     {
-        rank = rp->rankings[i];
-        if( ( ( rp->tasks[rank].state < RP_TASK_STATE_RUNNING ) &&
-              ( ( int32_t )( rp->tasks[rank].start_time_ms - now ) >= 0 ) ) ||
-            ( rp->tasks[rank].state == RP_TASK_STATE_RUNNING ) )
-        {
-            time_tmp = rp->tasks[rank].start_time_ms + rp->tasks[rank].duration_time_ms;
+        rp_bitset_set( candidates, rp->hook_table[late_ids[i]]->task.priority );
+    }
+    if( ( rp->hook_table[rp->radio_task_id] != NULL ) &&
+        ( rp->hook_table[rp->radio_task_id]->task.state == RP_TASK_STATE_RUNNING ) )
+    {
+        rp_bitset_set( candidates, rp->hook_table[rp->radio_task_id]->task.priority );
+    }
 
-            int32_t tmp = ( int32_t )( time_tmp - hook_time_to_exe_tmp );
-            if( ( tmp < 0 ) && ( ( int32_t )( time_tmp - now ) >= 0 ) )
-            {
-                hook_to_exe_tmp      = rp->tasks[rank].hook_id;
-                hook_time_to_exe_tmp = rp->tasks[rank].start_time_ms;
-            }
+    for( uint8_t rank = rp_bitset_find_next( candidates, RP_PRIORITY_INDEX_WORDS, priority + 1 );
+         rank != RP_BITSET_NONE; rank = rp_bitset_find_next( candidates, RP_PRIORITY_INDEX_WORDS, rank + 1 ) )
+    {
+        uint8_t  id       = rank % RP_NB_HOOKS_MAX;
+        uint32_t time_tmp = rp->hook_table[id]->task.start_time_ms + rp->hook_table[id]->task.duration_time_ms;
+
+        int32_t tmp = ( int32_t )( time_tmp - hook_time_to_exe_tmp );
+        if( ( tmp < 0 ) && ( ( int32_t )( time_tmp - now ) >= 0 ) )
+        {
+            hook_to_exe_tmp      = id;
+            hook_time_to_exe_tmp = rp->hook_table[id]->task.start_time_ms;
         }
     }
-    rp->priority_task = rp->tasks[hook_to_exe_tmp];
+    rp->priority_task = rp->hook_table[hook_to_exe_tmp]->task;
     return RP_SOMETHING_TO_DO;
 }
 
 static rp_next_state_status_t rp_task_get_next( radio_planner_t* rp, uint32_t* duration, uint8_t* task_id,
                                                 const uint32_t now )
 {
-    uint8_t  hook_id  = 0;
-    uint8_t  index    = 0;
-    uint32_t time_tmp = now;
+    uint8_t late_ids[RP_NB_HOOKS_MAX];
+    uint8_t next_id;
+    uint8_t nb_late = rp_task_heap_scan( rp, now, late_ids, &next_id );
 
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
+    for( uint8_t i = 0; i < nb_late; i++ )
     {  // Garbage collector
-        if( ( rp->tasks[hook_id].state == RP_TASK_STATE_SCHEDULE ) &&
-            ( ( ( int32_t )( rp->tasks[hook_id].start_time_ms - time_tmp ) < 0 ) ) )
+        if( ( rp->hook_table[late_ids[i]]->task.state == RP_TASK_STATE_SCHEDULE ) &&
+            ( rp_task_try_shift( rp, late_ids[i], now ) == false ) )
         {
-            rp->tasks[hook_id].state = RP_TASK_STATE_ABORTED;
+            rp_task_set_aborted( rp, late_ids[i], RP_ABORT_REASON_LATE );
         }
-    }
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
-    {
-        if( ( rp->tasks[hook_id].state < RP_TASK_STATE_RUNNING ) &&
-            ( ( ( int32_t )( rp->tasks[hook_id].start_time_ms - time_tmp ) >= 0 ) ) )
-        {
-            time_tmp = rp->tasks[hook_id].start_time_ms;
-            index    = hook_id;
-            break;
+        else if( ( int32_t )( rp->hook_table[late_ids[i]]->task.start_time_ms - now ) >= 0 )
+        {  // A shifted task can be the next one
+            if( ( next_id == RP_NB_HOOKS_MAX ) || rp_task_heap_is_before( rp, late_ids[i], next_id ) )
+            {
+                next_id = late_ids[i];
+            }
         }
     }
-    if( hook_id == RP_NB_HOOKS )
+    if( next_id == RP_NB_HOOKS_MAX )
     {
         return RP_STATUS_NO_MORE_TASK_SCHEDULE;
     }
 
-    for( uint8_t i = hook_id; i < RP_NB_HOOKS; i++ )
-    {
-        if( ( rp->tasks[i].state < RP_TASK_STATE_RUNNING ) &&
-            ( ( int32_t )( rp->tasks[i].start_time_ms - time_tmp ) < 0 ) &&
-            ( ( int32_t )( rp->tasks[i].start_time_ms - now ) >= 0 ) )
-        {
-            time_tmp = rp->tasks[i].start_time_ms;
-            index    = i;
-        }
-    }
-    *task_id  = index;
-    *duration = time_tmp - now;
+    *task_id  = next_id;
+    *duration = rp->hook_table[next_id]->task.start_time_ms - now;
     return RP_STATUS_HAVE_TO_SET_TIMER;
 }
 
-static uint8_t rp_task_find_highest_priority( uint8_t* vector, uint8_t length )
-{
-    uint8_t priority_high = 0xFF;
-    uint8_t index         = 0;
-
-    for( int32_t i = 0; i < length; i++ )
-    {
-        if( vector[i] <= priority_high )
-        {
-            priority_high = vector[i];
-            index         = i;
-        }
-    }
-    return index;
-}
-
 rp_hook_status_t rp_get_pkt_payload( radio_planner_t* rp, const rp_task_t* task )
 {
-    rp_hook_status_t status = RP_HOOK_STATUS_OK;
-    uint8_t          id     = task->hook_id;
+    rp_hook_status_t status    = RP_HOOK_STATUS_OK;
+    rp_hook_t*       hook_data = rp->hook_table[task->hook_id];
 
     if( ( task->type == RP_TASK_TYPE_USER ) || ( task->type == RP_TASK_TYPE_NONE ) )
     {
         return status;  // don't catch the payload in case of user task
     }
-    smtc_modem_hal_assert( ral_get_pkt_payload( &( rp->radio->ral ), rp->payload_size[id], rp->payload[id],
-                                                &rp->payload_size[id] ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_get_pkt_payload( &( rp->radio->ral ), hook_data->payload_size, hook_data->payload,
+                                                &hook_data->payload_size ) == RAL_STATUS_OK );
 
     if( ( task->type == RP_TASK_TYPE_RX_LORA ) || ( task->type == RP_TASK_TYPE_CAD_TO_RX ) )
     {
-        rp->radio_params[id].pkt_type = RAL_PKT_TYPE_LORA;
-        status                        = RP_HOOK_STATUS_OK;
+        hook_data->radio_params.pkt_type = RAL_PKT_TYPE_LORA;
+        status                           = RP_HOOK_STATUS_OK;
 
-        smtc_modem_hal_assert( ral_get_lora_rx_pkt_status(
-                                   &( rp->radio->ral ), &rp->radio_params[id].rx.lora_pkt_status ) == RAL_STATUS_OK );
+        smtc_modem_hal_assert( ral_get_lora_rx_pkt_status( &( rp->radio->ral ),
+                                                           &hook_data->radio_params.rx.lora_pkt_status ) ==
+                               RAL_STATUS_OK );
     }
     else if( task->type == RP_TASK_TYPE_RX_FSK )
     {
-        rp->radio_params[id].pkt_type = RAL_PKT_TYPE_GFSK;
-        status                        = RP_HOOK_STATUS_OK;
+        hook_data->radio_params.pkt_type = RAL_PKT_TYPE_GFSK;
+        status                           = RP_HOOK_STATUS_OK;
 
-        smtc_modem_hal_assert( ral_get_gfsk_rx_pkt_status(
-                                   &( rp->radio->ral ), &rp->radio_params[id].rx.gfsk_pkt_status ) == RAL_STATUS_OK );
+        smtc_modem_hal_assert( ral_get_gfsk_rx_pkt_status( &( rp->radio->ral ),
+                                                           &hook_data->radio_params.rx.gfsk_pkt_status ) ==
+                               RAL_STATUS_OK );
     }
     else
     {
@@ -877,46 +1157,298 @@ static void rp_timer_irq( radio_planner_t* rp )
 
 static void rp_task_call_aborted( radio_planner_t* rp )
 {
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    // A hook callback may abort or enqueue other tasks, so the index is read again after each of them
+    for( uint8_t i = rp_bitset_find_next( rp->aborted_index, RP_HOOK_INDEX_WORDS, 0 ); i != RP_BITSET_NONE;
+         i         = rp_bitset_find_next( rp->aborted_index, RP_HOOK_INDEX_WORDS, i + 1 ) )
+    {
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: INFO - Aborted hook # %d callback\n", i );
+        rp->hook_table[i]->stats.task_hook_aborted_nb++;
+        rp_task_free( rp, i );
+        rp->hook_table[i]->status = RP_STATUS_TASK_ABORTED;
+        rp_hook_callback( rp, i );
+    }
+}
+
+//
+// Task indexes
+//
+// The pending tasks (schedule and asap) are kept in a min-heap ordered by start time, and the pending and running
+// tasks are flagged in a bitset indexed by priority. A priority is ( state * RP_NB_HOOKS_MAX ) + hook_id, so each
+// priority level belongs to a single hook and the hook id is found back with a modulo.
+//
+
+static void rp_task_set_priority( radio_planner_t* rp, const uint8_t hook_id )
+{
+    if( rp->hook_table[hook_id]->task.schedule_task_low_priority == true )
+    {
+        rp->hook_table[hook_id]->task.priority = ( RP_TASK_STATE_ASAP * RP_NB_HOOKS_MAX ) + hook_id;
+    }
+    else
+    {
+        rp->hook_table[hook_id]->task.priority = ( rp->hook_table[hook_id]->task.state * RP_NB_HOOKS_MAX ) + hook_id;
+    }
+    rp_bitset_set( rp->priority_index, rp->hook_table[hook_id]->task.priority );
+}
+
+static void rp_task_set_running( radio_planner_t* rp, const uint8_t hook_id )
+{
+    rp_task_t* task = &rp->hook_table[hook_id]->task;
+
+    rp_stats_launch_update( &rp->hook_table[hook_id]->stats, rp_hal_get_time_in_ms( ), task->start_time_ms,
+                            task->start_time_init_ms, task->state == RP_TASK_STATE_ASAP );
+    rp_task_heap_remove( rp, hook_id );
+    task->state = RP_TASK_STATE_RUNNING;
+}
+
+static void rp_task_set_aborted( radio_planner_t* rp, const uint8_t hook_id, const rp_abort_reason_t reason )
+{
+    rp_stats_abort_update( &rp->hook_table[hook_id]->stats, reason );
+    rp_task_index_remove( rp, hook_id );
+    rp->hook_table[hook_id]->task.state = RP_TASK_STATE_ABORTED;
+    rp_bitset_set( rp->aborted_index, hook_id );
+}
+
+static bool rp_task_try_shift( radio_planner_t* rp, const uint8_t hook_id, const uint32_t start_time_ms )
+{
+    rp_task_t* task  = &rp->hook_table[hook_id]->task;
+    int32_t    shift = ( int32_t )( start_time_ms - task->start_time_ms );
+
+    if( ( task->state != RP_TASK_STATE_SCHEDULE ) || ( task->slack_ms == 0 ) || ( shift < 0 ) ||
+        ( ( int32_t )( start_time_ms - task->start_time_init_ms ) > ( int32_t ) task->slack_ms ) )
     {
-        if( rp->tasks[i].state == RP_TASK_STATE_ABORTED )
+        return false;
+    }
+    if( ( shift > 0 ) && ( task->shift_task_check_callbacks != NULL ) &&
+        ( task->shift_task_check_callbacks( rp->hook_table[hook_id]->hook, start_time_ms ) == false ) )
+    {
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: Task #%u can not be postponed to %u\n", hook_id, start_time_ms );
+        return false;
+    }
+    if( shift > 0 )
+    {
+        task->start_time_ms += shift;
+        task->start_time_100us += shift * 10;
+        rp_task_heap_insert( rp, hook_id );
+        rp->hook_table[hook_id]->stats.task_hook_shifted_nb++;
+        rp->stats.task_shifted_nb++;
+    }
+    return true;
+}
+
+static void rp_task_index_remove( radio_planner_t* rp, const uint8_t hook_id )
+{
+    rp_task_heap_remove( rp, hook_id );
+    // The priority of a finished or aborted task is not meaningful anymore (and is 0 before the first enqueue)
+    if( rp->hook_table[hook_id]->task.state <= RP_TASK_STATE_RUNNING )
+    {
+        rp_bitset_clear( rp->priority_index, rp->hook_table[hook_id]->task.priority );
+    }
+    rp_bitset_clear( rp->aborted_index, hook_id );
+}
+
+static bool rp_task_heap_is_before( const radio_planner_t* rp, const uint8_t id_a, const uint8_t id_b )
+{
+    int32_t diff = ( int32_t )( rp->hook_table[id_a]->task.start_time_ms - rp->hook_table[id_b]->task.start_time_ms );
+
+    return ( diff < 0 ) || ( ( diff == 0 ) && ( id_a < id_b ) );
+}
+
+static void rp_task_heap_sift( radio_planner_t* rp, uint8_t pos )
+{
+    uint8_t id = rp->task_heap[pos];
+
+    // Move the task up while it starts before its parent
+    while( ( pos > 0 ) && rp_task_heap_is_before( rp, id, rp->task_heap[( pos - 1 ) >> 1] ) )
+    {
+        uint8_t parent                             = ( pos - 1 ) >> 1;
+        rp->task_heap[pos]                         = rp->task_heap[parent];
+        rp->task_heap_position[rp->task_heap[pos]] = pos;
+        pos                                        = parent;
+    }
+
+    // Move the task down while one of its children starts before it
+    for( ;; )
+    {
+        uint8_t child = ( 2 * pos ) + 1;
+
+        if( child >= rp->task_heap_size )
         {
-            SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: INFO - Aborted hook # %d callback\n", i );
-            rp->stats.task_hook_aborted_nb[i]++;
-            rp_task_free( rp, &rp->tasks[i] );
-            rp->status[i] = RP_STATUS_TASK_ABORTED;
-            rp_hook_callback( rp, i );
+            break;
+        }
+        if( ( ( child + 1 ) < rp->task_heap_size ) &&
+            rp_task_heap_is_before( rp, rp->task_heap[child + 1], rp->task_heap[child] ) )
+        {
+            child++;
+        }
+        if( rp_task_heap_is_before( rp, id, rp->task_heap[child] ) )
+        {
+            break;
         }
+        rp->task_heap[pos]                         = rp->task_heap[child];
+        rp->task_heap_position[rp->task_heap[pos]] = pos;
+        pos                                        = child;
+    }
+
+    rp->task_heap[pos]         = id;
+    rp->task_heap_position[id] = pos;
+}
+
+static void rp_task_heap_insert( radio_planner_t* rp, const uint8_t hook_id )
+{
+    if( rp->task_heap_position[hook_id] == RP_TASK_HEAP_NONE )
+    {
+        rp->task_heap_position[hook_id]     = rp->task_heap_size;
+        rp->task_heap[rp->task_heap_size++] = hook_id;
+    }
+    rp_task_heap_sift( rp, rp->task_heap_position[hook_id] );
+}
+
+static void rp_task_heap_remove( radio_planner_t* rp, const uint8_t hook_id )
+{
+    uint8_t pos = rp->task_heap_position[hook_id];
+
+    if( pos == RP_TASK_HEAP_NONE )
+    {
+        return;
+    }
+    rp->task_heap_position[hook_id] = RP_TASK_HEAP_NONE;
+    rp->task_heap_size--;
+
+    // The last task of the heap takes the free position
+    if( pos != rp->task_heap_size )
+    {
+        rp->task_heap[pos]                         = rp->task_heap[rp->task_heap_size];
+        rp->task_heap_position[rp->task_heap[pos]] = pos;
+        rp_task_heap_sift( rp, pos );
     }
 }
 
+static uint8_t rp_task_heap_scan( const radio_planner_t* rp, const uint32_t time, uint8_t* late_ids,
+                                  uint8_t* next_id )
+{
+    uint8_t stack[RP_NB_HOOKS_MAX];
+    uint8_t stack_size = 0;
+    uint8_t nb_late    = 0;
+
+    *next_id = RP_NB_HOOKS_MAX;
+    if( rp->task_heap_size > 0 )
+    {
+        stack[stack_size++] = 0;
+    }
+
+    // A task starting at or after time hides its whole subtree, and the first of these tasks is the next one
+    while( stack_size > 0 )
+    {
+        uint8_t pos = stack[--stack_size];
+        uint8_t id  = rp->task_heap[pos];
+
+        if( ( int32_t )( rp->hook_table[id]->task.start_time_ms - time ) < 0 )
+        {
+            late_ids[nb_late++] = id;
+            for( uint8_t child = ( 2 * pos ) + 1; ( child <= ( ( 2 * pos ) + 2 ) ) && ( child < rp->task_heap_size );
+                 child++ )
+            {
+                stack[stack_size++] = child;
+            }
+        }
+        else if( ( *next_id == RP_NB_HOOKS_MAX ) || rp_task_heap_is_before( rp, id, *next_id ) )
+        {
+            *next_id = id;
+        }
+    }
+    return nb_late;
+}
+
+static void rp_bitset_set( uint32_t* bitset, const uint8_t bit )
+{
+    bitset[bit >> 5] |= ( 1UL << ( bit & 0x1F ) );
+}
+
+static void rp_bitset_clear( uint32_t* bitset, const uint8_t bit )
+{
+    bitset[bit >> 5] &= ~( 1UL << ( bit & 0x1F ) );
+}
+
+static bool rp_bitset_is_set( const uint32_t* bitset, const uint8_t bit )
+{
+    return ( bitset[bit >> 5] & ( 1UL << ( bit & 0x1F ) ) ) != 0;
+}
+
+static uint8_t rp_bitset_find_next( const uint32_t* bitset, const uint8_t nb_words, const uint8_t from )
+{
+    uint8_t word = from >> 5;
+
+    if( word >= nb_words )
+    {
+        return RP_BITSET_NONE;
+    }
+    uint32_t bits = bitset[word] & ( 0xFFFFFFFFUL << ( from & 0x1F ) );
+    while( bits == 0 )
+    {
+        if( ++word >= nb_words )
+        {
+            return RP_BITSET_NONE;
+        }
+        bits = bitset[word];
+    }
+#if defined( __GNUC__ )
+    return ( word << 5 ) + __builtin_ctz( bits );
+#else
+    uint8_t bit = 0;
+    while( ( bits & 1 ) == 0 )
+    {
+        bits >>= 1;
+        bit++;
+    }
+    return ( word << 5 ) + bit;
+#endif
+}
+
 //
 // Radio planner callbacks
 //
 
 void rp_radio_irq_callback( void* obj )
 {
-    rp_radio_irq( ( radio_planner_t* ) obj );
+    radio_planner_t* rp               = ( radio_planner_t* ) obj;
+    void*            previous_context = rp_irq_context_select( rp, rp->irq_context );
+
+    rp_radio_irq( rp );
+    rp_irq_context_select( rp, previous_context );
 }
 
 static void rp_timer_irq_callback( void* obj )
 {
-    rp_timer_irq( ( radio_planner_t* ) obj );
+    radio_planner_t* rp               = ( radio_planner_t* ) obj;
+    void*            previous_context = rp_irq_context_select( rp, rp->irq_context );
+
+    rp_timer_irq( rp );
+    rp_irq_context_select( rp, previous_context );
+}
+
+static void* rp_irq_context_select( radio_planner_t* rp, void* context )
+{
+    return ( rp->irq_context_select != NULL ) ? rp->irq_context_select( context ) : NULL;
 }
 
 static void rp_hook_callback( radio_planner_t* rp, uint8_t id )
 {
-    if( id >= RP_NB_HOOKS )
+    if( ( id >= RP_NB_HOOKS_MAX ) || ( rp->hook_table[id] == NULL ) )
     {
         smtc_modem_hal_mcu_panic( );
         return;
     }
-    if( rp->hook_callbacks[id] == NULL )
+    if( rp->hook_table[id]->callback == NULL )
     {
         smtc_modem_hal_mcu_panic( );
         return;
     }
-    rp->hook_callbacks[id]( rp->hooks[id] );
+    if( rp->hook_table[id]->status != RP_STATUS_TASK_ABORTED )
+    {  // Radio irq of the task
+        rp_stats_histogram_add( &rp->hook_table[id]->stats.latency.irq_to_callback_100us,
+                                rp_hal_get_time_in_100us( ) - rp->hook_table[id]->irq_timestamp_100us );
+    }
+    rp->hook_table[id]->callback( rp->hook_table[id]->hook );
 }
 
 //
@@ -969,40 +1501,41 @@ static void rp_task_print( const radio_planner_t* rp, const rp_task_t* task )
 
 static void rp_consumption_statistics_updated( radio_planner_t* rp, const uint8_t hook_id, const uint32_t time )
 {
-    uint32_t micro_ampere_radio = 0, micro_ampere_process = 0;
-    uint32_t radio_t = 0, process_t = 0;
+    uint32_t   micro_ampere_radio = 0, micro_ampere_process = 0;
+    uint32_t   radio_t = 0, process_t = 0;
+    rp_hook_t* hook_data = rp->hook_table[hook_id];
 
-    if( rp->tasks[hook_id].type == RP_TASK_TYPE_RX_LORA )
+    if( hook_data->task.type == RP_TASK_TYPE_RX_LORA )
     {
-        ral_get_lora_rx_consumption_in_ua( &( rp->radio->ral ), rp->radio_params[hook_id].rx.lora.mod_params.bw, false,
+        ral_get_lora_rx_consumption_in_ua( &( rp->radio->ral ), hook_data->radio_params.rx.lora.mod_params.bw, false,
                                            &micro_ampere_radio );
     }
-    else if( rp->tasks[hook_id].type == RP_TASK_TYPE_RX_FSK )
+    else if( hook_data->task.type == RP_TASK_TYPE_RX_FSK )
     {
-        ral_get_gfsk_rx_consumption_in_ua( &( rp->radio->ral ), rp->radio_params[hook_id].rx.gfsk.mod_params.br_in_bps,
-                                           rp->radio_params[hook_id].rx.gfsk.mod_params.bw_dsb_in_hz, false,
+        ral_get_gfsk_rx_consumption_in_ua( &( rp->radio->ral ), hook_data->radio_params.rx.gfsk.mod_params.br_in_bps,
+                                           hook_data->radio_params.rx.gfsk.mod_params.bw_dsb_in_hz, false,
                                            &micro_ampere_radio );
     }
-    else if( rp->tasks[hook_id].type == RP_TASK_TYPE_TX_LORA )
+    else if( hook_data->task.type == RP_TASK_TYPE_TX_LORA )
     {
-        ral_get_tx_consumption_in_ua( &( rp->radio->ral ), rp->radio_params[hook_id].tx.lora.output_pwr_in_dbm,
-                                      rp->radio_params[hook_id].tx.lora.rf_freq_in_hz, &micro_ampere_radio );
+        ral_get_tx_consumption_in_ua( &( rp->radio->ral ), hook_data->radio_params.tx.lora.output_pwr_in_dbm,
+                                      hook_data->radio_params.tx.lora.rf_freq_in_hz, &micro_ampere_radio );
     }
-    else if( rp->tasks[hook_id].type == RP_TASK_TYPE_TX_FSK )
+    else if( hook_data->task.type == RP_TASK_TYPE_TX_FSK )
     {
-        ral_get_tx_consumption_in_ua( &( rp->radio->ral ), rp->radio_params[hook_id].tx.gfsk.output_pwr_in_dbm,
-                                      rp->radio_params[hook_id].tx.gfsk.rf_freq_in_hz, &micro_ampere_radio );
+        ral_get_tx_consumption_in_ua( &( rp->radio->ral ), hook_data->radio_params.tx.gfsk.output_pwr_in_dbm,
+                                      hook_data->radio_params.tx.gfsk.rf_freq_in_hz, &micro_ampere_radio );
     }
-    // else if( rp->tasks[hook_id].type == RP_TASK_TYPE_TX_LR_FHSS )  // TODO uncomment when LR-FHSS consumption will be
+    // else if( hook_data->task.type == RP_TASK_TYPE_TX_LR_FHSS )  // TODO uncomment when LR-FHSS consumption will be
     // developed
     // {
-    //     ral_get_tx_consumption_in_ua( &( rp->radio->ral ), rp->radio_params[hook_id].tx.lr_fhss.output_pwr_in_dbm,
-    //                                   rp->radio_params[hook_id].tx.lr_fhss.ral_lr_fhss_params.rf_freq_in_hz,
+    //     ral_get_tx_consumption_in_ua( &( rp->radio->ral ), hook_data->radio_params.tx.lr_fhss.output_pwr_in_dbm,
+    //                                   hook_data->radio_params.tx.lr_fhss.ral_lr_fhss_params.rf_freq_in_hz,
     //                                   &micro_ampere_radio );
     // }
 #if defined( LR1110_MODEM_E ) && defined( _MODEM_E_GNSS_ENABLE )
-    else if( ( rp->tasks[hook_id].type == RP_TASK_TYPE_GNSS_SNIFF ) ||
-             ( rp->tasks[hook_id].type == RP_TASK_TYPE_GNSS_RSSI ) )
+    else if( ( hook_data->task.type == RP_TASK_TYPE_GNSS_SNIFF ) ||
+             ( hook_data->task.type == RP_TASK_TYPE_GNSS_RSSI ) )
     {
         rp_hal_get_gnss_conso_us( &radio_t, &process_t );
         micro_ampere_radio   = 10000;
@@ -1011,8 +1544,8 @@ static void rp_consumption_statistics_updated( radio_planner_t* rp, const uint8_
 #endif  // LR1110_MODEM_E && _MODEM_E_GNSS_ENABLE
 
 #if defined( LR1110_MODEM_E ) && defined( _MODEM_E_WIFI_ENABLE )
-    else if( ( rp->tasks[hook_id].type == RP_TASK_TYPE_WIFI_SNIFF ) ||
-             ( rp->tasks[hook_id].type == RP_TASK_TYPE_WIFI_RSSI ) )
+    else if( ( hook_data->task.type == RP_TASK_TYPE_WIFI_SNIFF ) ||
+             ( hook_data->task.type == RP_TASK_TYPE_WIFI_RSSI ) )
     {
         rp_hal_get_wifi_conso_us( &radio_t, &process_t );
         micro_ampere_radio   = 11000;
@@ -1020,16 +1553,14 @@ static void rp_consumption_statistics_updated( radio_planner_t* rp, const uint8_
     }
 #endif  // LR1110_MODEM_E && _MODEM_E_WIFI_ENABLE
 
-    if( ( rp->tasks[hook_id].type == RP_TASK_TYPE_GNSS_SNIFF ) ||
-        ( rp->tasks[hook_id].type == RP_TASK_TYPE_GNSS_RSSI ) ||
-        ( rp->tasks[hook_id].type == RP_TASK_TYPE_WIFI_SNIFF ) ||
-        ( rp->tasks[hook_id].type == RP_TASK_TYPE_WIFI_RSSI ) )
+    if( ( hook_data->task.type == RP_TASK_TYPE_GNSS_SNIFF ) || ( hook_data->task.type == RP_TASK_TYPE_GNSS_RSSI ) ||
+        ( hook_data->task.type == RP_TASK_TYPE_WIFI_SNIFF ) || ( hook_data->task.type == RP_TASK_TYPE_WIFI_RSSI ) )
     {
-        rp_stats_sniff_update( &rp->stats, time, radio_t, process_t, hook_id, micro_ampere_radio,
+        rp_stats_sniff_update( &rp->stats, &hook_data->stats, time, radio_t, process_t, micro_ampere_radio,
                                micro_ampere_process );
     }
     else
     {
-        rp_stats_update( &rp->stats, time, hook_id, micro_ampere_radio );
+        rp_stats_update( &rp->stats, &hook_data->stats, time, micro_ampere_radio );
     }
 }
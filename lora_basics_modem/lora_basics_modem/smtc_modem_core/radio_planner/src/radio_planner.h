@@ -68,34 +68,51 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/*!
+ * Per-hook data of the radio planner. The built-in hooks (enum RP_HOOK_ID_DEF) are stored in the radio planner
+ * itself, the hooks added with rp_hook_register() are stored by the caller
+ */
+typedef struct rp_hook_s
+{
+    rp_task_t         task;
+    rp_radio_params_t radio_params;
+    uint8_t*          payload;
+    uint16_t          payload_size;
+    void*             hook;
+    void ( *callback )( void* );
+    rp_status_t     status;
+    ral_irq_t       raw_radio_irq;
+    uint32_t        irq_timestamp_ms;
+    uint32_t        irq_timestamp_100us;
+    rp_hook_stats_t stats;
+} rp_hook_t;
+
 /*!
  *
  */
 typedef struct radio_planner_s
 {
-    rp_task_t         priority_task;
-    rp_radio_params_t radio_params[RP_NB_HOOKS];
-    rp_task_t         tasks[RP_NB_HOOKS];
-    uint8_t*          payload[RP_NB_HOOKS];
-    uint16_t          payload_size[RP_NB_HOOKS];
-    uint8_t           rankings[RP_NB_HOOKS];
-    void*             hooks[RP_NB_HOOKS];
-    rp_status_t       status[RP_NB_HOOKS];
-    ral_irq_t         raw_radio_irq[RP_NB_HOOKS];
-    uint32_t          irq_timestamp_ms[RP_NB_HOOKS];
-    uint32_t          irq_timestamp_100us[RP_NB_HOOKS];
-    rp_stats_t        stats;
-    uint8_t           hook_to_execute;
-    uint32_t          hook_to_execute_time_ms;
-    uint8_t           radio_task_id;
-    uint8_t           timer_task_id;
-    uint8_t           semaphore_radio;
-    uint32_t          timer_value;
-    uint8_t           timer_hook_id;
-    void ( *hook_callbacks[RP_NB_HOOKS] )( void* );
+    rp_task_t  priority_task;
+    rp_hook_t* hook_table[RP_NB_HOOKS_MAX];          // NULL for the ids which are not registered
+    rp_hook_t  hook_builtin[RP_NB_HOOKS];            // storage of the built-in hooks
+    uint8_t    task_heap[RP_NB_HOOKS_MAX];           // pending tasks, min-heap ordered by start time
+    uint8_t    task_heap_position[RP_NB_HOOKS_MAX];  // position of each hook in task_heap
+    uint8_t    task_heap_size;
+    uint32_t   priority_index[RP_PRIORITY_INDEX_WORDS];  // priorities of the pending and running tasks
+    uint32_t   aborted_index[RP_HOOK_INDEX_WORDS];       // hooks with an aborted task to be notified
+    rp_stats_t stats;
+    uint8_t    hook_to_execute;
+    uint32_t   hook_to_execute_time_ms;
+    uint8_t    radio_task_id;
+    uint8_t    timer_task_id;
+    uint8_t    semaphore_radio;
+    uint32_t   timer_value;
+    uint8_t    timer_hook_id;
     rp_next_state_status_t next_state_status;
     const ralf_t*          radio;
     uint32_t               margin_delay;
+    void* ( *irq_context_select )( void* context );  // see rp_irq_context_init
+    void*                  irq_context;
 } radio_planner_t;
 
 /*
@@ -113,11 +130,44 @@ void rp_radio_irq_callback( void* obj );
  */
 void rp_init( radio_planner_t* rp, const ralf_t* radio );
 
+/*!
+ * Set the context selected while the radio planner handles its radio and timer interrupts
+ *
+ * \param [in/out] rp       Radio planner data structure
+ * \param [in]     select   Function selecting the context given as parameter and returning the one selected before,
+ *                          called with context before an interrupt is handled and with the returned value after
+ * \param [in]     context  Context of the owner of the radio planner
+ */
+void rp_irq_context_init( radio_planner_t* rp, void* ( *select )( void* context ), void* context );
+
 /*!
  *
  */
 rp_hook_status_t rp_hook_init( radio_planner_t* rp, const uint8_t id, void ( *callback )( void* context ), void* hook );
 
+/*!
+ * Register a new hook in the first free id following the built-in hooks
+ *
+ * \param [in/out] rp        Radio planner data structure
+ * \param [in]     hook_data Storage of the hook, must remain valid as long as the radio planner is used
+ * \param [in]     callback  Function called by the radio planner at the end of the hook tasks
+ * \param [in]     hook      Context given to the callback
+ * \param [out]    id        Id allocated to the hook
+ * \retval status            RP_HOOK_STATUS_ID_ERROR if the hook table is full
+ */
+rp_hook_status_t rp_hook_register( radio_planner_t* rp, rp_hook_t* hook_data, void ( *callback )( void* context ),
+                                   void* hook, uint8_t* id );
+
+/*!
+ * Unregister a hook added with rp_hook_register, its id and storage can be reused afterwards
+ *
+ * \param [in/out] rp  Radio planner data structure
+ * \param [in]     id  Id of the hook
+ * \retval status      RP_HOOK_STATUS_ID_ERROR if the id is not a registered hook, RP_TASK_STATUS_ALREADY_RUNNING if
+ *                     a task of the hook is still pending (call rp_task_abort and wait for its callback first)
+ */
+rp_hook_status_t rp_hook_unregister( radio_planner_t* rp, uint8_t id );
+
 /*!
  *
  */
@@ -153,6 +203,30 @@ rp_hook_status_t rp_task_abort( radio_planner_t* rp, const uint8_t hook_id );
  */
 rp_stats_t rp_get_stats( const radio_planner_t* rp );
 
+/*!
+ * Clear the radio planner statistics and the statistics of all the registered hooks
+ */
+void rp_reset_stats( radio_planner_t* rp );
+
+/*!
+ * Get the radio utilization since the planner init or the last statistics reset
+ *
+ * \param [in] rp                Radio planner data structure
+ * \retval utilization           Part of the time spent with the radio busy on a task, in per mille
+ */
+uint16_t rp_get_radio_utilization( const radio_planner_t* rp );
+
+/*!
+ * Get the launch, queueing and irq latency histograms and the abort counters of a hook
+ *
+ * \param [in]  rp               Radio planner data structure
+ * \param [in]  id               Hook id
+ * \param [out] latency_stats    Latency statistics of the hook, cleared with the other statistics by rp_reset_stats
+ * \retval status                RP_HOOK_STATUS_ID_ERROR if the hook does not exist
+ */
+rp_hook_status_t rp_get_hook_latency_stats( const radio_planner_t* rp, const uint8_t id,
+                                            rp_hook_latency_stats_t* latency_stats );
+
 /*!
  *
  */
@@ -106,6 +106,13 @@ uint32_t rp_hal_get_time_in_ms( void );
  */
 uint32_t rp_hal_get_radio_irq_timestamp_in_100us( void );
 
+/**
+ * @brief Gets current time in 100µs, same time base as rp_hal_get_radio_irq_timestamp_in_100us()
+ *
+ * @return uint32_t
+ */
+uint32_t rp_hal_get_time_in_100us( void );
+
 /*!
  *
  */
@@ -62,23 +62,82 @@ extern "C" {
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 
+// clang-format off
+
+/*!
+ * Number of buckets of a radio planner histogram. Buckets 0 to 7 count the values 0 to 7, the next ones count the
+ * values in [8, 16[, [16, 32[, ... [512, 1024[ and the last one counts all the values from 1024
+ */
+#define RP_STATS_HISTOGRAM_NB_BUCKETS               16
+
+/*!
+ * Number of histogram buckets holding a single value
+ */
+#define RP_STATS_HISTOGRAM_LINEAR_BUCKETS           8
+
+// clang-format on
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
 /*!
- *
+ * Reasons for which the radio planner aborts a task
+ */
+typedef enum rp_abort_reason_e
+{
+    RP_ABORT_REASON_USER,          // aborted with rp_task_abort()
+    RP_ABORT_REASON_LATE,          // schedule task still pending after its start time and slack
+    RP_ABORT_REASON_IN_PAST,       // priority task already in the past when the arbiter ran
+    RP_ABORT_REASON_NOT_PRIORITY,  // schedule task overlapping a higher priority task
+    RP_ABORT_REASON_PREEMPTED,     // running task stopped for a higher priority task
+    RP_ABORT_REASON_NB,
+} rp_abort_reason_t;
+
+/*!
+ * Fixed-bucket histogram, see RP_STATS_HISTOGRAM_NB_BUCKETS for the bucket bounds. Counters saturate at 0xFFFF
+ */
+typedef struct rp_stats_histogram_s
+{
+    uint16_t bucket[RP_STATS_HISTOGRAM_NB_BUCKETS];
+    uint32_t max;
+} rp_stats_histogram_t;
+
+/*!
+ * Timing statistics of a single hook, used to tune RP_MARGIN_DELAY and the board delays
+ */
+typedef struct rp_hook_latency_stats_s
+{
+    rp_stats_histogram_t launch_early_ms;        // task launched before its start time
+    rp_stats_histogram_t launch_late_ms;         // task launched after its start time
+    rp_stats_histogram_t asap_queue_ms;          // asap task waiting time, from its enqueue to its launch
+    rp_stats_histogram_t irq_to_callback_100us;  // radio irq to hook callback
+    uint16_t             abort_nb[RP_ABORT_REASON_NB];
+} rp_hook_latency_stats_t;
+
+/*!
+ * Statistics of a single hook, stored with the hook in the radio planner hook table
+ */
+typedef struct rp_hook_stats_s
+{
+    uint32_t                tx_last_toa_ms;
+    uint32_t                tx_consumption_ms;
+    uint32_t                rx_consumption_ms;
+    uint32_t                none_consumption_ms;
+    uint32_t                tx_consumption_ma;
+    uint32_t                rx_consumption_ma;
+    uint32_t                none_consumption_ma;
+    uint32_t                task_hook_aborted_nb;
+    uint32_t                task_hook_shifted_nb;
+    rp_hook_latency_stats_t latency;
+} rp_hook_stats_t;
+
+/*!
+ * Statistics of the whole radio planner
  */
 typedef struct rp_stats_s
 {
-    uint32_t tx_last_toa_ms[RP_NB_HOOKS];
-    uint32_t tx_consumption_ms[RP_NB_HOOKS];
-    uint32_t rx_consumption_ms[RP_NB_HOOKS];
-    uint32_t none_consumption_ms[RP_NB_HOOKS];
-    uint32_t tx_consumption_ma[RP_NB_HOOKS];
-    uint32_t rx_consumption_ma[RP_NB_HOOKS];
-    uint32_t none_consumption_ma[RP_NB_HOOKS];
     uint32_t tx_total_consumption_ms;
     uint32_t rx_total_consumption_ms;
     uint32_t none_total_consumption_ms;
@@ -88,8 +147,11 @@ typedef struct rp_stats_s
     uint32_t tx_timestamp;
     uint32_t rx_timestamp;
     uint32_t none_timestamp;
-    uint32_t task_hook_aborted_nb[RP_NB_HOOKS];
     uint32_t rp_error;
+    uint32_t task_shifted_nb;          // tasks postponed in their slack instead of being aborted
+    uint32_t task_preempted_nb;        // running tasks aborted for a higher priority task
+    uint32_t preempted_radio_time_ms;  // radio time lost by the preempted tasks
+    uint32_t stats_start_ms;           // start of the statistics period, for the radio utilization
 } rp_stats_t;
 
 /*
@@ -105,6 +167,14 @@ static inline void rp_stats_init( rp_stats_t* rp_stats )
     memset( rp_stats, 0, sizeof( rp_stats_t ) );
 }
 
+/*!
+ *
+ */
+static inline void rp_hook_stats_init( rp_hook_stats_t* hook_stats )
+{
+    memset( hook_stats, 0, sizeof( rp_hook_stats_t ) );
+}
+
 /*!
  *
  */
@@ -132,40 +202,41 @@ static inline void rp_stats_set_none_timestamp( rp_stats_t* rp_stats, uint32_t t
 /*!
  *
  */
-static inline void rp_stats_update( rp_stats_t* rp_stats, uint32_t timestamp, uint8_t hook_id, uint32_t micro_ampere )
+static inline void rp_stats_update( rp_stats_t* rp_stats, rp_hook_stats_t* hook_stats, uint32_t timestamp,
+                                    uint32_t micro_ampere )
 {
     uint32_t computed_time        = 0;
     uint32_t computed_consumption = 0;
     if( rp_stats->tx_timestamp != 0 )
     {
         // wrapping is impossible with this time base
-        computed_time                     = timestamp - rp_stats->tx_timestamp;
-        rp_stats->tx_last_toa_ms[hook_id] = computed_time;
-        rp_stats->tx_consumption_ms[hook_id] += computed_time;
+        computed_time              = timestamp - rp_stats->tx_timestamp;
+        hook_stats->tx_last_toa_ms = computed_time;
+        hook_stats->tx_consumption_ms += computed_time;
         rp_stats->tx_total_consumption_ms += computed_time;
 
         computed_consumption = ( computed_time * micro_ampere );
-        rp_stats->tx_consumption_ma[hook_id] += ( computed_consumption / 1000 );
+        hook_stats->tx_consumption_ma += ( computed_consumption / 1000 );
         rp_stats->tx_total_consumption_ma += ( computed_consumption / 1000 );
     }
     if( rp_stats->rx_timestamp != 0 )
     {
         computed_time = timestamp - rp_stats->rx_timestamp;
-        rp_stats->rx_consumption_ms[hook_id] += computed_time;
+        hook_stats->rx_consumption_ms += computed_time;
         rp_stats->rx_total_consumption_ms += computed_time;
 
         computed_consumption = ( computed_time * micro_ampere );
-        rp_stats->rx_consumption_ma[hook_id] += ( computed_consumption / 1000 );
+        hook_stats->rx_consumption_ma += ( computed_consumption / 1000 );
         rp_stats->rx_total_consumption_ma += ( computed_consumption / 1000 );
     }
     if( rp_stats->none_timestamp != 0 )
     {
         computed_time = timestamp - rp_stats->none_timestamp;
-        rp_stats->none_consumption_ms[hook_id] += computed_time;
+        hook_stats->none_consumption_ms += computed_time;
         rp_stats->none_total_consumption_ms += computed_time;
 
         computed_consumption = ( computed_time * micro_ampere );
-        rp_stats->none_consumption_ma[hook_id] += ( computed_consumption / 1000 );
+        hook_stats->none_consumption_ma += ( computed_consumption / 1000 );
         rp_stats->none_total_consumption_ma += ( computed_consumption / 1000 );
     }
     rp_stats->tx_timestamp   = 0;
@@ -173,11 +244,73 @@ static inline void rp_stats_update( rp_stats_t* rp_stats, uint32_t timestamp, ui
     rp_stats->none_timestamp = 0;
 }
 
+/*!
+ * Add a value to a histogram
+ */
+static inline void rp_stats_histogram_add( rp_stats_histogram_t* histogram, uint32_t value )
+{
+    uint8_t index = ( uint8_t ) value;
+
+    if( value >= RP_STATS_HISTOGRAM_LINEAR_BUCKETS )
+    {
+        uint32_t tmp = value / RP_STATS_HISTOGRAM_LINEAR_BUCKETS;
+
+        // One more bucket each time the value doubles
+        index = RP_STATS_HISTOGRAM_LINEAR_BUCKETS;
+        while( ( tmp > 1 ) && ( index < ( RP_STATS_HISTOGRAM_NB_BUCKETS - 1 ) ) )
+        {
+            tmp >>= 1;
+            index++;
+        }
+    }
+    if( histogram->bucket[index] < 0xFFFF )
+    {
+        histogram->bucket[index]++;
+    }
+    if( value > histogram->max )
+    {
+        histogram->max = value;
+    }
+}
+
+/*!
+ * Record the launch of a task, called before the task switches to the running state
+ */
+static inline void rp_stats_launch_update( rp_hook_stats_t* hook_stats, uint32_t timestamp, uint32_t start_time_ms,
+                                           uint32_t start_time_init_ms, bool is_asap )
+{
+    int32_t offset = ( int32_t )( timestamp - start_time_ms );
+
+    if( offset < 0 )
+    {
+        rp_stats_histogram_add( &hook_stats->latency.launch_early_ms, ( uint32_t ) ( -offset ) );
+    }
+    else
+    {
+        rp_stats_histogram_add( &hook_stats->latency.launch_late_ms, ( uint32_t ) offset );
+    }
+    if( is_asap == true )
+    {
+        rp_stats_histogram_add( &hook_stats->latency.asap_queue_ms, timestamp - start_time_init_ms );
+    }
+}
+
+/*!
+ * Record an aborted task
+ */
+static inline void rp_stats_abort_update( rp_hook_stats_t* hook_stats, rp_abort_reason_t reason )
+{
+    if( hook_stats->latency.abort_nb[reason] < 0xFFFF )
+    {
+        hook_stats->latency.abort_nb[reason]++;
+    }
+}
+
 /*!
  *
  */
-static inline void rp_stats_sniff_update( rp_stats_t* rp_stats, uint32_t timestamp, uint32_t time_radio,
-                                          uint32_t time_proc, uint8_t hook_id, uint32_t ma_radio, uint32_t ma_proc )
+static inline void rp_stats_sniff_update( rp_stats_t* rp_stats, rp_hook_stats_t* hook_stats, uint32_t timestamp,
+                                          uint32_t time_radio, uint32_t time_proc, uint32_t ma_radio, uint32_t ma_proc )
 {
     uint32_t computed_time        = 0;
     uint32_t computed_consumption = 0;
@@ -185,11 +318,11 @@ static inline void rp_stats_sniff_update( rp_stats_t* rp_stats, uint32_t timesta
     computed_time = timestamp - rp_stats->none_timestamp;
     // SMTC_MODEM_HAL_TRACE_WARNING( "stat %d %d\n", time_radio/1000, time_proc/1000 );
     // SMTC_MODEM_HAL_TRACE_WARNING( "stat %d \n", computed_time);
-    rp_stats->none_consumption_ms[hook_id] += computed_time;
+    hook_stats->none_consumption_ms += computed_time;
     rp_stats->none_total_consumption_ms += computed_time;
 
     computed_consumption = ( time_radio / 1000 * ma_radio ) + ( time_proc / 1000 * ma_proc );
-    rp_stats->none_consumption_ma[hook_id] += ( computed_consumption / 1000 );
+    hook_stats->none_consumption_ma += ( computed_consumption / 1000 );
     rp_stats->none_total_consumption_ma += ( computed_consumption / 1000 );
 
     rp_stats->tx_timestamp   = 0;
@@ -198,6 +331,28 @@ static inline void rp_stats_sniff_update( rp_stats_t* rp_stats, uint32_t timesta
 }
 
 #if defined( RP_STAT_PRINT_ENBALE )
+/*!
+ * Print the non empty buckets of a histogram, each bucket is shown with its lowest value
+ */
+static inline void rp_stats_histogram_print( const char* name, const rp_stats_histogram_t* histogram )
+{
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "%s, max %lu:", name, histogram->max );
+    for( uint8_t i = 0; i < RP_STATS_HISTOGRAM_NB_BUCKETS; i++ )
+    {
+        if( histogram->bucket[i] != 0 )
+        {
+            uint32_t low = i;
+
+            if( i >= RP_STATS_HISTOGRAM_LINEAR_BUCKETS )
+            {
+                low = ( uint32_t ) RP_STATS_HISTOGRAM_LINEAR_BUCKETS << ( i - RP_STATS_HISTOGRAM_LINEAR_BUCKETS );
+            }
+            SMTC_MODEM_HAL_RP_TRACE_PRINTF( " [%lu]=%u", low, histogram->bucket[i] );
+        }
+    }
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "\n" );
+}
+
 /*!
  *
  */
@@ -206,35 +361,44 @@ static inline void rp_stats_print( rp_stats_t* rp_stats )
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "###### ===================================== ######\n" );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "###### ===== Radio Planner Statistics ====== ######\n" );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "###### ===================================== ######\n" );
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
-    {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%ld = %lu ms\n", i, rp_stats->tx_consumption_ms[i] );
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%ld = %lu ua\n", i, rp_stats->tx_consumption_ma[i] );
-    }
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
-    {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%ld = %lu ms\n", i, rp_stats->rx_consumption_ms[i] );
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%ld = %lu ua\n", i, rp_stats->rx_consumption_ma[i] );
-    }
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
-    {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%ld = %lu ms\n", i, rp_stats->none_consumption_ms[i] );
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%ld = %lu ua\n", i, rp_stats->none_consumption_ma[i] );
-    }
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx total consumption     = %lu ms\n ", rp_stats->tx_total_consumption_ms );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx total consumption     = %lu uA\n ", rp_stats->tx_total_consumption_ma );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx total consumption     = %lu ms\n ", rp_stats->rx_total_consumption_ms );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx total consumption     = %lu uA\n ", rp_stats->rx_total_consumption_ma );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None total consumption   = %lu ms\n ", rp_stats->none_total_consumption_ms );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None total consumption   = %lu uA\n ", rp_stats->none_total_consumption_ma );
-
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
-    {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Number of aborted tasks for hook #%ld = %lu \n", i,
-                                        rp_stats->task_hook_aborted_nb[i] );
-    }
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Shifted tasks            = %lu\n ", rp_stats->task_shifted_nb );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Preempted tasks          = %lu (%lu ms lost)\n ", rp_stats->task_preempted_nb,
+                                    rp_stats->preempted_radio_time_ms );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: number of errors is %lu\n\n\n", rp_stats->rp_error );
 }
+
+/*!
+ *
+ */
+static inline void rp_hook_stats_print( rp_hook_stats_t* hook_stats, uint8_t hook_id )
+{
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%u = %lu ms\n", hook_id, hook_stats->tx_consumption_ms );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%u = %lu ua\n", hook_id, hook_stats->tx_consumption_ma );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%u = %lu ms\n", hook_id, hook_stats->rx_consumption_ms );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%u = %lu ua\n", hook_id, hook_stats->rx_consumption_ma );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%u = %lu ms\n", hook_id, hook_stats->none_consumption_ms );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%u = %lu ua\n", hook_id, hook_stats->none_consumption_ma );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Number of aborted tasks for hook #%u = %lu \n", hook_id,
+                                    hook_stats->task_hook_aborted_nb );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Number of shifted tasks for hook #%u = %lu \n", hook_id,
+                                    hook_stats->task_hook_shifted_nb );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Aborts hook #%u: user %u, late %u, in past %u, not priority %u, preempted %u\n",
+                                    hook_id, hook_stats->latency.abort_nb[RP_ABORT_REASON_USER],
+                                    hook_stats->latency.abort_nb[RP_ABORT_REASON_LATE],
+                                    hook_stats->latency.abort_nb[RP_ABORT_REASON_IN_PAST],
+                                    hook_stats->latency.abort_nb[RP_ABORT_REASON_NOT_PRIORITY],
+                                    hook_stats->latency.abort_nb[RP_ABORT_REASON_PREEMPTED] );
+    rp_stats_histogram_print( "Launch early (ms)", &hook_stats->latency.launch_early_ms );
+    rp_stats_histogram_print( "Launch late (ms)", &hook_stats->latency.launch_late_ms );
+    rp_stats_histogram_print( "Asap queue (ms)", &hook_stats->latency.asap_queue_ms );
+    rp_stats_histogram_print( "Irq to callback (100us)", &hook_stats->latency.irq_to_callback_100us );
+}
 #endif  // RP_STAT_PRINT_ENBALE
 
 #ifdef __cplusplus
@@ -64,12 +64,34 @@ extern "C" {
 // clang-format off
 
 /*
- * Maximum number of objects that can be attached to the scheduler
+ * Number of built-in objects attached to the scheduler (ids of enum RP_HOOK_ID_DEF)
  */
 #define RP_NB_HOOKS                                 RP_HOOK_ID_MAX
 
 #define RP_NB_USER_HOOK                             3
 
+/*
+ * Maximum number of objects that can be attached to the scheduler, built-in hooks plus the hooks registered at
+ * runtime with rp_hook_register(). Task priorities are stored on 8 bits, so it can not exceed 127
+ */
+#ifndef RP_NB_HOOKS_MAX
+#define RP_NB_HOOKS_MAX                             32
+#endif
+
+#if RP_NB_HOOKS_MAX > 127
+#error "RP_NB_HOOKS_MAX can not exceed 127, task priorities are stored on 8 bits"
+#endif
+
+/*
+ * Number of 32-bit words of the hook bitsets (one bit per hook id)
+ */
+#define RP_HOOK_INDEX_WORDS                         ( ( RP_NB_HOOKS_MAX + 31 ) / 32 )
+
+/*
+ * Number of 32-bit words of the priority bitsets (one bit per task priority level, see rp_task_t)
+ */
+#define RP_PRIORITY_INDEX_WORDS                     ( ( ( 2 * RP_NB_HOOKS_MAX ) + 31 ) / 32 )
+
 
 
 /*!
@@ -209,7 +231,7 @@ typedef struct rp_task_s
     uint8_t         hook_id;
     rp_task_types_t type;
     void ( *launch_task_callbacks )( void* );
-    uint8_t          priority;
+    uint8_t          priority;  // ( state * RP_NB_HOOKS_MAX ) + hook_id, 0 is the highest priority
     bool             schedule_task_low_priority;
     rp_task_states_t state;
     // absolute Ms
@@ -219,6 +241,13 @@ typedef struct rp_task_s
     // schedule task after long period
     uint32_t start_time_init_ms;
     uint32_t duration_time_ms;
+    // A schedule task that can not start on time because the radio is busy is postponed up to slack_ms after its
+    // initial start time (the time it was scheduled at for an asap task switched to a schedule one) instead of being
+    // aborted. 0 for a task that has to start at the exact time (Rx windows, beacons, ping slots)
+    uint32_t slack_ms;
+    // Optional check of the owner before the task is postponed to start_time_ms, the task is aborted if it returns
+    // false. NULL if the task can start anywhere in its slack
+    bool ( *shift_task_check_callbacks )( void* hook, uint32_t start_time_ms );
 } rp_task_t;
 
 /*!
@@ -41,6 +41,7 @@
 #include <stdbool.h>  // bool type
 
 #include "smtc_secure_element.h"
+#include "smtc_secure_element_ctx.h"
 
 #include "lr11xx_system.h"
 #include "lr11xx_crypto_engine.h"
@@ -48,6 +49,8 @@
 #include "smtc_modem_hal_dbg_trace.h"
 
 #include "modem_context.h"
+#include "smtc_modem_ctx.h"
+#include "modem_crc32.h"
 
 #include <string.h>  //for memset
 
@@ -86,18 +89,6 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
-/**
- * @brief Structure for data needed by lr11xx crypto engine
- *
- * @struct lr11xx_ce_data_t
- */
-typedef struct lr11xx_ce_data_s
-{
-    uint8_t deveui[SMTC_SE_EUI_SIZE];   //!< DevEUI storage
-    uint8_t joineui[SMTC_SE_EUI_SIZE];  //!< Join EUI storage
-    uint8_t pin[SMTC_SE_PIN_SIZE];      //!< pin storage
-} lr11xx_ce_data_t;
-
 /**
  * @brief Struture for lr11xx crypto engine context saving in NVM
  *
@@ -114,9 +105,6 @@ typedef struct lr11xx_ce_context_nvm_s
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static lr11xx_ce_data_t lr11xx_ce_data;
-static const void*      lr11xx_ctx;
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -131,13 +119,17 @@ static const void*      lr11xx_ctx;
 static lr11xx_crypto_keys_idx_t convert_key_id_from_se_to_lr11xx( smtc_se_key_identifier_t key_id );
 
 /**
- * @brief CRC function for lr11xx se context security
+ * @brief Encrypts blocks with the lr11xx crypto engine, radio access must be suspended by the caller
  *
- * @param [in] buf  Data buffer
- * @param [in] len Length of the data
- * @return uint32_t
+ * @param [in] buffer Data buffer
+ * @param [in] size Data buffer size - this value shall be a multiple of 16
+ * @param [in] key_id Key identifier to determine the AES key to be used
+ * @param [out] enc_buffer Encrypted buffer
+ * @return smtc_se_return_code_t
  */
-uint32_t lr11xx_ce_crc( const uint8_t* buf, int len );
+static smtc_se_return_code_t aes_encrypt_blocks( const uint8_t* buffer, uint16_t size, smtc_se_key_identifier_t key_id,
+                                                 uint8_t* enc_buffer );
+
 
 /*
  * -----------------------------------------------------------------------------
@@ -146,15 +138,18 @@ uint32_t lr11xx_ce_crc( const uint8_t* buf, int len );
 
 smtc_se_return_code_t smtc_secure_element_init( void )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     SMTC_MODEM_HAL_TRACE_INFO( "Use lr11xx crypto engine for cryptographic functionalities\n" );
 
     lr11xx_crypto_status_t lr11xx_crypto_status = LR11XX_CRYPTO_STATUS_ERROR;
 
     // Initialize data structure to 0
-    memset( &lr11xx_ce_data, 0, sizeof( lr11xx_ce_data_t ) );
+    memset( lr11xx_ce_data, 0, sizeof( lr11xx_ce_data_t ) );
 
     // get radio context
-    lr11xx_ctx = modem_context_get_modem_radio_ctx( );
+    const void* lr11xx_ctx                           = modem_context_get_modem_radio_ctx( );
+    smtc_modem_current_ctx->secure_element.radio_ctx = lr11xx_ctx;
 
     // lr11xx crypto operation needed: suspend modem radio access to secure this direct access
     modem_context_suspend_radio_access( RP_TASK_TYPE_NONE );
@@ -166,9 +161,9 @@ smtc_se_return_code_t smtc_secure_element_init( void )
     SMTC_MODEM_HAL_TRACE_WARNING( "Use lr11xx preprovisioned EUIs and keys\n" );
 
     // Read LR11XX pre-provisioned identity
-    smtc_modem_hal_assert( lr11xx_system_read_uid( lr11xx_ctx, lr11xx_ce_data.deveui ) == LR11XX_STATUS_OK );
-    smtc_modem_hal_assert( lr11xx_system_read_join_eui( lr11xx_ctx, lr11xx_ce_data.joineui ) == LR11XX_STATUS_OK );
-    smtc_modem_hal_assert( lr11xx_system_read_pin( lr11xx_ctx, lr11xx_ce_data.pin ) == LR11XX_STATUS_OK );
+    smtc_modem_hal_assert( lr11xx_system_read_uid( lr11xx_ctx, lr11xx_ce_data->deveui ) == LR11XX_STATUS_OK );
+    smtc_modem_hal_assert( lr11xx_system_read_join_eui( lr11xx_ctx, lr11xx_ce_data->joineui ) == LR11XX_STATUS_OK );
+    smtc_modem_hal_assert( lr11xx_system_read_pin( lr11xx_ctx, lr11xx_ce_data->pin ) == LR11XX_STATUS_OK );
 #endif
     // lr11xx crypto operation done: resume modem radio access
     modem_context_resume_radio_access( );
@@ -180,6 +175,8 @@ smtc_se_return_code_t smtc_secure_element_init( void )
 smtc_se_return_code_t smtc_secure_element_set_key( smtc_se_key_identifier_t key_id,
                                                    const uint8_t            key[SMTC_SE_KEY_SIZE] )
 {
+    const void* lr11xx_ctx = smtc_modem_current_ctx->secure_element.radio_ctx;
+
     if( key == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
@@ -228,6 +225,8 @@ smtc_se_return_code_t smtc_secure_element_compute_aes_cmac( uint8_t* mic_bx_buff
                                                             uint16_t size, smtc_se_key_identifier_t key_id,
                                                             uint32_t* cmac )
 {
+    const void* lr11xx_ctx = smtc_modem_current_ctx->secure_element.radio_ctx;
+
     smtc_se_return_code_t status = SMTC_SE_RC_ERROR;
     // uint8_t*              local_buffer = buffer;
 
@@ -274,6 +273,8 @@ smtc_se_return_code_t smtc_secure_element_compute_aes_cmac( uint8_t* mic_bx_buff
 smtc_se_return_code_t smtc_secure_element_verify_aes_cmac( uint8_t* buffer, uint16_t size, uint32_t expected_cmac,
                                                            smtc_se_key_identifier_t key_id )
 {
+    const void* lr11xx_ctx = smtc_modem_current_ctx->secure_element.radio_ctx;
+
     smtc_se_return_code_t status = SMTC_SE_RC_ERROR;
 
     if( buffer == NULL )
@@ -307,17 +308,54 @@ smtc_se_return_code_t smtc_secure_element_aes_encrypt( const uint8_t* buffer, ui
     // lr11xx crypto operation needed: suspend modem radio access to secure this direct access
     modem_context_suspend_radio_access( RP_TASK_TYPE_NONE );
 
-    if( key_id == SMTC_SE_SLOT_RAND_ZERO_KEY )
+    status = aes_encrypt_blocks( buffer, size, key_id, enc_buffer );
+
+    // lr11xx crypto operation done: resume modem radio access
+    modem_context_resume_radio_access( );
+
+    return status;
+}
+
+smtc_se_return_code_t smtc_secure_element_aes_ctr_encrypt( const uint8_t a_block[16], const uint8_t* buffer,
+                                                           uint16_t size, smtc_se_key_identifier_t key_id,
+                                                           uint8_t* enc_buffer )
+{
+    smtc_se_return_code_t status = SMTC_SE_RC_SUCCESS;
+    // Counter blocks sent to the crypto engine per command
+    uint8_t  ctr_blocks[4 * 16];
+    uint8_t  s_blocks[4 * 16];
+    uint16_t ctr;
+    uint16_t index = 0;
+
+    if( ( a_block == NULL ) || ( buffer == NULL ) || ( enc_buffer == NULL ) )
     {
-        smtc_modem_hal_assert( lr11xx_crypto_aes_encrypt( lr11xx_ctx, ( lr11xx_crypto_status_t* ) &status,
-                                                          LR11XX_CRYPTO_KEYS_IDX_GP0, buffer, size,
-                                                          enc_buffer ) == LR11XX_STATUS_OK );
+        return SMTC_SE_RC_ERROR_NPE;
     }
-    else
+    ctr = ( ( uint16_t ) a_block[14] << 8 ) | a_block[15];
+
+    // lr11xx crypto operation needed: suspend modem radio access to secure this direct access
+    modem_context_suspend_radio_access( RP_TASK_TYPE_NONE );
+
+    while( ( index < size ) && ( status == SMTC_SE_RC_SUCCESS ) )
     {
-        smtc_modem_hal_assert( lr11xx_crypto_aes_encrypt_01( lr11xx_ctx, ( lr11xx_crypto_status_t* ) &status,
-                                                             convert_key_id_from_se_to_lr11xx( key_id ), buffer, size,
-                                                             enc_buffer ) == LR11XX_STATUS_OK );
+        uint16_t remaining = size - index;
+        uint16_t len       = ( remaining > sizeof( ctr_blocks ) ) ? sizeof( ctr_blocks ) : remaining;
+        uint16_t nb_byte   = ( len + 15 ) & ~0x0F;
+
+        for( uint16_t block = 0; block < nb_byte; block += 16 )
+        {
+            memcpy( &ctr_blocks[block], a_block, 14 );
+            ctr_blocks[block + 14] = ( ctr >> 8 ) & 0xFF;
+            ctr_blocks[block + 15] = ctr & 0xFF;
+            ctr++;
+        }
+
+        status = aes_encrypt_blocks( ctr_blocks, nb_byte, key_id, s_blocks );
+        for( uint16_t i = 0; i < len; i++ )
+        {
+            enc_buffer[index + i] = buffer[index + i] ^ s_blocks[i];
+        }
+        index += len;
     }
 
     // lr11xx crypto operation done: resume modem radio access
@@ -326,9 +364,54 @@ smtc_se_return_code_t smtc_secure_element_aes_encrypt( const uint8_t* buffer, ui
     return status;
 }
 
+smtc_se_return_code_t smtc_secure_element_aes_ctr_and_cmac( const uint8_t a_block[16], uint8_t* mic_bx_buffer,
+                                                            const uint8_t* buffer, uint16_t size, uint16_t enc_offset,
+                                                            bool encrypt, smtc_se_key_identifier_t enc_key_id,
+                                                            smtc_se_key_identifier_t mac_key_id, uint8_t* enc_buffer,
+                                                            uint32_t* cmac )
+{
+    smtc_se_return_code_t status = SMTC_SE_RC_SUCCESS;
+    uint8_t               mac_buffer[CRYPTO_MAXMESSAGE_SIZE];
+
+    if( ( a_block == NULL ) || ( buffer == NULL ) || ( cmac == NULL ) ||
+        ( ( enc_buffer == NULL ) && ( enc_offset < size ) ) )
+    {
+        return SMTC_SE_RC_ERROR_NPE;
+    }
+    if( ( enc_offset > size ) || ( size > CRYPTO_MAXMESSAGE_SIZE ) )
+    {
+        return SMTC_SE_RC_ERROR_BUF_SIZE;
+    }
+
+    // No fused command in the crypto engine: the frame goes through a ctr then a cmac computation, the cmac input
+    // being gathered first as enc_buffer may overwrite the frame
+    memcpy( mac_buffer, buffer, enc_offset );
+    if( enc_offset < size )
+    {
+        if( encrypt == false )
+        {
+            memcpy( &mac_buffer[enc_offset], &buffer[enc_offset], size - enc_offset );
+        }
+        status = smtc_secure_element_aes_ctr_encrypt( a_block, &buffer[enc_offset], size - enc_offset, enc_key_id,
+                                                      enc_buffer );
+        if( encrypt == true )
+        {
+            memcpy( &mac_buffer[enc_offset], enc_buffer, size - enc_offset );
+        }
+    }
+
+    if( status == SMTC_SE_RC_SUCCESS )
+    {
+        status = smtc_secure_element_compute_aes_cmac( mic_bx_buffer, mac_buffer, size, mac_key_id, cmac );
+    }
+    return status;
+}
+
 smtc_se_return_code_t smtc_secure_element_derive_and_store_key( uint8_t* input, smtc_se_key_identifier_t rootkey_id,
                                                                 smtc_se_key_identifier_t targetkey_id )
 {
+    const void* lr11xx_ctx = smtc_modem_current_ctx->secure_element.radio_ctx;
+
     smtc_se_return_code_t status = SMTC_SE_RC_ERROR;
 
     if( input == NULL )
@@ -359,6 +442,8 @@ smtc_se_return_code_t smtc_secure_element_process_join_accept( smtc_se_join_req_
                                                                uint8_t enc_join_accept_size, uint8_t* dec_join_accept,
                                                                uint8_t* version_minor )
 {
+    const void* lr11xx_ctx = smtc_modem_current_ctx->secure_element.radio_ctx;
+
     smtc_se_return_code_t status = SMTC_SE_RC_ERROR;
 
     if( ( enc_join_accept == NULL ) || ( dec_join_accept == NULL ) || ( version_minor == NULL ) )
@@ -416,71 +501,85 @@ smtc_se_return_code_t smtc_secure_element_process_join_accept( smtc_se_join_req_
 
 smtc_se_return_code_t smtc_secure_element_set_deveui( const uint8_t deveui[SMTC_SE_EUI_SIZE] )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     if( deveui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( lr11xx_ce_data.deveui, deveui, SMTC_SE_EUI_SIZE );
+    memcpy( lr11xx_ce_data->deveui, deveui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_get_deveui( uint8_t deveui[SMTC_SE_EUI_SIZE] )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     if( deveui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( deveui, lr11xx_ce_data.deveui, SMTC_SE_EUI_SIZE );
+    memcpy( deveui, lr11xx_ce_data->deveui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_set_joineui( const uint8_t joineui[SMTC_SE_EUI_SIZE] )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     if( joineui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( lr11xx_ce_data.joineui, joineui, SMTC_SE_EUI_SIZE );
+    memcpy( lr11xx_ce_data->joineui, joineui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_get_joineui( uint8_t joineui[SMTC_SE_EUI_SIZE] )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     if( joineui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( joineui, lr11xx_ce_data.joineui, SMTC_SE_EUI_SIZE );
+    memcpy( joineui, lr11xx_ce_data->joineui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_set_pin( const uint8_t pin[SMTC_SE_PIN_SIZE] )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     if( pin == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( lr11xx_ce_data.pin, pin, SMTC_SE_PIN_SIZE );
+    memcpy( lr11xx_ce_data->pin, pin, SMTC_SE_PIN_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_get_pin( uint8_t pin[SMTC_SE_PIN_SIZE] )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     if( pin == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
 
-    memcpy( pin, lr11xx_ce_data.pin, SMTC_SE_EUI_SIZE );
+    memcpy( pin, lr11xx_ce_data->pin, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_store_context( void )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     lr11xx_ce_context_nvm_t ctx = {
-        .data = lr11xx_ce_data,
+        .data = *lr11xx_ce_data,
     };
-    ctx.crc = lr11xx_ce_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
+    ctx.crc = modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
 
     smtc_modem_hal_context_store( CONTEXT_SECURE_ELEMENT, ( uint8_t* ) &ctx, sizeof( ctx ) );
     smtc_secure_element_restore_context( );
@@ -489,18 +588,20 @@ smtc_se_return_code_t smtc_secure_element_store_context( void )
 
 smtc_se_return_code_t smtc_secure_element_restore_context( void )
 {
+    lr11xx_ce_data_t* lr11xx_ce_data = &smtc_modem_current_ctx->secure_element.data;
+
     lr11xx_ce_context_nvm_t ctx;
     smtc_modem_hal_context_restore( CONTEXT_SECURE_ELEMENT, ( uint8_t* ) &ctx, sizeof( ctx ) );
-    if( lr11xx_ce_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc )
+    if( modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc )
     {
-        lr11xx_ce_data = ctx.data;
+        *lr11xx_ce_data = ctx.data;
         return SMTC_SE_RC_SUCCESS;
     }
     else
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Restore of Secure Element context fails => Return to init values\n" );
         // Initialize data structure to 0
-        memset( &lr11xx_ce_data, 0, sizeof( lr11xx_ce_data_t ) );
+        memset( lr11xx_ce_data, 0, sizeof( lr11xx_ce_data_t ) );
         return SMTC_SE_RC_ERROR;
     }
 }
@@ -510,6 +611,28 @@ smtc_se_return_code_t smtc_secure_element_restore_context( void )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static smtc_se_return_code_t aes_encrypt_blocks( const uint8_t* buffer, uint16_t size, smtc_se_key_identifier_t key_id,
+                                                 uint8_t* enc_buffer )
+{
+    const void* lr11xx_ctx = smtc_modem_current_ctx->secure_element.radio_ctx;
+
+    smtc_se_return_code_t status = SMTC_SE_RC_ERROR;
+
+    if( key_id == SMTC_SE_SLOT_RAND_ZERO_KEY )
+    {
+        smtc_modem_hal_assert( lr11xx_crypto_aes_encrypt( lr11xx_ctx, ( lr11xx_crypto_status_t* ) &status,
+                                                          LR11XX_CRYPTO_KEYS_IDX_GP0, buffer, size,
+                                                          enc_buffer ) == LR11XX_STATUS_OK );
+    }
+    else
+    {
+        smtc_modem_hal_assert( lr11xx_crypto_aes_encrypt_01( lr11xx_ctx, ( lr11xx_crypto_status_t* ) &status,
+                                                             convert_key_id_from_se_to_lr11xx( key_id ), buffer, size,
+                                                             enc_buffer ) == LR11XX_STATUS_OK );
+    }
+    return status;
+}
+
 static lr11xx_crypto_keys_idx_t convert_key_id_from_se_to_lr11xx( smtc_se_key_identifier_t key_id )
 {
     lr11xx_crypto_keys_idx_t id = LR11XX_CRYPTO_KEYS_IDX_GP1;
@@ -592,18 +715,4 @@ static lr11xx_crypto_keys_idx_t convert_key_id_from_se_to_lr11xx( smtc_se_key_id
     return id;
 }
 
-uint32_t lr11xx_ce_crc( const uint8_t* buf, int len )
-{
-    uint32_t crc = 0xFFFFFFFF;
-    while( len-- > 0 )
-    {
-        crc = crc ^ *buf++;
-        for( int i = 0; i < 8; i++ )
-        {
-            uint32_t mask = -( crc & 1 );
-            crc           = ( crc >> 1 ) ^ ( 0xEDB88320 & mask );
-        }
-    }
-    return ~crc;
-}
 /* --- EOF ------------------------------------------------------------------ */
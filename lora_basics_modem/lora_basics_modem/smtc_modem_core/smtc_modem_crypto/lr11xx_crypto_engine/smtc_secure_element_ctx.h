@@ -0,0 +1,84 @@
+/**
+ * @file      smtc_secure_element_ctx.h
+ *
+ * @brief     LR11XX crypto engine state of one modem instance
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_SECURE_ELEMENT_CTX_H__
+#define SMTC_SECURE_ELEMENT_CTX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "smtc_secure_element.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Structure for data needed by lr11xx crypto engine
+ *
+ * @struct lr11xx_ce_data_t
+ */
+typedef struct lr11xx_ce_data_s
+{
+    uint8_t deveui[SMTC_SE_EUI_SIZE];   //!< DevEUI storage
+    uint8_t joineui[SMTC_SE_EUI_SIZE];  //!< Join EUI storage
+    uint8_t pin[SMTC_SE_PIN_SIZE];      //!< pin storage
+} lr11xx_ce_data_t;
+
+/**
+ * @brief Secure element part of the modem context, see smtc_modem_ctx_t
+ *
+ * @struct smtc_secure_element_ctx_t
+ */
+typedef struct smtc_secure_element_ctx_s
+{
+    lr11xx_ce_data_t data;       //!< Identity of the device, also saved in NVM
+    const void*      radio_ctx;  //!< Radio context used to reach the crypto engine
+} smtc_secure_element_ctx_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_SECURE_ELEMENT_CTX_H__
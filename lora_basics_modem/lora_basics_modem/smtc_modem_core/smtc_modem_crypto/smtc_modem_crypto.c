@@ -146,6 +146,16 @@ static smtc_modem_crypto_return_code_t compute_mic( const uint8_t* buffer, uint1
 static smtc_modem_crypto_return_code_t prepare_b0( uint16_t msg_len, uint8_t dir, uint32_t devaddr, uint32_t fcnt,
                                                    uint8_t* b0 );
 
+/**
+ * @brief Prepares the initial A block of the payload encryption
+ *
+ * @param [in] dir Frame direction ( Uplink:0, Downlink:1 )
+ * @param [in] address Frame address
+ * @param [in] frame_counter Frame counter
+ * @param [out] a_block A block
+ */
+static void prepare_a_block( uint8_t dir, uint32_t address, uint32_t frame_counter, uint8_t a_block[16] );
+
 /**
  * @brief Derives a session key as of LoRaWAN versions prior to 1.1.0
  *
@@ -199,43 +209,13 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_payload_encrypt( const uint8_t
         return SMTC_MODEM_CRYPTO_RC_ERROR_NPE;
     }
 
-    uint16_t buffer_idx = 0;
-    uint16_t ctr        = 1;
-    uint8_t  sBlock[16] = { 0 };
-    uint8_t  aBlock[16] = { 0 };
-    int16_t  local_size = size;
+    uint8_t aBlock[16];
 
-    aBlock[0] = 0x01;
+    prepare_a_block( dir, address, frame_counter, aBlock );
 
-    aBlock[5] = dir;
-
-    aBlock[6] = address & 0xFF;
-    aBlock[7] = ( address >> 8 ) & 0xFF;
-    aBlock[8] = ( address >> 16 ) & 0xFF;
-    aBlock[9] = ( address >> 24 ) & 0xFF;
-
-    aBlock[10] = frame_counter & 0xFF;
-    aBlock[11] = ( frame_counter >> 8 ) & 0xFF;
-    aBlock[12] = ( frame_counter >> 16 ) & 0xFF;
-    aBlock[13] = ( frame_counter >> 24 ) & 0xFF;
-
-    while( local_size > 0 )
+    if( smtc_secure_element_aes_ctr_encrypt( aBlock, buffer, size, key_id, enc_buffer ) != SMTC_SE_RC_SUCCESS )
     {
-        aBlock[15] = ctr & 0xFF;
-
-        ctr++;
-
-        if( smtc_secure_element_aes_encrypt( aBlock, 16, key_id, sBlock ) != SMTC_SE_RC_SUCCESS )
-        {
-            return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
-        }
-
-        for( uint8_t i = 0; i < ( ( local_size > 16 ) ? 16 : local_size ); i++ )
-        {
-            enc_buffer[buffer_idx + i] = buffer[buffer_idx + i] ^ sBlock[i];
-        }
-        local_size -= 16;
-        buffer_idx += 16;
+        return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
     }
 
     return SMTC_MODEM_CRYPTO_RC_SUCCESS;
@@ -347,6 +327,78 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_compute_and_add_mic( uint8_t*
     return rc;
 }
 
+smtc_modem_crypto_return_code_t smtc_modem_crypto_payload_encrypt_and_add_mic( uint8_t* buffer, uint16_t size,
+                                                                               uint16_t                 payload_offset,
+                                                                               smtc_se_key_identifier_t enc_key_id,
+                                                                               smtc_se_key_identifier_t mic_key_id,
+                                                                               uint32_t devaddr, uint8_t dir,
+                                                                               uint32_t fcnt )
+{
+    if( buffer == 0 )
+    {
+        return SMTC_MODEM_CRYPTO_RC_ERROR_NPE;
+    }
+    if( ( size > CRYPTO_MAXMESSAGE_SIZE ) || ( payload_offset > size ) )
+    {
+        return SMTC_MODEM_CRYPTO_RC_ERROR_BUF_SIZE;
+    }
+
+    uint8_t  aBlock[16];
+    uint8_t  mic_buff[MIC_BLOCK_BX_SIZE];
+    uint32_t computed_mic;
+
+    prepare_a_block( dir, devaddr, fcnt, aBlock );
+    prepare_b0( size, dir, devaddr, fcnt, mic_buff );
+
+    if( smtc_secure_element_aes_ctr_and_cmac( aBlock, mic_buff, buffer, size, payload_offset, true, enc_key_id,
+                                              mic_key_id, &buffer[payload_offset],
+                                              &computed_mic ) != SMTC_SE_RC_SUCCESS )
+    {
+        return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
+    }
+    memcpy( &buffer[size], ( uint8_t* ) &computed_mic, 4 );
+    return SMTC_MODEM_CRYPTO_RC_SUCCESS;
+}
+
+smtc_modem_crypto_return_code_t smtc_modem_crypto_verify_mic_and_payload_decrypt(
+    const uint8_t* buffer, uint16_t size, uint16_t payload_offset, smtc_se_key_identifier_t dec_key_id,
+    smtc_se_key_identifier_t mic_key_id, uint32_t devaddr, uint8_t dir, uint32_t fcnt, uint32_t expected_mic,
+    uint8_t* dec_buffer )
+{
+    if( ( buffer == 0 ) || ( ( dec_buffer == 0 ) && ( payload_offset < size ) ) )
+    {
+        return SMTC_MODEM_CRYPTO_RC_ERROR_NPE;
+    }
+    if( ( size > CRYPTO_MAXMESSAGE_SIZE ) || ( payload_offset > size ) )
+    {
+        return SMTC_MODEM_CRYPTO_RC_ERROR_BUF_SIZE;
+    }
+
+    uint8_t  aBlock[16];
+    uint8_t  mic_buff[MIC_BLOCK_BX_SIZE];
+    uint8_t  dec_scratch[CRYPTO_MAXMESSAGE_SIZE];
+    uint32_t computed_mic;
+
+    prepare_a_block( dir, devaddr, fcnt, aBlock );
+    prepare_b0( size, dir, devaddr, fcnt, mic_buff );
+
+    // The plaintext of an unauthenticated frame must not reach the caller: decrypt aside, copy out once the mic matched
+    if( smtc_secure_element_aes_ctr_and_cmac( aBlock, mic_buff, buffer, size, payload_offset, false, dec_key_id,
+                                              mic_key_id, dec_scratch, &computed_mic ) != SMTC_SE_RC_SUCCESS )
+    {
+        return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
+    }
+    if( computed_mic != expected_mic )
+    {
+        return SMTC_MODEM_CRYPTO_RC_FAIL_MIC;
+    }
+    if( payload_offset < size )
+    {
+        memcpy( dec_buffer, dec_scratch, size - payload_offset );
+    }
+    return SMTC_MODEM_CRYPTO_RC_SUCCESS;
+}
+
 smtc_modem_crypto_return_code_t smtc_modem_crypto_set_key( smtc_se_key_identifier_t key_id, const uint8_t* key )
 {
     if( smtc_secure_element_set_key( key_id, key ) != SMTC_SE_RC_SUCCESS )
@@ -463,33 +515,16 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_service_encrypt( const uint8_t
         return SMTC_MODEM_CRYPTO_RC_ERROR_NPE;
     }
 
-    uint16_t index       = 0;
-    uint16_t ctr         = 1;
-    uint8_t  s_block[16] = { 0 };
-    uint8_t  a_block[16] = { 0 };
-    int16_t  local_size  = len;
+    uint8_t a_block[16] = { 0 };
 
-    // first copy the 14 bytes of nonce into a_block first 14 bytes
+    // first copy the 14 bytes of nonce into a_block first 14 bytes, then the 16 bits counter starting at 1
     memcpy( a_block, nonce, 14 );
+    a_block[15] = 0x01;
 
-    while( local_size > 0 )
+    if( smtc_secure_element_aes_ctr_encrypt( a_block, clear_buff, len, SMTC_SE_APP_S_KEY, enc_buff ) !=
+        SMTC_SE_RC_SUCCESS )
     {
-        a_block[15] = ctr & 0xFF;
-        a_block[14] = ( ctr >> 8 ) & 0xFF;
-
-        ctr++;
-
-        if( smtc_secure_element_aes_encrypt( a_block, 16, SMTC_SE_APP_S_KEY, s_block ) != SMTC_SE_RC_SUCCESS )
-        {
-            return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
-        }
-
-        for( uint8_t i = 0; i < ( ( local_size > 16 ) ? 16 : local_size ); i++ )
-        {
-            enc_buff[index + i] = clear_buff[index + i] ^ s_block[i];
-        }
-        local_size -= 16;
-        index += 16;
+        return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
     }
 
     return SMTC_MODEM_CRYPTO_RC_SUCCESS;
@@ -558,6 +593,31 @@ static smtc_modem_crypto_return_code_t prepare_b0( uint16_t msg_len, uint8_t dir
     return SMTC_MODEM_CRYPTO_RC_SUCCESS;
 }
 
+static void prepare_a_block( uint8_t dir, uint32_t address, uint32_t frame_counter, uint8_t a_block[16] )
+{
+    a_block[0] = 0x01;
+    a_block[1] = 0x00;
+    a_block[2] = 0x00;
+    a_block[3] = 0x00;
+    a_block[4] = 0x00;
+
+    a_block[5] = dir;
+
+    a_block[6] = address & 0xFF;
+    a_block[7] = ( address >> 8 ) & 0xFF;
+    a_block[8] = ( address >> 16 ) & 0xFF;
+    a_block[9] = ( address >> 24 ) & 0xFF;
+
+    a_block[10] = frame_counter & 0xFF;
+    a_block[11] = ( frame_counter >> 8 ) & 0xFF;
+    a_block[12] = ( frame_counter >> 16 ) & 0xFF;
+    a_block[13] = ( frame_counter >> 24 ) & 0xFF;
+
+    // Counter of the first block, a LoRaWAN payload never needs more than a_block[15]
+    a_block[14] = 0x00;
+    a_block[15] = 0x01;
+}
+
 static smtc_modem_crypto_return_code_t derive_session_key_1_0_x( smtc_se_key_identifier_t key_id,
                                                                  const uint8_t* join_nonce, const uint8_t* net_id,
                                                                  uint16_t dev_nonce )
@@ -220,6 +220,48 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_compute_and_add_mic( uint8_t*
                                                                        smtc_se_key_identifier_t key_id,
                                                                        uint32_t devaddr, uint8_t dir, uint32_t fcnt );
 
+/**
+ * @brief Encrypts the payload of a frame in place and adds the mic computed over the encrypted frame, in one pass
+ *
+ * @param [in] buffer Frame buffer, with room for the mic after the frame
+ * @param [in] size Frame size, mic excluded
+ * @param [in] payload_offset Index of the payload in the frame, size when there is no payload
+ * @param [in] enc_key_id Payload encryption key identifier
+ * @param [in] mic_key_id Mic key identifier
+ * @param [in] devaddr Device address
+ * @param [in] dir Frame direction [0: uplink, 1: downlink]
+ * @param [in] fcnt Frame counter
+ * @return smtc_modem_crypto_return_code_t
+ */
+smtc_modem_crypto_return_code_t smtc_modem_crypto_payload_encrypt_and_add_mic( uint8_t* buffer, uint16_t size,
+                                                                               uint16_t                 payload_offset,
+                                                                               smtc_se_key_identifier_t enc_key_id,
+                                                                               smtc_se_key_identifier_t mic_key_id,
+                                                                               uint32_t devaddr, uint8_t dir,
+                                                                               uint32_t fcnt );
+
+/**
+ * @brief Verifies the mic of a frame and decrypts its payload, in one pass
+ *
+ * @remark dec_buffer is only written when the mic matches, that is when SMTC_MODEM_CRYPTO_RC_SUCCESS is returned
+ *
+ * @param [in] buffer Frame buffer
+ * @param [in] size Frame size, mic excluded
+ * @param [in] payload_offset Index of the payload in the frame, size when there is nothing to decrypt
+ * @param [in] dec_key_id Payload decryption key identifier
+ * @param [in] mic_key_id Mic key identifier
+ * @param [in] devaddr Device address
+ * @param [in] dir Frame direction [0: uplink, 1: downlink]
+ * @param [in] fcnt Frame counter
+ * @param [in] expected_mic Expected mic field
+ * @param [out] dec_buffer Decrypted payload, may overlap buffer
+ * @return smtc_modem_crypto_return_code_t
+ */
+smtc_modem_crypto_return_code_t smtc_modem_crypto_verify_mic_and_payload_decrypt(
+    const uint8_t* buffer, uint16_t size, uint16_t payload_offset, smtc_se_key_identifier_t dec_key_id,
+    smtc_se_key_identifier_t mic_key_id, uint32_t devaddr, uint8_t dir, uint32_t fcnt, uint32_t expected_mic,
+    uint8_t* dec_buffer );
+
 /**
  * @brief Sets a key
  *
@@ -203,6 +203,49 @@ smtc_se_return_code_t smtc_secure_element_verify_aes_cmac( uint8_t* buffer, uint
 smtc_se_return_code_t smtc_secure_element_aes_encrypt( const uint8_t* buffer, uint16_t size,
                                                        smtc_se_key_identifier_t key_id, uint8_t* enc_buffer );
 
+/**
+ * @brief Encrypts or decrypts a buffer in AES CTR mode
+ *
+ * The key stream blocks are a_block with its last 2 bytes replaced by a big endian counter,
+ * starting at the value they hold in a_block and incremented for each block of 16 bytes.
+ *
+ * @param [in] a_block Initial counter block ( 16 bytes )
+ * @param [in] buffer Data buffer
+ * @param [in] size Data buffer size, any value
+ * @param [in] key_id Key identifier to determine the AES key to be used
+ * @param [out] enc_buffer Encrypted buffer, may be the same as buffer
+ * @return Secure element return code as defined in @ref smtc_se_return_code_t
+ */
+smtc_se_return_code_t smtc_secure_element_aes_ctr_encrypt( const uint8_t a_block[16], const uint8_t* buffer,
+                                                           uint16_t size, smtc_se_key_identifier_t key_id,
+                                                           uint8_t* enc_buffer );
+
+/**
+ * @brief Encrypts or decrypts in AES CTR mode the end of a frame and computes the CMAC of the frame in one pass
+ *
+ * The CMAC is computed over mic_bx_buffer ( if not NULL ), the first enc_offset bytes of buffer and the encrypted
+ * part of the frame: the output of the encryption when encrypt is true, the input of the decryption otherwise.
+ * The AES key schedules are resolved once for the whole frame.
+ *
+ * @param [in] a_block Initial counter block ( 16 bytes ), see @ref smtc_secure_element_aes_ctr_encrypt
+ * @param [in] mic_bx_buffer Buffer containing the initial Bx block
+ * @param [in] buffer Frame buffer
+ * @param [in] size Frame buffer size
+ * @param [in] enc_offset Index in buffer of the first byte to encrypt or decrypt, size when there is none
+ * @param [in] encrypt True to encrypt then compute the CMAC, false to compute the CMAC then decrypt
+ * @param [in] enc_key_id Key identifier of the AES CTR key
+ * @param [in] mac_key_id Key identifier of the CMAC key
+ * @param [out] enc_buffer Receives the size - enc_offset processed bytes, may be buffer + enc_offset or any place
+ *                         starting before it in buffer ( unused when there are none )
+ * @param [out] cmac Computed cmac
+ * @return Secure element return code as defined in @ref smtc_se_return_code_t
+ */
+smtc_se_return_code_t smtc_secure_element_aes_ctr_and_cmac( const uint8_t a_block[16], uint8_t* mic_bx_buffer,
+                                                            const uint8_t* buffer, uint16_t size, uint16_t enc_offset,
+                                                            bool encrypt, smtc_se_key_identifier_t enc_key_id,
+                                                            smtc_se_key_identifier_t mac_key_id, uint8_t* enc_buffer,
+                                                            uint32_t* cmac );
+
 /**
  * @brief Derives and store a key
  *
@@ -0,0 +1,420 @@
+/**
+ * @file      aes_fast.c
+ *
+ * @brief     Word oriented AES (T-table) backend of the soft secure element, selected by CRYPTO=SOFT_FAST
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>  // C99 types
+#include <stdlib.h>  // EXIT_SUCCESS, EXIT_FAILURE
+#include <string.h>  // memcpy
+
+#include "aes.h"
+
+#if defined( __AES__ ) && defined( __SSE2__ )
+#include <wmmintrin.h>
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#define ROTL8( x ) ( ( ( x ) << 8 ) | ( ( x ) >> 24 ) )
+#define ROTL16( x ) ( ( ( x ) << 16 ) | ( ( x ) >> 16 ) )
+#define ROTL24( x ) ( ( ( x ) << 24 ) | ( ( x ) >> 8 ) )
+
+/*!
+ * Byte n of a state word, byte 0 being the first byte of the column in memory
+ */
+#define BYTE( x, n ) ( ( uint8_t ) ( ( x ) >> ( 8 * ( n ) ) ) )
+
+/*!
+ * S-box, the byte 1 of every T-table entry
+ */
+#define SBOX( x ) ( ( uint8_t ) ( te0[( x )] >> 8 ) )
+
+/*!
+ * Multiplication by x in GF(2^8)
+ */
+#define XTIME( x ) ( ( uint8_t ) ( ( ( x ) << 1 ) ^ ( ( ( x ) & 0x80 ) ? 0x1B : 0x00 ) ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * Round T-table: SubBytes and MixColumns of the first row of a column,
+ * { 2.S[x], S[x], S[x], 3.S[x] } from the least significant byte.
+ * The 3 other rows use the same table rotated by 8, 16 and 24 bits.
+ */
+static const uint32_t te0[256] = {
+    0xA56363C6, 0x847C7CF8, 0x997777EE, 0x8D7B7BF6, 0x0DF2F2FF, 0xBD6B6BD6, 0xB16F6FDE, 0x54C5C591,
+    0x50303060, 0x03010102, 0xA96767CE, 0x7D2B2B56, 0x19FEFEE7, 0x62D7D7B5, 0xE6ABAB4D, 0x9A7676EC,
+    0x45CACA8F, 0x9D82821F, 0x40C9C989, 0x877D7DFA, 0x15FAFAEF, 0xEB5959B2, 0xC947478E, 0x0BF0F0FB,
+    0xECADAD41, 0x67D4D4B3, 0xFDA2A25F, 0xEAAFAF45, 0xBF9C9C23, 0xF7A4A453, 0x967272E4, 0x5BC0C09B,
+    0xC2B7B775, 0x1CFDFDE1, 0xAE93933D, 0x6A26264C, 0x5A36366C, 0x413F3F7E, 0x02F7F7F5, 0x4FCCCC83,
+    0x5C343468, 0xF4A5A551, 0x34E5E5D1, 0x08F1F1F9, 0x937171E2, 0x73D8D8AB, 0x53313162, 0x3F15152A,
+    0x0C040408, 0x52C7C795, 0x65232346, 0x5EC3C39D, 0x28181830, 0xA1969637, 0x0F05050A, 0xB59A9A2F,
+    0x0907070E, 0x36121224, 0x9B80801B, 0x3DE2E2DF, 0x26EBEBCD, 0x6927274E, 0xCDB2B27F, 0x9F7575EA,
+    0x1B090912, 0x9E83831D, 0x742C2C58, 0x2E1A1A34, 0x2D1B1B36, 0xB26E6EDC, 0xEE5A5AB4, 0xFBA0A05B,
+    0xF65252A4, 0x4D3B3B76, 0x61D6D6B7, 0xCEB3B37D, 0x7B292952, 0x3EE3E3DD, 0x712F2F5E, 0x97848413,
+    0xF55353A6, 0x68D1D1B9, 0x00000000, 0x2CEDEDC1, 0x60202040, 0x1FFCFCE3, 0xC8B1B179, 0xED5B5BB6,
+    0xBE6A6AD4, 0x46CBCB8D, 0xD9BEBE67, 0x4B393972, 0xDE4A4A94, 0xD44C4C98, 0xE85858B0, 0x4ACFCF85,
+    0x6BD0D0BB, 0x2AEFEFC5, 0xE5AAAA4F, 0x16FBFBED, 0xC5434386, 0xD74D4D9A, 0x55333366, 0x94858511,
+    0xCF45458A, 0x10F9F9E9, 0x06020204, 0x817F7FFE, 0xF05050A0, 0x443C3C78, 0xBA9F9F25, 0xE3A8A84B,
+    0xF35151A2, 0xFEA3A35D, 0xC0404080, 0x8A8F8F05, 0xAD92923F, 0xBC9D9D21, 0x48383870, 0x04F5F5F1,
+    0xDFBCBC63, 0xC1B6B677, 0x75DADAAF, 0x63212142, 0x30101020, 0x1AFFFFE5, 0x0EF3F3FD, 0x6DD2D2BF,
+    0x4CCDCD81, 0x140C0C18, 0x35131326, 0x2FECECC3, 0xE15F5FBE, 0xA2979735, 0xCC444488, 0x3917172E,
+    0x57C4C493, 0xF2A7A755, 0x827E7EFC, 0x473D3D7A, 0xAC6464C8, 0xE75D5DBA, 0x2B191932, 0x957373E6,
+    0xA06060C0, 0x98818119, 0xD14F4F9E, 0x7FDCDCA3, 0x66222244, 0x7E2A2A54, 0xAB90903B, 0x8388880B,
+    0xCA46468C, 0x29EEEEC7, 0xD3B8B86B, 0x3C141428, 0x79DEDEA7, 0xE25E5EBC, 0x1D0B0B16, 0x76DBDBAD,
+    0x3BE0E0DB, 0x56323264, 0x4E3A3A74, 0x1E0A0A14, 0xDB494992, 0x0A06060C, 0x6C242448, 0xE45C5CB8,
+    0x5DC2C29F, 0x6ED3D3BD, 0xEFACAC43, 0xA66262C4, 0xA8919139, 0xA4959531, 0x37E4E4D3, 0x8B7979F2,
+    0x32E7E7D5, 0x43C8C88B, 0x5937376E, 0xB76D6DDA, 0x8C8D8D01, 0x64D5D5B1, 0xD24E4E9C, 0xE0A9A949,
+    0xB46C6CD8, 0xFA5656AC, 0x07F4F4F3, 0x25EAEACF, 0xAF6565CA, 0x8E7A7AF4, 0xE9AEAE47, 0x18080810,
+    0xD5BABA6F, 0x887878F0, 0x6F25254A, 0x722E2E5C, 0x241C1C38, 0xF1A6A657, 0xC7B4B473, 0x51C6C697,
+    0x23E8E8CB, 0x7CDDDDA1, 0x9C7474E8, 0x211F1F3E, 0xDD4B4B96, 0xDCBDBD61, 0x868B8B0D, 0x858A8A0F,
+    0x907070E0, 0x423E3E7C, 0xC4B5B571, 0xAA6666CC, 0xD8484890, 0x05030306, 0x01F6F6F7, 0x120E0E1C,
+    0xA36161C2, 0x5F35356A, 0xF95757AE, 0xD0B9B969, 0x91868617, 0x58C1C199, 0x271D1D3A, 0xB99E9E27,
+    0x38E1E1D9, 0x13F8F8EB, 0xB398982B, 0x33111122, 0xBB6969D2, 0x70D9D9A9, 0x898E8E07, 0xA7949433,
+    0xB69B9B2D, 0x221E1E3C, 0x92878715, 0x20E9E9C9, 0x49CECE87, 0xFF5555AA, 0x78282850, 0x7ADFDFA5,
+    0x8F8C8C03, 0xF8A1A159, 0x80898909, 0x170D0D1A, 0xDABFBF65, 0x31E6E6D7, 0xC6424284, 0xB86868D0,
+    0xC3414182, 0xB0999929, 0x772D2D5A, 0x110F0F1E, 0xCBB0B07B, 0xFC5454A8, 0xD6BBBB6D, 0x3A16162C
+};
+
+#if defined( AES_DEC_PREKEYED )
+/*!
+ * Inverse S-box
+ */
+static const uint8_t inv_sbox[256] = {
+    0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+    0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+    0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+    0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+    0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+    0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+    0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+    0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+    0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+    0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+    0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+    0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+    0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+    0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+    0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+};
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * \brief Loads 4 bytes as a little endian word, no alignment required
+ *
+ * \param [IN] buf Bytes to load
+ * \retval word    buf[0] in the least significant byte
+ */
+static inline uint32_t load_le32( const uint8_t* buf );
+
+/*!
+ * \brief Stores a word as 4 little endian bytes, no alignment required
+ *
+ * \param [OUT] buf  Destination of the bytes
+ * \param [IN]  word Word to store, least significant byte first
+ */
+static inline void store_le32( uint8_t* buf, uint32_t word );
+
+#if defined( AES_DEC_PREKEYED )
+/*!
+ * \brief Multiplies in GF(2^8), used by the inverse MixColumns only
+ *
+ * \param [IN] a 1st factor
+ * \param [IN] b 2nd factor
+ * \retval product a.b
+ */
+static uint8_t gf_mul( uint8_t a, uint8_t b );
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+#if defined( AES_ENC_PREKEYED ) || defined( AES_DEC_PREKEYED )
+
+return_type aes_set_key( const uint8_t key[], length_type keylen, aes_context ctx[1] )
+{
+    uint8_t rc = 1;
+    uint8_t hi;
+
+    switch( keylen )
+    {
+    case 16:
+    case 24:
+    case 32:
+        break;
+    default:
+        ctx->rnd = 0;
+        return ( uint8_t ) -1;
+    }
+
+    // Same byte layout as the reference implementation: round r key is ksch[16 * r] to ksch[16 * r + 15]
+    memcpy( ctx->ksch, key, keylen );
+    hi       = ( keylen + 28 ) << 2;
+    ctx->rnd = ( hi >> 4 ) - 1;
+    for( uint8_t cc = keylen; cc < hi; cc += 4 )
+    {
+        uint32_t word = load_le32( &ctx->ksch[cc - 4] );
+
+        if( ( cc % keylen ) == 0 )
+        {
+            // RotWord, SubWord and Rcon
+            word = ( ( uint32_t ) ( SBOX( BYTE( word, 1 ) ) ^ rc ) | ( ( uint32_t ) SBOX( BYTE( word, 2 ) ) << 8 ) |
+                     ( ( uint32_t ) SBOX( BYTE( word, 3 ) ) << 16 ) | ( ( uint32_t ) SBOX( BYTE( word, 0 ) ) << 24 ) );
+            rc   = XTIME( rc );
+        }
+        else if( ( keylen > 24 ) && ( ( cc % keylen ) == 16 ) )
+        {
+            word = ( uint32_t ) SBOX( BYTE( word, 0 ) ) | ( ( uint32_t ) SBOX( BYTE( word, 1 ) ) << 8 ) |
+                   ( ( uint32_t ) SBOX( BYTE( word, 2 ) ) << 16 ) | ( ( uint32_t ) SBOX( BYTE( word, 3 ) ) << 24 );
+        }
+        store_le32( &ctx->ksch[cc], load_le32( &ctx->ksch[cc - keylen] ) ^ word );
+    }
+    return 0;
+}
+
+#endif
+
+#if defined( AES_ENC_PREKEYED )
+
+return_type aes_encrypt( const uint8_t in[N_BLOCK], uint8_t out[N_BLOCK], const aes_context ctx[1] )
+{
+    if( ctx->rnd == 0 )
+    {
+        return ( uint8_t ) -1;
+    }
+
+#if defined( __AES__ ) && defined( __SSE2__ )
+    __m128i state = _mm_xor_si128( _mm_loadu_si128( ( const __m128i* ) in ),
+                                   _mm_loadu_si128( ( const __m128i* ) ctx->ksch ) );
+
+    for( uint8_t r = 1; r < ctx->rnd; r++ )
+    {
+        state = _mm_aesenc_si128( state, _mm_loadu_si128( ( const __m128i* ) &ctx->ksch[r * N_BLOCK] ) );
+    }
+    state = _mm_aesenclast_si128( state, _mm_loadu_si128( ( const __m128i* ) &ctx->ksch[ctx->rnd * N_BLOCK] ) );
+    _mm_storeu_si128( ( __m128i* ) out, state );
+#else
+    const uint8_t* rk = ctx->ksch;
+    uint32_t       s0 = load_le32( &in[0] ) ^ load_le32( &rk[0] );
+    uint32_t       s1 = load_le32( &in[4] ) ^ load_le32( &rk[4] );
+    uint32_t       s2 = load_le32( &in[8] ) ^ load_le32( &rk[8] );
+    uint32_t       s3 = load_le32( &in[12] ) ^ load_le32( &rk[12] );
+    uint32_t       t0, t1, t2, t3;
+
+    // Row n of the output column c comes from the column c + n (ShiftRows)
+    for( uint8_t r = 1; r < ctx->rnd; r++ )
+    {
+        rk += N_BLOCK;
+        t0 = te0[BYTE( s0, 0 )] ^ ROTL8( te0[BYTE( s1, 1 )] ) ^ ROTL16( te0[BYTE( s2, 2 )] ) ^
+             ROTL24( te0[BYTE( s3, 3 )] ) ^ load_le32( &rk[0] );
+        t1 = te0[BYTE( s1, 0 )] ^ ROTL8( te0[BYTE( s2, 1 )] ) ^ ROTL16( te0[BYTE( s3, 2 )] ) ^
+             ROTL24( te0[BYTE( s0, 3 )] ) ^ load_le32( &rk[4] );
+        t2 = te0[BYTE( s2, 0 )] ^ ROTL8( te0[BYTE( s3, 1 )] ) ^ ROTL16( te0[BYTE( s0, 2 )] ) ^
+             ROTL24( te0[BYTE( s1, 3 )] ) ^ load_le32( &rk[8] );
+        t3 = te0[BYTE( s3, 0 )] ^ ROTL8( te0[BYTE( s0, 1 )] ) ^ ROTL16( te0[BYTE( s1, 2 )] ) ^
+             ROTL24( te0[BYTE( s2, 3 )] ) ^ load_le32( &rk[12] );
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // Last round has no MixColumns
+    rk += N_BLOCK;
+    t0 = ( ( uint32_t ) SBOX( BYTE( s0, 0 ) ) | ( ( uint32_t ) SBOX( BYTE( s1, 1 ) ) << 8 ) |
+           ( ( uint32_t ) SBOX( BYTE( s2, 2 ) ) << 16 ) | ( ( uint32_t ) SBOX( BYTE( s3, 3 ) ) << 24 ) );
+    t1 = ( ( uint32_t ) SBOX( BYTE( s1, 0 ) ) | ( ( uint32_t ) SBOX( BYTE( s2, 1 ) ) << 8 ) |
+           ( ( uint32_t ) SBOX( BYTE( s3, 2 ) ) << 16 ) | ( ( uint32_t ) SBOX( BYTE( s0, 3 ) ) << 24 ) );
+    t2 = ( ( uint32_t ) SBOX( BYTE( s2, 0 ) ) | ( ( uint32_t ) SBOX( BYTE( s3, 1 ) ) << 8 ) |
+           ( ( uint32_t ) SBOX( BYTE( s0, 2 ) ) << 16 ) | ( ( uint32_t ) SBOX( BYTE( s1, 3 ) ) << 24 ) );
+    t3 = ( ( uint32_t ) SBOX( BYTE( s3, 0 ) ) | ( ( uint32_t ) SBOX( BYTE( s0, 1 ) ) << 8 ) |
+           ( ( uint32_t ) SBOX( BYTE( s1, 2 ) ) << 16 ) | ( ( uint32_t ) SBOX( BYTE( s2, 3 ) ) << 24 ) );
+    store_le32( &out[0], t0 ^ load_le32( &rk[0] ) );
+    store_le32( &out[4], t1 ^ load_le32( &rk[4] ) );
+    store_le32( &out[8], t2 ^ load_le32( &rk[8] ) );
+    store_le32( &out[12], t3 ^ load_le32( &rk[12] ) );
+#endif
+    return 0;
+}
+
+return_type aes_cbc_encrypt( const uint8_t* in, uint8_t* out, int32_t n_block, uint8_t iv[N_BLOCK],
+                             const aes_context ctx[1] )
+{
+    while( n_block-- )
+    {
+        for( uint8_t i = 0; i < N_BLOCK; i++ )
+        {
+            iv[i] ^= in[i];
+        }
+        if( aes_encrypt( iv, iv, ctx ) != EXIT_SUCCESS )
+        {
+            return EXIT_FAILURE;
+        }
+        memcpy( out, iv, N_BLOCK );
+        in += N_BLOCK;
+        out += N_BLOCK;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif
+
+#if defined( AES_DEC_PREKEYED )
+
+return_type aes_decrypt( const uint8_t in[N_BLOCK], uint8_t out[N_BLOCK], const aes_context ctx[1] )
+{
+    uint8_t s[N_BLOCK];
+    uint8_t t[N_BLOCK];
+
+    if( ctx->rnd == 0 )
+    {
+        return ( uint8_t ) -1;
+    }
+
+    // Only the host simulation decrypts, a byte oriented inverse cipher is enough
+    for( uint8_t i = 0; i < N_BLOCK; i++ )
+    {
+        s[i] = in[i] ^ ctx->ksch[ctx->rnd * N_BLOCK + i];
+    }
+    for( uint8_t r = ctx->rnd; r-- > 0; )
+    {
+        // InvShiftRows and InvSubBytes: row n of column c goes to column c + n
+        for( uint8_t c = 0; c < N_COL; c++ )
+        {
+            for( uint8_t n = 0; n < N_ROW; n++ )
+            {
+                t[( ( ( c + n ) & 0x03 ) * N_ROW ) + n] = inv_sbox[s[( c * N_ROW ) + n]];
+            }
+        }
+        for( uint8_t i = 0; i < N_BLOCK; i++ )
+        {
+            t[i] ^= ctx->ksch[r * N_BLOCK + i];
+        }
+        if( r == 0 )
+        {
+            memcpy( out, t, N_BLOCK );
+            break;
+        }
+        // InvMixColumns
+        for( uint8_t c = 0; c < N_BLOCK; c += N_ROW )
+        {
+            s[c + 0] = gf_mul( t[c], 14 ) ^ gf_mul( t[c + 1], 11 ) ^ gf_mul( t[c + 2], 13 ) ^ gf_mul( t[c + 3], 9 );
+            s[c + 1] = gf_mul( t[c], 9 ) ^ gf_mul( t[c + 1], 14 ) ^ gf_mul( t[c + 2], 11 ) ^ gf_mul( t[c + 3], 13 );
+            s[c + 2] = gf_mul( t[c], 13 ) ^ gf_mul( t[c + 1], 9 ) ^ gf_mul( t[c + 2], 14 ) ^ gf_mul( t[c + 3], 11 );
+            s[c + 3] = gf_mul( t[c], 11 ) ^ gf_mul( t[c + 1], 13 ) ^ gf_mul( t[c + 2], 9 ) ^ gf_mul( t[c + 3], 14 );
+        }
+    }
+    return 0;
+}
+
+return_type aes_cbc_decrypt( const uint8_t* in, uint8_t* out, int32_t n_block, uint8_t iv[N_BLOCK],
+                             const aes_context ctx[1] )
+{
+    while( n_block-- )
+    {
+        uint8_t tmp[N_BLOCK];
+
+        memcpy( tmp, in, N_BLOCK );
+        if( aes_decrypt( in, out, ctx ) != EXIT_SUCCESS )
+        {
+            return EXIT_FAILURE;
+        }
+        for( uint8_t i = 0; i < N_BLOCK; i++ )
+        {
+            out[i] ^= iv[i];
+        }
+        memcpy( iv, tmp, N_BLOCK );
+        in += N_BLOCK;
+        out += N_BLOCK;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static inline uint32_t load_le32( const uint8_t* buf )
+{
+    return ( uint32_t ) buf[0] | ( ( uint32_t ) buf[1] << 8 ) | ( ( uint32_t ) buf[2] << 16 ) |
+           ( ( uint32_t ) buf[3] << 24 );
+}
+
+static inline void store_le32( uint8_t* buf, uint32_t word )
+{
+    buf[0] = ( uint8_t ) word;
+    buf[1] = ( uint8_t ) ( word >> 8 );
+    buf[2] = ( uint8_t ) ( word >> 16 );
+    buf[3] = ( uint8_t ) ( word >> 24 );
+}
+
+#if defined( AES_DEC_PREKEYED )
+static uint8_t gf_mul( uint8_t a, uint8_t b )
+{
+    uint8_t product = 0;
+
+    while( b != 0 )
+    {
+        if( ( b & 0x01 ) != 0 )
+        {
+            product ^= a;
+        }
+        a = XTIME( a );
+        b >>= 1;
+    }
+    return product;
+}
+#endif
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,135 @@
+/**
+ * @file      smtc_secure_element_ctx.h
+ *
+ * @brief     Software secure element state of one modem instance
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_SECURE_ELEMENT_CTX_H__
+#define SMTC_SECURE_ELEMENT_CTX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "smtc_secure_element.h"
+#include "aes.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Number of keys supported in soft secure element
+ */
+#define SOFT_SE_NUMBER_OF_KEYS 23
+
+/*!
+ * Number of expanded AES key schedules kept per modem, least recently used one is replaced
+ */
+#ifndef SOFT_SE_KEY_SCHEDULE_CACHE_NB
+#define SOFT_SE_KEY_SCHEDULE_CACHE_NB 4
+#endif
+
+/*!
+ * Value of key_schedule_index for a key whose expanded key is not cached
+ */
+#define SOFT_SE_KEY_SCHEDULE_NOT_READY 0xFF
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Key structure definition for the soft-se
+ *
+ * @struct soft_se_key_t
+ */
+typedef struct soft_se_key_s
+{
+    smtc_se_key_identifier_t key_id;                       //!< Key identifier
+    uint8_t                  key_value[SMTC_SE_KEY_SIZE];  //!< Key value
+} soft_se_key_t;
+
+/**
+ * @brief Structure for data needed by soft secure element
+ *
+ * @struct soft_se_data_t
+ */
+typedef struct soft_se_data_s
+{
+    uint8_t       deveui[SMTC_SE_EUI_SIZE];          //!< DevEUI storage
+    uint8_t       joineui[SMTC_SE_EUI_SIZE];         //!< Join EUI storage
+    uint8_t       pin[SMTC_SE_PIN_SIZE];             //!< pin storage
+    soft_se_key_t key_list[SOFT_SE_NUMBER_OF_KEYS];  //!< The key list
+} soft_se_data_t;
+
+/**
+ * @brief Expanded AES key schedule of one key of the key list
+ *
+ * @struct soft_se_key_schedule_t
+ */
+typedef struct soft_se_key_schedule_s
+{
+    aes_context              aes_ctx;   //!< Expanded key
+    smtc_se_key_identifier_t key_id;    //!< Key identifier, SMTC_SE_NO_KEY when the slot is free
+    uint32_t                 last_use;  //!< Value of key_schedule_tick when last used
+} soft_se_key_schedule_t;
+
+/**
+ * @brief Secure element part of the modem context, see smtc_modem_ctx_t
+ *
+ * @struct smtc_secure_element_ctx_t
+ */
+typedef struct smtc_secure_element_ctx_s
+{
+    soft_se_data_t         data;  //!< Identity and keys of the device, also saved in NVM
+#if !defined( SOFT_SE_HW_ACCEL )
+    soft_se_key_schedule_t key_schedule[SOFT_SE_KEY_SCHEDULE_CACHE_NB];  //!< Expanded keys, not saved in NVM
+    uint8_t                key_schedule_index[SOFT_SE_NUMBER_OF_KEYS];   //!< Slot of each key in key_schedule
+    uint32_t               key_schedule_tick;                            //!< LRU clock of key_schedule
+#endif
+} smtc_secure_element_ctx_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_SECURE_ELEMENT_CTX_H__
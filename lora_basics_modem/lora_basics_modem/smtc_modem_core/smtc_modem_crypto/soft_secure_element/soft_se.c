@@ -41,10 +41,14 @@
 #include <stdbool.h>  // bool type
 
 #include "smtc_secure_element.h"
+#include "smtc_secure_element_ctx.h"
+#include "smtc_modem_ctx.h"
 
 #include "aes.h"
 #include "cmac.h"
 
+#include "modem_crc32.h"
+
 #include "smtc_modem_hal.h"
 #include "smtc_modem_hal_dbg_trace.h"
 
@@ -60,11 +64,6 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
-/*!
- * Number of keys supported in soft secure element
- */
-#define SOFT_SE_NUMBER_OF_KEYS 23
-
 /*!
  * JoinAccept frame maximum size
  */
@@ -80,6 +79,13 @@
  */
 #define LORAMAC_MHDR_FIELD_SIZE 1
 
+#if defined( SOFT_SE_HW_ACCEL )
+/*!
+ * Largest frame whose cmac is computed over a payload encrypted out of place
+ */
+#define SOFT_SE_HW_ACCEL_MAX_FRAME_SIZE 256
+#endif
+
 #define SOFT_SE_KEY_LIST                                                                                             \
     {                                                                                                                \
         {                                                                                                            \
@@ -280,30 +286,6 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
-/**
- * @brief Key structure definition for the soft-se
- *
- * @struct soft_se_key_t
- */
-typedef struct soft_se_key_s
-{
-    smtc_se_key_identifier_t key_id;                       //!< Key identifier
-    uint8_t                  key_value[SMTC_SE_KEY_SIZE];  //!< Key value
-} soft_se_key_t;
-
-/**
- * @brief Structure for data needed by soft secure element
- *
- * @struct soft_se_data_t
- */
-typedef struct soft_se_data_s
-{
-    uint8_t       deveui[SMTC_SE_EUI_SIZE];          //!< DevEUI storage
-    uint8_t       joineui[SMTC_SE_EUI_SIZE];         //!< Join EUI storage
-    uint8_t       pin[SMTC_SE_PIN_SIZE];             //!< pin storage
-    soft_se_key_t key_list[SOFT_SE_NUMBER_OF_KEYS];  //!< The key list
-} soft_se_data_t;
-
 /**
  * @brief Struture for soft secure element context saving in NVM
  *
@@ -320,8 +302,6 @@ typedef struct soft_se_context_nvm_s
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static soft_se_data_t soft_se_data = { 0 };
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -331,6 +311,15 @@ static soft_se_data_t soft_se_data = { 0 };
  * Local functions
  */
 
+/**
+ * @brief Gets the index of a key in the key list
+ *
+ * @param [in] key_id Key identifier
+ * @param [out] index Index of the key in soft_se_data.key_list
+ * @return smtc_se_return_code_t
+ */
+static smtc_se_return_code_t get_key_index( smtc_se_key_identifier_t key_id, uint8_t* index );
+
 /**
  * @brief Gets key item from key list.
  *
@@ -340,6 +329,24 @@ static soft_se_data_t soft_se_data = { 0 };
  */
 static smtc_se_return_code_t get_key_by_id( smtc_se_key_identifier_t key_id, soft_se_key_t** key_item );
 
+#if !defined( SOFT_SE_HW_ACCEL )
+/**
+ * @brief Gets the expanded AES key schedule of a key, expanding it if it is not cached
+ *
+ * @param [in] key_id Key identifier
+ * @param [out] aes_ctx Expanded key, valid until the next call
+ * @return smtc_se_return_code_t
+ */
+static smtc_se_return_code_t get_key_schedule( smtc_se_key_identifier_t key_id, const aes_context** aes_ctx );
+#endif
+
+/**
+ * @brief Drops the cached key schedule of a key whose value changed
+ *
+ * @param [in] key_id Key identifier, SMTC_SE_NO_KEY drops all of them
+ */
+static void invalidate_key_schedule( smtc_se_key_identifier_t key_id );
+
 /**
  * @brief Computes a CMAC of a message using provided initial Bx block
  *
@@ -355,15 +362,6 @@ static smtc_se_return_code_t get_key_by_id( smtc_se_key_identifier_t key_id, sof
 static smtc_se_return_code_t compute_cmac( uint8_t* mic_bx_buffer, const uint8_t* buffer, uint16_t size,
                                            smtc_se_key_identifier_t key_id, uint32_t* cmac );
 
-/**
- * @brief CRC function for soft se context security
- *
- * @param [in] buf  Data buffer
- * @param [in] len Length of the data
- * @return uint32_t
- */
-uint32_t soft_ce_crc( const uint8_t* buf, int len );
-
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -371,12 +369,15 @@ uint32_t soft_ce_crc( const uint8_t* buf, int len );
 
 smtc_se_return_code_t smtc_secure_element_init( void )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     soft_se_data_t local_data = { .deveui   = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
                                   .joineui  = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
                                   .pin      = { 0x00, 0x00, 0x00, 0x00 },
                                   .key_list = SOFT_SE_KEY_LIST };
     // init soft secure element data euis and pin to 0 and key_list with empty lut
-    memcpy( ( uint8_t* ) &soft_se_data, ( uint8_t* ) &local_data, sizeof( local_data ) );
+    memcpy( ( uint8_t* ) &soft_se_ctx->data, ( uint8_t* ) &local_data, sizeof( local_data ) );
+    invalidate_key_schedule( SMTC_SE_NO_KEY );
 
     SMTC_MODEM_HAL_TRACE_INFO( "Use soft secure element for cryptographic functionalities\n" );
 
@@ -391,30 +392,31 @@ smtc_se_return_code_t smtc_secure_element_set_key( smtc_se_key_identifier_t key_
         return SMTC_SE_RC_ERROR_NPE;
     }
 
-    for( uint8_t i = 0; i < SOFT_SE_NUMBER_OF_KEYS; i++ )
+    soft_se_key_t* key_item;
+
+    if( get_key_by_id( key_id, &key_item ) != SMTC_SE_RC_SUCCESS )
     {
-        if( soft_se_data.key_list[i].key_id == key_id )
-        {
-            if( ( key_id == SMTC_SE_MC_KEY_0 ) || ( key_id == SMTC_SE_MC_KEY_1 ) || ( key_id == SMTC_SE_MC_KEY_2 ) ||
-                ( key_id == SMTC_SE_MC_KEY_3 ) )
-            {  // Decrypt the key if its a Mckey
-                smtc_se_return_code_t rc                = SMTC_SE_RC_ERROR;
-                uint8_t               decrypted_key[16] = { 0 };
+        return SMTC_SE_RC_ERROR_INVALID_KEY_ID;
+    }
 
-                rc = smtc_secure_element_aes_encrypt( key, 16, SMTC_SE_MC_KE_KEY, decrypted_key );
+    if( ( key_id == SMTC_SE_MC_KEY_0 ) || ( key_id == SMTC_SE_MC_KEY_1 ) || ( key_id == SMTC_SE_MC_KEY_2 ) ||
+        ( key_id == SMTC_SE_MC_KEY_3 ) )
+    {  // Decrypt the key if its a Mckey
+        smtc_se_return_code_t rc                = SMTC_SE_RC_ERROR;
+        uint8_t               decrypted_key[16] = { 0 };
 
-                memcpy( soft_se_data.key_list[i].key_value, decrypted_key, SMTC_SE_KEY_SIZE );
-                return rc;
-            }
-            else
-            {
-                memcpy( &( soft_se_data.key_list[i].key_value ), key, SMTC_SE_KEY_SIZE );
-                return SMTC_SE_RC_SUCCESS;
-            }
-        }
-    }
+        rc = smtc_secure_element_aes_encrypt( key, 16, SMTC_SE_MC_KE_KEY, decrypted_key );
 
-    return SMTC_SE_RC_ERROR_INVALID_KEY_ID;
+        memcpy( key_item->key_value, decrypted_key, SMTC_SE_KEY_SIZE );
+        invalidate_key_schedule( key_id );
+        return rc;
+    }
+    else
+    {
+        memcpy( key_item->key_value, key, SMTC_SE_KEY_SIZE );
+        invalidate_key_schedule( key_id );
+        return SMTC_SE_RC_SUCCESS;
+    }
 }
 
 smtc_se_return_code_t smtc_secure_element_compute_aes_cmac( uint8_t* mic_bx_buffer, const uint8_t* buffer,
@@ -469,28 +471,231 @@ smtc_se_return_code_t smtc_secure_element_aes_encrypt( const uint8_t* buffer, ui
         return SMTC_SE_RC_ERROR_BUF_SIZE;
     }
 
-    aes_context aes_ctx;
-    memset( &aes_ctx, 0, sizeof( aes_context ) );
-
+#if defined( SOFT_SE_HW_ACCEL )
     soft_se_key_t*        key_item;
     smtc_se_return_code_t rc = get_key_by_id( key_id, &key_item );
 
-    if( rc == SMTC_SE_RC_SUCCESS )
+    if( ( rc == SMTC_SE_RC_SUCCESS ) &&
+        ( smtc_modem_hal_aes_ecb_encrypt( key_item->key_value, buffer, size, enc_buffer ) == false ) )
     {
-        aes_set_key( key_item->key_value, 16, &aes_ctx );
+        rc = SMTC_SE_RC_FAIL_ENCRYPT;
+    }
+#else
+    const aes_context*    aes_ctx;
+    smtc_se_return_code_t rc = get_key_schedule( key_id, &aes_ctx );
 
-        uint8_t block = 0;
+    if( rc == SMTC_SE_RC_SUCCESS )
+    {
+        uint16_t block = 0;
 
         while( size != 0 )
         {
-            aes_encrypt( &buffer[block], &enc_buffer[block], &aes_ctx );
+            aes_encrypt( &buffer[block], &enc_buffer[block], aes_ctx );
             block = block + 16;
             size  = size - 16;
         }
     }
+#endif
+    return rc;
+}
+
+smtc_se_return_code_t smtc_secure_element_aes_ctr_encrypt( const uint8_t a_block[16], const uint8_t* buffer,
+                                                           uint16_t size, smtc_se_key_identifier_t key_id,
+                                                           uint8_t* enc_buffer )
+{
+    if( ( a_block == NULL ) || ( buffer == NULL ) || ( enc_buffer == NULL ) )
+    {
+        return SMTC_SE_RC_ERROR_NPE;
+    }
+
+#if defined( SOFT_SE_HW_ACCEL )
+    // The accelerator carries into the upper bytes of the counter block, the 16-bit counter must not wrap
+    if( ( ( ( uint32_t ) a_block[14] << 8 ) | a_block[15] ) + ( ( ( uint32_t ) size + 15 ) >> 4 ) > 0x10000 )
+    {
+        return SMTC_SE_RC_ERROR_BUF_SIZE;
+    }
+
+    soft_se_key_t*        key_item;
+    smtc_se_return_code_t rc = get_key_by_id( key_id, &key_item );
+
+    if( ( rc == SMTC_SE_RC_SUCCESS ) &&
+        ( smtc_modem_hal_aes_ctr_encrypt( key_item->key_value, a_block, buffer, size, enc_buffer ) == false ) )
+    {
+        rc = SMTC_SE_RC_FAIL_ENCRYPT;
+    }
+#else
+    const aes_context*    aes_ctx;
+    smtc_se_return_code_t rc = get_key_schedule( key_id, &aes_ctx );
+
+    if( rc == SMTC_SE_RC_SUCCESS )
+    {
+        uint8_t  ctr_block[16];
+        uint8_t  s_block[16];
+        uint16_t ctr   = ( ( uint16_t ) a_block[14] << 8 ) | a_block[15];
+        uint16_t index = 0;
+
+        memcpy( ctr_block, a_block, 14 );
+
+        while( index < size )
+        {
+            uint16_t len = ( ( size - index ) > 16 ) ? 16 : ( size - index );
+
+            ctr_block[14] = ( ctr >> 8 ) & 0xFF;
+            ctr_block[15] = ctr & 0xFF;
+            ctr++;
+
+            aes_encrypt( ctr_block, s_block, aes_ctx );
+            for( uint8_t i = 0; i < len; i++ )
+            {
+                enc_buffer[index + i] = buffer[index + i] ^ s_block[i];
+            }
+            index += len;
+        }
+    }
+#endif
     return rc;
 }
 
+smtc_se_return_code_t smtc_secure_element_aes_ctr_and_cmac( const uint8_t a_block[16], uint8_t* mic_bx_buffer,
+                                                            const uint8_t* buffer, uint16_t size, uint16_t enc_offset,
+                                                            bool encrypt, smtc_se_key_identifier_t enc_key_id,
+                                                            smtc_se_key_identifier_t mac_key_id, uint8_t* enc_buffer,
+                                                            uint32_t* cmac )
+{
+    if( ( a_block == NULL ) || ( buffer == NULL ) || ( cmac == NULL ) ||
+        ( ( enc_buffer == NULL ) && ( enc_offset < size ) ) )
+    {
+        return SMTC_SE_RC_ERROR_NPE;
+    }
+    if( enc_offset > size )
+    {
+        return SMTC_SE_RC_ERROR_BUF_SIZE;
+    }
+
+#if defined( SOFT_SE_HW_ACCEL )
+    // The accelerator works on whole buffers: the cmac is computed over the frame as sent on air, so before the
+    // decryption or after the encryption
+    uint16_t              enc_size = size - enc_offset;
+    bool                  in_place = ( enc_size == 0 ) || ( enc_buffer == &buffer[enc_offset] );
+    uint8_t               mac_buffer[SOFT_SE_HW_ACCEL_MAX_FRAME_SIZE];
+    smtc_se_return_code_t rc = SMTC_SE_RC_SUCCESS;
+
+    if( encrypt == false )
+    {
+        rc = compute_cmac( mic_bx_buffer, buffer, size, mac_key_id, cmac );
+    }
+    else if( in_place == false )
+    {
+        // The encrypted payload may overwrite the header, keep a copy of the frame for the cmac
+        if( size > sizeof( mac_buffer ) )
+        {
+            return SMTC_SE_RC_ERROR_BUF_SIZE;
+        }
+        memcpy( mac_buffer, buffer, enc_offset );
+    }
+
+    if( ( rc == SMTC_SE_RC_SUCCESS ) && ( enc_size != 0 ) )
+    {
+        // The accelerator only supports in place or disjoint buffers
+        if( in_place == false )
+        {
+            memmove( enc_buffer, &buffer[enc_offset], enc_size );
+        }
+        rc = smtc_secure_element_aes_ctr_encrypt( a_block, enc_buffer, enc_size, enc_key_id, enc_buffer );
+    }
+
+    if( ( rc == SMTC_SE_RC_SUCCESS ) && ( encrypt == true ) )
+    {
+        if( in_place == true )
+        {
+            rc = compute_cmac( mic_bx_buffer, buffer, size, mac_key_id, cmac );
+        }
+        else
+        {
+            memcpy( &mac_buffer[enc_offset], enc_buffer, enc_size );
+            rc = compute_cmac( mic_bx_buffer, mac_buffer, size, mac_key_id, cmac );
+        }
+    }
+    return rc;
+#else
+    uint8_t      local_cmac[16];
+    AES_CMAC_CTX aes_cmac_ctx[1];
+
+    AES_CMAC_Init( aes_cmac_ctx );
+
+    const aes_context*    aes_ctx;
+    smtc_se_return_code_t rc = get_key_schedule( mac_key_id, &aes_ctx );
+
+    if( rc != SMTC_SE_RC_SUCCESS )
+    {
+        return rc;
+    }
+
+    // The cmac schedule is copied before the ctr one is looked up, which may evict it from the cache
+    aes_cmac_ctx->rijndael = *aes_ctx;
+
+    if( enc_offset < size )
+    {
+        rc = get_key_schedule( enc_key_id, &aes_ctx );
+        if( rc != SMTC_SE_RC_SUCCESS )
+        {
+            return rc;
+        }
+    }
+
+    if( mic_bx_buffer != NULL )
+    {
+        AES_CMAC_Update( aes_cmac_ctx, mic_bx_buffer, 16 );
+    }
+    AES_CMAC_Update( aes_cmac_ctx, buffer, enc_offset );
+
+    uint8_t  ctr_block[16];
+    uint8_t  s_block[16];
+    uint8_t  data_block[16];
+    uint16_t ctr   = ( ( uint16_t ) a_block[14] << 8 ) | a_block[15];
+    uint16_t index = 0;
+
+    memcpy( ctr_block, a_block, 14 );
+
+    while( index < ( size - enc_offset ) )
+    {
+        uint16_t len = ( ( size - enc_offset - index ) > 16 ) ? 16 : ( size - enc_offset - index );
+
+        ctr_block[14] = ( ctr >> 8 ) & 0xFF;
+        ctr_block[15] = ctr & 0xFF;
+        ctr++;
+
+        // Work on a copy of the block: enc_buffer may overlap buffer before the block being read
+        memcpy( data_block, &buffer[enc_offset + index], len );
+        if( encrypt == false )
+        {
+            AES_CMAC_Update( aes_cmac_ctx, data_block, len );
+        }
+
+        aes_encrypt( ctr_block, s_block, aes_ctx );
+        for( uint8_t i = 0; i < len; i++ )
+        {
+            data_block[i] ^= s_block[i];
+        }
+
+        if( encrypt == true )
+        {
+            AES_CMAC_Update( aes_cmac_ctx, data_block, len );
+        }
+        memcpy( &enc_buffer[index], data_block, len );
+        index += len;
+    }
+
+    AES_CMAC_Final( local_cmac, aes_cmac_ctx );
+
+    // Bring into the required format
+    *cmac = ( uint32_t )( ( uint32_t ) local_cmac[3] << 24 | ( uint32_t ) local_cmac[2] << 16 |
+                          ( uint32_t ) local_cmac[1] << 8 | ( uint32_t ) local_cmac[0] );
+
+    return rc;
+#endif
+}
+
 smtc_se_return_code_t smtc_secure_element_derive_and_store_key( uint8_t* input, smtc_se_key_identifier_t rootkey_id,
                                                                 smtc_se_key_identifier_t targetkey_id )
 {
@@ -597,71 +802,85 @@ smtc_se_return_code_t smtc_secure_element_process_join_accept( smtc_se_join_req_
 
 smtc_se_return_code_t smtc_secure_element_set_deveui( const uint8_t deveui[SMTC_SE_EUI_SIZE] )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     if( deveui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( soft_se_data.deveui, deveui, SMTC_SE_EUI_SIZE );
+    memcpy( soft_se_ctx->data.deveui, deveui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_get_deveui( uint8_t deveui[SMTC_SE_EUI_SIZE] )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     if( deveui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( deveui, soft_se_data.deveui, SMTC_SE_EUI_SIZE );
+    memcpy( deveui, soft_se_ctx->data.deveui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_set_joineui( const uint8_t joineui[SMTC_SE_EUI_SIZE] )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     if( joineui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( soft_se_data.joineui, joineui, SMTC_SE_EUI_SIZE );
+    memcpy( soft_se_ctx->data.joineui, joineui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_get_joineui( uint8_t joineui[SMTC_SE_EUI_SIZE] )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     if( joineui == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( joineui, soft_se_data.joineui, SMTC_SE_EUI_SIZE );
+    memcpy( joineui, soft_se_ctx->data.joineui, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_set_pin( const uint8_t pin[SMTC_SE_PIN_SIZE] )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     if( pin == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
 
-    memcpy( soft_se_data.pin, pin, SMTC_SE_PIN_SIZE );
+    memcpy( soft_se_ctx->data.pin, pin, SMTC_SE_PIN_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_get_pin( uint8_t pin[SMTC_SE_PIN_SIZE] )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     if( pin == NULL )
     {
         return SMTC_SE_RC_ERROR_NPE;
     }
-    memcpy( pin, soft_se_data.pin, SMTC_SE_EUI_SIZE );
+    memcpy( pin, soft_se_ctx->data.pin, SMTC_SE_EUI_SIZE );
     return SMTC_SE_RC_SUCCESS;
 }
 
 smtc_se_return_code_t smtc_secure_element_store_context( void )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     soft_se_context_nvm_t ctx = {
-        .data = soft_se_data,
+        .data = soft_se_ctx->data,
     };
-    ctx.crc = soft_ce_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
+    ctx.crc = modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
 
     smtc_modem_hal_context_store( CONTEXT_SECURE_ELEMENT, ( uint8_t* ) &ctx, sizeof( ctx ) );
     smtc_secure_element_restore_context( );
@@ -670,11 +889,14 @@ smtc_se_return_code_t smtc_secure_element_store_context( void )
 
 smtc_se_return_code_t smtc_secure_element_restore_context( void )
 {
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
     soft_se_context_nvm_t ctx;
     smtc_modem_hal_context_restore( CONTEXT_SECURE_ELEMENT, ( uint8_t* ) &ctx, sizeof( ctx ) );
-    if( soft_ce_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc )
+    invalidate_key_schedule( SMTC_SE_NO_KEY );
+    if( modem_crc32( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc )
     {
-        soft_se_data = ctx.data;
+        soft_se_ctx->data = ctx.data;
         return SMTC_SE_RC_SUCCESS;
     }
     else
@@ -685,7 +907,7 @@ smtc_se_return_code_t smtc_secure_element_restore_context( void )
                                       .pin      = { 0x00, 0x00, 0x00, 0x00 },
                                       .key_list = SOFT_SE_KEY_LIST };
         // init soft secure element data euis and pin to 0 and key_list with empty lut
-        memcpy( ( uint8_t* ) &soft_se_data, ( uint8_t* ) &local_data, sizeof( local_data ) );
+        memcpy( ( uint8_t* ) &soft_se_ctx->data, ( uint8_t* ) &local_data, sizeof( local_data ) );
         return SMTC_SE_RC_ERROR;
     }
 }
@@ -694,17 +916,136 @@ smtc_se_return_code_t smtc_secure_element_restore_context( void )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static smtc_se_return_code_t get_key_index( smtc_se_key_identifier_t key_id, uint8_t* index )
+{
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
+    // SOFT_SE_KEY_LIST holds the keys in identifier order: the unicast ones from 0 to SMTC_SE_MC_ROOT_KEY, then the
+    // multicast ones from SMTC_SE_MC_KE_KEY to SMTC_SE_SLOT_RAND_ZERO_KEY
+    if( key_id <= SMTC_SE_MC_ROOT_KEY )
+    {
+        *index = ( uint8_t ) key_id;
+    }
+    else if( ( key_id >= SMTC_SE_MC_KE_KEY ) && ( key_id <= SMTC_SE_SLOT_RAND_ZERO_KEY ) )
+    {
+        *index = ( uint8_t )( key_id - SMTC_SE_MC_KE_KEY + SMTC_SE_MC_ROOT_KEY + 1 );
+    }
+    else
+    {
+        return SMTC_SE_RC_ERROR_INVALID_KEY_ID;
+    }
+
+    // Also rejects a key list restored from a context with another order
+    if( ( *index >= SOFT_SE_NUMBER_OF_KEYS ) || ( soft_se_ctx->data.key_list[*index].key_id != key_id ) )
+    {
+        return SMTC_SE_RC_ERROR_INVALID_KEY_ID;
+    }
+    return SMTC_SE_RC_SUCCESS;
+}
+
 static smtc_se_return_code_t get_key_by_id( smtc_se_key_identifier_t key_id, soft_se_key_t** key_item )
 {
-    for( uint8_t i = 0; i < SOFT_SE_NUMBER_OF_KEYS; i++ )
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
+    uint8_t               index;
+    smtc_se_return_code_t rc = get_key_index( key_id, &index );
+
+    if( rc == SMTC_SE_RC_SUCCESS )
     {
-        if( soft_se_data.key_list[i].key_id == key_id )
+        *key_item = &( soft_se_ctx->data.key_list[index] );
+    }
+    return rc;
+}
+
+#if !defined( SOFT_SE_HW_ACCEL )
+static smtc_se_return_code_t get_key_schedule( smtc_se_key_identifier_t key_id, const aes_context** aes_ctx )
+{
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
+    uint8_t               index;
+    smtc_se_return_code_t rc = get_key_index( key_id, &index );
+
+    if( rc != SMTC_SE_RC_SUCCESS )
+    {
+        return rc;
+    }
+
+    soft_se_ctx->key_schedule_tick++;
+
+    uint8_t                 slot_index = soft_se_ctx->key_schedule_index[index];
+    soft_se_key_schedule_t* slot;
+
+    if( slot_index != SOFT_SE_KEY_SCHEDULE_NOT_READY )
+    {
+        slot = &soft_se_ctx->key_schedule[slot_index];
+    }
+    else
+    {
+        // Free slots first, then the least recently used one
+        slot_index = 0;
+        for( uint8_t i = 1; i < SOFT_SE_KEY_SCHEDULE_CACHE_NB; i++ )
+        {
+            soft_se_key_schedule_t* best = &soft_se_ctx->key_schedule[slot_index];
+
+            if( ( best->key_id != SMTC_SE_NO_KEY ) &&
+                ( ( soft_se_ctx->key_schedule[i].key_id == SMTC_SE_NO_KEY ) ||
+                  ( ( soft_se_ctx->key_schedule_tick - soft_se_ctx->key_schedule[i].last_use ) >
+                    ( soft_se_ctx->key_schedule_tick - best->last_use ) ) ) )
+            {
+                slot_index = i;
+            }
+        }
+        slot = &soft_se_ctx->key_schedule[slot_index];
+
+        if( slot->key_id != SMTC_SE_NO_KEY )
         {
-            *key_item = &( soft_se_data.key_list[i] );
-            return SMTC_SE_RC_SUCCESS;
+            invalidate_key_schedule( slot->key_id );
         }
+        memset( &slot->aes_ctx, 0, sizeof( aes_context ) );
+        aes_set_key( soft_se_ctx->data.key_list[index].key_value, 16, &slot->aes_ctx );
+        slot->key_id                           = key_id;
+        soft_se_ctx->key_schedule_index[index] = slot_index;
     }
-    return SMTC_SE_RC_ERROR_INVALID_KEY_ID;
+
+    slot->last_use = soft_se_ctx->key_schedule_tick;
+    *aes_ctx       = &slot->aes_ctx;
+    return SMTC_SE_RC_SUCCESS;
+}
+#endif
+
+
+static void invalidate_key_schedule( smtc_se_key_identifier_t key_id )
+{
+#if defined( SOFT_SE_HW_ACCEL )
+    // Keys are given as they are to the accelerator, there is no expanded key to drop
+    ( void ) key_id;
+#else
+    smtc_secure_element_ctx_t* soft_se_ctx = &smtc_modem_current_ctx->secure_element;
+
+    if( key_id == SMTC_SE_NO_KEY )
+    {
+        for( uint8_t i = 0; i < SOFT_SE_KEY_SCHEDULE_CACHE_NB; i++ )
+        {
+            soft_se_ctx->key_schedule[i].key_id = SMTC_SE_NO_KEY;
+        }
+        memset( soft_se_ctx->key_schedule_index, SOFT_SE_KEY_SCHEDULE_NOT_READY,
+                sizeof( soft_se_ctx->key_schedule_index ) );
+        return;
+    }
+
+    uint8_t index;
+
+    if( get_key_index( key_id, &index ) == SMTC_SE_RC_SUCCESS )
+    {
+        uint8_t slot_index = soft_se_ctx->key_schedule_index[index];
+
+        if( slot_index != SOFT_SE_KEY_SCHEDULE_NOT_READY )
+        {
+            soft_se_ctx->key_schedule[slot_index].key_id = SMTC_SE_NO_KEY;
+            soft_se_ctx->key_schedule_index[index]       = SOFT_SE_KEY_SCHEDULE_NOT_READY;
+        }
+    }
+#endif
 }
 
 static smtc_se_return_code_t compute_cmac( uint8_t* mic_bx_buffer, const uint8_t* buffer, uint16_t size,
@@ -715,18 +1056,33 @@ static smtc_se_return_code_t compute_cmac( uint8_t* mic_bx_buffer, const uint8_t
         return SMTC_SE_RC_ERROR_NPE;
     }
 
-    uint8_t      local_cmac[16];
+    uint8_t local_cmac[16];
+
+#if defined( SOFT_SE_HW_ACCEL )
+    soft_se_key_t*        key_item;
+    smtc_se_return_code_t rc = get_key_by_id( key_id, &key_item );
+
+    if( ( rc == SMTC_SE_RC_SUCCESS ) &&
+        ( smtc_modem_hal_aes_cmac( key_item->key_value, mic_bx_buffer, buffer, size, local_cmac ) == false ) )
+    {
+        rc = SMTC_SE_RC_ERROR;
+    }
+
+    if( rc == SMTC_SE_RC_SUCCESS )
+    {
+#else
     AES_CMAC_CTX aes_cmac_ctx[1];
 
     AES_CMAC_Init( aes_cmac_ctx );
 
-    soft_se_key_t* key_item;
+    const aes_context* aes_ctx;
 
-    smtc_se_return_code_t rc = get_key_by_id( key_id, &key_item );
+    smtc_se_return_code_t rc = get_key_schedule( key_id, &aes_ctx );
 
     if( rc == SMTC_SE_RC_SUCCESS )
     {
-        AES_CMAC_SetKey( aes_cmac_ctx, key_item->key_value );
+        // Same as AES_CMAC_SetKey without expanding the key again
+        aes_cmac_ctx->rijndael = *aes_ctx;
 
         if( mic_bx_buffer != NULL )
         {
@@ -736,6 +1092,7 @@ static smtc_se_return_code_t compute_cmac( uint8_t* mic_bx_buffer, const uint8_t
         AES_CMAC_Update( aes_cmac_ctx, buffer, size );
 
         AES_CMAC_Final( local_cmac, aes_cmac_ctx );
+#endif
 
         // Bring into the required format
         *cmac = ( uint32_t )( ( uint32_t ) local_cmac[3] << 24 | ( uint32_t ) local_cmac[2] << 16 |
@@ -745,19 +1102,4 @@ static smtc_se_return_code_t compute_cmac( uint8_t* mic_bx_buffer, const uint8_t
     return rc;
 }
 
-uint32_t soft_ce_crc( const uint8_t* buf, int len )
-{
-    uint32_t crc = 0xFFFFFFFF;
-    while( len-- > 0 )
-    {
-        crc = crc ^ *buf++;
-        for( int i = 0; i < 8; i++ )
-        {
-            uint32_t mask = -( crc & 1 );
-            crc           = ( crc >> 1 ) ^ ( 0xEDB88320 & mask );
-        }
-    }
-    return ~crc;
-}
-
 /* --- EOF ------------------------------------------------------------------ */
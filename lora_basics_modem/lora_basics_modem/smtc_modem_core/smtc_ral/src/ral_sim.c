@@ -0,0 +1,741 @@
+/**
+ * @file      ral_sim.c
+ *
+ * @brief     Radio abstraction layer implementation for the simulated radio
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ral_sim.h"
+#include "ral_sim_bsp.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Seed used by the random number generator when none has been provided by the board
+ */
+#define RAL_SIM_DEFAULT_RANDOM_SEED 0x2545F491
+
+/**
+ * @brief Typical consumption figures of a sub-GHz transceiver, used for the energy accounting
+ */
+#define RAL_SIM_TX_BASE_CONSUMPTION_IN_UA 10000
+#define RAL_SIM_TX_CONSUMPTION_PER_DBM_IN_UA 5000
+#define RAL_SIM_RX_CONSUMPTION_IN_UA 4600
+#define RAL_SIM_RX_BOOSTED_CONSUMPTION_IN_UA 5300
+
+/**
+ * @brief LoRa bandwidths in Hz, indexed by ral_lora_bw_t
+ */
+static const uint32_t ral_sim_lora_bw_in_hz[] = {
+    7810,     // RAL_LORA_BW_007_KHZ
+    10420,    // RAL_LORA_BW_010_KHZ
+    15630,    // RAL_LORA_BW_015_KHZ
+    20830,    // RAL_LORA_BW_020_KHZ
+    31250,    // RAL_LORA_BW_031_KHZ
+    41670,    // RAL_LORA_BW_041_KHZ
+    62500,    // RAL_LORA_BW_062_KHZ
+    125000,   // RAL_LORA_BW_125_KHZ
+    203125,   // RAL_LORA_BW_200_KHZ
+    250000,   // RAL_LORA_BW_250_KHZ
+    406250,   // RAL_LORA_BW_400_KHZ
+    500000,   // RAL_LORA_BW_500_KHZ
+    812500,   // RAL_LORA_BW_800_KHZ
+    1625000,  // RAL_LORA_BW_1600_KHZ
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Start a new operation: any completion still pending is dropped
+ *
+ * @param [in] sim Simulated radio state
+ * @param [in] mode Mode entered by the radio
+ */
+static void ral_sim_enter_mode( ral_sim_t* sim, const ral_sim_mode_t mode );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool ral_sim_process_irq( const void* context )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    if( sim->irq_pending == RAL_IRQ_NONE )
+    {
+        return false;
+    }
+
+    sim->irq_status |= sim->irq_pending & sim->irq_mask;
+    sim->irq_pending = RAL_IRQ_NONE;
+
+    if( ( sim->mode != RAL_SIM_MODE_RX ) || ( sim->rx_is_continuous == false ) )
+    {
+        sim->mode = RAL_SIM_MODE_STANDBY;
+    }
+
+    return ( sim->irq_status != RAL_IRQ_NONE ) ? true : false;
+}
+
+void ral_sim_load_rx_frame( const void* context, const uint8_t* buffer, const uint16_t size_in_bytes,
+                            const int16_t rssi_in_dbm, const int16_t snr_in_db )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    sim->buffer_size_in_bytes =
+        ( size_in_bytes > RAL_SIM_BUFFER_SIZE_IN_BYTES ) ? RAL_SIM_BUFFER_SIZE_IN_BYTES : size_in_bytes;
+    memcpy( sim->buffer, buffer, sim->buffer_size_in_bytes );
+
+    sim->lora_rx_pkt_status.rssi_pkt_in_dbm        = rssi_in_dbm;
+    sim->lora_rx_pkt_status.snr_pkt_in_db          = snr_in_db;
+    sim->lora_rx_pkt_status.signal_rssi_pkt_in_dbm = rssi_in_dbm;
+
+    sim->gfsk_rx_pkt_status.rx_status        = RAL_RX_STATUS_PKT_RECEIVED;
+    sim->gfsk_rx_pkt_status.rssi_sync_in_dbm = rssi_in_dbm;
+    sim->gfsk_rx_pkt_status.rssi_avg_in_dbm  = rssi_in_dbm;
+}
+
+bool ral_sim_handles_part( const char* part_number )
+{
+    return ( strcmp( "sim", part_number ) == 0 );
+}
+
+ral_status_t ral_sim_reset( const void* context )
+{
+    ral_sim_t* sim          = ( ral_sim_t* ) context;
+    void*      bsp_context  = sim->bsp_context;
+    uint32_t   random_state = sim->random_state;
+
+    ral_sim_bsp_cancel_irq( context );
+
+    memset( sim, 0, sizeof( ral_sim_t ) );
+    sim->bsp_context      = bsp_context;
+    sim->random_state     = ( random_state != 0 ) ? random_state : RAL_SIM_DEFAULT_RANDOM_SEED;
+    sim->mode             = RAL_SIM_MODE_STANDBY;
+    sim->pkt_type         = RAL_PKT_TYPE_GFSK;
+    sim->rssi_inst_in_dbm = RAL_SIM_NOISE_FLOOR_IN_DBM;
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_init( const void* context )
+{
+    ral_sim_enter_mode( ( ral_sim_t* ) context, RAL_SIM_MODE_STANDBY );
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_wakeup( const void* context )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    if( sim->mode == RAL_SIM_MODE_SLEEP )
+    {
+        sim->mode = RAL_SIM_MODE_STANDBY;
+    }
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_sleep( const void* context, const bool retain_config )
+{
+    ral_sim_enter_mode( ( ral_sim_t* ) context, RAL_SIM_MODE_SLEEP );
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_standby( const void* context, ral_standby_cfg_t standby_cfg )
+{
+    ral_sim_enter_mode( ( ral_sim_t* ) context, RAL_SIM_MODE_STANDBY );
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_fs( const void* context )
+{
+    ral_sim_enter_mode( ( ral_sim_t* ) context, RAL_SIM_MODE_FS );
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_tx( const void* context )
+{
+    ral_sim_t* sim               = ( ral_sim_t* ) context;
+    uint32_t   time_on_air_in_ms = 0;
+    uint16_t   size_in_bytes     = 0;
+
+    if( sim->pkt_type == RAL_PKT_TYPE_LORA )
+    {
+        time_on_air_in_ms = ral_sim_get_lora_time_on_air_in_ms( &sim->lora_pkt_params, &sim->lora_mod_params );
+        size_in_bytes     = sim->lora_pkt_params.pld_len_in_bytes;
+    }
+    else if( sim->pkt_type == RAL_PKT_TYPE_GFSK )
+    {
+        time_on_air_in_ms = ral_sim_get_gfsk_time_on_air_in_ms( &sim->gfsk_pkt_params, &sim->gfsk_mod_params );
+        size_in_bytes     = sim->gfsk_pkt_params.pld_len_in_bytes;
+    }
+    else
+    {
+        return RAL_STATUS_UNSUPPORTED_FEATURE;
+    }
+
+    ral_sim_enter_mode( sim, RAL_SIM_MODE_TX );
+    ral_sim_bsp_transmit( context, sim->buffer, size_in_bytes, time_on_air_in_ms );
+
+    sim->irq_pending = RAL_IRQ_TX_DONE;
+    ral_sim_bsp_schedule_irq( context, time_on_air_in_ms );
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_rx( const void* context, const uint32_t timeout_in_ms )
+{
+    ral_sim_t* sim                 = ( ral_sim_t* ) context;
+    uint32_t   rx_window_in_ms     = timeout_in_ms;
+    uint32_t   rx_done_delay_in_ms = 0;
+
+    if( ( sim->pkt_type == RAL_PKT_TYPE_LORA ) && ( sim->lora_symb_nb_timeout != 0 ) )
+    {
+        // The symbol timeout ends the reception if no preamble is detected in time
+        const uint32_t symb_window_in_ms =
+            ( ( uint32_t ) sim->lora_symb_nb_timeout * ral_sim_get_lora_symb_time_in_us( &sim->lora_mod_params ) +
+              999 ) /
+            1000;
+
+        if( symb_window_in_ms < rx_window_in_ms )
+        {
+            rx_window_in_ms = symb_window_in_ms;
+        }
+    }
+
+    ral_sim_enter_mode( sim, RAL_SIM_MODE_RX );
+    sim->rx_is_continuous = ( rx_window_in_ms == RAL_RX_TIMEOUT_CONTINUOUS_MODE ) ? true : false;
+
+    if( ral_sim_bsp_receive( context, rx_window_in_ms, &rx_done_delay_in_ms ) == true )
+    {
+        sim->irq_pending = RAL_IRQ_RX_DONE;
+        ral_sim_bsp_schedule_irq( context, rx_done_delay_in_ms );
+    }
+    else if( sim->rx_is_continuous == false )
+    {
+        sim->irq_pending = RAL_IRQ_RX_TIMEOUT;
+        ral_sim_bsp_schedule_irq( context, rx_window_in_ms );
+    }
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_cfg_rx_boosted( const void* context, const bool enable_boost_mode )
+{
+    ( ( ral_sim_t* ) context )->rx_boost_is_on = enable_boost_mode;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_rx_tx_fallback_mode( const void* context, const ral_fallback_modes_t ral_fallback_mode )
+{
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_stop_timer_on_preamble( const void* context, const bool enable )
+{
+    ( ( ral_sim_t* ) context )->stop_timer_on_preamble_is_on = enable;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_rx_duty_cycle( const void* context, const uint32_t rx_time_in_ms,
+                                        const uint32_t sleep_time_in_ms )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_set_lora_cad( const void* context )
+{
+    ral_sim_t*     sim = ( ral_sim_t* ) context;
+    const uint32_t cad_time_in_us = ( ( uint32_t ) 1 << sim->lora_cad_params.cad_symb_nb ) *
+                                    ral_sim_get_lora_symb_time_in_us( &sim->lora_mod_params );
+
+    // The simulated channel is always free: the CAD never detects any activity
+    ral_sim_enter_mode( sim, RAL_SIM_MODE_CAD );
+    sim->irq_pending = RAL_IRQ_CAD_DONE;
+    ral_sim_bsp_schedule_irq( context, ( cad_time_in_us + 999 ) / 1000 );
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_tx_cw( const void* context )
+{
+    ral_sim_enter_mode( ( ral_sim_t* ) context, RAL_SIM_MODE_TX );
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_tx_infinite_preamble( const void* context )
+{
+    ral_sim_enter_mode( ( ral_sim_t* ) context, RAL_SIM_MODE_TX );
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_cal_img( const void* context, const uint16_t freq1_in_mhz, const uint16_t freq2_in_mhz )
+{
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_tx_cfg( const void* context, const int8_t output_pwr_in_dbm, const uint32_t rf_freq_in_hz )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    sim->output_pwr_in_dbm = output_pwr_in_dbm;
+    sim->rf_freq_in_hz     = rf_freq_in_hz;
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_pkt_payload( const void* context, const uint8_t* buffer, const uint16_t size )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    if( size > RAL_SIM_BUFFER_SIZE_IN_BYTES )
+    {
+        return RAL_STATUS_ERROR;
+    }
+    memcpy( sim->buffer, buffer, size );
+    sim->buffer_size_in_bytes = size;
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_pkt_payload( const void* context, uint16_t max_size_in_bytes, uint8_t* buffer,
+                                     uint16_t* size_in_bytes )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    if( size_in_bytes != NULL )
+    {
+        *size_in_bytes = sim->buffer_size_in_bytes;
+    }
+    if( sim->buffer_size_in_bytes > max_size_in_bytes )
+    {
+        return RAL_STATUS_ERROR;
+    }
+    memcpy( buffer, sim->buffer, sim->buffer_size_in_bytes );
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_irq_status( const void* context, ral_irq_t* irq )
+{
+    *irq = ( ( ral_sim_t* ) context )->irq_status;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_clear_irq_status( const void* context, const ral_irq_t irq )
+{
+    ( ( ral_sim_t* ) context )->irq_status &= ~irq;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_and_clear_irq_status( const void* context, ral_irq_t* irq )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    if( irq != NULL )
+    {
+        *irq = sim->irq_status;
+    }
+    sim->irq_status = RAL_IRQ_NONE;
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_dio_irq_params( const void* context, const ral_irq_t irq )
+{
+    ( ( ral_sim_t* ) context )->irq_mask = irq;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_rf_freq( const void* context, const uint32_t freq_in_hz )
+{
+    ( ( ral_sim_t* ) context )->rf_freq_in_hz = freq_in_hz;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_pkt_type( const void* context, const ral_pkt_type_t pkt_type )
+{
+    if( pkt_type == RAL_PKT_TYPE_FLRC )
+    {
+        return RAL_STATUS_UNSUPPORTED_FEATURE;
+    }
+    ( ( ral_sim_t* ) context )->pkt_type = pkt_type;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_pkt_type( const void* context, ral_pkt_type_t* pkt_type )
+{
+    *pkt_type = ( ( ral_sim_t* ) context )->pkt_type;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_gfsk_mod_params( const void* context, const ral_gfsk_mod_params_t* params )
+{
+    if( params->br_in_bps == 0 )
+    {
+        return RAL_STATUS_UNKNOWN_VALUE;
+    }
+    ( ( ral_sim_t* ) context )->gfsk_mod_params = *params;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_gfsk_pkt_params( const void* context, const ral_gfsk_pkt_params_t* params )
+{
+    ( ( ral_sim_t* ) context )->gfsk_pkt_params = *params;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_lora_mod_params( const void* context, const ral_lora_mod_params_t* params )
+{
+    if( ( params->sf < RAL_LORA_SF5 ) || ( params->sf > RAL_LORA_SF12 ) || ( params->bw > RAL_LORA_BW_1600_KHZ ) )
+    {
+        return RAL_STATUS_UNKNOWN_VALUE;
+    }
+    ( ( ral_sim_t* ) context )->lora_mod_params = *params;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_lora_pkt_params( const void* context, const ral_lora_pkt_params_t* params )
+{
+    ( ( ral_sim_t* ) context )->lora_pkt_params = *params;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_lora_cad_params( const void* context, const ral_lora_cad_params_t* params )
+{
+    ( ( ral_sim_t* ) context )->lora_cad_params = *params;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_lora_symb_nb_timeout( const void* context, const uint8_t nb_of_symbs )
+{
+    ( ( ral_sim_t* ) context )->lora_symb_nb_timeout = nb_of_symbs;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_flrc_mod_params( const void* context, const ral_flrc_mod_params_t* params )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_set_flrc_pkt_params( const void* context, const ral_flrc_pkt_params_t* params )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_get_gfsk_rx_pkt_status( const void* context, ral_gfsk_rx_pkt_status_t* rx_pkt_status )
+{
+    *rx_pkt_status = ( ( ral_sim_t* ) context )->gfsk_rx_pkt_status;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_lora_rx_pkt_status( const void* context, ral_lora_rx_pkt_status_t* rx_pkt_status )
+{
+    *rx_pkt_status = ( ( ral_sim_t* ) context )->lora_rx_pkt_status;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_flrc_rx_pkt_status( const void* context, ral_flrc_rx_pkt_status_t* rx_pkt_status )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_get_rssi_inst( const void* context, int16_t* rssi_in_dbm )
+{
+    *rssi_in_dbm = ( ( ral_sim_t* ) context )->rssi_inst_in_dbm;
+    return RAL_STATUS_OK;
+}
+
+uint32_t ral_sim_get_lora_time_on_air_in_ms( const ral_lora_pkt_params_t* pkt_p, const ral_lora_mod_params_t* mod_p )
+{
+    const int32_t sf          = ( int32_t ) mod_p->sf;
+    const bool    ldro_is_on  = ( mod_p->ldro != 0 ) ? true : false;
+    const int32_t header_bits = ( pkt_p->header_type == RAL_LORA_PKT_EXPLICIT ) ? 20 : 0;
+    const int32_t crc_bits    = ( pkt_p->crc_is_on == true ) ? 16 : 0;
+    uint32_t      cr_denom    = 4;
+    int32_t       nb_bits     = 0;
+    int32_t       bits_per_symb;
+    uint32_t      nb_symb_x4;
+    uint64_t      toa_in_ms;
+
+    switch( mod_p->cr )
+    {
+    case RAL_LORA_CR_4_5:
+    case RAL_LORA_CR_LI_4_5:
+        cr_denom += 1;
+        break;
+    case RAL_LORA_CR_4_6:
+    case RAL_LORA_CR_LI_4_6:
+        cr_denom += 2;
+        break;
+    case RAL_LORA_CR_4_7:
+        cr_denom += 3;
+        break;
+    default:
+        cr_denom += 4;
+        break;
+    }
+
+    // Preamble, sync word and start of frame, counted in quarters of symbol
+    nb_symb_x4 = ( ( uint32_t ) pkt_p->preamble_len_in_symb * 4 ) + ( ( sf < 7 ) ? 25 : 17 ) + ( 8 * 4 );
+
+    nb_bits =
+        ( 8 * ( int32_t ) pkt_p->pld_len_in_bytes ) + crc_bits - ( 4 * sf ) + header_bits + ( ( sf < 7 ) ? 0 : 8 );
+    bits_per_symb = 4 * ( ( ldro_is_on == true ) ? ( sf - 2 ) : sf );
+    if( nb_bits > 0 )
+    {
+        nb_symb_x4 += ( ( uint32_t )( ( nb_bits + bits_per_symb - 1 ) / bits_per_symb ) ) * cr_denom * 4;
+    }
+
+    toa_in_ms = ( ( uint64_t ) nb_symb_x4 * ( ( uint64_t ) 1 << sf ) * 1000 );
+    toa_in_ms = ( toa_in_ms + ( 4 * ( uint64_t ) ral_sim_lora_bw_in_hz[mod_p->bw] ) - 1 ) /
+                ( 4 * ( uint64_t ) ral_sim_lora_bw_in_hz[mod_p->bw] );
+
+    return ( uint32_t ) toa_in_ms;
+}
+
+uint32_t ral_sim_get_gfsk_time_on_air_in_ms( const ral_gfsk_pkt_params_t* pkt_p, const ral_gfsk_mod_params_t* mod_p )
+{
+    uint32_t nb_bits = pkt_p->preamble_len_in_bits + pkt_p->sync_word_len_in_bits;
+
+    if( pkt_p->header_type == RAL_GFSK_PKT_VAR_LEN )
+    {
+        nb_bits += 8;
+    }
+    if( pkt_p->address_filtering != RAL_GFSK_ADDRESS_FILTERING_DISABLE )
+    {
+        nb_bits += 8;
+    }
+    switch( pkt_p->crc_type )
+    {
+    case RAL_GFSK_CRC_1_BYTE:
+    case RAL_GFSK_CRC_1_BYTE_INV:
+        nb_bits += 8;
+        break;
+    case RAL_GFSK_CRC_2_BYTES:
+    case RAL_GFSK_CRC_2_BYTES_INV:
+        nb_bits += 16;
+        break;
+    case RAL_GFSK_CRC_3_BYTES:
+        nb_bits += 24;
+        break;
+    default:
+        break;
+    }
+    nb_bits += 8 * ( uint32_t ) pkt_p->pld_len_in_bytes;
+
+    if( mod_p->br_in_bps == 0 )
+    {
+        return 0;
+    }
+    return ( uint32_t )( ( ( uint64_t ) nb_bits * 1000 + mod_p->br_in_bps - 1 ) / mod_p->br_in_bps );
+}
+
+uint32_t ral_sim_get_flrc_time_on_air_in_ms( const ral_flrc_pkt_params_t* pkt_p, const ral_flrc_mod_params_t* mod_p )
+{
+    return 0;
+}
+
+ral_status_t ral_sim_set_gfsk_sync_word( const void* context, const uint8_t* sync_word, const uint8_t sync_word_len )
+{
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_lora_sync_word( const void* context, const uint8_t sync_word )
+{
+    ( ( ral_sim_t* ) context )->lora_sync_word = sync_word;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_flrc_sync_word( const void* context, const uint8_t* sync_word, const uint8_t sync_word_len )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_set_gfsk_crc_params( const void* context, const uint16_t seed, const uint16_t polynomial )
+{
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_set_flrc_crc_params( const void* context, const uint32_t seed )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_set_gfsk_whitening_seed( const void* context, const uint16_t seed )
+{
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_lr_fhss_init( const void* context, const ral_lr_fhss_params_t* lr_fhss_params )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_lr_fhss_build_frame( const void* context, const ral_lr_fhss_params_t* lr_fhss_params,
+                                          ral_lr_fhss_memory_state_t state, uint16_t hop_sequence_id,
+                                          const uint8_t* payload, uint16_t payload_length )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_lr_fhss_handle_hop( const void* context, const ral_lr_fhss_params_t* lr_fhss_params,
+                                         ral_lr_fhss_memory_state_t state )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_lr_fhss_handle_tx_done( const void* context, const ral_lr_fhss_params_t* lr_fhss_params,
+                                             ral_lr_fhss_memory_state_t state )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_lr_fhss_get_time_on_air_in_ms( const void* context, const ral_lr_fhss_params_t* lr_fhss_params,
+                                                    uint16_t payload_length, uint32_t* time_on_air )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_lr_fhss_get_hop_sequence_count( const void*                 context,
+                                                     const ral_lr_fhss_params_t* lr_fhss_params )
+{
+    return RAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+ral_status_t ral_sim_get_lora_rx_pkt_cr_crc( const void* context, ral_lora_cr_t* cr, bool* is_crc_present )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    *cr             = sim->lora_mod_params.cr;
+    *is_crc_present = sim->lora_pkt_params.crc_is_on;
+
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_tx_consumption_in_ua( const void* context, const int8_t output_pwr_in_dbm,
+                                               const uint32_t rf_freq_in_hz, uint32_t* pwr_consumption_in_ua )
+{
+    *pwr_consumption_in_ua = RAL_SIM_TX_BASE_CONSUMPTION_IN_UA;
+    if( output_pwr_in_dbm > 0 )
+    {
+        *pwr_consumption_in_ua += ( uint32_t ) output_pwr_in_dbm * RAL_SIM_TX_CONSUMPTION_PER_DBM_IN_UA;
+    }
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_gfsk_rx_consumption_in_ua( const void* context, const uint32_t br_in_bps,
+                                                    const uint32_t bw_dsb_in_hz, const bool rx_boosted,
+                                                    uint32_t* pwr_consumption_in_ua )
+{
+    *pwr_consumption_in_ua =
+        ( rx_boosted == true ) ? RAL_SIM_RX_BOOSTED_CONSUMPTION_IN_UA : RAL_SIM_RX_CONSUMPTION_IN_UA;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_lora_rx_consumption_in_ua( const void* context, const ral_lora_bw_t bw,
+                                                    const bool rx_boosted, uint32_t* pwr_consumption_in_ua )
+{
+    *pwr_consumption_in_ua =
+        ( rx_boosted == true ) ? RAL_SIM_RX_BOOSTED_CONSUMPTION_IN_UA : RAL_SIM_RX_CONSUMPTION_IN_UA;
+    return RAL_STATUS_OK;
+}
+
+ral_status_t ral_sim_get_random_numbers( const void* context, uint32_t* numbers, unsigned int n )
+{
+    ral_sim_t* sim = ( ral_sim_t* ) context;
+
+    if( sim->random_state == 0 )
+    {
+        sim->random_state = RAL_SIM_DEFAULT_RANDOM_SEED;
+    }
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        // xorshift32
+        sim->random_state ^= sim->random_state << 13;
+        sim->random_state ^= sim->random_state >> 17;
+        sim->random_state ^= sim->random_state << 5;
+        numbers[i] = sim->random_state;
+    }
+    return RAL_STATUS_OK;
+}
+
+uint32_t ral_sim_get_lora_symb_time_in_us( const ral_lora_mod_params_t* mod_params )
+{
+    return ( uint32_t )( ( ( ( uint64_t ) 1 << mod_params->sf ) * 1000000 ) / ral_sim_lora_bw_in_hz[mod_params->bw] );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void ral_sim_enter_mode( ral_sim_t* sim, const ral_sim_mode_t mode )
+{
+    if( sim->irq_pending != RAL_IRQ_NONE )
+    {
+        ral_sim_bsp_cancel_irq( sim );
+        sim->irq_pending = RAL_IRQ_NONE;
+    }
+    sim->rx_is_continuous = false;
+    sim->mode             = mode;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,121 @@
+/**
+ * @file      ral_sim_bsp.h
+ *
+ * @brief     Board Support Package for the simulated radio RAL.
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RAL_SIM_BSP_H__
+#define RAL_SIM_BSP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ral_defs.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * Request the completion of the ongoing radio operation after a given delay
+ *
+ * @remark The board shall call ral_sim_process_irq once the delay has elapsed, then raise the radio irq if it returns
+ * true. Only one operation can be pending: a new request replaces the previous one.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] delay_in_ms Delay before the end of the operation
+ */
+void ral_sim_bsp_schedule_irq( const void* context, const uint32_t delay_in_ms );
+
+/**
+ * Cancel the completion previously requested with ral_sim_bsp_schedule_irq
+ *
+ * @param [in] context Chip implementation context
+ */
+void ral_sim_bsp_cancel_irq( const void* context );
+
+/**
+ * Notify the board that a frame starts to be transmitted
+ *
+ * @remark Radio configuration (frequency, modulation, power) can be read from the context.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] buffer Frame being transmitted
+ * @param [in] size_in_bytes Size of the frame
+ * @param [in] time_on_air_in_ms Duration of the transmission
+ */
+void ral_sim_bsp_transmit( const void* context, const uint8_t* buffer, const uint16_t size_in_bytes,
+                           const uint32_t time_on_air_in_ms );
+
+/**
+ * Ask the board whether a frame can be received in the reception window which starts now
+ *
+ * @remark If a frame is available, the board shall load it with ral_sim_load_rx_frame before returning.
+ *
+ * @param [in] context Chip implementation context
+ * @param [in] rx_window_in_ms Duration of the reception window, RAL_RX_TIMEOUT_CONTINUOUS_MODE if not bounded
+ * @param [out] rx_done_delay_in_ms Delay from now to the end of the received frame
+ *
+ * @returns true if a frame has been loaded, false otherwise
+ */
+bool ral_sim_bsp_receive( const void* context, const uint32_t rx_window_in_ms, uint32_t* rx_done_delay_in_ms );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RAL_SIM_BSP_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -46,6 +46,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "ral.h"
 #include "ralf_defs.h"
 #include "ralf_drv.h"
@@ -67,8 +68,9 @@ extern "C" {
 typedef struct ralf_s
 {
     // ral must be the first element of ralf_t to enable ralf_from_ral()
-    ral_t      ral;
-    ralf_drv_t ralf_drv;
+    ral_t          ral;
+    ralf_drv_t     ralf_drv;
+    ralf_shadow_t* shadow;  //!< Optional, see ralf_invalidate_shadow - NULL to always configure the whole radio
 } ralf_t;
 
 /*
@@ -117,6 +119,24 @@ static inline ral_status_t ralf_setup_flrc( const ralf_t* radio, const ralf_para
     return radio->ralf_drv.setup_flrc( radio, params );
 }
 
+/**
+ * @brief Forget the configuration last applied by the ralf_setup_* functions
+ *
+ * @remark When a shadow is attached to the radio, the ralf_setup_* functions only send the commands whose parameters
+ * differ from the previous setup. The configuration is assumed to be kept while the radio is in sleep mode with
+ * retention, so this function has to be called every time it may be lost or changed outside of RALF: radio reset
+ * or initialization, sleep mode without retention, or direct ral_* configuration calls.
+ *
+ * @param [in] radio Pointer to radio data
+ */
+static inline void ralf_invalidate_shadow( const ralf_t* radio )
+{
+    if( radio->shadow != NULL )
+    {
+        radio->shadow->valid_fields = 0;
+    }
+}
+
 /**
  * @brief Convert ral_t* to ralf_t*
  *
@@ -56,6 +56,11 @@ extern "C" {
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 
+/**
+ * @brief Maximum sync word length kept in the shadow of the radio configuration, in bytes
+ */
+#define RALF_SHADOW_SYNC_WORD_MAX_LEN 8
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -101,6 +106,50 @@ typedef struct ralf_params_lr_fhss_s
     uint16_t             hop_sequence_id;
 } ralf_params_lr_fhss_t;
 
+/**
+ * @brief Shadow of the configuration last applied to the radio by the ralf_setup_* functions
+ *
+ * @remark Only the fields flagged in valid_fields match the radio. It is updated by ralf_shadow.c, the other
+ * modules only reset it through ralf_invalidate_shadow.
+ */
+typedef struct ralf_shadow_s
+{
+    uint16_t       valid_fields;
+    bool           stop_timer_on_preamble_is_on;
+    ral_pkt_type_t pkt_type;
+    uint32_t       rf_freq_in_hz;
+    uint32_t       tx_cfg_rf_freq_in_hz;
+    int8_t         tx_cfg_output_pwr_in_dbm;
+    uint8_t        lora_symb_nb_timeout;
+    union
+    {
+        struct
+        {
+            ral_lora_mod_params_t mod_params;
+            ral_lora_pkt_params_t pkt_params;
+            uint8_t               sync_word;
+        } lora;
+        struct
+        {
+            ral_gfsk_mod_params_t mod_params;
+            ral_gfsk_pkt_params_t pkt_params;
+            uint16_t              crc_seed;
+            uint16_t              crc_polynomial;
+            uint16_t              whitening_seed;
+            uint8_t               sync_word[RALF_SHADOW_SYNC_WORD_MAX_LEN];
+            uint8_t               sync_word_len_in_bytes;
+        } gfsk;
+        struct
+        {
+            ral_flrc_mod_params_t mod_params;
+            ral_flrc_pkt_params_t pkt_params;
+            uint32_t              crc_seed;
+            uint8_t               sync_word[RALF_SHADOW_SYNC_WORD_MAX_LEN];
+            uint8_t               sync_word_len_in_bytes;
+        } flrc;
+    } modem;
+} ralf_shadow_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
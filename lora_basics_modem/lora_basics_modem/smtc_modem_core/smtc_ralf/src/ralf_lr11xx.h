@@ -65,6 +65,11 @@ extern "C" {
         .ral = RAL_LR11XX_INSTANTIATE( ctx ), .ralf_drv = RALF_DRV_LR11XX_INSTANTIATE, \
     }
 
+#define RALF_LR11XX_INSTANTIATE_WITH_SHADOW( ctx, shadow_ptr )                                               \
+    {                                                                                                        \
+        .ral = RAL_LR11XX_INSTANTIATE( ctx ), .ralf_drv = RALF_DRV_LR11XX_INSTANTIATE, .shadow = shadow_ptr, \
+    }
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -0,0 +1,528 @@
+/**
+ * @file      ralf_shadow.c
+ *
+ * @brief     Radio abstraction layer feature - shadow of the applied radio configuration
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+
+#include "ralf_shadow.h"
+#include "ral.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Flags of ralf_shadow_t valid_fields
+ */
+#define RALF_SHADOW_STOP_TIMER_ON_PREAMBLE ( 1 << 0 )
+#define RALF_SHADOW_PKT_TYPE ( 1 << 1 )
+#define RALF_SHADOW_RF_FREQ ( 1 << 2 )
+#define RALF_SHADOW_TX_CFG ( 1 << 3 )
+#define RALF_SHADOW_LORA_SYMB_NB_TIMEOUT ( 1 << 4 )
+#define RALF_SHADOW_MOD_PARAMS ( 1 << 5 )
+#define RALF_SHADOW_PKT_PARAMS ( 1 << 6 )
+#define RALF_SHADOW_CRC_PARAMS ( 1 << 7 )
+#define RALF_SHADOW_SYNC_WORD ( 1 << 8 )
+#define RALF_SHADOW_WHITENING_SEED ( 1 << 9 )
+
+/**
+ * @brief Fields which have to be sent again after a packet type change
+ */
+#define RALF_SHADOW_PKT_TYPE_DEPENDENT_FIELDS                                                                          \
+    ( RALF_SHADOW_RF_FREQ | RALF_SHADOW_TX_CFG | RALF_SHADOW_MOD_PARAMS | RALF_SHADOW_PKT_PARAMS |                     \
+      RALF_SHADOW_CRC_PARAMS | RALF_SHADOW_SYNC_WORD | RALF_SHADOW_WHITENING_SEED )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Check if a field of the shadow matches the radio
+ *
+ * @param [in] shadow Pointer to the shadow, can be NULL
+ * @param [in] field  RALF_SHADOW_* flag
+ *
+ * @returns True if the field is valid
+ */
+static bool ralf_shadow_is_valid( const ralf_shadow_t* shadow, const uint16_t field );
+
+/**
+ * @brief Check if a modem specific field of the shadow matches the radio configured with a given packet type
+ *
+ * @param [in] shadow   Pointer to the shadow, can be NULL
+ * @param [in] pkt_type Packet type the field belongs to
+ * @param [in] field    RALF_SHADOW_* flag
+ *
+ * @returns True if the field is valid
+ */
+static bool ralf_shadow_modem_is_valid( const ralf_shadow_t* shadow, const ral_pkt_type_t pkt_type,
+                                        const uint16_t field );
+
+/**
+ * @brief Flag a field according to the status of the ral_* call which has just configured it
+ *
+ * @param [in] shadow Pointer to the shadow, can be NULL
+ * @param [in] field  RALF_SHADOW_* flag
+ * @param [in] status Status of the ral_* call
+ */
+static void ralf_shadow_update( ralf_shadow_t* shadow, const uint16_t field, const ral_status_t status );
+
+/**
+ * @brief Flag a modem specific field according to the status of the ral_* call which has just configured it
+ *
+ * @remark The field is only flagged as valid if the current packet type is known and matches
+ *
+ * @param [in] shadow   Pointer to the shadow, can be NULL
+ * @param [in] pkt_type Packet type the field belongs to
+ * @param [in] field    RALF_SHADOW_* flag
+ * @param [in] status   Status of the ral_* call
+ */
+static void ralf_shadow_modem_update( ralf_shadow_t* shadow, const ral_pkt_type_t pkt_type, const uint16_t field,
+                                      const ral_status_t status );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+ral_status_t ralf_shadow_stop_timer_on_preamble( const ralf_t* radio, const bool enable )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_is_valid( shadow, RALF_SHADOW_STOP_TIMER_ON_PREAMBLE ) &&
+        ( shadow->stop_timer_on_preamble_is_on == enable ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_stop_timer_on_preamble( &radio->ral, enable );
+    if( shadow != NULL )
+    {
+        shadow->stop_timer_on_preamble_is_on = enable;
+    }
+    ralf_shadow_update( shadow, RALF_SHADOW_STOP_TIMER_ON_PREAMBLE, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_pkt_type( const ralf_t* radio, const ral_pkt_type_t pkt_type )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_is_valid( shadow, RALF_SHADOW_PKT_TYPE ) && ( shadow->pkt_type == pkt_type ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_pkt_type( &radio->ral, pkt_type );
+    if( shadow != NULL )
+    {
+        shadow->valid_fields &= ~RALF_SHADOW_PKT_TYPE_DEPENDENT_FIELDS;
+        shadow->pkt_type = pkt_type;
+    }
+    ralf_shadow_update( shadow, RALF_SHADOW_PKT_TYPE, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_rf_freq( const ralf_t* radio, const uint32_t freq_in_hz )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_is_valid( shadow, RALF_SHADOW_RF_FREQ ) && ( shadow->rf_freq_in_hz == freq_in_hz ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_rf_freq( &radio->ral, freq_in_hz );
+    if( shadow != NULL )
+    {
+        shadow->rf_freq_in_hz = freq_in_hz;
+    }
+    ralf_shadow_update( shadow, RALF_SHADOW_RF_FREQ, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_tx_cfg( const ralf_t* radio, const int8_t output_pwr_in_dbm,
+                                     const uint32_t rf_freq_in_hz )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_is_valid( shadow, RALF_SHADOW_TX_CFG ) &&
+        ( shadow->tx_cfg_output_pwr_in_dbm == output_pwr_in_dbm ) && ( shadow->tx_cfg_rf_freq_in_hz == rf_freq_in_hz ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_tx_cfg( &radio->ral, output_pwr_in_dbm, rf_freq_in_hz );
+    if( shadow != NULL )
+    {
+        shadow->tx_cfg_output_pwr_in_dbm = output_pwr_in_dbm;
+        shadow->tx_cfg_rf_freq_in_hz     = rf_freq_in_hz;
+    }
+    ralf_shadow_update( shadow, RALF_SHADOW_TX_CFG, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_lora_symb_nb_timeout( const ralf_t* radio, const uint8_t nb_of_symbs )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_is_valid( shadow, RALF_SHADOW_LORA_SYMB_NB_TIMEOUT ) &&
+        ( shadow->lora_symb_nb_timeout == nb_of_symbs ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_lora_symb_nb_timeout( &radio->ral, nb_of_symbs );
+    if( shadow != NULL )
+    {
+        shadow->lora_symb_nb_timeout = nb_of_symbs;
+    }
+    ralf_shadow_update( shadow, RALF_SHADOW_LORA_SYMB_NB_TIMEOUT, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_lora_mod_params( const ralf_t* radio, const ral_lora_mod_params_t* params )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_LORA, RALF_SHADOW_MOD_PARAMS ) &&
+        ( shadow->modem.lora.mod_params.sf == params->sf ) && ( shadow->modem.lora.mod_params.bw == params->bw ) &&
+        ( shadow->modem.lora.mod_params.cr == params->cr ) && ( shadow->modem.lora.mod_params.ldro == params->ldro ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_lora_mod_params( &radio->ral, params );
+    if( shadow != NULL )
+    {
+        shadow->modem.lora.mod_params = *params;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_LORA, RALF_SHADOW_MOD_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_lora_pkt_params( const ralf_t* radio, const ral_lora_pkt_params_t* params )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_LORA, RALF_SHADOW_PKT_PARAMS ) &&
+        ( shadow->modem.lora.pkt_params.preamble_len_in_symb == params->preamble_len_in_symb ) &&
+        ( shadow->modem.lora.pkt_params.header_type == params->header_type ) &&
+        ( shadow->modem.lora.pkt_params.pld_len_in_bytes == params->pld_len_in_bytes ) &&
+        ( shadow->modem.lora.pkt_params.crc_is_on == params->crc_is_on ) &&
+        ( shadow->modem.lora.pkt_params.invert_iq_is_on == params->invert_iq_is_on ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_lora_pkt_params( &radio->ral, params );
+    if( shadow != NULL )
+    {
+        shadow->modem.lora.pkt_params = *params;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_LORA, RALF_SHADOW_PKT_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_lora_sync_word( const ralf_t* radio, const uint8_t sync_word )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_LORA, RALF_SHADOW_SYNC_WORD ) &&
+        ( shadow->modem.lora.sync_word == sync_word ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_lora_sync_word( &radio->ral, sync_word );
+    if( shadow != NULL )
+    {
+        shadow->modem.lora.sync_word = sync_word;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_LORA, RALF_SHADOW_SYNC_WORD, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_gfsk_mod_params( const ralf_t* radio, const ral_gfsk_mod_params_t* params )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_MOD_PARAMS ) &&
+        ( shadow->modem.gfsk.mod_params.br_in_bps == params->br_in_bps ) &&
+        ( shadow->modem.gfsk.mod_params.fdev_in_hz == params->fdev_in_hz ) &&
+        ( shadow->modem.gfsk.mod_params.bw_dsb_in_hz == params->bw_dsb_in_hz ) &&
+        ( shadow->modem.gfsk.mod_params.pulse_shape == params->pulse_shape ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_gfsk_mod_params( &radio->ral, params );
+    if( shadow != NULL )
+    {
+        shadow->modem.gfsk.mod_params = *params;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_MOD_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_gfsk_pkt_params( const ralf_t* radio, const ral_gfsk_pkt_params_t* params )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_PKT_PARAMS ) &&
+        ( shadow->modem.gfsk.pkt_params.preamble_len_in_bits == params->preamble_len_in_bits ) &&
+        ( shadow->modem.gfsk.pkt_params.preamble_detector == params->preamble_detector ) &&
+        ( shadow->modem.gfsk.pkt_params.sync_word_len_in_bits == params->sync_word_len_in_bits ) &&
+        ( shadow->modem.gfsk.pkt_params.address_filtering == params->address_filtering ) &&
+        ( shadow->modem.gfsk.pkt_params.header_type == params->header_type ) &&
+        ( shadow->modem.gfsk.pkt_params.pld_len_in_bytes == params->pld_len_in_bytes ) &&
+        ( shadow->modem.gfsk.pkt_params.crc_type == params->crc_type ) &&
+        ( shadow->modem.gfsk.pkt_params.dc_free == params->dc_free ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_gfsk_pkt_params( &radio->ral, params );
+    if( shadow != NULL )
+    {
+        shadow->modem.gfsk.pkt_params = *params;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_PKT_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_gfsk_crc_params( const ralf_t* radio, const uint16_t seed, const uint16_t polynomial )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_CRC_PARAMS ) &&
+        ( shadow->modem.gfsk.crc_seed == seed ) && ( shadow->modem.gfsk.crc_polynomial == polynomial ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_gfsk_crc_params( &radio->ral, seed, polynomial );
+    if( shadow != NULL )
+    {
+        shadow->modem.gfsk.crc_seed       = seed;
+        shadow->modem.gfsk.crc_polynomial = polynomial;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_CRC_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_gfsk_sync_word( const ralf_t* radio, const uint8_t* sync_word,
+                                             const uint8_t sync_word_len )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_SYNC_WORD ) &&
+        ( shadow->modem.gfsk.sync_word_len_in_bytes == sync_word_len ) &&
+        ( memcmp( shadow->modem.gfsk.sync_word, sync_word, sync_word_len ) == 0 ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_gfsk_sync_word( &radio->ral, sync_word, sync_word_len );
+    if( ( shadow != NULL ) && ( sync_word_len <= RALF_SHADOW_SYNC_WORD_MAX_LEN ) )
+    {
+        memcpy( shadow->modem.gfsk.sync_word, sync_word, sync_word_len );
+        shadow->modem.gfsk.sync_word_len_in_bytes = sync_word_len;
+        ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_SYNC_WORD, status );
+    }
+    else
+    {
+        // Too long to be kept, always sent
+        ralf_shadow_update( shadow, RALF_SHADOW_SYNC_WORD, RAL_STATUS_ERROR );
+    }
+    return status;
+}
+
+ral_status_t ralf_shadow_set_gfsk_whitening_seed( const ralf_t* radio, const uint16_t seed )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_WHITENING_SEED ) &&
+        ( shadow->modem.gfsk.whitening_seed == seed ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_gfsk_whitening_seed( &radio->ral, seed );
+    if( shadow != NULL )
+    {
+        shadow->modem.gfsk.whitening_seed = seed;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_GFSK, RALF_SHADOW_WHITENING_SEED, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_flrc_mod_params( const ralf_t* radio, const ral_flrc_mod_params_t* params )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_MOD_PARAMS ) &&
+        ( shadow->modem.flrc.mod_params.br_in_bps == params->br_in_bps ) &&
+        ( shadow->modem.flrc.mod_params.bw_dsb_in_hz == params->bw_dsb_in_hz ) &&
+        ( shadow->modem.flrc.mod_params.cr == params->cr ) &&
+        ( shadow->modem.flrc.mod_params.pulse_shape == params->pulse_shape ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_flrc_mod_params( &radio->ral, params );
+    if( shadow != NULL )
+    {
+        shadow->modem.flrc.mod_params = *params;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_MOD_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_flrc_pkt_params( const ralf_t* radio, const ral_flrc_pkt_params_t* params )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_PKT_PARAMS ) &&
+        ( shadow->modem.flrc.pkt_params.preamble_len_in_bits == params->preamble_len_in_bits ) &&
+        ( shadow->modem.flrc.pkt_params.sync_word_is_on == params->sync_word_is_on ) &&
+        ( shadow->modem.flrc.pkt_params.pld_is_fix == params->pld_is_fix ) &&
+        ( shadow->modem.flrc.pkt_params.pld_len_in_bytes == params->pld_len_in_bytes ) &&
+        ( shadow->modem.flrc.pkt_params.crc_type == params->crc_type ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_flrc_pkt_params( &radio->ral, params );
+    if( shadow != NULL )
+    {
+        shadow->modem.flrc.pkt_params = *params;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_PKT_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_flrc_crc_params( const ralf_t* radio, const uint32_t seed )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_CRC_PARAMS ) &&
+        ( shadow->modem.flrc.crc_seed == seed ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_flrc_crc_params( &radio->ral, seed );
+    if( shadow != NULL )
+    {
+        shadow->modem.flrc.crc_seed = seed;
+    }
+    ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_CRC_PARAMS, status );
+    return status;
+}
+
+ral_status_t ralf_shadow_set_flrc_sync_word( const ralf_t* radio, const uint8_t* sync_word,
+                                             const uint8_t sync_word_len )
+{
+    ralf_shadow_t* shadow = radio->shadow;
+
+    if( ralf_shadow_modem_is_valid( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_SYNC_WORD ) &&
+        ( shadow->modem.flrc.sync_word_len_in_bytes == sync_word_len ) &&
+        ( memcmp( shadow->modem.flrc.sync_word, sync_word, sync_word_len ) == 0 ) )
+    {
+        return RAL_STATUS_OK;
+    }
+    const ral_status_t status = ral_set_flrc_sync_word( &radio->ral, sync_word, sync_word_len );
+    if( ( shadow != NULL ) && ( sync_word_len <= RALF_SHADOW_SYNC_WORD_MAX_LEN ) )
+    {
+        memcpy( shadow->modem.flrc.sync_word, sync_word, sync_word_len );
+        shadow->modem.flrc.sync_word_len_in_bytes = sync_word_len;
+        ralf_shadow_modem_update( shadow, RAL_PKT_TYPE_FLRC, RALF_SHADOW_SYNC_WORD, status );
+    }
+    else
+    {
+        // Too long to be kept, always sent
+        ralf_shadow_update( shadow, RALF_SHADOW_SYNC_WORD, RAL_STATUS_ERROR );
+    }
+    return status;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool ralf_shadow_is_valid( const ralf_shadow_t* shadow, const uint16_t field )
+{
+    return ( shadow != NULL ) && ( ( shadow->valid_fields & field ) != 0 );
+}
+
+static bool ralf_shadow_modem_is_valid( const ralf_shadow_t* shadow, const ral_pkt_type_t pkt_type,
+                                        const uint16_t field )
+{
+    return ralf_shadow_is_valid( shadow, RALF_SHADOW_PKT_TYPE ) && ( shadow->pkt_type == pkt_type ) &&
+           ralf_shadow_is_valid( shadow, field );
+}
+
+static void ralf_shadow_update( ralf_shadow_t* shadow, const uint16_t field, const ral_status_t status )
+{
+    if( shadow == NULL )
+    {
+        return;
+    }
+    if( status == RAL_STATUS_OK )
+    {
+        shadow->valid_fields |= field;
+    }
+    else
+    {
+        shadow->valid_fields &= ~field;
+    }
+}
+
+static void ralf_shadow_modem_update( ralf_shadow_t* shadow, const ral_pkt_type_t pkt_type, const uint16_t field,
+                                      const ral_status_t status )
+{
+    const bool pkt_type_is_valid =
+        ralf_shadow_is_valid( shadow, RALF_SHADOW_PKT_TYPE ) && ( shadow->pkt_type == pkt_type );
+
+    ralf_shadow_update( shadow, field, ( pkt_type_is_valid == true ) ? status : RAL_STATUS_ERROR );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
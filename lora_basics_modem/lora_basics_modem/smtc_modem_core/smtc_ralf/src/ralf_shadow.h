@@ -0,0 +1,175 @@
+/**
+ * @file      ralf_shadow.h
+ *
+ * @brief     Radio abstraction layer feature - shadow of the applied radio configuration
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RALF_SHADOW_H__
+#define RALF_SHADOW_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ralf.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * The functions below are used by the ralf_<radio>_setup_* implementations in place of the ral_* functions of the
+ * same name. When radio->shadow is not NULL, the ral_* function is only called if its parameters differ from the ones
+ * recorded in the shadow, which is updated on success. Changing the packet type forgets the RF frequency, the TX
+ * configuration and the modem specific parameters, so they are sent again.
+ *
+ * If the ral_* function fails, the matching shadow field is forgotten.
+ */
+
+/**
+ * @see ral_stop_timer_on_preamble
+ */
+ral_status_t ralf_shadow_stop_timer_on_preamble( const ralf_t* radio, const bool enable );
+
+/**
+ * @see ral_set_pkt_type
+ */
+ral_status_t ralf_shadow_set_pkt_type( const ralf_t* radio, const ral_pkt_type_t pkt_type );
+
+/**
+ * @see ral_set_rf_freq
+ */
+ral_status_t ralf_shadow_set_rf_freq( const ralf_t* radio, const uint32_t freq_in_hz );
+
+/**
+ * @see ral_set_tx_cfg
+ */
+ral_status_t ralf_shadow_set_tx_cfg( const ralf_t* radio, const int8_t output_pwr_in_dbm,
+                                     const uint32_t rf_freq_in_hz );
+
+/**
+ * @see ral_set_lora_symb_nb_timeout
+ */
+ral_status_t ralf_shadow_set_lora_symb_nb_timeout( const ralf_t* radio, const uint8_t nb_of_symbs );
+
+/**
+ * @see ral_set_lora_mod_params
+ */
+ral_status_t ralf_shadow_set_lora_mod_params( const ralf_t* radio, const ral_lora_mod_params_t* params );
+
+/**
+ * @see ral_set_lora_pkt_params
+ */
+ral_status_t ralf_shadow_set_lora_pkt_params( const ralf_t* radio, const ral_lora_pkt_params_t* params );
+
+/**
+ * @see ral_set_lora_sync_word
+ */
+ral_status_t ralf_shadow_set_lora_sync_word( const ralf_t* radio, const uint8_t sync_word );
+
+/**
+ * @see ral_set_gfsk_mod_params
+ */
+ral_status_t ralf_shadow_set_gfsk_mod_params( const ralf_t* radio, const ral_gfsk_mod_params_t* params );
+
+/**
+ * @see ral_set_gfsk_pkt_params
+ */
+ral_status_t ralf_shadow_set_gfsk_pkt_params( const ralf_t* radio, const ral_gfsk_pkt_params_t* params );
+
+/**
+ * @see ral_set_gfsk_crc_params
+ */
+ral_status_t ralf_shadow_set_gfsk_crc_params( const ralf_t* radio, const uint16_t seed, const uint16_t polynomial );
+
+/**
+ * @see ral_set_gfsk_sync_word
+ */
+ral_status_t ralf_shadow_set_gfsk_sync_word( const ralf_t* radio, const uint8_t* sync_word,
+                                             const uint8_t sync_word_len );
+
+/**
+ * @see ral_set_gfsk_whitening_seed
+ */
+ral_status_t ralf_shadow_set_gfsk_whitening_seed( const ralf_t* radio, const uint16_t seed );
+
+/**
+ * @see ral_set_flrc_mod_params
+ */
+ral_status_t ralf_shadow_set_flrc_mod_params( const ralf_t* radio, const ral_flrc_mod_params_t* params );
+
+/**
+ * @see ral_set_flrc_pkt_params
+ */
+ral_status_t ralf_shadow_set_flrc_pkt_params( const ralf_t* radio, const ral_flrc_pkt_params_t* params );
+
+/**
+ * @see ral_set_flrc_crc_params
+ */
+ral_status_t ralf_shadow_set_flrc_crc_params( const ralf_t* radio, const uint32_t seed );
+
+/**
+ * @see ral_set_flrc_sync_word
+ */
+ral_status_t ralf_shadow_set_flrc_sync_word( const ralf_t* radio, const uint8_t* sync_word,
+                                             const uint8_t sync_word_len );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RALF_SHADOW_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -66,6 +66,11 @@ extern "C" {
         .ral = RAL_SX126X_INSTANTIATE( ctx ), .ralf_drv = RALF_DRV_SX126X_INSTANTIATE, \
     }
 
+#define RALF_SX126X_INSTANTIATE_WITH_SHADOW( ctx, shadow_ptr )                                               \
+    {                                                                                                        \
+        .ral = RAL_SX126X_INSTANTIATE( ctx ), .ralf_drv = RALF_DRV_SX126X_INSTANTIATE, .shadow = shadow_ptr, \
+    }
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -38,6 +38,7 @@
  */
 
 #include "ralf_sx128x.h"
+#include "ralf_shadow.h"
 #include "ral.h"
 
 /*
@@ -72,48 +73,48 @@
 
 ral_status_t ralf_sx128x_setup_gfsk( const ralf_t* radio, const ralf_params_gfsk_t* params )
 {
-    ral_status_t status = ral_set_pkt_type( &radio->ral, RAL_PKT_TYPE_GFSK );
+    ral_status_t status = ralf_shadow_set_pkt_type( radio, RAL_PKT_TYPE_GFSK );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_rf_freq( &radio->ral, params->rf_freq_in_hz );
+    status = ralf_shadow_set_rf_freq( radio, params->rf_freq_in_hz );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_tx_cfg( &radio->ral, params->output_pwr_in_dbm, params->rf_freq_in_hz );
+    status = ralf_shadow_set_tx_cfg( radio, params->output_pwr_in_dbm, params->rf_freq_in_hz );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_gfsk_mod_params( &radio->ral, &params->mod_params );
+    status = ralf_shadow_set_gfsk_mod_params( radio, &params->mod_params );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_gfsk_pkt_params( &radio->ral, &params->pkt_params );
+    status = ralf_shadow_set_gfsk_pkt_params( radio, &params->pkt_params );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
     if( params->pkt_params.crc_type != RAL_GFSK_CRC_OFF )
     {
-        status = ral_set_gfsk_crc_params( &radio->ral, params->crc_seed, params->crc_polynomial );
+        status = ralf_shadow_set_gfsk_crc_params( radio, params->crc_seed, params->crc_polynomial );
         if( status != RAL_STATUS_OK )
         {
             return status;
         }
     }
-    status =
-        ral_set_gfsk_sync_word( &radio->ral, params->sync_word, ( params->pkt_params.sync_word_len_in_bits + 7 ) / 8 );
+    status = ralf_shadow_set_gfsk_sync_word( radio, params->sync_word,
+                                             ( params->pkt_params.sync_word_len_in_bits + 7 ) / 8 );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
     if( params->dc_free_is_on == true )
     {
-        status = ral_set_gfsk_whitening_seed( &radio->ral, params->whitening_seed );
+        status = ralf_shadow_set_gfsk_whitening_seed( radio, params->whitening_seed );
         if( status != RAL_STATUS_OK )
         {
             return status;
@@ -124,32 +125,32 @@ ral_status_t ralf_sx128x_setup_gfsk( const ralf_t* radio, const ralf_params_gfsk
 
 ral_status_t ralf_sx128x_setup_lora( const ralf_t* radio, const ralf_params_lora_t* params )
 {
-    ral_status_t status = ral_set_pkt_type( &radio->ral, RAL_PKT_TYPE_LORA );
+    ral_status_t status = ralf_shadow_set_pkt_type( radio, RAL_PKT_TYPE_LORA );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_rf_freq( &radio->ral, params->rf_freq_in_hz );
+    status = ralf_shadow_set_rf_freq( radio, params->rf_freq_in_hz );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_tx_cfg( &radio->ral, params->output_pwr_in_dbm, params->rf_freq_in_hz );
+    status = ralf_shadow_set_tx_cfg( radio, params->output_pwr_in_dbm, params->rf_freq_in_hz );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_lora_mod_params( &radio->ral, &params->mod_params );
+    status = ralf_shadow_set_lora_mod_params( radio, &params->mod_params );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_lora_pkt_params( &radio->ral, &params->pkt_params );
+    status = ralf_shadow_set_lora_pkt_params( radio, &params->pkt_params );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_lora_sync_word( &radio->ral, params->sync_word );
+    status = ralf_shadow_set_lora_sync_word( radio, params->sync_word );
     if( status != RAL_STATUS_OK )
     {
         return status;
@@ -159,41 +160,41 @@ ral_status_t ralf_sx128x_setup_lora( const ralf_t* radio, const ralf_params_lora
 
 ral_status_t ralf_sx128x_setup_flrc( const ralf_t* radio, const ralf_params_flrc_t* params )
 {
-    ral_status_t status = ral_set_pkt_type( &radio->ral, RAL_PKT_TYPE_FLRC );
+    ral_status_t status = ralf_shadow_set_pkt_type( radio, RAL_PKT_TYPE_FLRC );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_rf_freq( &radio->ral, params->rf_freq_in_hz );
+    status = ralf_shadow_set_rf_freq( radio, params->rf_freq_in_hz );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
-    status = ral_set_tx_cfg( &radio->ral, params->output_pwr_in_dbm, params->rf_freq_in_hz );
+    status = ralf_shadow_set_tx_cfg( radio, params->output_pwr_in_dbm, params->rf_freq_in_hz );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
 
-    status = ral_set_flrc_mod_params( &radio->ral, &params->mod_params );
+    status = ralf_shadow_set_flrc_mod_params( radio, &params->mod_params );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
 
-    status = ral_set_flrc_pkt_params( &radio->ral, &params->pkt_params );
+    status = ralf_shadow_set_flrc_pkt_params( radio, &params->pkt_params );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
 
-    status = ral_set_flrc_crc_params( &radio->ral, params->crc_seed );
+    status = ralf_shadow_set_flrc_crc_params( radio, params->crc_seed );
     if( status != RAL_STATUS_OK )
     {
         return status;
     }
 
-    status = ral_set_flrc_sync_word( &radio->ral, params->sync_word, 4 );
+    status = ralf_shadow_set_flrc_sync_word( radio, params->sync_word, 4 );
 
     return status;
 }
@@ -249,7 +249,8 @@ void smtc_modem_hal_context_restore( const modem_context_type_t ctx_type, uint8_
 /**
  * @brief Stores the data context
  *
- * @remark This function is used to store Modem data in a non volatile memory
+ * @remark This function is used to store Modem data in a non volatile memory. The data must be stored when the
+ * function returns, the modem does not read it back
  *
  * @param [in] ctx_type   Type of modem context that need to be saved
  * @param [in] buffer     Buffer pointer to write from
@@ -405,6 +406,72 @@ uint8_t smtc_modem_hal_get_voltage( void );
  */
 int8_t smtc_modem_hal_get_board_delay_ms( void );
 
+/* ------------ CRC management ------------*/
+
+/**
+ * @brief Feed a buffer to a running crc32 computed by the mcu crc unit
+ *
+ * @remark Only required when the modem is built with MODEM_HAL_CRC32. The crc is the reflected 0xEDB88320 one, the
+ * register is given and returned without initialization nor final inversion (see modem_crc32_update)
+ *
+ * @param [in] crc Current register value
+ * @param [in] buf Input buffer
+ * @param [in] len Input buffer length
+ *
+ * @return uint32_t Updated register value
+ */
+uint32_t smtc_modem_hal_crc32_update( uint32_t crc, const uint8_t* buf, uint32_t len );
+
+/* ------------ Crypto accelerator management ------------*/
+
+/**
+ * @brief Encrypt blocks in AES-128 ECB mode with the mcu crypto accelerator
+ *
+ * @remark Only required when the modem is built with CRYPTO=HW_ACCEL
+ *
+ * @param [in] key AES-128 key
+ * @param [in] buffer Input buffer
+ * @param [in] size Input buffer size, a multiple of 16
+ * @param [out] enc_buffer Output buffer, same as buffer or disjoint from it
+ *
+ * @return bool True if the operation succeeded
+ */
+bool smtc_modem_hal_aes_ecb_encrypt( const uint8_t key[16], const uint8_t* buffer, uint16_t size,
+                                     uint8_t* enc_buffer );
+
+/**
+ * @brief Encrypt or decrypt a buffer in AES-128 CTR mode with the mcu crypto accelerator
+ *
+ * @remark Only required when the modem is built with CRYPTO=HW_ACCEL. The counter block is incremented as a big
+ * endian number for each block, the modem never lets its two last bytes wrap
+ *
+ * @param [in] key AES-128 key
+ * @param [in] a_block Initial counter block
+ * @param [in] buffer Input buffer
+ * @param [in] size Input buffer size, any value
+ * @param [out] enc_buffer Output buffer, same as buffer or disjoint from it
+ *
+ * @return bool True if the operation succeeded
+ */
+bool smtc_modem_hal_aes_ctr_encrypt( const uint8_t key[16], const uint8_t a_block[16], const uint8_t* buffer,
+                                     uint16_t size, uint8_t* enc_buffer );
+
+/**
+ * @brief Compute the AES-128 CMAC of a message with the mcu crypto accelerator
+ *
+ * @remark Only required when the modem is built with CRYPTO=HW_ACCEL
+ *
+ * @param [in] key AES-128 key
+ * @param [in] mic_bx_buffer 16 bytes block put in front of the message, NULL if none
+ * @param [in] buffer Message
+ * @param [in] size Message size, any value
+ * @param [out] cmac Computed cmac
+ *
+ * @return bool True if the operation succeeded
+ */
+bool smtc_modem_hal_aes_cmac( const uint8_t key[16], const uint8_t* mic_bx_buffer, const uint8_t* buffer,
+                              uint16_t size, uint8_t cmac[16] );
+
 /* ------------ Trace management ------------*/
 
 /**
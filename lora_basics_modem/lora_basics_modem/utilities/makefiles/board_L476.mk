@@ -47,6 +47,7 @@ BOARD_C_SOURCES = \
 	user_app/mcu_drivers/STM32L4xx_HAL_Driver/Src/stm32l4xx_hal_adc.c \
 	user_app/mcu_drivers/STM32L4xx_HAL_Driver/Src/stm32l4xx_hal_adc_ex.c\
 	user_app/smtc_modem_hal/smtc_modem_hal.c\
+	user_app/smtc_modem_hal/nvm_journal.c\
 	user_app/mcu_drivers/core/system_stm32l4xx.c\
 	user_app/smtc_hal_l4/smtc_hal_adc.c\
 	user_app/smtc_hal_l4/smtc_hal_flash.c\
@@ -60,6 +61,14 @@ BOARD_C_SOURCES = \
 	user_app/smtc_hal_l4/smtc_hal_uart.c\
 	user_app/smtc_hal_l4/smtc_hal_watchdog.c
 
+# The STM32L476 has no AES peripheral, the modem hal cannot offer the crypto accelerator on this board. Checked when
+# the board is built only: this file is also read by the top-level make of the host targets
+.PHONY: board_check
+board_check:
+ifeq ($(CRYPTO),HW_ACCEL)
+	$(error CRYPTO=HW_ACCEL is not supported by the STM32L476 board (no AES peripheral), use CRYPTO=SOFT or CRYPTO=SOFT_FAST)
+endif
+
 BOARD_ASM_SOURCES =  \
 	user_app/mcu_drivers/core/startup_stm32l476xx.s
 
@@ -73,5 +82,6 @@ BOARD_C_INCLUDES =  \
 	-Iuser_app/littlefs\
 	-Iuser_app/mcu_drivers/core\
 	-Iuser_app/smtc_modem_hal\
-	-Iuser_app/smtc_hal_l4
+	-Iuser_app/smtc_hal_l4\
+	-I$(LORA_BASICS_MODEM)/smtc_modem_core/modem_services
 
@@ -0,0 +1,39 @@
+##############################################################################
+# Definitions for the host board (native build, virtual time base)
+##############################################################################
+
+
+#-----------------------------------------------------------------------------
+# Compilation flags
+#-----------------------------------------------------------------------------
+
+#MCU compilation flags
+MCU_FLAGS =
+
+BOARD_C_DEFS =
+
+#-----------------------------------------------------------------------------
+# Hardware-specific sources
+#-----------------------------------------------------------------------------
+BOARD_C_SOURCES = \
+	user_app/smtc_hal_host/smtc_hal_flash.c\
+	user_app/smtc_hal_host/smtc_hal_gpio.c\
+	user_app/smtc_hal_host/smtc_hal_lp_timer.c\
+	user_app/smtc_hal_host/smtc_hal_mcu.c\
+	user_app/smtc_hal_host/smtc_hal_rng.c\
+	user_app/smtc_hal_host/smtc_hal_rtc.c\
+	user_app/smtc_hal_host/smtc_hal_trace.c\
+	user_app/smtc_modem_hal/smtc_modem_hal_host.c
+
+# AES accelerator of the modem hal: OpenSSL, which uses AES-NI when the cpu has it
+ifeq ($(CRYPTO),HW_ACCEL)
+BOARD_C_SOURCES += \
+	user_app/smtc_hal_host/smtc_hal_aes.c
+
+LIBS += -lcrypto
+endif
+
+BOARD_ASM_SOURCES =
+
+BOARD_C_INCLUDES =  \
+	-Iuser_app/smtc_hal_host
@@ -5,7 +5,11 @@
 #-----------------------------------------------------------------------------
 # Build system binaries
 #-----------------------------------------------------------------------------
+ifeq ($(HOST),yes)
+PREFIX =
+else
 PREFIX = arm-none-eabi-
+endif
 # The gcc compiler bin path can be either defined in make command via GCC_PATH variable (> make GCC_PATH=xxx)
 # either it can be added to the PATH environment variable.
 ifdef GCC_PATH
@@ -31,7 +35,11 @@ GCOVR = gcovr
 # Board selection
 #-----------------------------------------------------------------------------
 
+ifeq ($(HOST),yes)
+include makefiles/board_host.mk
+else
 include makefiles/board_L476.mk
+endif
 
 #-----------------------------------------------------------------------------
 # Define target build directory
@@ -104,6 +112,38 @@ BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_crc_spi
 endif
 endif # lr1120
 
+ifeq ($(CRYPTO),SOFT_FAST)
+TARGET_MODEM := $(TARGET_MODEM)_soft_fast
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_soft_fast
+endif # SOFT_FAST
+
+ifeq ($(CRYPTO),HW_ACCEL)
+TARGET_MODEM := $(TARGET_MODEM)_hw_accel
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_hw_accel
+endif # HW_ACCEL
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_SIM)
+TARGET_MODEM := $(TARGET_MODEM)_multi
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_multi
+endif
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_REPLAY)
+TARGET_MODEM := $(TARGET_MODEM)_replay
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_replay
+endif
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_CRYPTO_TEST)
+TARGET_MODEM := $(TARGET_MODEM)_crypto_test
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_crypto_test
+endif
+
+ifneq ($(HOST),yes)
+ifeq ($(RADIO_HAL_TRACE),yes)
+TARGET_MODEM := $(TARGET_MODEM)_radio_hal_trace
+BUILD_DIR_MODEM := $(BUILD_DIR_MODEM)_radio_hal_trace
+endif
+endif
+
 ifeq ($(DEBUG),yes)
 TARGET_MODEM := $(TARGET_MODEM)_debug
 endif
@@ -162,11 +202,14 @@ WFLAG += \
 	-Wno-unused-parameter \
 	-Wpedantic \
 	-fomit-frame-pointer \
-	-mabi=aapcs \
 	-fno-unroll-loops \
 	-ffast-math \
 	-ftree-vectorize
 
+ifneq ($(HOST),yes)
+WFLAG += -mabi=aapcs
+endif
+
 # Allow linker to not link unused functions
 WFLAG += \
 	-ffunction-sections \
@@ -216,6 +259,16 @@ COMMON_C_DEFS += \
 	-DPERF_TEST_ENABLED
 endif
 
+ifeq ($(CRYPTO),HW_ACCEL)
+COMMON_C_DEFS += \
+	-DSOFT_SE_HW_ACCEL
+endif
+
+ifeq ($(RADIO_HAL_TRACE),yes)
+COMMON_C_DEFS += \
+	-DRADIO_HAL_TRACE
+endif
+
 CFLAGS += -fno-builtin $(MCU_FLAGS) $(BOARD_C_DEFS) $(COMMON_C_DEFS) $(MODEM_C_DEFS) $(BOARD_C_INCLUDES) $(COMMON_C_INCLUDES) $(MODEM_C_INCLUDES) $(OPT) $(WFLAG) -MMD -MP -MF"$(@:%.o=%.d)"
 CFLAGS += -falign-functions=4
 CFLAGS += -std=c17
@@ -224,6 +277,13 @@ CFLAGS += -std=c17
 # Link flags
 #-----------------------------------------------------------------------------
 # libraries
+ifeq ($(HOST),yes)
+LIBS += -lm
+
+LDFLAGS += $(LIBS) $(COVERAGE_LDFLAGS)
+LDFLAGS += -Wl,--cref # Cross-reference table
+LDFLAGS += -Wl,--gc-sections # Garbage collect unused sections
+else
 LIBS += -lstdc++ -lsupc++ -lm -lc -lnosys
 
 LIBDIR =
@@ -235,6 +295,7 @@ LDFLAGS += -T$(BOARD_LDSCRIPT) $(LIBDIR) $(LIBS) $(COVERAGE_LDFLAGS)
 LDFLAGS += -Wl,--cref # Cross-reference table
 LDFLAGS += -Wl,--print-memory-usage # Display ram/flash memory usage
 LDFLAGS += -Wl,--gc-sections # Garbage collect unused sections
+endif
 
 
 #-----------------------------------------------------------------------------
@@ -254,6 +315,29 @@ USER_APP_C_SOURCES += \
 	user_app/main_examples/main_exti.c
 endif
 
+ifeq ($(MODEM_APP),EXAMPLE_HOST)
+USER_APP_C_SOURCES += \
+	user_app/main_examples/main_host.c
+endif
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_SIM)
+USER_APP_C_SOURCES += \
+	user_app/main_examples/main_host_sim.c
+endif
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_REPLAY)
+USER_APP_C_SOURCES += \
+	user_app/main_examples/main_host_replay.c
+endif
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_CRYPTO_TEST)
+USER_APP_C_SOURCES += \
+	user_app/main_examples/main_host_crypto_test.c
+
+COMMON_C_INCLUDES += \
+	-I$(LORA_BASICS_MODEM)/smtc_modem_core/smtc_modem_crypto/soft_secure_element
+endif
+
 ifeq ($(MODEM_APP),EXAMPLE_TX_BEACON)
 USER_APP_C_SOURCES += \
 	user_app/main_examples/main_tx_beacon.c
@@ -283,6 +367,19 @@ COMMON_C_INCLUDES +=  \
 	-I$(LORA_BASICS_MODEM)/smtc_modem_api\
 	-I$(LORA_BASICS_MODEM)/smtc_modem_hal
 
+#-----------------------------------------------------------------------------
+# Radio hal trace: recorded on target, replayed on the host
+#-----------------------------------------------------------------------------
+ifeq ($(RADIO_HAL_TRACE),yes)
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/radio_hal_trace.c
+endif
+
+ifeq ($(MODEM_APP),EXAMPLE_HOST_REPLAY)
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/radio_hal_replay.c
+endif
+
 #-----------------------------------------------------------------------------
 # Region sources and defines
 #-----------------------------------------------------------------------------
@@ -309,8 +406,30 @@ else
 endif 
 
 
-example_build: $(BUILD_DIR_MODEM)/$(TARGET_MODEM).elf $(BUILD_DIR_MODEM)/$(TARGET_MODEM).hex $(BUILD_DIR_MODEM)/$(TARGET_MODEM).bin
+ifeq ($(HOST),yes)
+example_build: $(BUILD_DIR_MODEM)/$(TARGET_MODEM).elf
+	$(call success,$@)
+
+# Runs the host program once built, make fails with it
+example_run: example
+	$(SILENT)$(BUILD_DIR_MODEM)/$(TARGET_MODEM).elf
+
+# Replays a reference trace in a scratch directory and compares the counters printed with the expected ones
+REPLAY_TRACE_DIR = user_app/radio_hal/replay_traces
+REPLAY_CHECK_DIR = $(BUILD_DIR_MODEM)/replay_check
+
+example_replay_check: example
+	$(SILENT)rm -rf $(REPLAY_CHECK_DIR)
+	$(SILENT)mkdir -p $(REPLAY_CHECK_DIR)
+	$(SILENT)cp $(REPLAY_TRACE_DIR)/$(REPLAY_TRACE).bin $(REPLAY_CHECK_DIR)/radio_hal_trace.bin
+	$(SILENT)cd $(REPLAY_CHECK_DIR) && $(abspath $(BUILD_DIR_MODEM)/$(TARGET_MODEM).elf) > replay.log
+	$(SILENT)grep -a -o "Uplink [0-9]*: .*\|Host replay done.*\|Replay: .*" $(REPLAY_CHECK_DIR)/replay.log > $(REPLAY_CHECK_DIR)/counters.txt
+	$(SILENT)diff $(REPLAY_TRACE_DIR)/$(REPLAY_TRACE).txt $(REPLAY_CHECK_DIR)/counters.txt
 	$(call success,$@)
+else
+example_build: board_check $(BUILD_DIR_MODEM)/$(TARGET_MODEM).elf $(BUILD_DIR_MODEM)/$(TARGET_MODEM).hex $(BUILD_DIR_MODEM)/$(TARGET_MODEM).bin
+	$(call success,$@)
+endif
 
 
 #-----------------------------------------------------------------------------
@@ -18,9 +18,17 @@ endif
 
 
 RADIO_HAL_C_SOURCES += \
-	user_app/radio_hal/lr11xx_hal.c\
 	user_app/radio_hal/ral_lr11xx_bsp.c
 
+# On the host, the radio answers from a trace recorded on target (see make host_replay)
+ifeq ($(HOST),yes)
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/lr11xx_hal_replay.c
+else
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/lr11xx_hal.c
+endif
+
 #-----------------------------------------------------------------------------
 # Includes
 #-----------------------------------------------------------------------------
@@ -0,0 +1,31 @@
+##############################################################################
+# Definitions for the simulated tranceiver
+##############################################################################
+TARGET = sim
+
+#-----------------------------------------------------------------------------
+# Common sources
+#-----------------------------------------------------------------------------
+
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/ral_sim_bsp.c\
+	user_app/radio_hal/ral_sim_medium.c
+
+#-----------------------------------------------------------------------------
+# Includes
+#-----------------------------------------------------------------------------
+MODEM_C_INCLUDES =  \
+	-I$(LORA_BASICS_MODEM)/smtc_modem_core/smtc_ralf/src \
+	-I$(LORA_BASICS_MODEM)/smtc_modem_core/smtc_ral/src \
+	-I$(LORA_BASICS_MODEM)/smtc_modem_core/smtc_modem_crypto/soft_secure_element
+
+#-----------------------------------------------------------------------------
+# Region
+#-----------------------------------------------------------------------------
+
+#-----------------------------------------------------------------------------
+# Radio specific compilation flags
+#-----------------------------------------------------------------------------
+MODEM_C_DEFS += \
+	-DRADIO_SIM\
+	-DAES_DEC_PREKEYED
@@ -16,9 +16,17 @@ endif
 #-----------------------------------------------------------------------------
 
 RADIO_HAL_C_SOURCES += \
-	user_app/radio_hal/sx126x_hal.c \
 	user_app/radio_hal/ral_sx126x_bsp.c
 
+# On the host, the radio answers from a trace recorded on target (see make host_replay)
+ifeq ($(HOST),yes)
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/sx126x_hal_replay.c
+else
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/sx126x_hal.c
+endif
+
 #-----------------------------------------------------------------------------
 # Includes
 #-----------------------------------------------------------------------------
@@ -4,9 +4,17 @@
 TARGET = sx128x
 
 RADIO_HAL_C_SOURCES += \
-	user_app/radio_hal/sx128x_hal.c\
 	user_app/radio_hal/ral_sx128x_bsp.c
 
+# On the host, the radio answers from a trace recorded on target (see make host_replay)
+ifeq ($(HOST),yes)
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/sx128x_hal_replay.c
+else
+RADIO_HAL_C_SOURCES += \
+	user_app/radio_hal/sx128x_hal.c
+endif
+
 #-----------------------------------------------------------------------------
 # Includes
 #-----------------------------------------------------------------------------
@@ -85,6 +85,18 @@ int main( void )
 #if MAKEFILE_APP == EXAMPLE_EXTI
     // This example show how to send data on an external event.
     main_exti( );
+#elif MAKEFILE_APP == EXAMPLE_HOST
+    // This example runs the modem on the host, with a simulated radio and a virtual time base.
+    main_host( );
+#elif MAKEFILE_APP == EXAMPLE_HOST_SIM
+    // This example simulates several devices and a gateway on the host, with a virtual time base.
+    main_host_sim( );
+#elif MAKEFILE_APP == EXAMPLE_HOST_REPLAY
+    // This example replays on the host a radio hal trace recorded on target, with a virtual time base.
+    main_host_replay( );
+#elif MAKEFILE_APP == EXAMPLE_HOST_CRYPTO_TEST
+    // This test checks on the host the soft secure element AES and CMAC against their known answers.
+    main_host_crypto_test( );
 #else
 #error "Unknown application" ## MAKEFILE_APP
 #endif
@@ -66,6 +66,10 @@ extern "C" {
  * @brief Application examples
  */
 #define EXAMPLE_EXTI 0
+#define EXAMPLE_HOST 1
+#define EXAMPLE_HOST_SIM 2
+#define EXAMPLE_HOST_REPLAY 3
+#define EXAMPLE_HOST_CRYPTO_TEST 4
 
 /*
  * -----------------------------------------------------------------------------
@@ -73,6 +77,10 @@ extern "C" {
  */
 
 void main_exti( void );
+void main_host( void );
+void main_host_sim( void );
+void main_host_replay( void );
+void main_host_crypto_test( void );
 
 #ifdef __cplusplus
 }
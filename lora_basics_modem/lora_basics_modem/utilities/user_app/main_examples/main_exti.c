@@ -60,6 +60,10 @@
 #include "ralf_lr11xx.h"
 #endif
 
+#if defined( RADIO_HAL_TRACE )
+#include "radio_hal_trace.h"
+#endif
+
 #include <string.h>
 
 /*
@@ -79,12 +83,14 @@ static const uint8_t user_dev_eui[8]  = USER_LORAWAN_DEVICE_EUI;
 static const uint8_t user_join_eui[8] = USER_LORAWAN_JOIN_EUI;
 static const uint8_t user_app_key[16] = USER_LORAWAN_APP_KEY;
 
+static ralf_shadow_t modem_radio_shadow;
+
 #if defined( SX128X )
-const ralf_t modem_radio = RALF_SX128X_INSTANTIATE( NULL );
+const ralf_t modem_radio = RALF_SX128X_INSTANTIATE_WITH_SHADOW( NULL, &modem_radio_shadow );
 #elif defined( SX126X )
-const ralf_t modem_radio = RALF_SX126X_INSTANTIATE( NULL );
+const ralf_t modem_radio = RALF_SX126X_INSTANTIATE_WITH_SHADOW( NULL, &modem_radio_shadow );
 #elif defined( LR11XX )
-const ralf_t modem_radio = RALF_LR11XX_INSTANTIATE( NULL );
+const ralf_t modem_radio = RALF_LR11XX_INSTANTIATE_WITH_SHADOW( NULL, &modem_radio_shadow );
 #else
 #error "Please select radio board.."
 #endif
@@ -159,6 +165,12 @@ void main_exti( void )
                 // Send MCU temperature on port 102
                 uint8_t temperature = ( uint8_t ) smtc_modem_hal_get_temperature( );
                 SMTC_HAL_TRACE_INFO( "MCU temperature : %d \n", temperature );
+#if defined( RADIO_HAL_TRACE )
+                // Let the host replay request the same uplink at the same time (see main_host_replay)
+                const uint8_t uplink_marker[] = { 102, false };
+                radio_hal_trace_record( RADIO_HAL_TRACE_MARKER, uplink_marker, sizeof( uplink_marker ), &temperature,
+                                        1 );
+#endif
                 smtc_modem_request_uplink( STACK_ID, 102, false, &temperature, 1 );
             }
         }
@@ -223,6 +235,18 @@ static void get_event( void )
         case SMTC_MODEM_EVENT_TXDONE:
             SMTC_HAL_TRACE_INFO( "Event received: TXDONE\n" );
             SMTC_HAL_TRACE_INFO( "Transmission done \n" );
+#if defined( RADIO_HAL_TRACE )
+        {
+            radio_hal_trace_stats_t stats;
+
+            radio_hal_trace_get_stats( &stats );
+            radio_hal_trace_reset_stats( );
+            SMTC_HAL_TRACE_INFO( "Radio hal: %u spi transactions, %u bytes out, %u bytes in, %u irqs, %u dropped\n",
+                                 stats.nb_transactions, stats.nb_bytes_out, stats.nb_bytes_in, stats.nb_irqs,
+                                 stats.nb_dropped_records );
+            radio_hal_trace_flush( );
+        }
+#endif
             break;
 
         case SMTC_MODEM_EVENT_DOWNDATA:
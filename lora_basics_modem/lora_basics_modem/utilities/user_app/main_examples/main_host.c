@@ -0,0 +1,230 @@
+/*!
+ * \file      main_host.c
+ *
+ * \brief     main program for host example, running the modem on a virtual time base
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "main.h"
+
+#include "smtc_modem_api.h"
+#include "smtc_modem_utilities.h"
+
+#include "smtc_modem_hal.h"
+#include "smtc_hal_dbg_trace.h"
+
+#include "example_options.h"
+
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_rtc.h"
+
+#include "ralf_sim.h"
+
+#include <string.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * Stack id value (multistacks modem is not yet available)
+ */
+#define STACK_ID 0
+
+/**
+ * @brief Virtual duration of the simulation, the program returns once elapsed
+ */
+#ifndef HOST_SIMULATION_DURATION_S
+#define HOST_SIMULATION_DURATION_S ( 24 * 3600 )
+#endif
+
+/**
+ * @brief Period between two uplinks once joined
+ */
+#ifndef HOST_UPLINK_PERIOD_S
+#define HOST_UPLINK_PERIOD_S 300
+#endif
+
+/**
+ * @brief Stack credentials
+ */
+static const uint8_t user_dev_eui[8]  = USER_LORAWAN_DEVICE_EUI;
+static const uint8_t user_join_eui[8] = USER_LORAWAN_JOIN_EUI;
+static const uint8_t user_app_key[16] = USER_LORAWAN_APP_KEY;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+static ral_sim_t     sim_radio          = { 0 };
+static ralf_shadow_t modem_radio_shadow = { 0 };
+static const ralf_t  modem_radio        = RALF_SIM_INSTANTIATE_WITH_SHADOW( &sim_radio, &modem_radio_shadow );
+
+static uint32_t nb_tx_done   = 0;  // Number of TXDONE events
+static uint32_t nb_join_fail = 0;  // Number of JOINFAIL events
+static uint32_t nb_downdata  = 0;  // Number of DOWNDATA events
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+static void get_event( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Example running the modem on the host: periodic uplinks with a simulated radio
+ *
+ * The time base is virtual: sleeping jumps directly to the next timer expiry, so a day of modem activity runs in a
+ * few seconds.
+ */
+void main_host( void )
+{
+    // Disable IRQ to avoid unwanted behaviour during init
+    hal_mcu_disable_irq( );
+
+    // Configure the virtual board (time base, timers, nvm file, random generator)
+    hal_mcu_init( );
+
+    // Init the modem and use get_event as event callback, please note that the callback will be
+    // called immediatly after the first call to smtc_modem_run_engine because of the reset detection
+    smtc_modem_init( &modem_radio, &get_event );
+
+    // Re-enable IRQ
+    hal_mcu_enable_irq( );
+
+    SMTC_HAL_TRACE_INFO( "Host example is starting \n" );
+
+    while( hal_rtc_get_time_s( ) < HOST_SIMULATION_DURATION_S )
+    {
+        // Execute modem runtime, this function must be recalled in sleep_time_ms (max value, can be recalled sooner)
+        uint32_t sleep_time_ms = smtc_modem_run_engine( );
+
+        // nothing to process, go to sleep: the virtual time jumps to the next event
+        hal_mcu_set_sleep_for_ms( sleep_time_ms );
+    }
+
+    SMTC_HAL_TRACE_INFO( "Host example done after %u s: %u tx, %u join fail, %u downlink\n", hal_rtc_get_time_s( ),
+                         nb_tx_done, nb_join_fail, nb_downdata );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief User callback for modem event
+ *
+ *  This callback is called every time an event ( see smtc_modem_event_t ) appears in the modem.
+ *  Several events may have to be read from the modem when this callback is called.
+ */
+static void get_event( void )
+{
+    smtc_modem_event_t current_event;
+    uint8_t            event_pending_count;
+    uint8_t            stack_id = STACK_ID;
+
+    // Continue to read modem event until all event has been processed
+    do
+    {
+        // Read modem event
+        smtc_modem_get_event( &current_event, &event_pending_count );
+
+        switch( current_event.event_type )
+        {
+        case SMTC_MODEM_EVENT_RESET:
+            SMTC_HAL_TRACE_INFO( "Event received: RESET\n" );
+
+            // Set user credentials
+            smtc_modem_set_deveui( stack_id, user_dev_eui );
+            smtc_modem_set_joineui( stack_id, user_join_eui );
+            smtc_modem_set_nwkkey( stack_id, user_app_key );
+            // Set user region
+            smtc_modem_set_region( stack_id, MODEM_EXAMPLE_REGION );
+            // Schedule a Join LoRaWAN network
+            smtc_modem_join_network( stack_id );
+            break;
+
+        case SMTC_MODEM_EVENT_ALARM:
+        {
+            // Send MCU temperature on port 102 and schedule the next uplink
+            uint8_t temperature = ( uint8_t ) smtc_modem_hal_get_temperature( );
+            smtc_modem_request_uplink( stack_id, 102, false, &temperature, 1 );
+            smtc_modem_alarm_start_timer( HOST_UPLINK_PERIOD_S );
+            break;
+        }
+
+        case SMTC_MODEM_EVENT_JOINED:
+            SMTC_HAL_TRACE_INFO( "Event received: JOINED\n" );
+            smtc_modem_alarm_start_timer( HOST_UPLINK_PERIOD_S );
+            break;
+
+        case SMTC_MODEM_EVENT_TXDONE:
+            nb_tx_done++;
+            break;
+
+        case SMTC_MODEM_EVENT_DOWNDATA:
+            nb_downdata++;
+            SMTC_HAL_TRACE_PRINTF( "Data received on port %u\n", current_event.event_data.downdata.fport );
+            break;
+
+        case SMTC_MODEM_EVENT_JOINFAIL:
+            nb_join_fail++;
+            SMTC_HAL_TRACE_WARNING( "Join request failed \n" );
+            break;
+
+        case SMTC_MODEM_EVENT_NONE:
+            break;
+
+        default:
+            SMTC_HAL_TRACE_INFO( "Event received: %u\n", current_event.event_type );
+            break;
+        }
+    } while( event_pending_count > 0 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
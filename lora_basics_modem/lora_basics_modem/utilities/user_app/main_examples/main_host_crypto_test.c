@@ -0,0 +1,246 @@
+/*!
+ * \file      main_host_crypto_test.c
+ *
+ * \brief     main program for the host crypto test, known-answer tests of the soft secure element AES and CMAC
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stdlib.h>
+#include <string.h>
+
+#include "main.h"
+
+#include "smtc_hal_dbg_trace.h"
+
+#include "aes.h"
+#include "cmac.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Chunk size used to feed the CMAC in several updates, not a multiple of the block size
+ */
+#define CMAC_UPDATE_CHUNK_SIZE 7
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief AES-128 known answer: one block encrypted with one key
+ */
+typedef struct aes_kat_s
+{
+    const char* name;
+    uint8_t     key[16];
+    uint8_t     plain[N_BLOCK];
+    uint8_t     cipher[N_BLOCK];
+} aes_kat_t;
+
+/**
+ * @brief AES-CMAC known answer: the first len bytes of cmac_kat_msg signed with cmac_kat_key
+ */
+typedef struct cmac_kat_s
+{
+    const char* name;
+    uint32_t    len;
+    uint8_t     mac[AES_CMAC_DIGEST_LENGTH];
+} cmac_kat_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief FIPS-197 appendix B and appendix C.1
+ */
+static const aes_kat_t aes_kats[] = {
+    {
+        .name   = "FIPS-197 B",
+        .key    = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c },
+        .plain  = { 0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d, 0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34 },
+        .cipher = { 0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb, 0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32 },
+    },
+    {
+        .name   = "FIPS-197 C.1",
+        .key    = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+        .plain  = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+        .cipher = { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a },
+    },
+};
+
+/**
+ * @brief RFC 4493 section 4 key and message
+ */
+static const uint8_t cmac_kat_key[AES_CMAC_KEY_LENGTH] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+
+static const uint8_t cmac_kat_msg[64] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+};
+
+/**
+ * @brief RFC 4493 section 4 examples 1 to 4
+ */
+static const cmac_kat_t cmac_kats[] = {
+    {
+        .name = "RFC 4493 example 1",
+        .len  = 0,
+        .mac  = { 0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46 },
+    },
+    {
+        .name = "RFC 4493 example 2",
+        .len  = 16,
+        .mac  = { 0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c },
+    },
+    {
+        .name = "RFC 4493 example 3",
+        .len  = 40,
+        .mac  = { 0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27 },
+    },
+    {
+        .name = "RFC 4493 example 4",
+        .len  = 64,
+        .mac  = { 0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe },
+    },
+};
+
+static uint32_t nb_pass = 0;
+static uint32_t nb_fail = 0;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+static void check( const char* name, const uint8_t* result, const uint8_t* expected, uint16_t size );
+static void cmac_compute( const uint8_t* msg, uint32_t len, uint32_t chunk_size,
+                          uint8_t mac[AES_CMAC_DIGEST_LENGTH] );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Known-answer tests of the AES and CMAC linked in the modem, aes.c or aes_fast.c following CRYPTO
+ *
+ * The program exits with a failure status when one answer does not match, which fails make host_crypto_test.
+ */
+void main_host_crypto_test( void )
+{
+    for( uint8_t i = 0; i < sizeof( aes_kats ) / sizeof( aes_kats[0] ); i++ )
+    {
+        aes_context ctx;
+        uint8_t     cipher[N_BLOCK];
+
+        memset( &ctx, 0, sizeof( ctx ) );
+        aes_set_key( aes_kats[i].key, sizeof( aes_kats[i].key ), &ctx );
+        aes_encrypt( aes_kats[i].plain, cipher, &ctx );
+        check( aes_kats[i].name, cipher, aes_kats[i].cipher, N_BLOCK );
+    }
+
+    for( uint8_t i = 0; i < sizeof( cmac_kats ) / sizeof( cmac_kats[0] ); i++ )
+    {
+        uint8_t mac[AES_CMAC_DIGEST_LENGTH];
+
+        // In one update, then in short chunks straddling the blocks
+        cmac_compute( cmac_kat_msg, cmac_kats[i].len, cmac_kats[i].len, mac );
+        check( cmac_kats[i].name, mac, cmac_kats[i].mac, AES_CMAC_DIGEST_LENGTH );
+        cmac_compute( cmac_kat_msg, cmac_kats[i].len, CMAC_UPDATE_CHUNK_SIZE, mac );
+        check( cmac_kats[i].name, mac, cmac_kats[i].mac, AES_CMAC_DIGEST_LENGTH );
+    }
+
+    SMTC_HAL_TRACE_INFO( "Host crypto test done: %u passed, %u failed\n", nb_pass, nb_fail );
+
+    if( nb_fail != 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief Compares a result with its known answer and counts it
+ */
+static void check( const char* name, const uint8_t* result, const uint8_t* expected, uint16_t size )
+{
+    if( memcmp( result, expected, size ) == 0 )
+    {
+        nb_pass++;
+    }
+    else
+    {
+        nb_fail++;
+        SMTC_HAL_TRACE_ERROR( "%s: wrong answer\n", name );
+        SMTC_HAL_TRACE_ARRAY( "got", result, size );
+        SMTC_HAL_TRACE_ARRAY( "expected", expected, size );
+    }
+}
+
+/**
+ * @brief Computes the CMAC of a message, fed to AES_CMAC_Update chunk_size bytes at a time
+ */
+static void cmac_compute( const uint8_t* msg, uint32_t len, uint32_t chunk_size, uint8_t mac[AES_CMAC_DIGEST_LENGTH] )
+{
+    AES_CMAC_CTX ctx;
+    uint32_t     offset = 0;
+
+    AES_CMAC_Init( &ctx );
+    AES_CMAC_SetKey( &ctx, cmac_kat_key );
+    while( offset < len )
+    {
+        const uint32_t size = ( ( len - offset ) < chunk_size ) ? ( len - offset ) : chunk_size;
+
+        AES_CMAC_Update( &ctx, msg + offset, size );
+        offset += size;
+    }
+    AES_CMAC_Final( mac, &ctx );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,321 @@
+/*!
+ * \file      main_host_replay.c
+ *
+ * \brief     main program for host replay example, running the modem with a radio replaying a recorded trace
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stdlib.h>
+#include <setjmp.h>
+
+#include "main.h"
+
+#include "smtc_modem_api.h"
+#include "smtc_modem_utilities.h"
+
+#include "smtc_modem_hal.h"
+#include "smtc_hal_dbg_trace.h"
+
+#include "example_options.h"
+
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_rtc.h"
+#include "smtc_hal_lp_timer.h"
+
+#include "radio_hal_replay.h"
+#include "radio_hal_trace.h"
+
+#if defined( SX128X )
+#include "ralf_sx128x.h"
+#elif defined( SX126X )
+#include "ralf_sx126x.h"
+#elif defined( LR11XX )
+#include "ralf_lr11xx.h"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * Stack id value (multistacks modem is not yet available)
+ */
+#define STACK_ID 0
+
+/**
+ * @brief Size of the uplink markers recorded by the target application: port, then confirmed flag
+ */
+#define UPLINK_MARKER_SIZE 2
+
+/**
+ * @brief Stack credentials, the ones of the recording device
+ */
+static const uint8_t user_dev_eui[8]  = USER_LORAWAN_DEVICE_EUI;
+static const uint8_t user_join_eui[8] = USER_LORAWAN_JOIN_EUI;
+static const uint8_t user_app_key[16] = USER_LORAWAN_APP_KEY;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+static ralf_shadow_t modem_radio_shadow;
+
+#if defined( SX128X )
+static const ralf_t modem_radio = RALF_SX128X_INSTANTIATE_WITH_SHADOW( NULL, &modem_radio_shadow );
+#elif defined( SX126X )
+static const ralf_t modem_radio = RALF_SX126X_INSTANTIATE_WITH_SHADOW( NULL, &modem_radio_shadow );
+#elif defined( LR11XX )
+static const ralf_t modem_radio = RALF_LR11XX_INSTANTIATE_WITH_SHADOW( NULL, &modem_radio_shadow );
+#else
+#error "Please select radio board.."
+#endif
+
+static uint32_t                nb_tx_done = 0;  // Number of TXDONE events
+static uint32_t                nb_reset   = 0;  // Number of resets requested by the modem
+static radio_hal_trace_stats_t total_stats;     // Radio hal traffic of the whole replay
+static jmp_buf                 modem_reset_point;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+static void get_event( void );
+static void request_recorded_uplinks( void );
+static void on_modem_reset( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Example running the modem on the host with the radio driver of the target, the radio answering from a trace
+ *
+ * The trace is recorded on target with RADIO_HAL_TRACE=yes. The uplinks are requested when the recording application
+ * requested them, and the radio hal traffic is printed after each uplink: it measures the radio driver without
+ * hardware.
+ * The program exits with a failure status when the trace can not be loaded or when a transaction of the stack is not
+ * found in it, which fails make host_replay_check.
+ */
+void main_host_replay( void )
+{
+    // Disable IRQ to avoid unwanted behaviour during init
+    hal_mcu_disable_irq( );
+
+    // Configure the virtual board (time base, timers, nvm file, random generator)
+    hal_mcu_init( );
+
+    if( radio_hal_replay_open( RADIO_HAL_REPLAY_FILE_NAME ) == false )
+    {
+        exit( EXIT_FAILURE );
+    }
+
+    // A reset requested by the modem starts it again in place: the replay goes on from the current record, as the
+    // recorded trace goes on after a reset of the target. The radio is reset by the modem init, which also cancels
+    // the replayed irq.
+    hal_mcu_set_reset_handler( on_modem_reset );
+    if( setjmp( modem_reset_point ) != 0 )
+    {
+        hal_mcu_disable_irq( );
+        hal_lp_timer_stop( HAL_LP_TIMER_ID_MODEM );
+        nb_reset++;
+    }
+
+    // Init the modem and use get_event as event callback, please note that the callback will be
+    // called immediatly after the first call to smtc_modem_run_engine because of the reset detection
+    smtc_modem_init( &modem_radio, &get_event );
+
+    // Re-enable IRQ
+    hal_mcu_enable_irq( );
+
+    SMTC_HAL_TRACE_INFO( "Host replay example is starting \n" );
+
+    while( radio_hal_replay_is_over( ) == false )
+    {
+        request_recorded_uplinks( );
+
+        // Execute modem runtime, this function must be recalled in sleep_time_ms (max value, can be recalled sooner)
+        uint32_t sleep_time_ms = smtc_modem_run_engine( );
+
+        // The replay may have to raise a radio irq, skip records or request an uplink sooner
+        const uint32_t replay_time_ms = radio_hal_replay_process( );
+        if( replay_time_ms < sleep_time_ms )
+        {
+            sleep_time_ms = replay_time_ms;
+        }
+
+        // nothing to process, go to sleep: the virtual time jumps to the next event
+        hal_mcu_set_sleep_for_ms( sleep_time_ms );
+    }
+
+    // The events of the last replayed exchange are raised by the next run of the modem
+    smtc_modem_run_engine( );
+
+    radio_hal_trace_stats_t  stats;
+    radio_hal_replay_stats_t replay_stats;
+
+    radio_hal_trace_get_stats( &stats );
+    radio_hal_replay_get_stats( &replay_stats );
+
+    SMTC_HAL_TRACE_INFO(
+        "Host replay done after %u s: %u tx, %u reset, %u spi transactions, %u bytes out, %u bytes in\n",
+        hal_rtc_get_time_s( ), nb_tx_done, nb_reset, total_stats.nb_transactions + stats.nb_transactions,
+        total_stats.nb_bytes_out + stats.nb_bytes_out, total_stats.nb_bytes_in + stats.nb_bytes_in );
+    SMTC_HAL_TRACE_INFO( "Replay: %u matched, %u diverged, %u unmatched, %u skipped\n", replay_stats.nb_matched,
+                         replay_stats.nb_diverged, replay_stats.nb_unmatched, replay_stats.nb_skipped );
+
+    hal_mcu_set_reset_handler( NULL );
+    radio_hal_replay_close( );
+
+    if( replay_stats.nb_unmatched != 0 )
+    {
+        SMTC_HAL_TRACE_ERROR( "%u transactions of the stack are not in the trace\n", replay_stats.nb_unmatched );
+        exit( EXIT_FAILURE );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief User callback for modem event
+ *
+ *  This callback is called every time an event ( see smtc_modem_event_t ) appears in the modem.
+ *  Several events may have to be read from the modem when this callback is called.
+ */
+static void get_event( void )
+{
+    smtc_modem_event_t current_event;
+    uint8_t            event_pending_count;
+    uint8_t            stack_id = STACK_ID;
+
+    // Continue to read modem event until all event has been processed
+    do
+    {
+        // Read modem event
+        smtc_modem_get_event( &current_event, &event_pending_count );
+
+        switch( current_event.event_type )
+        {
+        case SMTC_MODEM_EVENT_RESET:
+            SMTC_HAL_TRACE_INFO( "Event received: RESET\n" );
+
+            // Set user credentials
+            smtc_modem_set_deveui( stack_id, user_dev_eui );
+            smtc_modem_set_joineui( stack_id, user_join_eui );
+            smtc_modem_set_nwkkey( stack_id, user_app_key );
+            // Set user region
+            smtc_modem_set_region( stack_id, MODEM_EXAMPLE_REGION );
+            // Schedule a Join LoRaWAN network
+            smtc_modem_join_network( stack_id );
+            break;
+
+        case SMTC_MODEM_EVENT_JOINED:
+            SMTC_HAL_TRACE_INFO( "Event received: JOINED\n" );
+            break;
+
+        case SMTC_MODEM_EVENT_TXDONE:
+        {
+            radio_hal_trace_stats_t stats;
+
+            // Radio hal traffic since the previous uplink, the records themselves are not kept on the host
+            radio_hal_trace_get_stats( &stats );
+            radio_hal_trace_reset_stats( );
+            radio_hal_trace_clear( );
+
+            nb_tx_done++;
+            total_stats.nb_transactions += stats.nb_transactions;
+            total_stats.nb_bytes_out += stats.nb_bytes_out;
+            total_stats.nb_bytes_in += stats.nb_bytes_in;
+            SMTC_HAL_TRACE_INFO( "Uplink %u: %u spi transactions, %u bytes out, %u bytes in, %u irqs\n", nb_tx_done,
+                                 stats.nb_transactions, stats.nb_bytes_out, stats.nb_bytes_in, stats.nb_irqs );
+            break;
+        }
+
+        case SMTC_MODEM_EVENT_DOWNDATA:
+            SMTC_HAL_TRACE_PRINTF( "Data received on port %u\n", current_event.event_data.downdata.fport );
+            break;
+
+        case SMTC_MODEM_EVENT_JOINFAIL:
+            SMTC_HAL_TRACE_WARNING( "Join request failed \n" );
+            break;
+
+        case SMTC_MODEM_EVENT_NONE:
+            break;
+
+        default:
+            SMTC_HAL_TRACE_INFO( "Event received: %u\n", current_event.event_type );
+            break;
+        }
+    } while( event_pending_count > 0 );
+}
+
+/**
+ * @brief Requests the uplinks the recording application requested, once their recorded time is reached
+ */
+static void request_recorded_uplinks( void )
+{
+    const uint8_t* marker;
+    uint16_t       marker_size;
+    const uint8_t* payload;
+    uint16_t       payload_size;
+
+    while( radio_hal_replay_get_marker( &marker, &marker_size, &payload, &payload_size ) == true )
+    {
+        if( marker_size == UPLINK_MARKER_SIZE )
+        {
+            smtc_modem_request_uplink( STACK_ID, marker[0], marker[1] != 0, payload, ( uint8_t ) payload_size );
+        }
+    }
+}
+
+/**
+ * @brief Reset handler of the board: back to the modem init in main_host_replay
+ */
+static void on_modem_reset( void )
+{
+    longjmp( modem_reset_point, 1 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
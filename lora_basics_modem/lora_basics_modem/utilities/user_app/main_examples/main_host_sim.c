@@ -0,0 +1,569 @@
+/*!
+ * \file      main_host_sim.c
+ *
+ * \brief     main program for the host simulation of several modems sharing the air with a virtual gateway
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stdlib.h>   // calloc
+#include <setjmp.h>
+
+#include "main.h"
+
+#include "smtc_modem_api.h"
+#include "smtc_modem_utilities.h"
+
+#include "smtc_modem_hal.h"
+#include "smtc_hal_dbg_trace.h"
+
+#include "example_options.h"
+
+#include "smtc_hal_flash.h"
+#include "smtc_hal_lp_timer.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_rng.h"
+#include "smtc_hal_rtc.h"
+
+#include "ralf_sim.h"
+#include "ral_sim_medium.h"
+
+#include "aes.h"
+#include "cmac.h"
+
+#include <string.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * Stack id value (multistacks modem is not yet available)
+ */
+#define STACK_ID 0
+
+/**
+ * @brief Number of simulated devices
+ */
+#ifndef HOST_SIM_NB_DEVICES
+#define HOST_SIM_NB_DEVICES 16
+#endif
+
+/**
+ * @brief Virtual duration of the simulation, the program returns once elapsed
+ */
+#ifndef HOST_SIMULATION_DURATION_S
+#define HOST_SIMULATION_DURATION_S ( 24 * 3600 )
+#endif
+
+/**
+ * @brief Period between two uplinks of a device once joined
+ */
+#ifndef HOST_UPLINK_PERIOD_S
+#define HOST_UPLINK_PERIOD_S 300
+#endif
+
+/**
+ * @brief Virtual network answering the join requests
+ */
+#define HOST_SIM_NET_ID 0x000013
+#define HOST_SIM_DEV_ADDR_PREFIX 0x26000000
+#define HOST_SIM_JOIN_ACCEPT_DELAY1_MS 5000
+#define HOST_SIM_JOIN_ACCEPT_RX_DELAY_S 1
+
+/**
+ * @brief LoRaWAN frame layout used by the virtual gateway
+ */
+#define HOST_SIM_MHDR_JOIN_REQUEST 0x00
+#define HOST_SIM_MHDR_JOIN_ACCEPT 0x20
+#define HOST_SIM_JOIN_REQUEST_SIZE 23
+#define HOST_SIM_JOIN_ACCEPT_SIZE 17
+#define HOST_SIM_MIC_SIZE 4
+
+/**
+ * @brief Stack credentials, the device index is added to the DevEUI
+ */
+static const uint8_t user_dev_eui[8]  = USER_LORAWAN_DEVICE_EUI;
+static const uint8_t user_join_eui[8] = USER_LORAWAN_JOIN_EUI;
+static const uint8_t user_app_key[16] = USER_LORAWAN_APP_KEY;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief One simulated device: modem, board and radio
+ */
+typedef struct host_sim_device_s
+{
+    uint16_t          index;
+    uint8_t           dev_eui[8];
+    smtc_modem_ctx_t* modem_ctx;           //!< smtc_modem_get_ctx_size() bytes
+    void*             board_instance;      //!< hal_mcu_get_instance_size() bytes
+    ral_sim_t         radio;
+    ralf_shadow_t     radio_shadow;
+    ralf_t            radio_ralf;
+    bool              is_started;
+    uint64_t          wakeup_time_us;      //!< Next time the modem engine has to run
+    uint32_t          join_nonce;          //!< Last JoinNonce given by the virtual network
+    uint32_t          nb_tx_done;
+    uint32_t          nb_join_fail;
+    uint32_t          nb_downdata;
+    uint32_t          nb_reset;
+    uint32_t          nb_uplink_received;  //!< Uplinks received by the virtual gateway after the join
+    uint32_t          nb_wakeup;           //!< Calls to the modem engine
+    bool              is_joined;
+} host_sim_device_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static host_sim_device_t devices[HOST_SIM_NB_DEVICES];
+
+// Min-heap of the devices ordered by wake-up time: the next one to run is on top
+static host_sim_device_t* wakeup_heap[HOST_SIM_NB_DEVICES];
+
+static host_sim_device_t* current_device = NULL;
+static jmp_buf            device_reset_point;
+
+static uint32_t nb_join_accept = 0;  // Number of join accepts sent by the virtual gateway
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+static void host_sim_select_device( host_sim_device_t* device );
+static void host_sim_start_device( host_sim_device_t* device );
+static void host_sim_run_device( host_sim_device_t* device );
+static void host_sim_on_device_reset( void );
+static void host_sim_heap_sift_down( uint16_t position );
+static void host_sim_gateway_on_uplink( const ral_sim_medium_frame_t* frame );
+static void host_sim_gateway_send_join_accept( host_sim_device_t* device, const ral_sim_medium_frame_t* join_request );
+static void get_event( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Example simulating several devices running the modem, sharing the air with a virtual gateway
+ *
+ * The devices run one at a time on a shared virtual time base: the simulation always jumps to the earliest event
+ * among the devices wake-ups and the ends of frames on air. The gateway answers the join requests and counts the
+ * uplinks, collisions included.
+ */
+void main_host_sim( void )
+{
+    const uint32_t modem_ctx_size      = smtc_modem_get_ctx_size( );
+    const uint32_t board_instance_size = hal_mcu_get_instance_size( );
+
+    hal_rtc_init( );
+    ral_sim_medium_init( );
+    ral_sim_medium_set_gateway( host_sim_gateway_on_uplink );
+    hal_mcu_set_reset_handler( host_sim_on_device_reset );
+
+    for( uint16_t i = 0; i < HOST_SIM_NB_DEVICES; i++ )
+    {
+        host_sim_device_t* device = &devices[i];
+
+        device->index          = i;
+        device->modem_ctx      = calloc( 1, modem_ctx_size );
+        device->board_instance = calloc( 1, board_instance_size );
+        if( ( device->modem_ctx == NULL ) || ( device->board_instance == NULL ) )
+        {
+            mcu_panic( "Cannot allocate device %u\n", i );
+            return;
+        }
+        memcpy( device->dev_eui, user_dev_eui, sizeof( device->dev_eui ) );
+        device->dev_eui[6] += ( uint8_t )( ( i + 1 ) >> 8 );
+        device->dev_eui[7] += ( uint8_t )( i + 1 );
+        device->radio.bsp_context = device;
+        device->radio_ralf =
+            ( ralf_t ) RALF_SIM_INSTANTIATE_WITH_SHADOW( &device->radio, &device->radio_shadow );
+
+        // Fresh board: erased flash and its own random sequence
+        host_sim_select_device( device );
+        hal_flash_init_in_ram( );
+        hal_rng_set_seed( HAL_RNG_SEED + i );
+
+        // Spread the power-ups over the first second
+        device->wakeup_time_us = ( uint64_t ) hal_rng_get_random_in_range( 0, 1000000 );
+        wakeup_heap[i]         = device;
+    }
+    for( int32_t i = ( HOST_SIM_NB_DEVICES / 2 ) - 1; i >= 0; i-- )
+    {
+        host_sim_heap_sift_down( ( uint16_t ) i );
+    }
+
+    SMTC_HAL_TRACE_INFO( "Host simulation is starting: %u devices, %u bytes of modem state each\n",
+                         HOST_SIM_NB_DEVICES, modem_ctx_size );
+
+    while( true )
+    {
+        host_sim_device_t* device         = wakeup_heap[0];
+        uint64_t           medium_time_us = 0;
+
+        if( ( ral_sim_medium_get_next_event_time_us( &medium_time_us ) == true ) &&
+            ( medium_time_us <= device->wakeup_time_us ) )
+        {
+            hal_rtc_set_time_us( medium_time_us );
+            ral_sim_medium_process( );
+            continue;
+        }
+        if( device->wakeup_time_us >= ( ( uint64_t ) HOST_SIMULATION_DURATION_S * 1000000 ) )
+        {
+            break;
+        }
+
+        host_sim_run_device( device );
+        host_sim_heap_sift_down( 0 );
+    }
+
+    ral_sim_medium_stats_t medium_stats;
+    uint32_t               nb_joined = 0;
+    uint32_t               nb_reset  = 0;
+
+    ral_sim_medium_get_stats( &medium_stats );
+    for( uint16_t i = 0; i < HOST_SIM_NB_DEVICES; i++ )
+    {
+        uint16_t radio_utilization = 0;
+
+        host_sim_select_device( &devices[i] );
+        smtc_modem_get_radio_utilization( &radio_utilization );
+        SMTC_HAL_TRACE_PRINTF(
+            "Device %u: %s, %u tx, %u join fail, %u downlink, %u uplink received, %u reset, radio %u.%u%%, "
+            "%u wakeups\n",
+            i, ( devices[i].is_joined == true ) ? "joined" : "not joined", devices[i].nb_tx_done,
+            devices[i].nb_join_fail, devices[i].nb_downdata, devices[i].nb_uplink_received, devices[i].nb_reset,
+            radio_utilization / 10, radio_utilization % 10, devices[i].nb_wakeup );
+        nb_joined += ( devices[i].is_joined == true ) ? 1 : 0;
+        nb_reset += devices[i].nb_reset;
+    }
+    SMTC_HAL_TRACE_INFO( "Host simulation done after %u s: %u/%u devices joined, %u reset\n", hal_rtc_get_time_s( ),
+                         nb_joined, HOST_SIM_NB_DEVICES, nb_reset );
+    SMTC_HAL_TRACE_INFO( "Air: %u uplinks, %u collided, %u dropped, %u downlinks (%u join accepts), %u received\n",
+                         medium_stats.nb_uplinks, medium_stats.nb_collided_uplinks, medium_stats.nb_dropped_uplinks,
+                         medium_stats.nb_downlinks, nb_join_accept, medium_stats.nb_received_downlinks );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief Makes the modem and board calls work on the given device
+ */
+static void host_sim_select_device( host_sim_device_t* device )
+{
+    current_device = device;
+    smtc_modem_set_ctx( device->modem_ctx );
+    hal_mcu_set_instance( device->board_instance );
+}
+
+/**
+ * @brief Powers the device up: the modem starts from a blank state, the flash content is kept
+ */
+static void host_sim_start_device( host_sim_device_t* device )
+{
+    hal_mcu_disable_irq( );
+
+    hal_lp_timer_init( );
+
+    smtc_modem_init( &device->radio_ralf, &get_event );
+    device->is_started = true;
+
+    hal_mcu_enable_irq( );
+}
+
+/**
+ * @brief Runs the device at its wake-up time: expired timers, then the modem engine
+ */
+static void host_sim_run_device( host_sim_device_t* device )
+{
+    uint64_t expiry_time_us = 0;
+
+    host_sim_select_device( device );
+    hal_rtc_set_time_us( device->wakeup_time_us );
+
+    if( setjmp( device_reset_point ) != 0 )
+    {
+        // Reset requested by the modem, the device starts again right now
+        current_device->is_started     = false;
+        current_device->is_joined      = false;
+        current_device->wakeup_time_us = hal_rtc_get_time_us( );
+        current_device->nb_reset++;
+        return;
+    }
+
+    if( device->is_started == false )
+    {
+        host_sim_start_device( device );
+    }
+
+    hal_lp_timer_process( );
+
+    // Execute modem runtime, this function must be recalled in sleep_time_ms (max value, can be recalled sooner)
+    const uint32_t sleep_time_ms = smtc_modem_run_engine( );
+    device->nb_wakeup++;
+
+    device->wakeup_time_us = hal_rtc_get_time_us( ) + ( ( uint64_t ) sleep_time_ms * 1000 );
+    if( ( hal_lp_timer_get_next_expiry_time_us( &expiry_time_us ) == true ) &&
+        ( expiry_time_us < device->wakeup_time_us ) )
+    {
+        device->wakeup_time_us = expiry_time_us;
+    }
+}
+
+/**
+ * @brief Reset handler of the board: back to the scheduler, which restarts the device being run
+ */
+static void host_sim_on_device_reset( void )
+{
+    longjmp( device_reset_point, 1 );
+}
+
+/**
+ * @brief Moves the device at the given position down the heap until it wakes up before its children
+ */
+static void host_sim_heap_sift_down( uint16_t position )
+{
+    while( true )
+    {
+        uint16_t earliest = position;
+        uint16_t left     = ( 2 * position ) + 1;
+        uint16_t right    = left + 1;
+
+        if( ( left < HOST_SIM_NB_DEVICES ) &&
+            ( wakeup_heap[left]->wakeup_time_us < wakeup_heap[earliest]->wakeup_time_us ) )
+        {
+            earliest = left;
+        }
+        if( ( right < HOST_SIM_NB_DEVICES ) &&
+            ( wakeup_heap[right]->wakeup_time_us < wakeup_heap[earliest]->wakeup_time_us ) )
+        {
+            earliest = right;
+        }
+        if( earliest == position )
+        {
+            return;
+        }
+
+        host_sim_device_t* device = wakeup_heap[position];
+        wakeup_heap[position]     = wakeup_heap[earliest];
+        wakeup_heap[earliest]     = device;
+        position                  = earliest;
+    }
+}
+
+/**
+ * @brief Virtual gateway: called by the medium at the end of every uplink
+ */
+static void host_sim_gateway_on_uplink( const ral_sim_medium_frame_t* frame )
+{
+    host_sim_device_t* device = ( host_sim_device_t* ) ( ( const ral_sim_t* ) frame->sender )->bsp_context;
+
+    if( frame->is_collided == true )
+    {
+        return;
+    }
+
+    if( ( frame->payload[0] == HOST_SIM_MHDR_JOIN_REQUEST ) && ( frame->size_in_bytes == HOST_SIM_JOIN_REQUEST_SIZE ) )
+    {
+        // DevEUI is sent least significant byte first
+        for( uint8_t i = 0; i < 8; i++ )
+        {
+            if( frame->payload[9 + i] != device->dev_eui[7 - i] )
+            {
+                return;
+            }
+        }
+        host_sim_gateway_send_join_accept( device, frame );
+    }
+    else if( device->is_joined == true )
+    {
+        device->nb_uplink_received++;
+    }
+}
+
+/**
+ * @brief Builds the LoRaWAN 1.0.x join accept of the device and schedules it in the first reception window
+ */
+static void host_sim_gateway_send_join_accept( host_sim_device_t* device, const ral_sim_medium_frame_t* join_request )
+{
+    const uint32_t         dev_addr = HOST_SIM_DEV_ADDR_PREFIX | device->index;
+    uint8_t                plain[HOST_SIM_JOIN_ACCEPT_SIZE];
+    uint8_t                mic[AES_CMAC_DIGEST_LENGTH];
+    AES_CMAC_CTX           cmac_ctx;
+    aes_context            aes_ctx;
+    ral_sim_medium_frame_t join_accept;
+
+    device->join_nonce++;
+
+    plain[0]  = HOST_SIM_MHDR_JOIN_ACCEPT;
+    plain[1]  = ( uint8_t ) device->join_nonce;
+    plain[2]  = ( uint8_t )( device->join_nonce >> 8 );
+    plain[3]  = ( uint8_t )( device->join_nonce >> 16 );
+    plain[4]  = ( uint8_t ) HOST_SIM_NET_ID;
+    plain[5]  = ( uint8_t )( HOST_SIM_NET_ID >> 8 );
+    plain[6]  = ( uint8_t )( HOST_SIM_NET_ID >> 16 );
+    plain[7]  = ( uint8_t ) dev_addr;
+    plain[8]  = ( uint8_t )( dev_addr >> 8 );
+    plain[9]  = ( uint8_t )( dev_addr >> 16 );
+    plain[10] = ( uint8_t )( dev_addr >> 24 );
+    plain[11] = 0;  // DLSettings: no Rx1 data rate offset, Rx2 on the regional default data rate
+    plain[12] = HOST_SIM_JOIN_ACCEPT_RX_DELAY_S;
+
+    // cmac = aes128_cmac(AppKey, MHDR | JoinNonce | NetID | DevAddr | DLSettings | RxDelay)
+    AES_CMAC_Init( &cmac_ctx );
+    AES_CMAC_SetKey( &cmac_ctx, user_app_key );
+    AES_CMAC_Update( &cmac_ctx, plain, HOST_SIM_JOIN_ACCEPT_SIZE - HOST_SIM_MIC_SIZE );
+    AES_CMAC_Final( mic, &cmac_ctx );
+    memcpy( &plain[HOST_SIM_JOIN_ACCEPT_SIZE - HOST_SIM_MIC_SIZE], mic, HOST_SIM_MIC_SIZE );
+
+    // The network encrypts with the inverse cipher, so that the device only needs the forward one
+    memset( &join_accept, 0, sizeof( join_accept ) );
+    join_accept.payload[0] = plain[0];
+    aes_set_key( user_app_key, sizeof( user_app_key ), &aes_ctx );
+    aes_decrypt( &plain[1], &join_accept.payload[1], &aes_ctx );
+
+    // Rx1 on the channel and data rate of the join request
+    const ral_lora_mod_params_t mod_params = {
+        .sf   = join_request->sf,
+        .bw   = join_request->bw,
+        .cr   = RAL_LORA_CR_4_5,
+        .ldro = ( ( join_request->bw == RAL_LORA_BW_125_KHZ ) &&
+                  ( ( join_request->sf == RAL_LORA_SF11 ) || ( join_request->sf == RAL_LORA_SF12 ) ) )
+                    ? 1
+                    : 0,
+    };
+    const ral_lora_pkt_params_t pkt_params = {
+        .preamble_len_in_symb = 8,
+        .header_type          = RAL_LORA_PKT_EXPLICIT,
+        .pld_len_in_bytes     = HOST_SIM_JOIN_ACCEPT_SIZE,
+        .crc_is_on            = false,
+        .invert_iq_is_on      = true,
+    };
+
+    join_accept.sender          = NULL;
+    join_accept.rf_freq_in_hz   = join_request->rf_freq_in_hz;
+    join_accept.sf              = join_request->sf;
+    join_accept.bw              = join_request->bw;
+    join_accept.invert_iq_is_on = true;
+    join_accept.start_time_us   = join_request->end_time_us + ( ( uint64_t ) HOST_SIM_JOIN_ACCEPT_DELAY1_MS * 1000 );
+    join_accept.end_time_us =
+        join_accept.start_time_us +
+        ( ( uint64_t ) ral_sim_get_lora_time_on_air_in_ms( &pkt_params, &mod_params ) * 1000 );
+    join_accept.size_in_bytes = HOST_SIM_JOIN_ACCEPT_SIZE;
+
+    ral_sim_medium_schedule_downlink( &join_accept );
+    nb_join_accept++;
+}
+
+/**
+ * @brief User callback for modem event, of the device being run
+ *
+ *  This callback is called every time an event ( see smtc_modem_event_t ) appears in the modem.
+ *  Several events may have to be read from the modem when this callback is called.
+ */
+static void get_event( void )
+{
+    host_sim_device_t*            device = current_device;
+    smtc_modem_event_t            current_event;
+    smtc_modem_dl_payload_spans_t downdata_spans;
+    uint8_t                       event_pending_count;
+    uint8_t                       stack_id = STACK_ID;
+
+    // Continue to read modem event until all event has been processed
+    do
+    {
+        // Read modem event, a downlink payload is read in place in the modem fifo
+        smtc_modem_get_event_zero_copy( &current_event, &event_pending_count, &downdata_spans );
+
+        switch( current_event.event_type )
+        {
+        case SMTC_MODEM_EVENT_RESET:
+            // Set user credentials
+            smtc_modem_set_deveui( stack_id, device->dev_eui );
+            smtc_modem_set_joineui( stack_id, user_join_eui );
+            smtc_modem_set_nwkkey( stack_id, user_app_key );
+            // Set user region
+            smtc_modem_set_region( stack_id, MODEM_EXAMPLE_REGION );
+            // Schedule a Join LoRaWAN network
+            smtc_modem_join_network( stack_id );
+            break;
+
+        case SMTC_MODEM_EVENT_ALARM:
+        {
+            // Send the device index on port 102 and schedule the next uplink
+            uint8_t payload[2] = { ( uint8_t )( device->index >> 8 ), ( uint8_t ) device->index };
+            smtc_modem_request_uplink( stack_id, 102, false, payload, sizeof( payload ) );
+            smtc_modem_alarm_start_timer( HOST_UPLINK_PERIOD_S );
+            break;
+        }
+
+        case SMTC_MODEM_EVENT_JOINED:
+            SMTC_HAL_TRACE_INFO( "Device %u joined at %u s\n", device->index, hal_rtc_get_time_s( ) );
+            device->is_joined = true;
+            // Random phase, so that devices which joined together do not keep colliding
+            smtc_modem_alarm_start_timer( hal_rng_get_random_in_range( 1, HOST_UPLINK_PERIOD_S ) );
+            break;
+
+        case SMTC_MODEM_EVENT_TXDONE:
+            device->nb_tx_done++;
+            break;
+
+        case SMTC_MODEM_EVENT_DOWNDATA:
+            device->nb_downdata++;
+            smtc_modem_release_downdata( );
+            break;
+
+        case SMTC_MODEM_EVENT_JOINFAIL:
+            device->nb_join_fail++;
+            break;
+
+        default:
+            break;
+        }
+    } while( event_pending_count > 0 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
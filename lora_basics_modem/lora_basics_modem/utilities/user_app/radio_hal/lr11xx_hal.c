@@ -47,6 +47,10 @@
 
 #include "modem_pinout.h"
 
+#if defined( RADIO_HAL_TRACE )
+#include "radio_hal_trace.h"
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE MACROS-----------------------------------------------------------
@@ -109,14 +113,8 @@ lr11xx_hal_status_t lr11xx_hal_write( const void* context, const uint8_t* comman
 
     // Put NSS low to start spi transaction
     hal_gpio_set_value( RADIO_NSS, 0 );
-    for( uint16_t i = 0; i < command_length; i++ )
-    {
-        hal_spi_in_out( RADIO_SPI_ID, command[i] );
-    }
-    for( uint16_t i = 0; i < data_length; i++ )
-    {
-        hal_spi_in_out( RADIO_SPI_ID, data[i] );
-    }
+    hal_spi_transfer( RADIO_SPI_ID, command, NULL, command_length );
+    hal_spi_transfer( RADIO_SPI_ID, data, NULL, data_length );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     // Add crc byte at the end of the transaction
@@ -126,6 +124,10 @@ lr11xx_hal_status_t lr11xx_hal_write( const void* context, const uint8_t* comman
     // Put NSS high as the spi transaction is finished
     hal_gpio_set_value( RADIO_NSS, 1 );
 
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_WRITE, command, command_length, data, data_length );
+#endif
+
     // LR11XX_SYSTEM_SET_SLEEP_OC=0x011B opcode. In sleep mode the radio busy line is held at 1 => do not test it
     if( ( command[0] == 0x01 ) && ( command[1] == 0x1B ) )
     {
@@ -150,10 +152,7 @@ lr11xx_hal_status_t lr11xx_hal_read( const void* context, const uint8_t* command
 
     // Put NSS low to start spi transaction
     hal_gpio_set_value( RADIO_NSS, 0 );
-    for( uint16_t i = 0; i < command_length; i++ )
-    {
-        hal_spi_in_out( RADIO_SPI_ID, command[i] );
-    }
+    hal_spi_transfer( RADIO_SPI_ID, command, NULL, command_length );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     // Add crc byte at the end of the transaction
@@ -175,10 +174,7 @@ lr11xx_hal_status_t lr11xx_hal_read( const void* context, const uint8_t* command
         hal_spi_in_out( RADIO_SPI_ID, 0 );
 #endif
 
-        for( uint16_t i = 0; i < data_length; i++ )
-        {
-            data[i] = hal_spi_in_out( RADIO_SPI_ID, 0 );
-        }
+        hal_spi_transfer( RADIO_SPI_ID, NULL, data, data_length );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
         // read crc sent by lr11xx at the end of the transaction
@@ -200,6 +196,10 @@ lr11xx_hal_status_t lr11xx_hal_read( const void* context, const uint8_t* command
 #endif
     }
 
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_READ, command, command_length, data, data_length );
+#endif
+
     return LR11XX_HAL_STATUS_OK;
 }
 
@@ -210,10 +210,7 @@ lr11xx_hal_status_t lr11xx_hal_direct_read( const void* context, uint8_t* data,
     // Put NSS low to start spi transaction
     hal_gpio_set_value( RADIO_NSS, 0 );
 
-    for( uint16_t i = 0; i < data_length; i++ )
-    {
-        data[i] = hal_spi_in_out( RADIO_SPI_ID, 0 );
-    }
+    hal_spi_transfer( RADIO_SPI_ID, NULL, data, data_length );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     // read crc sent by lr11xx by sending one more NOP
@@ -232,6 +229,10 @@ lr11xx_hal_status_t lr11xx_hal_direct_read( const void* context, uint8_t* data,
     }
 #endif
 
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_DIRECT_READ, NULL, 0, data, data_length );
+#endif
+
     return LR11XX_HAL_STATUS_OK;
 }
 
@@ -245,6 +246,9 @@ lr11xx_hal_status_t lr11xx_hal_reset( const void* context )
     // Wait 200ms until internal lr11xx fw is ready
     hal_mcu_wait_us( 200000 );
     radio_mode = RADIO_AWAKE;
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_RESET, NULL, 0, NULL, 0 );
+#endif
 
     return LR11XX_HAL_STATUS_OK;
 }
@@ -0,0 +1,547 @@
+/*!
+ * \file      radio_hal_replay.c
+ *
+ * \brief     Host replay of a radio hal trace: the radio answers the stack with the recorded responses
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>   // NULL
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radio_hal_replay.h"
+#include "smtc_hal_dbg_trace.h"
+#include "smtc_hal_gpio.h"
+#include "smtc_hal_lp_timer.h"
+#include "smtc_hal_rtc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * Number of microseconds per time step of the trace
+ */
+#define RADIO_HAL_REPLAY_US_PER_STEP 100
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*!
+ * Decoded record of the trace
+ */
+typedef struct radio_hal_replay_record_s
+{
+    radio_hal_trace_type_t type;
+    uint64_t               time_us;  //!< Time since the start of the trace
+    const uint8_t*         command;
+    uint16_t               command_length;
+    const uint8_t*         data;
+    uint16_t               data_length;
+} radio_hal_replay_record_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint8_t*                   replay_file_content = NULL;
+static radio_hal_replay_record_t* replay_records      = NULL;
+static uint32_t                   replay_nb_records   = 0;
+static uint32_t                   replay_position     = 0;  //!< Index of the next record to replay
+static bool                       replay_irq_is_armed = false;
+static uint64_t                   replay_irq_time_us  = 0;  //!< Time of the armed irq in the trace
+
+// Time of the last consumed record, in the trace and on the host: the following records are due relative to it
+static uint64_t replay_anchor_trace_time_us = 0;
+static uint64_t replay_anchor_host_time_us  = 0;
+
+static radio_hal_replay_stats_t replay_stats;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * Decodes a LEB128 value
+ *
+ * \param [in]     buffer Trace content
+ * \param [in]     size   Size of the trace content
+ * \param [in,out] offset Position of the value, moved after it
+ * \param [out]    value  Decoded value
+ *
+ * \retval true if the value is complete, false otherwise
+ */
+static bool radio_hal_replay_get_leb128( const uint8_t* buffer, const uint32_t size, uint32_t* offset,
+                                         uint32_t* value );
+
+/*!
+ * Decodes the records of the trace, or only counts them if records is NULL
+ *
+ * \retval Number of records, -1 if the trace is corrupted
+ */
+static int32_t radio_hal_replay_decode( const uint8_t* buffer, const uint32_t size,
+                                        radio_hal_replay_record_t* records );
+
+/*!
+ * Host time at which a record is due
+ */
+static uint64_t radio_hal_replay_get_due_time_us( const radio_hal_replay_record_t* record );
+
+/*!
+ * Looks ahead of the replay position for the record of a transaction, without crossing a marker
+ *
+ * \param [in]  type           Transaction type
+ * \param [in]  command        Command bytes
+ * \param [in]  command_length Number of command bytes
+ * \param [in]  data           Written bytes, NULL for a read
+ * \param [in]  data_length    Number of data bytes
+ * \param [in]  opcode_length  Number of command bytes identifying the command of the radio
+ * \param [out] is_exact       Same command and data, or same opcode only
+ *
+ * \retval Index of the record, -1 if not found
+ */
+static int32_t radio_hal_replay_find( const radio_hal_trace_type_t type, const uint8_t* command,
+                                      const uint16_t command_length, const uint8_t* data, const uint16_t data_length,
+                                      const uint8_t opcode_length, bool* is_exact );
+
+/*!
+ * Moves the replay position after a record, the records crossed are skipped
+ */
+static void radio_hal_replay_consume( const uint32_t index );
+
+/*!
+ * Raises the radio irq line, as recorded
+ */
+static void radio_hal_replay_on_irq_timer( void* context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool radio_hal_replay_open( const char* file_name )
+{
+    FILE* file = fopen( file_name, "rb" );
+    long  size = -1;
+
+    radio_hal_replay_close( );
+
+    if( file == NULL )
+    {
+        SMTC_HAL_TRACE_ERROR( "Cannot open %s\n", file_name );
+        return false;
+    }
+
+    if( fseek( file, 0, SEEK_END ) == 0 )
+    {
+        size = ftell( file );
+        rewind( file );
+    }
+    if( size > 0 )
+    {
+        replay_file_content = malloc( ( size_t ) size );
+    }
+    if( ( replay_file_content == NULL ) ||
+        ( fread( replay_file_content, 1, ( size_t ) size, file ) != ( size_t ) size ) )
+    {
+        SMTC_HAL_TRACE_ERROR( "Cannot read %s\n", file_name );
+        fclose( file );
+        radio_hal_replay_close( );
+        return false;
+    }
+    fclose( file );
+
+    const int32_t nb_records = radio_hal_replay_decode( replay_file_content, ( uint32_t ) size, NULL );
+    if( nb_records < 0 )
+    {
+        SMTC_HAL_TRACE_ERROR( "%s is not a radio hal trace\n", file_name );
+        radio_hal_replay_close( );
+        return false;
+    }
+    if( nb_records > 0 )
+    {
+        replay_records = malloc( ( size_t ) nb_records * sizeof( radio_hal_replay_record_t ) );
+        if( replay_records == NULL )
+        {
+            radio_hal_replay_close( );
+            return false;
+        }
+        radio_hal_replay_decode( replay_file_content, ( uint32_t ) size, replay_records );
+    }
+
+    replay_nb_records           = ( uint32_t ) nb_records;
+    replay_anchor_trace_time_us = 0;
+    replay_anchor_host_time_us  = hal_rtc_get_time_us( );
+
+    SMTC_HAL_TRACE_INFO( "Replay of %s: %u records\n", file_name, replay_nb_records );
+    return true;
+}
+
+void radio_hal_replay_close( void )
+{
+    if( replay_irq_is_armed == true )
+    {
+        hal_lp_timer_stop( HAL_LP_TIMER_ID_RADIO );
+    }
+
+    free( replay_records );
+    free( replay_file_content );
+    replay_records      = NULL;
+    replay_file_content = NULL;
+    replay_nb_records   = 0;
+    replay_position     = 0;
+    replay_irq_is_armed = false;
+    memset( &replay_stats, 0, sizeof( replay_stats ) );
+}
+
+bool radio_hal_replay_is_over( void )
+{
+    return ( replay_position >= replay_nb_records ) && ( replay_irq_is_armed == false );
+}
+
+void radio_hal_replay_write( const uint8_t* command, const uint16_t command_length, const uint8_t* data,
+                             const uint16_t data_length, const uint8_t opcode_length )
+{
+    bool          is_exact = false;
+    const int32_t index    = radio_hal_replay_find( RADIO_HAL_TRACE_WRITE, command, command_length, data, data_length,
+                                                    opcode_length, &is_exact );
+
+    if( index < 0 )
+    {
+        replay_stats.nb_unmatched++;
+        return;
+    }
+
+    if( is_exact == true )
+    {
+        replay_stats.nb_matched++;
+    }
+    else
+    {
+        replay_stats.nb_diverged++;
+    }
+    radio_hal_replay_consume( ( uint32_t ) index );
+}
+
+void radio_hal_replay_read( const radio_hal_trace_type_t type, const uint8_t* command, const uint16_t command_length,
+                            uint8_t* data, const uint16_t data_length, const uint8_t opcode_length )
+{
+    bool          is_exact = false;
+    const int32_t index =
+        radio_hal_replay_find( type, command, command_length, NULL, data_length, opcode_length, &is_exact );
+
+    memset( data, 0, data_length );
+
+    if( index < 0 )
+    {
+        replay_stats.nb_unmatched++;
+        return;
+    }
+
+    const radio_hal_replay_record_t* record = &replay_records[index];
+
+    memcpy( data, record->data, ( record->data_length < data_length ) ? record->data_length : data_length );
+    if( is_exact == true )
+    {
+        replay_stats.nb_matched++;
+    }
+    else
+    {
+        replay_stats.nb_diverged++;
+    }
+    radio_hal_replay_consume( ( uint32_t ) index );
+}
+
+void radio_hal_replay_reset( void )
+{
+    bool          is_exact = false;
+    const int32_t index    = radio_hal_replay_find( RADIO_HAL_TRACE_RESET, NULL, 0, NULL, 0, 0, &is_exact );
+
+    // The reset clears the irq of the radio
+    if( replay_irq_is_armed == true )
+    {
+        hal_lp_timer_stop( HAL_LP_TIMER_ID_RADIO );
+        replay_irq_is_armed = false;
+    }
+
+    if( index < 0 )
+    {
+        replay_stats.nb_unmatched++;
+        return;
+    }
+
+    replay_stats.nb_matched++;
+    radio_hal_replay_consume( ( uint32_t ) index );
+}
+
+uint32_t radio_hal_replay_process( void )
+{
+    const uint64_t now_us = hal_rtc_get_time_us( );
+
+    while( replay_position < replay_nb_records )
+    {
+        const radio_hal_replay_record_t* record = &replay_records[replay_position];
+        const uint64_t                   due_us = radio_hal_replay_get_due_time_us( record );
+
+        if( record->type == RADIO_HAL_TRACE_IRQ )
+        {
+            if( replay_irq_is_armed == true )
+            {
+                // Armed irqs are raised in order: the next one waits
+                return UINT32_MAX;
+            }
+
+            const uint64_t delay_us = ( due_us > now_us ) ? ( due_us - now_us ) : 0;
+
+            hal_lp_timer_start( HAL_LP_TIMER_ID_RADIO, ( uint32_t )( ( delay_us + 999 ) / 1000 ),
+                                &( hal_lp_timer_irq_t ){ .context = NULL, .callback = radio_hal_replay_on_irq_timer } );
+            replay_irq_is_armed = true;
+            replay_irq_time_us  = record->time_us;
+            replay_position++;
+            continue;
+        }
+
+        if( record->type == RADIO_HAL_TRACE_MARKER )
+        {
+            // Consumed by radio_hal_replay_get_marker
+            return ( due_us > now_us ) ? ( uint32_t )( ( due_us - now_us + 999 ) / 1000 ) : 0;
+        }
+
+        // Transaction the stack is expected to issue: wait for it, up to the resync delay
+        const uint64_t resync_us = due_us + ( ( uint64_t ) RADIO_HAL_REPLAY_RESYNC_DELAY_MS * 1000 );
+        if( now_us < resync_us )
+        {
+            return ( uint32_t )( ( resync_us - now_us + 999 ) / 1000 );
+        }
+        replay_stats.nb_skipped++;
+        replay_position++;
+    }
+
+    return UINT32_MAX;
+}
+
+bool radio_hal_replay_get_marker( const uint8_t** command, uint16_t* command_length, const uint8_t** data,
+                                  uint16_t* data_length )
+{
+    if( replay_position >= replay_nb_records )
+    {
+        return false;
+    }
+
+    const radio_hal_replay_record_t* record = &replay_records[replay_position];
+
+    if( ( record->type != RADIO_HAL_TRACE_MARKER ) ||
+        ( hal_rtc_get_time_us( ) < radio_hal_replay_get_due_time_us( record ) ) )
+    {
+        return false;
+    }
+
+    *command        = record->command;
+    *command_length = record->command_length;
+    *data           = record->data;
+    *data_length    = record->data_length;
+    radio_hal_replay_consume( replay_position );
+    return true;
+}
+
+void radio_hal_replay_get_stats( radio_hal_replay_stats_t* stats )
+{
+    *stats = replay_stats;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool radio_hal_replay_get_leb128( const uint8_t* buffer, const uint32_t size, uint32_t* offset,
+                                         uint32_t* value )
+{
+    *value = 0;
+
+    for( uint8_t shift = 0; ( shift < 32 ) && ( *offset < size ); shift += 7 )
+    {
+        const uint8_t byte = buffer[( *offset )++];
+
+        *value |= ( uint32_t )( byte & 0x7F ) << shift;
+        if( ( byte & 0x80 ) == 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static int32_t radio_hal_replay_decode( const uint8_t* buffer, const uint32_t size,
+                                        radio_hal_replay_record_t* records )
+{
+    uint32_t offset     = RADIO_HAL_TRACE_HEADER_SIZE;
+    uint64_t time_us    = 0;
+    int32_t  nb_records = 0;
+
+    if( ( size < RADIO_HAL_TRACE_HEADER_SIZE ) || ( memcmp( buffer, "RHT", 3 ) != 0 ) ||
+        ( buffer[3] != RADIO_HAL_TRACE_VERSION ) )
+    {
+        return -1;
+    }
+
+    while( offset < size )
+    {
+        const uint8_t type = buffer[offset++];
+        uint32_t      delay;
+        uint32_t      command_length;
+        uint32_t      data_length;
+
+        if( ( type < RADIO_HAL_TRACE_WRITE ) || ( type > RADIO_HAL_TRACE_MARKER ) ||
+            ( radio_hal_replay_get_leb128( buffer, size, &offset, &delay ) == false ) ||
+            ( radio_hal_replay_get_leb128( buffer, size, &offset, &command_length ) == false ) ||
+            ( radio_hal_replay_get_leb128( buffer, size, &offset, &data_length ) == false ) ||
+            ( command_length > UINT16_MAX ) || ( data_length > UINT16_MAX ) ||
+            ( ( size - offset ) < ( command_length + data_length ) ) )
+        {
+            return -1;
+        }
+
+        time_us += ( uint64_t ) delay * RADIO_HAL_REPLAY_US_PER_STEP;
+        if( records != NULL )
+        {
+            records[nb_records].type           = ( radio_hal_trace_type_t ) type;
+            records[nb_records].time_us        = time_us;
+            records[nb_records].command        = &buffer[offset];
+            records[nb_records].command_length = ( uint16_t ) command_length;
+            records[nb_records].data           = &buffer[offset + command_length];
+            records[nb_records].data_length    = ( uint16_t ) data_length;
+        }
+        offset += command_length + data_length;
+        nb_records++;
+    }
+
+    return nb_records;
+}
+
+static uint64_t radio_hal_replay_get_due_time_us( const radio_hal_replay_record_t* record )
+{
+    return replay_anchor_host_time_us + ( record->time_us - replay_anchor_trace_time_us );
+}
+
+static int32_t radio_hal_replay_find( const radio_hal_trace_type_t type, const uint8_t* command,
+                                      const uint16_t command_length, const uint8_t* data, const uint16_t data_length,
+                                      const uint8_t opcode_length, bool* is_exact )
+{
+    int32_t        candidate = -1;
+    const uint32_t end       = ( ( replay_nb_records - replay_position ) > RADIO_HAL_REPLAY_SEARCH_WINDOW )
+                                   ? ( replay_position + RADIO_HAL_REPLAY_SEARCH_WINDOW )
+                                   : replay_nb_records;
+
+    for( uint32_t i = replay_position; i < end; i++ )
+    {
+        const radio_hal_replay_record_t* record = &replay_records[i];
+
+        // Application events keep the replay aligned with the recorded scenario
+        if( record->type == RADIO_HAL_TRACE_MARKER )
+        {
+            break;
+        }
+        if( record->type != type )
+        {
+            continue;
+        }
+
+        const bool is_same_command =
+            ( record->command_length == command_length ) &&
+            ( ( command_length == 0 ) || ( memcmp( record->command, command, command_length ) == 0 ) );
+        const bool is_same_data =
+            ( record->data_length == data_length ) &&
+            ( ( data == NULL ) || ( data_length == 0 ) || ( memcmp( record->data, data, data_length ) == 0 ) );
+
+        if( ( is_same_command == true ) && ( is_same_data == true ) )
+        {
+            *is_exact = true;
+            return ( int32_t ) i;
+        }
+        if( ( candidate < 0 ) && ( record->command_length >= opcode_length ) && ( command_length >= opcode_length ) &&
+            ( ( opcode_length == 0 ) || ( memcmp( record->command, command, opcode_length ) == 0 ) ) )
+        {
+            candidate = ( int32_t ) i;
+        }
+    }
+
+    *is_exact = false;
+    return candidate;
+}
+
+static void radio_hal_replay_consume( const uint32_t index )
+{
+    const radio_hal_replay_record_t* record = &replay_records[index];
+
+    replay_stats.nb_skipped += index - replay_position;
+    replay_position             = index + 1;
+    replay_anchor_trace_time_us = record->time_us;
+    replay_anchor_host_time_us  = hal_rtc_get_time_us( );
+
+    // An irq recorded right after this transaction is armed at once
+    radio_hal_replay_process( );
+}
+
+static void radio_hal_replay_on_irq_timer( void* context )
+{
+    replay_irq_is_armed = false;
+
+    // Transactions recorded after the irq may already have been replayed
+    if( replay_irq_time_us >= replay_anchor_trace_time_us )
+    {
+        replay_anchor_trace_time_us = replay_irq_time_us;
+        replay_anchor_host_time_us  = hal_rtc_get_time_us( );
+    }
+
+    radio_hal_trace_record( RADIO_HAL_TRACE_IRQ, NULL, 0, NULL, 0 );
+    hal_gpio_set_pending_irq( RADIO_DIOX );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
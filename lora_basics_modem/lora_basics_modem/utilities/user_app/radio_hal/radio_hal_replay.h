@@ -0,0 +1,188 @@
+/*!
+ * \file      radio_hal_replay.h
+ *
+ * \brief     Host replay of a radio hal trace: the radio answers the stack with the recorded responses
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __RADIO_HAL_REPLAY_H__
+#define __RADIO_HAL_REPLAY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "radio_hal_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Trace replayed, recorded on target with RADIO_HAL_TRACE=yes
+ */
+#define RADIO_HAL_REPLAY_FILE_NAME "radio_hal_trace.bin"
+
+/*!
+ * Number of records looked ahead of the replay position for a transaction of the stack
+ */
+#ifndef RADIO_HAL_REPLAY_SEARCH_WINDOW
+#define RADIO_HAL_REPLAY_SEARCH_WINDOW 32
+#endif
+
+/*!
+ * Delay after its recorded time at which a record the stack did not issue is skipped
+ */
+#ifndef RADIO_HAL_REPLAY_RESYNC_DELAY_MS
+#define RADIO_HAL_REPLAY_RESYNC_DELAY_MS 10000
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * Matching counters between the stack and the trace
+ */
+typedef struct radio_hal_replay_stats_s
+{
+    uint32_t nb_matched;    //!< Transactions found in the trace with the same command and data
+    uint32_t nb_diverged;   //!< Transactions found with the same opcode but other parameters or data
+    uint32_t nb_unmatched;  //!< Transactions not found in the trace, reads return zeros
+    uint32_t nb_skipped;    //!< Records of the trace the stack did not issue
+} radio_hal_replay_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Loads a trace and starts its replay at the current time
+ *
+ * \param [in] file_name Binary trace, see radio_hal_trace.h for its format
+ *
+ * \retval true if the trace has been loaded, false otherwise
+ */
+bool radio_hal_replay_open( const char* file_name );
+
+/*!
+ * Releases the trace
+ */
+void radio_hal_replay_close( void );
+
+/*!
+ * Tells whether all the records have been replayed or skipped
+ *
+ * \retval true once the end of the trace is reached, false otherwise
+ */
+bool radio_hal_replay_is_over( void );
+
+/*!
+ * Consumes the write of the trace corresponding to a write of the stack
+ *
+ * \param [in] command        Command bytes
+ * \param [in] command_length Number of command bytes
+ * \param [in] data           Data bytes
+ * \param [in] data_length    Number of data bytes
+ * \param [in] opcode_length  Number of command bytes identifying the command of the radio
+ */
+void radio_hal_replay_write( const uint8_t* command, const uint16_t command_length, const uint8_t* data,
+                             const uint16_t data_length, const uint8_t opcode_length );
+
+/*!
+ * Consumes the read of the trace corresponding to a read of the stack and returns its response
+ *
+ * \param [in]  type           RADIO_HAL_TRACE_READ or RADIO_HAL_TRACE_DIRECT_READ
+ * \param [in]  command        Command bytes
+ * \param [in]  command_length Number of command bytes
+ * \param [out] data           Recorded response, zeros if the read is not found
+ * \param [in]  data_length    Number of response bytes
+ * \param [in]  opcode_length  Number of command bytes identifying the command of the radio
+ */
+void radio_hal_replay_read( const radio_hal_trace_type_t type, const uint8_t* command, const uint16_t command_length,
+                            uint8_t* data, const uint16_t data_length, const uint8_t opcode_length );
+
+/*!
+ * Consumes the reset of the trace corresponding to a reset of the radio by the stack, the pending irq is cancelled
+ */
+void radio_hal_replay_reset( void );
+
+/*!
+ * Arms the next recorded irq and skips the records the stack missed
+ *
+ * \remark To be called by the application before sleeping
+ *
+ * \retval Delay in ms before the replay needs to be processed again, UINT32_MAX if nothing is pending
+ */
+uint32_t radio_hal_replay_process( void );
+
+/*!
+ * Gets the next application marker once its recorded time is reached
+ *
+ * \param [out] command        Command bytes of the marker
+ * \param [out] command_length Number of command bytes
+ * \param [out] data           Data bytes of the marker
+ * \param [out] data_length    Number of data bytes
+ *
+ * \retval true if a marker has been consumed, false otherwise
+ */
+bool radio_hal_replay_get_marker( const uint8_t** command, uint16_t* command_length, const uint8_t** data,
+                                  uint16_t* data_length );
+
+/*!
+ * Gets the matching counters
+ *
+ * \param [out] stats Counters since radio_hal_replay_open
+ */
+void radio_hal_replay_get_stats( radio_hal_replay_stats_t* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __RADIO_HAL_REPLAY_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,258 @@
+/*!
+ * \file      radio_hal_trace.c
+ *
+ * \brief     Recorder of the radio hal transactions in a compact binary trace
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>   // NULL
+#include <string.h>
+
+#include "radio_hal_trace.h"
+#include "smtc_hal_dbg_trace.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_rtc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * Maximum size of a LEB128 encoded 32-bit value
+ */
+#define RADIO_HAL_TRACE_LEB128_MAX_SIZE 5
+
+/*!
+ * Maximum size of a record without its command and data bytes: type, time and lengths
+ */
+#define RADIO_HAL_TRACE_RECORD_MAX_OVERHEAD ( 1 + ( 3 * RADIO_HAL_TRACE_LEB128_MAX_SIZE ) )
+
+/*!
+ * Number of trace bytes printed per line by radio_hal_trace_flush
+ */
+#define RADIO_HAL_TRACE_BYTES_PER_LINE 32
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint8_t  trace_buffer[RADIO_HAL_TRACE_BUFFER_SIZE] = { 'R', 'H', 'T', RADIO_HAL_TRACE_VERSION };
+static uint32_t trace_size                                = RADIO_HAL_TRACE_HEADER_SIZE;
+static bool     trace_header_is_flushed                   = false;
+static uint32_t trace_last_record_time_100us              = 0;
+
+static radio_hal_trace_stats_t trace_stats;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * Encodes a value in LEB128: 7 bits per byte, least significant first, msb set on all bytes but the last one
+ *
+ * \param [out] buffer Destination, at least RADIO_HAL_TRACE_LEB128_MAX_SIZE bytes
+ * \param [in]  value  Value to encode
+ *
+ * \retval Number of bytes written
+ */
+static uint8_t radio_hal_trace_put_leb128( uint8_t* buffer, uint32_t value );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void radio_hal_trace_record( const radio_hal_trace_type_t type, const uint8_t* command, const uint16_t command_length,
+                             const uint8_t* data, const uint16_t data_length )
+{
+    uint32_t mask;
+
+    hal_mcu_critical_section_begin( &mask );
+
+    switch( type )
+    {
+    case RADIO_HAL_TRACE_WRITE:
+        trace_stats.nb_transactions++;
+        trace_stats.nb_bytes_out += command_length + data_length;
+        break;
+    case RADIO_HAL_TRACE_READ:
+    case RADIO_HAL_TRACE_DIRECT_READ:
+        trace_stats.nb_transactions++;
+        trace_stats.nb_bytes_out += command_length;
+        trace_stats.nb_bytes_in += data_length;
+        break;
+    case RADIO_HAL_TRACE_IRQ:
+        trace_stats.nb_irqs++;
+        break;
+    default:
+        break;
+    }
+
+    if( ( trace_size + RADIO_HAL_TRACE_RECORD_MAX_OVERHEAD + command_length + data_length ) <=
+        RADIO_HAL_TRACE_BUFFER_SIZE )
+    {
+        const uint32_t now_100us = hal_rtc_get_time_100us( );
+        uint8_t*       record    = &trace_buffer[trace_size];
+        uint32_t       size      = 0;
+
+        record[size++] = ( uint8_t ) type;
+        size += radio_hal_trace_put_leb128( &record[size], now_100us - trace_last_record_time_100us );
+        size += radio_hal_trace_put_leb128( &record[size], command_length );
+        size += radio_hal_trace_put_leb128( &record[size], data_length );
+        if( command_length > 0 )
+        {
+            memcpy( &record[size], command, command_length );
+            size += command_length;
+        }
+        if( data_length > 0 )
+        {
+            memcpy( &record[size], data, data_length );
+            size += data_length;
+        }
+
+        trace_size += size;
+        trace_last_record_time_100us = now_100us;
+    }
+    else
+    {
+        // The time of the next record is still relative to the last one kept
+        trace_stats.nb_dropped_records++;
+    }
+
+    hal_mcu_critical_section_end( &mask );
+}
+
+const uint8_t* radio_hal_trace_get_buffer( uint32_t* size )
+{
+    *size = trace_size;
+    return trace_buffer;
+}
+
+void radio_hal_trace_flush( void )
+{
+    static const char hex_digits[] = "0123456789abcdef";
+    char              line[sizeof( RADIO_HAL_TRACE_LINE_PREFIX ) + ( 2 * RADIO_HAL_TRACE_BYTES_PER_LINE ) + 1];
+    uint32_t          mask;
+    uint32_t          size;
+
+    // Records appended by an irq while printing are kept for the next flush
+    hal_mcu_critical_section_begin( &mask );
+    size = trace_size;
+    hal_mcu_critical_section_end( &mask );
+
+    for( uint32_t offset = 0; offset < size; offset += RADIO_HAL_TRACE_BYTES_PER_LINE )
+    {
+        uint32_t length = sizeof( RADIO_HAL_TRACE_LINE_PREFIX ) - 1;
+
+        memcpy( line, RADIO_HAL_TRACE_LINE_PREFIX, length );
+        for( uint32_t i = offset; ( i < size ) && ( i < ( offset + RADIO_HAL_TRACE_BYTES_PER_LINE ) ); i++ )
+        {
+            line[length++] = hex_digits[trace_buffer[i] >> 4];
+            line[length++] = hex_digits[trace_buffer[i] & 0x0F];
+        }
+        line[length++] = '\n';
+        line[length]   = '\0';
+        SMTC_HAL_TRACE_PRINTF( "%s", line );
+    }
+
+    hal_mcu_critical_section_begin( &mask );
+    memmove( trace_buffer, &trace_buffer[size], trace_size - size );
+    trace_size -= size;
+    trace_header_is_flushed = true;
+    hal_mcu_critical_section_end( &mask );
+}
+
+void radio_hal_trace_clear( void )
+{
+    uint32_t mask;
+
+    hal_mcu_critical_section_begin( &mask );
+    trace_size = ( trace_header_is_flushed == true ) ? 0 : RADIO_HAL_TRACE_HEADER_SIZE;
+    hal_mcu_critical_section_end( &mask );
+}
+
+void radio_hal_trace_get_stats( radio_hal_trace_stats_t* stats )
+{
+    uint32_t mask;
+
+    hal_mcu_critical_section_begin( &mask );
+    *stats = trace_stats;
+    hal_mcu_critical_section_end( &mask );
+}
+
+void radio_hal_trace_reset_stats( void )
+{
+    uint32_t mask;
+
+    hal_mcu_critical_section_begin( &mask );
+    memset( &trace_stats, 0, sizeof( trace_stats ) );
+    hal_mcu_critical_section_end( &mask );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint8_t radio_hal_trace_put_leb128( uint8_t* buffer, uint32_t value )
+{
+    uint8_t size = 0;
+
+    while( value >= 0x80 )
+    {
+        buffer[size++] = ( uint8_t )( value | 0x80 );
+        value >>= 7;
+    }
+    buffer[size++] = ( uint8_t ) value;
+
+    return size;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
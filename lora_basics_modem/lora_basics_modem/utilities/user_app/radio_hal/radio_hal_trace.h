@@ -0,0 +1,174 @@
+/*!
+ * \file      radio_hal_trace.h
+ *
+ * \brief     Recorder of the radio hal transactions in a compact binary trace
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __RADIO_HAL_TRACE_H__
+#define __RADIO_HAL_TRACE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Size of the RAM buffer holding the records not yet flushed, the following ones are dropped
+ */
+#ifndef RADIO_HAL_TRACE_BUFFER_SIZE
+#define RADIO_HAL_TRACE_BUFFER_SIZE 4096
+#endif
+
+/*!
+ * Header of a trace: "RHT" followed by the format version
+ */
+#define RADIO_HAL_TRACE_HEADER_SIZE 4
+#define RADIO_HAL_TRACE_VERSION 1
+
+/*!
+ * Prefix of the lines printed by radio_hal_trace_flush
+ */
+#define RADIO_HAL_TRACE_LINE_PREFIX "RHT:"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * Record types
+ *
+ * A trace is its header followed by records made of:
+ *  - the type, on one byte
+ *  - the time elapsed since the previous record in 100 us steps, LEB128 encoded
+ *  - the command length and the data length, LEB128 encoded
+ *  - the command bytes, then the data bytes: written data for a write, response of the radio for a read
+ */
+typedef enum radio_hal_trace_type_e
+{
+    RADIO_HAL_TRACE_WRITE       = 0x01,  //!< Command and data sent to the radio
+    RADIO_HAL_TRACE_READ        = 0x02,  //!< Command sent to the radio and its response
+    RADIO_HAL_TRACE_DIRECT_READ = 0x03,  //!< Response read without command (lr11xx only)
+    RADIO_HAL_TRACE_RESET       = 0x04,  //!< Hardware reset of the radio
+    RADIO_HAL_TRACE_IRQ         = 0x05,  //!< Rising edge on the radio irq line
+    RADIO_HAL_TRACE_MARKER      = 0x06,  //!< Application event, its content is defined by the application
+} radio_hal_trace_type_t;
+
+/*!
+ * Traffic counters of the radio hal
+ */
+typedef struct radio_hal_trace_stats_s
+{
+    uint32_t nb_transactions;     //!< Spi transactions: writes, reads and direct reads
+    uint32_t nb_bytes_out;        //!< Command and data bytes sent to the radio
+    uint32_t nb_bytes_in;         //!< Response bytes received from the radio
+    uint32_t nb_irqs;             //!< Radio irqs
+    uint32_t nb_dropped_records;  //!< Records lost because the buffer was full
+} radio_hal_trace_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Appends a record to the trace and updates the counters
+ *
+ * \remark The timestamp is taken by the function: call it once the transaction is completed. It can be called from
+ * an interrupt handler.
+ *
+ * \param [in] type           Record type
+ * \param [in] command        Command bytes, can be NULL if command_length is 0
+ * \param [in] command_length Number of command bytes
+ * \param [in] data           Data bytes, can be NULL if data_length is 0
+ * \param [in] data_length    Number of data bytes
+ */
+void radio_hal_trace_record( const radio_hal_trace_type_t type, const uint8_t* command, const uint16_t command_length,
+                             const uint8_t* data, const uint16_t data_length );
+
+/*!
+ * Gets the records not yet flushed
+ *
+ * \param [out] size Number of bytes, the header included if nothing has been flushed yet
+ *
+ * \retval Pointer to the first byte
+ */
+const uint8_t* radio_hal_trace_get_buffer( uint32_t* size );
+
+/*!
+ * Prints the records not yet flushed in hexadecimal and removes them from the buffer
+ *
+ * \remark Every line starts with RADIO_HAL_TRACE_LINE_PREFIX. Concatenating the lines of all flushes gives the binary
+ * trace, e.g. grep "^RHT:" log.txt | cut -c5- | xxd -r -p > radio_hal_trace.bin
+ */
+void radio_hal_trace_flush( void );
+
+/*!
+ * Discards the records not yet flushed
+ */
+void radio_hal_trace_clear( void );
+
+/*!
+ * Gets the traffic counters
+ *
+ * \param [out] stats Counters since the start or the last call to radio_hal_trace_reset_stats
+ */
+void radio_hal_trace_get_stats( radio_hal_trace_stats_t* stats );
+
+/*!
+ * Resets the traffic counters
+ */
+void radio_hal_trace_reset_stats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __RADIO_HAL_TRACE_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,125 @@
+/*!
+ * \file      ral_sim_bsp.c
+ *
+ * \brief     Implements the BSP (BoardSpecificPackage) HAL functions for the simulated radio
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "ral_sim.h"
+#include "ral_sim_bsp.h"
+#include "ral_sim_medium.h"
+#include "smtc_hal_dbg_trace.h"
+#include "smtc_hal_gpio.h"
+#include "smtc_hal_lp_timer.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * End of the ongoing radio operation, raise the radio irq line if needed
+ */
+static void ral_sim_bsp_on_radio_timer( void* context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void ral_sim_bsp_schedule_irq( const void* context, const uint32_t delay_in_ms )
+{
+    hal_lp_timer_start( HAL_LP_TIMER_ID_RADIO, delay_in_ms,
+                        &( hal_lp_timer_irq_t ){ .context = ( void* ) context, .callback = ral_sim_bsp_on_radio_timer } );
+}
+
+void ral_sim_bsp_cancel_irq( const void* context )
+{
+    hal_lp_timer_stop( HAL_LP_TIMER_ID_RADIO );
+}
+
+void ral_sim_bsp_transmit( const void* context, const uint8_t* buffer, const uint16_t size_in_bytes,
+                           const uint32_t time_on_air_in_ms )
+{
+    const ral_sim_t* sim = ( const ral_sim_t* ) context;
+
+    SMTC_HAL_TRACE_PRINTF( "SIM TX: %u Hz, %d dBm, %u bytes, %u ms\n", sim->rf_freq_in_hz, sim->output_pwr_in_dbm,
+                           size_in_bytes, time_on_air_in_ms );
+    ral_sim_medium_transmit( sim, buffer, size_in_bytes, time_on_air_in_ms );
+}
+
+bool ral_sim_bsp_receive( const void* context, const uint32_t rx_window_in_ms, uint32_t* rx_done_delay_in_ms )
+{
+    // Without a gateway on the medium, every reception window times out
+    return ral_sim_medium_receive( ( const ral_sim_t* ) context, rx_window_in_ms, rx_done_delay_in_ms );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void ral_sim_bsp_on_radio_timer( void* context )
+{
+    if( ral_sim_process_irq( context ) == true )
+    {
+        hal_gpio_set_pending_irq( RADIO_DIOX );
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,292 @@
+/*!
+ * \file      ral_sim_medium.c
+ *
+ * \brief     Shared radio medium of the simulated radios: frames on air, collisions and virtual gateway hook
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>   // NULL
+#include <string.h>
+
+#include "ral_sim_medium.h"
+#include "smtc_hal_rtc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static ral_sim_medium_frame_t uplinks[RAL_SIM_MEDIUM_NB_UPLINKS];
+static uint8_t                nb_uplinks;
+
+static ral_sim_medium_frame_t downlinks[RAL_SIM_MEDIUM_NB_DOWNLINKS];
+static uint8_t                nb_downlinks;
+
+static ral_sim_medium_stats_t medium_stats;
+
+static void ( *gateway_on_uplink )( const ral_sim_medium_frame_t* frame ) = NULL;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * Checks whether two frames share the same channel and spreading factor
+ */
+static bool ral_sim_medium_is_same_channel( const ral_sim_medium_frame_t* frame_1,
+                                            const ral_sim_medium_frame_t* frame_2 );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void ral_sim_medium_init( void )
+{
+    nb_uplinks   = 0;
+    nb_downlinks = 0;
+    memset( &medium_stats, 0, sizeof( medium_stats ) );
+}
+
+void ral_sim_medium_set_gateway( void ( *on_uplink )( const ral_sim_medium_frame_t* frame ) )
+{
+    gateway_on_uplink = on_uplink;
+}
+
+void ral_sim_medium_transmit( const ral_sim_t* sim, const uint8_t* buffer, const uint16_t size_in_bytes,
+                              const uint32_t time_on_air_in_ms )
+{
+    if( sim->pkt_type != RAL_PKT_TYPE_LORA )
+    {
+        return;
+    }
+
+    // Frames which ended before this one are handed over first
+    ral_sim_medium_process( );
+
+    medium_stats.nb_uplinks++;
+    if( nb_uplinks >= RAL_SIM_MEDIUM_NB_UPLINKS )
+    {
+        medium_stats.nb_dropped_uplinks++;
+        return;
+    }
+
+    ral_sim_medium_frame_t* frame = &uplinks[nb_uplinks++];
+
+    frame->sender          = sim;
+    frame->rf_freq_in_hz   = sim->rf_freq_in_hz;
+    frame->sf              = sim->lora_mod_params.sf;
+    frame->bw              = sim->lora_mod_params.bw;
+    frame->invert_iq_is_on = sim->lora_pkt_params.invert_iq_is_on;
+    frame->start_time_us   = hal_rtc_get_time_us( );
+    frame->end_time_us     = frame->start_time_us + ( ( uint64_t ) time_on_air_in_ms * 1000 );
+    frame->is_collided     = false;
+    frame->size_in_bytes   = size_in_bytes;
+    memcpy( frame->payload, buffer, size_in_bytes );
+
+    // No capture effect: every overlapping frame on the same channel is lost
+    for( uint8_t i = 0; i < ( nb_uplinks - 1 ); i++ )
+    {
+        if( ( uplinks[i].end_time_us > frame->start_time_us ) &&
+            ( ral_sim_medium_is_same_channel( &uplinks[i], frame ) == true ) )
+        {
+            uplinks[i].is_collided = true;
+            frame->is_collided     = true;
+        }
+    }
+}
+
+void ral_sim_medium_schedule_downlink( const ral_sim_medium_frame_t* frame )
+{
+    if( nb_downlinks >= RAL_SIM_MEDIUM_NB_DOWNLINKS )
+    {
+        return;
+    }
+    downlinks[nb_downlinks++] = *frame;
+    medium_stats.nb_downlinks++;
+}
+
+bool ral_sim_medium_receive( const ral_sim_t* sim, const uint32_t rx_window_in_ms, uint32_t* rx_done_delay_in_ms )
+{
+    const uint64_t          now_us = hal_rtc_get_time_us( );
+    ral_sim_medium_frame_t* found  = NULL;
+    uint64_t                late_opening_in_us;
+
+    if( sim->pkt_type != RAL_PKT_TYPE_LORA )
+    {
+        return false;
+    }
+
+    late_opening_in_us = ( uint64_t ) RAL_SIM_MEDIUM_RX_LATE_OPENING_IN_SYMB *
+                         ral_sim_get_lora_symb_time_in_us( &sim->lora_mod_params );
+
+    for( uint8_t i = 0; i < nb_downlinks; i++ )
+    {
+        ral_sim_medium_frame_t* frame = &downlinks[i];
+
+        if( ( frame->rf_freq_in_hz != sim->rf_freq_in_hz ) || ( frame->sf != sim->lora_mod_params.sf ) ||
+            ( frame->bw != sim->lora_mod_params.bw ) ||
+            ( frame->invert_iq_is_on != sim->lora_pkt_params.invert_iq_is_on ) )
+        {
+            continue;
+        }
+        // The preamble must be detected during the window
+        if( ( ( frame->start_time_us + late_opening_in_us ) < now_us ) ||
+            ( ( rx_window_in_ms != RAL_RX_TIMEOUT_CONTINUOUS_MODE ) &&
+              ( frame->start_time_us > ( now_us + ( ( uint64_t ) rx_window_in_ms * 1000 ) ) ) ) )
+        {
+            continue;
+        }
+        if( ( found == NULL ) || ( frame->start_time_us < found->start_time_us ) )
+        {
+            found = frame;
+        }
+    }
+
+    if( found == NULL )
+    {
+        return false;
+    }
+
+    ral_sim_load_rx_frame( sim, found->payload, found->size_in_bytes, RAL_SIM_MEDIUM_DOWNLINK_RSSI_IN_DBM,
+                           RAL_SIM_MEDIUM_DOWNLINK_SNR_IN_DB );
+    *rx_done_delay_in_ms = ( uint32_t )( ( found->end_time_us - now_us + 999 ) / 1000 );
+    medium_stats.nb_received_downlinks++;
+    return true;
+}
+
+bool ral_sim_medium_get_next_event_time_us( uint64_t* time_us )
+{
+    bool is_pending = false;
+
+    for( uint8_t i = 0; i < nb_uplinks; i++ )
+    {
+        if( ( is_pending == false ) || ( uplinks[i].end_time_us < *time_us ) )
+        {
+            *time_us   = uplinks[i].end_time_us;
+            is_pending = true;
+        }
+    }
+    for( uint8_t i = 0; i < nb_downlinks; i++ )
+    {
+        if( ( is_pending == false ) || ( downlinks[i].end_time_us < *time_us ) )
+        {
+            *time_us   = downlinks[i].end_time_us;
+            is_pending = true;
+        }
+    }
+    return is_pending;
+}
+
+void ral_sim_medium_process( void )
+{
+    const uint64_t now_us = hal_rtc_get_time_us( );
+    uint8_t        i      = 0;
+
+    while( i < nb_uplinks )
+    {
+        if( uplinks[i].end_time_us > now_us )
+        {
+            i++;
+            continue;
+        }
+
+        ral_sim_medium_frame_t frame = uplinks[i];
+
+        // Remove the frame before the gateway is called, it may transmit
+        uplinks[i] = uplinks[--nb_uplinks];
+        if( frame.is_collided == true )
+        {
+            medium_stats.nb_collided_uplinks++;
+        }
+        if( gateway_on_uplink != NULL )
+        {
+            gateway_on_uplink( &frame );
+        }
+    }
+
+    i = 0;
+    while( i < nb_downlinks )
+    {
+        if( downlinks[i].end_time_us <= now_us )
+        {
+            downlinks[i] = downlinks[--nb_downlinks];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void ral_sim_medium_get_stats( ral_sim_medium_stats_t* stats )
+{
+    *stats = medium_stats;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool ral_sim_medium_is_same_channel( const ral_sim_medium_frame_t* frame_1,
+                                            const ral_sim_medium_frame_t* frame_2 )
+{
+    return ( ( frame_1->rf_freq_in_hz == frame_2->rf_freq_in_hz ) && ( frame_1->sf == frame_2->sf ) &&
+             ( frame_1->bw == frame_2->bw ) )
+               ? true
+               : false;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,197 @@
+/*!
+ * \file      ral_sim_medium.h
+ *
+ * \brief     Shared radio medium of the simulated radios: frames on air, collisions and virtual gateway hook
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __RAL_SIM_MEDIUM_H__
+#define __RAL_SIM_MEDIUM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+#include "ral_sim.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Maximum number of uplinks simultaneously on air, the following ones are lost
+ */
+#ifndef RAL_SIM_MEDIUM_NB_UPLINKS
+#define RAL_SIM_MEDIUM_NB_UPLINKS 64
+#endif
+
+/*!
+ * Maximum number of downlinks scheduled by the gateway and not yet completed
+ */
+#ifndef RAL_SIM_MEDIUM_NB_DOWNLINKS
+#define RAL_SIM_MEDIUM_NB_DOWNLINKS 16
+#endif
+
+/*!
+ * Signal quality reported to the devices receiving a downlink
+ */
+#define RAL_SIM_MEDIUM_DOWNLINK_RSSI_IN_DBM -80
+#define RAL_SIM_MEDIUM_DOWNLINK_SNR_IN_DB 10
+
+/*!
+ * Number of preamble symbols a reception window may miss and still detect the downlink
+ */
+#define RAL_SIM_MEDIUM_RX_LATE_OPENING_IN_SYMB 4
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * LoRa frame on the simulated air
+ */
+typedef struct ral_sim_medium_frame_s
+{
+    const void*   sender;  //!< Radio context of the transmitting device, NULL for the gateway
+    uint32_t      rf_freq_in_hz;
+    ral_lora_sf_t sf;
+    ral_lora_bw_t bw;
+    bool          invert_iq_is_on;
+    uint64_t      start_time_us;
+    uint64_t      end_time_us;
+    bool          is_collided;  //!< Another frame overlapped it on the same channel and spreading factor
+    uint16_t      size_in_bytes;
+    uint8_t       payload[RAL_SIM_BUFFER_SIZE_IN_BYTES];
+} ral_sim_medium_frame_t;
+
+/*!
+ * Traffic counters of the simulated air
+ */
+typedef struct ral_sim_medium_stats_s
+{
+    uint32_t nb_uplinks;             //!< Uplinks transmitted by the devices
+    uint32_t nb_collided_uplinks;    //!< Uplinks lost because of a collision
+    uint32_t nb_dropped_uplinks;     //!< Uplinks lost because too many frames were on air
+    uint32_t nb_downlinks;           //!< Downlinks transmitted by the gateway
+    uint32_t nb_received_downlinks;  //!< Downlinks caught in a reception window
+} ral_sim_medium_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Empties the air and resets the counters
+ */
+void ral_sim_medium_init( void );
+
+/*!
+ * Sets the gateway listening to the uplinks
+ *
+ * \param [in] on_uplink Called at the end of every uplink, collided or not. NULL if nobody listens.
+ */
+void ral_sim_medium_set_gateway( void ( *on_uplink )( const ral_sim_medium_frame_t* frame ) );
+
+/*!
+ * Puts a frame transmitted by a simulated radio on air
+ *
+ * \remark Only LoRa frames are propagated, the other modulations reach nobody.
+ *
+ * \param [in] sim               Transmitting radio, its configuration is the one of the frame
+ * \param [in] buffer            Frame being transmitted
+ * \param [in] size_in_bytes     Size of the frame
+ * \param [in] time_on_air_in_ms Duration of the transmission, starting now
+ */
+void ral_sim_medium_transmit( const ral_sim_t* sim, const uint8_t* buffer, const uint16_t size_in_bytes,
+                              const uint32_t time_on_air_in_ms );
+
+/*!
+ * Schedules a downlink from the gateway
+ *
+ * \param [in] frame Downlink to be transmitted, start and end times set
+ */
+void ral_sim_medium_schedule_downlink( const ral_sim_medium_frame_t* frame );
+
+/*!
+ * Looks for a downlink matching a reception window which opens now, and loads it in the radio if any
+ *
+ * \param [in]  sim                 Receiving radio, its configuration is the one of the window
+ * \param [in]  rx_window_in_ms     Duration of the window, RAL_RX_TIMEOUT_CONTINUOUS_MODE if not bounded
+ * \param [out] rx_done_delay_in_ms Delay from now to the end of the received downlink
+ *
+ * \retval true if a downlink has been loaded, false otherwise
+ */
+bool ral_sim_medium_receive( const ral_sim_t* sim, const uint32_t rx_window_in_ms, uint32_t* rx_done_delay_in_ms );
+
+/*!
+ * Gets the time of the next end of frame on air
+ *
+ * \param [out] time_us Virtual time of the next event, in microseconds
+ *
+ * \retval true if a frame is on air or scheduled, false otherwise
+ */
+bool ral_sim_medium_get_next_event_time_us( uint64_t* time_us );
+
+/*!
+ * Hands the completed uplinks to the gateway and removes the completed frames from the air
+ */
+void ral_sim_medium_process( void );
+
+/*!
+ * Gets the traffic counters
+ *
+ * \param [out] stats Counters since ral_sim_medium_init
+ */
+void ral_sim_medium_get_stats( ral_sim_medium_stats_t* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __RAL_SIM_MEDIUM_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -47,6 +47,10 @@
 #include "smtc_hal_mcu.h"
 #include "modem_pinout.h"
 
+#if defined( RADIO_HAL_TRACE )
+#include "radio_hal_trace.h"
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE MACROS-----------------------------------------------------------
@@ -103,17 +107,15 @@ sx128x_hal_status_t sx128x_hal_write( const void* context, const uint8_t* comman
 
     // Put NSS low to start spi transaction
     hal_gpio_set_value( RADIO_NSS, 0 );
-    for( uint16_t i = 0; i < command_length; i++ )
-    {
-        hal_spi_in_out( RADIO_SPI_ID, command[i] );
-    }
-    for( uint16_t i = 0; i < data_length; i++ )
-    {
-        hal_spi_in_out( RADIO_SPI_ID, data[i] );
-    }
+    hal_spi_transfer( RADIO_SPI_ID, command, NULL, command_length );
+    hal_spi_transfer( RADIO_SPI_ID, data, NULL, data_length );
     // Put NSS high as the spi transaction is finished
     hal_gpio_set_value( RADIO_NSS, 1 );
 
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_WRITE, command, command_length, data, data_length );
+#endif
+
     // 0x84 - SX128X_SET_SLEEP opcode. In sleep mode the radio dio is struck to 1 => do not test it
     if( command[0] != 0x84 )
     {
@@ -134,17 +136,15 @@ sx128x_hal_status_t sx128x_hal_read( const void* context, const uint8_t* command
 
     // Put NSS low to start spi transaction
     hal_gpio_set_value( RADIO_NSS, 0 );
-    for( uint16_t i = 0; i < command_length; i++ )
-    {
-        hal_spi_in_out( RADIO_SPI_ID, command[i] );
-    }
-    for( uint16_t i = 0; i < data_length; i++ )
-    {
-        data[i] = hal_spi_in_out( RADIO_SPI_ID, 0 );
-    }
+    hal_spi_transfer( RADIO_SPI_ID, command, NULL, command_length );
+    hal_spi_transfer( RADIO_SPI_ID, NULL, data, data_length );
     // Put NSS high as the spi transaction is finished
     hal_gpio_set_value( RADIO_NSS, 1 );
 
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_READ, command, command_length, data, data_length );
+#endif
+
     return SX128X_HAL_STATUS_OK;
 }
 
@@ -155,6 +155,9 @@ sx128x_hal_status_t sx128x_hal_reset( const void* context )
     hal_gpio_set_value( RADIO_NRST, 1 );
     hal_mcu_wait_us( 5000 );
     radio_mode = RADIO_AWAKE;
+#if defined( RADIO_HAL_TRACE )
+    radio_hal_trace_record( RADIO_HAL_TRACE_RESET, NULL, 0, NULL, 0 );
+#endif
     return SX128X_HAL_STATUS_OK;
 }
 
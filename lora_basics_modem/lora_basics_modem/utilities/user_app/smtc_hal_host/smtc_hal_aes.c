@@ -0,0 +1,192 @@
+/*!
+ * \file      smtc_hal_aes.c
+ *
+ * \brief     AES accelerator Hardware Abstraction Layer implementation for host builds (OpenSSL)
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>   // NULL
+
+#include <openssl/evp.h>
+#include <openssl/core_names.h>
+
+#include "smtc_hal_aes.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+// Fetched once and kept for the whole run: OpenSSL uses AES-NI when the cpu has it
+static EVP_CIPHER_CTX* aes_cipher_ctx;
+static EVP_CIPHER*     aes_ecb;
+static EVP_CIPHER*     aes_ctr;
+static EVP_MAC*        aes_cmac;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * Fetches the algorithms at first use
+ *
+ * \retval true if they are available
+ */
+static bool hal_aes_init( void );
+
+/*!
+ * Runs a cipher over a buffer
+ *
+ * \param [in] cipher AES-128 mode
+ * \param [in] key AES-128 key
+ * \param [in] iv Initial counter block, NULL for ECB
+ * \param [in] buffer Input buffer
+ * \param [in] size Input buffer size
+ * \param [out] enc_buffer Output buffer
+ *
+ * \retval true if the operation succeeded
+ */
+static bool hal_aes_cipher( const EVP_CIPHER* cipher, const uint8_t key[16], const uint8_t* iv,
+                            const uint8_t* buffer, uint16_t size, uint8_t* enc_buffer );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool hal_aes_ecb_encrypt( const uint8_t key[16], const uint8_t* buffer, uint16_t size, uint8_t* enc_buffer )
+{
+    if( ( hal_aes_init( ) == false ) || ( ( size % 16 ) != 0 ) )
+    {
+        return false;
+    }
+    return hal_aes_cipher( aes_ecb, key, NULL, buffer, size, enc_buffer );
+}
+
+bool hal_aes_ctr_encrypt( const uint8_t key[16], const uint8_t a_block[16], const uint8_t* buffer, uint16_t size,
+                          uint8_t* enc_buffer )
+{
+    if( hal_aes_init( ) == false )
+    {
+        return false;
+    }
+    return hal_aes_cipher( aes_ctr, key, a_block, buffer, size, enc_buffer );
+}
+
+bool hal_aes_cmac( const uint8_t key[16], const uint8_t* mic_bx_buffer, const uint8_t* buffer, uint16_t size,
+                   uint8_t cmac[16] )
+{
+    if( hal_aes_init( ) == false )
+    {
+        return false;
+    }
+
+    EVP_MAC_CTX* mac_ctx = EVP_MAC_CTX_new( aes_cmac );
+    OSSL_PARAM   params[] = { OSSL_PARAM_construct_utf8_string( OSSL_MAC_PARAM_CIPHER, "AES-128-CBC", 0 ),
+                            OSSL_PARAM_construct_end( ) };
+    size_t       cmac_size = 0;
+    bool         status    = ( mac_ctx != NULL ) && ( EVP_MAC_init( mac_ctx, key, 16, params ) == 1 );
+
+    if( ( status == true ) && ( mic_bx_buffer != NULL ) )
+    {
+        status = EVP_MAC_update( mac_ctx, mic_bx_buffer, 16 ) == 1;
+    }
+    if( status == true )
+    {
+        status = ( EVP_MAC_update( mac_ctx, buffer, size ) == 1 ) &&
+                 ( EVP_MAC_final( mac_ctx, cmac, &cmac_size, 16 ) == 1 ) && ( cmac_size == 16 );
+    }
+    EVP_MAC_CTX_free( mac_ctx );
+    return status;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool hal_aes_init( void )
+{
+    if( aes_cipher_ctx == NULL )
+    {
+        aes_cipher_ctx = EVP_CIPHER_CTX_new( );
+        aes_ecb        = EVP_CIPHER_fetch( NULL, "AES-128-ECB", NULL );
+        aes_ctr        = EVP_CIPHER_fetch( NULL, "AES-128-CTR", NULL );
+        aes_cmac       = EVP_MAC_fetch( NULL, "CMAC", NULL );
+    }
+    return ( aes_cipher_ctx != NULL ) && ( aes_ecb != NULL ) && ( aes_ctr != NULL ) && ( aes_cmac != NULL );
+}
+
+static bool hal_aes_cipher( const EVP_CIPHER* cipher, const uint8_t key[16], const uint8_t* iv,
+                            const uint8_t* buffer, uint16_t size, uint8_t* enc_buffer )
+{
+    int out_size   = 0;
+    int final_size = 0;
+
+    if( ( EVP_EncryptInit_ex2( aes_cipher_ctx, cipher, key, iv, NULL ) != 1 ) ||
+        ( EVP_CIPHER_CTX_set_padding( aes_cipher_ctx, 0 ) != 1 ) )
+    {
+        return false;
+    }
+    if( ( size != 0 ) && ( EVP_EncryptUpdate( aes_cipher_ctx, enc_buffer, &out_size, buffer, size ) != 1 ) )
+    {
+        return false;
+    }
+    if( EVP_EncryptFinal_ex( aes_cipher_ctx, &enc_buffer[out_size], &final_size ) != 1 )
+    {
+        return false;
+    }
+    return ( out_size + final_size ) == size;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
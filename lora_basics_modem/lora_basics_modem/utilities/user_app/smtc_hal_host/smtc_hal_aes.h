@@ -0,0 +1,116 @@
+/*!
+ * \file      smtc_hal_aes.h
+ *
+ * \brief     AES accelerator Hardware Abstraction Layer definition for host builds (OpenSSL)
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_HAL_AES_H__
+#define __SMTC_HAL_AES_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Encrypts blocks in AES-128 ECB mode
+ *
+ * \param [in] key AES-128 key
+ * \param [in] buffer Input buffer
+ * \param [in] size Input buffer size, a multiple of 16
+ * \param [out] enc_buffer Output buffer, same as buffer or disjoint from it
+ *
+ * \retval true if the operation succeeded
+ */
+bool hal_aes_ecb_encrypt( const uint8_t key[16], const uint8_t* buffer, uint16_t size, uint8_t* enc_buffer );
+
+/*!
+ * Encrypts or decrypts a buffer in AES-128 CTR mode, the counter block being a 128 bits big endian number
+ *
+ * \param [in] key AES-128 key
+ * \param [in] a_block Initial counter block
+ * \param [in] buffer Input buffer
+ * \param [in] size Input buffer size
+ * \param [out] enc_buffer Output buffer, same as buffer or disjoint from it
+ *
+ * \retval true if the operation succeeded
+ */
+bool hal_aes_ctr_encrypt( const uint8_t key[16], const uint8_t a_block[16], const uint8_t* buffer, uint16_t size,
+                          uint8_t* enc_buffer );
+
+/*!
+ * Computes the AES-128 CMAC of a message
+ *
+ * \param [in] key AES-128 key
+ * \param [in] mic_bx_buffer 16 bytes block put in front of the message, NULL if none
+ * \param [in] buffer Message
+ * \param [in] size Message size
+ * \param [out] cmac Computed cmac
+ *
+ * \retval true if the operation succeeded
+ */
+bool hal_aes_cmac( const uint8_t key[16], const uint8_t* mic_bx_buffer, const uint8_t* buffer, uint16_t size,
+                   uint8_t cmac[16] );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_HAL_AES_H__
+
+/* --- EOF ------------------------------------------------------------------ */
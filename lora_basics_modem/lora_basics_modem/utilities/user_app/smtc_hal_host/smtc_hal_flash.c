@@ -0,0 +1,195 @@
+/*!
+ * \file      smtc_hal_flash.c
+ *
+ * \brief     File-backed flash Hardware Abstraction Layer implementation for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stdio.h>
+#include <string.h>
+
+#include "smtc_hal_flash.h"
+#include "smtc_hal_mcu.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define FLASH_ERASED_BYTE 0xFF
+
+#define FLASH_SIZE ( FLASH_PAGE_NUMBER * ADDR_FLASH_PAGE_SIZE )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+typedef struct hal_flash_instance_s
+{
+    FILE*   flash_file;
+    bool    is_in_ram;  //!< Content kept in ram instead of flash_file
+    uint8_t ram[FLASH_SIZE];
+} hal_flash_instance_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+// Instance used as long as no other one is set with hal_flash_set_instance()
+static hal_flash_instance_t  flash_instance_default = { .flash_file = NULL, .is_in_ram = false };
+static hal_flash_instance_t* flash_instance         = &flash_instance_default;
+
+#define flash_file flash_instance->flash_file
+#define flash_is_in_ram flash_instance->is_in_ram
+#define flash_ram flash_instance->ram
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+uint32_t hal_flash_get_instance_size( void )
+{
+    return sizeof( hal_flash_instance_t );
+}
+
+void hal_flash_set_instance( void* instance )
+{
+    flash_instance = ( instance != NULL ) ? ( hal_flash_instance_t* ) instance : &flash_instance_default;
+}
+
+void hal_flash_init_in_ram( void )
+{
+    flash_is_in_ram = true;
+    memset( flash_ram, FLASH_ERASED_BYTE, FLASH_SIZE );
+}
+
+void hal_flash_init( void )
+{
+    if( ( flash_file != NULL ) || ( flash_is_in_ram == true ) )
+    {
+        return;
+    }
+
+    flash_file = fopen( HAL_FLASH_FILE_NAME, "r+b" );
+    if( flash_file == NULL )
+    {
+        flash_file = fopen( HAL_FLASH_FILE_NAME, "w+b" );
+        if( flash_file == NULL )
+        {
+            mcu_panic( "Cannot open %s\n", HAL_FLASH_FILE_NAME );
+            return;
+        }
+        hal_flash_erase_page( FLASH_PAGE_ADDR( 0 ), FLASH_PAGE_NUMBER );
+    }
+}
+
+uint8_t hal_flash_erase_page( uint32_t addr, uint8_t nb_page )
+{
+    uint8_t erased_page[ADDR_FLASH_PAGE_SIZE];
+    uint8_t nb_erased_page = 0;
+
+    memset( erased_page, FLASH_ERASED_BYTE, sizeof( erased_page ) );
+
+    // Align on the page holding the given address, as the hardware does
+    addr -= addr % ADDR_FLASH_PAGE_SIZE;
+    while( ( nb_erased_page < nb_page ) && ( ( addr + ADDR_FLASH_PAGE_SIZE ) <= FLASH_SIZE ) )
+    {
+        hal_flash_write_buffer( addr, erased_page, ADDR_FLASH_PAGE_SIZE );
+        addr += ADDR_FLASH_PAGE_SIZE;
+        nb_erased_page++;
+    }
+    return nb_erased_page;
+}
+
+uint32_t hal_flash_write_buffer( uint32_t addr, const uint8_t* buffer, uint32_t size )
+{
+    if( ( ( flash_file == NULL ) && ( flash_is_in_ram == false ) ) || ( ( addr + size ) > FLASH_SIZE ) )
+    {
+        mcu_panic( "Flash write out of range: 0x%08x, %u bytes\n", addr, size );
+        return 0;
+    }
+    if( flash_is_in_ram == true )
+    {
+        memcpy( &flash_ram[addr], buffer, size );
+        return size;
+    }
+    if( ( fseek( flash_file, ( long ) addr, SEEK_SET ) != 0 ) ||
+        ( fwrite( buffer, 1, size, flash_file ) != size ) || ( fflush( flash_file ) != 0 ) )
+    {
+        mcu_panic( "Flash write failed\n" );
+        return 0;
+    }
+    return size;
+}
+
+void hal_flash_read_buffer( uint32_t addr, uint8_t* buffer, uint32_t size )
+{
+    if( ( ( flash_file == NULL ) && ( flash_is_in_ram == false ) ) || ( ( addr + size ) > FLASH_SIZE ) )
+    {
+        mcu_panic( "Flash read out of range: 0x%08x, %u bytes\n", addr, size );
+        return;
+    }
+    if( flash_is_in_ram == true )
+    {
+        memcpy( buffer, &flash_ram[addr], size );
+        return;
+    }
+    if( ( fseek( flash_file, ( long ) addr, SEEK_SET ) != 0 ) || ( fread( buffer, 1, size, flash_file ) != size ) )
+    {
+        mcu_panic( "Flash read failed\n" );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,146 @@
+/*!
+ * \file      smtc_hal_flash.h
+ *
+ * \brief     File-backed flash Hardware Abstraction Layer definition for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_HAL_FLASH_H__
+#define __SMTC_HAL_FLASH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * File holding the content of the simulated flash, kept between two runs
+ */
+#ifndef HAL_FLASH_FILE_NAME
+#define HAL_FLASH_FILE_NAME "basic_modem_nvm.bin"
+#endif
+
+#define ADDR_FLASH_PAGE_SIZE ( ( uint32_t ) 0x00000800 ) /* Size of Page = 2 Kbytes */
+#define FLASH_PAGE_NUMBER 8
+
+#define FLASH_PAGE_ADDR( page ) ( ( page ) *ADDR_FLASH_PAGE_SIZE )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Opens the file backing the simulated flash, creating an erased one if needed
+ */
+void hal_flash_init( void );
+
+/*!
+ * Gets the size of the memory holding the flash content of one simulated device
+ *
+ * \retval Size in bytes
+ */
+uint32_t hal_flash_get_instance_size( void );
+
+/*!
+ * Sets the memory holding the flash content used by all the following calls
+ *
+ * \remark The memory must have been zeroed before its first use
+ *
+ * \param [in] instance Pointer to hal_flash_get_instance_size() bytes, NULL for the built-in instance
+ */
+void hal_flash_set_instance( void* instance );
+
+/*!
+ * Initializes a flash kept in RAM only, fully erased, instead of the nvm file
+ *
+ * \remark Used by the simulation of several devices, each one having its own flash instance.
+ */
+void hal_flash_init_in_ram( void );
+
+/*!
+ * Erases the given flash area
+ *
+ * \param [in] addr     Address of the first page to be erased
+ * \param [in] nb_page  Number of pages to be erased
+ *
+ * \retval status       Number of erased pages
+ */
+uint8_t hal_flash_erase_page( uint32_t addr, uint8_t nb_page );
+
+/*!
+ * Writes the given buffer to the flash memory
+ *
+ * \param [in] addr     Flash address
+ * \param [in] buffer   Pointer to the buffer to be written
+ * \param [in] size     Size of the buffer to be written
+ *
+ * \retval status       Number of written bytes
+ */
+uint32_t hal_flash_write_buffer( uint32_t addr, const uint8_t* buffer, uint32_t size );
+
+/*!
+ * Reads the flash memory into the given buffer
+ *
+ * \param [in] addr     Flash address
+ * \param [out] buffer  Pointer to the buffer to be filled
+ * \param [in] size     Size of the buffer to be read
+ */
+void hal_flash_read_buffer( uint32_t addr, uint8_t* buffer, uint32_t size );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_HAL_FLASH_H__
+
+/* --- EOF ------------------------------------------------------------------ */
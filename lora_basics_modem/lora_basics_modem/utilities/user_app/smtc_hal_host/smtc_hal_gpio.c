@@ -0,0 +1,169 @@
+/*!
+ * \file      smtc_hal_gpio.c
+ *
+ * \brief     Virtual GPIO Hardware Abstraction Layer implementation for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>
+
+#include "smtc_hal_gpio.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+typedef struct hal_gpio_instance_s
+{
+    hal_gpio_irq_t gpio_irq[HAL_GPIO_PIN_NB];  //!< Copy of the attached irq, callback is NULL if none
+    bool           gpio_irq_is_pending[HAL_GPIO_PIN_NB];
+    bool           gpio_irq_is_enabled;
+} hal_gpio_instance_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+// Instance used as long as no other one is set with hal_gpio_set_instance()
+static hal_gpio_instance_t  gpio_instance_default = { .gpio_irq_is_enabled = true };
+static hal_gpio_instance_t* gpio_instance         = &gpio_instance_default;
+
+#define gpio_irq gpio_instance->gpio_irq
+#define gpio_irq_is_pending gpio_instance->gpio_irq_is_pending
+#define gpio_irq_is_enabled gpio_instance->gpio_irq_is_enabled
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * Calls the callbacks of the pending interrupts
+ */
+static void hal_gpio_process_pending_irq( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+uint32_t hal_gpio_get_instance_size( void )
+{
+    return sizeof( hal_gpio_instance_t );
+}
+
+void hal_gpio_set_instance( void* instance )
+{
+    gpio_instance = ( instance != NULL ) ? ( hal_gpio_instance_t* ) instance : &gpio_instance_default;
+}
+
+void hal_gpio_irq_attach( const hal_gpio_irq_t* irq )
+{
+    if( ( irq != NULL ) && ( irq->pin < HAL_GPIO_PIN_NB ) )
+    {
+        gpio_irq[irq->pin] = *irq;
+    }
+}
+
+void hal_gpio_irq_deatach( const hal_gpio_irq_t* irq )
+{
+    if( ( irq != NULL ) && ( irq->pin < HAL_GPIO_PIN_NB ) )
+    {
+        gpio_irq[irq->pin].callback = NULL;
+    }
+}
+
+void hal_gpio_irq_enable( void )
+{
+    gpio_irq_is_enabled = true;
+    hal_gpio_process_pending_irq( );
+}
+
+void hal_gpio_irq_disable( void )
+{
+    gpio_irq_is_enabled = false;
+}
+
+void hal_gpio_clear_pending_irq( const hal_gpio_pin_names_t pin )
+{
+    gpio_irq_is_pending[pin] = false;
+}
+
+void hal_gpio_set_pending_irq( const hal_gpio_pin_names_t pin )
+{
+    gpio_irq_is_pending[pin] = true;
+    hal_gpio_process_pending_irq( );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void hal_gpio_process_pending_irq( void )
+{
+    if( gpio_irq_is_enabled == false )
+    {
+        return;
+    }
+
+    for( uint8_t pin = 0; pin < HAL_GPIO_PIN_NB; pin++ )
+    {
+        if( gpio_irq_is_pending[pin] == true )
+        {
+            gpio_irq_is_pending[pin] = false;
+            if( gpio_irq[pin].callback != NULL )
+            {
+                gpio_irq[pin].callback( gpio_irq[pin].context );
+            }
+        }
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
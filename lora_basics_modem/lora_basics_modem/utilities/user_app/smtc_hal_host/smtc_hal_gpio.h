@@ -0,0 +1,153 @@
+/*!
+ * \file      smtc_hal_gpio.h
+ *
+ * \brief     Virtual GPIO Hardware Abstraction Layer definition for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_HAL_GPIO_H__
+#define __SMTC_HAL_GPIO_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * Virtual interrupt lines available on the host
+ */
+typedef enum hal_gpio_pin_names_e
+{
+    RADIO_DIOX,  //!< Simulated radio irq line
+    HAL_GPIO_PIN_NB,
+} hal_gpio_pin_names_t;
+
+/*!
+ * GPIO IRQ data context
+ */
+typedef struct hal_gpio_irq_s
+{
+    hal_gpio_pin_names_t pin;
+    void*                context;
+    void ( *callback )( void* context );
+} hal_gpio_irq_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Gets the size of the memory holding the interrupt lines state of one simulated device
+ *
+ * \retval Size in bytes
+ */
+uint32_t hal_gpio_get_instance_size( void );
+
+/*!
+ * Sets the memory holding the interrupt lines state used by all the following calls
+ *
+ * \remark The memory must have been zeroed before its first use
+ *
+ * \param [in] instance Pointer to hal_gpio_get_instance_size() bytes, NULL for the built-in instance
+ */
+void hal_gpio_set_instance( void* instance );
+
+/*!
+ * Attaches the given callback to the GPIO interrupt
+ *
+ * \remark The IRQ data context is copied, it does not need to outlive the call.
+ *
+ * \param [in] irq Pointer to IRQ data context.
+ */
+void hal_gpio_irq_attach( const hal_gpio_irq_t* irq );
+
+/*!
+ * Detaches callback from the GPIO interrupt
+ *
+ * \param [in] irq Pointer to IRQ data context.
+ */
+void hal_gpio_irq_deatach( const hal_gpio_irq_t* irq );
+
+/*!
+ * Enables all GPIO MCU interrupts, raising the ones which are pending
+ */
+void hal_gpio_irq_enable( void );
+
+/*!
+ * Disables all GPIO MCU interrupts
+ */
+void hal_gpio_irq_disable( void );
+
+/*!
+ * Clears a pending interrupt
+ *
+ * \param [in] pin MCU IRQ pin name
+ */
+void hal_gpio_clear_pending_irq( const hal_gpio_pin_names_t pin );
+
+/*!
+ * Raises an interrupt on the given line
+ *
+ * \remark The callback is called immediately if interrupts are enabled, otherwise the interrupt stays pending.
+ *
+ * \param [in] pin MCU IRQ pin name
+ */
+void hal_gpio_set_pending_irq( const hal_gpio_pin_names_t pin );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_HAL_GPIO_H__
+
+/* --- EOF ------------------------------------------------------------------ */
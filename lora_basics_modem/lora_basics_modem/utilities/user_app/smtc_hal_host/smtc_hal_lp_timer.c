@@ -0,0 +1,179 @@
+/*!
+ * \file      smtc_hal_lp_timer.c
+ *
+ * \brief     Virtual timer Hardware Abstraction Layer implementation for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>   // NULL
+
+#include "smtc_hal_lp_timer.h"
+#include "smtc_hal_rtc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+typedef struct hal_lp_timer_s
+{
+    bool               is_running;
+    uint64_t           expiry_time_us;
+    hal_lp_timer_irq_t tmr_irq;
+} hal_lp_timer_t;
+
+typedef struct hal_lp_timer_instance_s
+{
+    hal_lp_timer_t lp_timers[HAL_LP_TIMER_ID_NB];
+    bool           lp_timer_irq_is_enabled;
+} hal_lp_timer_instance_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+// Instance used as long as no other one is set with hal_lp_timer_set_instance()
+static hal_lp_timer_instance_t  lp_timer_instance_default = { .lp_timer_irq_is_enabled = true };
+static hal_lp_timer_instance_t* lp_timer_instance         = &lp_timer_instance_default;
+
+#define lp_timers lp_timer_instance->lp_timers
+#define lp_timer_irq_is_enabled lp_timer_instance->lp_timer_irq_is_enabled
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+uint32_t hal_lp_timer_get_instance_size( void )
+{
+    return sizeof( hal_lp_timer_instance_t );
+}
+
+void hal_lp_timer_set_instance( void* instance )
+{
+    lp_timer_instance = ( instance != NULL ) ? ( hal_lp_timer_instance_t* ) instance : &lp_timer_instance_default;
+}
+
+void hal_lp_timer_init( void )
+{
+    for( uint8_t i = 0; i < HAL_LP_TIMER_ID_NB; i++ )
+    {
+        lp_timers[i] = ( hal_lp_timer_t ){ .is_running = false, .expiry_time_us = 0, .tmr_irq = { NULL, NULL } };
+    }
+    lp_timer_irq_is_enabled = true;
+}
+
+void hal_lp_timer_start( const hal_lp_timer_id_t id, const uint32_t milliseconds, const hal_lp_timer_irq_t* tmr_irq )
+{
+    lp_timers[id].expiry_time_us = hal_rtc_get_time_us( ) + ( ( uint64_t ) milliseconds * 1000 );
+    lp_timers[id].tmr_irq        = *tmr_irq;
+    lp_timers[id].is_running     = true;
+}
+
+void hal_lp_timer_stop( const hal_lp_timer_id_t id )
+{
+    lp_timers[id].is_running = false;
+}
+
+void hal_lp_timer_irq_enable( void )
+{
+    lp_timer_irq_is_enabled = true;
+}
+
+void hal_lp_timer_irq_disable( void )
+{
+    lp_timer_irq_is_enabled = false;
+}
+
+bool hal_lp_timer_get_next_expiry_time_us( uint64_t* expiry_time_us )
+{
+    bool is_running = false;
+
+    for( uint8_t i = 0; i < HAL_LP_TIMER_ID_NB; i++ )
+    {
+        if( ( lp_timers[i].is_running == true ) &&
+            ( ( is_running == false ) || ( lp_timers[i].expiry_time_us < *expiry_time_us ) ) )
+        {
+            *expiry_time_us = lp_timers[i].expiry_time_us;
+            is_running      = true;
+        }
+    }
+    return is_running;
+}
+
+void hal_lp_timer_process( void )
+{
+    if( lp_timer_irq_is_enabled == false )
+    {
+        return;
+    }
+
+    for( uint8_t i = 0; i < HAL_LP_TIMER_ID_NB; i++ )
+    {
+        if( ( lp_timers[i].is_running == true ) && ( lp_timers[i].expiry_time_us <= hal_rtc_get_time_us( ) ) )
+        {
+            lp_timers[i].is_running = false;
+            if( lp_timers[i].tmr_irq.callback != NULL )
+            {
+                lp_timers[i].tmr_irq.callback( lp_timers[i].tmr_irq.context );
+            }
+        }
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
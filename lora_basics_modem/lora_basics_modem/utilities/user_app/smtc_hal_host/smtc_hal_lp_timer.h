@@ -0,0 +1,156 @@
+/*!
+ * \file      smtc_hal_lp_timer.h
+ *
+ * \brief     Virtual timer Hardware Abstraction Layer definition for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_HAL_LP_TIMER_H__
+#define __SMTC_HAL_LP_TIMER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * Virtual timers available on the host
+ */
+typedef enum hal_lp_timer_id_e
+{
+    HAL_LP_TIMER_ID_MODEM,  //!< Timer used by the modem (smtc_modem_hal_start_timer)
+    HAL_LP_TIMER_ID_RADIO,  //!< Timer used by the simulated or replayed radio to complete its operations
+    HAL_LP_TIMER_ID_NB,
+} hal_lp_timer_id_t;
+
+/*!
+ * Timer IRQ handling data context
+ */
+typedef struct hal_lp_timer_irq_s
+{
+    void* context;
+    void ( *callback )( void* context );
+} hal_lp_timer_irq_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ *  Initializes the virtual timers
+ */
+void hal_lp_timer_init( void );
+
+/*!
+ * Gets the size of the memory holding the virtual timers of one simulated device
+ *
+ * \retval Size in bytes
+ */
+uint32_t hal_lp_timer_get_instance_size( void );
+
+/*!
+ * Sets the memory holding the virtual timers used by all the following calls
+ *
+ * \remark The memory must have been zeroed before its first use
+ *
+ * \param [in] instance Pointer to hal_lp_timer_get_instance_size() bytes, NULL for the built-in instance
+ */
+void hal_lp_timer_set_instance( void* instance );
+
+/*!
+ * Starts the provided timer objet for the given time
+ *
+ * \param [in] id           Timer to be started
+ * \param [in] milliseconds Number of milliseconds
+ * \param [in] tmr_irq      Timer IRQ handling data ontext
+ */
+void hal_lp_timer_start( const hal_lp_timer_id_t id, const uint32_t milliseconds, const hal_lp_timer_irq_t* tmr_irq );
+
+/*!
+ * Stops the provided timer
+ *
+ * \param [in] id Timer to be stopped
+ */
+void hal_lp_timer_stop( const hal_lp_timer_id_t id );
+
+/*!
+ * Enables timer interrupts
+ */
+void hal_lp_timer_irq_enable( void );
+
+/*!
+ * Disables timer interrupts
+ */
+void hal_lp_timer_irq_disable( void );
+
+/*!
+ * Gets the expiry time of the first running timer
+ *
+ * \param [out] expiry_time_us Virtual time at which the timer expires, in microseconds
+ *
+ * \retval true if a timer is running, false otherwise
+ */
+bool hal_lp_timer_get_next_expiry_time_us( uint64_t* expiry_time_us );
+
+/*!
+ * Calls the callback of every expired timer, if timer interrupts are enabled
+ */
+void hal_lp_timer_process( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_HAL_LP_TIMER_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,221 @@
+/*!
+ * \file      smtc_hal_mcu.c
+ *
+ * \brief     MCU Hardware Abstraction Layer implementation for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_flash.h"
+#include "smtc_hal_gpio.h"
+#include "smtc_hal_lp_timer.h"
+#include "smtc_hal_rng.h"
+#include "smtc_hal_rtc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * Image restarted on reset: the running program itself
+ */
+#define HAL_MCU_SELF_EXE "/proc/self/exe"
+
+/*!
+ * Rounds a board instance block size up so that each block stays aligned for any module state
+ */
+#define HAL_MCU_INSTANCE_ALIGN( size ) ( ( ( size ) + 7u ) & ~7u )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static void ( *mcu_reset_handler )( void ) = NULL;
+
+// Interrupts state saved by the critical sections, as the PRIMASK register on target
+static bool mcu_irq_is_disabled = false;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void hal_mcu_critical_section_begin( uint32_t* mask )
+{
+    *mask = ( mcu_irq_is_disabled == true ) ? 1 : 0;
+    hal_mcu_disable_irq( );
+}
+
+void hal_mcu_critical_section_end( uint32_t* mask )
+{
+    // Nested in a section with disabled irqs: keep them disabled
+    if( *mask == 0 )
+    {
+        hal_mcu_enable_irq( );
+    }
+}
+
+void hal_mcu_disable_irq( void )
+{
+    mcu_irq_is_disabled = true;
+    hal_gpio_irq_disable( );
+    hal_lp_timer_irq_disable( );
+}
+
+void hal_mcu_enable_irq( void )
+{
+    mcu_irq_is_disabled = false;
+    hal_gpio_irq_enable( );
+    hal_lp_timer_irq_enable( );
+}
+
+void hal_mcu_init( void )
+{
+    hal_rtc_init( );
+    hal_lp_timer_init( );
+    hal_rng_init( );
+    hal_flash_init( );
+}
+
+uint32_t hal_mcu_get_instance_size( void )
+{
+    return HAL_MCU_INSTANCE_ALIGN( hal_lp_timer_get_instance_size( ) ) +
+           HAL_MCU_INSTANCE_ALIGN( hal_gpio_get_instance_size( ) ) +
+           HAL_MCU_INSTANCE_ALIGN( hal_flash_get_instance_size( ) ) +
+           HAL_MCU_INSTANCE_ALIGN( hal_rng_get_instance_size( ) );
+}
+
+void hal_mcu_set_instance( void* instance )
+{
+    uint8_t* block = ( uint8_t* ) instance;
+
+    if( block == NULL )
+    {
+        hal_lp_timer_set_instance( NULL );
+        hal_gpio_set_instance( NULL );
+        hal_flash_set_instance( NULL );
+        hal_rng_set_instance( NULL );
+        return;
+    }
+
+    hal_lp_timer_set_instance( block );
+    block += HAL_MCU_INSTANCE_ALIGN( hal_lp_timer_get_instance_size( ) );
+    hal_gpio_set_instance( block );
+    block += HAL_MCU_INSTANCE_ALIGN( hal_gpio_get_instance_size( ) );
+    hal_flash_set_instance( block );
+    block += HAL_MCU_INSTANCE_ALIGN( hal_flash_get_instance_size( ) );
+    hal_rng_set_instance( block );
+}
+
+void hal_mcu_set_reset_handler( void ( *handler )( void ) )
+{
+    mcu_reset_handler = handler;
+}
+
+void hal_mcu_reset( void )
+{
+    if( mcu_reset_handler != NULL )
+    {
+        mcu_reset_handler( );
+    }
+
+    SMTC_HAL_TRACE_WARNING( "MCU reset requested, restarting\n" );
+    fflush( stdout );
+
+    // Start the program again from scratch, the nvm file is kept as the flash on target
+    execl( HAL_MCU_SELF_EXE, HAL_MCU_SELF_EXE, ( char* ) NULL );
+
+    // Only reached if the program cannot be restarted
+    exit( EXIT_FAILURE );
+}
+
+void hal_mcu_wait_us( const int32_t microseconds )
+{
+    if( microseconds > 0 )
+    {
+        hal_rtc_set_time_us( hal_rtc_get_time_us( ) + ( uint64_t ) microseconds );
+    }
+}
+
+void hal_mcu_set_sleep_for_ms( const int32_t milliseconds )
+{
+    uint64_t wakeup_time_us = hal_rtc_get_time_us( );
+    uint64_t expiry_time_us = 0;
+
+    if( milliseconds > 0 )
+    {
+        wakeup_time_us += ( uint64_t ) milliseconds * 1000;
+    }
+
+    if( ( hal_lp_timer_get_next_expiry_time_us( &expiry_time_us ) == true ) && ( expiry_time_us <= wakeup_time_us ) )
+    {
+        hal_rtc_set_time_us( expiry_time_us );
+        hal_lp_timer_process( );
+    }
+    else
+    {
+        hal_rtc_set_time_us( wakeup_time_us );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,138 @@
+/*!
+ * \file      smtc_hal_rng.h
+ *
+ * \brief     Pseudo-random generator Hardware Abstraction Layer definition for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_HAL_RNG_H__
+#define __SMTC_HAL_RNG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Default seed: a given seed always gives the same simulation
+ */
+#ifndef HAL_RNG_SEED
+#define HAL_RNG_SEED 0x12345678
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Initializes the generator with HAL_RNG_SEED
+ */
+void hal_rng_init( void );
+
+/*!
+ * Gets the size of the memory holding the generator state of one simulated device
+ *
+ * \retval Size in bytes
+ */
+uint32_t hal_rng_get_instance_size( void );
+
+/*!
+ * Sets the memory holding the generator state used by all the following calls
+ *
+ * \remark The memory must have been zeroed before its first use
+ *
+ * \param [in] instance Pointer to hal_rng_get_instance_size() bytes, NULL for the built-in instance
+ */
+void hal_rng_set_instance( void* instance );
+
+/*!
+ * Changes the seed of the generator
+ *
+ * \param [in] seed New seed, 0 is replaced by HAL_RNG_SEED
+ */
+void hal_rng_set_seed( const uint32_t seed );
+
+/*!
+ * Returns a 32bits random number
+ *
+ * \retval random 32bits number
+ */
+uint32_t hal_rng_get_random( void );
+
+/*!
+ * Returns an unsigned random number in range [val_1;val_2]
+ *
+ * \param[in] val_1 first range unsigned value
+ * \param[in] val_2 second range unsigned value
+ *
+ * \retval Generated random unsigned number between smallest value and biggest value between val_1 and val_2
+ */
+uint32_t hal_rng_get_random_in_range( const uint32_t val_1, const uint32_t val_2 );
+
+/*!
+ * Returns a signed random number in range [val_1;val_2]
+ *
+ * \param[in] val_1 first range signed value
+ * \param[in] val_2 second range signed value
+ *
+ * \retval Generated random signed number between smallest value and biggest value between val_1 and val_2
+ */
+int32_t hal_rng_get_signed_random_in_range( const int32_t val_1, const int32_t val_2 );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_HAL_RNG_H__
+
+/* --- EOF ------------------------------------------------------------------ */
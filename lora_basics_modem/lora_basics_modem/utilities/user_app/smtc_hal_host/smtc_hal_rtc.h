@@ -0,0 +1,128 @@
+/*!
+ * \file      smtc_hal_rtc.h
+ *
+ * \brief     Virtual RTC Hardware Abstraction Layer definition for host builds
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __RTC_UTILITIES_H__
+#define __RTC_UTILITIES_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Virtual time consumed by each read of the RTC, in microseconds
+ *
+ * \remark The modem busy-waits on the RTC before some radio operations: advancing the virtual clock on each read
+ *         models the CPU time spent polling and guarantees these loops terminate.
+ */
+#ifndef HAL_RTC_READ_DURATION_IN_US
+#define HAL_RTC_READ_DURATION_IN_US 10
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Initializes the virtual RTC (time starts at 0)
+ */
+void hal_rtc_init( void );
+
+/*!
+ * Returns the current RTC time in seconds
+ *
+ * retval rtc_time_s Current RTC time in seconds
+ */
+uint32_t hal_rtc_get_time_s( void );
+
+/*!
+ * Returns the current RTC time in milliseconds
+ *
+ * retval rtc_time_ms Current RTC time in milliseconds wraps every 49 days
+ */
+uint32_t hal_rtc_get_time_ms( void );
+
+/*!
+ * Returns the current RTC time in 0.1milliseconds
+ *
+ * retval rtc_time_ms Current RTC time in 0.1milliseconds wraps every 4.9 days
+ */
+uint32_t hal_rtc_get_time_100us( void );
+
+/*!
+ * Returns the current virtual time, without consuming any time
+ *
+ * \retval Current virtual time in microseconds
+ */
+uint64_t hal_rtc_get_time_us( void );
+
+/*!
+ * Moves the virtual time forward
+ *
+ * \remark Virtual time never goes backward: an older time is ignored.
+ *
+ * \param[IN] time_us New virtual time in microseconds
+ */
+void hal_rtc_set_time_us( const uint64_t time_us );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __RTC_UTILITIES_H__
+
+/* --- EOF ------------------------------------------------------------------ */
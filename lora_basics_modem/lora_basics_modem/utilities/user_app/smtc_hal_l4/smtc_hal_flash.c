@@ -126,7 +126,7 @@ uint8_t hal_flash_erase_page( uint32_t addr, uint8_t nb_page )
 
     /* Fill EraseInit structure*/
     EraseInitStruct.TypeErase = FLASH_TYPEERASE_PAGES;
-    EraseInitStruct.Page      = FirstUserPage;
+    EraseInitStruct.Page      = FirstUserPage % FLASH_PAGE_PER_BANK;  // Page number within its bank
     EraseInitStruct.NbPages   = nb_page;
     EraseInitStruct.Banks     = bank_number;
 
@@ -43,6 +43,7 @@
 #include "smtc_hal_spi.h"
 #include "stm32l4xx_hal.h"
 #include "stm32l4xx_ll_spi.h"
+#include "stm32l4xx_ll_dma.h"
 
 #include "modem_pinout.h"
 #include "smtc_hal_mcu.h"
@@ -67,6 +68,13 @@ typedef struct spi_s
     SPI_TypeDef*      interface;
     SPI_HandleTypeDef handle;
     struct
+    {
+        uint32_t  rx_channel;  // DMA1 channels and request of the interface
+        uint32_t  tx_channel;
+        uint32_t  request;
+        IRQn_Type rx_irq;
+    } dma;
+    struct
     {
         hal_gpio_pin_names_t mosi;
         hal_gpio_pin_names_t miso;
@@ -83,6 +91,13 @@ static spi_t spi_periph[] = {
         {
             .interface = SPI1,
             .handle    = {0},
+            .dma =
+                {
+                    .rx_channel = LL_DMA_CHANNEL_2,
+                    .tx_channel = LL_DMA_CHANNEL_3,
+                    .request    = LL_DMA_REQUEST_1,
+                    .rx_irq     = DMA1_Channel2_IRQn,
+                },
             .pins =
                 {
                     .mosi = NC,
@@ -98,6 +113,16 @@ static spi_t spi_periph[] = {
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
+/*!
+ * Transfers a buffer with the DMA, the core sleeping until the last byte is received
+ *
+ * \param [IN]  spi       SPI interface
+ * \param [IN]  tx_buffer Bytes to be sent, NULL to send zeros
+ * \param [OUT] rx_buffer Received bytes, NULL to drop them
+ * \param [IN]  size      Number of bytes to transfer
+ */
+static void hal_spi_transfer_dma( spi_t* spi, const uint8_t* tx_buffer, uint8_t* rx_buffer, const uint16_t size );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -157,6 +182,35 @@ uint16_t hal_spi_in_out( const uint32_t id, const uint16_t out_data )
     return LL_SPI_ReceiveData8( spi_periph[local_id].interface );
 }
 
+void hal_spi_transfer( const uint32_t id, const uint8_t* tx_buffer, uint8_t* rx_buffer, const uint16_t size )
+{
+    assert_param( ( id > 0 ) && ( ( id - 1 ) < sizeof( spi_periph ) ) );
+    spi_t* spi = &spi_periph[id - 1];
+
+    if( size >= HAL_SPI_DMA_MIN_SIZE )
+    {
+        hal_spi_transfer_dma( spi, tx_buffer, rx_buffer, size );
+        return;
+    }
+
+    for( uint16_t i = 0; i < size; i++ )
+    {
+        while( LL_SPI_IsActiveFlag_TXE( spi->interface ) == 0 )
+        {
+        };
+        LL_SPI_TransmitData8( spi->interface, ( tx_buffer != NULL ) ? tx_buffer[i] : 0 );
+
+        while( LL_SPI_IsActiveFlag_RXNE( spi->interface ) == 0 )
+        {
+        };
+        uint8_t in_data = LL_SPI_ReceiveData8( spi->interface );
+        if( rx_buffer != NULL )
+        {
+            rx_buffer[i] = in_data;
+        }
+    }
+}
+
 void HAL_SPI_MspInit( SPI_HandleTypeDef* spiHandle )
 {
     if( spiHandle->Instance == spi_periph[0].interface )
@@ -173,6 +227,10 @@ void HAL_SPI_MspInit( SPI_HandleTypeDef* spiHandle )
         HAL_GPIO_Init( gpio_port, &gpio );
 
         __HAL_RCC_SPI1_CLK_ENABLE( );
+        __HAL_RCC_DMA1_CLK_ENABLE( );
+
+        // Pending interrupts, even disabled ones, wake up the core from WFE: see hal_spi_transfer_dma
+        SET_BIT( SCB->SCR, SCB_SCR_SEVONPEND_Msk );
     }
     else
     {
@@ -207,4 +265,64 @@ void HAL_SPI_MspDeInit( SPI_HandleTypeDef* spiHandle )
         mcu_panic( );
     }
 }
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void hal_spi_transfer_dma( spi_t* spi, const uint8_t* tx_buffer, uint8_t* rx_buffer, const uint16_t size )
+{
+    static const uint8_t tx_dummy = 0;
+    static uint8_t       rx_dummy;
+    const uint32_t       dr_address = LL_SPI_DMA_GetRegAddr( spi->interface );
+
+    LL_DMA_ConfigTransfer( DMA1, spi->dma.rx_channel,
+                           LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_PRIORITY_HIGH | LL_DMA_MODE_NORMAL |
+                               LL_DMA_PERIPH_NOINCREMENT |
+                               ( ( rx_buffer != NULL ) ? LL_DMA_MEMORY_INCREMENT : LL_DMA_MEMORY_NOINCREMENT ) |
+                               LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE );
+    LL_DMA_ConfigAddresses( DMA1, spi->dma.rx_channel, dr_address,
+                            ( uint32_t )( ( rx_buffer != NULL ) ? rx_buffer : &rx_dummy ),
+                            LL_DMA_DIRECTION_PERIPH_TO_MEMORY );
+    LL_DMA_SetDataLength( DMA1, spi->dma.rx_channel, size );
+    LL_DMA_SetPeriphRequest( DMA1, spi->dma.rx_channel, spi->dma.request );
+
+    LL_DMA_ConfigTransfer( DMA1, spi->dma.tx_channel,
+                           LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_PRIORITY_HIGH | LL_DMA_MODE_NORMAL |
+                               LL_DMA_PERIPH_NOINCREMENT |
+                               ( ( tx_buffer != NULL ) ? LL_DMA_MEMORY_INCREMENT : LL_DMA_MEMORY_NOINCREMENT ) |
+                               LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE );
+    LL_DMA_ConfigAddresses( DMA1, spi->dma.tx_channel,
+                            ( uint32_t )( ( tx_buffer != NULL ) ? tx_buffer : &tx_dummy ), dr_address,
+                            LL_DMA_DIRECTION_MEMORY_TO_PERIPH );
+    LL_DMA_SetDataLength( DMA1, spi->dma.tx_channel, size );
+    LL_DMA_SetPeriphRequest( DMA1, spi->dma.tx_channel, spi->dma.request );
+
+    // The channel interrupt stays disabled in the NVIC: it only becomes pending, which wakes up the WFE below. This
+    // also works when called from an interrupt handler of any priority
+    LL_DMA_EnableIT_TC( DMA1, spi->dma.rx_channel );
+
+    // Order given by the reference manual: rx request, channels, then tx request
+    LL_SPI_EnableDMAReq_RX( spi->interface );
+    LL_DMA_EnableChannel( DMA1, spi->dma.rx_channel );
+    LL_DMA_EnableChannel( DMA1, spi->dma.tx_channel );
+    LL_SPI_EnableDMAReq_TX( spi->interface );
+
+    // Reception of the last byte also ends the transmission
+    while( READ_BIT( DMA1->ISR, DMA_ISR_TCIF1 << ( spi->dma.rx_channel * 4 ) ) == 0 )
+    {
+        __WFE( );
+    }
+
+    LL_SPI_DisableDMAReq_TX( spi->interface );
+    LL_DMA_DisableChannel( DMA1, spi->dma.tx_channel );
+    LL_DMA_DisableChannel( DMA1, spi->dma.rx_channel );
+    LL_SPI_DisableDMAReq_RX( spi->interface );
+
+    WRITE_REG( DMA1->IFCR, ( DMA_IFCR_CGIF1 << ( spi->dma.rx_channel * 4 ) ) |
+                               ( DMA_IFCR_CGIF1 << ( spi->dma.tx_channel * 4 ) ) );
+    NVIC_ClearPendingIRQ( spi->dma.rx_irq );
+}
+
 /* --- EOF ------------------------------------------------------------------ */
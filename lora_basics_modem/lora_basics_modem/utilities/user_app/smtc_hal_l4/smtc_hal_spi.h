@@ -55,6 +55,13 @@ extern "C" {
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 
+/*!
+ * Smallest transfer handed to the DMA, shorter ones (most radio commands) are cheaper to poll
+ */
+#ifndef HAL_SPI_DMA_MIN_SIZE
+#define HAL_SPI_DMA_MIN_SIZE 16
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -93,6 +100,16 @@ void hal_spi_de_init( const uint32_t id );
  */
 uint16_t hal_spi_in_out( const uint32_t id, const uint16_t out_data );
 
+/*!
+ * Sends and receives a buffer in one transfer, using DMA from HAL_SPI_DMA_MIN_SIZE bytes
+ *
+ * \param [IN]  id        SPI interface id [1:N]
+ * \param [IN]  tx_buffer Bytes to be sent, NULL to send zeros
+ * \param [OUT] rx_buffer Received bytes, NULL to drop them. May be the same as tx_buffer
+ * \param [IN]  size      Number of bytes to transfer
+ */
+void hal_spi_transfer( const uint32_t id, const uint8_t* tx_buffer, uint8_t* rx_buffer, const uint16_t size );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,501 @@
+/*!
+ * \file      nvm_journal.c
+ *
+ * \brief     Append-only journal of records in flash pages, with atomic commits
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <stddef.h>   // offsetof
+#include <string.h>
+
+#include "nvm_journal.h"
+#include "modem_crc32.h"
+#include "smtc_hal_flash.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*!
+ * Rounds a size up to the flash programming unit
+ */
+#define NVM_JOURNAL_ALIGN( size ) \
+    ( ( ( size ) + NVM_JOURNAL_PROGRAM_UNIT - 1 ) & ~( ( uint32_t ) NVM_JOURNAL_PROGRAM_UNIT - 1 ) )
+
+/*!
+ * Space taken in a page by a record of the given size
+ */
+#define NVM_JOURNAL_RECORD_SPACE( size ) ( sizeof( nvm_journal_record_header_t ) + NVM_JOURNAL_ALIGN( size ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * Flash programming unit: records start on a double word
+ */
+#define NVM_JOURNAL_PROGRAM_UNIT 8
+
+/*!
+ * Value of the erased flash bytes
+ */
+#define NVM_JOURNAL_ERASED_BYTE 0xFF
+
+/*!
+ * Magic number of a valid page header: "NVMJ"
+ */
+#define NVM_JOURNAL_PAGE_MAGIC 0x4A4D564EUL
+
+/*!
+ * Record flag: the next record belongs to the same commit
+ */
+#define NVM_JOURNAL_RECORD_FLAG_CONTINUED 0x01
+
+/*!
+ * Size of the buffer used to move records from a page to another, a multiple of NVM_JOURNAL_PROGRAM_UNIT
+ */
+#define NVM_JOURNAL_COPY_CHUNK_SIZE 64
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*!
+ * Header of a page, written once all the records copied in the page are written: a page without a valid header is
+ * ignored
+ */
+typedef struct nvm_journal_page_header_s
+{
+    uint32_t magic;
+    uint32_t sequence;  //!< Incremented at each page change, the page with the highest one holds the latest records
+    uint32_t rfu;
+    uint32_t crc;  //!< crc32 of the previous fields
+} nvm_journal_page_header_t;
+
+/*!
+ * Header of a record, followed by its content padded to NVM_JOURNAL_PROGRAM_UNIT
+ */
+typedef struct nvm_journal_record_header_s
+{
+    uint8_t  id;
+    uint8_t  flags;
+    uint16_t size;
+    uint32_t crc;  //!< crc32 of the previous fields and of the content
+} nvm_journal_record_header_t;
+
+/*!
+ * Location of the latest record of an identifier
+ */
+typedef struct nvm_journal_index_s
+{
+    uint32_t addr;  //!< Address of the content
+    uint16_t size;
+    bool     is_valid;
+} nvm_journal_index_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint32_t journal_addr     = 0;
+static uint8_t  journal_nb_pages = 0;
+
+static bool     journal_has_page       = false;  // A page holds the latest records
+static uint8_t  journal_page           = 0;      // Page holding the latest records, the next ones are appended to it
+static uint32_t journal_page_sequence  = 0;
+static uint32_t journal_page_offset    = 0;      // Offset of the next record in journal_page
+static bool     journal_page_is_closed = false;  // An interrupted write left the end of journal_page unusable
+
+static nvm_journal_index_t journal_index[NVM_JOURNAL_NB_IDS];
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * Indexes the records of journal_page and finds where the next one goes
+ */
+static void nvm_journal_scan_page( void );
+
+/*!
+ * Writes the commit to a new page, after a copy of the latest records of the other identifiers
+ *
+ * \param [in] entries    Records to write
+ * \param [in] nb_entries Number of records
+ * \param [in] size       Space taken by the records
+ *
+ * \retval false if the new page is too small
+ */
+static bool nvm_journal_compact( const nvm_journal_entry_t* entries, uint8_t nb_entries, uint32_t size );
+
+/*!
+ * Appends the records of a commit to journal_page and indexes them
+ *
+ * \param [in] entries    Records to write
+ * \param [in] nb_entries Number of records
+ */
+static void nvm_journal_write_entries( const nvm_journal_entry_t* entries, uint8_t nb_entries );
+
+/*!
+ * Programs a buffer, the last double word being padded with erased bytes
+ *
+ * \param [in] addr   Destination address, aligned on NVM_JOURNAL_PROGRAM_UNIT
+ * \param [in] buffer Bytes to program
+ * \param [in] size   Number of bytes
+ */
+static void nvm_journal_program( uint32_t addr, const uint8_t* buffer, uint32_t size );
+
+/*!
+ * Gets the address of a page of the journal
+ */
+static uint32_t nvm_journal_page_addr( uint8_t page );
+
+/*!
+ * Feeds flash content to a running crc32
+ */
+static uint32_t nvm_journal_crc32_update_from_flash( uint32_t crc, uint32_t addr, uint32_t size );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool nvm_journal_init( uint32_t addr, uint8_t nb_pages )
+{
+    nvm_journal_page_header_t header;
+
+    journal_addr     = addr;
+    journal_nb_pages = nb_pages;
+    journal_has_page = false;
+    memset( journal_index, 0, sizeof( journal_index ) );
+
+    for( uint8_t page = 0; page < nb_pages; page++ )
+    {
+        hal_flash_read_buffer( nvm_journal_page_addr( page ), ( uint8_t* ) &header, sizeof( header ) );
+
+        if( ( header.magic == NVM_JOURNAL_PAGE_MAGIC ) &&
+            ( header.crc == modem_crc32_final( modem_crc32_update( MODEM_CRC32_INIT, ( const uint8_t* ) &header,
+                                                                   offsetof( nvm_journal_page_header_t, crc ) ) ) ) &&
+            ( ( journal_has_page == false ) || ( ( int32_t ) ( header.sequence - journal_page_sequence ) > 0 ) ) )
+        {
+            journal_has_page      = true;
+            journal_page          = page;
+            journal_page_sequence = header.sequence;
+        }
+    }
+
+    if( journal_has_page == false )
+    {
+        return false;
+    }
+
+    nvm_journal_scan_page( );
+    return true;
+}
+
+bool nvm_journal_read( uint8_t id, uint8_t* buffer, uint16_t size )
+{
+    if( ( id >= NVM_JOURNAL_NB_IDS ) || ( journal_index[id].is_valid == false ) )
+    {
+        return false;
+    }
+
+    const uint16_t read_size = ( size < journal_index[id].size ) ? size : journal_index[id].size;
+
+    hal_flash_read_buffer( journal_index[id].addr, buffer, read_size );
+    memset( &buffer[read_size], NVM_JOURNAL_ERASED_BYTE, size - read_size );
+    return true;
+}
+
+bool nvm_journal_commit( const nvm_journal_entry_t* entries, uint8_t nb_entries )
+{
+    uint32_t size = 0;
+
+    for( uint8_t i = 0; i < nb_entries; i++ )
+    {
+        if( entries[i].id >= NVM_JOURNAL_NB_IDS )
+        {
+            return false;
+        }
+        size += NVM_JOURNAL_RECORD_SPACE( entries[i].size );
+    }
+
+    if( ( journal_has_page == true ) && ( journal_page_is_closed == false ) &&
+        ( ( journal_page_offset + size ) <= ADDR_FLASH_PAGE_SIZE ) )
+    {
+        nvm_journal_write_entries( entries, nb_entries );
+        return true;
+    }
+
+    return nvm_journal_compact( entries, nb_entries, size );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void nvm_journal_scan_page( void )
+{
+    const uint32_t              page_addr = nvm_journal_page_addr( journal_page );
+    nvm_journal_record_header_t header;
+    nvm_journal_index_t         pending[NVM_JOURNAL_NB_IDS];
+    uint8_t                     nb_pending = 0;
+
+    memset( pending, 0, sizeof( pending ) );
+    journal_page_offset    = sizeof( nvm_journal_page_header_t );
+    journal_page_is_closed = false;
+
+    while( ( journal_page_offset + sizeof( header ) ) <= ADDR_FLASH_PAGE_SIZE )
+    {
+        const uint32_t content_addr = page_addr + journal_page_offset + sizeof( header );
+        bool           is_valid     = false;
+
+        hal_flash_read_buffer( page_addr + journal_page_offset, ( uint8_t* ) &header, sizeof( header ) );
+
+        if( ( header.id == NVM_JOURNAL_ERASED_BYTE ) && ( header.flags == NVM_JOURNAL_ERASED_BYTE ) &&
+            ( header.size == 0xFFFF ) && ( header.crc == 0xFFFFFFFF ) )
+        {
+            // Free space
+            break;
+        }
+
+        if( ( header.id < NVM_JOURNAL_NB_IDS ) &&
+            ( header.size <= ( ADDR_FLASH_PAGE_SIZE - journal_page_offset - sizeof( header ) ) ) )
+        {
+            uint32_t crc = modem_crc32_update( MODEM_CRC32_INIT, ( const uint8_t* ) &header,
+                                               offsetof( nvm_journal_record_header_t, crc ) );
+
+            crc      = nvm_journal_crc32_update_from_flash( crc, content_addr, header.size );
+            is_valid = ( header.crc == modem_crc32_final( crc ) );
+        }
+        if( is_valid == false )
+        {
+            // Interrupted write: what follows has not been programmed as expected, nothing more is appended here
+            journal_page_is_closed = true;
+            break;
+        }
+
+        pending[header.id].addr     = content_addr;
+        pending[header.id].size     = header.size;
+        pending[header.id].is_valid = true;
+        nb_pending++;
+        journal_page_offset += NVM_JOURNAL_RECORD_SPACE( header.size );
+
+        if( ( header.flags & NVM_JOURNAL_RECORD_FLAG_CONTINUED ) == 0 )
+        {
+            // Last record of a commit: the commit is complete
+            for( uint8_t id = 0; id < NVM_JOURNAL_NB_IDS; id++ )
+            {
+                if( pending[id].is_valid == true )
+                {
+                    journal_index[id] = pending[id];
+                }
+            }
+            memset( pending, 0, sizeof( pending ) );
+            nb_pending = 0;
+        }
+    }
+
+    if( nb_pending > 0 )
+    {
+        // Interrupted commit: its records are dropped, the next ones must not be taken for its end
+        journal_page_is_closed = true;
+    }
+}
+
+static bool nvm_journal_compact( const nvm_journal_entry_t* entries, uint8_t nb_entries, uint32_t size )
+{
+    const uint8_t  page      = ( journal_has_page == true ) ? ( ( journal_page + 1 ) % journal_nb_pages ) : 0;
+    const uint32_t page_addr = nvm_journal_page_addr( page );
+    bool           is_copied[NVM_JOURNAL_NB_IDS];
+    uint8_t        chunk[NVM_JOURNAL_COPY_CHUNK_SIZE];
+
+    // The latest records of the identifiers not in the commit are copied
+    for( uint8_t id = 0; id < NVM_JOURNAL_NB_IDS; id++ )
+    {
+        is_copied[id] = journal_index[id].is_valid;
+    }
+    for( uint8_t i = 0; i < nb_entries; i++ )
+    {
+        is_copied[entries[i].id] = false;
+    }
+    for( uint8_t id = 0; id < NVM_JOURNAL_NB_IDS; id++ )
+    {
+        if( is_copied[id] == true )
+        {
+            size += NVM_JOURNAL_RECORD_SPACE( journal_index[id].size );
+        }
+    }
+    if( ( sizeof( nvm_journal_page_header_t ) + size ) > ADDR_FLASH_PAGE_SIZE )
+    {
+        return false;
+    }
+
+    // The page holds older records than journal_page, which stays valid until the header of the new one is written
+    hal_flash_erase_page( page_addr, 1 );
+
+    journal_page_offset = sizeof( nvm_journal_page_header_t );
+    for( uint8_t id = 0; id < NVM_JOURNAL_NB_IDS; id++ )
+    {
+        if( is_copied[id] == false )
+        {
+            continue;
+        }
+
+        const uint32_t              record_addr = page_addr + journal_page_offset;
+        nvm_journal_record_header_t header      = {
+                 .id    = id,
+                 .flags = 0,
+                 .size  = journal_index[id].size,
+        };
+
+        header.crc = modem_crc32_update( MODEM_CRC32_INIT, ( const uint8_t* ) &header,
+                                         offsetof( nvm_journal_record_header_t, crc ) );
+        header.crc = modem_crc32_final(
+            nvm_journal_crc32_update_from_flash( header.crc, journal_index[id].addr, header.size ) );
+        nvm_journal_program( record_addr, ( const uint8_t* ) &header, sizeof( header ) );
+
+        for( uint32_t offset = 0; offset < header.size; offset += sizeof( chunk ) )
+        {
+            const uint32_t chunk_size =
+                ( ( header.size - offset ) < sizeof( chunk ) ) ? ( header.size - offset ) : sizeof( chunk );
+
+            hal_flash_read_buffer( journal_index[id].addr + offset, chunk, chunk_size );
+            nvm_journal_program( record_addr + sizeof( header ) + offset, chunk, chunk_size );
+        }
+
+        journal_index[id].addr = record_addr + sizeof( header );
+        journal_page_offset += NVM_JOURNAL_RECORD_SPACE( header.size );
+    }
+
+    journal_page           = page;
+    journal_page_is_closed = false;
+    nvm_journal_write_entries( entries, nb_entries );
+
+    // The page becomes the one holding the latest records
+    nvm_journal_page_header_t page_header = {
+        .magic    = NVM_JOURNAL_PAGE_MAGIC,
+        .sequence = ( journal_has_page == true ) ? ( journal_page_sequence + 1 ) : 0,
+        .rfu      = 0xFFFFFFFF,
+    };
+    page_header.crc = modem_crc32_final( modem_crc32_update( MODEM_CRC32_INIT, ( const uint8_t* ) &page_header,
+                                                             offsetof( nvm_journal_page_header_t, crc ) ) );
+    nvm_journal_program( page_addr, ( const uint8_t* ) &page_header, sizeof( page_header ) );
+
+    journal_has_page      = true;
+    journal_page_sequence = page_header.sequence;
+    return true;
+}
+
+static void nvm_journal_write_entries( const nvm_journal_entry_t* entries, uint8_t nb_entries )
+{
+    const uint32_t page_addr = nvm_journal_page_addr( journal_page );
+    uint32_t       offset    = journal_page_offset;
+
+    for( uint8_t i = 0; i < nb_entries; i++ )
+    {
+        const uint32_t              record_addr = page_addr + journal_page_offset;
+        nvm_journal_record_header_t header      = {
+                 .id    = entries[i].id,
+                 .flags = ( i < ( nb_entries - 1 ) ) ? NVM_JOURNAL_RECORD_FLAG_CONTINUED : 0,
+                 .size  = entries[i].size,
+        };
+
+        header.crc = modem_crc32_update( MODEM_CRC32_INIT, ( const uint8_t* ) &header,
+                                         offsetof( nvm_journal_record_header_t, crc ) );
+        header.crc = modem_crc32_final( modem_crc32_update( header.crc, entries[i].buffer, entries[i].size ) );
+
+        // The header goes first: an interrupted write is caught by its crc, and never looks like free space
+        nvm_journal_program( record_addr, ( const uint8_t* ) &header, sizeof( header ) );
+        nvm_journal_program( record_addr + sizeof( header ), entries[i].buffer, entries[i].size );
+        journal_page_offset += NVM_JOURNAL_RECORD_SPACE( entries[i].size );
+    }
+
+    // Only indexed once all the records of the commit are written
+    for( uint8_t i = 0; i < nb_entries; i++ )
+    {
+        journal_index[entries[i].id].addr     = page_addr + offset + sizeof( nvm_journal_record_header_t );
+        journal_index[entries[i].id].size     = entries[i].size;
+        journal_index[entries[i].id].is_valid = true;
+        offset += NVM_JOURNAL_RECORD_SPACE( entries[i].size );
+    }
+}
+
+static void nvm_journal_program( uint32_t addr, const uint8_t* buffer, uint32_t size )
+{
+    const uint32_t aligned_size = size - ( size % NVM_JOURNAL_PROGRAM_UNIT );
+    uint8_t        last_unit[NVM_JOURNAL_PROGRAM_UNIT];
+
+    if( aligned_size > 0 )
+    {
+        hal_flash_write_buffer( addr, buffer, aligned_size );
+    }
+    if( aligned_size < size )
+    {
+        // The flash is programmed by whole units: do not read past the end of the buffer
+        memset( last_unit, NVM_JOURNAL_ERASED_BYTE, sizeof( last_unit ) );
+        memcpy( last_unit, &buffer[aligned_size], size - aligned_size );
+        hal_flash_write_buffer( addr + aligned_size, last_unit, sizeof( last_unit ) );
+    }
+}
+
+static uint32_t nvm_journal_page_addr( uint8_t page )
+{
+    return journal_addr + ( ( uint32_t ) page * ADDR_FLASH_PAGE_SIZE );
+}
+
+static uint32_t nvm_journal_crc32_update_from_flash( uint32_t crc, uint32_t addr, uint32_t size )
+{
+    uint8_t chunk[NVM_JOURNAL_COPY_CHUNK_SIZE];
+
+    for( uint32_t offset = 0; offset < size; offset += sizeof( chunk ) )
+    {
+        const uint32_t chunk_size = ( ( size - offset ) < sizeof( chunk ) ) ? ( size - offset ) : sizeof( chunk );
+
+        hal_flash_read_buffer( addr + offset, chunk, chunk_size );
+        crc = modem_crc32_update( crc, chunk, chunk_size );
+    }
+    return crc;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,131 @@
+/*!
+ * \file      nvm_journal.h
+ *
+ * \brief     Append-only journal of records in flash pages, with atomic commits
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __NVM_JOURNAL_H__
+#define __NVM_JOURNAL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * Number of record identifiers, the identifiers go from 0 to NVM_JOURNAL_NB_IDS - 1
+ */
+#ifndef NVM_JOURNAL_NB_IDS
+#define NVM_JOURNAL_NB_IDS 8
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * Record to be written by nvm_journal_commit
+ */
+typedef struct nvm_journal_entry_s
+{
+    uint8_t        id;      //!< Record identifier, the new record replaces the previous one with the same identifier
+    const uint8_t* buffer;  //!< Record content
+    uint16_t       size;    //!< Record size in bytes
+} nvm_journal_entry_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * Opens the journal held by the given flash pages and indexes its records
+ *
+ * \remark The records are appended to the page holding the latest ones. When it is full, the next page is erased
+ * and receives a copy of the latest records, which only becomes valid once completely written: a page is erased
+ * once per page filled instead of once per record, and the erases are spread over all the pages.
+ *
+ * \param [in] addr     Address of the first page
+ * \param [in] nb_pages Number of consecutive pages, at least 2
+ *
+ * \retval true if records have been found, false if the journal is empty
+ */
+bool nvm_journal_init( uint32_t addr, uint8_t nb_pages );
+
+/*!
+ * Reads the latest record with the given identifier
+ *
+ * \param [in]  id     Record identifier
+ * \param [out] buffer Record content, completed with erased flash bytes if the record is shorter than size
+ * \param [in]  size   Number of bytes to read
+ *
+ * \retval false if no record has this identifier, the buffer is left untouched
+ */
+bool nvm_journal_read( uint8_t id, uint8_t* buffer, uint16_t size );
+
+/*!
+ * Writes several records at once
+ *
+ * \remark The commit is atomic: after a reset, either all its records or none of them are read back. The flash is
+ * programmed and back to read mode when the function returns.
+ *
+ * \param [in] entries    Records to write, with different identifiers
+ * \param [in] nb_entries Number of records
+ *
+ * \retval false if the records, with the latest ones of the other identifiers, do not fit in a page
+ */
+bool nvm_journal_commit( const nvm_journal_entry_t* entries, uint8_t nb_entries );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __NVM_JOURNAL_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -55,6 +55,11 @@
 #include "smtc_hal_watchdog.h"
 
 #include "modem_pinout.h"
+#include "nvm_journal.h"
+
+#if defined( RADIO_HAL_TRACE )
+#include "radio_hal_trace.h"
+#endif
 
 // for variadic args
 #include <stdio.h>
@@ -73,6 +78,12 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+// Journal of the modem contexts, at the end of the second bank: erasing it does not stall the code running from the
+// first one
+#define ADDR_FLASH_CONTEXT_JOURNAL FLASH_PAGE_ADDR( 508 )
+#define FLASH_CONTEXT_JOURNAL_NB_PAGES 4
+
+// One page per context before the journal, only read for the contexts not stored in the journal yet
 #define ADDR_FLASH_LORAWAN_CONTEXT ADDR_FLASH_PAGE_254
 #define ADDR_FLASH_MODEM_CONTEXT ADDR_FLASH_PAGE_255
 #define ADDR_FLASH_DEVNONCE_CONTEXT ADDR_FLASH_PAGE_253
@@ -89,6 +100,10 @@
  */
 
 static hal_gpio_irq_t radio_dio_irq;
+#if defined( RADIO_HAL_TRACE )
+static void ( *radio_dio_irq_callback )( void* context );
+#endif
+static bool            context_journal_is_open = false;
 uint8_t __attribute__( ( section( ".noinit" ) ) ) saved_crashlog[CRASH_LOG_SIZE];
 volatile bool __attribute__( ( section( ".noinit" ) ) ) crashlog_available;
 
@@ -97,6 +112,18 @@ volatile bool __attribute__( ( section( ".noinit" ) ) ) crashlog_available;
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
+#if defined( RADIO_HAL_TRACE )
+/*!
+ * Records the radio irq in the radio hal trace then calls the modem handler
+ */
+static void radio_dio_irq_trace_handler( void* context );
+#endif
+
+/*!
+ * Opens the journal of the modem contexts on first use
+ */
+static void context_journal_open( void );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -179,6 +206,12 @@ void smtc_modem_hal_enable_modem_irq( void )
 
 void smtc_modem_hal_context_restore( const modem_context_type_t ctx_type, uint8_t* buffer, const uint32_t size )
 {
+    context_journal_open( );
+    if( nvm_journal_read( ( uint8_t ) ctx_type, buffer, ( uint16_t ) size ) == true )
+    {
+        return;
+    }
+
     switch( ctx_type )
     {
     case CONTEXT_MODEM:
@@ -201,27 +234,22 @@ void smtc_modem_hal_context_restore( const modem_context_type_t ctx_type, uint8_
 
 void smtc_modem_hal_context_store( const modem_context_type_t ctx_type, const uint8_t* buffer, const uint32_t size )
 {
-    switch( ctx_type )
+    const nvm_journal_entry_t entry = {
+        .id     = ( uint8_t ) ctx_type,
+        .buffer = buffer,
+        .size   = ( uint16_t ) size,
+    };
+
+    if( ( ctx_type >= MODEM_CONTEXT_TYPE_SIZE ) || ( size > ADDR_FLASH_PAGE_SIZE ) )
+    {
+        mcu_panic( );
+    }
+
+    // Appended to the journal: a page is only erased when the current one is full
+    context_journal_open( );
+    if( nvm_journal_commit( &entry, 1 ) == false )
     {
-    case CONTEXT_MODEM:
-        hal_flash_erase_page( ADDR_FLASH_MODEM_CONTEXT, 1 );
-        hal_flash_write_buffer( ADDR_FLASH_MODEM_CONTEXT, buffer, size );
-        break;
-    case CONTEXT_LR1MAC:
-        hal_flash_erase_page( ADDR_FLASH_LORAWAN_CONTEXT, 1 );
-        hal_flash_write_buffer( ADDR_FLASH_LORAWAN_CONTEXT, buffer, size );
-        break;
-    case CONTEXT_DEVNONCE:
-        hal_flash_erase_page( ADDR_FLASH_DEVNONCE_CONTEXT, 1 );
-        hal_flash_write_buffer( ADDR_FLASH_DEVNONCE_CONTEXT, buffer, size );
-        break;
-    case CONTEXT_SECURE_ELEMENT:
-        hal_flash_erase_page( ADDR_FLASH_SECURE_ELEMENT_CONTEXT, 1 );
-        hal_flash_write_buffer( ADDR_FLASH_SECURE_ELEMENT_CONTEXT, buffer, size );
-        break;
-    default:
         mcu_panic( );
-        break;
     }
 }
 
@@ -285,6 +313,10 @@ void smtc_modem_hal_irq_config_radio_irq( void ( *callback )( void* context ), v
     radio_dio_irq.pin      = RADIO_DIOX;
     radio_dio_irq.callback = callback;
     radio_dio_irq.context  = context;
+#if defined( RADIO_HAL_TRACE )
+    radio_dio_irq_callback = callback;
+    radio_dio_irq.callback = radio_dio_irq_trace_handler;
+#endif
 
     hal_gpio_irq_attach( &radio_dio_irq );
 }
@@ -360,4 +392,21 @@ void smtc_modem_hal_print_trace( const char* fmt, ... )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+#if defined( RADIO_HAL_TRACE )
+static void radio_dio_irq_trace_handler( void* context )
+{
+    radio_hal_trace_record( RADIO_HAL_TRACE_IRQ, NULL, 0, NULL, 0 );
+    radio_dio_irq_callback( context );
+}
+#endif
+
+static void context_journal_open( void )
+{
+    if( context_journal_is_open == false )
+    {
+        nvm_journal_init( ADDR_FLASH_CONTEXT_JOURNAL, FLASH_CONTEXT_JOURNAL_NB_PAGES );
+        context_journal_is_open = true;
+    }
+}
+
 /* --- EOF ------------------------------------------------------------------ */